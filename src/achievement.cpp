@@ -891,6 +891,12 @@ void achievements_tracker::clear()
     achievements_status_.clear();
 }
 
+bool achievements_tracker::notified_by( event_type type ) const
+{
+    // Everything else reaches the achievements through the stats_tracker watchers
+    return type == event_type::game_start;
+}
+
 void achievements_tracker::notify( const cata::event &e )
 {
     if( e.type() == event_type::game_start ) {
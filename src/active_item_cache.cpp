@@ -49,8 +49,9 @@ bool active_item_cache::add( item &it, point_rel_ms location, item *parent,
     bool ret = false;
     for( item_pocket *pk : it.get_standard_pockets() ) {
         pockets.emplace_back( pk );
-        for( item *pkit : pk->all_items_top() ) {
-            ret |= add( *pkit, location, &it, pockets );
+        // Walk the pocket itself rather than a copied list of pointers.
+        for( item &pkit : pk->edit_contents() ) {
+            ret |= add( pkit, location, &it, pockets );
         }
     }
     int speed = it.processing_speed();
@@ -90,13 +91,26 @@ bool active_item_cache::add( item &it, point_rel_ms location, item *parent,
 
 bool active_item_cache::empty() const
 {
-    return std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
+    return sleeping_items.empty() &&
+    std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
         return active_queue.second.empty();
     } );
 }
 
+void active_item_cache::wake_sleeping( const time_point &now )
+{
+    auto it = sleeping_items.begin();
+    while( it != sleeping_items.end() && it->first.first <= now ) {
+        std::list<item_reference> &target_list = active_items[it->first.second];
+        target_list.splice( target_list.begin(), it->second );
+        it = sleeping_items.erase( it );
+    }
+}
+
 std::vector<item_reference> active_item_cache::get()
 {
+    // Sleepers are listed too. get_for_processing() will put them back to sleep.
+    wake_sleeping( calendar::turn_max );
     std::vector<item_reference> all_cached_items;
     for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
         for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
@@ -114,6 +128,8 @@ std::vector<item_reference> active_item_cache::get()
 
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
+    const time_point now = calendar::turn;
+    wake_sleeping( now );
     std::vector<item_reference> items_to_process;
     items_to_process.reserve( std::accumulate( active_items.begin(), active_items.end(), std::size_t{ 0 },
     []( size_t prev, const auto & kv ) {
@@ -125,8 +141,15 @@ std::vector<item_reference> active_item_cache::get_for_processing()
         std::list<item_reference>::iterator it = kv.second.begin();
         for( ; it != kv.second.end() && num_to_process >= 0; ) {
             if( it->item_ref ) {
-                items_to_process.push_back( *it );
+                const time_point wake = it->item_ref->processing_wake();
                 --num_to_process;
+                if( wake > now ) {
+                    // Nothing would happen to it before then, let it sleep till it has work again.
+                    std::list<item_reference> &sleepers = sleeping_items[std::make_pair( wake, kv.first )];
+                    sleepers.splice( sleepers.end(), kv.second, it++ );
+                    continue;
+                }
+                items_to_process.push_back( *it );
                 ++it;
             } else {
                 // The item has been destroyed, so remove the reference from the cache
@@ -158,6 +181,7 @@ std::vector<item_reference> active_item_cache::get_special( special_item_type ty
 
 void active_item_cache::subtract_locations( const point_rel_ms &delta )
 {
+    wake_sleeping( calendar::turn_max );
     for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
         for( item_reference &ir : pair.second ) {
             ir.location -= delta;
@@ -167,6 +191,7 @@ void active_item_cache::subtract_locations( const point_rel_ms &delta )
 
 void active_item_cache::rotate_locations( int turns, const point_rel_ms &dim )
 {
+    wake_sleeping( calendar::turn_max );
     for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
         for( item_reference &ir : pair.second ) {
             // Should 'rotate' be propaged up to the typed coordinates?
@@ -177,6 +202,7 @@ void active_item_cache::rotate_locations( int turns, const point_rel_ms &dim )
 
 void active_item_cache::mirror( const point_rel_ms &dim, bool horizontally )
 {
+    wake_sleeping( calendar::turn_max );
     for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
         for( item_reference &ir : pair.second ) {
             if( horizontally ) {
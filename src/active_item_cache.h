@@ -4,9 +4,12 @@
 
 #include <cstddef>
 #include <list>
+#include <map>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "coordinates.h"
 #include "item_pocket.h"
 #include "point.h"
@@ -56,6 +59,11 @@ class active_item_cache
         std::unordered_map<int, std::list<item_reference>> active_items;
         std::unordered_map<special_item_type, std::list<item_reference>> special_items;
         std::unordered_map<int, std::unordered_map<item *, safe_reference<item>>> active_items_index;
+        // References put to sleep by get_for_processing(), by wake time and processing speed.
+        // They stay in active_items_index, so add() doesn't queue them a second time.
+        std::map<std::pair<time_point, int>, std::list<item_reference>> sleeping_items;
+        // Moves the references whose wake time has come back to the front of their lists.
+        void wake_sleeping( const time_point &now );
     public:
         /**
          * Adds the reference to the cache. Does nothing if the reference is already in the cache.
@@ -86,6 +94,8 @@ class active_item_cache
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          * Relies on the fact that item::processing_speed() is a constant.
+         * Items whose item::processing_wake() is still in the future are not returned, they
+         * sleep outside the lists until then.
          */
         std::vector<item_reference> get_for_processing();
 
@@ -4759,6 +4759,7 @@ bool multi_zone_activity_actor::simulate_turn( player_activity &act, Character &
     }
 
     requirement_failure_reasons req_fail_reason;
+    const bool remember_skips = multi_activity_actor::remembers_skips( current_activity );
 
     for( const tripoint_abs_ms &src : src_sorted ) {
         const tripoint_bub_ms &src_bub = here.get_bub( src );
@@ -4779,9 +4780,21 @@ bool multi_zone_activity_actor::simulate_turn( player_activity &act, Character &
             }
         }
 
+        if( remember_skips ) {
+            // nothing that ruled this location out last time has changed since
+            if( const std::optional<requirement_check_result> skipped =
+                    multi_activity_actor::remembered_skip( you, current_activity, src, src_bub ) ) {
+                req_fail_reason = requirement_failure_reasons();
+                req_fail_reason.convert_requirement_check_result( *skipped );
+                continue;
+            }
+        }
+
         you.invalidate_crafting_inventory();
         // can we do the activity for position src_loc? if so, what stage of the activity?
         activity_reason_info act_info = multi_activity_can_do( you, src_bub );
+        const bool needed_fetch = !act_info.can_do &&
+                                  multi_activity_actor::activity_reason_continue( act_info.reason );
 
         // do we have requirements for this activity stage? if so, are they satisfied?
         // see activity_handlers.h enum for requirement_check_result
@@ -4794,6 +4807,10 @@ bool multi_zone_activity_actor::simulate_turn( player_activity &act, Character &
         }
         req_fail_reason.convert_requirement_check_result( req_res );
         if( req_fail_reason.check_skip_location() ) {
+            if( remember_skips ) {
+                multi_activity_actor::remember_skip( you, current_activity, src, src_bub, req_res,
+                                                     needed_fetch );
+            }
             continue;
         }
 
@@ -12790,6 +12807,8 @@ void zone_sort_activity_actor::stage_init( player_activity &, Character &you )
     mgr.cache_avatar_location();
     coord_set.clear();
     unreachable_sources.clear();
+    planned_sources.clear();
+    planned_zone_version.reset();
     for( const tripoint_abs_ms &p :
          mgr.get_near( zone_type_LOOT_UNSORTED, you.pos_abs(), MAX_VIEW_DISTANCE, nullptr,
                        you.get_faction_id() ) ) {
@@ -12800,7 +12819,6 @@ void zone_sort_activity_actor::stage_init( player_activity &, Character &you )
 
 bool zone_sort_activity_actor::stage_think( player_activity &act, Character &you )
 {
-    const map &here = get_map();
     zone_manager &mgr = zone_manager::get_manager();
     mgr.cache_avatar_location();
 
@@ -12831,6 +12849,46 @@ bool zone_sort_activity_actor::stage_think( player_activity &act, Character &you
     last_think_grab_type = cur_grab_type;
     last_think_grab_point = cur_grab_point;
 
+    // Follow the planned trip sequence while it lasts. Planning classifies every source once
+    // and does no pathfinding, tiles it left out are still visited in route order afterwards.
+    // It is only planned again once the zones change.
+    if( planned_zone_version != mgr.get_zone_version() ) {
+        planned_zone_version = mgr.get_zone_version();
+        planned_sources.clear();
+        const std::vector<tripoint_abs_ms> sources( coord_set.begin(), coord_set.end() );
+        for( const zone_sorting::sort_trip &trip :
+             zone_sorting::plan_sort_trips( you, sources, other_activity_items ) ) {
+            planned_sources.push_back( trip.src );
+        }
+    }
+    std::unordered_set<tripoint_abs_ms> checked;
+    while( !planned_sources.empty() ) {
+        const tripoint_abs_ms src = planned_sources.front();
+        if( coord_set.count( src ) && !unreachable_sources.count( src ) ) {
+            if( const std::optional<bool> done = think_about_source( act, you, src ) ) {
+                return *done;
+            }
+            checked.emplace( src );
+        }
+        // Nothing left to do there, the tile stays first in line while it still has work.
+        planned_sources.erase( planned_sources.begin() );
+    }
+
+    // iterate over zone positions and look for items to move
+    for( const tripoint_abs_ms &src : route_sorted_sources( you ) ) {
+        if( checked.count( src ) ) {
+            continue;
+        }
+        if( const std::optional<bool> done = think_about_source( act, you, src ) ) {
+            return *done;
+        }
+    }
+    return true;
+}
+
+std::vector<tripoint_abs_ms> zone_sort_activity_actor::route_sorted_sources( Character &you )
+{
+    const map &here = get_map();
     // Sort sources by A* route distance. Pre-sort by Chebyshev (lower bound),
     // compute A* lazily, stop when chebyshev > best_route + 1.
     // Tiles past the cutoff are appended in Chebyshev order as fallback.
@@ -12901,73 +12959,75 @@ bool zone_sort_activity_actor::stage_think( player_activity &act, Character &you
     for( const tripoint_abs_ms &p : oob_tiles ) {
         src_sorted.emplace_back( p );
     }
+    return src_sorted;
+}
 
-    // iterate over zone positions and look for items to move
-    for( const tripoint_abs_ms &src : src_sorted ) {
-        placement = src;
+std::optional<bool> zone_sort_activity_actor::think_about_source( player_activity &act,
+        Character &you, const tripoint_abs_ms &src )
+{
+    const map &here = get_map();
+    placement = src;
 
-        const tripoint_bub_ms src_bub = here.get_bub( src );
-        if( !here.inbounds( src_bub ) ) {
-            if( zone_sorting::sorter_out_of_bounds( you, zone_sort_activity_actor() ) ) {
-                return false;
-            }
-            if( !zone_sorting::route_to_destination( you, act, src_bub, stage ) ) {
-                unreachable_sources.emplace( src );
-                continue;
-            }
+    const tripoint_bub_ms src_bub = here.get_bub( src );
+    if( !here.inbounds( src_bub ) ) {
+        if( zone_sorting::sorter_out_of_bounds( you, zone_sort_activity_actor() ) ) {
             return false;
         }
+        if( !zone_sorting::route_to_destination( you, act, src_bub, stage ) ) {
+            unreachable_sources.emplace( src );
+            return std::nullopt;
+        }
+        return false;
+    }
 
-        bool ignore_contents = zone_sorting::ignore_contents( you, src );
+    bool ignore_contents = zone_sorting::ignore_contents( you, src );
 
-        if( zone_sorting::ignore_zone_position( you, src, ignore_contents ) ) {
-            continue;
-        }
+    if( zone_sorting::ignore_zone_position( you, src, ignore_contents ) ) {
+        return std::nullopt;
+    }
 
-        zone_sorting::unload_sort_options zone_unload_options = zone_sorting::set_unload_options( you, src,
-                true );
+    zone_sorting::unload_sort_options zone_unload_options = zone_sorting::set_unload_options( you, src,
+            true );
 
-        const zone_sorting::zone_items items = zone_sorting::populate_items( src_bub );
+    const zone_sorting::zone_items items = zone_sorting::populate_items( src_bub );
 
-        // check if there is valid destination for any item of the tile
-        bool pickup_failure;
-        bool has_items_to_work_on = zone_sorting::has_items_to_sort( you, src, zone_unload_options,
-                                    other_activity_items, items, &pickup_failure );
+    // check if there is valid destination for any item of the tile
+    bool pickup_failure;
+    bool has_items_to_work_on = zone_sorting::has_items_to_sort( you, src, zone_unload_options,
+                                other_activity_items, items, &pickup_failure );
 
-        if( pickup_failure && !pickup_failure_reported ) {
-            pickup_failure_reported = true;
-            add_msg_if_player_sees( you,
-                                    _( "At least one item to be sorted is too large/heavy for %s to sort.  "
-                                       "Emptying the inventory and freeing up the hands will allow for more efficient sorting." ),
-                                    you.disp_name() );
-        }
+    if( pickup_failure && !pickup_failure_reported ) {
+        pickup_failure_reported = true;
+        add_msg_if_player_sees( you,
+                                _( "At least one item to be sorted is too large/heavy for %s to sort.  "
+                                   "Emptying the inventory and freeing up the hands will allow for more efficient sorting." ),
+                                you.disp_name() );
+    }
 
-        if( !has_items_to_work_on ) {
-            continue;
-        }
+    if( !has_items_to_work_on ) {
+        return std::nullopt;
+    }
 
-        bool is_adjacent_or_closer = square_dist( you.pos_bub(), src_bub ) <= 1;
-        // before we move any item, check if player is at or
-        // adjacent to the loot source tile
-        if( !is_adjacent_or_closer ) {
+    bool is_adjacent_or_closer = square_dist( you.pos_bub(), src_bub ) <= 1;
+    // before we move any item, check if player is at or
+    // adjacent to the loot source tile
+    if( !is_adjacent_or_closer ) {
+        add_msg_debug( debugmode::DF_ACTIVITY,
+                       "zone_sort THINK: routing to source (%d,%d,%d) from (%d,%d)",
+                       src.x(), src.y(), src.z(),
+                       you.pos_bub().x(), you.pos_bub().y() );
+        // Route to source. Can't skip: post-cutoff fallback tiles weren't pre-evaluated by route_length.
+        if( !zone_sorting::route_to_destination( you, act, src_bub, stage ) ) {
             add_msg_debug( debugmode::DF_ACTIVITY,
-                           "zone_sort THINK: routing to source (%d,%d,%d) from (%d,%d)",
-                           src.x(), src.y(), src.z(),
-                           you.pos_bub().x(), you.pos_bub().y() );
-            // Route to source. Can't skip: post-cutoff fallback tiles weren't pre-evaluated by route_length.
-            if( !zone_sorting::route_to_destination( you, act, src_bub, stage ) ) {
-                add_msg_debug( debugmode::DF_ACTIVITY,
-                               "zone_sort THINK: route to source FAILED, trying next" );
-                continue;
-            }
-            return false;
+                           "zone_sort THINK: route to source FAILED, trying next" );
+            return std::nullopt;
         }
-        add_msg_debug( debugmode::DF_ACTIVITY,
-                       "zone_sort THINK: adjacent to source (%d,%d,%d), entering DO",
-                       src.x(), src.y(), src.z() );
-        stage = DO;
-        break;
+        return false;
     }
+    add_msg_debug( debugmode::DF_ACTIVITY,
+                   "zone_sort THINK: adjacent to source (%d,%d,%d), entering DO",
+                   src.x(), src.y(), src.z() );
+    stage = DO;
     return true;
 }
 
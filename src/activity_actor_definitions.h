@@ -4123,9 +4123,20 @@ class zone_sort_activity_actor : public zone_activity_actor
         // persists across do_turn re-entries within the same source.
         std::optional<tripoint_bub_ms> drag_worst_tile; // NOLINT(cata-serialize)
 
+        // Source tiles in the order zone_sorting::plan_sort_trips wants them visited.
+        // Replanned whenever the zones change, see zone_manager::get_zone_version.
+        std::vector<tripoint_abs_ms> planned_sources; // NOLINT(cata-serialize)
+        std::optional<int> planned_zone_version; // NOLINT(cata-serialize)
+
         // Returns all picked up items to the source tile and clears sorting state.
         // Used when routing to a destination fails.
         void return_items_to_source( Character &you, const tripoint_bub_ms &src_bub );
+        // Sources not yet ruled out, nearest by route first
+        std::vector<tripoint_abs_ms> route_sorted_sources( Character &you );
+        // Heads for src or starts working on it if it has anything to sort. Returns the result
+        // for stage_think, or nullopt if the next source should be tried.
+        std::optional<bool> think_about_source( player_activity &act, Character &you,
+                                                const tripoint_abs_ms &src );
 };
 
 #endif // CATA_SRC_ACTIVITY_ACTOR_DEFINITIONS_H
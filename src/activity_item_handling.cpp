@@ -5,7 +5,9 @@
 #include <climits>
 #include <cmath>
 #include <cstdlib>
+#include <iterator>
 #include <list>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -36,8 +38,10 @@
 #include "field_type.h"
 #include "fire.h"
 #include "flag.h"
+#include "flat_lru_cache.h"
 #include "game.h"
 #include "game_constants.h"
+#include "hash_utils.h"
 #include "iexamine.h"
 #include "inventory.h"
 #include "item.h"
@@ -68,10 +72,12 @@
 #include "requirements.h"
 #include "ret_val.h"
 #include "stomach.h"
+#include "submap.h"
 #include "temp_crafting_inventory.h"
 #include "translations.h"
 #include "trap.h"
 #include "units.h"
+#include "units_utility.h"
 #include "value_ptr.h"
 #include "veh_interact.h"
 #include "veh_type.h"
@@ -1355,6 +1361,90 @@ int route_length( const Character &you, const tripoint_bub_ms &dest )
     return route.empty() ? INT_MAX : static_cast<int>( route.size() );
 }
 
+std::vector<sort_trip> plan_sort_trips( Character &you, const std::vector<tripoint_abs_ms> &sources,
+                                        const std::vector<item_location> &other_activity_items )
+{
+    map &here = get_map();
+    const zone_manager &mgr = zone_manager::get_manager();
+    const faction_id fac_id = _fac_id( you );
+    const tripoint_abs_ms abspos = you.pos_abs();
+
+    units::volume capacity = you.free_space();
+    if( you.is_avatar() && you.as_avatar()->get_grab_type() == object_type::VEHICLE ) {
+        const tripoint_bub_ms cart_pos = you.pos_bub() + you.as_avatar()->grab_point;
+        if( std::optional<vpart_reference> ovp = here.veh_at( cart_pos ).cargo() ) {
+            capacity = std::max( capacity, ovp->items().free_volume() );
+        }
+    }
+
+    std::vector<sort_trip> pending;
+    for( const tripoint_abs_ms &src : sources ) {
+        const tripoint_bub_ms src_bub = here.get_bub( src );
+        if( !here.inbounds( src_bub ) || !mgr.has( zone_type_LOOT_UNSORTED, src, fac_id ) ) {
+            continue;
+        }
+        if( ignore_zone_position( you, src, ignore_contents( you, src ) ) ) {
+            continue;
+        }
+        const bool ignore_favorite = mgr.has( zone_type_LOOT_IGNORE_FAVORITES, src, fac_id );
+        std::map<zone_type_id, std::pair<units::volume, tripoint_abs_ms>> loads;
+        sort_trip trip;
+        trip.src = src;
+        for( const std::pair<item *, bool> &it_pair : populate_items( src_bub ) ) {
+            const item &it = *it_pair.first;
+            if( sort_skip_item( you, it_pair.first, other_activity_items, ignore_favorite, src ) ) {
+                continue;
+            }
+            const zone_type_id dest_type = mgr.get_near_zone_type_for_item( it, src,
+                                           MAX_VIEW_DISTANCE, fac_id );
+            if( dest_type.is_null() ) {
+                continue;
+            }
+            auto load = loads.find( dest_type );
+            if( load == loads.end() ) {
+                const std::optional<tripoint_abs_ms> nearest = mgr.get_nearest( dest_type, src,
+                        MAX_VIEW_DISTANCE, fac_id );
+                load = loads.emplace( dest_type, std::make_pair( 0_ml, nearest.value_or( src ) ) ).first;
+            }
+            load->second.first += it.volume();
+            trip.est_moves += activity_handlers::move_cost( it, src_bub,
+                              here.get_bub( load->second.second ) );
+        }
+        if( loads.empty() ) {
+            continue;
+        }
+        std::vector<std::pair<units::volume, zone_type_id>> by_size;
+        for( const auto &[type, load] : loads ) {
+            by_size.emplace_back( load.first, type );
+            // An item too big for the free space still goes one at a time.
+            trip.loads += capacity > 0_ml ? std::max( 1, divide_round_up( load.first, capacity ) ) : 1;
+        }
+        std::stable_sort( by_size.begin(), by_size.end(), []( const auto & lhs, const auto & rhs ) {
+            return lhs.first > rhs.first;
+        } );
+        for( const auto &entry : by_size ) {
+            trip.dest_types.push_back( entry.second );
+        }
+        trip.drop_point = loads[by_size.front().second].second;
+        pending.push_back( std::move( trip ) );
+    }
+
+    // Greedy chain: always head for the unvisited tile nearest to where we last dropped off.
+    std::vector<sort_trip> plan;
+    plan.reserve( pending.size() );
+    tripoint_abs_ms pos = abspos;
+    while( !pending.empty() ) {
+        auto next = std::min_element( pending.begin(), pending.end(),
+        [&pos]( const sort_trip & lhs, const sort_trip & rhs ) {
+            return square_dist( pos, lhs.src ) < square_dist( pos, rhs.src );
+        } );
+        pos = next->drop_point;
+        plan.push_back( std::move( *next ) );
+        pending.erase( next );
+    }
+    return plan;
+}
+
 std::optional<tripoint_bub_ms> worst_drag_tile_on_route(
     const Character &who, const std::vector<tripoint_abs_ms> &dropoff_coords )
 {
@@ -1512,32 +1602,30 @@ bool _can_construct(
              can_construct( check, loc ) );
 }
 
-construction const *
-_find_alt_construction( tripoint_bub_ms const &loc, construction_id const &idx,
-                        std::optional<construction_id> const &part_con_idx,
-                        std::function<bool( construction const & )> const &filter )
-{
-    std::vector<construction *> cons = constructions_by_filter( filter );
-    for( construction const *el : cons ) {
-        if( _can_construct( loc, idx, *el, part_con_idx ) ) {
-            return el;
-        }
-    }
-    return nullptr;
-}
-
 template <class ID>
 ID _get_id( construction_id const &idx )
 {
     return idx->post_terrain.empty() ? ID() : ID( idx->post_terrain );
 }
 
+// What find_base_construction tries for a blueprint when it can't be built as it is, in the
+// order it tries them. That order depends on the construction data alone.
+struct blueprint_step {
+    // The construction the step leads to, _can_construct checks that it doesn't undo it
+    construction_id leads_to;
+    construction const *con;
+};
+struct blueprint_plan {
+    // Variants from the same group
+    std::vector<blueprint_step> alternatives;
+    // Prerequisites from other groups, depth first
+    std::vector<blueprint_step> prereqs;
+};
+
 using checked_cache_t = std::vector<construction_id>;
-construction const *_find_prereq( tripoint_bub_ms const &loc, construction_id const &idx,
-                                  construction_id const &top_idx,
-                                  std::optional<construction_id> const &part_con_idx, checked_cache_t &checked_cache )
+void _add_prereqs( blueprint_plan &plan, construction_id const &idx,
+                   construction_id const &top_idx, checked_cache_t &checked_cache )
 {
-    construction const *con = nullptr;
     std::vector<construction *> cons = constructions_by_filter( [&idx, &top_idx](
     construction const & it ) {
         furn_id const f = top_idx->post_is_furniture ? _get_id<furn_id>( top_idx ) : furn_id();
@@ -1555,15 +1643,78 @@ construction const *_find_prereq( tripoint_bub_ms const &loc, construction_id co
             continue;
         }
         checked_cache.emplace_back( gcon->id );
-        if( _can_construct( loc, idx, *gcon, part_con_idx ) ) {
-            return gcon;
-        }
-        // try to find a prerequisite of this prerequisite
+        plan.prereqs.push_back( { idx, gcon } );
+        // then the prerequisites of this prerequisite
         if( !gcon->pre_terrain.empty() || !gcon->pre_flags.empty() ) {
-            con = _find_prereq( loc, gcon->id, top_idx, part_con_idx, checked_cache );
+            _add_prereqs( plan, gcon->id, top_idx, checked_cache );
+        }
+    }
+}
+
+const blueprint_plan &_blueprint_plan( construction_id const &idx )
+{
+    static int version = -1;
+    static std::unordered_map<construction_id, blueprint_plan> plans;
+    if( version != constructions_version() ) {
+        plans.clear();
+        version = constructions_version();
+    }
+    auto found = plans.try_emplace( idx );
+    blueprint_plan &plan = found.first->second;
+    if( found.second ) {
+        for( construction const *alt : constructions_by_group( idx->group ) ) {
+            plan.alternatives.push_back( { idx, alt } );
         }
-        if( con != nullptr ) {
-            return con;
+        if( !idx->strict ) {
+            checked_cache_t checked_cache;
+            for( construction const *vcon : constructions_by_group( idx->group ) ) {
+                _add_prereqs( plan, vcon->id, vcon->id, checked_cache );
+            }
+        }
+    }
+    return plan;
+}
+
+// The steps of the plan for @p idx that the furniture and terrain of a tile allow. Every
+// tile of a large blueprint tends to have the same, so they share the result.
+std::shared_ptr<const blueprint_plan> _blueprint_plan_on( construction_id const &idx,
+        furn_id const &f, ter_id const &t )
+{
+    using key_t = std::tuple<construction_id, furn_id, ter_id>;
+    static int version = -1;
+    static flat_lru_cache<key_t, std::shared_ptr<const blueprint_plan>, cata::tuple_hash> cache( 256,
+            "blueprint_plans" );
+    if( version != constructions_version() ) {
+        cache.clear();
+        version = constructions_version();
+    }
+    const key_t key( idx, f, t );
+    std::shared_ptr<const blueprint_plan> ret = cache.get( key, nullptr );
+    if( ret ) {
+        return ret;
+    }
+    const blueprint_plan &plan = _blueprint_plan( idx );
+    const auto allowed = [&f, &t]( const blueprint_step & step ) {
+        return step.con->pre_terrain.find( step.leads_to->post_terrain ) == step.con->pre_terrain.end() &&
+               can_construct_on( *step.con, f, t );
+    };
+    blueprint_plan on_tile;
+    std::copy_if( plan.alternatives.begin(), plan.alternatives.end(),
+                  std::back_inserter( on_tile.alternatives ), allowed );
+    std::copy_if( plan.prereqs.begin(), plan.prereqs.end(), std::back_inserter( on_tile.prereqs ),
+                  allowed );
+    ret = std::make_shared<const blueprint_plan>( std::move( on_tile ) );
+    cache.insert( key, ret );
+    return ret;
+}
+
+construction const *_first_buildable( tripoint_bub_ms const &loc,
+                                      std::vector<blueprint_step> const &steps,
+                                      std::optional<construction_id> const &part_con_idx )
+{
+    for( const blueprint_step &step : steps ) {
+        if( _can_construct( loc, step.leads_to, *step.con, part_con_idx ) ) {
+            return step.con;
         }
     }
     return nullptr;
@@ -1595,19 +1746,18 @@ static activity_reason_info find_base_construction(
     construction const *con = nullptr;
 
     if( !cc ) {
+        // A partial construction may be any step, whatever the tile is like
+        std::shared_ptr<const blueprint_plan> on_tile;
+        if( !part_con_idx ) {
+            const map &here = get_map();
+            on_tile = _blueprint_plan_on( idx, here.furn( loc ), here.ter( loc ) );
+        }
+        const blueprint_plan &plan = on_tile ? *on_tile : _blueprint_plan( idx );
         // try to build a variant from the same group
-        con = _find_alt_construction( loc, idx, part_con_idx, [&idx]( construction const & it ) {
-            return it.group == idx->group;
-        } );
-        if( !idx->strict && con == nullptr ) {
+        con = _first_buildable( loc, plan.alternatives, part_con_idx );
+        if( con == nullptr ) {
             // try to build a pre-requisite from a different group, recursively
-            checked_cache_t checked_cache;
-            for( construction const *vcon : constructions_by_group( idx->group ) ) {
-                con = _find_prereq( loc, vcon->id, vcon->id, part_con_idx, checked_cache );
-                if( con != nullptr ) {
-                    break;
-                }
-            }
+            con = _first_buildable( loc, plan.prereqs, part_con_idx );
         }
         cc = con != nullptr;
     }
@@ -1638,15 +1788,124 @@ static activity_reason_info find_base_construction(
     return activity_reason_info::build( do_activity_reason::CAN_DO_CONSTRUCTION, true, build.id );
 }
 
+namespace
+{
+
+constexpr time_duration skipped_location_lifetime = 1_minutes;
+
+struct skipped_location {
+    requirement_check_result result;
+    time_point when;
+    int zone_version;
+    uint64_t inventory_version;
+    // Of the submaps around the location, or of every submap if fetching was considered
+    uint64_t content_version;
+    bool needed_fetch;
+};
+
+using skipped_locations = std::unordered_map<tripoint_abs_ms, skipped_location>;
+
+std::map<std::pair<character_id, activity_id>, skipped_locations> &skipped_locations_by_worker()
+{
+    static std::map<std::pair<character_id, activity_id>, skipped_locations> skipped;
+    return skipped;
+}
+
+uint64_t skip_content_version( const tripoint_bub_ms &src_loc, bool needed_fetch )
+{
+    // The crafting inventories multi_activity_can_do asks for reach PICKUP_RANGE from next
+    // to the location
+    return needed_fetch ? submap::get_total_content_version() :
+           get_map().content_version( src_loc, PICKUP_RANGE + 1 );
+}
+
+// The items on one loot tile that a fetch could use, shared by every worker of a faction that
+// looks at the tile during the same turn. Only this turn's entries are kept, so the pointers
+// never outlive a map shift or a save.
+struct fetchable_tile {
+    uint64_t content_version;
+    int zone_version;
+    std::vector<item *> items;
+};
+
+const std::vector<item *> &fetchable_items_at( map &here, const tripoint_bub_ms &p,
+        const faction_id &fac )
+{
+    static time_point index_turn = calendar::before_time_starts;
+    static tripoint_abs_sm index_abs_sub;
+    static std::map<faction_id, std::unordered_map<tripoint_abs_ms, fetchable_tile>> index;
+    if( index_turn != calendar::turn || index_abs_sub != here.get_abs_sub() ) {
+        index.clear();
+        index_turn = calendar::turn;
+        index_abs_sub = here.get_abs_sub();
+    }
+    zone_manager &mgr = zone_manager::get_manager();
+    const tripoint_abs_ms abs_p = here.get_abs( p );
+    const uint64_t version = here.content_version( p );
+    auto found = index[fac].try_emplace( abs_p );
+    fetchable_tile &tile = found.first->second;
+    if( found.second || tile.content_version != version ||
+        tile.zone_version != mgr.get_zone_version() ) {
+        tile.content_version = version;
+        tile.zone_version = mgr.get_zone_version();
+        tile.items.clear();
+        // skip tiles in IGNORE zone and inaccessible furniture, like filled charcoal kiln
+        if( !mgr.has( zone_type_LOOT_IGNORE, abs_p, fac ) && here.can_put_items_ter_furn( p ) ) {
+            for( item &it : here.i_at( p ) ) {
+                if( !it.made_of_from_type( phase_id::LIQUID ) ) {
+                    tile.items.push_back( &it );
+                }
+            }
+        }
+    }
+    return tile.items;
+}
+
+} // namespace
+
 namespace multi_activity_actor
 {
 
+bool remembers_skips( const activity_id &act_id )
+{
+    return act_id != ACT_VEHICLE_DECONSTRUCTION && act_id != ACT_VEHICLE_REPAIR;
+}
+
+std::optional<requirement_check_result> remembered_skip( Character &you, const activity_id &act_id,
+        const tripoint_abs_ms &src, const tripoint_bub_ms &src_loc )
+{
+    auto by_worker = skipped_locations_by_worker().find( { you.getID(), act_id } );
+    if( by_worker == skipped_locations_by_worker().end() ) {
+        return std::nullopt;
+    }
+    auto found = by_worker->second.find( src );
+    if( found == by_worker->second.end() ) {
+        return std::nullopt;
+    }
+    const skipped_location &skip = found->second;
+    if( calendar::turn < skip.when || calendar::turn - skip.when >= skipped_location_lifetime ||
+        skip.zone_version != zone_manager::get_manager().get_zone_version() ||
+        skip.inventory_version != you.get_inventory_version() ||
+        skip.content_version != skip_content_version( src_loc, skip.needed_fetch ) ) {
+        by_worker->second.erase( found );
+        return std::nullopt;
+    }
+    return skip.result;
+}
+
+void remember_skip( Character &you, const activity_id &act_id, const tripoint_abs_ms &src,
+                    const tripoint_bub_ms &src_loc, requirement_check_result result, bool needed_fetch )
+{
+    skipped_locations_by_worker()[ { you.getID(), act_id }][src] = skipped_location{
+        result, calendar::turn, zone_manager::get_manager().get_zone_version(),
+        you.get_inventory_version(), skip_content_version( src_loc, needed_fetch ), needed_fetch };
+}
+
 bool are_requirements_nearby(
     const std::vector<tripoint_bub_ms> &loot_spots, const requirement_id &needed_things,
     Character &you, const activity_id &activity_to_restore, const bool in_loot_zones,
     const tripoint_bub_ms &src_loc )
 {
-    zone_manager &mgr = zone_manager::get_manager();
     temp_crafting_inventory temp_inv;
     units::volume volume_allowed;
     units::mass weight_allowed;
@@ -1677,41 +1936,31 @@ bool are_requirements_nearby(
         temp_inv.add_item_ref( *elem );
     }
     map &here = get_map();
+    const faction_id fac = _fac_id( you );
     for( const tripoint_bub_ms &elem : loot_spots ) {
         // if we are searching for things to fetch, we can skip certain things.
         // if, however they are already near the work spot, then the crafting / inventory functions will have their own method to use or discount them.
         if( in_loot_zones ) {
-            // skip tiles in IGNORE zone and tiles on fire
-            // (to prevent taking out wood off the lit brazier)
-            // and inaccessible furniture, like filled charcoal kiln
-            if( mgr.has( zone_type_LOOT_IGNORE, here.get_abs( elem ), _fac_id( you ) ) ||
-                here.dangerous_field_at( elem ) ||
-                !here.can_put_items_ter_furn( elem ) ) {
+            // skip tiles on fire (to prevent taking out wood off the lit brazier)
+            if( here.dangerous_field_at( elem ) ) {
                 continue;
             }
-        }
-        for( item &elem2 : here.i_at( elem ) ) {
-            if( in_loot_zones ) {
-                if( elem2.made_of_from_type( phase_id::LIQUID ) ) {
+            for( item *elem2 : fetchable_items_at( here, elem, fac ) ) {
+                // this fetch task will need to pick up an item. so check for its weight/volume before setting off.
+                if( check_weight && ( elem2->volume() > volume_allowed ||
+                                      elem2->weight() > weight_allowed ) ) {
                     continue;
                 }
-
-                if( check_weight ) {
-                    // this fetch task will need to pick up an item. so check for its weight/volume before setting off.
-                    if( elem2.volume() > volume_allowed ||
-                        elem2.weight() > weight_allowed ) {
-                        continue;
-                    }
-                }
+                temp_inv.add_item_ref( *elem2 );
             }
+            continue;
+        }
+        for( item &elem2 : here.i_at( elem ) ) {
             temp_inv.add_item_ref( elem2 );
         }
-
-        if( !in_loot_zones ) {
-            if( const std::optional<vpart_reference> ovp = here.veh_at( elem ).cargo() ) {
-                for( item &it : ovp->items() ) {
-                    temp_inv.add_item_ref( it );
-                }
+        if( const std::optional<vpart_reference> ovp = here.veh_at( elem ).cargo() ) {
+            for( item &it : ovp->items() ) {
+                temp_inv.add_item_ref( it );
             }
         }
     }
@@ -2121,6 +2370,15 @@ activity_reason_info multi_build_construction_activity_actor::multi_activity_can
     if( part_con ) {
         part_con_idx = part_con->id;
     }
+    // Much of a large blueprint is usually built already, rule those tiles out before looking
+    // for a route to them.
+    if( !zones.empty() ) {
+        const construction_id index = dynamic_cast<const blueprint_options &>
+                                      ( zones.front().get_options() ).get_index();
+        if( already_done( index.obj(), src_loc ) ) {
+            return activity_reason_info::build( do_activity_reason::ALREADY_DONE, false, index );
+        }
+    }
 
     tripoint_bub_ms nearest_src_loc;
     if( square_dist( you.pos_bub(), src_loc ) == 1 ) {
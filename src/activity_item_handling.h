@@ -118,6 +118,28 @@ void move_item( Character &you, const std::optional<vpart_reference> &vpr_src,
                 const tripoint_bub_ms &src_bub, const std::unordered_set<tripoint_abs_ms> &dest_set,
                 item &it, int &num_processed );
 
+// One visit to a source tile in a sorting pass.
+struct sort_trip {
+    tripoint_abs_ms src;
+    // Destination zone types of the sortable items there, biggest load first
+    std::vector<zone_type_id> dest_types;
+    // How many times the load has to be carried, given the free carry or cart space
+    int loads = 0;
+    // Estimated moves to carry everything off the tile, see activity_handlers::move_cost
+    int est_moves = 0;
+    // Where the biggest load is dropped off, the next trip starts from here
+    tripoint_abs_ms drop_point;
+};
+
+/**
+ * Plans a whole sorting pass at once: classifies the items of every tile in `sources` a
+ * single time, groups them by destination type and carry capacity, and orders the trips so
+ * each one starts from the tile nearest to where the previous one dropped off.
+ * Tiles with nothing to sort are left out. No pathfinding is done.
+ */
+std::vector<sort_trip> plan_sort_trips( Character &you, const std::vector<tripoint_abs_ms> &sources,
+                                        const std::vector<item_location> &other_activity_items );
+
 // Returns A* route length from the player to a tile adjacent to dest.
 // Uses grab-aware routing when the player is dragging a vehicle.
 // Returns INT_MAX if unreachable.
@@ -191,4 +213,17 @@ bool are_requirements_nearby(
     Character &you, const activity_id &activity_to_restore, bool in_loot_zones,
     const tripoint_bub_ms &src_loc );
 
+/**
+ * Locations a worker's multi-activity skipped are remembered, so the next passes skip them again
+ * without asking multi_activity_can_do and scanning for requirements. A skip holds while the
+ * zones, the worker's inventory and the map around the location stay the same, or the loot
+ * anywhere when fetching was considered, and for no longer than a minute.
+ */
+std::optional<requirement_check_result> remembered_skip( Character &you, const activity_id &act_id,
+        const tripoint_abs_ms &src, const tripoint_bub_ms &src_loc );
+void remember_skip( Character &you, const activity_id &act_id, const tripoint_abs_ms &src,
+                    const tripoint_bub_ms &src_loc, requirement_check_result result, bool needed_fetch );
+// Vehicle work can change without touching the map, so it is never remembered
+bool remembers_skips( const activity_id &act_id );
+
 } //namespace multi_activity_actor
@@ -49,6 +49,11 @@ using namespace auto_pickup;
 
 static const ammotype ammo_battery( "battery" );
 
+static const option_handle<bool> option_auto_pickup( "AUTO_PICKUP" );
+static const option_handle<bool> option_auto_pickup_owned( "AUTO_PICKUP_OWNED" );
+static const option_handle<int> option_auto_pickup_weight_limit( "AUTO_PICKUP_WEIGHT_LIMIT" );
+static const option_handle<int> option_auto_pickup_volume_limit( "AUTO_PICKUP_VOLUME_LIMIT" );
+
 static bool check_special_rule( const std::map<material_id, int> &materials,
                                 std::string_view rule );
 
@@ -67,8 +72,8 @@ static bool within_autopickup_limits( const item *pickup_item )
 {
     bool valid_item = !pickup_item->has_any_flag( cata::flat_set<flag_id> { flag_ZERO_WEIGHT, flag_NO_DROP } );
 
-    int weight_limit = get_option<int>( "AUTO_PICKUP_WEIGHT_LIMIT" );
-    int volume_limit = get_option<int>( "AUTO_PICKUP_VOLUME_LIMIT" );
+    int weight_limit = option_auto_pickup_weight_limit.get();
+    int volume_limit = option_auto_pickup_volume_limit.get();
 
     bool valid_volume = pickup_item->volume() <= volume_limit * 50_ml;
     bool valid_weight = pickup_item->weight() <= weight_limit * 50_gram;
@@ -161,7 +166,7 @@ static std::vector<item_location> get_autopickup_items( item_location &from )
 
     std::vector<item_location> result;
     // do not auto pickup owned containers or items
-    if( !get_option<bool>( "AUTO_PICKUP_OWNED" ) &&
+    if( !option_auto_pickup_owned.get() &&
         container_item->is_owned_by( get_player_character() ) ) {
         return result;
     }
@@ -271,7 +276,7 @@ drop_locations auto_pickup::select_items(
         }
 
         // do not auto pickup owned containers or items
-        if( !get_option<bool>( "AUTO_PICKUP_OWNED" ) &&
+        if( !option_auto_pickup_owned.get() &&
             item_entry->is_owned_by( get_player_character() ) ) {
             continue;
         }
@@ -378,7 +383,7 @@ void user_interface::show()
         // Redraw the header
         // NOLINTNEXTLINE(cata-use-named-point-constants)
         mvwhline( w_header, point( 0, 0 ), ' ', FULL_SCREEN_WIDTH - 2 );  // clear the line
-        const bool enabled = get_option<bool>( "AUTO_PICKUP" );
+        const bool enabled = option_auto_pickup.get();
         nc_color color = c_white;
         // NOLINTNEXTLINE(cata-use-named-point-constants)
         print_colored_text( w_header, point( 1, 0 ), color, c_white, string_format( "%s %s",
@@ -713,7 +718,7 @@ void player_settings::add_rule( const item *it, bool include )
     character_rules.push_back( rule( it->tname( 1, false ), true, !include ) );
     create_rule( it );
 
-    if( !get_option<bool>( "AUTO_PICKUP" ) &&
+    if( !option_auto_pickup.get() &&
         query_yn( _( "Auto pickup is not enabled in the options.  Enable it now?" ) ) ) {
         get_options().get_option( "AUTO_PICKUP" ).setNext();
         get_options().save();
@@ -50,6 +50,7 @@
 #include "map_memory.h"
 #include "map_scale_constants.h"
 #include "martialarts.h"
+#include "memory_report.h"
 #include "messages.h"
 #include "mission.h"
 #include "move_mode.h"
@@ -249,6 +250,12 @@ void avatar::clear_map_memory()
     player_map_memory->clear();
 }
 
+void avatar::add_memory_usage( memory_report::report &out ) const
+{
+    player_map_memory->add_memory_usage( out );
+    out.add_items( "avatar_items", *this );
+}
+
 void avatar::prepare_map_memory_region( const tripoint_abs_ms &p1, const tripoint_abs_ms &p2 )
 {
     player_map_memory->prepare_region( p1, p2 );
@@ -1280,7 +1287,8 @@ void avatar::set_movement_mode( const move_mode_id &new_mode )
         recalculate_enchantment_cache();
         // crouching affects visibility
         //TODO: Replace with dirtying vision_transparency_cache
-        here.set_transparency_cache_dirty( pos_bub() );
+        here.set_transparency_cache_dirty( pos_bub() + tripoint_rel_ms( -1, -1, 0 ),
+                                           pos_bub() + tripoint_rel_ms( 1, 1, 0 ) );
         here.set_seen_cache_dirty( posz() );
         recoil = MAX_RECOIL;
     } else {
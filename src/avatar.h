@@ -49,6 +49,10 @@ namespace debug_menu
 {
 class mission_debug;
 }  // namespace debug_menu
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 enum class pool_type;
 
 // Monster visible in different directions (safe mode & compass)
@@ -100,6 +104,8 @@ class avatar : public Character
         bool save_map_memory();
         void load_map_memory();
         void clear_map_memory();
+        /** Adds the map memory and the carried items to @p out. */
+        void add_memory_usage( memory_report::report &out ) const;
 
         // newcharacter.cpp
         bool create( character_type type, const std::string &tempname = "" );
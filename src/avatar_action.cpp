@@ -204,7 +204,9 @@ bool avatar_action::move( avatar &you, map &m, const tripoint_rel_ms &d )
                              you.is_running();
     const bool is_prone = you.is_prone();
     if( is_crouching || is_prone || low_profile ) {
-        m.set_transparency_cache_dirty( d.z() );
+        const tripoint_bub_ms dest = you.pos_bub() + d;
+        m.set_transparency_cache_dirty( dest + tripoint_rel_ms( -1, -1, 0 ),
+                                        dest + tripoint_rel_ms( 1, 1, 0 ) );
     }
 
     // If any leg broken without crutches and not already on the ground topple over
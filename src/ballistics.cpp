@@ -192,6 +192,43 @@ static void drop_or_embed_projectile( map *here, const dealt_projectile_attack &
     }
 }
 
+// Enough for the distinct lines of a shotgun shell or a long burst.
+static constexpr size_t max_burst_paths = 16;
+
+projectile_burst::projectile_burst( const map &here ) : here( &here ),
+    generation( here.get_sight_generation() )
+{
+}
+
+std::vector<tripoint_bub_ms> projectile_burst::clear_path( const tripoint_bub_ms &from,
+        const tripoint_bub_ms &to )
+{
+    // Paths across z-levels depend on floors, which the generation doesn't follow.
+    if( from.z() != to.z() ) {
+        ++traced_paths;
+        return here->find_clear_path( from, to );
+    }
+    if( generation != here->get_sight_generation() ) {
+        generation = here->get_sight_generation();
+        paths.clear();
+        next_replaced = 0;
+    }
+    for( const path_entry &entry : paths ) {
+        if( entry.from == from && entry.to == to ) {
+            return entry.path;
+        }
+    }
+    ++traced_paths;
+    path_entry found{ from, to, here->find_clear_path( from, to ) };
+    if( paths.size() < max_burst_paths ) {
+        paths.push_back( found );
+    } else {
+        paths[next_replaced] = found;
+        next_replaced = ( next_replaced + 1 ) % max_burst_paths;
+    }
+    return std::move( found.path );
+}
+
 static size_t blood_trail_len( int damage )
 {
     if( damage > 50 ) {
@@ -245,8 +282,13 @@ void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_
 void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_arg,
                         map *here, const tripoint_bub_ms &source, const tripoint_bub_ms &target_arg,
                         const dispersion_sources &dispersion, Creature *origin, const vehicle *in_veh,
-                        const weakpoint_attack &wp_attack )
+                        const weakpoint_attack &wp_attack, projectile_burst *burst )
 {
+    // The pellets of one shot share their trajectories even if the caller keeps no burst.
+    std::optional<projectile_burst> own_burst;
+    if( burst == nullptr ) {
+        burst = &own_burst.emplace( *here );
+    }
     const bool do_animation = get_option<bool>( "ANIMATION_PROJECTILES" );
 
     double range = rl_dist( source, target_arg );
@@ -355,7 +397,7 @@ void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_
     }
 
     //Use find clear path to draw the trajectory with optimal initial tile offsets.
-    trajectory = here->find_clear_path( source, target );
+    trajectory = burst->clear_path( source, target );
 
     add_msg_debug( debugmode::DF_BALLISTIC,
                    "missed_by_tiles: %.2f; missed_by: %.2f; target (orig/hit): %s/%s",
@@ -415,7 +457,7 @@ void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_
                     target_c.x() = source.x() + sgn( dx );
                     target_c.y() = source.y() + sgn( dy );
                 }
-                t_copy = here->find_clear_path( first_p, target_c );
+                t_copy = burst->clear_path( first_p, target_c );
                 // point-blank tile should be the same
                 t_copy.insert( t_copy.begin(), first_p );
                 t_copy.insert( t_copy.begin(), source );
@@ -683,7 +725,8 @@ void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_
             Creature &z = *mon_ptr;
             attack.targets_hit[&z].first += 0;
             add_msg( _( "The attack bounced to %s!" ), z.get_name() );
-            projectile_attack( attack, proj, here, tp, z.pos_bub(), dispersion, origin, in_veh );
+            projectile_attack( attack, proj, here, tp, z.pos_bub(), dispersion, origin, in_veh,
+                               weakpoint_attack(), burst );
             // TODO: Refine to handle overlapping maps
             if( here == &reality_bubble() ) {
                 sfx::play_variant_sound( "fire_gun", "bio_lightning_tail",
@@ -9,7 +9,7 @@
 #include <utility>
 #include <vector>
 
-#include "coords_fwd.h"
+#include "coordinates.h"
 #include "weakpoint.h"
 #include "weighted_list.h"
 
@@ -30,6 +30,38 @@ struct projectile_attack_aim {
     double dispersion = 0;
 };
 
+/**
+ * What the projectiles of one firing action share: the trajectories found so far. The shots
+ * of a burst and the pellets of a shell mostly fly along the same few lines, and finding one
+ * traces several sight lines. A trajectory is only reused between tiles on one z-level, and
+ * while the map's sight generation is still the one it was found at.
+ */
+class projectile_burst
+{
+    public:
+        explicit projectile_burst( const map &here );
+
+        /** The same as map::find_clear_path( @p from, @p to ). */
+        std::vector<tripoint_bub_ms> clear_path( const tripoint_bub_ms &from, const tripoint_bub_ms &to );
+        /** How many trajectories had to be traced, for tests. */
+        int traced() const {
+            return traced_paths;
+        }
+
+    private:
+        struct path_entry {
+            tripoint_bub_ms from;
+            tripoint_bub_ms to;
+            std::vector<tripoint_bub_ms> path;
+        };
+
+        const map *here;
+        int generation;
+        std::vector<path_entry> paths;
+        size_t next_replaced = 0;
+        int traced_paths = 0;
+};
+
 /**
  * Evaluates dispersion sources, range, and target to determine attack trajectory.
  **/
@@ -46,10 +78,14 @@ void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_
                         const dispersion_sources &dispersion, Creature *origin = nullptr, const vehicle *in_veh = nullptr,
                         const weakpoint_attack &wp_attack = weakpoint_attack() );
 
+/**
+ * As above, on map @p here. Callers firing several times in a row at nearly the same spot pass
+ * the same @p burst to each, so the trajectories are traced once for all of them.
+ */
 void projectile_attack( dealt_projectile_attack &attack, const projectile &proj_arg,
                         map *here, const tripoint_bub_ms &source, const tripoint_bub_ms &target_arg,
                         const dispersion_sources &dispersion, Creature *origin = nullptr, const vehicle *in_veh = nullptr,
-                        const weakpoint_attack &wp_attack = weakpoint_attack() );
+                        const weakpoint_attack &wp_attack = weakpoint_attack(), projectile_burst *burst = nullptr );
 
 /* Used for selecting which part to target in a projectile attack
  * Primarily a template for ease of testing, but can be reused!
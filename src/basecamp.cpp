@@ -1,14 +1,18 @@
 #include "basecamp.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "activity_type.h"
 #include "avatar.h"
 #include "build_reqs.h"
 #include "calendar.h"
@@ -29,6 +33,7 @@
 #include "input_popup.h"
 #include "inventory.h"
 #include "item.h"
+#include "item_factory.h"
 #include "itype.h"
 #include "iuse_actor.h"
 #include "llm_intent.h"
@@ -38,9 +43,11 @@
 #include "mapdata.h"
 #include "messages.h"
 #include "npc.h"
+#include "options.h"
 #include "output.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
+#include "pathfinding.h"
 #include "recipe.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
@@ -215,69 +222,253 @@ bool camp_locker_slot_plan::has_changes() const {
 }
 
 namespace {
-bool armor_covers_any(const item &it,
-                      const std::initializer_list<std::string_view> &parts) {
-  const islot_armor *armor = it.find_armor_data();
-  if (armor == nullptr) {
-    return false;
+// Bits of camp_locker_type_profile::covers, by body part
+enum camp_locker_bp : uint32_t {
+  locker_bp_torso = 1U << 0,
+  locker_bp_arm_l = 1U << 1,
+  locker_bp_arm_r = 1U << 2,
+  locker_bp_leg_l = 1U << 3,
+  locker_bp_leg_r = 1U << 4,
+  locker_bp_head = 1U << 5,
+  locker_bp_eyes = 1U << 6,
+  locker_bp_mouth = 1U << 7,
+  locker_bp_hand_l = 1U << 8,
+  locker_bp_hand_r = 1U << 9,
+  locker_bp_foot_l = 1U << 10,
+  locker_bp_foot_r = 1U << 11,
+};
+
+// Bits of camp_locker_type_profile::sub_covers, by sub body part
+enum camp_locker_sbp : uint32_t {
+  locker_sbp_torso_upper = 1U << 0,
+  locker_sbp_torso_lower = 1U << 1,
+  locker_sbp_torso_waist = 1U << 2,
+  locker_sbp_arm_upper_l = 1U << 3,
+  locker_sbp_arm_upper_r = 1U << 4,
+  locker_sbp_arm_lower_l = 1U << 5,
+  locker_sbp_arm_lower_r = 1U << 6,
+  locker_sbp_hand_l = 1U << 7,
+  locker_sbp_hand_r = 1U << 8,
+  locker_sbp_leg_hip_l = 1U << 9,
+  locker_sbp_leg_hip_r = 1U << 10,
+  locker_sbp_leg_upper_l = 1U << 11,
+  locker_sbp_leg_upper_r = 1U << 12,
+  locker_sbp_leg_knee_l = 1U << 13,
+  locker_sbp_leg_knee_r = 1U << 14,
+  locker_sbp_leg_lower_l = 1U << 15,
+  locker_sbp_leg_lower_r = 1U << 16,
+  locker_sbp_leg_draped_l = 1U << 17,
+  locker_sbp_leg_draped_r = 1U << 18,
+  locker_sbp_foot_l = 1U << 19,
+  locker_sbp_foot_r = 1U << 20,
+  locker_sbp_head = 1U << 21,
+  locker_sbp_eye_l = 1U << 22,
+  locker_sbp_eye_r = 1U << 23,
+  locker_sbp_mouth = 1U << 24,
+};
+
+constexpr std::array<std::pair<std::string_view, uint32_t>, 12>
+    camp_locker_bp_bits = {{
+    {"torso", locker_bp_torso},
+    {"arm_l", locker_bp_arm_l},
+    {"arm_r", locker_bp_arm_r},
+    {"leg_l", locker_bp_leg_l},
+    {"leg_r", locker_bp_leg_r},
+    {"head", locker_bp_head},
+    {"eyes", locker_bp_eyes},
+    {"mouth", locker_bp_mouth},
+    {"hand_l", locker_bp_hand_l},
+    {"hand_r", locker_bp_hand_r},
+    {"foot_l", locker_bp_foot_l},
+    {"foot_r", locker_bp_foot_r},
+}};
+
+constexpr std::array<std::pair<std::string_view, uint32_t>, 25>
+    camp_locker_sbp_bits = {{
+    {"torso_upper", locker_sbp_torso_upper},
+    {"torso_lower", locker_sbp_torso_lower},
+    {"torso_waist", locker_sbp_torso_waist},
+    {"arm_upper_l", locker_sbp_arm_upper_l},
+    {"arm_upper_r", locker_sbp_arm_upper_r},
+    {"arm_lower_l", locker_sbp_arm_lower_l},
+    {"arm_lower_r", locker_sbp_arm_lower_r},
+    {"hand_l", locker_sbp_hand_l},
+    {"hand_r", locker_sbp_hand_r},
+    {"leg_hip_l", locker_sbp_leg_hip_l},
+    {"leg_hip_r", locker_sbp_leg_hip_r},
+    {"leg_upper_l", locker_sbp_leg_upper_l},
+    {"leg_upper_r", locker_sbp_leg_upper_r},
+    {"leg_knee_l", locker_sbp_leg_knee_l},
+    {"leg_knee_r", locker_sbp_leg_knee_r},
+    {"leg_lower_l", locker_sbp_leg_lower_l},
+    {"leg_lower_r", locker_sbp_leg_lower_r},
+    {"leg_draped_l", locker_sbp_leg_draped_l},
+    {"leg_draped_r", locker_sbp_leg_draped_r},
+    {"foot_l", locker_sbp_foot_l},
+    {"foot_r", locker_sbp_foot_r},
+    {"head", locker_sbp_head},
+    {"eye_l", locker_sbp_eye_l},
+    {"eye_r", locker_sbp_eye_r},
+    {"mouth", locker_sbp_mouth},
+}};
+
+constexpr uint32_t locker_sbp_upper_body =
+    locker_sbp_torso_upper | locker_sbp_torso_lower | locker_sbp_arm_upper_l |
+    locker_sbp_arm_upper_r | locker_sbp_arm_lower_l | locker_sbp_arm_lower_r |
+    locker_sbp_hand_l | locker_sbp_hand_r;
+constexpr uint32_t locker_sbp_face =
+    locker_sbp_head | locker_sbp_eye_l | locker_sbp_eye_r | locker_sbp_mouth;
+constexpr uint32_t locker_sbp_hips =
+    locker_sbp_leg_hip_l | locker_sbp_leg_hip_r;
+constexpr uint32_t locker_sbp_thighs =
+    locker_sbp_leg_upper_l | locker_sbp_leg_upper_r;
+constexpr uint32_t locker_sbp_lower_legs =
+    locker_sbp_leg_knee_l | locker_sbp_leg_knee_r | locker_sbp_leg_lower_l |
+    locker_sbp_leg_lower_r;
+constexpr uint32_t locker_sbp_draped_legs =
+    locker_sbp_leg_draped_l | locker_sbp_leg_draped_r;
+constexpr uint32_t locker_sbp_feet = locker_sbp_foot_l | locker_sbp_foot_r;
+constexpr uint32_t locker_bp_arms = locker_bp_arm_l | locker_bp_arm_r;
+constexpr uint32_t locker_bp_legs = locker_bp_leg_l | locker_bp_leg_r;
+constexpr uint32_t locker_bp_hands = locker_bp_hand_l | locker_bp_hand_r;
+constexpr uint32_t locker_bp_feet = locker_bp_foot_l | locker_bp_foot_r;
+
+// What the locker needs to know about an armor type. None of it can differ
+// between two items of the type.
+struct camp_locker_type_profile {
+  uint32_t covers = 0;
+  uint32_t sub_covers = 0;
+  bool skintight = false;
+  bool outer_layer = false;
+  bool jumpsuit_like = false;
+  int average_encumber = 0;
+  int average_coverage = 0;
+};
+
+uint32_t camp_locker_part_bits(std::string_view part) {
+  for (const auto &[name, bit] : camp_locker_bp_bits) {
+    if (name == part) {
+      return bit;
+    }
   }
+  return 0;
+}
 
-  for (const armor_portion_data &portion : armor->data) {
-    if (!portion.covers) {
-      continue;
+uint32_t camp_locker_sub_part_bits(std::string_view part) {
+  for (const auto &[name, bit] : camp_locker_sbp_bits) {
+    if (name == part) {
+      return bit;
     }
-    for (const auto &covered_part : *portion.covers) {
-      for (const std::string_view part : parts) {
-        if (covered_part.str() == part) {
-          return true;
-        }
+  }
+  return 0;
+}
+
+camp_locker_type_profile make_camp_locker_type_profile(const itype &type) {
+  static const itype_id itype_jumpsuit("jumpsuit");
+  static const itype_id itype_suit("suit");
+  camp_locker_type_profile profile;
+  profile.jumpsuit_like = type.get_id() == itype_jumpsuit ||
+                          type.looks_like == itype_jumpsuit ||
+                          type.looks_like == itype_suit;
+  if (!type.armor) {
+    return profile;
+  }
+  const islot_armor &armor = *type.armor;
+  int total_encumber = 0;
+  int total_coverage = 0;
+  for (const armor_portion_data &portion : armor.data) {
+    total_encumber += portion.encumber;
+    total_coverage += portion.coverage;
+    if (portion.covers) {
+      for (const bodypart_str_id &covered_part : *portion.covers) {
+        profile.covers |=
+            camp_locker_part_bits(covered_part.str());
       }
     }
+    for (const sub_bodypart_str_id &covered_part : portion.sub_coverage) {
+      profile.sub_covers |= camp_locker_sub_part_bits(covered_part.str());
+    }
   }
-  return false;
+  if (!armor.data.empty()) {
+    profile.average_encumber =
+        total_encumber / static_cast<int>(armor.data.size());
+    profile.average_coverage =
+        total_coverage / static_cast<int>(armor.data.size());
+  }
+  const auto has_layer = [&armor](layer_level level) {
+    return std::find(armor.all_layers.begin(), armor.all_layers.end(),
+                     level) != armor.all_layers.end();
+  };
+  profile.skintight = has_layer(layer_level::SKINTIGHT);
+  profile.outer_layer = has_layer(layer_level::OUTER);
+  return profile;
 }
 
-bool armor_specifically_covers_any(
-    const item &it, const std::initializer_list<std::string_view> &parts) {
-  const islot_armor *armor = it.find_armor_data();
-  if (armor == nullptr) {
-    return false;
+std::unordered_map<const itype *, camp_locker_type_profile> &
+camp_locker_type_profiles() {
+  static std::unordered_map<const itype *, camp_locker_type_profile> profiles;
+  return profiles;
+}
+
+const camp_locker_type_profile &
+camp_locker_profile_of_type(const itype &type) {
+  std::unordered_map<const itype *, camp_locker_type_profile> &profiles =
+      camp_locker_type_profiles();
+  auto found = profiles.find(&type);
+  if (found == profiles.end()) {
+    // Only types made up after finalization, like in tests, get here
+    found = profiles.emplace(&type, make_camp_locker_type_profile(type)).first;
   }
+  return found->second;
+}
 
-  for (const armor_portion_data &portion : armor->data) {
-    for (const auto &covered_part : portion.sub_coverage) {
-      for (const std::string_view part : parts) {
-        if (covered_part.str() == part) {
-          return true;
-        }
-      }
+// The profile of the type whose armor data the item uses, see
+// item::find_armor_data
+const camp_locker_type_profile &camp_locker_profile(const item &it) {
+  static const camp_locker_type_profile no_armor;
+  if (it.type->armor) {
+    return camp_locker_profile_of_type(*it.type);
+  }
+  for (const item *mod : it.gunmods()) {
+    if (mod->type->armor) {
+      return camp_locker_profile_of_type(*mod->type);
     }
   }
-  return false;
+  return no_armor;
 }
-} // namespace
 
-namespace {
-int average_armor_portion_stat(const item &it,
-                               int armor_portion_data::*member) {
-  const islot_armor *armor = it.find_armor_data();
-  if (armor == nullptr || armor->data.empty()) {
-    return 0;
-  }
+bool armor_covers_any(const item &it, uint32_t parts) {
+  return (camp_locker_profile(it).covers & parts) != 0;
+}
+
+bool armor_specifically_covers_any(const item &it, uint32_t sub_parts) {
+  return (camp_locker_profile(it).sub_covers & sub_parts) != 0;
+}
+
+bool is_camp_locker_outer(const item &it) {
+  return camp_locker_profile(it).outer_layer || it.has_flag(flag_OUTER);
+}
+} // namespace
 
-  int total = 0;
-  for (const armor_portion_data &portion : armor->data) {
-    total += portion.*member;
+namespace camp_locker_profiles {
+void finalize_all() {
+  reset();
+  for (const itype *type : item_controller->all()) {
+    camp_locker_type_profiles().emplace(type,
+                                        make_camp_locker_type_profile(*type));
   }
-  return total / static_cast<int>(armor->data.size());
 }
 
+void reset() { camp_locker_type_profiles().clear(); }
+} // namespace camp_locker_profiles
+
+namespace {
 int average_armor_encumber(const item &it) {
-  return average_armor_portion_stat(it, &armor_portion_data::encumber);
+  return camp_locker_profile(it).average_encumber;
 }
 
 int average_armor_coverage(const item &it) {
-  return average_armor_portion_stat(it, &armor_portion_data::coverage);
+  return camp_locker_profile(it).average_coverage;
 }
 
 units::volume utility_storage_capacity(const item &it) {
@@ -371,11 +562,8 @@ int camp_locker_upgrade_threshold(camp_locker_slot slot) {
   return 25;
 }
 
-bool is_better_scored_locker_item(
-    camp_locker_slot slot, const item &lhs, const item &rhs,
-    const std::optional<units::temperature> &local_temperature = std::nullopt) {
-  const int lhs_score = score_camp_locker_item(slot, lhs, local_temperature);
-  const int rhs_score = score_camp_locker_item(slot, rhs, local_temperature);
+bool is_better_scored_locker_item(const item &lhs, int lhs_score,
+                                  const item &rhs, int rhs_score) {
   if (lhs_score != rhs_score) {
     return lhs_score > rhs_score;
   }
@@ -388,6 +576,29 @@ bool is_better_scored_locker_item(
   return lhs.typeId().str() < rhs.typeId().str();
 }
 
+bool is_better_scored_locker_item(
+    camp_locker_slot slot, const item &lhs, const item &rhs,
+    const std::optional<units::temperature> &local_temperature = std::nullopt) {
+  return is_better_scored_locker_item(
+      lhs, score_camp_locker_item(slot, lhs, local_temperature), rhs,
+      score_camp_locker_item(slot, rhs, local_temperature));
+}
+
+// The temperature adjustments only tell cold, mild and hot apart
+int camp_locker_temperature_band(
+    const std::optional<units::temperature> &local_temperature) {
+  if (!local_temperature) {
+    return 0;
+  }
+  if (*local_temperature <= units::from_fahrenheit(50)) {
+    return -1;
+  }
+  if (*local_temperature >= units::from_fahrenheit(75)) {
+    return 1;
+  }
+  return 0;
+}
+
 const item *select_best_locker_item(
     camp_locker_slot slot, const std::vector<const item *> &items,
     const std::optional<units::temperature> &local_temperature = std::nullopt) {
@@ -409,63 +620,52 @@ bool is_camp_locker_weather_sensitive_outerwear(
   if (slot != camp_locker_slot::shirt && slot != camp_locker_slot::vest) {
     return false;
   }
-  const bool outer =
-      it.has_layer({layer_level::OUTER}) || it.has_flag(flag_OUTER);
-  return outer && armor_covers_any(it, {"torso"}) &&
-         armor_covers_any(it, {"arm_l", "arm_r"});
+  const bool outer = is_camp_locker_outer(it);
+  return outer && armor_covers_any(it, locker_bp_torso) &&
+         armor_covers_any(it, locker_bp_arms);
 }
 
 bool is_camp_locker_weather_sensitive_legwear(
     camp_locker_slot slot, const item &it) {
   return slot == camp_locker_slot::pants &&
-         armor_covers_any(it, {"leg_l", "leg_r"});
+         armor_covers_any(it, locker_bp_legs);
 }
 
 bool is_camp_locker_short_legwear(const item &it) {
-  return armor_specifically_covers_any(
-             it, {"leg_hip_l", "leg_hip_r", "leg_upper_l", "leg_upper_r"}) &&
-         !armor_specifically_covers_any(
-             it, {"leg_knee_l", "leg_knee_r", "leg_lower_l", "leg_lower_r"});
+  return armor_specifically_covers_any(it,
+                                       locker_sbp_hips | locker_sbp_thighs) &&
+         !armor_specifically_covers_any(it, locker_sbp_lower_legs);
 }
 
 bool is_camp_locker_draped_only_legwear(const item &it) {
-  return armor_specifically_covers_any(it, {"leg_draped_l", "leg_draped_r"}) &&
+  return armor_specifically_covers_any(it, locker_sbp_draped_legs) &&
          !armor_specifically_covers_any(
-             it, {"leg_hip_l", "leg_hip_r", "leg_upper_l", "leg_upper_r",
-                  "leg_knee_l", "leg_knee_r", "leg_lower_l", "leg_lower_r",
-                  "foot_l", "foot_r"});
+             it, locker_sbp_hips | locker_sbp_thighs | locker_sbp_lower_legs |
+                     locker_sbp_feet);
 }
 
 bool is_camp_locker_draped_overlay_onepiece(const item &it) {
-  return armor_specifically_covers_any(it, {"torso_waist"}) &&
-         armor_specifically_covers_any(it, {"leg_draped_l", "leg_draped_r"}) &&
+  return armor_specifically_covers_any(it, locker_sbp_torso_waist) &&
+         armor_specifically_covers_any(it, locker_sbp_draped_legs) &&
          !armor_specifically_covers_any(
-             it, {"torso_upper", "torso_lower", "arm_upper_l", "arm_upper_r",
-                  "arm_lower_l", "arm_lower_r", "hand_l", "hand_r",
-                  "leg_hip_l", "leg_hip_r", "leg_upper_l", "leg_upper_r",
-                  "leg_knee_l", "leg_knee_r", "leg_lower_l", "leg_lower_r",
-                  "foot_l", "foot_r", "head", "eye_l", "eye_r", "mouth"});
+             it, locker_sbp_upper_body | locker_sbp_hips | locker_sbp_thighs |
+                     locker_sbp_lower_legs | locker_sbp_feet | locker_sbp_face);
 }
 
 bool is_camp_locker_leg_accessory(const item &it) {
-  const bool covers_hips =
-      armor_specifically_covers_any(it, {"leg_hip_l", "leg_hip_r"});
+  const bool covers_hips = armor_specifically_covers_any(it, locker_sbp_hips);
   const bool covers_upper_leg =
-      armor_specifically_covers_any(it, {"leg_hip_l", "leg_hip_r",
-                                         "leg_upper_l", "leg_upper_r"});
+      armor_specifically_covers_any(it, locker_sbp_hips | locker_sbp_thighs);
   const bool covers_only_upper_leg =
-      armor_specifically_covers_any(it, {"leg_upper_l", "leg_upper_r"});
+      armor_specifically_covers_any(it, locker_sbp_thighs);
   const bool covers_lower_leg =
-      armor_specifically_covers_any(it, {"leg_knee_l", "leg_knee_r",
-                                         "leg_lower_l", "leg_lower_r"});
-  const bool covers_feet =
-      armor_specifically_covers_any(it, {"foot_l", "foot_r"});
+      armor_specifically_covers_any(it, locker_sbp_lower_legs);
+  const bool covers_feet = armor_specifically_covers_any(it, locker_sbp_feet);
   const bool covers_only_partial_upper_leg = covers_only_upper_leg != covers_hips;
   const bool full_leg_without_hips =
       covers_only_upper_leg && covers_lower_leg && !covers_hips;
   const bool support_storage = utility_storage_capacity(it) > 0_ml;
-  const bool outer =
-      it.has_layer({layer_level::OUTER}) || it.has_flag(flag_OUTER);
+  const bool outer = is_camp_locker_outer(it);
 
   if (covers_upper_leg && !covers_lower_leg && !covers_feet &&
       (it.has_flag(flag_BELTED) || it.has_flag(flag_BELT_CLIP))) {
@@ -477,12 +677,8 @@ bool is_camp_locker_leg_accessory(const item &it) {
     return true;
   }
 
-  const bool covers_non_leg_regions =
-      armor_specifically_covers_any(it, {"torso_upper", "torso_lower",
-                                         "arm_upper_l", "arm_upper_r",
-                                         "arm_lower_l", "arm_lower_r",
-                                         "hand_l", "hand_r", "head",
-                                         "eye_l", "eye_r", "mouth"});
+  const bool covers_non_leg_regions = armor_specifically_covers_any(
+      it, locker_sbp_upper_body | locker_sbp_face);
 
   if (covers_upper_leg && !covers_lower_leg && !covers_feet &&
       !support_storage && !it.is_holster() && !covers_non_leg_regions && outer &&
@@ -505,37 +701,33 @@ bool is_camp_locker_leg_accessory(const item &it) {
 }
 
 bool is_camp_locker_jumpsuit_like(const item &it) {
-  static const itype_id itype_jumpsuit("jumpsuit");
-  static const itype_id itype_suit("suit");
-  return it.typeId() == itype_jumpsuit ||
-         it.typeId()->looks_like == itype_jumpsuit ||
-         it.typeId()->looks_like == itype_suit;
+  return camp_locker_profile_of_type(*it.type).jumpsuit_like;
 }
 
 bool is_camp_locker_armored_full_body_suit(const item &it) {
   return utility_storage_capacity(it) >= 4_liter &&
-         armor_covers_any(it, {"torso"}) &&
-         armor_covers_any(it, {"arm_l", "arm_r"}) &&
-         armor_covers_any(it, {"leg_l", "leg_r"}) &&
-         !it.has_layer({layer_level::SKINTIGHT}) &&
+         armor_covers_any(it, locker_bp_torso) &&
+         armor_covers_any(it, locker_bp_arms) &&
+         armor_covers_any(it, locker_bp_legs) &&
+         !camp_locker_profile(it).skintight &&
          protection_score(it, 1, 2, 2) >= 80;
 }
 
 bool is_camp_locker_outer_onepiece_garment(const item &it) {
-  const bool outer =
-      it.has_layer({layer_level::OUTER}) || it.has_flag(flag_OUTER);
+  const bool outer = is_camp_locker_outer(it);
   return outer && it.weight() < 1500_gram &&
          utility_storage_capacity(it) < 500_ml &&
-         armor_covers_any(it, {"torso"}) &&
-         armor_covers_any(it, {"arm_l", "arm_r"}) &&
-         armor_covers_any(it, {"leg_l", "leg_r"}) &&
-         !armor_covers_any(it, {"head", "eyes", "mouth", "hand_l",
-                                "hand_r", "foot_l", "foot_r"});
+         armor_covers_any(it, locker_bp_torso) &&
+         armor_covers_any(it, locker_bp_arms) &&
+         armor_covers_any(it, locker_bp_legs) &&
+         !armor_covers_any(it, locker_bp_head | locker_bp_eyes |
+                                   locker_bp_mouth | locker_bp_hands |
+                                   locker_bp_feet);
 }
 
-bool camp_locker_plan_slot_retains_coverage(
-    const camp_locker_plan &plan, camp_locker_slot slot,
-    std::initializer_list<std::string_view> parts) {
+bool camp_locker_plan_slot_retains_coverage(const camp_locker_plan &plan,
+                                            camp_locker_slot slot,
+                                            uint32_t parts) {
   const auto found = plan.find(slot);
   if (found == plan.end()) {
     return false;
@@ -548,8 +740,7 @@ bool camp_locker_plan_slot_retains_coverage(
 }
 
 bool camp_locker_plan_has_other_coverage(
-    const camp_locker_plan &plan,
-    std::initializer_list<std::string_view> parts,
+    const camp_locker_plan &plan, uint32_t parts,
     std::initializer_list<camp_locker_slot> slots) {
   return std::any_of(slots.begin(), slots.end(),
                      [&](const camp_locker_slot slot) {
@@ -579,7 +770,7 @@ void prevent_upper_body_stripping_pants_upgrades(camp_locker_plan &plan) {
   }
 
   auto coverage_preserved =
-      [&](std::initializer_list<std::string_view> parts,
+      [&](uint32_t parts,
           std::initializer_list<camp_locker_slot> fallback_slots) {
         return !armor_covers_any(*pants_plan.kept_current, parts) ||
                armor_covers_any(*pants_plan.selected_candidate, parts) ||
@@ -587,19 +778,19 @@ void prevent_upper_body_stripping_pants_upgrades(camp_locker_plan &plan) {
                                                    fallback_slots);
       };
 
-  if (coverage_preserved({"torso"}, {camp_locker_slot::shirt,
-                                      camp_locker_slot::vest,
-                                      camp_locker_slot::body_armor}) &&
-      coverage_preserved({"arm_l", "arm_r"},
+  if (coverage_preserved(locker_bp_torso,
+                         {camp_locker_slot::shirt, camp_locker_slot::vest,
+                          camp_locker_slot::body_armor}) &&
+      coverage_preserved(locker_bp_arms,
                          {camp_locker_slot::shirt, camp_locker_slot::vest,
                           camp_locker_slot::body_armor}) &&
-      coverage_preserved({"head"}, {camp_locker_slot::helmet}) &&
-      coverage_preserved({"eyes"},
+      coverage_preserved(locker_bp_head, {camp_locker_slot::helmet}) &&
+      coverage_preserved(locker_bp_eyes,
                          {camp_locker_slot::helmet,
                           camp_locker_slot::glasses}) &&
-      coverage_preserved({"mouth"}, {camp_locker_slot::helmet}) &&
-      coverage_preserved({"hand_l", "hand_r"}, {}) &&
-      coverage_preserved({"foot_l", "foot_r"},
+      coverage_preserved(locker_bp_mouth, {camp_locker_slot::helmet}) &&
+      coverage_preserved(locker_bp_hands, {}) &&
+      coverage_preserved(locker_bp_feet,
                          {camp_locker_slot::socks,
                           camp_locker_slot::shoes})) {
     return;
@@ -612,7 +803,8 @@ void prevent_upper_body_stripping_pants_upgrades(camp_locker_plan &plan) {
 void prevent_missing_pants_fill_under_full_body_body_armor(
     camp_locker_plan &plan) {
   if (!camp_locker_plan_slot_retains_coverage(
-          plan, camp_locker_slot::body_armor, {"leg_l", "leg_r"})) {
+          plan, camp_locker_slot::body_armor,
+          locker_bp_legs)) {
     return;
   }
 
@@ -677,18 +869,16 @@ std::optional<camp_locker_slot> classify_camp_locker_item(const item &it) {
     return std::nullopt;
   }
 
-  const bool covers_eyes = armor_covers_any(it, {"eyes"});
-  const bool covers_head = armor_covers_any(it, {"head"});
-  const bool covers_feet = armor_covers_any(it, {"foot_l", "foot_r"});
-  const bool covers_legs = armor_covers_any(it, {"leg_l", "leg_r"});
+  const bool covers_eyes = armor_covers_any(it, locker_bp_eyes);
+  const bool covers_head = armor_covers_any(it, locker_bp_head);
+  const bool covers_feet = armor_covers_any(it, locker_bp_feet);
+  const bool covers_legs = armor_covers_any(it, locker_bp_legs);
   const bool covers_lower_legs =
-      armor_specifically_covers_any(it, {"leg_knee_l", "leg_knee_r",
-                                        "leg_lower_l", "leg_lower_r"});
-  const bool covers_torso = armor_covers_any(it, {"torso"});
-  const bool covers_arms = armor_covers_any(it, {"arm_l", "arm_r"});
-  const bool skintight = it.has_layer({layer_level::SKINTIGHT});
-  const bool outer =
-      it.has_layer({layer_level::OUTER}) || it.has_flag(flag_OUTER);
+      armor_specifically_covers_any(it, locker_sbp_lower_legs);
+  const bool covers_torso = armor_covers_any(it, locker_bp_torso);
+  const bool covers_arms = armor_covers_any(it, locker_bp_arms);
+  const bool skintight = camp_locker_profile(it).skintight;
+  const bool outer = is_camp_locker_outer(it);
   const units::volume storage = utility_storage_capacity(it);
 
   if (is_camp_locker_draped_overlay_onepiece(it)) {
@@ -1024,6 +1214,7 @@ describe_camp_patrol_guard_runtime(const camp_patrol_shift_plan &plan,
         runtime.behavior = camp_patrol_guard_behavior::hold;
         runtime.route = { cluster.tiles[hold_index] };
         runtime.target = cluster.tiles[hold_index];
+        runtime.leg_start = runtime.target;
         return runtime;
     }
 
@@ -1038,7 +1229,10 @@ describe_camp_patrol_guard_runtime(const camp_patrol_shift_plan &plan,
     const size_t loop_step = dwell_turns > 0 ? static_cast<size_t>(absolute_turn /
                              dwell_turns) : 0;
     const size_t loop_phase = camp_patrol_guard_loop_phase(plan, *guard_it);
-    runtime.target = runtime.route[(loop_step + loop_phase) % runtime.route.size()];
+    const size_t target_index = (loop_step + loop_phase) % runtime.route.size();
+    runtime.target = runtime.route[target_index];
+    runtime.leg_start = runtime.route[(target_index + runtime.route.size() - 1) %
+                                      runtime.route.size()];
     return runtime;
 }
 
@@ -1135,6 +1329,12 @@ bool camp_locker_reservation_matches(const camp_locker_reservation &reservation,
          reservation.item_type == candidate.typeId();
 }
 
+bool camp_locker_tile_in_reach(const std::vector<tripoint_abs_ms> *reach,
+                               const tripoint_abs_ms &tile) {
+  return reach == nullptr || std::binary_search(reach->begin(), reach->end(),
+                                                tile, tripoint_abs_ms_zyx_less);
+}
+
 } // namespace
 
 camp_locker_candidate_map collect_camp_locker_zone_candidates(
@@ -1186,6 +1386,199 @@ camp_locker_candidate_map collect_camp_locker_zone_candidates(
       policy);
 }
 
+void camp_locker_index::invalidate_slots(const tile_entry &entry) {
+  for (const auto &candidate : entry.candidates) {
+    rankings[static_cast<size_t>(candidate.first)].valid = false;
+  }
+}
+
+void camp_locker_index::refresh(const std::vector<tripoint_abs_ms> &locker_tiles) {
+  map &here = get_map();
+  bool changed = false;
+  if (bubble_origin != here.get_abs_sub()) {
+    tiles.clear();
+    for (slot_ranking &ranking : rankings) {
+      ranking = slot_ranking();
+    }
+    bubble_origin = here.get_abs_sub();
+    changed = true;
+  }
+
+  std::map<tripoint_abs_ms, tile_entry> refreshed;
+  for (const tripoint_abs_ms &tile : locker_tiles) {
+    const tripoint_bub_ms local = here.get_bub(tile);
+    if (!here.inbounds(local)) {
+      continue;
+    }
+    const uint64_t version = here.content_version(local);
+    auto found = tiles.find(tile);
+    if (found != tiles.end() && found->second.content_version == version) {
+      refreshed.emplace(tile, std::move(found->second));
+      tiles.erase(found);
+      continue;
+    }
+    if (found != tiles.end()) {
+      invalidate_slots(found->second);
+      tiles.erase(found);
+    }
+    tile_entry entry;
+    entry.content_version = version;
+    for (const item &it : here.i_at(local)) {
+      entry.items.push_back(&it);
+      if (const std::optional<camp_locker_slot> slot =
+              classify_camp_locker_item(it)) {
+        entry.candidates.emplace_back(*slot, &it);
+      }
+    }
+    invalidate_slots(entry);
+    refreshed.emplace(tile, std::move(entry));
+    changed = true;
+  }
+  // whatever is left is no longer a locker tile in reach
+  for (const auto &entry : tiles) {
+    invalidate_slots(entry.second);
+    changed = true;
+  }
+  tiles = std::move(refreshed);
+  if (tile_order != locker_tiles) {
+    // the ranking breaks ties by tile order
+    tile_order = locker_tiles;
+    for (slot_ranking &ranking : rankings) {
+      ranking.valid = false;
+    }
+    changed = true;
+  }
+  if (changed) {
+    generation++;
+  }
+}
+
+std::vector<const item *> camp_locker_index::items(
+    const std::vector<camp_locker_reservation> &reservations,
+    const character_id &requesting_worker,
+    const std::vector<tripoint_abs_ms> *reach) const {
+  std::vector<const item *> ret;
+  for (const tripoint_abs_ms &tile : tile_order) {
+    const auto found = tiles.find(tile);
+    if (found == tiles.end() || !camp_locker_tile_in_reach(reach, tile)) {
+      continue;
+    }
+    for (const item *it : found->second.items) {
+      if (std::none_of(reservations.begin(), reservations.end(),
+                       [&tile, it, &requesting_worker](
+                           const camp_locker_reservation &reservation) {
+                         return camp_locker_reservation_matches(
+                             reservation, tile, *it, requesting_worker);
+                       })) {
+        ret.push_back(it);
+      }
+    }
+  }
+  return ret;
+}
+
+camp_locker_candidate_map camp_locker_index::ranked_candidates(
+    const camp_locker_policy &policy,
+    const std::vector<camp_locker_reservation> &reservations,
+    const character_id &requesting_worker,
+    const std::optional<units::temperature> &local_temperature,
+    const std::vector<tripoint_abs_ms> *reach) {
+  const int band = camp_locker_temperature_band(local_temperature);
+  camp_locker_candidate_map ret;
+  for (const camp_locker_slot slot : all_camp_locker_slots()) {
+    if (!policy.is_enabled(slot)) {
+      continue;
+    }
+    slot_ranking &ranking = rankings[static_cast<size_t>(slot)];
+    if (!ranking.valid || ranking.temperature_band != band) {
+      ranking.ranked.clear();
+      for (const tripoint_abs_ms &tile : tile_order) {
+        const auto found = tiles.find(tile);
+        if (found == tiles.end()) {
+          continue;
+        }
+        for (const auto &candidate : found->second.candidates) {
+          if (candidate.first == slot) {
+            ranking.ranked.push_back(
+                {tile, candidate.second,
+                 score_camp_locker_item(slot, *candidate.second,
+                                        local_temperature)});
+          }
+        }
+      }
+      std::stable_sort(ranking.ranked.begin(), ranking.ranked.end(),
+                       [](const ranked_candidate &lhs, const ranked_candidate &rhs) {
+                         return is_better_scored_locker_item(*lhs.it, lhs.score,
+                                                             *rhs.it, rhs.score);
+                       });
+      ranking.valid = true;
+      ranking.temperature_band = band;
+    }
+    for (const ranked_candidate &candidate : ranking.ranked) {
+      if (camp_locker_tile_in_reach(reach, candidate.tile) &&
+          std::none_of(reservations.begin(), reservations.end(),
+                       [&candidate, &requesting_worker](
+                           const camp_locker_reservation &reservation) {
+                         return camp_locker_reservation_matches(
+                             reservation, candidate.tile, *candidate.it,
+                             requesting_worker);
+                       })) {
+        ret[slot].push_back(candidate.it);
+      }
+    }
+  }
+  return ret;
+}
+
+std::optional<tripoint_abs_ms>
+camp_locker_index::tile_of(const item *it) const {
+  for (const auto &[tile, entry] : tiles) {
+    if (std::find(entry.items.begin(), entry.items.end(), it) !=
+        entry.items.end()) {
+      return tile;
+    }
+  }
+  return std::nullopt;
+}
+
+void camp_locker_tile_snapshot::refresh(const faction_id &new_fac) {
+  const zone_manager &mgr = zone_manager::get_manager();
+  if (zone_version == mgr.get_zone_version() && fac == new_fac) {
+    return;
+  }
+  zone_version = mgr.get_zone_version();
+  fac = new_fac;
+  const std::unordered_set<tripoint_abs_ms> point_set =
+      mgr.get_point_set(zone_type_CAMP_LOCKER, fac);
+  const std::unordered_set<tripoint_abs_ms> vzone_set =
+      mgr.get_vzone_set(zone_type_CAMP_LOCKER, fac);
+  tiles.assign(point_set.begin(), point_set.end());
+  for (const tripoint_abs_ms &tile : vzone_set) {
+    if (point_set.count(tile) == 0) {
+      tiles.push_back(tile);
+    }
+  }
+  sort_tripoints_zyx(tiles);
+  vehicle_only.clear();
+  vehicle_only.reserve(tiles.size());
+  for (const tripoint_abs_ms &tile : tiles) {
+    vehicle_only.push_back(point_set.count(tile) == 0);
+  }
+}
+
+std::vector<tripoint_abs_ms>
+camp_locker_tile_snapshot::tiles_near(const tripoint_abs_ms &origin,
+                                      int range) const {
+  std::vector<tripoint_abs_ms> ret;
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    if (square_dist(tiles[i], origin) <= range &&
+        (!vehicle_only[i] || tiles[i].z() == origin.z())) {
+      ret.push_back(tiles[i]);
+    }
+  }
+  return ret;
+}
+
 int score_camp_locker_item(
     camp_locker_slot slot, const item &it,
     const std::optional<units::temperature> &local_temperature) {
@@ -1250,7 +1643,8 @@ plan_camp_locker_loadout(
     const std::vector<const item *> &current_items,
     const camp_locker_candidate_map &locker_candidates,
     const camp_locker_policy &policy,
-    const std::optional<units::temperature> &local_temperature) {
+    const std::optional<units::temperature> &local_temperature,
+    bool candidates_ranked) {
   camp_locker_plan plan;
   const camp_locker_candidate_map current_by_slot =
       collect_camp_locker_candidates(current_items, policy);
@@ -1282,8 +1676,11 @@ plan_camp_locker_loadout(
 
     auto candidate_it = locker_candidates.find(slot);
     if (candidate_it != locker_candidates.end()) {
-      const item *best_candidate = select_best_locker_item(
-          slot, candidate_it->second, local_temperature);
+      const item *best_candidate =
+          !candidates_ranked ? select_best_locker_item(slot, candidate_it->second,
+                                                       local_temperature)
+          : candidate_it->second.empty() ? nullptr
+                                         : candidate_it->second.front();
       if (best_candidate != nullptr) {
         if (slot_plan.kept_current == nullptr) {
           slot_plan.missing_current = true;
@@ -1888,20 +2285,24 @@ bool camp_locker_plan_has_changes(const camp_locker_plan &plan) {
 }
 
 camp_locker_live_state collect_camp_locker_live_state(
-    npc &worker, const faction_id &fac, const camp_locker_policy &policy,
-    const std::vector<camp_locker_reservation> &reservations) {
+    npc &worker, const std::vector<tripoint_abs_ms> &locker_tiles,
+    const camp_locker_policy &policy,
+    const std::vector<camp_locker_reservation> &reservations,
+    camp_locker_index &index) {
   camp_locker_live_state live_state;
   live_state.current_items = collect_camp_locker_current_items(worker);
   live_state.worker_items = collect_camp_locker_worker_items(worker);
-  const std::vector<tripoint_abs_ms> locker_tiles =
-      collect_sorted_camp_locker_tiles(worker.pos_abs(), fac);
-  live_state.locker_items = collect_camp_locker_zone_items(
-      locker_tiles, reservations, worker.getID());
+  live_state.locker_items =
+      index.items(reservations, worker.getID(), &locker_tiles);
+  const std::optional<units::temperature> local_temperature =
+      get_weather().get_temperature(worker.pos_bub());
   live_state.locker_candidates =
-      collect_camp_locker_candidates(live_state.locker_items, policy);
-  live_state.plan = plan_camp_locker_loadout(
-      live_state.current_items, live_state.locker_candidates, policy,
-      get_weather().get_temperature(worker.pos_bub()));
+      index.ranked_candidates(policy, reservations, worker.getID(),
+                              local_temperature, &locker_tiles);
+  live_state.plan =
+      plan_camp_locker_loadout(live_state.current_items,
+                               live_state.locker_candidates, policy,
+                               local_temperature, true);
   live_state.ranged_readiness = collect_camp_locker_ranged_readiness_state(
       worker, policy, live_state.worker_items, live_state.locker_items);
   return live_state;
@@ -1918,6 +2319,64 @@ std::string camp_locker_live_state_signature(
       camp_locker_ranged_readiness_debug_summary(live_state.ranged_readiness));
 }
 
+camp_locker_worker_outlook make_camp_locker_worker_outlook(
+    npc &worker, const camp_locker_tile_snapshot &snapshot,
+    const camp_locker_policy &policy,
+    const std::vector<camp_locker_reservation> &reservations,
+    camp_locker_index &index) {
+  camp_locker_worker_outlook outlook;
+  outlook.reach = snapshot.tiles_near(worker.pos_abs(), MAX_VIEW_DISTANCE);
+  const camp_locker_live_state live_state = collect_camp_locker_live_state(
+      worker, outlook.reach, policy, reservations, index);
+  outlook.signature = camp_locker_live_state_signature(live_state, policy);
+  outlook.plan_summary = camp_locker_plan_debug_summary(live_state.plan);
+  outlook.ranged_summary =
+      camp_locker_ranged_readiness_debug_summary(live_state.ranged_readiness);
+  outlook.has_changes = camp_locker_plan_has_changes(live_state.plan) ||
+                        live_state.ranged_readiness.has_changes();
+  outlook.inventory_version = worker.get_inventory_version();
+  outlook.temperature_band = camp_locker_temperature_band(
+      get_weather().get_temperature(worker.pos_bub()));
+  for (const auto &[slot, slot_plan] : live_state.plan) {
+    if (slot_plan.selected_candidate == nullptr) {
+      continue;
+    }
+    if (const std::optional<tripoint_abs_ms> tile =
+            index.tile_of(slot_plan.selected_candidate)) {
+      // only has to outlast this turn, later workers of the wave plan around it
+      outlook.claims.push_back({worker.getID(), slot, *tile,
+                                slot_plan.selected_candidate->typeId(),
+                                calendar::turn + 1_turns});
+    }
+  }
+  return outlook;
+}
+
+bool is_camp_locker_outlook_current(const camp_locker_worker_outlook &outlook,
+                                    npc &worker,
+                                    const camp_locker_tile_snapshot &snapshot) {
+  return outlook.inventory_version == worker.get_inventory_version() &&
+         outlook.temperature_band ==
+             camp_locker_temperature_band(
+                 get_weather().get_temperature(worker.pos_bub())) &&
+         outlook.reach ==
+             snapshot.tiles_near(worker.pos_abs(), MAX_VIEW_DISTANCE);
+}
+
+bool same_camp_locker_reservations(
+    const std::vector<camp_locker_reservation> &lhs,
+    const std::vector<camp_locker_reservation> &rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                    [](const camp_locker_reservation &left,
+                       const camp_locker_reservation &right) {
+                      return left.worker_id == right.worker_id &&
+                             left.slot == right.slot &&
+                             left.tile == right.tile &&
+                             left.item_type == right.item_type &&
+                             left.expires == right.expires;
+                    });
+}
+
 } // namespace
 
 const std::map<point_rel_omt, base_camps::direction_data>
@@ -2359,6 +2818,7 @@ void basecamp::add_resource(const itype_id &camp_resource) {
     bcp_r.ammo_id = camp_item.ammo_default();
     resources.emplace_back( bcp_r );
   fuel_types.insert(bcp_r.ammo_id);
+  invalidate_crafting_inventory();
 }
 
 void basecamp::update_resources(const std::string &bldg) {
@@ -2619,6 +3079,8 @@ std::list<item> basecamp::use_charges(const itype_id &fake_id, int &quantity) {
   if (quantity <= 0) {
     return ret;
     }
+    // the resources it draws on are counted again when the inventory is formed
+    invalidate_crafting_inventory();
     for( basecamp_resource &bcp_r : resources ) {
         if( bcp_r.fake_id == fake_id ) {
             item camp_item( bcp_r.fake_id, calendar::turn_zero );
@@ -2674,7 +3136,33 @@ void basecamp::form_storage_zones(map &here, const tripoint_abs_ms &abspos) {
   set_dumping_spot(here.get_abs(src_loc));
   set_liquid_dumping_spot(possible_liquid_dumps);
 }
+void basecamp::invalidate_crafting_inventory() { _inv_key.reset(); }
+
 void basecamp::form_crafting_inventory(map &target_map) {
+  crafting_inventory_key key;
+  key.formed_on = &target_map;
+  key.map_origin = target_map.get_abs_sub();
+  key.turn = calendar::turn;
+  // Vehicle cargo doesn't show in the content versions, so tiles with vehicles are read every time
+  bool reusable = true;
+  key.tile_versions.reserve(src_set.size());
+  for (const tripoint_abs_ms &p : src_set) {
+    const tripoint_bub_ms local = target_map.get_bub(p);
+    if (target_map.veh_at(local)) {
+      reusable = false;
+      break;
+    }
+    key.tile_versions.emplace_back(p, target_map.content_version(local));
+  }
+  if (reusable) {
+    std::sort(key.tile_versions.begin(), key.tile_versions.end());
+    if (_inv_key && *_inv_key == key) {
+      return;
+    }
+    _inv_key = std::move(key);
+  } else {
+    _inv_key.reset();
+  }
   _inv.clear();
   zone_manager &mgr = zone_manager::get_manager();
   map &here = get_map();
@@ -2754,6 +3242,119 @@ void basecamp::form_crafting_inventory(map &target_map) {
   }
 }
 
+// One step of the coarse simulation of a camp outside the reality bubble
+static const time_duration camp_offscreen_step = 1_hours;
+// npc::on_load catches a worker's needs up by at most this much, so a worker is
+// never owed more meals than that. Anything drawn beyond it was eaten away.
+static const time_duration camp_offscreen_max_owed = 2_days;
+
+bool camp_offscreen_ledger::empty() const {
+  return job_hours.empty() && owed_meals.empty() && hungry_hours == 0_turns;
+}
+
+bool basecamp::is_in_reality_bubble() const {
+  return get_map().inbounds(omt_pos);
+}
+
+void basecamp::simulate_offscreen(const time_point &until) {
+  if (offscreen.simulated_until == calendar::turn_zero ||
+      offscreen.simulated_until > until) {
+    offscreen.simulated_until = until;
+  }
+  if (is_in_reality_bubble()) {
+    offscreen.simulated_until = until;
+    if (!offscreen.empty()) {
+      reconcile_offscreen();
+    }
+    return;
+  }
+  if (until - offscreen.simulated_until < camp_offscreen_step) {
+    return;
+  }
+
+  // Workers away on missions are fed by the mission itself.
+  std::vector<npc_ptr> workers;
+  for (const npc_ptr &worker : get_npcs_assigned()) {
+    if (!worker->has_companion_mission()) {
+      workers.push_back(worker);
+    }
+  }
+  const bool feed =
+      !get_option<bool>("NO_NPC_FOOD") && fac()->consumes_food;
+  for (; until - offscreen.simulated_until >= camp_offscreen_step;
+       offscreen.simulated_until += camp_offscreen_step) {
+    for (const npc_ptr &worker : workers) {
+      std::optional<activity_id> job;
+      if (worker->job.has_job()) {
+        const activity_id top = worker->job.get_prioritised_vector().front();
+        if (worker->job.get_priority_of_job(top) > 0) {
+          job = top;
+        }
+      }
+      const float exertion = job && job->is_valid() ? job->obj().exertion_level()
+                                                   : NO_EXERCISE;
+      if (job) {
+        offscreen.job_hours[*job] +=
+            camp_offscreen_step * work_day_hours / 24;
+      }
+      if (!feed) {
+        continue;
+      }
+      // A full day's meals spread over the day, rest and sleep included.
+      const int kcal = time_to_food(24_hours, exertion) *
+                       to_turns<int>(camp_offscreen_step) /
+                       to_turns<int>(24_hours);
+      const int to_draw = std::min(kcal, fac()->food_supply().kcal());
+      if (to_draw < kcal) {
+        offscreen.hungry_hours += camp_offscreen_step;
+      }
+      if (to_draw <= 0) {
+        continue;
+      }
+      nutrients &owed = offscreen.owed_meals[worker->getID()];
+      owed += camp_food_supply(-to_draw);
+      const int owed_cap = time_to_food(camp_offscreen_max_owed, exertion);
+      if (owed.kcal() > owed_cap) {
+        owed *= static_cast<double>(owed_cap) / owed.kcal();
+      }
+    }
+  }
+}
+
+void basecamp::reconcile_offscreen() {
+  for (const npc_ptr &worker : get_npcs_assigned()) {
+    const auto owed = offscreen.owed_meals.find(worker->getID());
+    if (owed == offscreen.owed_meals.end() || owed->second.kcal() <= 0) {
+      continue;
+    }
+    if (allowed_access_by(*worker) &&
+        worker->will_eat(make_fake_food(owed->second)).value() == EDIBLE) {
+      feed_workers(*worker, owed->second);
+    } else {
+      // Whatever the worker can't eat goes back in the larder.
+      fac()->add_to_food_supply({{calendar::turn_zero, owed->second}});
+    }
+  }
+  time_duration work = 0_turns;
+  for (const std::pair<const activity_id, time_duration> &job :
+       offscreen.job_hours) {
+    work += job.second;
+    DebugLog(D_INFO, DC_ALL) << string_format(
+        "camp offscreen: camp=%s job=%s hours=%d", name, job.first.str(),
+        to_hours<int>(job.second));
+  }
+  if (work >= 1_hours) {
+    add_msg(m_info, _("While you were away, the workers of %s put in %d hours on their jobs."),
+            name, to_hours<int>(work));
+  }
+  if (offscreen.hungry_hours >= 1_hours) {
+    add_msg(m_bad, _("The larder of %s ran out while you were away."), name);
+  }
+  const time_point simulated_until = offscreen.simulated_until;
+  offscreen = camp_offscreen_ledger();
+  offscreen.simulated_until = simulated_until;
+}
+
 map &basecamp::get_camp_map() {
   if (by_radio) {
     if (!camp_map.map_) {
@@ -2803,6 +3404,8 @@ void basecamp::clear_patrol_shift_cache() {
   patrol_shift_cache_day = -1;
   patrol_shift_cache_kind = camp_patrol_shift::day;
   patrol_shift_cache = camp_patrol_shift_plan();
+  patrol_shift_cache_zone_version = -1;
+  patrol_legs.clear();
 }
 
 bool basecamp::refresh_patrol_shift_cache() {
@@ -2810,8 +3413,10 @@ bool basecamp::refresh_patrol_shift_cache() {
 
   const int current_day = camp_patrol_shift_cache_day(calendar::turn);
   const camp_patrol_shift current_shift = camp_patrol_shift_for_turn(calendar::turn);
+  const int zone_version = zone_manager::get_manager().get_zone_version();
   if( patrol_shift_cache_valid && patrol_shift_cache_day == current_day &&
-      patrol_shift_cache_kind == current_shift ) {
+      patrol_shift_cache_kind == current_shift &&
+      patrol_shift_cache_zone_version == zone_version ) {
     return !patrol_shift_cache.clusters.empty() &&
            !patrol_shift_cache.roster.empty();
   }
@@ -2842,6 +3447,8 @@ bool basecamp::refresh_patrol_shift_cache() {
   patrol_shift_cache_valid = true;
   patrol_shift_cache_day = current_day;
   patrol_shift_cache_kind = current_shift;
+  patrol_shift_cache_zone_version = zone_version;
+  precompute_patrol_legs();
   DebugLog( D_INFO, DC_ALL )
       << string_format(
              "camp patrol: cache camp=%s shift=%s workers=%zu roster=%zu active=%zu reserve=%zu clusters=%s",
@@ -2852,6 +3459,78 @@ bool basecamp::refresh_patrol_shift_cache() {
   return !patrol_shift_cache.roster.empty();
 }
 
+void basecamp::precompute_patrol_legs() {
+  for( const camp_patrol_guard_plan &guard_plan : patrol_shift_cache.active_guards ) {
+    const std::optional<camp_patrol_guard_runtime> runtime =
+        describe_camp_patrol_guard_runtime( patrol_shift_cache, guard_plan.worker_id,
+                                            calendar::turn );
+    npc *const guard = g->find_npc( guard_plan.worker_id );
+    if( !runtime || runtime->behavior != camp_patrol_guard_behavior::loop ||
+        guard == nullptr ) {
+      continue;
+    }
+    const std::vector<tripoint_abs_ms> &route = runtime->route;
+    for( size_t index = 0; index < route.size(); ++index ) {
+      get_patrol_leg( *guard, route[index], route[( index + 1 ) % route.size()] );
+    }
+  }
+}
+
+const std::vector<tripoint_abs_ms> *basecamp::get_patrol_leg(
+    npc &guard, const tripoint_abs_ms &from, const tripoint_abs_ms &to ) {
+  map &here = get_map();
+  const auto submaps_version = [&here]( const std::vector<tripoint_abs_sm> &submaps )
+  -> std::optional<uint64_t> {
+    uint64_t version = 0;
+    for( const tripoint_abs_sm &sm : submaps ) {
+      const tripoint_bub_ms local = here.get_bub( project_to<coords::ms>( sm ) );
+      if( !here.inbounds( local ) ) {
+        return std::nullopt;
+      }
+      version += here.content_version( local );
+    }
+    return version;
+  };
+
+  const std::pair<tripoint_abs_ms, tripoint_abs_ms> key( from, to );
+  const auto found = patrol_legs.find( key );
+  if( found != patrol_legs.end() &&
+      submaps_version( found->second.submaps ) == found->second.content_version ) {
+    return &found->second.path;
+  }
+
+  const tripoint_bub_ms local_from = here.get_bub( from );
+  const tripoint_bub_ms local_to = here.get_bub( to );
+  if( from == to || !here.inbounds( local_from ) || !here.inbounds( local_to ) ) {
+    patrol_legs.erase( key );
+    return nullptr;
+  }
+  const std::vector<tripoint_bub_ms> steps =
+      here.route( local_from, pathfinding_target::point( local_to ),
+                  guard.get_pathfinding_settings(), guard.get_path_avoid() );
+  if( steps.empty() ) {
+    patrol_legs.erase( key );
+    return nullptr;
+  }
+  camp_patrol_leg leg;
+  leg.submaps.push_back( project_to<coords::sm>( from ) );
+  for( const tripoint_bub_ms &step : steps ) {
+    if( step == local_from ) {
+      continue;
+    }
+    const tripoint_abs_ms abs_step = here.get_abs( step );
+    leg.path.push_back( abs_step );
+    const tripoint_abs_sm sm = project_to<coords::sm>( abs_step );
+    if( std::find( leg.submaps.begin(), leg.submaps.end(), sm ) == leg.submaps.end() ) {
+      leg.submaps.push_back( sm );
+    }
+  }
+  leg.content_version = *submaps_version( leg.submaps );
+  camp_patrol_leg &stored = patrol_legs[key];
+  stored = std::move( leg );
+  return &stored.path;
+}
+
 const camp_patrol_shift_plan *basecamp::get_current_patrol_shift_plan() {
   if( !refresh_patrol_shift_cache() ) {
     return nullptr;
@@ -2901,6 +3580,97 @@ void basecamp::mark_camp_locker_dirty(npc &worker, bool high_priority) {
   } else {
     locker_service_queue.push_back(worker_id);
   }
+  // the queue decides who claims contested gear first
+  locker_wave.valid = false;
+}
+
+void basecamp::plan_camp_locker_wave(npc &requesting_worker) {
+  std::vector<npc *> workers;
+  const auto add_worker = [&workers](npc *worker) {
+    if (worker != nullptr &&
+        std::find(workers.begin(), workers.end(), worker) == workers.end()) {
+      workers.push_back(worker);
+    }
+  };
+  const auto find_assignee = [this](const character_id &id) -> npc * {
+    for (const npc_ptr &assignee : assigned_npcs) {
+      if (assignee && assignee->getID() == id) {
+        return assignee.get();
+      }
+    }
+    return nullptr;
+  };
+  map &here = get_map();
+  const auto in_wave = [this, &here](const npc *worker) {
+    return worker != nullptr && !worker->is_dead() && worker->assigned_camp &&
+           *worker->assigned_camp == omt_pos &&
+           here.inbounds(worker->pos_bub());
+  };
+  for (const character_id &id : locker_service_queue) {
+    npc *worker = find_assignee(id);
+    if (in_wave(worker)) {
+      add_worker(worker);
+    }
+  }
+  for (const npc_ptr &assignee : assigned_npcs) {
+    if (in_wave(assignee.get())) {
+      add_worker(assignee.get());
+    }
+  }
+  add_worker(&requesting_worker);
+
+  locker_wave = camp_locker_wave();
+  locker_wave.index_generation = locker_index.get_generation();
+  locker_wave.reservations = locker_reservations;
+  locker_wave.valid = true;
+  std::vector<camp_locker_reservation> claims = locker_reservations;
+  for (npc *worker : workers) {
+    camp_locker_worker_outlook outlook = make_camp_locker_worker_outlook(
+        *worker, locker_tile_snapshot, locker_policy, claims, locker_index);
+    claims.insert(claims.end(), outlook.claims.begin(), outlook.claims.end());
+    locker_wave.order.push_back(worker->getID());
+    locker_wave.outlooks[worker->getID()] = std::move(outlook);
+  }
+  DebugLog(D_INFO, DC_ALL) << string_format(
+      "camp locker: planned wave of %d workers over %d locker tiles",
+      static_cast<int>(workers.size()),
+      static_cast<int>(locker_tile_snapshot.all_tiles().size()));
+}
+
+const camp_locker_worker_outlook &basecamp::camp_locker_outlook(npc &worker) {
+  const faction_id fac_id = owner.is_valid() ? owner : your_fac;
+  locker_tile_snapshot.refresh(fac_id);
+  locker_index.refresh(locker_tile_snapshot.all_tiles());
+  if (!locker_wave.valid ||
+      locker_wave.index_generation != locker_index.get_generation() ||
+      !same_camp_locker_reservations(locker_wave.reservations,
+                                     locker_reservations)) {
+    plan_camp_locker_wave(worker);
+    return locker_wave.outlooks.at(worker.getID());
+  }
+  const auto found = locker_wave.outlooks.find(worker.getID());
+  if (found != locker_wave.outlooks.end() &&
+      is_camp_locker_outlook_current(found->second, worker,
+                                     locker_tile_snapshot)) {
+    return found->second;
+  }
+
+  // Only this worker changed, it still plans around the workers ahead of it
+  std::vector<camp_locker_reservation> claims = locker_reservations;
+  for (const character_id &id : locker_wave.order) {
+    if (id == worker.getID()) {
+      break;
+    }
+    const camp_locker_worker_outlook &ahead = locker_wave.outlooks.at(id);
+    claims.insert(claims.end(), ahead.claims.begin(), ahead.claims.end());
+  }
+  if (found == locker_wave.outlooks.end()) {
+    locker_wave.order.push_back(worker.getID());
+  }
+  camp_locker_worker_outlook &outlook = locker_wave.outlooks[worker.getID()];
+  outlook = make_camp_locker_worker_outlook(worker, locker_tile_snapshot,
+                                            locker_policy, claims, locker_index);
+  return outlook;
 }
 
 bool basecamp::process_camp_locker_downtime(npc &worker) {
@@ -2966,29 +3736,21 @@ bool basecamp::process_camp_locker_downtime(npc &worker) {
                static_cast<int>(assigned_npcs.size()));
   }
 
-  const faction_id fac_id = owner.is_valid() ? owner : your_fac;
-  const camp_locker_live_state live_state = collect_camp_locker_live_state(
-      worker, fac_id, locker_policy, locker_reservations);
-  const std::string locker_state_signature =
-      camp_locker_live_state_signature(live_state, locker_policy);
+  const camp_locker_worker_outlook &outlook = camp_locker_outlook(worker);
   const std::string previous_signature =
       worker.get_value(camp_locker_state_signature_key).str();
-  const bool has_state_changes =
-      camp_locker_plan_has_changes(live_state.plan) ||
-      live_state.ranged_readiness.has_changes();
-  if (previous_signature != locker_state_signature && has_state_changes &&
+  const bool has_state_changes = outlook.has_changes;
+  if (previous_signature != outlook.signature && has_state_changes &&
       !queued_after_cleanup) {
     mark_camp_locker_dirty(worker);
     DebugLog(D_INFO, DC_ALL)
         << string_format(
                "camp locker: queued %s state-dirty queue_size=%d next_turn=%d plan=[%s] ranged=[%s]",
                worker.get_name(), static_cast<int>(locker_service_queue.size()),
-               to_turn<int>(locker_next_service_turn),
-               camp_locker_plan_debug_summary(live_state.plan),
-               camp_locker_ranged_readiness_debug_summary(
-                   live_state.ranged_readiness));
+               to_turn<int>(locker_next_service_turn), outlook.plan_summary,
+               outlook.ranged_summary);
   }
-  worker.set_value(camp_locker_state_signature_key, locker_state_signature);
+  worker.set_value(camp_locker_state_signature_key, outlook.signature);
 
   if (locker_service_queue.empty() ||
       locker_service_queue.front() != worker.getID() ||
@@ -3035,11 +3797,9 @@ bool basecamp::process_camp_locker_downtime(npc &worker) {
   locker_next_service_turn =
       calendar::turn + (applied_changes ? 10_minutes : 2_minutes);
 
-  const camp_locker_live_state post_service_state = collect_camp_locker_live_state(
-      worker, fac_id, locker_policy, locker_reservations);
+  // The service moved items and reserved its picks, so this plans the wave again
   worker.set_value(camp_locker_state_signature_key,
-                   camp_locker_live_state_signature(post_service_state,
-                                                    locker_policy));
+                   camp_locker_outlook(worker).signature);
 
   DebugLog(D_INFO, DC_ALL)
       << string_format(
@@ -3052,8 +3812,9 @@ bool basecamp::process_camp_locker_downtime(npc &worker) {
 
 bool basecamp::service_camp_locker(npc &worker) {
   const faction_id fac_id = owner.is_valid() ? owner : your_fac;
+  locker_tile_snapshot.refresh(fac_id);
   const std::vector<tripoint_abs_ms> locker_tiles =
-      collect_sorted_camp_locker_tiles(worker.pos_abs(), fac_id);
+      locker_tile_snapshot.tiles_near(worker.pos_abs(), MAX_VIEW_DISTANCE);
   if (locker_tiles.empty()) {
     return false;
   }
@@ -3071,17 +3832,22 @@ bool basecamp::service_camp_locker(npc &worker) {
       collect_camp_locker_current_items(worker);
   const std::vector<const item *> worker_items =
       collect_camp_locker_worker_items(worker);
-  const std::vector<const item *> locker_items = collect_camp_locker_zone_items(
-      locker_tiles, locker_reservations, worker.getID());
+  locker_index.refresh(locker_tile_snapshot.all_tiles());
+  const std::vector<const item *> locker_items =
+      locker_index.items(locker_reservations, worker.getID(), &locker_tiles);
+  const std::optional<units::temperature> local_temperature =
+      get_weather().get_temperature(worker.pos_bub());
   const camp_locker_candidate_map locker_candidates =
-      collect_camp_locker_candidates(locker_items, locker_policy);
+      locker_index.ranked_candidates(locker_policy, locker_reservations,
+                                     worker.getID(), local_temperature,
+                                     &locker_tiles);
   int candidate_count = 0;
   for (const auto &entry : locker_candidates) {
     candidate_count += static_cast<int>(entry.second.size());
   }
-  const camp_locker_plan plan = plan_camp_locker_loadout(
-      current_items, locker_candidates, locker_policy,
-      get_weather().get_temperature(worker.pos_bub()));
+  const camp_locker_plan plan =
+      plan_camp_locker_loadout(current_items, locker_candidates, locker_policy,
+                               local_temperature, true);
   const camp_locker_ranged_readiness_state ranged_readiness =
       collect_camp_locker_ranged_readiness_state(worker, locker_policy,
                                                  worker_items, locker_items);
@@ -3244,6 +4010,7 @@ void basecamp::set_locker_slot_enabled(camp_locker_slot slot, bool enabled) {
     return;
   }
   locker_policy.set_enabled(slot, enabled);
+  locker_wave.valid = false;
   for (const npc_ptr &assignee : assigned_npcs) {
     if (assignee && assignee->assigned_camp && *assignee->assigned_camp == omt_pos) {
       mark_camp_locker_dirty(*assignee, true);
@@ -3452,4 +4219,5 @@ void basecamp_action_components::consume_components() {
         }
     }
     target_map.save();
+    base_.invalidate_crafting_inventory();
 }
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
@@ -256,6 +257,16 @@ struct camp_patrol_guard_runtime {
     camp_patrol_guard_behavior behavior = camp_patrol_guard_behavior::hold;
     std::vector<tripoint_abs_ms> route;
     tripoint_abs_ms target = tripoint_abs_ms::zero;
+    // The waypoint before target, where the current leg of a loop starts
+    tripoint_abs_ms leg_start = tripoint_abs_ms::zero;
+};
+
+// A walked leg between two waypoints of a patrol loop, kept until the map under it changes
+struct camp_patrol_leg {
+    // Every step after the start, ending at the next waypoint
+    std::vector<tripoint_abs_ms> path;
+    std::vector<tripoint_abs_sm> submaps;
+    uint64_t content_version = 0;
 };
 
 time_duration camp_patrol_loop_dwell();
@@ -290,6 +301,12 @@ struct camp_locker_slot_plan {
 
 using camp_locker_plan = std::map<camp_locker_slot, camp_locker_slot_plan>;
 
+namespace camp_locker_profiles {
+// Works out what the locker classifier needs from every item type, once the items are finalized
+void finalize_all();
+void reset();
+} // namespace camp_locker_profiles
+
 std::optional<camp_locker_slot> classify_camp_locker_item(const item &it);
 int score_camp_locker_item(
     camp_locker_slot slot, const item &it,
@@ -309,12 +326,126 @@ camp_locker_candidate_map collect_camp_locker_zone_candidates(
     const std::vector<camp_locker_reservation> &reservations,
     const character_id &requesting_worker,
     int range = MAX_VIEW_DISTANCE);
+// With candidates_ranked, every slot of locker_candidates is already ordered best first, the way
+// camp_locker_index::ranked_candidates returns them, so only the front of each is looked at.
 camp_locker_plan
 plan_camp_locker_loadout(
     const std::vector<const item *> &current_items,
     const camp_locker_candidate_map &locker_candidates,
     const camp_locker_policy &policy,
-    const std::optional<units::temperature> &local_temperature = std::nullopt);
+    const std::optional<units::temperature> &local_temperature = std::nullopt,
+    bool candidates_ranked = false);
+
+// The camp's locker tiles, classified into slots and kept between locker passes. A tile is only
+// read again once its submap's content version moves, and a slot is only re-ranked once one of
+// its candidates came or went or the weather band flipped.
+class camp_locker_index {
+public:
+  // Brings the index to exactly these tiles, re-reading only the ones that changed. Starts over
+  // when the reality bubble moved, the item pointers may not have survived that.
+  void refresh(const std::vector<tripoint_abs_ms> &tiles);
+  // The items on the indexed tiles in tile order, minus those reserved by other workers. With
+  // reach, only the tiles in it count, it must be sorted like collect_sorted_camp_locker_tiles.
+  std::vector<const item *>
+  items(const std::vector<camp_locker_reservation> &reservations,
+        const character_id &requesting_worker,
+        const std::vector<tripoint_abs_ms> *reach = nullptr) const;
+  // collect_camp_locker_candidates over items(), with every slot ranked best first
+  camp_locker_candidate_map ranked_candidates(
+      const camp_locker_policy &policy,
+      const std::vector<camp_locker_reservation> &reservations,
+      const character_id &requesting_worker,
+      const std::optional<units::temperature> &local_temperature,
+      const std::vector<tripoint_abs_ms> *reach = nullptr);
+  // The indexed tile holding this item
+  std::optional<tripoint_abs_ms> tile_of(const item *it) const;
+  // Goes up whenever a refresh changed anything
+  uint64_t get_generation() const { return generation; }
+
+private:
+  struct tile_entry {
+    uint64_t content_version = 0;
+    std::vector<const item *> items;
+    std::vector<std::pair<camp_locker_slot, const item *>> candidates;
+  };
+  struct ranked_candidate {
+    tripoint_abs_ms tile;
+    const item *it = nullptr;
+    int score = 0;
+  };
+  struct slot_ranking {
+    bool valid = false;
+    int temperature_band = 0;
+    std::vector<ranked_candidate> ranked;
+  };
+  void invalidate_slots(const tile_entry &entry);
+
+  std::vector<tripoint_abs_ms> tile_order;
+  std::map<tripoint_abs_ms, tile_entry> tiles;
+  std::array<slot_ranking, static_cast<size_t>(camp_locker_slot::num_slots)>
+      rankings;
+  std::optional<tripoint_abs_sm> bubble_origin;
+  uint64_t generation = 0;
+};
+
+// Every locker tile of a faction, gathered from the zones once and shared by all the workers
+// of a camp instead of each of them asking the zone manager.
+class camp_locker_tile_snapshot {
+public:
+  // Gathers the tiles again only once the zones changed
+  void refresh(const faction_id &fac);
+  // Exactly what collect_sorted_camp_locker_tiles returns for origin and range
+  std::vector<tripoint_abs_ms> tiles_near(const tripoint_abs_ms &origin,
+                                          int range) const;
+  // Every tile, sorted like collect_sorted_camp_locker_tiles
+  const std::vector<tripoint_abs_ms> &all_tiles() const { return tiles; }
+
+private:
+  std::vector<tripoint_abs_ms> tiles;
+  // Tiles only a vehicle zone marks, those are only near on their own z-level
+  std::vector<bool> vehicle_only;
+  std::optional<int> zone_version;
+  faction_id fac;
+};
+
+// What the last locker wave worked out for one worker, see basecamp::plan_camp_locker_wave.
+// It holds no item pointers, so it can outlive the items it was worked out from.
+struct camp_locker_worker_outlook {
+  // The locker tiles in the worker's reach when it was worked out
+  std::vector<tripoint_abs_ms> reach;
+  // The picks of its plan, reserved against the workers after it in the wave
+  std::vector<camp_locker_reservation> claims;
+  std::string signature;
+  std::string plan_summary;
+  std::string ranged_summary;
+  bool has_changes = false;
+  uint64_t inventory_version = 0;
+  int temperature_band = 0;
+};
+
+struct camp_locker_wave {
+  std::map<character_id, camp_locker_worker_outlook> outlooks;
+  // The workers in the order they claimed their picks
+  std::vector<character_id> order;
+  uint64_t index_generation = 0;
+  std::vector<camp_locker_reservation> reservations;
+  bool valid = false;
+};
+
+// What a camp's workers did while it was outside the reality bubble, kept
+// until it is loaded again and folded back into the real workers.
+struct camp_offscreen_ledger {
+  // How far the coarse simulation has got
+  time_point simulated_until = calendar::turn_zero;
+  // Worker hours put into each camp job
+  std::map<activity_id, time_duration> job_hours;
+  // What each worker drew from the larder and has not eaten yet
+  std::map<character_id, nutrients> owed_meals;
+  // Worker hours spent with nothing left in the larder
+  time_duration hungry_hours = 0_turns;
+
+  bool empty() const;
+};
 std::vector<tripoint_abs_ms>
 collect_sorted_camp_patrol_tiles(const tripoint_abs_ms &origin,
                                  const faction_id &fac,
@@ -629,8 +760,12 @@ public:
   // expansions
   std::unordered_set<recipe_id> recipe_deck_all() const;
   int recipe_batch_max(const recipe &making) const;
+  // Both keep the last inventory while the storage tiles haven't changed this turn
   void form_crafting_inventory();
         void form_crafting_inventory( map &target_map );
+  // For changes the storage tiles' content versions don't show, like charges used up in place
+  void invalidate_crafting_inventory();
+  const inventory &get_crafting_inventory() const { return _inv; }
         std::list<item> use_charges( const itype_id &fake_id, int &quantity );
         /**
          * spawn items or corpses based on search attempts
@@ -873,17 +1008,35 @@ public:
   std::optional<camp_patrol_guard_runtime> get_current_patrol_runtime(
       const character_id &worker_id, const time_point &turn = calendar::turn);
   bool is_worker_on_patrol_shift(const npc &worker);
+  // The cached path of a patrol leg, routed for this guard if there is none or
+  // the map along it changed. Null if the guard can't get there.
+  const std::vector<tripoint_abs_ms> *get_patrol_leg(npc &guard,
+                                                      const tripoint_abs_ms &from,
+                                                      const tripoint_abs_ms &to);
   bool interrupt_patrol_worker(
       const character_id &worker_id,
       camp_patrol_interrupt_reason reason =
           camp_patrol_interrupt_reason::explicit_reassignment);
   void mark_camp_locker_dirty(npc &worker, bool high_priority = false);
   bool process_camp_locker_downtime(npc &worker);
+  // Works out the locker outlook of every worker of the camp in one pass over the shared locker
+  // tiles. Workers earlier in the service queue claim their picks first, so later ones plan
+  // around them.
+  void plan_camp_locker_wave(npc &requesting_worker);
+  // The wave's outlook for this worker, planning the wave again or just the
+  // worker's outlook if anything it depends on changed
+  const camp_locker_worker_outlook &camp_locker_outlook(npc &worker);
   bool service_camp_locker(npc &worker);
   bool is_locker_slot_enabled(camp_locker_slot slot) const;
   void set_locker_slot_enabled(camp_locker_slot slot, bool enabled);
   const camp_locker_policy &get_locker_policy() const { return locker_policy; }
   void form_storage_zones(map &here, const tripoint_abs_ms &abspos);
+  // Advances the camp's jobs and its workers' meals in coarse steps while the
+  // camp is outside the reality bubble, and folds them back in once loaded.
+  void simulate_offscreen(const time_point &until = calendar::turn);
+  const camp_offscreen_ledger &get_offscreen_ledger() const {
+    return offscreen;
+  }
   map &get_camp_map();
   void unload_camp_map();
   void set_owner(faction_id new_owner);
@@ -912,6 +1065,10 @@ private:
   tripoint_abs_ms patrol_origin() const;
   bool refresh_patrol_shift_cache();
   void clear_patrol_shift_cache();
+  // Routes the legs of every loaded guard's loop up front
+  void precompute_patrol_legs();
+  bool is_in_reality_bubble() const;
+  void reconcile_offscreen();
 
   // Which faction owns this camp?
   mutable faction_id owner = faction_id::NULL_ID();
@@ -944,13 +1101,32 @@ private:
   int patrol_shift_cache_day = -1;
   camp_patrol_shift patrol_shift_cache_kind = camp_patrol_shift::day;
   camp_patrol_shift_plan patrol_shift_cache;
+  int patrol_shift_cache_zone_version = -1;
+  // NOLINTNEXTLINE(cata-serialize)
+  std::map<std::pair<tripoint_abs_ms, tripoint_abs_ms>, camp_patrol_leg> patrol_legs;
   std::vector<character_id> locker_service_queue;
   time_point locker_next_service_turn = calendar::turn_zero;
   std::vector<camp_locker_reservation> locker_reservations; // NOLINT(cata-serialize)
+  camp_locker_index locker_index; // NOLINT(cata-serialize)
+  camp_locker_tile_snapshot locker_tile_snapshot; // NOLINT(cata-serialize)
+  camp_locker_wave locker_wave; // NOLINT(cata-serialize)
+  camp_offscreen_ledger offscreen;
   int next_camp_request_id = 1;
   std::vector<std::vector<ui_mission_id>>
       temp_ui_mission_keys; // NOLINT(cata-serialize)
   inventory _inv;           // NOLINT(cata-serialize)
+  // What _inv was formed from, it is formed again once any of it differs
+  struct crafting_inventory_key {
+    const map *formed_on = nullptr;
+    tripoint_abs_sm map_origin;
+    time_point turn = calendar::before_time_starts;
+    std::vector<std::pair<tripoint_abs_ms, uint64_t>> tile_versions;
+    bool operator==(const crafting_inventory_key &rhs) const {
+      return formed_on == rhs.formed_on && map_origin == rhs.map_origin &&
+             turn == rhs.turn && tile_versions == rhs.tile_versions;
+    }
+  };
+  std::optional<crafting_inventory_key> _inv_key; // NOLINT(cata-serialize)
   bool by_radio = false;    // NOLINT(cata-serialize)
 };
 
@@ -18,11 +18,23 @@
 #ifdef __ANDROID__
 #define MALLOC_USABLE_SIZE_QUALIFIER const
 #endif
+#ifdef CATA_ALLOC_TRACKING
+// The tracking operator new below forwards to snmalloc instead.
+#include <snmalloc/snmalloc.h>
+#else
 #if defined(__clang__) || defined(__GNUC__)
 #define SNMALLOC_EXPORT __attribute__((visibility("default")))
 #endif
 #include <snmalloc/override/new.cc> // NOLINT(bugprone-suspicious-include)
 #endif
+#endif
+
+#ifdef CATA_ALLOC_TRACKING
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#endif
 
 #if defined(TILES) || defined(SDL_SOUND)
 #define SDL_SET_MEMORY_FUNCTIONS
@@ -33,6 +45,239 @@
 #endif
 #endif
 
+cata::allocator_stats cata::get_allocator_stats()
+{
+    allocator_stats stats;
+#ifdef CATA_USE_SNMALLOC
+    stats.available = true;
+    stats.current_bytes = snmalloc::Alloc::Config::Backend::get_current_usage();
+    stats.peak_bytes = snmalloc::Alloc::Config::Backend::get_peak_usage();
+#endif
+    return stats;
+}
+
+#ifdef CATA_ALLOC_TRACKING
+namespace
+{
+
+struct tag_counters {
+    std::atomic<uint64_t> allocations{ 0 };
+    std::atomic<uint64_t> frees{ 0 };
+    std::atomic<uint64_t> allocated_bytes{ 0 };
+    std::atomic<int64_t> live_bytes{ 0 };
+};
+
+// Constant initialized, so allocations before main are counted too.
+std::array<tag_counters, cata::allocation_tag_count> counters;
+thread_local uint32_t current_tag = 0;
+
+// In front of every block, keeps the returned pointer aligned to at least 16.
+struct alignas( 16 ) block_header {
+    size_t size;
+    uint32_t tag;
+    // From the start of the underlying allocation to the returned pointer.
+    uint32_t offset;
+};
+static_assert( sizeof( block_header ) == 16 );
+
+void *raw_alloc( size_t size )
+{
+#ifdef CATA_USE_SNMALLOC
+    return snmalloc::libc::malloc( size );
+#else
+    return std::malloc( size );
+#endif
+}
+
+void raw_free( void *p )
+{
+#ifdef CATA_USE_SNMALLOC
+    snmalloc::libc::free( p );
+#else
+    std::free( p );
+#endif
+}
+
+void *tracked_alloc( size_t size, size_t align ) noexcept
+{
+    const size_t slack = align > sizeof( block_header ) ? align : sizeof( block_header );
+    char *const base = static_cast<char *>( raw_alloc( size + slack + sizeof( block_header ) ) );
+    if( base == nullptr ) {
+        return nullptr;
+    }
+    const uintptr_t first = reinterpret_cast<uintptr_t>( base ) + sizeof( block_header );
+    const uintptr_t aligned = ( first + slack - 1 ) / slack * slack;
+    char *const user = reinterpret_cast<char *>( aligned );
+    block_header *header = reinterpret_cast<block_header *>( user ) - 1;
+    header->size = size;
+    header->tag = current_tag < cata::allocation_tag_count ? current_tag :
+                  cata::allocation_tag_count - 1;
+    header->offset = static_cast<uint32_t>( user - base );
+    tag_counters &c = counters[header->tag];
+    c.allocations.fetch_add( 1, std::memory_order_relaxed );
+    c.allocated_bytes.fetch_add( size, std::memory_order_relaxed );
+    c.live_bytes.fetch_add( static_cast<int64_t>( size ), std::memory_order_relaxed );
+    return user;
+}
+
+void tracked_free( void *p ) noexcept
+{
+    if( p == nullptr ) {
+        return;
+    }
+    block_header *header = static_cast<block_header *>( p ) - 1;
+    tag_counters &c = counters[header->tag];
+    c.frees.fetch_add( 1, std::memory_order_relaxed );
+    c.live_bytes.fetch_sub( static_cast<int64_t>( header->size ), std::memory_order_relaxed );
+    raw_free( static_cast<char *>( p ) - header->offset );
+}
+
+void *tracked_new( size_t size, size_t align )
+{
+    while( true ) {
+        if( void *p = tracked_alloc( size, align ) ) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if( handler == nullptr ) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *tracked_new_nothrow( size_t size, size_t align ) noexcept
+{
+    try {
+        return tracked_new( size, align );
+    } catch( ... ) {
+        return nullptr;
+    }
+}
+
+} // namespace
+
+// NOLINTBEGIN(misc-new-delete-overloads)
+void *operator new( size_t size )
+{
+    return tracked_new( size, 0 );
+}
+void *operator new[]( size_t size )
+{
+    return tracked_new( size, 0 );
+}
+void *operator new( size_t size, const std::nothrow_t & ) noexcept
+{
+    return tracked_new_nothrow( size, 0 );
+}
+void *operator new[]( size_t size, const std::nothrow_t & ) noexcept
+{
+    return tracked_new_nothrow( size, 0 );
+}
+void *operator new( size_t size, std::align_val_t align )
+{
+    return tracked_new( size, static_cast<size_t>( align ) );
+}
+void *operator new[]( size_t size, std::align_val_t align )
+{
+    return tracked_new( size, static_cast<size_t>( align ) );
+}
+void *operator new( size_t size, std::align_val_t align, const std::nothrow_t & ) noexcept
+{
+    return tracked_new_nothrow( size, static_cast<size_t>( align ) );
+}
+void *operator new[]( size_t size, std::align_val_t align, const std::nothrow_t & ) noexcept
+{
+    return tracked_new_nothrow( size, static_cast<size_t>( align ) );
+}
+// Every block knows where it starts, so all the deletes are the same.
+void operator delete( void *p ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete[]( void *p ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete( void *p, size_t ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete[]( void *p, size_t ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete( void *p, const std::nothrow_t & ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete[]( void *p, const std::nothrow_t & ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete( void *p, std::align_val_t ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete[]( void *p, std::align_val_t ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete( void *p, size_t, std::align_val_t ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete[]( void *p, size_t, std::align_val_t ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete( void *p, std::align_val_t, const std::nothrow_t & ) noexcept
+{
+    tracked_free( p );
+}
+void operator delete[]( void *p, std::align_val_t, const std::nothrow_t & ) noexcept
+{
+    tracked_free( p );
+}
+// NOLINTEND(misc-new-delete-overloads)
+
+uint32_t cata::set_allocation_tag( uint32_t tag )
+{
+    const uint32_t previous = current_tag;
+    current_tag = tag;
+    return previous;
+}
+
+std::vector<cata::allocation_tag_stats> cata::get_allocation_tag_stats()
+{
+    std::vector<allocation_tag_stats> stats;
+    for( uint32_t tag = 0; tag < allocation_tag_count; ++tag ) {
+        const tag_counters &c = counters[tag];
+        allocation_tag_stats s;
+        s.tag = tag;
+        s.allocations = c.allocations.load( std::memory_order_relaxed );
+        if( s.allocations == 0 ) {
+            continue;
+        }
+        s.frees = c.frees.load( std::memory_order_relaxed );
+        s.allocated_bytes = c.allocated_bytes.load( std::memory_order_relaxed );
+        s.live_bytes = c.live_bytes.load( std::memory_order_relaxed );
+        stats.push_back( s );
+    }
+    return stats;
+}
+#else
+uint32_t cata::set_allocation_tag( uint32_t )
+{
+    return 0;
+}
+
+std::vector<cata::allocation_tag_stats> cata::get_allocation_tag_stats()
+{
+    return {};
+}
+#endif
+
 void cata::init_allocator()
 {
 #ifdef SDL_SET_MEMORY_FUNCTIONS
@@ -2,11 +2,57 @@
 #ifndef CATA_SRC_CATA_ALLOCATOR_H
 #define CATA_SRC_CATA_ALLOCATOR_H
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace cata
 {
 
 void init_allocator();
 
+struct allocator_stats {
+    // false when the game was built without snmalloc, the sizes are then unknown
+    bool available = false;
+    // bytes the allocator currently holds from the system, and the most it has held
+    size_t current_bytes = 0;
+    size_t peak_bytes = 0;
+};
+
+allocator_stats get_allocator_stats();
+
+/**
+ * Allocation tracking, only built with CATA_ALLOC_TRACKING. Every operator new and delete is
+ * counted against the tag of the calling thread, which the innermost traced perf_trace zone
+ * sets to its zone index plus one, 0 outside of any zone. Each block carries a small header
+ * with its size and tag, so frees are counted against the tag that allocated the block.
+ */
+constexpr bool allocation_tracking_enabled()
+{
+#ifdef CATA_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** Tags past this are counted as the last one. */
+constexpr uint32_t allocation_tag_count = 256;
+
+struct allocation_tag_stats {
+    uint32_t tag = 0;
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t allocated_bytes = 0;
+    // Allocated by this tag and not freed yet.
+    int64_t live_bytes = 0;
+};
+
+/** Sets the calling thread's tag, returns the previous one. */
+uint32_t set_allocation_tag( uint32_t tag );
+/** The totals since startup of every tag that allocated anything, empty without tracking. */
+std::vector<allocation_tag_stats> get_allocation_tag_stats();
+
 } // namespace cata
 
 #endif // CATA_SRC_CATA_ALLOCATOR_H
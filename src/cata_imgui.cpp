@@ -747,6 +747,69 @@ void cataimgui::set_scroll( scroll &s )
     s = scroll::none;
 }
 
+bool cataimgui::retained_text::outdated( size_t key )
+{
+    if( built_for == key ) {
+        return false;
+    }
+    entries.clear();
+    built_for = key;
+    return true;
+}
+
+void cataimgui::retained_text::invalidate()
+{
+    built_for.reset();
+}
+
+void cataimgui::retained_text::paragraph( std::string text, const nc_color &color )
+{
+    entries.push_back( { op::paragraph, std::move( text ), color } );
+}
+
+void cataimgui::retained_text::new_line()
+{
+    entries.push_back( { op::new_line, {}, {} } );
+}
+
+void cataimgui::retained_text::same_line()
+{
+    entries.push_back( { op::same_line, {}, {} } );
+}
+
+void cataimgui::retained_text::indent()
+{
+    entries.push_back( { op::indent, {}, {} } );
+}
+
+void cataimgui::retained_text::unindent()
+{
+    entries.push_back( { op::unindent, {}, {} } );
+}
+
+void cataimgui::retained_text::draw() const
+{
+    for( const entry &e : entries ) {
+        switch( e.what ) {
+            case op::paragraph:
+                TextColoredParagraph( e.color, e.text );
+                break;
+            case op::new_line:
+                ImGui::NewLine();
+                break;
+            case op::same_line:
+                ImGui::SameLine();
+                break;
+            case op::indent:
+                ImGui::Indent();
+                break;
+            case op::unindent:
+                ImGui::Unindent();
+                break;
+        }
+    }
+}
+
 void cataimgui::draw_colored_text( const std::string &original_text, const nc_color &color,
                                    float wrap_width, bool *is_selected, bool *is_focused, bool *is_hovered )
 {
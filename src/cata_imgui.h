@@ -1,12 +1,15 @@
 #pragma once
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 #include "color.h"
 #include "font_loader.h"
+#include "hash_utils.h"
 
 class nc_color;
 struct input_event;
@@ -114,6 +117,55 @@ void draw_colored_text( const std::string &original_text,
                         float wrap_width = 0.0F, bool *is_selected = nullptr,
                         bool *is_focused = nullptr, bool *is_hovered = nullptr );
 
+/**
+ * Text a window keeps from frame to frame, for contents that take work to put together.
+ * Each frame the window hashes what the text depends on into a key, see @ref retained_key,
+ * and builds the text again only when the key isn't the one it was built for. Drawing just
+ * replays what was built, so a frame in which nothing changed costs the key and the drawing.
+ */
+class retained_text
+{
+    public:
+        /** Whether the text was built for another key than @p key. If so it is emptied, to be built anew. */
+        bool outdated( size_t key );
+        /** Empties the text, so the next call to @ref outdated asks for it to be built again. */
+        void invalidate();
+
+        /** Colored text as drawn by TextColoredParagraph, wrapped to the window. */
+        void paragraph( std::string text, const nc_color &color );
+        void new_line();
+        void same_line();
+        void indent();
+        void unindent();
+
+        void draw() const;
+
+    private:
+        enum class op : uint8_t {
+            paragraph,
+            new_line,
+            same_line,
+            indent,
+            unindent
+        };
+        struct entry {
+            op what;
+            std::string text;
+            nc_color color;
+        };
+        std::vector<entry> entries;
+        std::optional<size_t> built_for;
+};
+
+/** The key of a @ref retained_text that depends on @p deps. */
+template<typename... Deps>
+size_t retained_key( const Deps &... deps )
+{
+    size_t seed = 0;
+    ( cata::hash_combine( seed, deps ), ... );
+    return seed;
+}
+
 class window
 {
         std::unique_ptr<class window_impl> p_impl;
@@ -71,6 +71,7 @@
 #include "npc.h"
 #include "npc_attack.h"
 #include "omdata.h"
+#include "options.h"
 #include "output.h"
 #include "overlay_ordering.h"
 #include "overmap.h"
@@ -84,6 +85,7 @@
 #include "sounds.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "translation.h"
 #include "trap.h"
@@ -111,6 +113,9 @@ static const trap_str_id tr_unfinished_construction( "tr_unfinished_construction
 static const std::string ITEM_HIGHLIGHT( "highlight_item" );
 static const std::string ZOMBIE_REVIVAL_INDICATOR( "zombie_revival_indicator" );
 
+static const option_handle<bool> option_nv_green_toggle( "NV_GREEN_TOGGLE" );
+static const option_handle<bool> option_animation_sct_use_font( "ANIMATION_SCT_USE_FONT" );
+
 static const std::array<std::string, 8> multitile_keys = {{
         "center",
         "corner",
@@ -276,6 +281,20 @@ void cata_tiles::on_options_changed()
     minimap->set_settings( settings );
 }
 
+void tileset::collect_atlases( std::unordered_set<SDL_Texture *> &out ) const
+{
+    for( const std::vector<texture> *sprites : {
+             &tile_values, &shadow_tile_values, &night_tile_values, &overexposed_tile_values,
+             &memory_tile_values
+         } ) {
+        for( const texture &sprite : *sprites ) {
+            if( sprite.atlas() != nullptr ) {
+                out.insert( sprite.atlas() );
+            }
+        }
+    }
+}
+
 void tileset::clear()
 {
     tile_values.clear();
@@ -358,6 +377,9 @@ tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_til
 void cata_tiles::load_tileset( const std::string &tileset_id, const bool precheck,
                                const bool force, const bool pump_events, const bool terrain )
 {
+    for( auto &season_cache : looks_like_cache ) {
+        season_cache.clear();
+    }
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
         return;
     }
@@ -430,16 +452,20 @@ static void get_tile_information( const cata_path &config_path, std::string &jso
     }
 }
 
-template<typename PixelConverter>
-static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
-        PixelConverter pixel_converter )
+static SDL_Surface_Ptr copy_surface_32( const SDL_Surface_Ptr &original )
 {
     cata_assert( original );
     SDL_Surface_Ptr surf = create_surface_32( original->w, original->h );
     cata_assert( surf );
     throwErrorIf( SDL_BlitSurface( original.get(), nullptr, surf.get(), nullptr ) != 0,
                   "SDL_BlitSurface failed" );
+    return surf;
+}
 
+template<typename PixelConverter>
+static void apply_color_filter( const SDL_Surface_Ptr &surf, PixelConverter pixel_converter )
+{
+    cata_assert( surf );
     SDL_Color *pix = static_cast<SDL_Color *>( surf->pixels );
 
     for( int y = 0, ey = surf->h; y < ey; ++y ) {
@@ -452,8 +478,6 @@ static SDL_Surface_Ptr apply_color_filter( const SDL_Surface_Ptr &original,
             *pix = pixel_converter( *pix );
         }
     }
-
-    return surf;
 }
 
 static bool is_contained( const SDL_Rect &smaller, const SDL_Rect &larger )
@@ -496,7 +520,8 @@ void tileset_cache::loader::create_textures_from_tile_atlas( const SDL_Surface_P
 
     /** perform color filter conversion here */
     using tiles_pixel_color_entry = std::tuple<std::vector<texture>*, std::string>;
-    std::array<tiles_pixel_color_entry, 5> tile_values_data = {{
+    constexpr size_t num_filters = 5;
+    std::array<tiles_pixel_color_entry, num_filters> tile_values_data = {{
             { std::make_tuple( &ts.tile_values, "color_pixel_none" ) },
             { std::make_tuple( &ts.shadow_tile_values, "color_pixel_grayscale" ) },
             { std::make_tuple( &ts.night_tile_values, "color_pixel_nightvision" ) },
@@ -504,18 +529,35 @@ void tileset_cache::loader::create_textures_from_tile_atlas( const SDL_Surface_P
             { std::make_tuple( &ts.memory_tile_values, tilecontext->memory_map_mode ) }
         }
     };
-    for( tiles_pixel_color_entry &entry : tile_values_data ) {
-        std::vector<texture> *tile_values = std::get<0>( entry );
-        color_pixel_function_pointer color_pixel_function = get_color_pixel_function( std::get<1>
-                ( entry ) );
-        if( !color_pixel_function ) {
-            // TODO: Move it inside apply_color_filter.
-            copy_surface_to_texture( tile_atlas, offset, *tile_values );
+    std::array<color_pixel_function_pointer, num_filters> color_pixel_functions;
+    std::array<SDL_Surface_Ptr, num_filters> filtered;
+    std::vector<int> parallel_filters;
+    for( size_t i = 0; i < num_filters; ++i ) {
+        color_pixel_functions[i] = get_color_pixel_function( std::get<1>( tile_values_data[i] ) );
+        if( !color_pixel_functions[i] ) {
+            continue;
+        }
+        // Blitting may RLE encode the shared atlas, so copy it on this thread.
+        filtered[i] = copy_surface_32( tile_atlas );
+        if( color_pixel_functions[i] == color_pixel_custom ) {
+            // Reads options for every pixel, keep it off the worker threads.
+            apply_color_filter( filtered[i], color_pixel_functions[i] );
         } else {
-            copy_surface_to_texture( apply_color_filter( tile_atlas, color_pixel_function ), offset,
-                                     *tile_values );
+            parallel_filters.push_back( static_cast<int>( i ) );
         }
     }
+    // The per pixel conversion is most of the time spent loading a tileset, and each filter
+    // only writes its own copy.
+    cata::get_thread_pool().parallel_for( 0, static_cast<int>( parallel_filters.size() ),
+    [&]( int i ) {
+        const int entry = parallel_filters[i];
+        apply_color_filter( filtered[entry], color_pixel_functions[entry] );
+    } );
+    // Texture uploads have to happen on the thread owning the renderer.
+    for( size_t i = 0; i < num_filters; ++i ) {
+        copy_surface_to_texture( filtered[i] ? filtered[i] : tile_atlas, offset,
+                                 *std::get<0>( tile_values_data[i] ) );
+    }
 }
 
 template<typename T>
@@ -1745,6 +1787,18 @@ void cata_tiles::draw( const point &dest, const tripoint_bub_ms &center, int wid
             &cata_tiles::draw_zombie_revival_indicators
         }
     };
+    // Leave out the layers that can't draw anything this frame instead of asking every tile.
+    const bool draw_zone_marks = g->is_zones_manager_open();
+    const bool draw_revival = tileset_ptr->find_tile_type( ZOMBIE_REVIVAL_INDICATOR ) != nullptr;
+    std::array<decltype( &cata_tiles::draw_furniture ), drawing_layers.size()> active_layers{};
+    size_t num_active_layers = 0;
+    for( auto f : drawing_layers ) {
+        if( ( f == &cata_tiles::draw_zone_mark && !draw_zone_marks ) ||
+            ( f == &cata_tiles::draw_zombie_revival_indicators && !draw_revival ) ) {
+            continue;
+        }
+        active_layers[num_active_layers++] = f;
+    }
 
     // Skip drawing shadow of critters above if there is no shadow sprite
     bool do_draw_shadow = false;
@@ -1766,7 +1820,8 @@ void cata_tiles::draw( const point &dest, const tripoint_bub_ms &center, int wid
                 p.com.height_3d = ( cur_zlevel - center.z() ) * zlevel_height;
             }
             // For each layer
-            for( auto f : drawing_layers ) {
+            for( size_t layer = 0; layer < num_active_layers; ++layer ) {
+                const auto f = active_layers[layer];
                 // For each tile
                 for( tile_render_info &p : here.draw_points_cache[cur_zlevel][row] ) {
                     if( const tile_render_info::vision_effect * const
@@ -2321,6 +2376,28 @@ std::optional<tile_lookup_res>
 cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
                                   const std::string &variant,
                                   const int looks_like_jumps_limit ) const
+{
+    // Only whole lookups are remembered, the looks_like jumps they make pass smaller limits.
+    if( looks_like_jumps_limit != 10 ) {
+        return resolve_tile_looks_like( id, category, variant, looks_like_jumps_limit );
+    }
+    std::vector<looks_like_memo> &memos =
+        looks_like_cache[season_of_year( calendar::turn )][id];
+    for( const looks_like_memo &memo : memos ) {
+        if( memo.category == category && memo.variant == variant ) {
+            return memo.result;
+        }
+    }
+    std::optional<tile_lookup_res> result = resolve_tile_looks_like( id, category, variant,
+                                            looks_like_jumps_limit );
+    memos.push_back( { category, variant, result } );
+    return result;
+}
+
+std::optional<tile_lookup_res>
+cata_tiles::resolve_tile_looks_like( const std::string &id, TILE_CATEGORY category,
+                                     const std::string &variant,
+                                     const int looks_like_jumps_limit ) const
 {
     if( id.empty() || looks_like_jumps_limit <= 0 ) {
         return std::nullopt;
@@ -2533,7 +2610,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
         int intensity_level, const std::string &variant,
         const point &offset )
 {
-    bool nv_color_active = apply_night_vision_goggles && get_option<bool>( "NV_GREEN_TOGGLE" );
+    bool nv_color_active = apply_night_vision_goggles && option_nv_green_toggle.get();
     // If the ID string does not produce a drawable tile
     // it will revert to the "unknown" tile.
     // The "unknown" tile is one that is highly visible so you kinda can't miss it :D
@@ -4824,7 +4901,7 @@ void cata_tiles::draw_weather_frame()
 
 void cata_tiles::draw_sct_frame( std::multimap<point, formatted_text> &overlay_strings )
 {
-    const bool use_font = get_option<bool>( "ANIMATION_SCT_USE_FONT" );
+    const bool use_font = option_animation_sct_use_font.get();
     tripoint_bub_ms player_pos = get_player_character().pos_bub();
 
     for( const scrollingcombattext::cSCT &sct : SCT.vSCT ) {
@@ -145,12 +145,20 @@ class texture
         std::pair<int, int> dimension() const {
             return std::make_pair( srcrect.w, srcrect.h );
         }
+        /// The sheet this sprite is cut from, shared with the other sprites on it.
+        SDL_Texture *atlas() const {
+            return sdl_texture_ptr.get();
+        }
         /// Interface to @ref SDL_RenderCopyEx, using this as the texture, and
         /// null as source rectangle (render the whole texture). Other parameters
-        /// are simply passed through.
+        /// are simply passed through. Unrotated, unflipped sprites, most of them, go through
+        /// the plain @ref SDL_RenderCopy, which queues less vertex work per sprite.
         int render_copy_ex( const SDL_Renderer_Ptr &renderer, const SDL_Rect *const dstrect,
                             const double angle,
                             const SDL_Point *const center, const SDL_RendererFlip flip ) const {
+            if( angle == 0 && flip == SDL_FLIP_NONE ) {
+                return SDL_RenderCopy( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect );
+            }
             return SDL_RenderCopyEx( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect, angle, center,
                                      flip );
         }
@@ -225,6 +233,8 @@ class tileset
         std::unordered_map<std::string, std::vector<layer_context_sprites>> field_layer_data;
 
         void clear();
+        /** Adds the sheets the sprites of this tileset are cut from to @p out. */
+        void collect_atlases( std::unordered_set<SDL_Texture *> &out ) const;
 
         bool is_isometric() const {
             return tile_isometric;
@@ -452,6 +462,11 @@ class cata_tiles
         bool is_valid() {
             return tileset_ptr != nullptr;
         }
+        void collect_atlases( std::unordered_set<SDL_Texture *> &out ) const {
+            if( tileset_ptr ) {
+                tileset_ptr->collect_atlases( out );
+            }
+        }
 
         /** Draw to screen */
         void draw( const point &dest, const tripoint_bub_ms &center, int width, int height,
@@ -488,6 +503,11 @@ class cata_tiles
         find_tile_looks_like( const std::string &id, TILE_CATEGORY category, const std::string &variant,
                               int looks_like_jumps_limit = 10 ) const;
 
+        // find_tile_looks_like without the memo, also followed by each looks_like jump
+        std::optional<tile_lookup_res>
+        resolve_tile_looks_like( const std::string &id, TILE_CATEGORY category,
+                                 const std::string &variant, int looks_like_jumps_limit ) const;
+
         // this templated method is used only from it's own cpp file, so it's ok to declare it here
         template<typename T>
         std::optional<tile_lookup_res>
@@ -798,6 +818,16 @@ class cata_tiles
         tileset_cache &cache;
         std::shared_ptr<const tileset> tileset_ptr;
 
+        struct looks_like_memo {
+            TILE_CATEGORY category;
+            std::string variant;
+            std::optional<tile_lookup_res> result;
+        };
+        // Full find_tile_looks_like() lookups by season and id. They only depend on the tileset
+        // and the game data, so load_tileset(), which also runs after every data load, drops them.
+        mutable std::array<std::unordered_map<std::string, std::vector<looks_like_memo>>, NUM_SEASONS>
+        looks_like_cache;
+
         // the scaled default sprite width and height. in non-isometric mode,
         // the basic tile width and height equal the default sprite width and
         // height, but in isometric mode, the basic tile height is always
@@ -120,6 +120,36 @@ bool lcmatch( const translation &str, std::string_view qry )
     return lcmatch( str.translated(), qry );
 }
 
+lcmatch_key lcmatch_prepare( std::string_view str )
+{
+    lcmatch_key key;
+    key.lowered = utf8_to_utf32( str );
+    std::transform( key.lowered.begin(), key.lowered.end(), key.lowered.begin(), u32_to_lowercase );
+    key.unaccented = key.lowered;
+    std::for_each( key.unaccented.begin(), key.unaccented.end(), remove_accent );
+    return key;
+}
+
+std::u32string lcmatch_query( std::string_view qry )
+{
+    std::u32string u32_qry = utf8_to_utf32( qry );
+    std::transform( u32_qry.begin(), u32_qry.end(), u32_qry.begin(), u32_to_lowercase );
+    return u32_qry;
+}
+
+bool lcmatch( const lcmatch_key &key, std::u32string_view lowered_qry )
+{
+    if( lowered_qry.empty() ) {
+        return true;
+    }
+    // Same order as lcmatch( str, qry ) above.
+    if( key.lowered.find( lowered_qry ) != std::u32string::npos ||
+        key.unaccented.find( lowered_qry ) != std::u32string::npos ) {
+        return true;
+    }
+    return use_pinyin_search && pinyin::pinyin_match( key.unaccented, lowered_qry );
+}
+
 bool match_include_exclude( std::string_view text, std::string filter )
 {
     size_t iPos;
@@ -610,9 +640,10 @@ bool read_from_zzip_optional( const zzip &z,
         return false;
     }
     try {
-        std::vector<std::byte> file_data = z.get_file( file );
-        std::string_view sv{ reinterpret_cast<const char *>( file_data.data() ), file_data.size() };
-        reader( sv );
+        // Stored entries are read straight out of the mapping.
+        if( !z.read_file( file, reader ) ) {
+            reader( std::string_view() );
+        }
         return true;
     } catch( const std::exception &err ) {
         debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), file.generic_u8string().c_str(),
@@ -629,9 +660,10 @@ bool read_from_zzip_optional( const std::shared_ptr<zzip_stack> &z,
         return false;
     }
     try {
-        std::vector<std::byte> file_data = z->get_file( file );
-        std::string_view sv{ reinterpret_cast<const char *>( file_data.data() ), file_data.size() };
-        reader( sv );
+        // Stored entries are read straight out of the mapping.
+        if( !z->read_file( file, reader ) ) {
+            reader( std::string_view() );
+        }
         return true;
     } catch( const std::exception &err ) {
         debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), file.generic_u8string().c_str(),
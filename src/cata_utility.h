@@ -115,6 +115,22 @@ bool isBetween( int test, int down, int up );
 bool lcmatch( std::string_view str, std::string_view qry );
 bool lcmatch( const translation &str, std::string_view qry );
 
+/**
+ * A subject string folded once for many lcmatch() queries against it, as when
+ * filtering a long list of names with one query after another.
+ */
+struct lcmatch_key {
+    // lowercase form
+    std::u32string lowered;
+    // lowercase form with accents removed
+    std::u32string unaccented;
+};
+lcmatch_key lcmatch_prepare( std::string_view str );
+/** Lowercase form of a query, for the overload below. */
+std::u32string lcmatch_query( std::string_view qry );
+/** Same result as lcmatch( str, qry ) for key = lcmatch_prepare( str ), lowered_qry = lcmatch_query( qry ). */
+bool lcmatch( const lcmatch_key &key, std::u32string_view lowered_qry );
+
 /**
  * Matches text case insensitive with the include/exclude rules of the filter
  *
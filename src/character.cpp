@@ -446,6 +446,30 @@ void queued_eocs::pop()
     list.erase( it );
 }
 
+void queued_eocs::wake_up( const std::vector<effect_on_condition_id> &eocs )
+{
+    const auto wakes = [&eocs]( const queued_eoc & q ) {
+        return q.time > calendar::turn &&
+               std::find( eocs.begin(), eocs.end(), q.eoc ) != eocs.end();
+    };
+    if( std::none_of( list.begin(), list.end(), wakes ) ) {
+        return;
+    }
+    // Only entries that are in the queue: the ones process_eocs has popped get a new
+    // time when it pushes them back.
+    std::vector<storage_iter> entries;
+    entries.reserve( queue.size() );
+    while( !queue.empty() ) {
+        storage_iter it = queue.top();
+        queue.pop();
+        if( wakes( *it ) ) {
+            it->time = calendar::turn;
+        }
+        entries.push_back( it );
+    }
+    queue = decltype( queue )( eoc_compare(), std::move( entries ) );
+}
+
 void Character::queue_effects( const std::vector<effect_on_condition_id> &effects )
 {
     for( const effect_on_condition_id &eoc_id : effects ) {
@@ -581,6 +605,20 @@ Character::Character() :
 }
 // *INDENT-ON*
 
+struct carried_enchantment_cache {
+    struct entry {
+        const item *parent;
+        // Exactly one of these.
+        std::optional<enchant_cache> proc;
+        std::optional<enchantment> defined;
+        bool conditional;
+    };
+    std::vector<entry> entries;
+    std::optional<uint64_t> inventory_version;
+    // A moved character's entries point into the character it came from.
+    const Character *owner = nullptr;
+};
+
 Character::~Character() = default;
 Character::Character( Character && ) noexcept( map_is_noexcept ) = default;
 Character &Character::operator=( Character && ) noexcept( list_is_noexcept ) = default;
@@ -4766,22 +4804,54 @@ void Character::recalculate_bodyparts()
                    get_cached_organic_size() );
 }
 
-void Character::recalculate_enchantment_cache()
+void Character::invalidate_carried_enchantments()
 {
-    enchantment_cache->clear();
+    if( carried_enchantments ) {
+        carried_enchantments->inventory_version.reset();
+    }
+}
 
-    cache_visit_items_with( "is_relic", &item::is_relic, [this]( const item_location & it ) {
+const carried_enchantment_cache &Character::get_carried_enchantments()
+{
+    if( !carried_enchantments ) {
+        carried_enchantments = std::make_unique<carried_enchantment_cache>();
+    }
+    carried_enchantment_cache &carried = *carried_enchantments;
+    if( carried.inventory_version == inventory_version && carried.owner == this ) {
+        return carried;
+    }
+    carried.entries.clear();
+    cache_visit_items_with( "is_relic", &item::is_relic, [this, &carried]( const item_location & it ) {
         for( const enchant_cache &ench : it->get_proc_enchantments() ) {
-            if( ench.is_active( *this, *it ) ) {
-                enchantment_cache->force_add( ench );
+            if( ench.is_carried_right( *this, *it ) ) {
+                carried.entries.push_back( { it.get_item(), ench, std::nullopt, ench.is_conditional() } );
             }
         }
         for( const enchantment &ench : it->get_defined_enchantments() ) {
-            if( ench.is_active( *this, *it ) ) {
-                enchantment_cache->force_add( ench, *this );
+            if( ench.is_carried_right( *this, *it ) ) {
+                carried.entries.push_back( { it.get_item(), std::nullopt, ench, ench.is_conditional() } );
             }
         }
     } );
+    carried.inventory_version = inventory_version;
+    carried.owner = this;
+    return carried;
+}
+
+void Character::recalculate_enchantment_cache()
+{
+    enchantment_cache->clear();
+
+    for( const carried_enchantment_cache::entry &carried : get_carried_enchantments().entries ) {
+        if( carried.proc ) {
+            if( !carried.conditional || carried.proc->is_active( *this, carried.parent->active ) ) {
+                enchantment_cache->force_add( *carried.proc );
+            }
+        } else if( !carried.conditional ||
+                   carried.defined->is_active( *this, carried.parent->active ) ) {
+            enchantment_cache->force_add( *carried.defined, *this );
+        }
+    }
 
 
     for( const bionic &bio : *my_bionics ) {
@@ -6504,6 +6574,11 @@ void Character::process_one_effect( effect &it, bool is_new )
         }
     }
 
+    // Everything below reads a modifier, all of which are 0 and never activate without any.
+    if( !it.get_effect_type()->has_mod_data() ) {
+        return;
+    }
+
     // Handle health mod
     val = get_effect( "H_MOD", reduced );
     if( val != 0 ) {
@@ -10,6 +10,7 @@
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <queue>
 #include <set>
@@ -72,6 +73,7 @@ class character_martial_arts;
 class dispersion_sources;
 class effect;
 class enchant_cache;
+struct carried_enchantment_cache;
 class faction;
 class known_magic;
 class ma_technique;
@@ -336,6 +338,9 @@ struct queued_eocs {
     const queued_eoc &top() const;
     void push( const queued_eoc &eoc );
     void pop();
+
+    /** Moves the queued entries of these EOCs that are due later up to the current turn. */
+    void wake_up( const std::vector<effect_on_condition_id> &eocs );
 };
 
 struct aim_type {
@@ -2461,6 +2466,10 @@ class Character : public Creature, public visitable
         void invalidate_inventory_validity_cache();
 
         void invalidate_weight_carried_cache();
+        /** Goes up every time one of the two caches above is invalidated. */
+        uint64_t get_inventory_version() const {
+            return inventory_version;
+        }
         /** Returns all items that must be taken off before taking off this item */
         std::list<item *> get_dependent_worn_items( const item &it );
         /** Drops an item to the specified location */
@@ -3598,6 +3607,8 @@ class Character : public Creature, public visitable
                                              const tripoint_bub_ms &src_pos = tripoint_bub_ms::zero,
                                              int radius = PICKUP_RANGE, bool clear_path = true ) const;
         void invalidate_crafting_inventory();
+        /** Frees caches that are rebuilt on demand, for characters far from the reality bubble. */
+        void shed_caches();
 
         /** Returns a value from 1.0 to 11.0 that acts as a multiplier
          * for the time taken to perform tasks that require detail vision,
@@ -4073,6 +4084,9 @@ class Character : public Creature, public visitable
 
         trap_map known_traps;
         mutable std::map<std::string, double> cached_info;
+        /** Armour rating NPCs see on this character, from npc::estimate_armour, and the turn it was rated. */
+        mutable float cached_armour_estimate = 0.0f;
+        mutable time_point cached_armour_estimate_turn = calendar::before_time_starts;
         bool bio_soporific_powered_at_last_sleep_check = false;
         /** last time we checked for sleep */
         time_point last_sleep_check = calendar::turn_zero;
@@ -4109,6 +4123,7 @@ class Character : public Creature, public visitable
          * If it is nullopt, needs to be recalculated
          */
         mutable std::optional<units::mass> cached_weight_carried = std::nullopt;
+        uint64_t inventory_version = 0;
 
         void store( JsonOut &json ) const;
         void load( const JsonObject &data );
@@ -4265,6 +4280,19 @@ class Character : public Creature, public visitable
             std::list<item_location> items;
         };
         mutable std::unordered_map<std::string, inv_search_cache> inv_search_caches;
+
+        /**
+         * The enchantments of carried relics in the right place to count, in the order
+         * recalculate_enchantment_cache() adds them. Finding them walks the whole inventory for
+         * every relic, so they are kept while the inventory version stays the same and nothing
+         * clears the search caches. Only the conditional ones are checked again on every rebuild.
+         */
+        std::unique_ptr<carried_enchantment_cache> carried_enchantments;
+        const carried_enchantment_cache &get_carried_enchantments();
+    public:
+        // Makes the next recalculate_enchantment_cache() look for carried relics again.
+        void invalidate_carried_enchantments();
+    private:
     protected:
         // Bionic IDs are unique only within a character. Used to unambiguously identify bionics in a character
         bionic_uid weapon_bionic_uid = 0;
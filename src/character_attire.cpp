@@ -850,10 +850,17 @@ bool Character::is_wearing_active_optcloak() const
 }
 
 static void layer_item( std::map<bodypart_id, encumbrance_data> &vals, const item &it,
-                        std::map<sub_bodypart_id, layer_level> &highest_layer_so_far, const Character &c )
+                        std::map<sub_bodypart_id, layer_level> &highest_layer_so_far, const Character &c,
+                        const std::vector<bodypart_id> &body_parts )
 {
     body_part_set covered_parts = it.get_covered_body_parts();
-    for( const bodypart_id &bp : c.get_all_body_parts() ) {
+    // Looked up once per item rather than once per body part and layer.
+    const std::vector<sub_bodypart_id> covered_sub_parts = it.get_covered_sub_body_parts();
+    const bool semitangible = it.has_flag( flag_SEMITANGIBLE );
+    const bool personal = it.has_flag( flag_PERSONAL );
+    std::vector<sub_bodypart_id> sub_parts_here;
+    std::vector<layer_level> ll( 1 );
+    for( const bodypart_id &bp : body_parts ) {
         if( !covered_parts.test( bp.id() ) ) {
             continue;
         }
@@ -868,60 +875,62 @@ static void layer_item( std::map<bodypart_id, encumbrance_data> &vals, const ite
          * layering_encumbrance of 2 )
          * Personal layer items and semitangible items do not conflict.
          */
-        if( it.has_flag( flag_SEMITANGIBLE ) ) {
+        if( semitangible ) {
             encumber_val = 0;
             layering_encumbrance = 0;
         }
-        if( it.has_flag( flag_PERSONAL ) ) {
+        if( personal ) {
             layering_encumbrance = 0;
         }
+        // the sub parts of the item that are part of the body part we are checking
+        sub_parts_here.clear();
+        for( const sub_bodypart_id &sbp : covered_sub_parts ) {
+            if( std::find( bp->sub_parts.begin(), bp->sub_parts.end(), sbp.id() ) != bp->sub_parts.end() ) {
+                sub_parts_here.push_back( sbp );
+            }
+        }
+        encumbrance_data &bp_vals = vals[bp];
         for( layer_level item_layer : item_layers ) {
             // do the sublayers of this armor conflict
             bool conflicts = false;
 
             // check if we've already added conflict for the layer and body part since each sbp is checked individually
-            std::map<layer_level, bool> bpcovered;
+            std::array<bool, static_cast<size_t>( layer_level::NUM_LAYER_LEVELS )> bpcovered{};
 
             // add the sublocations to the overall body part layer and update if we are conflicting
-            for( sub_bodypart_id &sbp : it.get_covered_sub_body_parts() ) {
-                if( std::count_if( bp->sub_parts.begin(),
-                bp->sub_parts.end(), [sbp]( const sub_bodypart_str_id & bpid ) {
-                return sbp.id() == bpid;
-                } ) == 0 ) {
-                    // the sub part isn't part of the bodypart we are checking
-                    continue;
-                }
+            for( const sub_bodypart_id &sbp : sub_parts_here ) {
                 // bit hacky but needed since we are doing one layer at a time
-                std::vector<layer_level> ll;
-                ll.push_back( item_layer );
+                ll.front() = item_layer;
                 if( !it.has_layer( ll, sbp ) ) {
                     // skip this layer and sbp if it doesn't cover it
                     continue;
                 }
 
-                if( item_layer >= highest_layer_so_far[sbp] ) {
-                    conflicts = vals[bp].add_sub_location( item_layer, sbp );
+                layer_level &highest = highest_layer_so_far[sbp];
+                if( item_layer >= highest ) {
+                    conflicts = bp_vals.add_sub_location( item_layer, sbp );
                 } else {
                     // if it is on a lower layer it conflicts for sure
                     conflicts = true;
                 }
 
-                highest_layer_so_far[sbp] = std::max( highest_layer_so_far[sbp], item_layer );
+                highest = std::max( highest, item_layer );
 
                 // Apply layering penalty to this layer, as well as any layer worn
                 // within it that would normally be worn outside of it.
                 for( layer_level penalty_layer = item_layer;
-                     penalty_layer <= highest_layer_so_far[sbp]; ++penalty_layer ) {
+                     penalty_layer <= highest; ++penalty_layer ) {
 
                     // make sure we haven't already found a subpart that covers and would cause penalty
-                    if( !bpcovered[penalty_layer] ) {
-                        vals[bp].layer( penalty_layer, layering_encumbrance, conflicts );
-                        bpcovered[penalty_layer] = true;
+                    bool &covered = bpcovered[static_cast<size_t>( penalty_layer )];
+                    if( !covered ) {
+                        bp_vals.layer( penalty_layer, layering_encumbrance, conflicts );
+                        covered = true;
                     }
                 }
             }
         }
-        vals[bp].armor_encumbrance += encumber_val;
+        bp_vals.armor_encumbrance += encumber_val;
     }
 }
 
@@ -960,20 +969,21 @@ void outfit::item_encumb( std::map<bodypart_id, encumbrance_data> &vals,
     // Track highest layer observed so far so we can penalize out-of-order
     // items
     std::map<sub_bodypart_id, layer_level> highest_layer_so_far;
+    const std::vector<bodypart_id> body_parts = guy.get_all_body_parts();
 
     for( auto w_it = worn.begin(); w_it != worn.end(); ++w_it ) {
         if( w_it == new_item_position ) {
-            layer_item( vals, new_item, highest_layer_so_far, guy );
+            layer_item( vals, new_item, highest_layer_so_far, guy, body_parts );
         }
-        layer_item( vals, *w_it, highest_layer_so_far, guy );
+        layer_item( vals, *w_it, highest_layer_so_far, guy, body_parts );
     }
 
     if( worn.end() == new_item_position && !new_item.is_null() ) {
-        layer_item( vals, new_item, highest_layer_so_far, guy );
+        layer_item( vals, new_item, highest_layer_so_far, guy, body_parts );
     }
 
     // make sure values are sane
-    for( const bodypart_id &bp : guy.get_all_body_parts() ) {
+    for( const bodypart_id &bp : body_parts ) {
         encumbrance_data &elem = vals[bp];
 
         for( const layer_details &cur_layer : elem.layer_penalty_details ) {
@@ -1926,18 +1936,30 @@ int outfit::get_env_resist( bodypart_id bp ) const
 
 std::map<bodypart_id, int> outfit::warmth( const Character &guy ) const
 {
+    const std::vector<bodypart_id> body_parts = guy.get_all_body_parts();
+    // Mutations can grow or take away limbs without anything being worn differently.
+    if( dry_warmth_version != guy.get_inventory_version() || dry_warmth_owner != &guy ||
+        dry_warmth.size() != body_parts.size() ) {
+        dry_warmth.clear();
+        for( const bodypart_id &bp : body_parts ) {
+            std::vector<std::pair<int, bool>> &pieces = dry_warmth[bp];
+            for( const item &clothing : worn ) {
+                if( clothing.covers( bp ) ) {
+                    pieces.emplace_back( clothing.get_warmth( bp ), clothing.made_of( material_wool ) );
+                }
+            }
+        }
+        dry_warmth_version = guy.get_inventory_version();
+        dry_warmth_owner = &guy;
+    }
     std::map<bodypart_id, int> total_warmth;
-    for( const bodypart_id &bp : guy.get_all_body_parts() ) {
-        double warmth_val = 0.0;
+    for( const bodypart_id &bp : body_parts ) {
         const float wetness_pct = guy.get_part_wetness_percentage( bp );
-        for( const item &clothing : worn ) {
-            if( !clothing.covers( bp ) ) {
-                continue;
-            }
-            warmth_val = clothing.get_warmth( bp );
+        for( const std::pair<int, bool> &piece : dry_warmth[bp] ) {
+            double warmth_val = piece.first;
             // Wool items do not lose their warmth due to being wet.
             // Warmth is reduced by 0 - 66% based on wetness.
-            if( !clothing.made_of( material_wool ) ) {
+            if( !piece.second ) {
                 warmth_val *= 1.0 - 0.66 * wetness_pct;
             }
 
@@ -2557,6 +2579,7 @@ void outfit::serialize( JsonOut &json ) const
 void outfit::deserialize( const JsonObject &jo )
 {
     jo.read( "worn", worn );
+    invalidate_warmth();
 }
 
 int outfit::clatter_sound() const
@@ -139,6 +139,10 @@ class outfit
         int collar_warmth() const;
         /** Returns warmth provided by armor, etc. */
         std::map<bodypart_id, int> warmth( const Character &guy ) const;
+        /** What is worn or how it is worn changed, warmth() has to look at every item again. */
+        void invalidate_warmth() {
+            dry_warmth_version.reset();
+        }
         int get_env_resist( bodypart_id bp ) const;
         int sum_filthy_cover( bool ranged, bool melee, bodypart_id bp ) const;
         ret_val<void> power_armor_conflicts( const item &clothing ) const;
@@ -255,6 +259,13 @@ class outfit
 
         void serialize( JsonOut &json ) const;
         void deserialize( const JsonObject &jo );
+
+    private:
+        // For warmth(), the warmth of each item on each body part and whether it's wool, so it
+        // stays warm when wet. Kept while the wearer's inventory version stays the same.
+        mutable std::map<bodypart_id, std::vector<std::pair<int, bool>>> dry_warmth;
+        mutable std::optional<uint64_t> dry_warmth_version;
+        mutable const Character *dry_warmth_owner = nullptr;
 };
 
 units::mass get_selected_stack_weight( const item *i, const std::map<const item *, int> &without );
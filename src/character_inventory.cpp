@@ -281,6 +281,8 @@ units::volume Character::max_single_item_volume() const
 std::pair<item_location, item_pocket *> Character::best_pocket( const item &it, const item *avoid,
         bool ignore_settings )
 {
+    // Every candidate pocket asks after the contents of everything around it.
+    item_pocket::aggregate_scope aggregates;
     item_location weapon_loc( *this, &weapon );
     std::pair<item_location, item_pocket *> ret = std::make_pair( item_location(), nullptr );
     if( &weapon != &it && &weapon != avoid ) {
@@ -1130,6 +1132,7 @@ units::mass Character::weight_carried() const
 void Character::invalidate_weight_carried_cache()
 {
     cached_weight_carried = std::nullopt;
+    ++inventory_version;
 }
 
 units::mass Character::weight_carried_with_tweaks( const std::vector<std::pair<item_location, int>>
@@ -1147,6 +1150,7 @@ units::mass Character::weight_carried_with_tweaks( const item_tweaks &tweaks ) c
     const std::map<const item *, int> empty;
     const std::map<const item *, int> &without = tweaks.without_items ? tweaks.without_items->get() :
             empty;
+    item_pocket::aggregate_scope aggregates;
 
     // Worn items
     units::mass ret = worn.weight_carried_with_tweaks( without );
@@ -1181,6 +1185,7 @@ units::mass Character::weight_carried_with_tweaks( const item_tweaks &tweaks ) c
 bool Character::can_pickVolume( const item &it, bool, const item *avoid,
                                 const bool ignore_pkt_settings ) const
 {
+    item_pocket::aggregate_scope aggregates;
     if( ( avoid == nullptr || &weapon != avoid ) &&
         weapon.can_contain( it, false, false, ignore_pkt_settings ).success() ) {
         return true;
@@ -1244,6 +1249,7 @@ ret_val<void> Character::can_unwield( const item &it ) const
 void Character::invalidate_inventory_validity_cache()
 {
     cache_inventory_is_valid = false;
+    ++inventory_version;
 }
 bool Character::is_wielding( const item &target ) const
 {
@@ -1275,7 +1281,9 @@ void Character::calc_encumbrance( const item &new_item )
     for( const std::pair<const bodypart_id, encumbrance_data> &elem : enc ) {
         set_part_encumbrance_data( elem.first, elem.second );
     }
-
+    // What we wear changed, so NPCs have to rate our armour again.
+    cached_armour_estimate_turn = calendar::before_time_starts;
+    worn.invalidate_warmth();
 }
 
 void layer_details::reset()
@@ -1689,6 +1697,7 @@ units::volume Character::free_space( const std::function<bool( const item_pocket
 {
     units::volume expansion =
         0_ml; // discarded, currently don't care if the character's held item would need to get bigger
+    item_pocket::aggregate_scope aggregates;
     return weapon.get_remaining_volume_recursive( include_pocket, check_pocket_tree, expansion )
            + worn.remaining_volume_recursive( include_pocket, check_pocket_tree );
 }
@@ -1717,6 +1726,7 @@ units::volume Character::volume_capacity_recursive(
     units::volume volume_capacity = 0_ml;
     // discard, currently don't care if inventory has to grow in overall volume
     units::volume expansion = 0_ml;
+    item_pocket::aggregate_scope aggregates;
     volume_capacity += weapon.get_volume_capacity_recursive( include_pocket,
                        check_pocket_tree,
                        expansion
@@ -1732,6 +1742,7 @@ units::volume Character::volume_capacity_recursive(
 
 units::volume Character::volume_carried() const
 {
+    item_pocket::aggregate_scope aggregates;
     units::volume volume = 0_ml;
     volume += weapon.volume();
     for( const item &it : worn.worn ) {
@@ -2196,6 +2207,7 @@ void Character::add_to_inv_search_caches( item &it ) const
 void Character::clear_inventory_search_cache()
 {
     inv_search_caches.clear();
+    invalidate_carried_enchantments();
 }
 
 bool Character::has_charges( const itype_id &it, int quantity,
@@ -2559,6 +2571,15 @@ void Character::invalidate_pseudo_items()
     pseudo_items_valid = false;
 }
 
+void Character::shed_caches()
+{
+    invalidate_crafting_inventory();
+    inv_search_caches.clear();
+    cached_info.clear();
+    pseudo_items_valid = false;
+    pseudo_items = std::vector<const item *>();
+}
+
 void Character::on_worn_item_transform( const item &old_it, const item &new_it )
 {
     morale->on_worn_item_transform( old_it, new_it );
@@ -2665,7 +2686,7 @@ void Character::search_surroundings()
     // Search for traps in a larger area than before because this is the only
     // way we can "find" traps that aren't marked as visible.
     // Detection formula takes care of likelihood of seeing within this range.
-    for( const tripoint_bub_ms &tp : here.points_in_radius( pos_bub(), 5 ) ) {
+    for( const tripoint_bub_ms &tp : here.trap_tiles_near( pos_bub(), 5 ) ) {
         const trap &tr = here.tr_at( tp );
         if( tr.is_null() || tp == pos_bub() ) {
             continue;
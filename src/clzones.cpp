@@ -7,6 +7,7 @@
 #include <iterator>
 #include <string>
 #include <tuple>
+#include <utility>
 
 #include "activity_actor_definitions.h"
 #include "avatar.h"
@@ -121,7 +122,10 @@ void zone_manager::clear()
     removed_vzones.clear();
     // Do not clear types since it is needed for the next games.
     area_cache.clear();
+    area_boxes.clear();
     vzone_cache.clear();
+    invalidate_zone_buckets();
+    ++zone_version;
 }
 
 std::string zone_type::name() const
@@ -808,7 +812,7 @@ void zone_data::set_position( const std::pair<tripoint_abs_ms, tripoint_abs_ms>
     }
 
     if( !skip_cache_update ) {
-        zone_manager::get_manager().cache_data( update_avatar );
+        zone_manager::get_manager().zone_moved( *this, update_avatar );
     }
 }
 
@@ -839,7 +843,7 @@ void zone_data::set_position( const std::pair<tripoint_rel_ms, tripoint_rel_ms>
     }
 
     if( !skip_cache_update ) {
-        zone_manager::get_manager().cache_data( update_avatar );
+        zone_manager::get_manager().zone_moved( *this, update_avatar );
     }
 }
 
@@ -1010,7 +1014,14 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
 
 void zone_manager::cache_data( bool update_avatar )
 {
+    invalidate_zone_buckets();
+    if( batch_depth > 0 ) {
+        batch_cache_pending = true;
+        batch_update_avatar = batch_update_avatar || update_avatar;
+        return;
+    }
     area_cache.clear();
+    area_boxes.clear();
     avatar &player_character = get_avatar();
     tripoint_abs_ms cached_shift = player_character.pos_abs();
     for( zone_data &elem : zones ) {
@@ -1024,15 +1035,106 @@ void zone_manager::cache_data( bool update_avatar )
             elem.update_cached_shift( cached_shift );
         }
 
-        const std::string &type_hash = elem.get_type_hash();
-        auto &cache = area_cache[type_hash];
+        cache_zone( elem );
+    }
+}
 
-        // Draw marked area
-        for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
-                 elem.get_start_point(), elem.get_end_point() ) ) {
-            cache.insert( p );
+void zone_manager::cache_zone( const zone_data &zone )
+{
+    const std::string &type_hash = zone.get_type_hash();
+    auto &cache = area_cache[type_hash];
+
+    // Draw marked area
+    const tripoint_range<tripoint_abs_ms> area( zone.get_start_point(), zone.get_end_point() );
+    for( const tripoint_abs_ms &p : area ) {
+        cache.insert( p );
+    }
+    if( !area.empty() ) {
+        area_boxes[type_hash].emplace_back( zone.get_start_point(), zone.get_end_point() );
+    }
+}
+
+void zone_manager::recache_type( const std::string &type_hash )
+{
+    invalidate_zone_buckets();
+    if( batch_depth > 0 ) {
+        batch_cache_pending = true;
+        return;
+    }
+    // Zones of one type may overlap, so the tiles of the others have to be put back.
+    area_cache.erase( type_hash );
+    area_boxes.erase( type_hash );
+    for( const zone_data &elem : zones ) {
+        if( elem.get_enabled() && elem.get_type_hash() == type_hash ) {
+            cache_zone( elem );
+        }
+    }
+}
+
+void zone_manager::zone_moved( const zone_data &zone, bool update_avatar )
+{
+    if( zone.get_is_personal() ) {
+        cache_data( update_avatar );
+        return;
+    }
+    recache_type( zone.get_type_hash() );
+}
+
+zone_manager::batch_edit::batch_edit( zone_manager &mgr ) : mgr( mgr )
+{
+    ++mgr.batch_depth;
+}
+
+zone_manager::batch_edit::~batch_edit()
+{
+    if( --mgr.batch_depth > 0 ) {
+        return;
+    }
+    if( mgr.batch_cache_pending ) {
+        mgr.batch_cache_pending = false;
+        mgr.cache_data( std::exchange( mgr.batch_update_avatar, false ) );
+    }
+    if( mgr.batch_vzones_pending ) {
+        mgr.batch_vzones_pending = false;
+        mgr.cache_vzones( std::exchange( mgr.batch_vzones_map, nullptr ) );
+    }
+}
+
+void zone_manager::invalidate_zone_buckets()
+{
+    zone_buckets_valid = false;
+    ++zone_version;
+}
+
+std::vector<int> zone_manager::zone_indices_near( const tripoint_abs_ms &where ) const
+{
+    if( !zone_buckets_valid ) {
+        zone_buckets.clear();
+        personal_zone_indices.clear();
+        for( int i = 0; i < static_cast<int>( zones.size() ); ++i ) {
+            const zone_data &zone = zones[i];
+            if( zone.get_is_personal() ) {
+                personal_zone_indices.push_back( i );
+                continue;
+            }
+            for( const tripoint_abs_sm &sm : tripoint_range<tripoint_abs_sm>(
+                     project_to<coords::sm>( zone.get_start_point() ),
+                     project_to<coords::sm>( zone.get_end_point() ) ) ) {
+                zone_buckets[sm].push_back( i );
+            }
         }
+        zone_buckets_valid = true;
+    }
+
+    const auto bucket = zone_buckets.find( project_to<coords::sm>( where ) );
+    if( bucket == zone_buckets.end() ) {
+        return personal_zone_indices;
     }
+    std::vector<int> ret;
+    ret.reserve( bucket->second.size() + personal_zone_indices.size() );
+    std::merge( bucket->second.begin(), bucket->second.end(), personal_zone_indices.begin(),
+                personal_zone_indices.end(), std::back_inserter( ret ) );
+    return ret;
 }
 
 void zone_manager::reset_disabled()
@@ -1065,7 +1167,13 @@ void zone_manager::cache_avatar_location()
 
 void zone_manager::cache_vzones( map *pmap )
 {
+    if( batch_depth > 0 ) {
+        batch_vzones_pending = true;
+        batch_vzones_map = pmap;
+        return;
+    }
     vzone_cache.clear();
+    ++zone_version;
     map &here = pmap == nullptr ? get_map() : *pmap;
     auto vzones = here.get_vehicle_zones( here.get_abs_sub().z() );
     for( zone_data *elem : vzones ) {
@@ -1180,10 +1288,12 @@ bool zone_manager::has( const zone_type_id &type, const tripoint_abs_ms &where,
 bool zone_manager::has_near( const zone_type_id &type, const tripoint_abs_ms &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
-            return true;
+    const auto &boxes = area_boxes.find( zone_data::make_type_hash( type, fac ) );
+    if( boxes != area_boxes.end() ) {
+        for( const inclusive_cuboid<tripoint_abs_ms> &box : boxes->second ) {
+            if( square_dist( clamp( where, box ), where ) <= range ) {
+                return true;
+            }
         }
     }
 
@@ -1255,7 +1365,8 @@ std::vector<zone_data const *> zone_manager::get_zones_at( const tripoint_abs_ms
         const zone_type_id &type, const faction_id &fac ) const
 {
     std::vector<zone_data const *> ret;
-    for( const zone_data &zone : zones ) {
+    for( const int i : zone_indices_near( where ) ) {
+        const zone_data &zone = zones[i];
         if( zone.has_inside( where ) && zone.get_type() == type && zone.get_faction() == fac ) {
             ret.emplace_back( &zone );
         }
@@ -1291,7 +1402,7 @@ bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it
         std::string const filter_string = options.get_mark();
         bool has = false;
         if( ztype == zone_type_LOOT_CUSTOM ) {
-            auto const z = item_filter_from_string( filter_string );
+            const std::function<bool( const item & )> &z = loot_filter( filter_string );
             has = z( *check_it ) || ( check_it != it && z( *it ) );
         } else if( ztype == zone_type_LOOT_ITEM_GROUP ) {
             has = item_group::group_contains_item( item_group_id( filter_string ),
@@ -1347,14 +1458,18 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
 
     tripoint_abs_ms nearest_pos( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint_abs_ms> &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+    const auto &boxes = area_boxes.find( zone_data::make_type_hash( type, fac ) );
+    if( boxes != area_boxes.end() ) {
+        for( const inclusive_cuboid<tripoint_abs_ms> &box : boxes->second ) {
+            // The closest tile of a zone is where clamped to its area.
+            const tripoint_abs_ms p = clamp( where, box );
+            int cur_dist = square_dist( p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
+                if( nearest_dist == 0 ) {
+                    return nearest_pos;
+                }
             }
         }
     }
@@ -1376,8 +1491,60 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
     return nearest_pos;
 }
 
+const std::function<bool( const item & )> &zone_manager::loot_filter(
+    const std::string &filter ) const
+{
+    auto found = loot_filters.find( filter );
+    if( found == loot_filters.end() ) {
+        found = loot_filters.emplace( filter, item_filter_from_string( filter ) ).first;
+    }
+    return found->second;
+}
+
+// Key of an item whose destination only depends on its type, damage and charges, or "" if
+// a filter could tell it apart from others like it: it has contents, flags or a note, is a
+// corpse, or its name shows its freshness or temperature.
+static std::string loot_destination_key( const item &it, const tripoint_abs_ms &where,
+        int range, const faction_id &fac )
+{
+    // Filters match on the item name, which reads item variables such as notes or snippets.
+    if( !it.empty() || it.is_corpse() || !it.get_flags().empty() || it.has_vars() ||
+        it.goes_bad() || it.has_temperature() ) {
+        return std::string();
+    }
+    std::string key = string_format( "%s|%s|%d|%d|%d|%d|%d|%d|%s", it.typeId().str(),
+                                     it.has_itype_variant( false ) ? it.itype_variant().id : std::string(),
+                                     it.damage_level(), it.charges, where.x(), where.y(), where.z(), range, fac.str() );
+    for( const fault_id &fault : it.get_faults() ) {
+        key += '|';
+        key += fault.str();
+    }
+    return key;
+}
+
 zone_type_id zone_manager::get_near_zone_type_for_item( const item &it,
         const tripoint_abs_ms &where, int range, const faction_id &fac ) const
+{
+    const std::string key = loot_destination_key( it, where, range, fac );
+    if( key.empty() ) {
+        return find_near_zone_type_for_item( it, where, range, fac );
+    }
+    if( loot_destinations_version != zone_version || loot_destinations_turn != calendar::turn ) {
+        loot_destinations.clear();
+        loot_destinations_version = zone_version;
+        loot_destinations_turn = calendar::turn;
+    }
+    const auto found = loot_destinations.find( key );
+    if( found != loot_destinations.end() ) {
+        return found->second;
+    }
+    const zone_type_id dest = find_near_zone_type_for_item( it, where, range, fac );
+    loot_destinations.emplace( key, dest );
+    return dest;
+}
+
+zone_type_id zone_manager::find_near_zone_type_for_item( const item &it,
+        const tripoint_abs_ms &where, int range, const faction_id &fac ) const
 {
     const item_category &cat = it.get_category_of_contents();
 
@@ -1502,9 +1669,10 @@ const zone_data *zone_manager::get_zone_at( const tripoint_abs_ms &where, bool l
                ( !loot_only || z.get_type().str().substr( 0, 4 ) == "LOOT" ) &&
                z.has_inside( where );
     };
-    for( auto it = zones.rbegin(); it != zones.rend(); ++it ) {
-        if( check( *it ) ) {
-            return &*it;
+    const std::vector<int> candidates = zone_indices_near( where );
+    for( auto it = candidates.rbegin(); it != candidates.rend(); ++it ) {
+        if( check( zones[*it] ) ) {
+            return &zones[*it];
         }
     }
     auto const vzones = here.get_vehicle_zones( here.get_abs_sub().z() );
@@ -1519,8 +1687,9 @@ const zone_data *zone_manager::get_zone_at( const tripoint_abs_ms &where, bool l
 const zone_data *zone_manager::get_bottom_zone(
     const tripoint_abs_ms &where, const faction_id &fac ) const
 {
-    for( auto it = zones.rbegin(); it != zones.rend(); ++it ) {
-        const zone_data &zone = *it;
+    const std::vector<int> candidates = zone_indices_near( where );
+    for( auto it = candidates.rbegin(); it != candidates.rend(); ++it ) {
+        const zone_data &zone = zones[*it];
         if( zone.get_faction() != fac ) {
             continue;
         }
@@ -1588,8 +1757,12 @@ void zone_manager::add( const std::string &name, const zone_type_id &type, const
 
     //Create a regular zone
     zones.push_back( new_zone );
-
-    cache_data();
+    invalidate_zone_buckets();
+    if( batch_depth > 0 ) {
+        batch_cache_pending = true;
+    } else if( zones.back().get_enabled() ) {
+        cache_zone( zones.back() );
+    }
 }
 
 void zone_manager::add( const std::string &name, const zone_type_id &type, const faction_id &fac,
@@ -1615,7 +1788,9 @@ bool zone_manager::remove( zone_data &zone )
             if( it->get_is_personal() ) {
                 num_personal_zones--;
             }
+            const std::string type_hash = it->get_type_hash();
             zones.erase( it );
+            recache_type( type_hash );
             return true;
         }
     }
@@ -1660,6 +1835,7 @@ void zone_manager::swap( zone_data &a, zone_data &b )
         return;
     }
     std::swap( a, b );
+    invalidate_zone_buckets();
 }
 
 namespace
@@ -1700,6 +1876,7 @@ void zone_manager::rotate_zones( map &target_map, const int turns )
         return;
     }
 
+    batch_edit batch( *this );
     for( zone_data &zone : zones ) {
         if( !zone.get_is_personal() && target_map.inbounds_z( zone.get_center_point().z() ) ) {
             _rotate_zone( target_map, zone, turns );
@@ -1790,6 +1967,7 @@ void zone_manager::deserialize( const JsonValue &jv )
             ++it;
         }
     }
+    invalidate_zone_buckets();
 }
 
 void zone_data::serialize( JsonOut &json ) const
@@ -1969,6 +2147,7 @@ void zone_manager::load_world_zones( std::string const &suffix )
 
 void zone_manager::zone_edited( zone_data &zone )
 {
+    ++zone_version;
     if( zone.get_is_vehicle() ) {
         //Check if this zone has already been stored
         for( auto &changed_vzone : changed_vzones ) {
@@ -2490,6 +2669,7 @@ basecamp_smart_zone_result auto_place_basecamp_smart_zones(
                                 _( "Basecamp quilts" ), "quilt" );
     }
 
+    zone_manager::batch_edit batch( mgr );
     for( const smart_zone_plan_entry &entry : ctx.planned ) {
         mapgen_place_zone( entry.start, entry.end, entry.type, ctx.fac,
                            entry.name, entry.filter, &ctx.here );
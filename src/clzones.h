@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "coordinates.h"
 #include "cuboid_rectangle.h"
 #include "game.h"
@@ -608,11 +609,49 @@ class zone_manager
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> area_cache;
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> vzone_cache;
+        // Areas of the enabled zones of each type hash, as cached by cache_data
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<std::string, std::vector<inclusive_cuboid<tripoint_abs_ms>>> area_boxes;
+        // Indices into zones of every zone covering each submap, in zones order. Personal zones
+        // move with the avatar and are kept in their own list. Rebuilt when first needed after
+        // the zones change.
+        // NOLINTNEXTLINE(cata-serialize)
+        mutable std::unordered_map<tripoint_abs_sm, std::vector<int>> zone_buckets;
+        mutable std::vector<int> personal_zone_indices; // NOLINT(cata-serialize)
+        mutable bool zone_buckets_valid = false; // NOLINT(cata-serialize)
+        void invalidate_zone_buckets();
+        // Open batch_edit scopes, and the cache updates they are holding back
+        int batch_depth = 0; // NOLINT(cata-serialize)
+        bool batch_cache_pending = false; // NOLINT(cata-serialize)
+        bool batch_update_avatar = false; // NOLINT(cata-serialize)
+        bool batch_vzones_pending = false; // NOLINT(cata-serialize)
+        map *batch_vzones_map = nullptr; // NOLINT(cata-serialize)
+        // Adds the tiles of one enabled zone to area_cache and area_boxes
+        void cache_zone( const zone_data &zone );
+        // Rebuilds area_cache and area_boxes for a single type hash
+        void recache_type( const std::string &type_hash );
+        // Bumped by every change to the zones, their caches or the vehicle zones
+        int zone_version = 0; // NOLINT(cata-serialize)
+        // LOOT_CUSTOM filter strings compiled to matchers
+        // NOLINTNEXTLINE(cata-serialize)
+        mutable std::unordered_map<std::string, std::function<bool( const item & )>> loot_filters;
+        // Destinations picked by get_near_zone_type_for_item for plain items this turn, see
+        // loot_destination_key. Filters may look at the avatar, so this never outlives a turn.
+        // NOLINTNEXTLINE(cata-serialize)
+        mutable std::unordered_map<std::string, zone_type_id> loot_destinations;
+        mutable int loot_destinations_version = -1; // NOLINT(cata-serialize)
+        mutable time_point loot_destinations_turn = calendar::before_time_starts; // NOLINT(cata-serialize)
+        const std::function<bool( const item & )> &loot_filter( const std::string &filter ) const;
+        zone_type_id find_near_zone_type_for_item( const item &it, const tripoint_abs_ms &where,
+                int range, const faction_id &fac ) const;
+        // Indices of the zones that may contain where, in zones order
+        std::vector<int> zone_indices_near( const tripoint_abs_ms &where ) const;
+    public:
+        // The points of the terrain zones of this type, and those of its vehicle zones
         std::unordered_set<tripoint_abs_ms> get_point_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
         std::unordered_set<tripoint_abs_ms> get_vzone_set( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-    public:
         zone_manager();
         ~zone_manager() = default;
         zone_manager( zone_manager && ) = default;
@@ -625,8 +664,29 @@ class zone_manager
             return manager;
         }
 
+        /**
+         * Coalesces the cache updates of a run of zone edits. cache_data and cache_vzones calls
+         * made while a batch is open run once when the outermost batch closes. The point caches
+         * are stale until then, lookups of the zones at a point already see the edits.
+         */
+        class batch_edit
+        {
+            public:
+                explicit batch_edit( zone_manager &mgr );
+                ~batch_edit();
+                batch_edit( const batch_edit & ) = delete;
+                batch_edit &operator=( const batch_edit & ) = delete;
+            private:
+                zone_manager &mgr;
+        };
+
         void clear();
 
+        // Goes up whenever a zone, its options or the caches of zone points change
+        int get_zone_version() const {
+            return zone_version;
+        }
+
         // For addition of regular and vehicle zones
         void add( const std::string &name, const zone_type_id &type, const faction_id &faction,
                   bool invert, bool enabled,
@@ -664,6 +724,8 @@ class zone_manager
         void reset_disabled();
         void cache_avatar_location();
         void cache_vzones( map *pmap = nullptr );
+        // Updates the caches after a zone has been moved, only its type is recached
+        void zone_moved( const zone_data &zone, bool update_avatar );
         bool has( const zone_type_id &type, const tripoint_abs_ms &where,
                   const faction_id &fac = your_fac ) const;
         bool has_terrain( const zone_type_id &type, const tripoint_abs_ms &where,
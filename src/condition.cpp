@@ -247,6 +247,7 @@ void var_info::deserialize( JsonValue const &jsin )
 
 void var_info::_deserialize( JsonObject const &jo )
 {
+    cached_generation = 0;
     if( jo.has_member( "u_val" ) ) {
         type = var_type::u;
         name = get_talk_varname( jo, "u_val" );
@@ -2656,34 +2657,20 @@ conditional_t::conditional_t( const JsonObject &jo )
         return conditionals;
     };
     if( jo.has_array( "and" ) ) {
-        std::vector<conditional_t> and_conditionals = parse_array( jo, "and" );
         found_sub_member = true;
-        condition = [acs = std::move( and_conditionals )]( const_dialogue const & d ) {
-            return std::all_of( acs.begin(), acs.end(), [&d]( conditional_t const & cond ) {
-                return cond( d );
-            } );
-        };
+        set_children( node_kind::all_of, parse_array( jo, "and" ) );
     } else if( jo.has_array( "or" ) ) {
-        std::vector<conditional_t> or_conditionals = parse_array( jo, "or" );
         found_sub_member = true;
-        condition = [ocs = std::move( or_conditionals )]( const_dialogue const & d ) {
-            return std::any_of( ocs.begin(), ocs.end(), [&d]( conditional_t const & cond ) {
-                return cond( d );
-            } );
-        };
+        set_children( node_kind::any_of, parse_array( jo, "or" ) );
     } else if( jo.has_object( "not" ) ) {
         JsonObject cond = jo.get_object( "not" );
-        const conditional_t sub_condition = conditional_t( cond );
+        *this = conditional_t( cond );
+        negate();
         found_sub_member = true;
-        condition = [sub_condition]( const_dialogue const & d ) {
-            return !sub_condition( d );
-        };
     } else if( jo.has_string( "not" ) ) {
-        const conditional_t sub_condition = conditional_t( jo.get_string( "not" ) );
+        *this = conditional_t( jo.get_string( "not" ) );
+        negate();
         found_sub_member = true;
-        condition = [sub_condition]( const_dialogue const & d ) {
-            return !sub_condition( d );
-        };
     }
     if( !found_sub_member ) {
         for( const std::string &sub_member : dialogue_data::complex_conds() ) {
@@ -2697,14 +2684,14 @@ conditional_t::conditional_t( const JsonObject &jo )
     for( const condition_parser &p : parsers ) {
         if( p.has_beta ) {
             if( p.check( jo ) ) {
-                condition = p.f_beta( jo, p.key_alpha, false );
+                set_leaf( p.f_beta( jo, p.key_alpha, false ) );
                 found = true;
             } else if( p.check( jo, true ) ) {
-                condition = p.f_beta( jo, p.key_beta, true );
+                set_leaf( p.f_beta( jo, p.key_beta, true ) );
                 found = true;
             }
         } else if( p.check( jo ) ) {
-            condition = p.f( jo, p.key_alpha );
+            set_leaf( p.f( jo, p.key_alpha ) );
             if( jo.has_member( "math" ) ) {
                 found_sub_member = true;
             }
@@ -2717,10 +2704,7 @@ conditional_t::conditional_t( const JsonObject &jo )
     if( !found ) {
         for( const std::string &sub_member : dialogue_data::simple_string_conds() ) {
             if( jo.has_string( sub_member ) ) {
-                const conditional_t sub_condition( jo.get_string( sub_member ) );
-                condition = [sub_condition]( const_dialogue const & d ) {
-                    return sub_condition( d );
-                };
+                *this = conditional_t( jo.get_string( sub_member ) );
                 found_sub_member = true;
                 break;
             }
@@ -2731,6 +2715,44 @@ conditional_t::conditional_t( const JsonObject &jo )
     }
 }
 
+void conditional_t::set_children( node_kind list_kind, std::vector<conditional_t> &&conds )
+{
+    // A lone child is the whole condition, whichever list it was in.
+    if( conds.size() == 1 ) {
+        conditional_t only = std::move( conds.front() );
+        *this = std::move( only );
+        return;
+    }
+    kind = list_kind;
+    negated = false;
+    condition = nullptr;
+    children.clear();
+    children.reserve( conds.size() );
+    for( conditional_t &cond : conds ) {
+        // "and" inside "and" (or "or" inside "or") checks the same thing as one flat list.
+        if( cond.kind == list_kind && !cond.negated ) {
+            for( conditional_t &grandchild : cond.children ) {
+                children.emplace_back( std::move( grandchild ) );
+            }
+        } else {
+            children.emplace_back( std::move( cond ) );
+        }
+    }
+}
+
+void conditional_t::set_leaf( func &&f )
+{
+    kind = node_kind::leaf;
+    negated = false;
+    condition = std::move( f );
+    children.clear();
+}
+
+void conditional_t::negate()
+{
+    negated = !negated;
+}
+
 conditional_t::conditional_t( std::string_view type )
 {
     bool found = false;
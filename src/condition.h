@@ -6,6 +6,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_set>
+#include <vector>
 
 #include "calendar.h"
 #include "coords_fwd.h"
@@ -74,6 +75,9 @@ void finalize_conditions();
  * into a lambda, stored in the std::function object.
  * Invoking the function operator with a dialog reference (so the function can access the NPC)
  * returns whether the response is allowed.
+ * "and" and "or" are not closures but lists of children walked directly, with nested lists
+ * of the same kind flattened into their parent and "not" folded into a flag, so deep
+ * condition trees cost one call per leaf rather than a chain of nested std::functions.
  */
 struct conditional_t {
     public:
@@ -86,14 +90,45 @@ struct conditional_t {
         static double get_legacy_dbl( const_dialogue const &d, std::string_view checked_value, char scope );
         static void set_legacy_dbl( dialogue &d, double input, std::string_view checked_value, char scope );
         bool operator()( const_dialogue const &d ) const {
+            switch( kind ) {
+                case node_kind::all_of:
+                    for( const conditional_t &child : children ) {
+                        if( !child( d ) ) {
+                            return negated;
+                        }
+                    }
+                    return !negated;
+                case node_kind::any_of:
+                    for( const conditional_t &child : children ) {
+                        if( child( d ) ) {
+                            return !negated;
+                        }
+                    }
+                    return negated;
+                case node_kind::leaf:
+                    break;
+            }
             if( !condition ) {
-                return false;
+                return negated;
             }
-            return condition( d );
+            return condition( d ) != negated;
         }
 
     private:
+        enum class node_kind : int {
+            leaf,
+            all_of,
+            any_of
+        };
+
+        void set_leaf( func &&f );
+        void set_children( node_kind list_kind, std::vector<conditional_t> &&conds );
+        void negate();
+
+        node_kind kind = node_kind::leaf;
+        bool negated = false;
         func condition;
+        std::vector<conditional_t> children;
 };
 
 #endif // CATA_SRC_CONDITION_H
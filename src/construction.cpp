@@ -163,6 +163,7 @@ static const vproto_id vehicle_prototype_none( "none" );
 static const std::string flag_WIRING( "WIRING" );
 
 static bool finalized = false;
+static int finalized_version = 0;
 
 // Construction functions.
 namespace construct
@@ -245,22 +246,19 @@ static bool player_can_see_to_build( Character &you, const construction_group_st
 static const deferred_color color_title = def_c_light_red; //color for titles
 static const deferred_color color_data = def_c_cyan; //color for data parts
 
-static bool has_pre_terrain( const construction &con, const tripoint_bub_ms &p )
+static bool has_pre_terrain( const construction &con, furn_id const &f, ter_id const &t )
 {
     if( con.pre_terrain.empty() ) {
         return true;
     }
 
-    map &here = get_map();
     if( con.pre_is_furniture ) {
-        furn_id f = here.furn( p );
         for( const auto &pre_terrain : con.pre_terrain ) {
             if( f == furn_id( pre_terrain ) ) {
                 return true;
             }
         }
     } else {
-        ter_id t = here.ter( p );
         for( const auto &pre_terrain : con.pre_terrain ) {
             if( t == ter_id( pre_terrain ) ) {
                 return true;
@@ -270,6 +268,12 @@ static bool has_pre_terrain( const construction &con, const tripoint_bub_ms &p )
     return false;
 }
 
+static bool has_pre_terrain( const construction &con, const tripoint_bub_ms &p )
+{
+    const map &here = get_map();
+    return has_pre_terrain( con, here.furn( p ), here.ter( p ) );
+}
+
 static bool has_pre_terrain( const construction &con )
 {
     if( con.pre_terrain.empty() ) {
@@ -1293,7 +1297,12 @@ bool can_construct( const construction &con, const tripoint_bub_ms &p )
     } else if( !con.pre_special( p ) ) { // pre-function
         return false;
     }
-    if( !has_pre_terrain( con, p ) || // terrain type
+    return can_construct_on( con, f, t );
+}
+
+bool can_construct_on( const construction &con, furn_id const &f, ter_id const &t )
+{
+    if( !has_pre_terrain( con, f, t ) || // terrain type
         !has_pre_flags( con, f, t ) ) { // flags
         return false;
     }
@@ -2673,6 +2682,12 @@ void finalize_constructions()
     }
 
     finalized = true;
+    ++finalized_version;
+}
+
+int constructions_version()
+{
+    return finalized_version;
 }
 
 // Using BFS to find the shortest route to create target terrain from empty or base terrain,
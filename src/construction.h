@@ -125,6 +125,8 @@ void reset_constructions();
 construction_id construction_menu( bool blueprint );
 bool has_pre_flags( const construction &con, furn_id const &f, ter_id const &t );
 bool can_construct( const construction &con, const tripoint_bub_ms &p );
+/** The part of can_construct that only looks at the furniture @p f and terrain @p t of the tile. */
+bool can_construct_on( const construction &con, furn_id const &f, ter_id const &t );
 bool player_can_build( Character &you, const read_only_visitable &inv, const construction &con,
                        bool can_construct_skip = false );
 std::vector<construction *> constructions_by_group( const construction_group_str_id &group );
@@ -132,6 +134,8 @@ std::vector<construction *> constructions_by_filter( std::function<bool( constru
         const &filter );
 void check_constructions();
 void finalize_constructions();
+/** Goes up every time the constructions are finalized, for caches built from them. */
+int constructions_version();
 std::vector<construction_id> find_build_sequence( const std::string &target_id,
         std::function<bool( construction const & )> const &filter,
         std::function<bool( construction const & )> const &can_build );
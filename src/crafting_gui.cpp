@@ -235,18 +235,30 @@ struct availability {
             std::string reason;
             craft_flags flag = camp_crafting ? craft_flags::none : craft_flags::start_only;
 
+            // whether the requirements can be met with every item allowed, if that was checked
+            std::optional<bool> has_components;
             if( crafter.is_npc() && !r->npc_can_craft( reason ) && !camp_crafting ) {
                 can_craft = false;
             } else if( r->is_nested() ) {
                 can_craft = check_can_craft_nested( _crafter, *r );
             } else {
-                can_craft = ( !r->is_practice() || has_all_skills ) && has_proficiencies &&
-                            req.can_make_with_inventory( inv, all_items_filter, batch_size, flag );
+                can_craft = ( !r->is_practice() || has_all_skills ) && has_proficiencies;
+                if( can_craft ) {
+                    has_components = req.can_make_with_inventory( inv, all_items_filter, batch_size, flag );
+                    can_craft = *has_components;
+                }
+            }
+            if( has_components && !*has_components ) {
+                // The filters below only take items away, so they can't succeed either.
+                // Most known recipes end up here, this saves two requirement checks for each.
+                would_use_rotten = true;
+                would_use_favorite = true;
+            } else {
+                would_use_rotten = !req.can_make_with_inventory( inv, no_rotten_filter, batch_size,
+                                   flag );
+                would_use_favorite = !req.can_make_with_inventory( inv, no_favorite_filter, batch_size,
+                                     flag );
             }
-            would_use_rotten = !req.can_make_with_inventory( inv, no_rotten_filter, batch_size,
-                               flag );
-            would_use_favorite = !req.can_make_with_inventory( inv, no_favorite_filter, batch_size,
-                                 flag );
             useless_practice = r->is_practice() && cannot_gain_skill_or_prof( crafter, *r );
             is_nested_category = r->is_nested();
             const requirement_data &simple_req = r->simple_requirements();
@@ -88,6 +88,7 @@ extern "C" {
 #endif
         log_text << "\nSTACK TRACE:\n";
         debug_write_backtrace( log_text );
+        flushDebugLog();
         std::cerr << log_text.str();
         FILE *file = fopen( crash_log_file.c_str(), "w" );
         if( file ) {
@@ -2105,12 +2105,13 @@ void Creature::process_effects()
     std::vector<efftype_id> rem_ids;
     std::vector<bodypart_id> rem_bps;
 
+    // Looked up once, for a character it goes through traits, bionics and gear.
+    const bool frozen = has_flag( json_flag_FREEZE_EFFECTS );
     // Decay/removal of effects
     for( auto &elem : *effects ) {
         for( auto &_it : elem.second ) {
             // Do not freeze the effect with the FREEZE_EFFECTS flag.
-            if( has_flag( json_flag_FREEZE_EFFECTS ) &&
-                !_it.second.has_flag( json_flag_FREEZE_EFFECTS ) ) {
+            if( frozen && !_it.second.has_flag( json_flag_FREEZE_EFFECTS ) ) {
                 continue;
             }
             // Add any effects that others remove to the removal list
@@ -93,7 +93,7 @@ bool creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos_abs()] = critter_ptr;
+    set_location( critter.pos_abs(), critter_ptr, next_order++ );
     return true;
 }
 
@@ -130,8 +130,12 @@ bool creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( old_pos );
-        monsters_by_location[new_pos] = *iter;
+        uint64_t order = next_order++;
+        if( const auto old_iter = monsters_by_location.find( old_pos );
+            old_iter != monsters_by_location.end() ) {
+            order = erase_location( old_iter );
+        }
+        set_location( new_pos, *iter, order );
         return true;
     } else {
         // We're changing the x/y/z coordinates of a zombie that hasn't been added
@@ -148,7 +152,7 @@ void creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos_abs() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( pos_iter );
         return;
     }
 
@@ -159,8 +163,95 @@ void creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( iter );
+    }
+}
+
+void creature_tracker::set_location( const tripoint_abs_ms &pos,
+                                     const shared_ptr_fast<monster> &critter, uint64_t order )
+{
+    if( const auto iter = monsters_by_location.find( pos ); iter != monsters_by_location.end() ) {
+        erase_location( iter );
+    }
+    monsters_by_location.emplace( pos, critter );
+    monsters_by_submap[project_to<coords::sm>( pos )].push_back( { critter.get(), pos, order } );
+}
+
+uint64_t creature_tracker::erase_location(
+    std::unordered_map<tripoint_abs_ms, shared_ptr_fast<monster>>::iterator iter )
+{
+    uint64_t order = next_order++;
+    const auto bucket = monsters_by_submap.find( project_to<coords::sm>( iter->first ) );
+    if( bucket != monsters_by_submap.end() ) {
+        std::vector<located_monster> &located = bucket->second;
+        for( size_t i = 0; i < located.size(); ++i ) {
+            if( located[i].pos == iter->first ) {
+                order = located[i].order;
+                located[i] = located.back();
+                located.pop_back();
+                break;
+            }
+        }
+        if( located.empty() ) {
+            monsters_by_submap.erase( bucket );
+        }
     }
+    monsters_by_location.erase( iter );
+    return order;
+}
+
+std::vector<Creature *> creature_tracker::creatures_in_box( const tripoint_abs_ms &min,
+        const tripoint_abs_ms &max ) const
+{
+    const auto inside = [&min, &max]( const tripoint_abs_ms & p ) {
+        return p.x() >= min.x() && p.y() >= min.y() && p.z() >= min.z() &&
+               p.x() <= max.x() && p.y() <= max.y() && p.z() <= max.z();
+    };
+    std::vector<const located_monster *> located;
+    const tripoint_abs_sm sm_min = project_to<coords::sm>( min );
+    const tripoint_abs_sm sm_max = project_to<coords::sm>( max );
+    for( int z = sm_min.z(); z <= sm_max.z(); ++z ) {
+        for( int y = sm_min.y(); y <= sm_max.y(); ++y ) {
+            for( int x = sm_min.x(); x <= sm_max.x(); ++x ) {
+                const auto bucket = monsters_by_submap.find( tripoint_abs_sm( x, y, z ) );
+                if( bucket == monsters_by_submap.end() ) {
+                    continue;
+                }
+                for( const located_monster &entry : bucket->second ) {
+                    if( inside( entry.pos ) && !entry.critter->is_dead() ) {
+                        located.push_back( &entry );
+                    }
+                }
+            }
+        }
+    }
+    std::sort( located.begin(), located.end(), []( const located_monster * a,
+    const located_monster * b ) {
+        return a->order < b->order;
+    } );
+
+    std::vector<Creature *> found;
+    found.reserve( located.size() );
+    for( const located_monster *entry : located ) {
+        found.push_back( entry->critter );
+    }
+    for( const shared_ptr_fast<npc> &guy : active_npc ) {
+        if( !guy->is_dead() && inside( guy->pos_abs() ) ) {
+            found.push_back( guy.get() );
+        }
+    }
+    avatar &you = get_avatar();
+    if( inside( you.pos_abs() ) ) {
+        found.push_back( &you );
+    }
+    return found;
+}
+
+std::vector<Creature *> creature_tracker::creatures_in_radius( const tripoint_abs_ms &center,
+        int radius, int radiusz ) const
+{
+    const tripoint offset( radius, radius, radiusz );
+    return creatures_in_box( center - offset, center + offset );
 }
 
 void creature_tracker::remove( const monster &critter )
@@ -183,6 +274,8 @@ void creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    next_order = 0;
     removed_this_turn_.clear();
     creatures_by_zone_and_faction_.clear();
     invalidate_reachability_cache();
@@ -191,8 +284,10 @@ void creature_tracker::clear()
 void creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    next_order = 0;
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos_abs()] = mon_ptr;
+        set_location( mon_ptr->pos_abs(), mon_ptr, next_order++ );
     }
 }
 
@@ -233,15 +328,17 @@ void creature_tracker::swap_positions( monster &first, monster &second )
     // implied: first_iter != second_iter
 
     shared_ptr_fast<monster> first_ptr;
+    uint64_t first_order = 0;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
+        first_order = erase_location( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
+    uint64_t second_order = 0;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+        second_order = erase_location( second_iter );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -251,10 +348,10 @@ void creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos_abs()] = first_ptr;
+        set_location( first.pos_abs(), first_ptr, first_order );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos_abs()] = second_ptr;
+        set_location( second.pos_abs(), second_ptr, second_order );
     }
 }
 
@@ -3,6 +3,7 @@
 #define CATA_SRC_CREATURE_TRACKER_H
 
 #include <cstddef>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <unordered_map>
@@ -123,6 +124,19 @@ class creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Returns every live creature standing in the box from @p min to @p max, corners
+         * included: monsters in the order of @ref get_monsters_list, then active NPCs,
+         * then the avatar. Hallucinations are included. Monsters are found through their
+         * submap buckets, so the cost follows the creatures near the box rather than
+         * all of them.
+         */
+        std::vector<Creature *> creatures_in_box( const tripoint_abs_ms &min,
+                const tripoint_abs_ms &max ) const;
+        /** As above, for the box reaching @p radius tiles out from @p center and @p radiusz levels up and down. */
+        std::vector<Creature *> creatures_in_radius( const tripoint_abs_ms &center, int radius,
+                int radiusz = 0 ) const;
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( const JsonArray &ja );
 
@@ -136,6 +150,12 @@ class creature_tracker
     private:
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** Puts @p critter in @ref monsters_by_location and its submap bucket. */
+        void set_location( const tripoint_abs_ms &pos, const shared_ptr_fast<monster> &critter,
+                           uint64_t order );
+        /** Takes the entry out of @ref monsters_by_location and its bucket, returns its order. */
+        uint64_t erase_location(
+            std::unordered_map<tripoint_abs_ms, shared_ptr_fast<monster>>::iterator iter );
 
         void flood_fill_zone( const Creature &origin );
 
@@ -148,6 +168,16 @@ class creature_tracker
         std::vector<shared_ptr_fast<monster>> monsters_list;
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<tripoint_abs_ms, shared_ptr_fast<monster>> monsters_by_location;
+        struct located_monster {
+            monster *critter;
+            tripoint_abs_ms pos;
+            // Sorts like monsters_list
+            uint64_t order;
+        };
+        // The entries of @ref monsters_by_location grouped by submap
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<tripoint_abs_sm, std::vector<located_monster>> monsters_by_submap;
+        uint64_t next_order = 0;  // NOLINT(cata-serialize)
 
         /**
          * Creatures that get removed via @ref remove are stored here until the end of the turn.
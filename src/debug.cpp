@@ -6,7 +6,9 @@
 // IWYU pragma: no_include <sys/unistd.h>
 #include <clocale>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -16,17 +18,20 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <optional>
 #include <regex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "cached_options.h"
+#include "cata_allocator.h"
 #include "cata_assert.h"
 #include "cata_scope_helpers.h"
 #include "cata_utility.h"
@@ -717,6 +722,120 @@ struct OutputDebugStreamA : public std::ostream {
 };
 #endif
 
+// Log file whose writes are done by a thread of its own. Every insertion into DebugLog's
+// stream is a sync (std::unitbuf), which used to be a write to disk on the logging thread.
+// Now it only appends to a buffer, and the writer thread writes the buffer out in batches.
+// Errors are written before the message returns, in case the game goes down right after.
+class async_log_buf : public std::streambuf
+{
+    public:
+        explicit async_log_buf( const cata_path &filename )
+            : out( filename.generic_u8string(), std::ios::out | std::ios::app ) {
+            writer = std::thread( [this]() {
+                run();
+            } );
+        }
+        async_log_buf( const async_log_buf & ) = delete;
+        async_log_buf &operator=( const async_log_buf & ) = delete;
+        ~async_log_buf() override {
+            {
+                std::lock_guard<std::mutex> lock( pending_mutex );
+                stopping = true;
+            }
+            wake.notify_one();
+            writer.join();
+            write_pending( true );
+        }
+
+        // Applies to the lines the calling thread writes until it next calls this.
+        static void set_urgent( bool value ) {
+            urgent = value;
+        }
+
+        // With wait false, returns false right away if another thread holds a lock.
+        bool write_pending( bool wait ) {
+            std::unique_lock<std::mutex> file_lock( file_mutex, std::defer_lock );
+            std::unique_lock<std::mutex> lock( pending_mutex, std::defer_lock );
+            if( wait ) {
+                file_lock.lock();
+                lock.lock();
+            } else if( !file_lock.try_lock() || !lock.try_lock() ) {
+                return false;
+            }
+            std::string batch;
+            batch.swap( pending );
+            lock.unlock();
+            out.write( batch.data(), static_cast<std::streamsize>( batch.size() ) );
+            out.flush();
+            return true;
+        }
+
+    protected:
+        int overflow( int c ) override {
+            if( c != EOF ) {
+                std::lock_guard<std::mutex> lock( pending_mutex );
+                wake_writer();
+                pending.push_back( static_cast<char>( c ) );
+            }
+            return c;
+        }
+        std::streamsize xsputn( const char *s, std::streamsize n ) override {
+            std::lock_guard<std::mutex> lock( pending_mutex );
+            wake_writer();
+            pending.append( s, static_cast<size_t>( n ) );
+            return n;
+        }
+        int sync() override {
+            if( urgent ) {
+                write_pending( true );
+            }
+            return 0;
+        }
+
+    private:
+        // How long a line may wait in the buffer before it is written.
+        static constexpr std::chrono::milliseconds batch_interval{ 100 };
+
+        // Called with pending_mutex held, before appending.
+        void wake_writer() {
+            if( pending.empty() ) {
+                wake.notify_one();
+            }
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock( pending_mutex );
+            while( !stopping ) {
+                wake.wait( lock, [this]() {
+                    return stopping || !pending.empty();
+                } );
+                // Let more lines come in, so that they are written together.
+                wake.wait_for( lock, batch_interval, [this]() {
+                    return stopping;
+                } );
+                lock.unlock();
+                write_pending( true );
+                lock.lock();
+            }
+        }
+
+        std::ofstream out;
+        // Held while writing to out, taken before pending_mutex.
+        std::mutex file_mutex;
+        std::mutex pending_mutex;
+        std::string pending;
+        std::condition_variable wake;
+        bool stopping = false;
+        // Per thread, so one thread's error doesn't decide when another's lines are written.
+        static inline thread_local bool urgent = false;
+        std::thread writer;
+};
+
+struct async_log_file : public std::ostream {
+    explicit async_log_file( const cata_path &filename ) : std::ostream( &buf ), buf( filename ) {}
+    async_log_buf buf;
+};
+
 struct DebugFile {
     void init( DebugOutput, const cata_path &filename );
     void deinit();
@@ -731,6 +850,8 @@ struct DebugFile {
     // Using shared_ptr for the type-erased deleter support, not because
     // it needs to be shared.
     std::shared_ptr<std::ostream> file = std::make_shared<std::ostringstream>();
+    // Set when file writes through a writer thread.
+    async_log_buf *async = nullptr;
     cata_path filename;
 };
 
@@ -745,6 +866,7 @@ void DebugFile::deinit()
         *file << get_time() << " : Log shutdown.\n";
         *file << "-----------------------------------------\n\n";
     }
+    async = nullptr;
     file.reset();
 }
 
@@ -774,8 +896,9 @@ void DebugFile::init( DebugOutput output_mode, const cata_path &filename )
                 fs::rename( fs::path( filename ), fs::path( oldfile ), ec );
                 rename_failed = bool( ec );
             }
-            file = std::make_shared<std::ofstream>(
-                       filename.generic_u8string(), std::ios::out | std::ios::app );
+            std::shared_ptr<async_log_file> log_file = std::make_shared<async_log_file>( filename );
+            async = &log_file->buf;
+            file = std::move( log_file );
         }
         break;
         default:
@@ -856,6 +979,13 @@ void deinitDebug()
     DebugFile::instance().deinit();
 }
 
+void flushDebugLog()
+{
+    if( async_log_buf *async = DebugFile::instance().async ) {
+        async->write_pending( false );
+    }
+}
+
 // OStream Operators                                                {{{2
 // ---------------------------------------------------------------------
 
@@ -1519,7 +1649,11 @@ std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
     // Error are always logged, they are important,
     // Messages from D_MAIN come from debugmsg and are equally important.
     if( ( lev & debugLevel && cl & debugClass ) || lev & D_ERROR || cl & D_MAIN ) {
-        std::ostream &out = DebugFile::instance().get_file();
+        DebugFile &debug_file = DebugFile::instance();
+        if( debug_file.async ) {
+            async_log_buf::set_urgent( lev & D_ERROR );
+        }
+        std::ostream &out = debug_file.get_file();
 
         output_repetitions( out );
 
@@ -1967,6 +2101,13 @@ std::string game_info::game_report()
            "- Game Language: " << lang_translated << " [" << lang << "]\n" <<
            "- Mods loaded: [\n    " << mods_loaded() << "\n]\n";
 
+    // Steady growth here over a long session points at fragmentation rather than content.
+    const cata::allocator_stats heap = cata::get_allocator_stats();
+    if( heap.available ) {
+        report << "- Heap: " << heap.current_bytes / ( 1024 * 1024 ) << " MiB held, peak " <<
+               heap.peak_bytes / ( 1024 * 1024 ) << " MiB\n";
+    }
+
     return report.str();
 }
 
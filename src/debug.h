@@ -188,6 +188,11 @@ enum class DebugOutput : int {
 void setupDebug( DebugOutput );
 /** Opposite of setupDebug, shuts the debugging system down. */
 void deinitDebug();
+/**
+ * Writes what the log file's writer thread hasn't written yet from the calling thread.
+ * For crash handlers, gives up instead of waiting if another thread is mid-write.
+ */
+void flushDebugLog();
 
 // Function Declarations                                            {{{1
 // ---------------------------------------------------------------------
@@ -78,6 +78,7 @@
 #include "itype.h"
 #include "json.h"
 #include "list.h"
+#include "llm_intent.h"
 #include "localized_comparator.h"
 #include "magic.h"
 #include "map.h"
@@ -89,6 +90,7 @@
 #include "martialarts.h"
 #include "math_parser_diag_value.h"
 #include "memory_fast.h"
+#include "memory_report.h"
 #include "messages.h"
 #include "mission.h"
 #include "mongroup.h"
@@ -107,6 +109,7 @@
 #include "overmapbuffer.h"
 #include "path_info.h"
 #include "pathfinding.h"
+#include "perf.h"
 #include "pimpl.h"
 #include "point.h"
 #include "popup.h"
@@ -123,6 +126,7 @@
 #include "trait_group.h"
 #include "translation.h"
 #include "translations.h"
+#include "turn_replay.h"
 #include "type_id.h"
 #include "uilist.h"
 #include "ui_manager.h"
@@ -293,6 +297,11 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::TALK_TOPIC: return "TALK_TOPIC";
         case debug_menu::debug_menu_index::IMGUI_DEMO: return "IMGUI_DEMO";
         case debug_menu::debug_menu_index::VEHICLE_EFFECTS: return "VEHICLE_EFFECTS";
+        case debug_menu::debug_menu_index::LLM_TELEMETRY: return "LLM_TELEMETRY";
+        case debug_menu::debug_menu_index::HOT_PATH_TRACE: return "HOT_PATH_TRACE";
+        case debug_menu::debug_menu_index::PERF_HUD: return "PERF_HUD";
+        case debug_menu::debug_menu_index::MEMORY_REPORT: return "MEMORY_REPORT";
+        case debug_menu::debug_menu_index::TURN_REPLAY: return "TURN_REPLAY";
         // *INDENT-ON*
         case debug_menu::debug_menu_index::last:
             break;
@@ -987,6 +996,11 @@ static int info_uilist()
         { uilist_entry( debug_menu_index::GENERATE_EFFECT_LIST, true, 'L', _( "Generate effect list" ) ) },
         { uilist_entry( debug_menu_index::WRITE_CITY_LIST, true, 'C', _( "Write city list to cities.output" ) ) },
         { uilist_entry( debug_menu_index::IMGUI_DEMO, true, 'u', _( "Open ImGui demo screen" ) ) },
+        { uilist_entry( debug_menu_index::LLM_TELEMETRY, true, 'N', _( "Show NPC LLM request timings" ) ) },
+        { uilist_entry( debug_menu_index::HOT_PATH_TRACE, true, 'P', perf_trace::is_recording() ? _( "Stop hot path trace and write hot_path_trace.json" ) : _( "Start hot path trace" ) ) },
+        { uilist_entry( debug_menu_index::PERF_HUD, true, 'O', _( "Toggle performance overlay" ) ) },
+        { uilist_entry( debug_menu_index::MEMORY_REPORT, true, 'Y', _( "Write memory footprint report" ) ) },
+        { uilist_entry( debug_menu_index::TURN_REPLAY, true, 'K', turn_replay::is_recording() ? _( "Stop turn recording" ) : _( "Record turns for replay" ) ) },
     };
 
     return uilist( _( "Info…" ), uilist_initializer );
@@ -4598,6 +4612,55 @@ void debug()
             run_imgui_demo();
             break;
 
+        case debug_menu_index::LLM_TELEMETRY:
+            popup_top( "%s", llm_intent::telemetry_summary() );
+            if( query_yn( _( "Write the timings to llm_intent_telemetry.csv and .json?" ) ) ) {
+                const std::string path = llm_intent::write_telemetry();
+                if( !path.empty() ) {
+                    popup( _( "Wrote %s" ), path );
+                }
+            }
+            break;
+
+        case debug_menu_index::HOT_PATH_TRACE:
+            if( !perf_trace::is_recording() ) {
+                perf_trace::start();
+                add_msg( m_info, _( "Tracing hot paths, stop it from the debug menu." ) );
+            } else {
+                perf_trace::stop();
+                const cata_path trace_path = PATH_INFO::config_dir_path() / "hot_path_trace.json";
+                if( perf_trace::write( trace_path ) ) {
+                    popup( _( "Wrote %s" ), trace_path.generic_u8string() );
+                }
+            }
+            break;
+
+        case debug_menu_index::PERF_HUD:
+            g->toggle_perf_hud();
+            break;
+
+        case debug_menu_index::MEMORY_REPORT: {
+            const memory_report::report rep = memory_report::collect();
+            const cata_path report_path = PATH_INFO::config_dir_path() / "memory_report.json";
+            if( memory_report::write( rep, report_path ) ) {
+                popup_top( "%s\n%s", memory_report::summary( rep ),
+                           string_format( _( "Wrote %s" ), report_path.generic_u8string() ) );
+            }
+            break;
+        }
+
+        case debug_menu_index::TURN_REPLAY:
+            if( turn_replay::is_recording() ) {
+                turn_replay::stop_recording();
+            } else {
+                int turns = 100;
+                if( query_int( turns, true, _( "Record how many turns?" ) ) && turns > 0 ) {
+                    turn_replay::request_recording( turns );
+                    add_msg( m_info, _( "Recording starts at the end of this turn." ) );
+                }
+            }
+            break;
+
         case debug_menu_index::TALK_TOPIC:
             display_talk_topic();
             break;
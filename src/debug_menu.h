@@ -120,6 +120,11 @@ enum class debug_menu_index : int {
     TALK_TOPIC,
     IMGUI_DEMO,
     VEHICLE_EFFECTS,
+    LLM_TELEMETRY,
+    HOT_PATH_TRACE,
+    PERF_HUD,
+    MEMORY_REPORT,
+    TURN_REPLAY,
     last
 };
 
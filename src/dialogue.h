@@ -209,6 +209,8 @@ struct talk_response {
     talk_data create_option_line( dialogue &d, const input_event &hotkey,
                                   bool is_computer = false );
     std::set<dialogue_consequence> get_consequences( dialogue &d ) const;
+    // As above, with the trial's chance already worked out by the caller.
+    std::set<dialogue_consequence> get_consequences( dialogue &d, int chance ) const;
     // debug: conditional / effect
     std::map<std::string, std::string> debug_info;
 
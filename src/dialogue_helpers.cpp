@@ -28,7 +28,15 @@ diag_value const *maybe_read_var_value( const var_info &info, const_dialogue con
     global_variables &globvars = get_globals();
     switch( info.type ) {
         case var_type::global:
-            return globvars.maybe_get_global_value( info.name );
+            if( info.cached_generation != global_variables::get_generation() ) {
+                info.cached_global = globvars.maybe_get_global_value( info.name );
+                if( info.cached_global == nullptr ) {
+                    // Not cached, it may be set at any time
+                    return nullptr;
+                }
+                info.cached_generation = global_variables::get_generation();
+            }
+            return info.cached_global;
         case var_type::context:
             return d.maybe_get_value( info.name );
         case var_type::u: {
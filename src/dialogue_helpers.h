@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_DIALOGUE_HELPERS_H
 #define CATA_SRC_DIALOGUE_HELPERS_H
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -48,6 +49,9 @@ struct var_info {
     var_info() : type( var_type::last ) {}
     var_type type;
     std::string name;
+    // Last value found for a global variable, valid while the globals' generation is unchanged
+    mutable diag_value const *cached_global = nullptr;
+    mutable uint64_t cached_generation = 0;
 
     void _deserialize( JsonObject const &jo );
     void deserialize( JsonValue const &jsin );
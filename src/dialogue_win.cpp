@@ -98,13 +98,21 @@ void dialogue_window::draw( const std::string &npc_name )
     if( update_history_view ) {
         update_history_view = false;
         const int newindex = history.size() - num_lines_highlighted;
-        std::string assembled;
+        const int width = history_view->text_width();
+        std::vector<std::string> lines;
         for( int i = 0; i < static_cast<int>( history.size() ); ++i ) {
-            nc_color col = ( i >= newindex ) ? history[i].color : c_light_gray;
-            assembled += colorize( history[i].text, col ).append( "\n" );
+            history_message &msg = history[i];
+            const bool highlighted = i >= newindex;
+            if( msg.folded_width != width || msg.folded_highlighted != highlighted ) {
+                msg.folded = foldstring( colorize( msg.text, highlighted ? msg.color : c_light_gray ),
+                                         width );
+                msg.folded_width = width;
+                msg.folded_highlighted = highlighted;
+            }
+            lines.insert( lines.end(), msg.folded.begin(), msg.folded.end() );
         }
 
-        history_view->set_text( assembled, false );
+        history_view->set_lines( std::move( lines ), false );
     }
     history_view->draw( c_light_gray );
 }
@@ -70,6 +70,10 @@ class dialogue_window
 
             nc_color color; // Text color when highlighted
             std::string text;
+            // The text as last folded, so a redraw only folds new or recolored messages
+            std::vector<std::string> folded;
+            int folded_width = -1;
+            bool folded_highlighted = false;
         };
 
         void add_to_history( const std::string &text, nc_color color );
@@ -20,6 +20,7 @@
 #include "action.h"
 #include "activity_type.h"
 #include "avatar.h"
+#include "basecamp.h"
 #include "bionics.h"
 #include "cached_options.h"
 #include "calendar.h"
@@ -45,9 +46,11 @@
 #include "mapbuffer.h"
 #include "mapdata.h"
 #include "memorial_logger.h"
+#include "memory_budget.h"
 #include "messages.h"
 #include "llm_intent.h"
 #include "mission.h"
+#include "monfaction.h"
 #include "monster.h"
 #include "mtype.h"
 #include "music.h"
@@ -56,6 +59,8 @@
 #include "output.h"
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
+#include "perf.h"
+#include "perf_hud.h"
 #include "pimpl.h"
 #include "player_activity.h"
 #include "point.h"
@@ -67,8 +72,10 @@
 #include "sounds.h"
 #include "stats_tracker.h"
 #include "string_formatter.h"
+#include "thread_pool.h"
 #include "timed_event.h"
 #include "translations.h"
+#include "turn_replay.h"
 #include "type_id.h"
 #include "uilist.h"
 #include "ui_manager.h"
@@ -97,6 +104,10 @@ static const json_character_flag json_flag_NO_SCENT( "NO_SCENT" );
 
 static const trait_id trait_HAS_NEMESIS( "HAS_NEMESIS" );
 
+static const option_handle<bool> option_autosave( "AUTOSAVE" );
+static const option_handle<int> option_autosave_turns( "AUTOSAVE_TURNS" );
+static const option_handle<bool> option_force_redraw( "FORCE_REDRAW" );
+
 #if defined(__ANDROID__)
 extern std::map<std::string, std::list<input_event>> quick_shortcuts_map;
 extern bool add_best_key_for_action_to_quick_shortcuts( action_id action,
@@ -110,6 +121,8 @@ namespace turn_handler
 bool cleanup_at_end()
 {
     avatar &u = get_avatar();
+    // Not over the main menu.
+    g->perf_overlay.reset();
     if( g->uquit == QUIT_DIED || g->uquit == QUIT_SUICIDE ) {
         // Put (non-hallucinations) into the overmap so they are not lost.
         for( monster &critter : g->all_monsters() ) {
@@ -273,12 +286,50 @@ void handle_key_blocking_activity()
 
 namespace
 {
+// Traces the sight lines from monsters to the NPCs they may want to target on the thread pool,
+// so that the serial monster::plan() calls below find them already known. Only the player's
+// z-level is done, that's the one whose transparency cache was just rebuilt.
+void prefetch_monster_sight_lines( const map &m, int z )
+{
+    std::vector<const npc *> targets;
+    for( const npc &who : g->all_npcs() ) {
+        if( who.posz() == z ) {
+            targets.push_back( &who );
+        }
+    }
+    if( targets.empty() ) {
+        return;
+    }
+    std::vector<std::pair<tripoint_bub_ms, tripoint_bub_ms>> lines;
+    for( const monster &critter : g->all_monsters() ) {
+        if( critter.is_dead() || critter.posz() != z || !m.inbounds( critter.pos_abs() ) ) {
+            continue;
+        }
+        const tripoint_bub_ms from = critter.pos_bub( m );
+        for( const npc *who : targets ) {
+            const mf_attitude faction_att = critter.faction.obj().attitude( who->get_monster_faction() );
+            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
+                continue;
+            }
+            const tripoint_bub_ms to = who->pos_bub( m );
+            const int dist = rl_dist( from, to );
+            if( dist > 1 && dist <= MAX_VIEW_DISTANCE ) {
+                lines.emplace_back( from, to );
+            }
+        }
+    }
+    m.prefetch_sight_lines( lines );
+}
+
 void monmove()
 {
+    CATA_TRACE_ZONE( "monmove" );
     g->cleanup_dead();
     map &m = get_map();
     avatar &u = get_avatar();
 
+    prefetch_monster_sight_lines( m, u.posz() );
+
     for( monster &critter : g->all_monsters() ) {
         if( !m.inbounds( critter.pos_abs() ) ) {
             continue;
@@ -325,13 +376,20 @@ void monmove()
         while( critter.get_moves() > 0 && !critter.is_dead() && !critter.has_effect( effect_ridden ) ) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
-            if( !critter.has_effect( effect_controlled ) ) {
-                // Formulate a path to follow
-                critter.plan();
-            } else {
+            if( critter.has_effect( effect_controlled ) ) {
                 critter.set_moves( 0 );
                 break;
             }
+            // Far away idle monsters skip most of their AI, see monster::ai_lod()
+            const monster_lod lod = critter.ai_lod();
+            if( lod == monster_lod::coarse ) {
+                critter.coarse_move();
+                break;
+            }
+            if( critter.lod_plan_due( lod ) ) {
+                // Formulate a path to follow
+                critter.plan();
+            }
             critter.move(); // Move one square, possibly hit u
             critter.process_triggers();
             m.creature_in_field( critter );
@@ -421,7 +479,12 @@ void overmap_npc_move()
             continue;
         }
         npc *npc_to_add = elem.get();
-        if( ( !npc_to_add->is_active() || rl_dist( u.pos_bub(), npc_to_add->pos_bub() ) > SEEX * 2 ) &&
+        const bool active = npc_to_add->is_active();
+        if( !active ) {
+            // Away from the bubble it only travels, or is reached over the radio and by camps.
+            npc_to_add->hibernate();
+        }
+        if( ( !active || rl_dist( u.pos_bub(), npc_to_add->pos_bub() ) > SEEX * 2 ) &&
             npc_to_add->mission == NPC_MISSION_TRAVELLING ) {
             travelling_npcs.push_back( npc_to_add );
         }
@@ -464,6 +527,10 @@ void overmap_npc_move()
 // Returns true if game is over (death, saved, quit, etc)
 bool do_turn()
 {
+    // Everything since the last call, drawing included, counts to the turn before this one.
+    perf_trace::end_turn();
+    turn_replay::end_turn();
+    CATA_TRACE_ZONE( "do_turn" );
     if( g->is_game_over() ) {
         return turn_handler::cleanup_at_end();
     }
@@ -481,7 +548,10 @@ bool do_turn()
             weather.set_nextweather( calendar::turn );
         }
     } else {
-        g->gamemode->per_turn();
+        // Tests run turns without having started a game.
+        if( g->gamemode ) {
+            g->gamemode->per_turn();
+        }
         calendar::turn += 1_turns;
     }
     //used for dimension swapping
@@ -525,6 +595,14 @@ bool do_turn()
     if( calendar::once_every( 1_days ) ) {
         overmap_buffer.process_mongroups();
     }
+    if( calendar::once_every( 10_minutes ) ) {
+        for( const tripoint_abs_omt &camp_pos : u.camps ) {
+            if( std::optional<basecamp *> camp = overmap_buffer.find_camp( camp_pos.xy() ) ) {
+                ( *camp )->simulate_offscreen();
+            }
+        }
+        overmap_buffer.process_fires();
+    }
 
     // Move hordes every turn, move_hordes has its own rate limiting
     overmap_buffer.move_hordes();
@@ -535,15 +613,28 @@ bool do_turn()
     }
 
     g->debug_hour_timer.print_time();
+    if( cata::allocation_tracking_enabled() && calendar::once_every( 1_hours ) ) {
+        perf_trace::log_allocations();
+    }
 
     u.update_body();
 
     // Auto-save if autosave is enabled
-    if( get_option<bool>( "AUTOSAVE" ) &&
-        calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
+    if( option_autosave.get() &&
+        calendar::once_every( 1_turns * option_autosave_turns.get() ) &&
         !u.is_dead_state() ) {
         g->autosave();
     }
+    if( calendar::once_every( 10_turns ) && !u.is_dead_state() ) {
+        memory_budget::check();
+    }
+    overmap_buffer.generate_ahead( u.pos_abs_omt() );
+    // The OMT stacks the last map shift is heading toward, a few milliseconds worth per turn.
+    m.generate_queued_mapgen( std::chrono::milliseconds( 5 ) );
+    // Tidy up fragmented map saves on the background thread while nothing is going on.
+    if( calendar::once_every( 1_minutes ) && !u.is_dead_state() && !g->is_hostile_nearby() ) {
+        MAPBUFFER.compact_idle_archives();
+    }
 
     weather.update_weather();
     g->reset_light_level();
@@ -654,10 +745,23 @@ bool do_turn()
         scent.set( u.pos_bub(), u.scent, u.get_type_of_scent() );
         overmap_buffer.set_scent( u.pos_abs_omt(),  u.scent );
     }
-    scent.update( u.pos_bub(), m );
-
+    // Scent diffusion reads terrain, furniture and vehicle parts and writes only the scent map.
+    // The floor caches read terrain and furniture and write only the floor caches. Neither
+    // uses the RNG, and everything below reads one or the other, so both finish before it.
+    // They only debugmsg about unloaded submaps, so then they run one after the other.
+    const auto update_scent = [&]() {
+        scent.update( u.pos_bub(), m );
+    };
     // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
+    const auto build_floor_caches = [&]() {
+        m.build_floor_caches();
+    };
+    if( m.all_submaps_loaded() ) {
+        cata::get_thread_pool().run_alongside( update_scent, build_floor_caches );
+    } else {
+        update_scent();
+        build_floor_caches();
+    }
 
     m.process_falling();
     m.vehmove();
@@ -692,7 +796,7 @@ bool do_turn()
     }
     g->mon_info_update();
     u.process_turn();
-    if( u.get_moves() < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+    if( u.get_moves() < 0 && option_force_redraw.get() ) {
         ui_manager::redraw();
         refresh_display();
     }
@@ -771,6 +875,7 @@ bool do_turn()
     sfx::do_vehicle_engine_sfx();
     sfx::do_vehicle_exterior_engine_sfx();
     sfx::do_low_stamina_sfx();
+    sfx::do_sfx_loader_upkeep();
 
     // reset player noise
     u.volume = 0;
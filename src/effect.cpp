@@ -583,6 +583,11 @@ double effect_type::get_mod_value( const std::string &type, mod_action action,
     return ret;
 }
 
+bool effect_type::has_mod_data() const
+{
+    return !mod_data.empty();
+}
+
 void effect_type::check_consistency()
 {
     for( auto const &check : effect_types ) {
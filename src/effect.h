@@ -147,6 +147,8 @@ class effect_type
 
         double get_mod_value( const std::string &type, mod_action action, uint8_t reduction_level,
                               int intensity ) const;
+        /** Whether any modifier (HURT, PAIN, SPEED...) is set, without one every get_mod_value is 0. */
+        bool has_mod_data() const;
 
         bool is_show_in_info() const;
 
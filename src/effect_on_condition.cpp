@@ -97,6 +97,12 @@ void effect_on_condition::load( const JsonObject &jo, std::string_view src )
         type = eoc_type::RECURRING;
         optional( jo, was_loaded, "recurrence", recurrence );
     }
+    if( jo.has_member( "wake_on_events" ) ) {
+        if( type != eoc_type::RECURRING ) {
+            jo.throw_error( "Only a recurring effect_on_condition can wake on events." );
+        }
+        optional( jo, was_loaded, "wake_on_events", wake_events );
+    }
     if( type == eoc_type::NUM_EOC_TYPES ) {
         type = eoc_type::ACTIVATION;
     }
@@ -553,6 +559,7 @@ void eoc_events::clear()
 {
     has_cached = false;
     event_EOCs.clear();
+    wake_EOCs.clear();
 }
 
 void eoc_events::notify( const cata::event &e )
@@ -577,11 +584,23 @@ void eoc_events::notify( const cata::event &e, std::unique_ptr<talker> alpha,
             if( eoc.type == eoc_type::EVENT ) {
                 event_EOCs[eoc.required_event].emplace_back( eoc );
             }
+            for( const event_type wake_event : eoc.wake_events ) {
+                wake_EOCs[wake_event].push_back( eoc.id );
+            }
         }
 
         has_cached = true;
     }
 
+    const auto woken = wake_EOCs.find( e.type() );
+    if( woken != wake_EOCs.end() ) {
+        g->queued_global_effect_on_conditions.wake_up( woken->second );
+        get_avatar().queued_effect_on_conditions.wake_up( woken->second );
+        for( npc &guy : g->all_npcs() ) {
+            guy.queued_effect_on_conditions.wake_up( woken->second );
+        }
+    }
+
     for( const effect_on_condition &eoc : event_EOCs[e.type()] ) {
         if( !alpha ) {
             // try to assign a character for the EOC
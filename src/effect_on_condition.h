@@ -43,6 +43,8 @@ class eoc_events : public event_subscriber
 
     private:
         std::map<event_type, std::vector<effect_on_condition>> event_EOCs;
+        /** Recurring EOCs by the events listed in their wake_on_events */
+        std::map<event_type, std::vector<effect_on_condition_id>> wake_EOCs;
         bool has_cached = false;
 };
 
@@ -66,6 +68,8 @@ struct effect_on_condition {
         bool has_false_effect = false;
         event_type required_event;
         duration_or_var recurrence;
+        /** Events that move a queued RECURRING EOC up to the current turn */
+        std::vector<event_type> wake_events;
         bool activate( dialogue &d, bool require_callstack_check = true ) const;
         bool activate_activation_only( dialogue &d, const std::string &text1, const std::string &text2 = "",
                                        const std::string &text3 = "", bool require_callstack_check = true ) const;
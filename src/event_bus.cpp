@@ -62,6 +62,11 @@ event_bus::~event_bus()
 void event_bus::subscribe( event_subscriber *s )
 {
     subscribers.push_back( s );
+    for( size_t i = 0; i < subscribers_by_type.size(); ++i ) {
+        if( s->notified_by( static_cast<event_type>( i ) ) ) {
+            subscribers_by_type[i].push_back( s );
+        }
+    }
     s->on_subscribe( this );
 }
 
@@ -73,6 +78,9 @@ void event_bus::unsubscribe( event_subscriber *s )
     } else {
         ( *it )->on_unsubscribe( this );
         subscribers.erase( it );
+        for( std::vector<event_subscriber *> &of_type : subscribers_by_type ) {
+            of_type.erase( std::remove( of_type.begin(), of_type.end(), s ), of_type.end() );
+        }
     }
 }
 
@@ -84,7 +92,7 @@ void event_bus::send( const cata::event &e ) const
         debugmsg( "Null event sent to bus.  REJECTED!" );
         return;
     }
-    for( event_subscriber *s : subscribers ) {
+    for( event_subscriber *s : subscribers_of( e.type() ) ) {
         s->notify( e );
     }
 }
@@ -92,7 +100,7 @@ void event_bus::send( const cata::event &e ) const
 void event_bus::send_with_talker( Creature *alpha, Creature *beta,
                                   const cata::event &e ) const
 {
-    for( event_subscriber *s : subscribers ) {
+    for( event_subscriber *s : subscribers_of( e.type() ) ) {
         s->notify( e, get_talker_for( alpha ), get_talker_for( beta ) );
     }
 }
@@ -100,14 +108,14 @@ void event_bus::send_with_talker( Creature *alpha, Creature *beta,
 void event_bus::send_with_talker( Creature *alpha, item_location *beta,
                                   const cata::event &e ) const
 {
-    for( event_subscriber *s : subscribers ) {
+    for( event_subscriber *s : subscribers_of( e.type() ) ) {
         s->notify( e, get_talker_for( alpha ), get_talker_for( beta ) );
     }
 }
 
 void event_bus::send_with_talker( vehicle *alpha,  Creature *beta, const cata::event &e ) const
 {
-    for( event_subscriber *s : subscribers ) {
+    for( event_subscriber *s : subscribers_of( e.type() ) ) {
         s->notify( e, get_talker_for( alpha ), get_talker_for( beta ) );
     }
 }
@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_EVENT_BUS_H
 #define CATA_SRC_EVENT_BUS_H
 
+#include <array>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -28,10 +30,20 @@ class event_bus
         void send_with_talker( vehicle *alpha, Creature *, const cata::event &e ) const;
         template<event_type Type, typename... Args>
         void send( Args &&... args ) const {
-            send( cata::event::make<Type>( std::forward<Args>( args )... ) );
+            // Don't build events nobody listens to
+            if( !subscribers_of( Type ).empty() ) {
+                send( cata::event::make<Type>( std::forward<Args>( args )... ) );
+            }
         }
     private:
+        const std::vector<event_subscriber *> &subscribers_of( event_type type ) const {
+            return subscribers_by_type[static_cast<size_t>( type )];
+        }
+
         std::vector<event_subscriber *> subscribers;
+        /** Subscribers in subscription order, by the event types they are notified by */
+        std::array<std::vector<event_subscriber *>, static_cast<size_t>( event_type::num_event_types )>
+        subscribers_by_type;
 };
 
 event_bus &get_event_bus();
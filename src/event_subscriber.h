@@ -10,6 +10,7 @@ class event;
 }  // namespace cata
 class event_bus;
 class talker;
+enum class event_type : int;
 
 class event_subscriber
 {
@@ -20,6 +21,13 @@ class event_subscriber
         virtual ~event_subscriber();
         virtual void notify( const cata::event & ) = 0;
         virtual void notify( const cata::event &, std::unique_ptr<talker>, std::unique_ptr<talker> );
+        /**
+         * Whether to send events of this type to the subscriber at all. Asked once per type
+         * when subscribing, so the answer must not change afterwards.
+         */
+        virtual bool notified_by( event_type ) const {
+            return true;
+        }
     private:
         friend class event_bus;
         void on_subscribe( event_bus * );
@@ -11,8 +11,9 @@
 #include <optional>
 #include <queue>
 #include <random>
-#include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -205,9 +206,13 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
 
     std::priority_queue< std::pair<float, tripoint_bub_ms>, std::vector< std::pair<float, tripoint_bub_ms> >, pair_greater_cmp_first >
     open;
-    std::set<tripoint_bub_ms> closed;
-    std::set<tripoint_bub_ms> bashed{ p };
-    std::map<tripoint_bub_ms, float> dist_map;
+    // Hashed for the per-neighbour lookups, the ordered lists keep the effects below applied
+    // in the same order as before.
+    std::unordered_set<tripoint_bub_ms> closed;
+    std::unordered_set<tripoint_bub_ms> bashed{ p };
+    std::unordered_map<tripoint_bub_ms, float> dist_map;
+    std::vector<tripoint_bub_ms> closed_order;
+    std::vector<tripoint_bub_ms> bashed_order{ p };
     open.emplace( 0.0f, p );
     dist_map[p] = 0.0f;
     // Find all points to blast
@@ -222,6 +227,7 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
         }
 
         closed.insert( pt );
+        closed_order.push_back( pt );
 
         const float force = power * std::pow( distance_factor, distance );
         if( force <= 1.0f ) {
@@ -251,8 +257,8 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
                 continue;
             }
 
-            if( bashed.count( dest ) == 0 ) {
-                bashed.insert( dest );
+            if( bashed.insert( dest ).second ) {
+                bashed_order.push_back( dest );
                 // Up to 200% bonus for shaped charge
                 // But not if the explosion is fiery, then only half the force and no bonus
                 const float bash_force = !fire ?
@@ -281,14 +287,17 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
+            const auto known = dist_map.emplace( dest, next_dist );
+            if( known.second || known.first->second > next_dist ) {
                 open.emplace( next_dist, dest );
-                dist_map[dest] = next_dist;
+                known.first->second = next_dist;
             }
         }
     }
+    std::sort( closed_order.begin(), closed_order.end() );
+    std::sort( bashed_order.begin(), bashed_order.end() );
 
-    for( const tripoint_bub_ms &pos : bashed ) {
+    for( const tripoint_bub_ms &pos : bashed_order ) {
         const tripoint_bub_ms below = pos + tripoint::below;
         const ter_t ter_below = m->ter( below ).obj();
 
@@ -303,7 +312,7 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
     map &bubble_map = reality_bubble();
     if( bubble_map.inbounds( m->get_abs( p ) ) ) {
         std::map<tripoint_bub_ms, nc_color> explosion_colors;
-        for( const tripoint_bub_ms &pt : closed ) {
+        for( const tripoint_bub_ms &pt : closed_order ) {
             const tripoint_bub_ms bubble_pos( bubble_map.get_bub( m->get_abs( pt ) ) );
 
             if( !bubble_map.inbounds( bubble_pos ) ) {
@@ -329,7 +338,7 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
 
     creature_tracker &creatures = get_creature_tracker();
     Creature *mutable_source = source == nullptr ? nullptr : creatures.creature_at( source->pos_abs() );
-    for( const tripoint_bub_ms &pt : closed ) {
+    for( const tripoint_bub_ms &pt : closed_order ) {
         const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
         if( force < 1.0f ) {
             // Too weak to matter
@@ -655,7 +664,12 @@ void flashbang( const tripoint_bub_ms &p, bool player_immune, const int radius )
         penalize_char( here, guy, p, radius );
     }
 
-    for( monster &critter : g->all_monsters() ) {
+    creature_tracker &creatures = get_creature_tracker();
+    for( Creature *caught : creatures.creatures_in_radius( here.get_abs( p ), radius, radius ) ) {
+        if( !caught->is_monster() ) {
+            continue;
+        }
+        monster &critter = *caught->as_monster();
         if( critter.type->in_species( species_ROBOT ) || critter.has_flag( mon_flag_FLASHBANGPROOF ) ) {
             continue;
         }
@@ -684,10 +698,12 @@ void shockwave( const tripoint_bub_ms &p, int radius, int force, int stun, int d
     sounds::sound( p, force * force * dam_mult / 2, sounds::sound_t::combat, _( "Crack!" ), false,
                    "misc", "shockwave" );
 
-    for( monster &critter : g->all_monsters() ) {
-        if( critter.posz() != p.z() ) {
+    for( Creature *caught : get_creature_tracker().creatures_in_radius( get_map().get_abs( p ),
+            radius ) ) {
+        if( !caught->is_monster() ) {
             continue;
         }
+        monster &critter = *caught->as_monster();
         if( rl_dist( critter.pos_bub(), p ) <= radius ) {
             add_msg( _( "%s is caught in the shockwave!" ), critter.name() );
             g->knockback( p, critter.pos_bub(), force, stun, dam_mult );
@@ -988,14 +1004,36 @@ void process_explosions()
     std::vector<queued_explosion> explosions_copy( _explosions );
     _explosions.clear();
 
+    const auto fits = []( const map & m, const tripoint_abs_ms & pos, int safe_range ) {
+        const tripoint_bub_ms local = m.get_bub( pos );
+        return local.x() - safe_range >= 0 && local.x() + safe_range <= MAPSIZE_X &&
+               local.y() - safe_range >= 0 && local.y() + safe_range <= MAPSIZE_Y;
+    };
+    // A chain of mines or a cluster of grenades going off away from the reality bubble would
+    // otherwise load the same neighbourhood once per explosion, so keep the last loaded map
+    // for the following explosions it can hold.
+    std::unique_ptr<map> loaded;
+    std::optional<swap_map> swapped;
+    const auto drop_loaded = [&loaded, &swapped]() {
+        swapped.reset();
+        loaded.reset();
+    };
+
     for( const queued_explosion &ex : explosions_copy ) {
         const int safe_range = ex.data.safe_range();
         map  *bubble_map = &reality_bubble();
-        const tripoint_bub_ms bubble_pos( bubble_map->get_bub( ex.pos ) );
 
-        if( bubble_pos.x() - safe_range < 0 || bubble_pos.x() + safe_range > MAPSIZE_X ||
-            bubble_pos.y() - safe_range < 0 || bubble_pos.y() + safe_range > MAPSIZE_Y ) {
-            map m;
+        if( fits( *bubble_map, ex.pos, safe_range ) ) {
+            // The reality bubble has to be the current map again.
+            drop_loaded();
+            _make_explosion( bubble_map, ex.source, bubble_map->get_bub( ex.pos ), ex.data );
+        } else if( loaded && fits( *loaded, ex.pos, safe_range ) ) {
+            _make_explosion( loaded.get(), ex.source, loaded->get_bub( ex.pos ), ex.data );
+            loaded->process_falling();
+        } else {
+            drop_loaded();
+            loaded = std::make_unique<map>();
+            map &m = *loaded;
             const tripoint_abs_sm origo( project_to<coords::sm>( ex.pos ) - point_rel_sm{ HALF_MAPSIZE, HALF_MAPSIZE} );
             // Create a map centered around the explosion point to allow an explosion with a radius of up to 5 submaps
             // to be created without being cut off by the map's boundary. That also means there is no need for the map
@@ -1003,16 +1041,15 @@ void process_explosions()
             // or have a vehicle run into a crater suddenly appearing just in front of it.
             process_explosions_in_progress = true;
             m.load( origo, true, false );
-            swap_map swap( m );
+            swapped.emplace( m );
             m.spawn_monsters( true, true );
             g->load_npcs( &m );
             process_explosions_in_progress = false;
             _make_explosion( &m, ex.source, m.get_bub( ex.pos ), ex.data );
             m.process_falling();
-        } else {
-            _make_explosion( bubble_map, ex.source, bubble_map->get_bub( ex.pos ), ex.data );
         }
     }
+    drop_loaded();
 }
 
 } // namespace explosion_handler
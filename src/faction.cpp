@@ -469,12 +469,8 @@ faction_price_rule const *faction::get_price_rules( item const &it, npc const &g
 
 bool faction::has_relationship( const faction_id &guy_id, npc_factions::relationship flag ) const
 {
-    for( const auto &rel_data : relations ) {
-        if( rel_data.first == guy_id.c_str() ) {
-            return rel_data.second.test( static_cast<size_t>( flag ) );
-        }
-    }
-    return false;
+    const auto rel_data = relations.find( guy_id.str() );
+    return rel_data != relations.end() && rel_data->second.test( static_cast<size_t>( flag ) );
 }
 
 std::string fac_combat_ability_text( int val )
@@ -4954,6 +4954,7 @@ npc_ptr basecamp::start_mission( const mission_id &miss_id, time_duration total_
                 }
             }
             target_map.save();
+            invalidate_crafting_inventory();
         }
     }
     return comp;
@@ -5200,6 +5201,7 @@ void basecamp::scan_pseudo_items()
             }
         }
     }
+    invalidate_crafting_inventory();
 }
 
 void basecamp::worker_assignment_ui()
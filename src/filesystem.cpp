@@ -571,6 +571,19 @@ bool copy_file( const cata_path &source_path, const cata_path &dest_path )
     }, nullptr ) &&source_stream;
 }
 
+bool copy_directory( const cata_path &source_path, const cata_path &dest_path )
+{
+    std::error_code ec;
+    setFsNeedsSync();
+    std::filesystem::remove_all( dest_path.get_unrelative_path(), ec );
+    if( ec ) {
+        return false;
+    }
+    std::filesystem::copy( source_path.get_unrelative_path(), dest_path.get_unrelative_path(),
+                           std::filesystem::copy_options::recursive, ec );
+    return !ec;
+}
+
 std::string ensure_valid_file_name( const std::string &file_name )
 {
     const char replacement_char = ' ';
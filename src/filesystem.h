@@ -113,6 +113,8 @@ std::vector<P> get_directories( const P &root_path = P(),
 
 bool copy_file( const std::string &source_path, const std::string &dest_path );
 bool copy_file( const cata_path &source_path, const cata_path &dest_path );
+// Copy a folder and everything in it, replacing whatever was at @p dest_path before.
+bool copy_directory( const cata_path &source_path, const cata_path &dest_path );
 
 /**
  *  Replace invalid characters in a string with a default character; can be used to ensure that a file name is compliant with most file systems.
@@ -0,0 +1,53 @@
+#include "flat_lru_cache.h"
+
+#include <map>
+#include <memory>
+
+namespace cache_counters
+{
+
+namespace
+{
+
+struct registry {
+    std::mutex mutex;
+    // Sorted by name, and the counters stay where they are as names are added.
+    std::map<std::string, std::unique_ptr<counters>, std::less<>> by_name;
+};
+
+registry &get_registry()
+{
+    static registry instance;
+    return instance;
+}
+
+} // namespace
+
+counters &named( std::string_view name )
+{
+    registry &reg = get_registry();
+    std::lock_guard<std::mutex> lock( reg.mutex );
+    auto it = reg.by_name.find( name );
+    if( it == reg.by_name.end() ) {
+        it = reg.by_name.emplace( std::string( name ), std::make_unique<counters>() ).first;
+    }
+    return *it->second;
+}
+
+std::vector<std::pair<std::string, cache_stats>> all()
+{
+    registry &reg = get_registry();
+    std::lock_guard<std::mutex> lock( reg.mutex );
+    std::vector<std::pair<std::string, cache_stats>> ret;
+    ret.reserve( reg.by_name.size() );
+    for( const auto &entry : reg.by_name ) {
+        cache_stats stats;
+        stats.hits = entry.second->hits.load( std::memory_order_relaxed );
+        stats.misses = entry.second->misses.load( std::memory_order_relaxed );
+        stats.evictions = entry.second->evictions.load( std::memory_order_relaxed );
+        ret.emplace_back( entry.first, stats );
+    }
+    return ret;
+}
+
+} // namespace cache_counters
@@ -0,0 +1,319 @@
+#pragma once
+#ifndef CATA_SRC_FLAT_LRU_CACHE_H
+#define CATA_SRC_FLAT_LRU_CACHE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct cache_stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+/**
+ * Hit, miss and eviction counts summed over every cache created with the same name, for the
+ * performance overlay. The counters are never freed, so caches can come and go freely.
+ */
+namespace cache_counters
+{
+
+struct counters {
+    std::atomic<uint64_t> hits{ 0 };
+    std::atomic<uint64_t> misses{ 0 };
+    std::atomic<uint64_t> evictions{ 0 };
+};
+
+/** The counters of caches called @p name. Takes a lock, so look them up once per cache. */
+counters &named( std::string_view name );
+/** Every name and its counts so far, sorted by name. */
+std::vector<std::pair<std::string, cache_stats>> all();
+
+} // namespace cache_counters
+
+/**
+ * A cache of at most a fixed number of entries, without a node per entry.
+ *
+ * Entries sit in one array and are found through an open addressed index, so a lookup is
+ * a hash and a short probe, and inserting only allocates when the arrays are first made.
+ * When full, the entry to drop is chosen by the CLOCK approximation of least recently used:
+ * a hit marks the entry, and the clock hand passes over marked entries once, unmarking them.
+ * Nothing is allocated until the first insert, so a cache per creature costs little until
+ * it is used.
+ *
+ * Not thread-safe, @p get writes the mark. See @ref sharded_lru_cache for that.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class flat_lru_cache
+{
+    public:
+        /** @p name, if any, is what the counters are listed as on the performance overlay. */
+        explicit flat_lru_cache( size_t capacity, std::string_view name = {} )
+            : capacity_( std::max<size_t>( capacity, 1 ) ),
+              shared( name.empty() ? nullptr : &cache_counters::named( name ) ) {}
+
+        Value get( const Key &key, const Value &default_ ) const {
+            const int32_t found = find_slot( key );
+            if( found < 0 ) {
+                count( stats_.misses, shared ? &shared->misses : nullptr );
+                return default_;
+            }
+            count( stats_.hits, shared ? &shared->hits : nullptr );
+            slots[found].referenced = true;
+            return slots[found].value;
+        }
+
+        void insert( const Key &key, const Value &value ) {
+            insert( key, value, []( const Key &, const Value & ) {} );
+        }
+        /** Same as above, handing the entry it pushes out, if any, to @p on_evict. */
+        template<typename OnEvict>
+        void insert( const Key &key, const Value &value, OnEvict &&on_evict ) {
+            if( index.empty() ) {
+                allocate();
+            }
+            const size_t hash = Hash()( key );
+            size_t pos = bucket_of( hash );
+            for( ; index[pos] >= 0; pos = ( pos + 1 ) & mask ) {
+                slot &s = slots[index[pos]];
+                if( s.hash == hash && s.key == key ) {
+                    s.value = value;
+                    s.referenced = true;
+                    return;
+                }
+            }
+            int32_t target;
+            if( !free_slots.empty() ) {
+                target = free_slots.back();
+                free_slots.pop_back();
+            } else {
+                target = evict( std::forward<OnEvict>( on_evict ) );
+                // The victim's index entry is gone, the probe for the new key may end elsewhere.
+                pos = bucket_of( hash );
+                while( index[pos] >= 0 ) {
+                    pos = ( pos + 1 ) & mask;
+                }
+            }
+            slot &s = slots[target];
+            s.key = key;
+            s.value = value;
+            s.hash = hash;
+            s.used = true;
+            s.referenced = false;
+            index[pos] = target;
+            ++size_;
+        }
+
+        void remove( const Key &key ) {
+            const int32_t found = find_slot( key );
+            if( found >= 0 ) {
+                erase_slot( found );
+            }
+        }
+
+        size_t size() const {
+            return size_;
+        }
+        size_t capacity() const {
+            return capacity_;
+        }
+        /** Counts of this cache alone. */
+        const cache_stats &stats() const {
+            return stats_;
+        }
+
+        /** Drops every entry but keeps the arrays. */
+        void clear() {
+            if( index.empty() ) {
+                return;
+            }
+            std::fill( index.begin(), index.end(), -1 );
+            free_slots.clear();
+            for( size_t i = capacity_; i-- > 0; ) {
+                slots[i] = slot();
+                free_slots.push_back( static_cast<int32_t>( i ) );
+            }
+            size_ = 0;
+            hand = 0;
+        }
+
+    private:
+        struct slot {
+            Key key{};
+            Value value{};
+            size_t hash = 0;
+            bool used = false;
+            bool referenced = false;
+        };
+
+        static void count( uint64_t &own, std::atomic<uint64_t> *named ) {
+            ++own;
+            if( named ) {
+                named->fetch_add( 1, std::memory_order_relaxed );
+            }
+        }
+
+        size_t bucket_of( size_t hash ) const {
+            // Fibonacci hashing, identity hashes of nearby keys end up spread over the index.
+            return static_cast<size_t>( ( static_cast<uint64_t>( hash ) * 0x9E3779B97F4A7C15ULL ) >>
+                                        index_shift );
+        }
+
+        void allocate() {
+            size_t buckets = 2;
+            index_shift = 63;
+            // At most half full, so probes stay short.
+            while( buckets < capacity_ * 2 ) {
+                buckets *= 2;
+                --index_shift;
+            }
+            mask = buckets - 1;
+            index.assign( buckets, -1 );
+            slots.resize( capacity_ );
+            clear();
+        }
+
+        int32_t find_slot( const Key &key ) const {
+            if( index.empty() || size_ == 0 ) {
+                return -1;
+            }
+            const size_t hash = Hash()( key );
+            for( size_t pos = bucket_of( hash ); index[pos] >= 0; pos = ( pos + 1 ) & mask ) {
+                const slot &s = slots[index[pos]];
+                if( s.hash == hash && s.key == key ) {
+                    return index[pos];
+                }
+            }
+            return -1;
+        }
+
+        template<typename OnEvict>
+        int32_t evict( OnEvict &&on_evict ) {
+            while( slots[hand].referenced ) {
+                slots[hand].referenced = false;
+                hand = ( hand + 1 ) % capacity_;
+            }
+            const int32_t victim = static_cast<int32_t>( hand );
+            hand = ( hand + 1 ) % capacity_;
+            count( stats_.evictions, shared ? &shared->evictions : nullptr );
+            on_evict( slots[victim].key, slots[victim].value );
+            erase_slot( victim );
+            free_slots.pop_back();
+            return victim;
+        }
+
+        void erase_slot( int32_t victim ) {
+            size_t hole = bucket_of( slots[victim].hash );
+            while( index[hole] != victim ) {
+                hole = ( hole + 1 ) & mask;
+            }
+            // Backward shift deletion: pull later entries of the probe run into the hole, unless
+            // that would put them before their own bucket.
+            for( size_t next = ( hole + 1 ) & mask; index[next] >= 0; next = ( next + 1 ) & mask ) {
+                const size_t ideal = bucket_of( slots[index[next]].hash );
+                if( ( ( next - ideal ) & mask ) >= ( ( next - hole ) & mask ) ) {
+                    index[hole] = index[next];
+                    hole = next;
+                }
+            }
+            index[hole] = -1;
+            slots[victim] = slot();
+            free_slots.push_back( victim );
+            --size_;
+        }
+
+        size_t capacity_;
+        cache_counters::counters *shared;
+        mutable std::vector<slot> slots;
+        std::vector<int32_t> index;
+        std::vector<int32_t> free_slots;
+        size_t mask = 0;
+        int index_shift = 0;
+        size_t size_ = 0;
+        size_t hand = 0;
+        mutable cache_stats stats_;
+};
+
+/**
+ * A @ref flat_lru_cache split into @p Shards parts with a lock each, for caches that worker
+ * threads read and fill. Keys are spread over the shards by hash, so threads working on
+ * different keys rarely wait on each other. Values are returned by copy.
+ */
+template<typename Key, typename Value, size_t Shards = 16, typename Hash = std::hash<Key>>
+class sharded_lru_cache
+{
+        static_assert( Shards > 0 && ( Shards & ( Shards - 1 ) ) == 0, "Shards must be a power of two" );
+    public:
+        explicit sharded_lru_cache( size_t capacity, std::string_view name = {} ) {
+            for( size_t i = 0; i < Shards; ++i ) {
+                shards[i].cache = std::make_unique<cache_t>( ( capacity + Shards - 1 ) / Shards, name );
+            }
+        }
+
+        Value get( const Key &key, const Value &default_ ) const {
+            shard &s = shard_of( key );
+            std::lock_guard<std::mutex> lock( s.mutex );
+            return s.cache->get( key, default_ );
+        }
+        void insert( const Key &key, const Value &value ) {
+            shard &s = shard_of( key );
+            std::lock_guard<std::mutex> lock( s.mutex );
+            s.cache->insert( key, value );
+        }
+        void remove( const Key &key ) {
+            shard &s = shard_of( key );
+            std::lock_guard<std::mutex> lock( s.mutex );
+            s.cache->remove( key );
+        }
+        void clear() {
+            for( shard &s : shards ) {
+                std::lock_guard<std::mutex> lock( s.mutex );
+                s.cache->clear();
+            }
+        }
+        size_t size() const {
+            size_t total = 0;
+            for( shard &s : shards ) {
+                std::lock_guard<std::mutex> lock( s.mutex );
+                total += s.cache->size();
+            }
+            return total;
+        }
+        cache_stats stats() const {
+            cache_stats total;
+            for( shard &s : shards ) {
+                std::lock_guard<std::mutex> lock( s.mutex );
+                total.hits += s.cache->stats().hits;
+                total.misses += s.cache->stats().misses;
+                total.evictions += s.cache->stats().evictions;
+            }
+            return total;
+        }
+
+    private:
+        using cache_t = flat_lru_cache<Key, Value, Hash>;
+        struct shard {
+            std::mutex mutex;
+            std::unique_ptr<cache_t> cache;
+        };
+
+        shard &shard_of( const Key &key ) const {
+            // Bits the shard's own index doesn't look at first.
+            const uint64_t mixed = static_cast<uint64_t>( Hash()( key ) ) * 0xC2B2AE3D27D4EB4FULL;
+            return shards[( mixed >> 29 ) & ( Shards - 1 )];
+        }
+
+        mutable std::array<shard, Shards> shards;
+};
+
+#endif // CATA_SRC_FLAT_LRU_CACHE_H
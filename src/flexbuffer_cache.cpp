@@ -1,5 +1,6 @@
 #include "flexbuffer_cache.h"
 
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
@@ -20,14 +21,34 @@
 #include <flatbuffers/idl.h>
 
 #include "cata_utility.h"
+#include "hash_utils.h"
 #include "filesystem.h"
 #include "json.h"
+#include "memory_report.h"
 #include "mmap_file.h"
 #include "options.h"
 
 namespace
 {
 
+// Flexbuffers alive anywhere, parsed on any thread, for the memory report.
+struct live_buffers {
+    std::atomic<size_t> count{ 0 };
+    std::atomic<size_t> bytes{ 0 };
+
+    void add( size_t size ) {
+        count.fetch_add( 1, std::memory_order_relaxed );
+        bytes.fetch_add( size, std::memory_order_relaxed );
+    }
+    void remove( size_t size ) {
+        count.fetch_sub( 1, std::memory_order_relaxed );
+        bytes.fetch_sub( size, std::memory_order_relaxed );
+    }
+};
+
+live_buffers heap_buffers;
+live_buffers mapped_buffers;
+
 void try_find_and_throw_json_error( TextJsonValue &jv )
 {
     if( jv.test_object() ) {
@@ -133,7 +154,12 @@ std::vector<uint8_t> parse_json_to_flexbuffer_(
 struct flexbuffer_vector_storage : flexbuffer_storage {
     std::vector<uint8_t> buffer_;
 
-    explicit flexbuffer_vector_storage( std::vector<uint8_t> &&buffer ) : buffer_{ std::move( buffer ) } {}
+    explicit flexbuffer_vector_storage( std::vector<uint8_t> &&buffer ) : buffer_{ std::move( buffer ) } {
+        heap_buffers.add( buffer_.capacity() );
+    }
+    ~flexbuffer_vector_storage() override {
+        heap_buffers.remove( buffer_.capacity() );
+    }
 
     const uint8_t *data() const override {
         return buffer_.data();
@@ -147,7 +173,12 @@ struct flexbuffer_vector_storage : flexbuffer_storage {
 struct flexbuffer_mmap_storage : flexbuffer_storage {
     std::shared_ptr<const mmap_file> mmap_handle_;
 
-    explicit flexbuffer_mmap_storage( std::shared_ptr<const mmap_file> mmap_handle ) : mmap_handle_{ std::move( mmap_handle ) } {}
+    explicit flexbuffer_mmap_storage( std::shared_ptr<const mmap_file> mmap_handle ) : mmap_handle_{ std::move( mmap_handle ) } {
+        mapped_buffers.add( mmap_handle_->len() );
+    }
+    ~flexbuffer_mmap_storage() override {
+        mapped_buffers.remove( mmap_handle_->len() );
+    }
 
     const uint8_t *data() const override {
         return static_cast<const uint8_t *>( mmap_handle_->base() );
@@ -157,6 +188,28 @@ struct flexbuffer_mmap_storage : flexbuffer_storage {
     }
 };
 
+// One flexbuffer out of a mapped flexbuffer_snapshot.
+struct flexbuffer_slice_storage : flexbuffer_storage {
+    std::shared_ptr<const mmap_file> mmap_handle_;
+    size_t offset_;
+    size_t len_;
+
+    flexbuffer_slice_storage( std::shared_ptr<const mmap_file> mmap_handle, size_t offset,
+                              size_t len ) : mmap_handle_{ std::move( mmap_handle ) }, offset_{ offset }, len_{ len } {
+        mapped_buffers.add( len_ );
+    }
+    ~flexbuffer_slice_storage() override {
+        mapped_buffers.remove( len_ );
+    }
+
+    const uint8_t *data() const override {
+        return static_cast<const uint8_t *>( mmap_handle_->base() ) + offset_;
+    }
+    size_t size() const override {
+        return len_;
+    }
+};
+
 parsed_flexbuffer::parsed_flexbuffer( std::shared_ptr<flexbuffer_storage> storage )
     : storage_{ std::move( storage ) }
 {
@@ -400,6 +453,10 @@ class flexbuffer_disk_cache
             return true;
         }
 
+        const std::filesystem::path &cache_path() const {
+            return cache_path_;
+        }
+
     private:
         explicit flexbuffer_disk_cache( std::filesystem::path cache_path,
                                         std::filesystem::path root_path ) : cache_path_{ std::move( cache_path ) },
@@ -456,7 +513,16 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse( std::filesystem::pat
 std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
     std::filesystem::path lexically_normal_json_source_path, size_t offset )
 {
+    if( shared_flexbuffer cached = find_cached( lexically_normal_json_source_path, offset ) ) {
+        return cached;
+    }
+    std::vector<uint8_t> fb = parse_to_flexbuffer( lexically_normal_json_source_path, offset );
+    return cache_parsed( std::move( lexically_normal_json_source_path ), std::move( fb ), offset );
+}
 
+std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::find_cached(
+    const std::filesystem::path &lexically_normal_json_source_path, size_t offset )
+{
     // Is our cache potentially stale?
     if( disk_cache_ ) {
         std::shared_ptr<flexbuffer_mmap_storage> cached_storage = disk_cache_->load_flexbuffer_if_not_stale(
@@ -468,10 +534,15 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
             ( void )ec;
 
             return std::make_shared<file_flexbuffer>( std::move( cached_storage ),
-                    std::move( lexically_normal_json_source_path ), mtime, offset );
+                    std::filesystem::path( lexically_normal_json_source_path ), mtime, offset );
         }
     }
+    return nullptr;
+}
 
+std::vector<uint8_t> flexbuffer_cache::parse_to_flexbuffer(
+    const std::filesystem::path &lexically_normal_json_source_path, size_t offset )
+{
     std::string json_source_path_string = lexically_normal_json_source_path.generic_u8string();
     std::optional<std::string> json_file_contents = read_whole_file(
                 lexically_normal_json_source_path );
@@ -481,8 +552,12 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
     std::string &json_source = *json_file_contents;
 
     const char *json_text = reinterpret_cast<const char *>( json_source.c_str() ) + offset;
-    std::vector<uint8_t> fb = parse_json_to_flexbuffer_( json_text, json_source_path_string.c_str() );
+    return parse_json_to_flexbuffer_( json_text, json_source_path_string.c_str() );
+}
 
+std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::cache_parsed(
+    std::filesystem::path lexically_normal_json_source_path, std::vector<uint8_t> fb, size_t offset )
+{
     if( disk_cache_ ) {
         disk_cache_->save_to_disk( lexically_normal_json_source_path, fb );
     }
@@ -501,6 +576,172 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
             mtime, offset );
 }
 
+std::filesystem::path flexbuffer_cache::snapshot_path( const std::string &name ) const
+{
+    if( !disk_cache_ ) {
+        return {};
+    }
+    std::array<char, 17> hex;
+    snprintf( hex.data(), hex.size(), "%016llx",
+              static_cast<unsigned long long>( std::hash<std::string>()( name ) ) );
+    return disk_cache_->cache_path() / "snapshots" / ( std::string( hex.data() ) + ".fbs" );
+}
+
+namespace
+{
+
+// Snapshot layout, in native byte order since it never leaves this machine:
+// magic, key, entry count, table offset, then the flexbuffers each starting at a multiple of
+// snapshot_alignment, then { offset, length, source mtime in ms } for each entry.
+constexpr uint64_t snapshot_magic = 0x31534246'41544143ULL; // "CATAFBS1"
+constexpr size_t snapshot_header_words = 4;
+constexpr size_t snapshot_entry_words = 3;
+constexpr uint64_t snapshot_alignment = 16;
+
+int64_t mtime_to_millis( std::filesystem::file_time_type mtime )
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>( mtime.time_since_epoch() ).count();
+}
+
+} // namespace
+
+uint64_t flexbuffer_snapshot::key_for( const std::vector<std::filesystem::path>
+                                       &lexically_normal_paths )
+{
+    std::size_t key = lexically_normal_paths.size();
+    for( const std::filesystem::path &path : lexically_normal_paths ) {
+        std::error_code ec;
+        const std::filesystem::file_time_type mtime = get_file_mtime_millis( path, ec );
+        const uintmax_t size = ec ? 0 : std::filesystem::file_size( path, ec );
+        if( ec ) {
+            return 0;
+        }
+        cata::hash_combine( key, path.generic_u8string() );
+        cata::hash_combine( key, size );
+        cata::hash_combine( key, mtime_to_millis( mtime ) );
+    }
+    // 0 means no key.
+    return key == 0 ? 1 : key;
+}
+
+std::optional<flexbuffer_snapshot> flexbuffer_snapshot::open( const std::filesystem::path &path,
+        uint64_t key )
+{
+    if( !file_exist( path ) ) {
+        return std::nullopt;
+    }
+    std::shared_ptr<const mmap_file> file = mmap_file::map_file( path );
+    if( !file || file->len() < snapshot_header_words * sizeof( uint64_t ) ) {
+        return std::nullopt;
+    }
+    std::array<uint64_t, snapshot_header_words> header;
+    memcpy( header.data(), file->base(), sizeof( header ) );
+    const uint64_t count = header[2];
+    const uint64_t table_offset = header[3];
+    if( header[0] != snapshot_magic || header[1] != key || table_offset > file->len() ||
+        ( file->len() - table_offset ) / ( snapshot_entry_words * sizeof( uint64_t ) ) != count ) {
+        return std::nullopt;
+    }
+
+    flexbuffer_snapshot ret;
+    const char *table = static_cast<const char *>( file->base() ) + table_offset;
+    for( uint64_t i = 0; i < count; ++i ) {
+        std::array<uint64_t, snapshot_entry_words> words;
+        memcpy( words.data(), table + i * sizeof( words ), sizeof( words ) );
+        if( words[0] > table_offset || words[1] > table_offset - words[0] ) {
+            return std::nullopt;
+        }
+        ret.entries_.push_back( entry{ words[0], words[1], std::filesystem::file_time_type(
+                                           std::chrono::milliseconds( static_cast<int64_t>( words[2] ) ) ) } );
+    }
+    ret.file_ = std::move( file );
+    return ret;
+}
+
+std::shared_ptr<parsed_flexbuffer> flexbuffer_snapshot::get( size_t i,
+        std::filesystem::path lexically_normal_json_source_path ) const
+{
+    const entry &e = entries_[i];
+    auto storage = std::make_shared<flexbuffer_slice_storage>( file_, e.offset, e.len );
+    return std::make_shared<file_flexbuffer>( std::move( storage ),
+            std::move( lexically_normal_json_source_path ), e.mtime, 0 );
+}
+
+flexbuffer_snapshot::writer::writer( std::filesystem::path path, uint64_t key )
+    : path_{ std::move( path ) }
+{
+    tmp_path_ = path_;
+    tmp_path_ += std::filesystem::u8path( ".tmp" );
+    if( !assure_dir_exist( path_.parent_path() ) ) {
+        return;
+    }
+    out_.open( tmp_path_, std::ofstream::binary | std::ofstream::trunc );
+    const std::array<uint64_t, snapshot_header_words> header{ 0, key, 0, 0 };
+    out_.write( reinterpret_cast<const char *>( header.data() ), sizeof( header ) );
+    offset_ = sizeof( header );
+}
+
+flexbuffer_snapshot::writer::~writer()
+{
+    if( !finished_ ) {
+        out_.close();
+        remove_file( tmp_path_ );
+    }
+}
+
+void flexbuffer_snapshot::writer::add( const parsed_flexbuffer &buffer,
+                                       const std::filesystem::path &lexically_normal_json_source_path )
+{
+    std::error_code ec;
+    const std::filesystem::file_time_type mtime = get_file_mtime_millis(
+                lexically_normal_json_source_path, ec );
+    if( ec ) {
+        out_.setstate( std::ios_base::failbit );
+    }
+    if( !out_.good() ) {
+        return;
+    }
+    const std::array<char, snapshot_alignment> padding{};
+    const uint64_t pad = ( snapshot_alignment - offset_ % snapshot_alignment ) % snapshot_alignment;
+    out_.write( padding.data(), pad );
+    offset_ += pad;
+    const flexbuffer_storage &storage = *buffer.get_storage();
+    out_.write( reinterpret_cast<const char *>( storage.data() ), storage.size() );
+    table_.push_back( offset_ );
+    table_.push_back( storage.size() );
+    table_.push_back( mtime_to_millis( mtime ) );
+    offset_ += storage.size();
+}
+
+bool flexbuffer_snapshot::writer::finish()
+{
+    if( !out_.good() ) {
+        return false;
+    }
+    const uint64_t table_offset = offset_;
+    out_.write( reinterpret_cast<const char *>( table_.data() ), table_.size() * sizeof( uint64_t ) );
+    const std::array<uint64_t, 2> counts{ table_.size() / snapshot_entry_words, table_offset };
+    out_.seekp( 2 * sizeof( uint64_t ) );
+    out_.write( reinterpret_cast<const char *>( counts.data() ), sizeof( counts ) );
+    // The magic goes in last, so a snapshot that wasn't finished is never taken for one.
+    out_.seekp( 0 );
+    out_.write( reinterpret_cast<const char *>( &snapshot_magic ), sizeof( snapshot_magic ) );
+    out_.close();
+    if( out_.fail() ) {
+        return false;
+    }
+    finished_ = rename_file( tmp_path_, path_ );
+    return finished_;
+}
+
+void flexbuffer_cache::add_memory_usage( memory_report::report &out )
+{
+    out.add( "flexbuffers", heap_buffers.count.load( std::memory_order_relaxed ),
+             heap_buffers.bytes.load( std::memory_order_relaxed ) );
+    out.add( "flexbuffers_mapped", mapped_buffers.count.load( std::memory_order_relaxed ),
+             mapped_buffers.bytes.load( std::memory_order_relaxed ) );
+}
+
 std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_buffer( std::string buffer )
 {
     std::vector<uint8_t> fb = parse_json_to_flexbuffer_( buffer.c_str(), nullptr );
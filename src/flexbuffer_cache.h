@@ -2,13 +2,22 @@
 #ifndef CATA_SRC_FLEXBUFFER_CACHE_H
 #define CATA_SRC_FLEXBUFFER_CACHE_H
 
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <iosfwd>
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <flatbuffers/flexbuffers.h>
 
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 
 struct flexbuffer_storage {
     virtual ~flexbuffer_storage() = default;
@@ -45,6 +54,7 @@ struct parsed_flexbuffer {
 };
 
 class flexbuffer_disk_cache;
+class mmap_file;
 struct flexbuffer_storage;
 
 class flexbuffer_cache
@@ -62,8 +72,26 @@ class flexbuffer_cache
         shared_flexbuffer parse_and_cache( std::filesystem::path lexically_normal_json_source_path,
                                            size_t offset = 0 ) noexcept( false ) ;
 
+        // parse_and_cache in three steps, so that the parsing in the middle can run on another
+        // thread. The other two touch the disk cache and must stay on the thread that owns it.
+        // Returns nullptr if there is no up to date flexbuffer cached on disk.
+        shared_flexbuffer find_cached( const std::filesystem::path &lexically_normal_json_source_path,
+                                       size_t offset = 0 );
+        // Throw exceptions on IO and parse errors. Safe to call from any thread.
+        static std::vector<uint8_t> parse_to_flexbuffer(
+            const std::filesystem::path &lexically_normal_json_source_path,
+            size_t offset = 0 ) noexcept( false );
+        shared_flexbuffer cache_parsed( std::filesystem::path lexically_normal_json_source_path,
+                                        std::vector<uint8_t> fb, size_t offset = 0 );
+
+        // Where the flexbuffer_snapshot called name lives, or empty if this cache has no disk cache.
+        std::filesystem::path snapshot_path( const std::string &name ) const;
+
         static shared_flexbuffer parse_buffer( std::string buffer ) noexcept( false );
 
+        // Adds the flexbuffers still alive, parsed into memory or mapped from the disk cache.
+        static void add_memory_usage( memory_report::report &out );
+
     private:
         flexbuffer_cache( flexbuffer_cache && ) noexcept = default;
 
@@ -73,4 +101,59 @@ class flexbuffer_cache
         std::unique_ptr<flexbuffer_disk_cache> disk_cache_;
 };
 
+// The flexbuffers of a whole list of json files in a single file, so that loading the same
+// files again maps one file instead of opening and mapping each of them.
+// Keyed on the files' paths, sizes and modification times, any change to them makes it stale.
+class flexbuffer_snapshot
+{
+        using shared_flexbuffer = std::shared_ptr<parsed_flexbuffer>;
+
+    public:
+        // Key for the given files in this order, or 0 if any of them can't be examined.
+        static uint64_t key_for( const std::vector<std::filesystem::path> &lexically_normal_paths );
+
+        // Opens the snapshot at path if it was written for key. Returns std::nullopt otherwise.
+        static std::optional<flexbuffer_snapshot> open( const std::filesystem::path &path,
+                uint64_t key );
+
+        size_t size() const {
+            return entries_.size();
+        }
+
+        // The flexbuffer of the i-th file the snapshot was written for.
+        shared_flexbuffer get( size_t i, std::filesystem::path lexically_normal_json_source_path ) const;
+
+        // Writes a snapshot as the flexbuffers come in, in the order of the files it was keyed on.
+        // Nothing is written to path unless finish() succeeds.
+        class writer
+        {
+            public:
+                writer( std::filesystem::path path, uint64_t key );
+                ~writer();
+                writer( const writer & ) = delete;
+                writer &operator=( const writer & ) = delete;
+
+                void add( const parsed_flexbuffer &buffer,
+                          const std::filesystem::path &lexically_normal_json_source_path );
+                bool finish();
+
+            private:
+                std::filesystem::path path_;
+                std::filesystem::path tmp_path_;
+                std::ofstream out_;
+                std::vector<uint64_t> table_;
+                uint64_t offset_ = 0;
+                bool finished_ = false;
+        };
+
+    private:
+        struct entry {
+            uint64_t offset;
+            uint64_t len;
+            std::filesystem::file_time_type mtime;
+        };
+        std::shared_ptr<const mmap_file> file_;
+        std::vector<entry> entries_;
+};
+
 #endif // CATA_SRC_FLEXBUFFER_CACHE_H
@@ -836,7 +836,7 @@ template<typename T, typename std::enable_if_t<std::is_convertible_v<T, std::str
 std::string JsonObject::get_string( const char *key, T &&fallback ) const
 {
     size_t idx = 0;
-    bool found = find_map_key_idx( key, keys_, idx );
+    bool found = find_key_idx( key, idx );
     if( found ) {
         return get_string( key );
     }
@@ -969,7 +969,7 @@ inline std::set<std::string> JsonObject::get_as_string_set( const std::string &n
 inline bool JsonObject::has_member( const std::string_view key ) const
 {
     size_t idx;
-    return find_map_key_idx( key, keys_, idx );
+    return find_key_idx( key, idx );
 }
 
 inline bool JsonObject::has_null( const std::string_view key ) const
@@ -1052,7 +1052,7 @@ inline bool JsonObject::get_bool( const std::string_view key, bool fallback ) co
 inline std::optional<JsonValue> JsonObject::get_member_opt( const std::string_view key ) const
 {
     size_t idx = 0;
-    bool found = find_map_key_idx( key, keys_, idx );
+    bool found = find_key_idx( key, idx );
     if( found ) {
         mark_visited( idx );
         return JsonValue{ root_, values_[ idx ], &path_, idx };
@@ -1066,7 +1066,7 @@ inline JsonValue JsonObject::get_member( const std::string_view key ) const
     // flexbuffers::Map::operator[] will probably be faster but won't give us the idx,
     // which we need to track visited fields.
     size_t idx = 0;
-    bool found = find_map_key_idx( key, keys_, idx );
+    bool found = find_key_idx( key, idx );
     if( found ) {
         mark_visited( idx );
         return JsonValue{ root_, values_[ idx ], &path_, idx };
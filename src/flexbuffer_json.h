@@ -540,6 +540,9 @@ class JsonObject : JsonWithPath
         flexbuffers::TypedVector keys_ = flexbuffers::TypedVector::EmptyTypedVector();
         flexbuffers::Vector values_ = flexbuffers::Vector::EmptyVector();
         mutable tiny_bitset visited_fields_bitset_;
+        // The key of the member found last and its index, the key points into our flexbuffer.
+        mutable std::string_view last_found_key_;
+        mutable size_t last_found_idx_ = 0;
 
         static const auto &empty_object_() {
             // NOLINTNEXTLINE(cata-almost-never-auto)
@@ -594,6 +597,7 @@ class JsonObject : JsonWithPath
             flexbuffers::Map json_map = json.AsMap();
             keys_ = json_map.Keys();
             values_ = json_map.Values();
+            last_found_key_ = std::string_view();
             if( moved_visited_fields ) {
                 using namespace std;
                 swap( visited_fields_bitset_, *moved_visited_fields );
@@ -697,16 +701,31 @@ class JsonObject : JsonWithPath
         // NOLINTNEXTLINE(cata-large-inline-function)
         flexbuffers::Reference find_value_ref( const std::string_view key ) const {
             size_t idx = 0;
-            bool found = find_map_key_idx( key, keys_, idx );
+            bool found = find_key_idx( key, idx );
             if( found ) {
                 return values_[ idx ];
             }
             return flexbuffers::Reference();
         }
 
+        // Loaders mostly test for a member right before reading it, or read the same member
+        // through several accessors, so remember the last hit and skip the search for it.
+        // NOLINTNEXTLINE(cata-large-inline-function)
+        bool find_key_idx( const std::string_view key, size_t &idx ) const {
+            if( last_found_key_.data() != nullptr && last_found_key_ == key ) {
+                idx = last_found_idx_;
+                return true;
+            }
+            if( !find_map_key_idx( key, keys_, idx, &last_found_key_ ) ) {
+                return false;
+            }
+            last_found_idx_ = idx;
+            return true;
+        }
+
         // NOLINTNEXTLINE(cata-large-inline-function)
         static bool find_map_key_idx( const std::string_view key, const flexbuffers::TypedVector &keys,
-                                      size_t &idx ) {
+                                      size_t &idx, std::string_view *found_key = nullptr ) {
             // Handlrolled binary search because the STL does not provide a version that just uses indexes.
             std::make_signed_t<size_t>low = 0;
             std::make_signed_t<size_t>high = keys.size() - 1;
@@ -718,6 +737,9 @@ class JsonObject : JsonWithPath
 
                 if( res == 0 ) {
                     idx = mid;
+                    if( found_key ) {
+                        *found_key = test_key;
+                    }
                     return true;
                 } else if( res < 0 ) {
                     low = mid + 1;
@@ -171,6 +171,7 @@
 #include "path_info.h"
 #include "pathfinding.h"
 #include "perf.h"
+#include "perf_hud.h"
 #include "pickup.h"
 #include "player_activity.h"
 #include "popup.h"
@@ -1583,35 +1584,14 @@ void game::set_critter_died()
     critter_died = true;
 }
 
-static int maptile_field_intensity( maptile &mt, field_type_id fld )
-{
-    const field_entry *field_ptr = mt.find_field( fld );
-
-    return field_ptr == nullptr ? 0 : field_ptr->get_field_intensity();
-}
-
 units::temperature_delta get_heat_radiation( const tripoint_bub_ms &location )
 {
     units::temperature_delta temp_mod = units::from_kelvin_delta( 0 );
     Character &player_character = get_player_character();
     map &here = get_map();
-    // Convert it to an int id once, instead of 139 times per turn
-    const field_type_id fd_fire_int = fd_fire.id();
-    for( const tripoint_bub_ms &dest : here.points_in_radius( location, 6 ) ) {
-        int heat_intensity = 0;
-
-        maptile mt = here.maptile_at( dest );
-
-        int ffire = maptile_field_intensity( mt, fd_fire_int );
-        if( ffire > 0 ) {
-            heat_intensity = ffire;
-        } else  {
-            heat_intensity = mt.get_ter()->heat_radiation;
-        }
-        if( heat_intensity == 0 ) {
-            // No heat source here
-            continue;
-        }
+    for( const std::pair<tripoint_bub_ms, int> &source : here.heat_sources_near( location, 6 ) ) {
+        const tripoint_bub_ms &dest = source.first;
+        const int heat_intensity = source.second;
         if( player_character.pos_bub() == location ) {
             bool heat_can_spread = true;
             for( const tripoint_bub_ms &p : line_to( player_character.pos_bub(), dest ) ) {
@@ -1638,23 +1618,9 @@ int get_best_fire( const tripoint_bub_ms &location )
     int best_fire = 0;
     Character &player_character = get_player_character();
     map &here = get_map();
-    // Convert it to an int id once, instead of 139 times per turn
-    const field_type_id fd_fire_int = fd_fire.id();
-    for( const tripoint_bub_ms &dest : here.points_in_radius( location, 6 ) ) {
-        int heat_intensity = 0;
-
-        maptile mt = here.maptile_at( dest );
-
-        int ffire = maptile_field_intensity( mt, fd_fire_int );
-        if( ffire > 0 ) {
-            heat_intensity = ffire;
-        } else  {
-            heat_intensity = mt.get_ter()->heat_radiation;
-        }
-        if( heat_intensity == 0 ) {
-            // No heat source here
-            continue;
-        }
+    for( const std::pair<tripoint_bub_ms, int> &source : here.heat_sources_near( location, 6 ) ) {
+        const tripoint_bub_ms &dest = source.first;
+        const int heat_intensity = source.second;
         if( player_character.pos_bub() == location ) {
             if( !here.clear_path( dest, location, -1, 1, 100 ) ) {
                 continue;
@@ -3294,6 +3260,7 @@ void game::draw( ui_adaptor &ui )
         return;
     }
 
+    CATA_TRACE_ZONE( "game::draw" );
     ter_view_p.z() = ( u.pos_bub() + u.view_offset ).z();
     here.build_map_cache( ter_view_p.z() );
     here.update_visibility_cache( ter_view_p.z() );
@@ -10371,6 +10338,15 @@ void game::toggle_debug_hour_timer()
     debug_hour_timer.toggle();
 }
 
+void game::toggle_perf_hud()
+{
+    if( perf_overlay ) {
+        perf_overlay.reset();
+    } else {
+        perf_overlay = std::make_unique<perf_hud>();
+    }
+}
+
 void game::debug_hour_timer::toggle()
 {
     enabled = !enabled;
@@ -84,6 +84,7 @@ class monster;
 class npc;
 class npc_template;
 class overmap;
+class perf_hud;
 class save_t;
 class scenario;
 class scent_map;
@@ -248,8 +249,10 @@ class game
         void unserialize_impl( const JsonObject &data );
     public:
 
-        /** Returns false if saving failed. */
-        bool save();
+        /** Returns false if saving failed.
+         * @param in_background Leave writing the map files to a background thread.
+         */
+        bool save( bool in_background = false );
 
         /** Returns a list of currently active character saves. */
         std::vector<std::string> list_active_saves();
@@ -927,7 +930,7 @@ class game
         void serialize_dimension_data( std::ostream &fout );
         void serialize_master( std::ostream &fout );
         // returns false if saving failed for whatever reason
-        bool save_maps();
+        bool save_maps( bool in_background = false );
 #if defined(__ANDROID__)
         void save_shortcuts( std::ostream &fout );
 #endif
@@ -1118,6 +1121,8 @@ class game
                 bool enabled = false;
                 std::optional<IRLTimeMs> start_time = std::nullopt;
         } debug_hour_timer; // NOLINT(cata-serialize)
+        /** Drawn over the game while set, see @ref toggle_perf_hud. */
+        std::unique_ptr<perf_hud> perf_overlay; // NOLINT(cata-serialize)
 
         /**
          * Checks if there's a hostile creature within given distance.
@@ -1211,6 +1216,8 @@ class game
         bool display_overlay_state( action_id );
         // toggles the timing of in-game hours
         void toggle_debug_hour_timer();
+        /** Shows or hides the per-turn performance overlay. */
+        void toggle_perf_hud();
         /** Creature for which to display the visibility map */
         Creature *displaying_visibility_creature; // NOLINT(cata-serialize)
         /** Type of lighting condition overlay to display */
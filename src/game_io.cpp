@@ -318,6 +318,7 @@ bool game::load( const std::string &world )
 
 bool game::load( const save_t &name )
 {
+    CATA_TRACE_ZONE( "game::load" );
     map &here = get_map();
 
     const cata_path worldpath = PATH_INFO::world_base_save_path();
@@ -574,14 +575,14 @@ bool game::save_dimension_data()
         serialize_dimension_data( fout );
     }, _( "dimension data" ) );
 }
-bool game::save_maps()
+bool game::save_maps( bool in_background )
 {
     map &here = get_map();
 
     try {
         here.save();
         overmap_buffer.save(); // can throw
-        MAPBUFFER.save(); // can throw
+        MAPBUFFER.save( false, in_background ); // can throw
         return true;
     } catch( const std::exception &err ) {
         popup( _( "Failed to save the maps: %s" ), err.what() );
@@ -722,8 +723,9 @@ bool game::save_external_options_record()
     return saved_externals;
 }
 
-bool game::save()
+bool game::save( bool in_background )
 {
+    CATA_TRACE_ZONE( "game::save" );
     if( save_is_dirty ) {
         popup( _( "The game is in an unsupported state after using debug tools and cannot be saved." ) );
         return false;
@@ -739,7 +741,7 @@ bool game::save()
             !save_factions_missions_npcs() ||
             !save_external_options_record() ||
             !save_dimension_data() ||
-            !save_maps() ||
+            !save_maps( in_background ) ||
             !get_auto_pickup().save_character() ||
             !get_auto_notes_settings().save( true ) ||
             !get_safemode().save_character() ||
@@ -895,8 +897,8 @@ void game::quicksave()
 
     time_t now = std::time( nullptr ); //timestamp for start of saving procedure
 
-    //perform save
-    save();
+    //perform save, the map files are written while the game goes on
+    save( true );
     //Now reset counters for autosaving, so we don't immediately autosave after a quicksave or autosave.
     moves_since_last_save = 0;
     last_save_timestamp = now;
@@ -412,7 +412,7 @@ class generic_factory
 
         /** Finalize all entries (derived classes should chain to this method) */
         virtual void finalize() {
-            DynamicDataLoader::get_instance().load_deferred( deferred );
+            DynamicDataLoader::get_instance().load_deferred( deferred, id_member_name );
             abstracts.clear();
 
             inc_version();
@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_GLOBAL_VARS_H
 #define CATA_SRC_GLOBAL_VARS_H
 
+#include <cstdint>
+
 #include "math_parser_diag_value.h"
 
 #include "json.h"
@@ -11,6 +13,13 @@ class global_variables
     public:
         using impl_t = std::unordered_map<std::string, diag_value>;
 
+        global_variables() = default;
+        global_variables( const global_variables & ) = delete;
+        global_variables &operator=( const global_variables & ) = delete;
+        ~global_variables() {
+            ++generation;
+        }
+
         // Methods for setting/getting misc key/value pairs.
         void set_global_value( const std::string &key, diag_value value ) {
             global_values[ key ] = std::move( value );
@@ -23,6 +32,7 @@ class global_variables
 
         void remove_global_value( const std::string &key ) {
             global_values.erase( key );
+            ++generation;
         }
 
         diag_value const *maybe_get_global_value( const std::string &key ) const {
@@ -45,6 +55,8 @@ class global_variables
         }
 
         impl_t &get_global_values() {
+            // The caller may erase entries
+            ++generation;
             return global_values;
         }
 
@@ -54,10 +66,20 @@ class global_variables
 
         void clear_global_values() {
             global_values.clear();
+            ++generation;
         }
 
         void set_global_values( impl_t input ) {
             global_values = std::move( input );
+            ++generation;
+        }
+
+        /**
+         * Changes whenever a pointer returned by @ref maybe_get_global_value may have gone
+         * stale. Adding or overwriting values doesn't change it, as map nodes stay put.
+         */
+        static uint64_t get_generation() {
+            return generation;
         }
         void unserialize( const JsonObject &jo );
         void serialize( JsonOut &jsout ) const;
@@ -67,6 +89,7 @@ class global_variables
 
     private:
         impl_t global_values;
+        static inline uint64_t generation = 1;
 };
 global_variables &get_globals();
 
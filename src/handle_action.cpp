@@ -49,6 +49,7 @@
 #include "gates.h"
 #include "gun_mode.h"
 #include "help.h"
+#include "input.h"
 #include "input_context.h"
 #include "input_enums.h"
 #include "input_popup.h"
@@ -426,7 +427,15 @@ input_context game::get_player_input( std::string &action )
                 g->invalidate_main_ui_adaptor();
             }
 
-            ui_manager::redraw_invalidated();
+            // Holding a key queues actions faster than the screen can show them. Don't draw
+            // a frame the queued key replaces at once, but still draw a few times a second.
+            static std::chrono::steady_clock::time_point last_redraw;
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if( now - last_redraw >= std::chrono::milliseconds( 100 ) ||
+                !inp_mngr.has_pending_key_input() ) {
+                ui_manager::redraw_invalidated();
+                last_redraw = now;
+            }
         } while( handle_mouseview( ctxt, action ) && uquit != QUIT_WATCH
                  && ( action != "TIMEOUT" || !current_turn.has_timeout_elapsed() ) );
         ctxt.reset_timeout();
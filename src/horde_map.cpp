@@ -1,5 +1,7 @@
 #include "horde_map.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -7,75 +9,74 @@
 
 #include "debug.h"
 #include "map_scale_constants.h"
+#include "memory_report.h"
 #include "monster.h"
 #include "mtype.h"
 
 static const species_id species_FERAL( "FERAL" );
 static const species_id species_ZOMBIE( "ZOMBIE" );
 
+// Indexes into horde_map::horde_chunk::flavors, matching the bits of horde_map_flavors.
+static constexpr int active_flavor = 0;
+static constexpr int idle_flavor = 1;
+static constexpr int dormant_flavor = 2;
+static constexpr int immobile_flavor = 3;
+static constexpr int num_flavors = 4;
+
+// Submap offsets within an overmap fit in 9 bits per horizontal axis, each gets a 10 bit field
+// with a bit to spare. The z-level gets 5.
+static uint32_t pack_chunk_key( const tripoint_om_sm &p )
+{
+    return ( static_cast<uint32_t>( p.x() ) & 0x3ff ) << 15 |
+           ( static_cast<uint32_t>( p.y() ) & 0x3ff ) << 5 |
+           ( static_cast<uint32_t>( p.z() + OVERMAP_DEPTH ) & 0x1f );
+}
+
+static tripoint_om_sm unpack_chunk_key( uint32_t key )
+{
+    return tripoint_om_sm( static_cast<int>( key >> 15 & 0x3ff ), static_cast<int>( key >> 5 & 0x3ff ),
+                           static_cast<int>( key & 0x1f ) - OVERMAP_DEPTH );
+}
+
+bool horde_map::horde_chunk::empty() const
+{
+    for( const entity_map &flavor : flavors ) {
+        if( !flavor.empty() ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+horde_map::horde_chunk *horde_map::chunk_at( const tripoint_om_sm &p )
+{
+    map_type::iterator iter = chunks.find( pack_chunk_key( p ) );
+    return iter == chunks.end() ? nullptr : &iter->second;
+}
+
 // Is just entity enough or do we need to wrap it in a tuple with a coordinate?
 // Or worse an iterator?
 horde_entity *horde_map::entity_at( const tripoint_om_ms &p )
 {
-    tripoint_om_sm submap_offset = project_to<coords::sm>( p );
+    horde_chunk *chunk = chunk_at( project_to<coords::sm>( p ) );
+    if( chunk == nullptr ) {
+        return nullptr;
+    }
     // TODO reconsider pruning p down to tripoint_om_ms in the first place.
     tripoint_abs_ms entity_loc = project_combine( location, p );
-    std::unordered_map<tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>>::iterator
-            active_monster_submap = active_monster_map.find( submap_offset );
-    bool active_map_exists = active_monster_submap != active_monster_map.end() &&
-                             !active_monster_submap->second.empty();
-    if( active_map_exists ) {
-        std::unordered_map<tripoint_abs_ms, horde_entity>::iterator iter =
-            active_monster_submap->second.find( entity_loc );
-        if( iter != active_monster_submap->second.end() ) {
+    for( entity_map &flavor : chunk->flavors ) {
+        entity_map::iterator iter = flavor.find( entity_loc );
+        if( iter != flavor.end() ) {
             return &iter->second;
         }
     }
-    std::unordered_map<tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>>::iterator
-            idle_monster_submap = idle_monster_map.find( submap_offset );
-    bool idle_map_exists = idle_monster_submap != idle_monster_map.end() &&
-                           !idle_monster_submap->second.empty();
-    if( idle_map_exists ) {
-        std::unordered_map<tripoint_abs_ms, horde_entity>::iterator iter =
-            idle_monster_submap->second.find( entity_loc );
-        if( iter != idle_monster_submap->second.end() ) {
-            return &iter->second;
-        }
-    }
-    std::unordered_map<tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>>::iterator
-            dormant_monster_submap = dormant_monster_map.find( submap_offset );
-    bool dormant_map_exists = dormant_monster_submap != dormant_monster_map.end() &&
-                              !dormant_monster_submap->second.empty();
-    if( dormant_map_exists ) {
-        std::unordered_map<tripoint_abs_ms, horde_entity>::iterator iter =
-            dormant_monster_submap->second.find( entity_loc );
-        if( iter != dormant_monster_submap->second.end() ) {
-            return  &iter->second;
-        }
-    }
-    std::unordered_map<tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>>::iterator
-            immobile_monster_submap = immobile_monster_map.find( submap_offset );
-    bool immobile_map_exists = immobile_monster_submap != immobile_monster_map.end() &&
-                               !immobile_monster_submap->second.empty();
-    if( immobile_map_exists ) {
-        std::unordered_map<tripoint_abs_ms, horde_entity>::iterator iter =
-            immobile_monster_submap->second.find( entity_loc );
-        if( iter != immobile_monster_submap->second.end() ) {
-            return  &iter->second;
-        }
-    }
     return nullptr;
 }
 
-// TODO: if callers want to filter for dormant vs idle vs active, etc we can do it cheaply.
 std::vector < std::unordered_map<tripoint_abs_ms, horde_entity> *> horde_map::entity_group_at(
     const tripoint_om_omt &p, int filter )
 {
-    // TODO: It might be worthwhile to have a single top level map of per-submap containers,
-    // and each entry of that map holds each variant container.
-    // This eliminates multiple top-level lookups.
     std::vector<std::unordered_map<tripoint_abs_ms, horde_entity>*> horde_chunk;
-    // TODO: Find all 4 submaps worth of monsters and return them.
     for( int y = 0; y <= 1; ++y ) {
         for( int x = 0; x <= 1; ++x ) {
             tripoint_om_sm target_submap = project_to<coords::sm>( p ) + point{ x, y };
@@ -91,32 +92,13 @@ std::vector<std::unordered_map<tripoint_abs_ms, horde_entity> *> horde_map::enti
     const tripoint_om_sm &p, int filter )
 {
     std::vector<std::unordered_map<tripoint_abs_ms, horde_entity>*> horde_chunk;
-
-    if( filter & horde_map_flavors::active ) {
-        auto active_monster_map_iter = active_monster_map.find( p );
-        if( active_monster_map_iter != active_monster_map.end() ) {
-            horde_chunk.push_back( &active_monster_map_iter->second );
-        }
+    horde_map::horde_chunk *chunk = chunk_at( p );
+    if( chunk == nullptr ) {
+        return horde_chunk;
     }
-
-    if( filter & horde_map_flavors::idle ) {
-        auto idle_monster_map_iter = idle_monster_map.find( p );
-        if( idle_monster_map_iter != idle_monster_map.end() ) {
-            horde_chunk.push_back( &idle_monster_map_iter->second );
-        }
-    }
-
-    if( filter & horde_map_flavors::dormant ) {
-        auto dormant_monster_map_iter = dormant_monster_map.find( p );
-        if( dormant_monster_map_iter != dormant_monster_map.end() ) {
-            horde_chunk.push_back( &dormant_monster_map_iter->second );
-        }
-    }
-
-    if( filter & horde_map_flavors::immobile ) {
-        auto immobile_monster_map_iter = immobile_monster_map.find( p );
-        if( immobile_monster_map_iter != immobile_monster_map.end() ) {
-            horde_chunk.push_back( &immobile_monster_map_iter->second );
+    for( int flavor = 0; flavor < num_flavors; ++flavor ) {
+        if( filter & ( 1 << flavor ) ) {
+            horde_chunk.push_back( &chunk->flavors[flavor] );
         }
     }
     return horde_chunk;
@@ -138,16 +120,15 @@ std::optional<std::unordered_map<tripoint_abs_ms, horde_entity>::iterator> horde
     if( id.is_null() || !id.is_valid() ) {
         return result; // Bail out, blacklisted monster or something's wrong.
     }
-    std::unordered_map <tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>> &target_map =
-                id->has_flag( mon_flag_DORMANT ) ? dormant_monster_map :
-                is_alert( *id ) ? idle_monster_map :
-                immobile_monster_map;
+    const int flavor = id->has_flag( mon_flag_DORMANT ) ? dormant_flavor :
+                       is_alert( *id ) ? idle_flavor :
+                       immobile_flavor;
     point_abs_om omp;
     tripoint_om_sm sm;
     std::tie( omp, sm ) = project_remain<coords::om>( project_to<coords::sm>( p ) );
     bool inserted;
-    // The [] operator creates a nested std::map if not present already.
-    std::tie( result, inserted ) = target_map[sm].emplace( p, id );
+    // The [] operator creates the chunk if not present already.
+    std::tie( result, inserted ) = chunks[pack_chunk_key( sm )].flavors[flavor].emplace( p, id );
     return result;
 }
 
@@ -155,18 +136,17 @@ std::optional<std::unordered_map<tripoint_abs_ms, horde_entity>::iterator> horde
 std::optional<std::unordered_map<tripoint_abs_ms, horde_entity>::iterator> horde_map::spawn_entity(
     const tripoint_abs_ms &p, const monster &mon )
 {
-    std::unordered_map <tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>> &target_map =
-                mon.type->has_flag( mon_flag_DORMANT ) ? dormant_monster_map :
-                !is_alert( *mon.type ) ? immobile_monster_map :
-                ( mon.has_dest() || mon.wandf > 0 ) ? active_monster_map :
-                idle_monster_map;
+    const int flavor = mon.type->has_flag( mon_flag_DORMANT ) ? dormant_flavor :
+                       !is_alert( *mon.type ) ? immobile_flavor :
+                       ( mon.has_dest() || mon.wandf > 0 ) ? active_flavor :
+                       idle_flavor;
     std::optional<std::unordered_map<tripoint_abs_ms, horde_entity>::iterator> result;
     point_abs_om omp;
     tripoint_om_sm sm;
     std::tie( omp, sm ) = project_remain<coords::om>( project_to<coords::sm>( p ) );
     bool inserted;
-    // The [] operator creates a nested std::map if not present already.
-    std::tie( result, inserted ) = target_map[sm].emplace( p, mon );
+    // The [] operator creates the chunk if not present already.
+    std::tie( result, inserted ) = chunks[pack_chunk_key( sm )].flavors[flavor].emplace( p, mon );
     if( inserted ) {
         ( *result )->second.monster_data->set_pos_abs_only( p );
     } else {
@@ -178,8 +158,8 @@ std::optional<std::unordered_map<tripoint_abs_ms, horde_entity>::iterator> horde
 
 static void signal_sm( const tripoint_abs_ms &origin, const tripoint_abs_sm &sm_dest,
                        const tripoint_abs_sm &sm_origin, int volume,
-                       std::unordered_map <tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>>::iterator
-                       &sm_iter, bool active, std::unordered_map<tripoint_abs_ms, horde_entity> &migrating_hordes )
+                       std::unordered_map<tripoint_abs_ms, horde_entity> &entities, bool active,
+                       std::unordered_map<tripoint_abs_ms, horde_entity> &migrating_hordes )
 {
 
     const int dist = rl_dist( sm_dest, sm_origin );
@@ -188,8 +168,8 @@ static void signal_sm( const tripoint_abs_ms &origin, const tripoint_abs_sm &sm_
         return;
     }
     int scaled_eff_power = eff_power * SEEX;
-    for( std::unordered_map<tripoint_abs_ms, horde_entity>::iterator mon = sm_iter->second.begin();
-         mon != sm_iter->second.end(); ) {
+    for( std::unordered_map<tripoint_abs_ms, horde_entity>::iterator mon = entities.begin();
+         mon != entities.end(); ) {
         // Avoid unecessary extract/insert for already-active horde entities.
         if( !active ) {
             mon->second.destination = origin;
@@ -197,7 +177,7 @@ static void signal_sm( const tripoint_abs_ms &origin, const tripoint_abs_sm &sm_
             std::unordered_map<tripoint_abs_ms, horde_entity>::iterator moving_mon = mon;
             // Advance the loop iterator past the current node, which we will be removing.
             mon++;
-            auto monster_node = sm_iter->second.extract( moving_mon );
+            auto monster_node = entities.extract( moving_mon );
             migrating_hordes.insert( std::move( monster_node ) );
         } else {
             if( mon->second.tracking_intensity < scaled_eff_power ) {
@@ -210,22 +190,56 @@ static void signal_sm( const tripoint_abs_ms &origin, const tripoint_abs_sm &sm_
 }
 
 // Volume is scaled down by SEEX so it matches the scale of tripoint_om_sm
-// dormant_monster_map and immobile_monster_map are intentionally excluded here.
+// dormant and immobile entities are intentionally excluded here.
 void horde_map::signal_entities( const tripoint_abs_ms &origin, int volume )
 {
+    // Chunks further than this on any axis are out of earshot.
+    const int reach = volume - 1;
+    if( reach < 0 ) {
+        return;
+    }
     std::unordered_map<tripoint_abs_ms, horde_entity> migrating_hordes;
     tripoint_abs_sm sm_dest = project_to<coords::sm>( origin );
-    for( std::unordered_map
-         <tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>>::iterator active_sm_iter =
-             active_monster_map.begin(); active_sm_iter != active_monster_map.end(); ++active_sm_iter ) {
-        tripoint_abs_sm abs_sm = project_combine( location, active_sm_iter->first );
-        signal_sm( origin, sm_dest, abs_sm, volume, active_sm_iter, true, migrating_hordes );
+    const auto signal_chunk = [&]( uint32_t key, horde_chunk & chunk ) {
+        entity_map &active = chunk.flavors[active_flavor];
+        entity_map &idle = chunk.flavors[idle_flavor];
+        if( active.empty() && idle.empty() ) {
+            return;
+        }
+        tripoint_abs_sm abs_sm = project_combine( location, unpack_chunk_key( key ) );
+        signal_sm( origin, sm_dest, abs_sm, volume, active, true, migrating_hordes );
+        signal_sm( origin, sm_dest, abs_sm, volume, idle, false, migrating_hordes );
+    };
+
+    // Look up the chunks within earshot if that's fewer than walking all of them.
+    const point_abs_sm om_corner = project_to<coords::sm>( location );
+    const tripoint local_dest( sm_dest.x() - om_corner.x(), sm_dest.y() - om_corner.y(), sm_dest.z() );
+    const tripoint box_min( std::max( local_dest.x - reach, 0 ), std::max( local_dest.y - reach, 0 ),
+                            std::max( local_dest.z - reach, -OVERMAP_DEPTH ) );
+    const tripoint box_max( std::min( local_dest.x + reach, OMAPX * 2 - 1 ),
+                            std::min( local_dest.y + reach, OMAPY * 2 - 1 ),
+                            std::min( local_dest.z + reach, OVERMAP_HEIGHT ) );
+    if( box_min.x > box_max.x || box_min.y > box_max.y || box_min.z > box_max.z ) {
+        return;
     }
-    for( std::unordered_map
-         <tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>>::iterator idle_sm_iter =
-             idle_monster_map.begin(); idle_sm_iter != idle_monster_map.end(); ++idle_sm_iter ) {
-        tripoint_abs_sm abs_sm = project_combine( location, idle_sm_iter->first );
-        signal_sm( origin, sm_dest, abs_sm, volume, idle_sm_iter, false, migrating_hordes );
+    const int64_t box_size = static_cast<int64_t>( box_max.x - box_min.x + 1 ) *
+                             ( box_max.y - box_min.y + 1 ) * ( box_max.z - box_min.z + 1 );
+    if( box_size < static_cast<int64_t>( chunks.size() ) ) {
+        for( int z = box_min.z; z <= box_max.z; ++z ) {
+            for( int y = box_min.y; y <= box_max.y; ++y ) {
+                for( int x = box_min.x; x <= box_max.x; ++x ) {
+                    const uint32_t key = pack_chunk_key( tripoint_om_sm( x, y, z ) );
+                    map_type::iterator chunk = chunks.find( key );
+                    if( chunk != chunks.end() ) {
+                        signal_chunk( key, chunk->second );
+                    }
+                }
+            }
+        }
+    } else {
+        for( std::pair<const uint32_t, horde_chunk> &chunk : chunks ) {
+            signal_chunk( chunk.first, chunk.second );
+        }
     }
 
     while( !migrating_hordes.empty() ) {
@@ -236,104 +250,86 @@ void horde_map::signal_entities( const tripoint_abs_ms &origin, int volume )
 
 void horde_map::insert( std::unordered_map<tripoint_abs_ms, horde_entity>::node_type &&node )
 {
-    std::unordered_map <tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>> &target_map =
-                node.mapped().get_type()->has_flag( mon_flag_DORMANT ) ? dormant_monster_map :
-                node.mapped().is_active() ? active_monster_map :
-                is_alert( *node.mapped().get_type() ) ? idle_monster_map :
-                immobile_monster_map;
+    const int flavor = node.mapped().get_type()->has_flag( mon_flag_DORMANT ) ? dormant_flavor :
+                       node.mapped().is_active() ? active_flavor :
+                       is_alert( *node.mapped().get_type() ) ? idle_flavor :
+                       immobile_flavor;
     point_abs_om omp;
     tripoint_om_sm sm;
     std::tie( omp, sm ) = project_remain<coords::om>( project_to<coords::sm> ( node.key() ) );
-    // The [] operator creates a nested std::map if not present already.
-    target_map[sm].insert( std::move( node ) );
+    // The [] operator creates the chunk if not present already.
+    chunks[pack_chunk_key( sm )].flavors[flavor].insert( std::move( node ) );
 }
 
 void horde_map::clear()
 {
-    active_monster_map.clear();
-    idle_monster_map.clear();
-    dormant_monster_map.clear();
-    immobile_monster_map.clear();
+    chunks.clear();
+}
+
+void horde_map::add_memory_usage( memory_report::report &out ) const
+{
+    // Every unordered_map node carries a next pointer and the cached hash besides its value.
+    constexpr size_t node_overhead = 2 * sizeof( void * );
+    size_t entities = 0;
+    size_t bytes = chunks.bucket_count() * sizeof( void * ) +
+                   chunks.size() * ( sizeof( map_type::value_type ) + node_overhead );
+    size_t spawned = 0;
+    for( const auto &[key, chunk] : chunks ) {
+        for( const entity_map &flavor : chunk.flavors ) {
+            entities += flavor.size();
+            bytes += flavor.bucket_count() * sizeof( void * ) +
+                     flavor.size() * ( sizeof( entity_map::value_type ) + node_overhead );
+            for( const auto &[pos, entity] : flavor ) {
+                spawned += entity.monster_data ? 1 : 0;
+            }
+        }
+    }
+    out.add( "horde_map", entities, bytes );
+    out.add( "horde_map_monsters", spawned, spawned * sizeof( monster ) );
 }
 
 void horde_map::clear_chunk( const tripoint_om_sm &p )
 {
-    active_monster_map.erase( p );
-    idle_monster_map.erase( p );
-    dormant_monster_map.erase( p );
-    immobile_monster_map.erase( p );
+    chunks.erase( pack_chunk_key( p ) );
 }
 
 // horde_map::iterator definitions
 
-void horde_map::iterator::next_map()
+horde_map::iterator::iterator( const horde_map &p, int filt ) :
+    outer_map( &const_cast<horde_map &>( p ).chunks ), outer_iter( outer_map->begin() ),
+    filter( filt )
 {
-    if( outer_map == &parent->active_monster_map ) {
-        if( filter & horde_map_flavors::idle ) {
-            outer_map = &parent->idle_monster_map;
-        } else if( filter & horde_map_flavors::dormant ) {
-            outer_map = &parent->dormant_monster_map;
-        } else if( filter & horde_map_flavors::immobile ) {
-            outer_map = &parent->immobile_monster_map;
-        } else {
-            outer_map = nullptr;
-        }
-    } else if( outer_map == &parent->idle_monster_map ) {
-        if( filter & horde_map_flavors::dormant ) {
-            outer_map = &parent->dormant_monster_map;
-        } else if( filter & horde_map_flavors::immobile ) {
-            outer_map = &parent->immobile_monster_map;
-        } else {
-            outer_map = nullptr;
-        }
-    } else if( outer_map == &parent->dormant_monster_map ) {
-        if( filter & horde_map_flavors::immobile ) {
-            outer_map = &parent->immobile_monster_map;
-        } else {
-            outer_map = nullptr;
-        }
-    } else {
-        // At the end.
-        outer_map = nullptr;
+    if( outer_iter != outer_map->end() ) {
+        inner_iter = outer_iter->second.flavors[flavor].begin();
     }
+    skip_to_valid();
 }
 
-// This helper insures that a freshly created iterator is in a valid state.
-void horde_map::iterator::insure_valid()
+void horde_map::iterator::skip_to_valid()
 {
-    // Iterate forward if we don't have a valid initial state.
-    if( !( filter & horde_map_flavors::active ) || outer_map->empty() ) {
-        do {
-            next_map();
-            if( outer_map == nullptr ) {
+    while( outer_iter != outer_map->end() ) {
+        while( true ) {
+            if( ( filter & ( 1 << flavor ) ) &&
+                inner_iter != outer_iter->second.flavors[flavor].end() ) {
                 return;
             }
-        } while( outer_map->empty() );
-        outer_iter = outer_map->begin();
+            if( ++flavor == num_flavors ) {
+                break;
+            }
+            inner_iter = outer_iter->second.flavors[flavor].begin();
+        }
+        flavor = 0;
+        if( ++outer_iter != outer_map->end() ) {
+            inner_iter = outer_iter->second.flavors[flavor].begin();
+        }
     }
-    // This is not obviously correct, but it is correct because
-    // horde_map::erase() insures that we cull empty maps, so if
-    // outer_map is not empty, outer_map->begin() is valid and so is
-    // outer_map->begin()->second.begin()
-    inner_iter = outer_iter->second.begin();
+    outer_map = nullptr;
 }
 
 horde_map::iterator &horde_map::iterator::operator++()
 {
-    if( inner_iter != outer_iter->second.end() ) {
-        ++inner_iter;
-    }
-    while( inner_iter == outer_iter->second.end() ) {
-        ++outer_iter;
-        while( outer_iter == outer_map->end() ) {
-            next_map();
-            if( outer_map == nullptr ) {
-                return *this;
-            }
-            outer_iter = outer_map->begin();
-        }
-        inner_iter = outer_iter->second.begin();
-    }
+    ++inner_iter;
+    skip_to_valid();
     return *this;
 }
 
@@ -348,7 +344,7 @@ bool horde_map::iterator::operator==( iterator other ) const
 {
     return ( outer_map == nullptr && other.outer_map == nullptr ) ||
            ( outer_map == other.outer_map && outer_iter == other.outer_iter &&
-             inner_iter == other.inner_iter );
+             flavor == other.flavor && inner_iter == other.inner_iter );
 }
 
 bool horde_map::iterator::operator!=( iterator other ) const
@@ -366,32 +362,21 @@ horde_map::iterator::pointer horde_map::iterator::operator->() const
     return &*inner_iter;
 }
 
+// Immobile entities are left out, there's no point alerting them.
 horde_map::iterator horde_map::find( const tripoint_om_ms &loc )
 {
-    tripoint_om_sm submap_loc = project_to<coords::sm>( loc );
-    tripoint_abs_ms monster_loc = project_combine( location, loc );
-    map_type::iterator submap_iter = active_monster_map.find( submap_loc );
-    if( submap_iter != active_monster_map.end() ) {
-        std::unordered_map<tripoint_abs_ms, horde_entity>::iterator mon_iter =
-            submap_iter->second.find( monster_loc );
-        if( mon_iter != submap_iter->second.end() ) {
-            return iterator( *this, active_monster_map, submap_iter, mon_iter );
-        }
+    map_type::iterator chunk_iter = chunks.find( pack_chunk_key( project_to<coords::sm>( loc ) ) );
+    if( chunk_iter == chunks.end() ) {
+        return end();
     }
-    submap_iter = idle_monster_map.find( submap_loc );
-    if( submap_iter != idle_monster_map.end() ) {
-        std::unordered_map<tripoint_abs_ms, horde_entity>::iterator mon_iter =
-            submap_iter->second.find( monster_loc );
-        if( mon_iter != submap_iter->second.end() ) {
-            return iterator( *this, idle_monster_map, submap_iter, mon_iter );
-        }
-    }
-    submap_iter = dormant_monster_map.find( submap_loc );
-    if( submap_iter != dormant_monster_map.end() ) {
-        std::unordered_map<tripoint_abs_ms, horde_entity>::iterator mon_iter =
-            submap_iter->second.find( monster_loc );
-        if( mon_iter != submap_iter->second.end() ) {
-            return iterator( *this, dormant_monster_map, submap_iter, mon_iter );
+    tripoint_abs_ms monster_loc = project_combine( location, loc );
+    for( int flavor : {
+             active_flavor, idle_flavor, dormant_flavor
+         } ) {
+        entity_map &entities = chunk_iter->second.flavors[flavor];
+        entity_map::iterator mon_iter = entities.find( monster_loc );
+        if( mon_iter != entities.end() ) {
+            return iterator( chunks, chunk_iter, flavor, mon_iter );
         }
     }
     return end();
@@ -399,23 +384,21 @@ horde_map::iterator horde_map::find( const tripoint_om_ms &loc )
 
 horde_map::iterator horde_map::erase( iterator iter )
 {
-    iterator old_iter = iter;
-    iter.inner_iter =
-        iter.outer_iter->second.erase( iter.inner_iter );
-    if( iter.inner_iter == iter.outer_iter->second.end() ) {
-        ++iter;
-        if( old_iter.outer_iter->second.empty() ) {
-            old_iter.outer_map->erase( old_iter.outer_iter );
-        }
+    const map_type::iterator chunk_iter = iter.outer_iter;
+    iter.inner_iter = chunk_iter->second.flavors[iter.flavor].erase( iter.inner_iter );
+    iter.skip_to_valid();
+    // The returned iterator can't be pointing into an empty chunk.
+    if( chunk_iter->second.empty() ) {
+        chunks.erase( chunk_iter );
     }
     return iter;
 }
 
 horde_map::node_type horde_map::extract( iterator iter )
 {
-    node_type node = iter.outer_iter->second.extract( iter.inner_iter );
+    node_type node = iter.outer_iter->second.flavors[iter.flavor].extract( iter.inner_iter );
     if( iter.outer_iter->second.empty() ) {
-        iter.outer_map->erase( iter.outer_iter );
+        chunks.erase( iter.outer_iter );
     }
     return node;
 }
@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_HORDE_MAP_H
 #define CATA_SRC_HORDE_MAP_H
 
+#include <array>
+#include <cstdint>
 #include <iterator>
 #include <optional>
 #include <unordered_map>
@@ -25,32 +27,40 @@ enum {
 } // namespace horde_map_flavors
 
 class monster;
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 
-// As this class holds a large number of entries (many thousands per overmap),
-// there are a number of optimizations that are worth investigating.
-// One is minimizing the sizes of the keys.  The outer key could be tripoint_om_sm<byte>
-// and the inner key could be a point_omt_ms<byte>, shrinking their memory footprint from
-// 12 bytes each to 3 and two bytes each respectively.
 /**
  * horde_map handles one overmap worth of monster entities.
  * The primary divisions are location and different behavior,
  * i.e. active monsters vs dormant monsters vs idle monsters.
+ *
+ * As this class holds a large number of entries (many thousands per overmap),
+ * all flavors of one submap live in a single chunk, so a location costs one
+ * top level lookup and one allocation no matter how many flavors it holds.
+ * The chunks are keyed by the submap offset within the overmap packed into
+ * 32 bits instead of a 12 byte tripoint.
  */
 class horde_map
 {
-        using map_type = std::unordered_map
-                         <tripoint_om_sm, std::unordered_map<tripoint_abs_ms, horde_entity>>;
+        using entity_map = std::unordered_map<tripoint_abs_ms, horde_entity>;
+        // Entities of one submap, indexed by the bit position of their horde_map_flavors value.
+        struct horde_chunk {
+            std::array<entity_map, 4> flavors;
+            bool empty() const;
+        };
+        // A tripoint_om_sm packed into 32 bits.
+        using map_type = std::unordered_map<uint32_t, horde_chunk>;
+
+        horde_chunk *chunk_at( const tripoint_om_sm &p );
 
-        map_type active_monster_map;
-        // Monsters with the DORMANT flag get placed in this parallell structure that is
-        // ignored by overmap::move_hordes but is otherwise handled the same.
-        map_type idle_monster_map;
-        map_type dormant_monster_map;
-        map_type immobile_monster_map;
+        map_type chunks;
         point_abs_om location;
 
     public:
-        using node_type = std::unordered_map<tripoint_abs_ms, horde_entity>::node_type;
+        using node_type = entity_map::node_type;
         void set_location( point_abs_om loc ) {
             location = loc;
         }
@@ -73,6 +83,8 @@ class horde_map
         void insert( node_type &&node );
         void clear();
         void clear_chunk( const tripoint_om_sm &p );
+        /** Adds the entities, and the monsters the spawned ones remember, to @p out. */
+        void add_memory_usage( memory_report::report &out ) const;
 
         class iterator
         {
@@ -81,35 +93,27 @@ class horde_map
                 using difference_type = int;
                 using pointer = std::pair<const tripoint_abs_ms, horde_entity> *;
                 using reference = std::pair<const tripoint_abs_ms, horde_entity> &;
-                horde_map *parent = nullptr;
+                // nullptr for the end() iterator
                 map_type *outer_map = nullptr;
                 map_type::iterator outer_iter;
-                std::unordered_map<tripoint_abs_ms, horde_entity>::iterator inner_iter;
+                int flavor = 0;
+                entity_map::iterator inner_iter;
                 int filter = horde_map_flavors::active | horde_map_flavors::idle | horde_map_flavors::dormant |
                              horde_map_flavors::immobile;
+
+                // Moves forward until pointing at an entity that passes the filter, or the end.
+                void skip_to_valid();
+                explicit iterator( map_type &m, map_type::iterator oi, int flav,
+                                   entity_map::iterator ii ) : outer_map( &m ), outer_iter( oi ),
+                    flavor( flav ), inner_iter( ii ) {}
             public:
                 friend horde_map;
-                // TODO: ideally these would be private, no use case for constructing them outside of horde_map
                 // No args gets you the end() iterator.
                 explicit iterator() = default;
-                explicit iterator( const horde_map &p ) : parent( const_cast<horde_map *>( &p ) ),
-                    outer_map( &parent->active_monster_map ),
-                    outer_iter( outer_map->begin() ) {
-                    insure_valid();
-                }
-                explicit iterator( const horde_map &p, int filt ) : parent( const_cast<horde_map *>( &p ) ),
-                    outer_map( &parent->active_monster_map ),
-                    outer_iter( outer_map->begin() ),
-                    filter( filt ) {
-                    insure_valid();
-                }
-                // Sets the members directly. TODO: make private but accessable to horde_map
-                explicit iterator( const horde_map &p, map_type &m, map_type::iterator oi,
-                                   std::unordered_map<tripoint_abs_ms, horde_entity>::iterator ii ) : parent( const_cast<horde_map *>
-                                               ( &p ) ), outer_map( &m ),
-                    outer_iter( oi ), inner_iter( ii ) {}
-                void next_map();
-                void insure_valid();
+                explicit iterator( const horde_map &p ) : iterator( p,
+                            horde_map_flavors::active | horde_map_flavors::idle | horde_map_flavors::dormant |
+                            horde_map_flavors::immobile ) {}
+                explicit iterator( const horde_map &p, int filt );
                 iterator &operator++();
                 iterator operator++( int );
                 bool operator==( iterator other ) const;
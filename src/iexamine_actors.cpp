@@ -178,7 +178,9 @@ bool cardreader_examine_actor::apply( const tripoint_bub_ms &examp ) const
         }
         set_queued_points();
         here.set_seen_cache_dirty( examp );
-        here.set_transparency_cache_dirty( examp.z() );
+        const tripoint_bub_ms omt_origin = here.get_bub( coords::project_to<coords::ms>( omt_pos ) );
+        here.set_transparency_cache_dirty( omt_origin,
+                                           omt_origin + tripoint_rel_ms( SEEX * 2 - 1, SEEY * 2 - 1, 0 ) );
     } else {
         open = false;
         const tripoint_range<tripoint_bub_ms> points = here.points_in_radius( examp, radius );
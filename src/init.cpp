@@ -3,11 +3,17 @@
 #include <algorithm>
 #include <cstddef>
 #include <filesystem>
+#include <istream>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "achievement.h"
@@ -17,6 +23,7 @@
 #include "ammo_effect.h"
 #include "anatomy.h"
 #include "ascii_art.h"
+#include "basecamp.h"
 #include "behavior.h"
 #include "bionics.h"
 #include "bodygraph.h"
@@ -24,6 +31,7 @@
 #include "butchery_requirements.h"
 #include "cata_assert.h"
 #include "cata_scope_helpers.h"
+#include "cata_utility.h"
 #include "character_modifier.h"
 #include "city.h"
 #include "climbing.h"
@@ -50,10 +58,13 @@
 #include "field_type.h"
 #include "filesystem.h"
 #include "flag.h"
+#include "flexbuffer_cache.h"
 #include "flexbuffer_json.h"
 #include "gates.h"
+#include "get_version.h"
 #include "global_vars.h"
 #include "harvest.h"
+#include "hash_utils.h"
 #include "help.h"
 #include "input.h"
 #include "item_action.h"
@@ -61,6 +72,7 @@
 #include "item_factory.h"
 #include "itype.h"
 #include "json_loader.h"
+#include "load_profile.h"
 #include "loading_ui.h"
 #include "lru_cache.h"
 #include "magic.h"
@@ -94,6 +106,7 @@
 #include "overmap_connection.h"
 #include "overmap_location.h"
 #include "overmap_map_data_cache.h"
+#include "path_info.h"
 #include "profession.h"
 #include "profession_group.h"
 #include "proficiency.h"
@@ -155,7 +168,14 @@ void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &sr
     if( it == type_function_map.end() ) {
         jo.throw_error_at( "type", "unrecognized JSON object" );
     }
+    load_profile &profile = get_load_profile();
+    if( !profile.is_enabled() ) {
+        it->second( jo, src, base_path, full_path );
+        return;
+    }
+    const load_profile::clock::time_point start = load_profile::clock::now();
     it->second( jo, src, base_path, full_path );
+    profile.add_object( type, src, load_profile::clock::now() - start );
 }
 
 struct DynamicDataLoader::cached_streams {
@@ -181,9 +201,84 @@ shared_ptr_fast<std::istream> DynamicDataLoader::get_cached_stream( const std::s
     return cached;
 }
 
-void DynamicDataLoader::load_deferred( deferred_json &data )
+// Reorders data so that entries come after the ones they copy from, keeping the order of
+// unrelated entries. An entry only depends on the nearest earlier definer of its copy-from,
+// so a later override of that id never becomes its base; with no earlier definer it keeps
+// its place and is left to the retry passes.
+static void order_by_copy_from( DynamicDataLoader::deferred_json &data,
+                                const std::string &id_member )
+{
+    std::vector<DynamicDataLoader::deferred_json::iterator> entries;
+    std::unordered_map<std::string, std::vector<size_t>> defined_by;
+    const auto define = [&]( const std::string & id ) {
+        defined_by[id].push_back( entries.size() - 1 );
+    };
+    for( auto it = data.begin(); it != data.end(); ++it ) {
+        const JsonObject &jo = it->first;
+        entries.push_back( it );
+        if( jo.has_string( id_member ) ) {
+            define( jo.get_string( id_member ) );
+        } else if( jo.has_array( id_member ) ) {
+            for( const JsonValue id : jo.get_array( id_member ) ) {
+                if( id.test_string() ) {
+                    define( id.get_string() );
+                }
+            }
+        }
+        if( jo.has_string( "abstract" ) ) {
+            define( jo.get_string( "abstract" ) );
+        }
+    }
+    std::vector<std::optional<size_t>> bases( entries.size() );
+    bool any_base = false;
+    for( size_t i = 0; i < entries.size(); ++i ) {
+        const JsonObject &jo = entries[i]->first;
+        if( jo.has_string( "copy-from" ) ) {
+            const auto found = defined_by.find( jo.get_string( "copy-from" ) );
+            if( found == defined_by.end() ) {
+                continue;
+            }
+            // Definers are listed in entry order.
+            const std::vector<size_t> &definers = found->second;
+            const auto after = std::lower_bound( definers.begin(), definers.end(), i );
+            if( after != definers.begin() ) {
+                bases[i] = *std::prev( after );
+                any_base = true;
+            }
+        }
+    }
+    if( !any_base ) {
+        return;
+    }
+
+    // Depth first, bases before the entry, without recursing so long chains are fine.
+    std::vector<bool> placed( entries.size(), false );
+    std::vector<size_t> stack;
+    DynamicDataLoader::deferred_json ordered;
+    for( size_t root = 0; root < entries.size(); ++root ) {
+        stack.push_back( root );
+        while( !stack.empty() ) {
+            const size_t idx = stack.back();
+            if( placed[idx] ) {
+                stack.pop_back();
+                continue;
+            }
+            if( bases[idx] && !placed[*bases[idx]] ) {
+                stack.push_back( *bases[idx] );
+                continue;
+            }
+            placed[idx] = true;
+            ordered.splice( ordered.end(), data, entries[idx] );
+            stack.pop_back();
+        }
+    }
+    data.swap( ordered );
+}
+
+void DynamicDataLoader::load_deferred( deferred_json &data, const std::string &id_member )
 {
     while( !data.empty() ) {
+        order_by_copy_from( data, id_member );
         const size_t n = data.size();
         auto it = data.begin();
         for( size_t idx = 0; idx != n; ++idx ) {
@@ -545,18 +640,18 @@ void DynamicDataLoader::load_data_from_path( const cata_path &path, const std::s
         files.emplace_back( path );
     }
 
-    // iterate over each file
-    for( const cata_path &file : files ) {
-        if( should_skip_nonruntime_json_file( file ) ) {
-            continue;
-        }
-        try {
-            // parse it
-            JsonValue jsin = json_loader::from_path( file );
+    files.erase( std::remove_if( files.begin(), files.end(), should_skip_nonruntime_json_file ),
+                 files.end() );
+    add_to_data_key( files );
+    load_profile_phase profile_phase( "load", string_format( "%s: %s", src,
+                                      path.generic_u8string() ) );
+    // Files are parsed ahead in parallel, but loaded in order.
+    try {
+        json_loader::from_paths( files, [&]( const cata_path & file, const JsonValue & jsin ) {
             load_all_from_json( jsin, src, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
+        }, get_option<bool>( "DATA_SNAPSHOT" ) ? path.generic_u8string() : std::string() );
+    } catch( const JsonError &err ) {
+        throw std::runtime_error( err.what() );
     }
 }
 
@@ -581,18 +676,18 @@ void DynamicDataLoader::load_mod_data_from_path( const cata_path &path, const st
         files.emplace_back( path );
     }
 
-    // iterate over each file
-    for( const cata_path &file : files ) {
-        if( should_skip_nonruntime_json_file( file ) ) {
-            continue;
-        }
-        try {
-            // parse it
-            JsonValue jsin = json_loader::from_path( file );
+    files.erase( std::remove_if( files.begin(), files.end(), should_skip_nonruntime_json_file ),
+                 files.end() );
+    add_to_data_key( files );
+    load_profile_phase profile_phase( "load", string_format( "%s: %s", src,
+                                      path.generic_u8string() ) );
+    // Files are parsed ahead in parallel, but loaded in order.
+    try {
+        json_loader::from_paths( files, [&]( const cata_path & file, const JsonValue & jsin ) {
             load_all_from_json( jsin, src, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
+        }, get_option<bool>( "DATA_SNAPSHOT" ) ? path.generic_u8string() : std::string() );
+    } catch( const JsonError &err ) {
+        throw std::runtime_error( err.what() );
     }
 }
 
@@ -623,6 +718,13 @@ void DynamicDataLoader::load_mod_interaction_files_from_path( const cata_path &p
             }
         }
     }
+    std::vector<cata_path> file_paths;
+    for( const std::pair<const mod_id, cata_path> &file : files ) {
+        file_paths.push_back( file.second );
+    }
+    add_to_data_key( file_paths );
+    load_profile_phase profile_phase( "load", string_format( "%s: %s", src,
+                                      path.generic_u8string() ) );
     // iterate over each file
     for( const std::pair<const mod_id, cata_path> &file : files ) {
         try {
@@ -655,9 +757,86 @@ void DynamicDataLoader::load_all_from_json( const JsonValue &jsin, const std::st
     inp_mngr.pump_events();
 }
 
+void DynamicDataLoader::add_to_data_key( const std::vector<cata_path> &files )
+{
+    std::vector<std::filesystem::path> paths;
+    paths.reserve( files.size() );
+    for( const cata_path &file : files ) {
+        paths.emplace_back( file.lexically_normal().get_unrelative_path() );
+    }
+    const uint64_t key = flexbuffer_snapshot::key_for( paths );
+    if( key == 0 ) {
+        data_key_valid = false;
+    }
+    cata::hash_combine( data_key, key );
+}
+
+namespace
+{
+// How many verified data sets we remember, e.g. one per mod list in use.
+constexpr size_t verified_data_keys_kept = 16;
+
+cata_path verified_data_path()
+{
+    return PATH_INFO::config_dir_path() / "verified_data.txt";
+}
+
+// Keys of the data sets that passed verification, oldest first.
+std::vector<std::size_t> read_verified_data_keys()
+{
+    std::vector<std::size_t> keys;
+    read_from_file_optional( verified_data_path(), [&keys]( std::istream & fin ) {
+        std::size_t key = 0;
+        while( fin >> std::hex >> key ) {
+            keys.push_back( key );
+        }
+    } );
+    return keys;
+}
+
+std::size_t versioned_data_key( std::size_t data_key )
+{
+    // A different build may check different things.
+    cata::hash_combine( data_key, std::string( getVersionString() ) );
+    return data_key;
+}
+} // namespace
+
+bool DynamicDataLoader::data_already_verified() const
+{
+    if( !data_key_valid ) {
+        return false;
+    }
+    const std::vector<std::size_t> keys = read_verified_data_keys();
+    return std::find( keys.begin(), keys.end(), versioned_data_key( data_key ) ) != keys.end();
+}
+
+void DynamicDataLoader::remember_data_verified() const
+{
+    if( !data_key_valid ) {
+        return;
+    }
+    const std::size_t key = versioned_data_key( data_key );
+    std::vector<std::size_t> keys = read_verified_data_keys();
+    keys.erase( std::remove( keys.begin(), keys.end(), key ), keys.end() );
+    keys.push_back( key );
+    if( keys.size() > verified_data_keys_kept ) {
+        keys.erase( keys.begin(), keys.end() - verified_data_keys_kept );
+    }
+    write_to_file( verified_data_path(), [&keys]( std::ostream & fout ) {
+        for( const std::size_t k : keys ) {
+            fout << std::hex << k << '\n';
+        }
+    }, _( "verified data list" ) );
+}
+
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    data_key = 0;
+    data_key_valid = true;
+    // Everything loaded after this point up to the finalization belongs to the next profile.
+    get_load_profile().reset( get_option<bool>( "PROFILE_LOADING" ) );
 
     achievement::reset();
     activity_type::reset();
@@ -670,6 +849,7 @@ void DynamicDataLoader::unload_data()
     behavior::reset();
     body_part_type::reset();
     butchery_requirements::reset();
+    camp_locker_profiles::reset();
     sub_body_part_type::reset();
     bodygraph::reset();
     climbing_aid::reset();
@@ -861,6 +1041,7 @@ void DynamicDataLoader::finalize_loaded_data()
             { _( "Item Categories" ), &item_category::finalize_all },
             { _( "Materials" ), &material_type::finalize_all },
             { _( "Items" ), &items::finalize_all },
+            { _( "Camp locker profiles" ), &camp_locker_profiles::finalize_all },
             { _( "Limb Scores" ), &limb_score::finalize_all },
             {
                 _( "Crafting requirements" ), []()
@@ -952,13 +1133,31 @@ void DynamicDataLoader::finalize_loaded_data()
 
     for( const named_entry &e : entries ) {
         loading_ui::show( _( "Finalizing" ), e.first );
+        load_profile_phase profile_phase( "finalize", e.first );
         e.second();
     }
 
     if( !get_option<bool>( "SKIP_VERIFICATION" ) ) {
-        check_consistency();
+        const bool cache_verification = get_option<bool>( "CACHE_VERIFICATION" );
+        if( cache_verification && data_already_verified() ) {
+            DebugLog( D_INFO, DC_ALL ) << "Skipping verification of already verified data";
+        } else {
+            // Errors from before the checks would count against them, so don't remember those.
+            const bool clean_before = !debug_has_error_been_observed();
+            check_consistency();
+            if( cache_verification && clean_before && !debug_has_error_been_observed() ) {
+                remember_data_verified();
+            }
+        }
     }
     finalized = true;
+
+    if( get_load_profile().is_enabled() ) {
+        const cata_path profile_path = PATH_INFO::config_dir_path() / "load_profile.json";
+        get_load_profile().write( profile_path );
+        DebugLog( D_INFO, DC_ALL ) << "Wrote the data loading profile to "
+                                   << profile_path.generic_u8string();
+    }
 }
 
 void DynamicDataLoader::check_consistency()
@@ -1063,6 +1262,7 @@ void DynamicDataLoader::check_consistency()
 
     for( const named_entry &e : entries ) {
         loading_ui::show( _( "Verifying" ), e.first );
+        load_profile_phase profile_phase( "check", e.first );
         e.second();
     }
 }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_INIT_H
 #define CATA_SRC_INIT_H
 
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <list>
@@ -69,6 +70,18 @@ class DynamicDataLoader
 
         std::unique_ptr<cached_streams> stream_cache;
 
+        // Hash of the paths, sizes and mtimes of every data file loaded since the last unload,
+        // in load order. Identifies the data set for the cached verification results.
+        std::size_t data_key = 0;
+        // Whether data_key covers everything loaded, false once a file couldn't be examined.
+        bool data_key_valid = true;
+
+        void add_to_data_key( const std::vector<cata_path> &files );
+        /** Whether this exact data set already passed @ref check_consistency before. */
+        bool data_already_verified() const;
+        /** Remembers that this data set passed @ref check_consistency without errors. */
+        void remember_data_verified() const;
+
     protected:
         /**
          * Maps the type string (coming from json) to the
@@ -180,8 +193,13 @@ class DynamicDataLoader
 
         /**
          * Loads and then removes entries from @param data
+         *
+         * Each pass first puts every entry after the entries defining its copy-from, found by
+         * their @p id_member or "abstract", so a chain of copy-from resolves in one pass
+         * rather than one pass per link. Entries that still can't load are retried until a
+         * pass makes no progress.
          */
-        void load_deferred( deferred_json &data );
+        void load_deferred( deferred_json &data, const std::string &id_member = "id" );
 
         /**
          * Returns whether the data is finalized and ready to be utilized.
@@ -27,6 +27,7 @@
 #include "sdltiles.h" // IWYU pragma: keep
 #include "string_formatter.h"
 #include "translations.h"
+#include "turn_replay.h"
 
 static const std::string default_context_id( "default" );
 
@@ -998,7 +999,7 @@ void input_manager::wait_for_any_key()
     input_context ctxt( "WAIT_FOR_ANY_KEY", keyboard_mode::keycode );
 #endif
     while( true ) {
-        const input_event evt = inp_mngr.get_input_event();
+        const input_event evt = turn_replay::next_input_event();
         switch( evt.type ) {
             case input_event_t::keyboard_char:
                 if( !evt.sequence.empty() ) {
@@ -337,6 +337,11 @@ class input_manager
          * Resize & refresh if necessary, process all pending window events, and ignore keypresses
          */
         void pump_events();
+        /**
+         * Whether a keypress is already queued, i.e. the next @ref get_input_event
+         * will return at once. Always false where the backend can't tell.
+         */
+        bool has_pending_key_input() const;
 
         /**
          * Wait until the user presses a key. Mouse and similar input is ignored,
@@ -36,6 +36,7 @@
 #include "string_formatter.h"
 #include "string_input_popup.h"
 #include "translations.h"
+#include "turn_replay.h"
 #include "ui_manager.h"
 #include "sdl_gamepad.h"
 
@@ -479,7 +480,7 @@ const std::string &input_context::handle_input( const int timeout )
     const std::string *result = &CATA_ERROR;
     while( true ) {
 
-        next_action = inp_mngr.get_input_event( preferred_keyboard_mode );
+        next_action = turn_replay::next_input_event( preferred_keyboard_mode );
         if( next_action.type == input_event_t::timeout ) {
             result = &TIMEOUT;
             break;
@@ -242,6 +242,7 @@ inventory inventory::operator+ ( const item &rhs )
 void inventory::unsort()
 {
     binned = false;
+    quality_levels.clear();
 }
 
 static bool stack_compare( const std::list<item> &lhs, const std::list<item> &rhs )
@@ -254,7 +255,7 @@ void inventory::clear()
     items.clear();
     max_empty_liq_cont.clear();
     binned = false;
-    qualities_cache.clear();
+    quality_levels.clear();
 }
 
 void inventory::push_back( const std::list<item> &newits )
@@ -302,6 +303,7 @@ char inventory::find_usable_cached_invlet( const itype_id &item_type )
 item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, bool should_stack )
 {
     binned = false;
+    quality_levels.clear();
 
     Character &player_character = get_player_character();
     if( should_stack ) {
@@ -395,6 +397,7 @@ void inventory::restack( Character &p )
     // 3. combine matching stacks
 
     binned = false;
+    quality_levels.clear();
     std::list<item> to_restack;
     int idx = 0;
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter, ++idx ) {
@@ -628,6 +631,7 @@ std::list<item> inventory::reduce_stack( const int position, const int quantity
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            quality_levels.clear();
             if( quantity >= static_cast<int>( iter->size() ) || quantity < 0 ) {
                 ret = *iter;
                 items.erase( iter );
@@ -650,6 +654,7 @@ item inventory::remove_item( const item *it )
     }, 1 );
     if( !tmp.empty() ) {
         binned = false;
+        quality_levels.clear();
         return tmp.front();
     }
     debugmsg( "Tried to remove a item not in inventory." );
@@ -662,6 +667,7 @@ item inventory::remove_item( const int position )
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            quality_levels.clear();
             if( iter->size() > 1 ) {
                 std::list<item>::iterator stack_member = iter->begin();
                 char invlet = stack_member->invlet;
@@ -707,6 +713,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
         }
         if( chosen_stack->empty() ) {
             binned = false;
+            quality_levels.clear();
             items.erase( chosen_stack );
         }
     }
@@ -803,6 +810,7 @@ std::list<item> inventory::use_amount( const itype_id &it, int quantity,
         }
         if( iter->empty() ) {
             binned = false;
+            quality_levels.clear();
             iter = items.erase( iter );
         } else if( iter != items.end() ) {
             ++iter;
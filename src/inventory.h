@@ -12,7 +12,6 @@
 #include <map>
 #include <set>
 #include <string>
-#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -97,20 +96,6 @@ class invlet_favorites
         std::array<itype_id, 256> ids_by_invlet;
 };
 
-struct quality_query {
-    quality_id qual;
-    int level;
-    int count;
-
-    bool operator==( const quality_query &other ) const {
-        return qual == other.qual && level == other.level && count == other.count;
-    }
-
-    bool operator<( const quality_query &other ) const {
-        return std::tie( qual, level, count ) < std::tie( other.qual, other.level, other.count );
-    }
-};
-
 class inventory : public visitable
 {
     public:
@@ -297,7 +282,11 @@ class inventory : public visitable
          */
         mutable itype_bin binned_items;
 
-        mutable std::map<quality_query, bool> qualities_cache;
+        /**
+         * Per quality, how many items have it at each level, counted the way has_quality()
+         * counts them. Filled one quality at a time on first use and dropped with the bins.
+         */
+        mutable std::unordered_map<quality_id, std::map<int, int>> quality_levels;
 };
 
 #endif // CATA_SRC_INVENTORY_H
@@ -102,6 +102,8 @@ struct item_name_t {
     std::string sort_key;
     std::string full_name;
     unsigned int contents_count{};
+    // full_name folded for name searches, filled by the first one
+    std::optional<lcmatch_key> search_key;
 };
 using name_cache_t = std::unordered_map<item const *, item_name_t>;
 name_cache_t item_name_cache;
@@ -114,7 +116,7 @@ item_name_t &get_cached_name( item const *it )
         return item_name_cache
                .emplace( it, item_name_t{ remove_color_tags( it->tname( 1, tname::tname_sort_key ) ),
                                           remove_color_tags( it->tname( 1, true ) ),
-                                          it->aggregated_contents().count } )
+                                          it->aggregated_contents().count, std::nullopt } )
                .first->second;
     }
 
@@ -751,6 +753,19 @@ nc_color inventory_selector_preset::get_color( const inventory_entry &entry ) co
 std::function<bool( const inventory_entry & )> inventory_selector_preset::get_filter(
     const std::string &filter ) const
 {
+    // Plain name searches, as basic_item_filter() reads them, go against the cached names
+    // instead of building and folding a fresh tname() for every entry on every search.
+    const size_t colon = filter.find( ':' );
+    if( colon == std::string::npos || colon == 0 ) {
+        return [query = lcmatch_query( filter )]( const inventory_entry & e ) {
+            item_name_t &names = get_cached_name( &*e.any_item() );
+            if( !names.search_key ) {
+                names.search_key = lcmatch_prepare( names.full_name );
+            }
+            return lcmatch( *names.search_key, query );
+        };
+    }
+
     auto item_filter = basic_item_filter( filter );
 
     return [item_filter]( const inventory_entry & e ) {
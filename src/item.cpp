@@ -146,6 +146,10 @@ static const std::string flag_NO_SELL( "NO_SELL" );
 // fault flags
 static const std::string flag_BLACKPOWDER_FOULING_DAMAGE( "BLACKPOWDER_FOULING_DAMAGE" );
 
+// item variables read on hot paths, built once rather than for every lookup
+static const std::string var_dirt( "dirt" );
+static const std::string var_gun_heat( "gun_heat" );
+
 // item pricing
 static const int PRICE_FILTHY_MALUS = 100;  // cents
 
@@ -870,7 +874,7 @@ stacking_info item::stacks_with( const item &rhs, bool check_components, bool co
     bits.set( tname::segments::FAULTS_SUFFIX, faults == rhs.faults );
     bits.set( tname::segments::TECHNIQUES, techniques == rhs.techniques );
     bits.set( tname::segments::OVERHEAT, overheat_symbol() == rhs.overheat_symbol() );
-    bits.set( tname::segments::DIRT, get_var( "dirt", 0 ) == rhs.get_var( "dirt", 0 ) );
+    bits.set( tname::segments::DIRT, get_var( var_dirt, 0 ) == rhs.get_var( var_dirt, 0 ) );
     bits.set( tname::segments::SEALED, all_pockets_sealed() == rhs.all_pockets_sealed() );
     bits.set( tname::segments::CBM_STATUS, _stacks_cbm_status( *this, rhs ) );
     bits.set( tname::segments::BROKEN, is_broken() == rhs.is_broken() );
@@ -879,7 +883,8 @@ stacking_info item::stacks_with( const item &rhs, bool check_components, bool co
     // but other item_vars such as label/note will prevent stacking
     static const std::set<std::string> ignore_keys = { "dirt", "shot_counter", "spawn_location", "ethereal", "last_act_by_char_id", "activity_var" };
     bits.set( tname::segments::TRAITS, template_traits == rhs.template_traits );
-    bits.set( tname::segments::VARS, map_equal_ignoring_keys( item_vars, rhs.item_vars, ignore_keys ) );
+    bits.set( tname::segments::VARS, ( item_vars.empty() && rhs.item_vars.empty() ) ||
+              map_equal_ignoring_keys( item_vars, rhs.item_vars, ignore_keys ) );
     bits.set( tname::segments::ETHEREAL, _stacks_ethereal( *this, rhs ) );
     bits.set( tname::segments::LOCATION_HINT, _stacks_location_hint( *this, rhs ) );
 
@@ -994,12 +999,21 @@ diag_value const &item::get_value( const std::string &name ) const
 
 diag_value const *item::maybe_get_value( const std::string &name ) const
 {
+    // Most items have no variables, don't hash the key for those.
+    if( item_vars.empty() ) {
+        return nullptr;
+    }
     return global_variables::_common_maybe_get_value( name, item_vars );
 }
 
 bool item::has_var( const std::string &name ) const
 {
-    return item_vars.count( name ) > 0;
+    return !item_vars.empty() && item_vars.count( name ) > 0;
+}
+
+bool item::has_vars() const
+{
+    return !item_vars.empty();
 }
 
 void item::erase_var( const std::string &name )
@@ -3804,7 +3818,7 @@ int item::processing_speed() const
 
     if( active || ethereal || wetness || has_link_data() ||
         has_flag( flag_RADIO_ACTIVATION ) || has_relic_recharge() ||
-        has_fault_flag( flag_BLACKPOWDER_FOULING_DAMAGE ) || get_var( "gun_heat", 0 ) > 0 ||
+        has_fault_flag( flag_BLACKPOWDER_FOULING_DAMAGE ) || get_var( var_gun_heat, 0 ) > 0 ||
         has_fault( fault_emp_reboot ) ) {
         // Unless otherwise indicated, update every turn.
         return 1;
@@ -4483,7 +4497,7 @@ bool item::process_internal( map &here, Character *carrier, const tripoint_bub_m
         if( has_fault_flag( flag_BLACKPOWDER_FOULING_DAMAGE ) ) {
             return process_blackpowder_fouling( carrier );
         }
-        if( get_var( "gun_heat", 0 ) > 0 ) {
+        if( get_var( var_gun_heat, 0 ) > 0 ) {
             return process_gun_cooling( carrier );
         }
         if( has_fault( fault_emp_reboot ) ) {
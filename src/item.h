@@ -1678,6 +1678,12 @@ class item : public visitable
          */
         int processing_speed() const;
         static constexpr int NO_PROCESSING = 10000;
+        /**
+         * The first turn at which @ref process could change this item, or the current turn if it
+         * might do so right away. Food that only warms, cools and rots has nothing to do until its
+         * next temperature check, see @ref process_temperature_rot.
+         */
+        time_point processing_wake() const;
         /**
          * Process and apply artifact effects. This should be called exactly once each turn, it may
          * modify character stats (like speed, strength, ...), so call it after those have been reset.
@@ -2024,6 +2030,8 @@ class item : public visitable
         diag_value const *maybe_get_value( const std::string &name ) const;
         /** Whether the variable is defined at all. */
         bool has_var( const std::string &name ) const;
+        /** Whether any variable is defined. */
+        bool has_vars() const;
         /** Erase the value of the given variable. */
         void erase_var( const std::string &name );
         /** Removes all item variables. */
@@ -2127,6 +2135,8 @@ class item : public visitable
 
         /** Does this item have the specified fault? */
         bool has_fault( const fault_id &fault ) const;
+        /** All faults this item currently has. */
+        const std::set<fault_id> &get_faults() const;
 
         bool has_fault_of_type( const std::string &fault_type ) const;
 
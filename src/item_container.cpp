@@ -191,6 +191,7 @@ void item::force_insert_item( const item &it, pocket_type pk_type )
 
 void item::on_contents_changed()
 {
+    item_pocket::invalidate_aggregates();
     contents.update_open_pockets();
     cached_relative_encumbrance.reset();
     encumbrance_update_ = true;
@@ -315,6 +315,11 @@ bool item::has_fault( const fault_id &fault ) const
     return faults.count( fault );
 }
 
+const std::set<fault_id> &item::get_faults() const
+{
+    return faults;
+}
+
 bool item::has_fault_of_type( const std::string &fault_type ) const
 {
     for( const fault_id &f : faults ) {
@@ -1262,6 +1267,21 @@ void item::apply_freezerburn()
     set_flag( flag_MUSHY );
 }
 
+// process_temperature_rot() updates an item at most this often.
+static constexpr time_duration temperature_rot_interval = 10_minutes;
+
+time_point item::processing_wake() const
+{
+    // Anything else process_internal() does for an item may happen on any turn.
+    if( !active || !is_food() || is_corpse() || is_tool() || ethereal || wetness > 0 ||
+        has_link_data() || has_relic_recharge() || requires_tags_processing ||
+        countdown_point != calendar::turn_max || !type->emits.empty() || !has_temperature() ||
+        units::to_joule_per_gram( specific_energy ) <= 0 || last_temp_check > calendar::turn ) {
+        return calendar::turn;
+    }
+    return std::max( calendar::turn, last_temp_check + temperature_rot_interval );
+}
+
 bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos, map &here,
                                     Character *carrier, const temperature_flag flag, float spoil_modifier, bool watertight_container )
 {
@@ -1275,8 +1295,8 @@ bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos
     }
 
     // process temperature and rot at most once every 100_turns (10 min)
-    // note we're also gated by item::processing_speed
-    time_duration smallest_interval = 10_minutes;
+    // note we're also gated by item::processing_speed and item::processing_wake
+    time_duration smallest_interval = temperature_rot_interval;
     if( now - last_temp_check < smallest_interval && units::to_joule_per_gram( specific_energy ) > 0 ) {
         return false;
     }
@@ -1321,9 +1341,6 @@ bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos
     if( now - time > 1_hours ) {
         // This code is for items that were left out of reality bubble for long time
 
-        const weather_generator &wgen = get_weather().get_cur_weather_gen();
-        const unsigned int seed = g->get_seed();
-
         units::temperature_delta temp_mod;
         // Toilets and vending machines will try to get the heat radiation and convection during mapgen and segfault.
         if( !g->new_game && !g->swapping_dimensions ) {
@@ -1341,6 +1358,19 @@ bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos
         // Process the past of this item in 1h chunks until there is less than 1h left.
         time_duration time_delta = 1_hours;
 
+        // Hours more than 2 days back only matter through rot and air exposure. When neither
+        // can change, because the item is frozen, done rotting or kept below freezing, those
+        // hours would each do nothing, so step over them at once.
+        if( !decays_in_air && ( !process_rot || has_own_flag( flag_FROZEN ) ||
+                                flag == temperature_flag::FREEZER ||
+                                ( !is_corpse() && get_relative_rot() > 2.0 ) ) ) {
+            const int idle_hours = to_hours<int>( now - 2_days - time );
+            if( idle_hours > 0 ) {
+                time += idle_hours * time_delta;
+                last_temp_check = time;
+            }
+        }
+
         while( now - time > 1_hours ) {
             time += time_delta;
 
@@ -1348,7 +1378,7 @@ bool item::process_temperature_rot( float insulation, const tripoint_bub_ms &pos
             // Use weather if above ground, use map temp if below
             units::temperature env_temperature;
             if( pos.z() >= 0 && flag != temperature_flag::ROOT_CELLAR ) {
-                env_temperature = wgen.get_weather_temperature( get_map().get_abs( pos ), time, seed );
+                env_temperature = get_weather().get_natural_temperature( get_map().get_abs( pos ), time );
             } else {
                 env_temperature = units::from_celsius( get_weather().get_cur_weather_gen().base_temperature );
             }
@@ -61,6 +61,7 @@
 #include "string_formatter.h"
 #include "subbodypart.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translation.h"
 #include "translations.h"
 #include "units.h"
@@ -823,6 +824,17 @@ void Item_factory::register_cached_uses( const itype &obj )
     }
 }
 
+// Complex firearms skip most of finalize_post, including their armor data.
+static bool is_complex_firearm( const itype &obj )
+{
+    return obj.gun && !obj.has_flag( flag_PRIMITIVE_RANGED_WEAPON );
+}
+
+static bool needs_armor_finalization( const itype &obj )
+{
+    return obj.armor && !is_complex_firearm( obj );
+}
+
 void Item_factory::finalize_post( itype &obj )
 {
     erase_if( obj.item_tags, [&]( const flag_id & f ) {
@@ -844,14 +856,12 @@ void Item_factory::finalize_post( itype &obj )
     }
 
     // handle complex firearms as a special case
-    if( obj.gun && !obj.has_flag( flag_PRIMITIVE_RANGED_WEAPON ) ) {
+    if( is_complex_firearm( obj ) ) {
         std::copy( gun_tools.begin(), gun_tools.end(), std::inserter( obj.repair, obj.repair.begin() ) );
         return;
     }
 
-    if( obj.armor ) {
-        finalize_post_armor( obj );
-    }
+    // armor data was already finalized by finalize_armor
 
     // if we haven't set what the item can be repaired with calculate it now
     if( obj.repairs_with.empty() ) {
@@ -929,7 +939,31 @@ void Item_factory::finalize_post( itype &obj )
     }
 }
 
-void Item_factory::finalize_post_armor( itype &obj )
+void Item_factory::finalize_armor( const std::vector<itype *> &types )
+{
+    // The workers below reach the body part ids stored in the shared body part types. Resolve
+    // them here first, so the workers only ever read the cached lookups of those ids.
+    for( const body_part_type &bp : body_part_type::get_all() ) {
+        for( const sub_bodypart_str_id &sbp : bp.sub_parts ) {
+            static_cast<void>( sbp.is_valid() );
+        }
+    }
+    for( const sub_body_part_type &sbp : sub_body_part_type::get_all() ) {
+        static_cast<void>( sbp.parent.is_valid() );
+    }
+
+    std::vector<std::vector<std::string>> errors( types.size() );
+    cata::get_thread_pool().parallel_for( 0, static_cast<int>( types.size() ), [&]( int i ) {
+        finalize_post_armor( *types[i], errors[i] );
+    } );
+    for( const std::vector<std::string> &type_errors : errors ) {
+        for( const std::string &error : type_errors ) {
+            debugmsg( "%s", error );
+        }
+    }
+}
+
+void Item_factory::finalize_post_armor( itype &obj, std::vector<std::string> &errors )
 {
     // Tally up all the hard-defined similar BPs
     for( armor_portion_data &data : obj.armor->sub_data ) {
@@ -1117,8 +1151,8 @@ void Item_factory::finalize_post_armor( itype &obj )
                         // or the new data has an empty sublocations list then say that you are
                         // redefining a limb
                         if( it.sub_coverage.empty() || sub_armor.sub_coverage.empty() ) {
-                            debugmsg( "item %s has multiple entries for %s.",
-                                      obj.id.str(), bp.str() );
+                            errors.push_back( string_format( "item %s has multiple entries for %s.",
+                                                             obj.id.str(), bp.str() ) );
                         }
 
                         // go through the materials list and update data
@@ -1199,7 +1233,13 @@ void Item_factory::finalize_post_armor( itype &obj )
     for( armor_portion_data &data : obj.armor->data ) {
         if( !data.encumber_modifiers.empty() ) {
             // we know that the data entry covers a single bp
-            data.encumber = data.calc_encumbrance( obj.weight, *data.covers.value().begin() );
+            const bodypart_str_id &bp = *data.covers.value().begin();
+            const std::optional<int> encumber = data.calc_encumbrance( obj.weight, bp );
+            if( !encumber ) {
+                errors.push_back( string_format( "item %s has no encumbrance reference point for %s.",
+                                                 obj.id.str(), bp.str() ) );
+            }
+            data.encumber = encumber.value_or( 100 );
 
             // need to account for varsize stuff here and double encumbrance if so
             if( obj.has_flag( flag_VARSIZE ) ) {
@@ -1496,8 +1536,8 @@ void Item_factory::finalize_post_armor( itype &obj )
     for( const armor_portion_data &armor_data : obj.armor->data ) {
         for( const part_material &mat : armor_data.materials ) {
             if( mat.cover > 100 || mat.cover < 0 ) {
-                debugmsg( "item %s has coverage %d for material %s.",
-                          obj.id.str(), mat.cover, mat.id.str() );
+                errors.push_back( string_format( "item %s has coverage %d for material %s.",
+                                                 obj.id.str(), mat.cover, mat.id.str() ) );
             }
         }
     }
@@ -1516,6 +1556,16 @@ void Item_factory::finalize()
         register_cached_uses( e );
     }
 
+    // Armor finalization only looks at the item itself, so unlike the passes around it, it can
+    // run for all items at once. finalize_post relies on its results.
+    std::vector<itype *> armor_types;
+    for( const itype &e : item_factory.get_all() ) {
+        if( needs_armor_finalization( e ) ) {
+            armor_types.push_back( &const_cast<itype &>( e ) );
+        }
+    }
+    finalize_armor( armor_types );
+
     for( const itype &e : item_factory.get_all() ) {
         finalize_post( const_cast<itype &>( e ) );
     }
@@ -1524,6 +1574,9 @@ void Item_factory::finalize()
     // TODO: support for runtimes that repair
     for( auto &e : m_runtimes ) {
         finalize_pre( *e.second );
+        if( needs_armor_finalization( *e.second ) ) {
+            finalize_armor( { e.second.get() } );
+        }
         finalize_post( *e.second );
     }
 
@@ -356,7 +356,13 @@ class Item_factory
         /** Applies part of finalization that depends on other items. */
         void finalize_post( itype &obj );
 
-        void finalize_post_armor( itype &obj );
+        /**
+         * Works out the per body part armor data. Only touches @p obj, so it may run for several
+         * items at once; problems are appended to @p errors instead of being reported directly.
+         */
+        void finalize_post_armor( itype &obj, std::vector<std::string> &errors );
+        /** Runs @ref finalize_post_armor for all of @p types across the thread pool. */
+        void finalize_armor( const std::vector<itype *> &types );
 
         /**
          * Contains the tool subtype mappings for crafting (i.e. mess kit is a hotplate etc.).
@@ -311,9 +311,10 @@ std::size_t Single_item_creator::create( ItemList &list,
             std::size_t tmp_list_size = isd->create( list, birthday, rec, flags );
             cata_assert( list.size() >= tmp_list_size );
             rec.pop_back();
-            if( modifier ) {
+            if( modifier && tmp_list_size > 0 ) {
+                const std::string modifier_context = "modifier for " + context();
                 for( auto it = list.end() - tmp_list_size; it != list.end(); ++it ) {
-                    modifier->modify( *it, "modifier for " + context() );
+                    modifier->modify( *it, modifier_context );
                 }
             }
         }
@@ -843,6 +844,7 @@ void Item_group::add_entry( std::unique_ptr<Item_spawn_data> ptr )
         ptr->set_probability( std::min( 100, ptr->get_probability( true ) ) );
     }
     sum_prob += ptr->get_probability( true );
+    cumulative_prob.push_back( sum_prob );
 
     // Make the ammo and magazine probabilities from the outer entity apply to the nested entity:
     // If ptr is an Item_group, it already inherited its parent's ammo/magazine chances in its constructor.
@@ -865,17 +867,9 @@ std::size_t Item_group::create( Item_spawn_data::ItemList &list,
             elem->create( list, birthday, rec, flags );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            bool ev_based = elem->is_event_based();
-            int prob = elem->get_probability( false );
-            int real_prob = elem->get_probability( true );
-            p -= real_prob;
-            if( ( ev_based && prob == 0 ) || p >= 0 ) {
-                continue;
-            }
-            elem->create( list, birthday, rec, flags );
-            break;
+        const std::size_t picked = distribution_entry( rng( 0, sum_prob - 1 ) );
+        if( picked < items.size() ) {
+            items[picked]->create( list, birthday, rec, flags );
         }
     }
     const std::size_t items_created = list.size() - prev_list_size;
@@ -885,6 +879,19 @@ std::size_t Item_group::create( Item_spawn_data::ItemList &list,
     return list.size() - prev_list_size;
 }
 
+std::size_t Item_group::distribution_entry( int p ) const
+{
+    // The first entry whose running total passes the roll.
+    std::size_t picked = std::upper_bound( cumulative_prob.begin(), cumulative_prob.end(),
+                                           p ) - cumulative_prob.begin();
+    // An event entry out of season keeps its share of the roll but hands it to the next entry.
+    while( picked < items.size() && items[picked]->is_event_based() &&
+           items[picked]->get_probability( false ) == 0 ) {
+        ++picked;
+    }
+    return picked;
+}
+
 item Item_group::create_single( const time_point &birthday, RecursionList &rec ) const
 {
     if( type == G_COLLECTION ) {
@@ -895,16 +902,9 @@ item Item_group::create_single( const time_point &birthday, RecursionList &rec )
             return elem->create_single( birthday, rec );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            bool ev_based = elem->is_event_based();
-            int prob = elem->get_probability( false );
-            int real_prob = elem->get_probability( true );
-            p -= real_prob;
-            if( ( ev_based && prob == 0 ) || p >= 0 ) {
-                continue;
-            }
-            return elem->create_single( birthday, rec );
+        const std::size_t picked = distribution_entry( rng( 0, sum_prob - 1 ) );
+        if( picked < items.size() ) {
+            return items[picked]->create_single( birthday, rec );
         }
     }
     return item( itype_id::NULL_ID(), birthday );
@@ -954,6 +954,12 @@ bool Item_group::remove_item( const itype_id &itemid )
             ++a;
         }
     }
+    cumulative_prob.clear();
+    int running_prob = 0;
+    for( const std::unique_ptr<Item_spawn_data> &elem : items ) {
+        running_prob += elem->get_probability( true );
+        cumulative_prob.push_back( running_prob );
+    }
     if( container_item && ( *container_item == itemid ) ) {
         container_item = std::nullopt;
         on_overflow = overflow_behaviour::none;
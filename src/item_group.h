@@ -421,10 +421,18 @@ class Item_group : public Item_spawn_data
          * that this group contains.
          */
         int sum_prob;
+        /**
+         * Running totals of the entry probabilities: cumulative_prob[i] is the sum over
+         * items[0..i]. A distribution pick is a binary search in here.
+         */
+        std::vector<int> cumulative_prob;
         /**
          * Links to the entries in this group.
          */
         prop_list items;
+
+        /** Index of the G_DISTRIBUTION entry that roll @p p selects, items.size() if none. */
+        std::size_t distribution_entry( int p ) const;
 };
 
 #endif // CATA_SRC_ITEM_GROUP_H
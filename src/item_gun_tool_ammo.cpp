@@ -82,6 +82,9 @@
 class JsonObject;
 
 static const std::string GUN_MODE_VAR_NAME( "item::mode" );
+static const std::string var_dirt( "dirt" );
+static const std::string var_gun_heat( "gun_heat" );
+static const std::string var_rust_timer( "rust_timer" );
 
 static const ammotype ammo_battery( "battery" );
 static const ammotype ammo_bolt( "bolt" );
@@ -550,7 +553,7 @@ std::string item::dirt_symbol() const
     // these symbols are unicode square characters of different heights, representing a rough
     // estimation of fouling in a gun. This appears instead of "faulty" since most guns will
     // have some level of fouling in them, and usually it is not a big deal.
-    switch( static_cast<int>( get_var( "dirt", 0 ) / 2000 ) ) {
+    switch( static_cast<int>( get_var( var_dirt, 0 ) / 2000 ) ) {
         // *INDENT-OFF*
         case 1:  return "<color_white>\u2581</color>";
         case 2:  return "<color_light_gray>\u2583</color>";
@@ -577,7 +580,7 @@ std::string item::overheat_symbol() const
     if( has_fault( fault_overheat_safety ) ) {
         return string_format( _( "<color_light_green>\u2588VNT </color>" ) );
     }
-    switch( std::min( 5, static_cast<int>( get_var( "gun_heat",
+    switch( std::min( 5, static_cast<int>( get_var( var_gun_heat,
                                            0 ) / std::max( type->gun->overheat_threshold * multiplier + modifier, 5.0 ) * 5.0 ) ) ) {
         case 1:
             return "";
@@ -3159,13 +3162,13 @@ bool item::process_blackpowder_fouling( Character *carrier )
 {
     // Rust is deterministic. At a total modifier of 1 (the max): 12 hours for first rust, then 24 (36 total), then 36 (72 total) and finally 48 (120 hours to go to XX)
     // this speeds up by the amount the gun is dirty, 2-6x as fast depending on dirt level. At minimum dirt, the modifier is 0.3x the speed of the above mentioned figures.
-    set_var( "rust_timer", get_var( "rust_timer", 0 ) + std::min( 0.3 + get_var( "dirt", 0 ) / 200,
+    set_var( var_rust_timer, get_var( var_rust_timer, 0 ) + std::min( 0.3 + get_var( var_dirt, 0 ) / 200,
              1.0 ) );
     double time_mult = 1.0 + ( 4.0 * static_cast<double>( damage() ) ) / static_cast<double>
                        ( max_damage() );
-    if( damage() < max_damage() && get_var( "rust_timer", 0 ) > 43200.0 * time_mult ) {
+    if( damage() < max_damage() && get_var( var_rust_timer, 0 ) > 43200.0 * time_mult ) {
         inc_damage();
-        set_var( "rust_timer", 0 );
+        set_var( var_rust_timer, 0 );
         if( carrier ) {
             carrier->add_msg_if_player( m_bad, _( "Your %s rusts due to corrosive powder fouling." ), tname() );
         }
@@ -3175,7 +3178,7 @@ bool item::process_blackpowder_fouling( Character *carrier )
 
 bool item::process_gun_cooling( Character *carrier )
 {
-    double heat = get_var( "gun_heat", 0 );
+    double heat = get_var( var_gun_heat, 0 );
     double overheat_modifier = 0;
     float overheat_multiplier = 1.0f;
     double cooling_modifier = 0;
@@ -3189,7 +3192,7 @@ bool item::process_gun_cooling( Character *carrier )
     double threshold = std::max( ( type->gun->overheat_threshold * overheat_multiplier ) +
                                  overheat_modifier, 5.0 );
     heat -= std::max( ( type->gun->cooling_value * cooling_multiplier ) + cooling_modifier, 0.5 );
-    set_var( "gun_heat", std::max( 0.0, heat ) );
+    set_var( var_gun_heat, std::max( 0.0, heat ) );
     if( has_fault( fault_overheat_safety ) && heat < threshold * 0.2 ) {
         remove_fault( fault_overheat_safety );
         if( carrier ) {
@@ -28,11 +28,13 @@
 #include "magic_enchantment.h"
 #include "map.h"
 #include "map_selector.h"
+#include "mapbuffer.h"
 #include "pimpl.h"
 #include "point.h"
 #include "ret_val.h"
 #include "safe_reference.h"
 #include "string_formatter.h"
+#include "submap.h"
 #include "talker.h"
 #include "talker_item.h"
 #include "translations.h"
@@ -113,6 +115,12 @@ class item_location::impl
         virtual void on_contents_changed() = 0;
         virtual void serialize( JsonOut &js ) const = 0;
         virtual item *unpack( int ) const = 0;
+        /** Called when the item is handed out for writing, so its holder can tell it changed. */
+        virtual void note_write() const {}
+        /** The location at the outside of the chain of containers, the one that isn't in one. */
+        virtual const impl *root() const {
+            return this;
+        }
 
         item *target() const {
             ensure_unpacked();
@@ -233,6 +241,14 @@ class item_location::impl::item_on_map : public item_location::impl
             return retrieve_index( cur, idx );
         }
 
+        void note_write() const override {
+            // Edits made through here don't go through the submap, it would be saved as unchanged.
+            // Whichever map the cursor came from, the submap itself lives in the map buffer.
+            if( submap *sm = MAPBUFFER.lookup_submap( project_to<coords::sm>( cur.pos_abs() ) ) ) {
+                sm->note_unsaved_change();
+            }
+        }
+
         type where() const override {
             return type::map;
         }
@@ -622,6 +638,9 @@ class item_location::impl::item_in_container : public item_location::impl
     private:
         item_location container;
         mutable item_pocket *container_pkt = nullptr; // NOLINT(cata-serialize)
+        // A location never changes its container, so the chain is only walked the first time.
+        // An item moved somewhere else gets a location of its own.
+        mutable const impl *root_location = nullptr; // NOLINT(cata-serialize)
 
         // figures out the index for the item, which is where it is in the total list of contents
         // note: could be a better way of handling this?
@@ -646,6 +665,19 @@ class item_location::impl::item_in_container : public item_location::impl
             return container;
         }
 
+        void note_write() const override {
+            if( container ) {
+                root()->note_write();
+            }
+        }
+
+        const impl *root() const override {
+            if( root_location == nullptr ) {
+                root_location = container.ptr->root();
+            }
+            return root_location;
+        }
+
         item_pocket *parent_pocket() const override {
             if( container_pkt == nullptr ) {
                 std::vector<item_pocket *> const pkts = parent_item()->get_standard_pockets();
@@ -684,7 +716,7 @@ class item_location::impl::item_in_container : public item_location::impl
         }
 
         Character *carrier() const override {
-            return container.carrier();
+            return root()->carrier();
         }
 
         std::string describe( const Character * ) const override {
@@ -699,15 +731,15 @@ class item_location::impl::item_in_container : public item_location::impl
         }
 
         type where_recursive() const override {
-            return container.where_recursive();
+            return root()->where();
         }
 
         tripoint_bub_ms pos_bub( const map &here ) const override {
-            return container.pos_bub( here );
+            return root()->pos_bub( here );
         }
 
         tripoint_abs_ms pos_abs() const override {
-            return container.pos_abs();
+            return root()->pos_abs();
         }
 
         void remove_item() override {
@@ -838,6 +870,7 @@ item_location::operator bool() const
 
 item &item_location::operator*()
 {
+    ptr->note_write();
     return *ptr->target();
 }
 
@@ -848,6 +881,7 @@ const item &item_location::operator*() const
 
 item *item_location::operator->()
 {
+    ptr->note_write();
     return ptr->target();
 }
 
@@ -1186,6 +1220,7 @@ void item_location::make_active()
 
 item *item_location::get_item()
 {
+    ptr->note_write();
     return ptr->target();
 }
 
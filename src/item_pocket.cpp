@@ -1,6 +1,7 @@
 #include "item_pocket.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
@@ -51,6 +52,11 @@
 
 static const itype_id itype_water( "water" );
 
+// Generations are unique across threads, a pocket cached on one thread never looks valid on another.
+static std::atomic<int> aggregate_generation_counter{ 0 };
+static thread_local int aggregate_scope_depth = 0;
+static thread_local int active_aggregate_generation = 0;
+
 namespace io
 {
 // *INDENT-OFF*
@@ -263,8 +269,43 @@ bool item_pocket::same_contents( const item_pocket &rhs ) const
     } );
 }
 
+item_pocket::aggregate_scope::aggregate_scope()
+{
+    if( aggregate_scope_depth++ == 0 ) {
+        active_aggregate_generation = aggregate_generation_counter.fetch_add( 1 ) + 1;
+    }
+}
+
+item_pocket::aggregate_scope::~aggregate_scope()
+{
+    if( --aggregate_scope_depth == 0 ) {
+        active_aggregate_generation = 0;
+    }
+}
+
+void item_pocket::invalidate_aggregates()
+{
+    if( aggregate_scope_depth > 0 ) {
+        // Pockets don't know their parents, so drop the whole tree rather than just the chain.
+        active_aggregate_generation = aggregate_generation_counter.fetch_add( 1 ) + 1;
+    }
+}
+
+item_pocket::aggregate_cache *item_pocket::current_aggregates() const
+{
+    if( active_aggregate_generation == 0 ) {
+        return nullptr;
+    }
+    if( aggregates.generation != active_aggregate_generation ) {
+        aggregates = aggregate_cache();
+        aggregates.generation = active_aggregate_generation;
+    }
+    return &aggregates;
+}
+
 void item_pocket::restack()
 {
+    invalidate_aggregates();
     if( contents.size() <= 1 ) {
         return;
     }
@@ -309,6 +350,7 @@ void item_pocket::restack()
 
 item *item_pocket::restack( /*const*/ item *it )
 {
+    invalidate_aggregates();
     item *ret = it;
     if( contents.size() <= 1 ) {
         return ret;
@@ -445,9 +487,11 @@ bool item_pocket::better_pocket( const item_pocket &rhs, const item &it, bool ne
         return rhs.data->rigid;
     }
 
-    if( remaining_volume() != rhs.remaining_volume() ) {
+    const units::volume our_remaining = remaining_volume();
+    const units::volume rhs_remaining = rhs.remaining_volume();
+    if( our_remaining != rhs_remaining ) {
         // we want the least amount of remaining volume
-        return rhs.remaining_volume() < remaining_volume();
+        return rhs_remaining < our_remaining;
     }
 
     return rhs.obtain_cost( it ) < obtain_cost( it );
@@ -566,6 +610,7 @@ const item &item_pocket::front() const
 
 void item_pocket::pop_back()
 {
+    invalidate_aggregates();
     contents.pop_back();
 }
 
@@ -623,17 +668,29 @@ units::volume item_pocket::item_size_modifier() const
     if( data->rigid ) {
         return 0_ml;
     }
+    aggregate_cache *cache = current_aggregates();
+    if( cache && cache->item_size_modifier ) {
+        return *cache->item_size_modifier;
+    }
     units::volume total_vol = 0_ml;
     for( const item &it : contents ) {
         total_vol += it.volume( is_type( pocket_type::MOD ) );
     }
     total_vol -= data->magazine_well;
     total_vol *= data->volume_multiplier;
-    return std::max( 0_ml, total_vol );
+    total_vol = std::max( 0_ml, total_vol );
+    if( cache ) {
+        cache->item_size_modifier = total_vol;
+    }
+    return total_vol;
 }
 
 units::mass item_pocket::item_weight_modifier() const
 {
+    aggregate_cache *cache = current_aggregates();
+    if( cache && cache->item_weight_modifier ) {
+        return *cache->item_weight_modifier;
+    }
     units::mass total_mass = 0_gram;
     for( const item &it : contents ) {
         if( is_type( pocket_type::MOD ) ) {
@@ -642,6 +699,9 @@ units::mass item_pocket::item_weight_modifier() const
             total_mass += it.weight() * data->weight_multiplier;
         }
     }
+    if( cache ) {
+        cache->item_weight_modifier = total_mass;
+    }
     return total_mass;
 }
 
@@ -727,6 +787,7 @@ itype_id item_pocket::magazine_default() const
 
 int item_pocket::ammo_consume( int qty )
 {
+    invalidate_aggregates();
     int need = qty;
     int used = 0;
     std::list<item>::iterator it;
@@ -787,6 +848,7 @@ std::set<ammotype> item_pocket::ammo_types() const
 
 void item_pocket::casings_handle( const std::function<bool( item & )> &func )
 {
+    invalidate_aggregates();
     for( auto it = contents.begin(); it != contents.end(); ) {
         if( it->has_flag( flag_CASING ) ) {
             it->unset_flag( flag_CASING );
@@ -803,6 +865,7 @@ void item_pocket::casings_handle( const std::function<bool( item & )> &func )
 
 void item_pocket::handle_liquid_or_spill( Character &guy, const item *avoid )
 {
+    invalidate_aggregates();
     if( guy.is_npc() ) {
         spill_contents( guy.pos_bub() );
         return;
@@ -831,6 +894,7 @@ void item_pocket::handle_liquid_or_spill( Character &guy, const item *avoid )
 
 bool item_pocket::use_amount( const itype_id &it, int &quantity, std::list<item> &used )
 {
+    invalidate_aggregates();
     bool used_item = false;
     for( auto a = contents.begin(); a != contents.end() && quantity > 0; ) {
         if( a->use_amount( it, quantity, used ) ) {
@@ -909,6 +973,7 @@ std::string item_pocket::translated_sealed_prefix() const
 
 bool item_pocket::detonate( const tripoint_bub_ms &pos, std::vector<item> &drops )
 {
+    invalidate_aggregates();
     const auto new_end = std::remove_if( contents.begin(), contents.end(), [&pos, &drops]( item & it ) {
         return it.detonate( pos, drops );
     } );
@@ -923,6 +988,7 @@ bool item_pocket::detonate( const tripoint_bub_ms &pos, std::vector<item> &drops
 
 void item_pocket::remove_all_ammo( Character &guy )
 {
+    invalidate_aggregates();
     for( auto iter = contents.begin(); iter != contents.end(); ) {
         if( iter->is_irremovable() ) {
             iter++;
@@ -935,6 +1001,7 @@ void item_pocket::remove_all_ammo( Character &guy )
 
 void item_pocket::remove_all_mods( Character &guy )
 {
+    invalidate_aggregates();
     for( auto iter = contents.begin(); iter != contents.end(); ) {
         if( iter->is_toolmod() ) {
             guy.i_add_or_drop( *iter );
@@ -1596,10 +1663,18 @@ ret_val<item_pocket::contain_code> item_pocket::_can_contain( const item &it,
     }
 
     int fallback_capacity = it.count_by_charges() ? it.charges : copies_remaining;
-    int copy_weight_capacity = weight <= 0_gram ? fallback_capacity :
-                               charges_per_remaining_weight( it );
-    int copy_volume_capacity = volume <= 0_ml ? fallback_capacity :
-                               charges_per_remaining_volume( it );
+    int copy_weight_capacity = fallback_capacity;
+    int copy_volume_capacity = fallback_capacity;
+    if( weight > 0_gram || volume > 0_ml ) {
+        // One pass over the contents, stacks_with() is not cheap.
+        const std::pair<int, int> copy_capacity = charges_per_remaining_weight_and_volume( it );
+        if( weight > 0_gram ) {
+            copy_weight_capacity = copy_capacity.first;
+        }
+        if( volume > 0_ml ) {
+            copy_volume_capacity = copy_capacity.second;
+        }
+    }
 
     if( copy_weight_capacity < it.count() ) {
         return ret_val<item_pocket::contain_code>::make_failure(
@@ -1734,6 +1809,7 @@ std::optional<item> item_pocket::remove_item( const item &it )
 {
     item ret( it );
     const size_t sz = contents.size();
+    invalidate_aggregates();
     contents.remove_if( [&it]( const item & rhs ) {
         return &rhs == &it;
     } );
@@ -1747,6 +1823,7 @@ std::optional<item> item_pocket::remove_item( const item &it )
 bool item_pocket::remove_internal( const std::function<bool( item & )> &filter,
                                    int &count, std::list<item> &res )
 {
+    invalidate_aggregates();
     for( auto it = contents.begin(); it != contents.end(); ) {
         if( filter( *it ) ) {
             res.splice( res.end(), contents, it++ );
@@ -1803,6 +1880,7 @@ static void move_to_parent_pocket_recursive( map &here, const tripoint_bub_ms &p
 
 void item_pocket::overflow( map &here, const tripoint_bub_ms &pos, const item_location &loc )
 {
+    invalidate_aggregates();
     if( is_type( pocket_type::MOD ) || is_type( pocket_type::CORPSE ) ||
         is_type( pocket_type::CABLE ) ||
         is_type( pocket_type::E_FILE_STORAGE ) ) {
@@ -1943,12 +2021,14 @@ bool item_pocket::spill_contents( map *here, const tripoint_bub_ms &pos )
     }
 
     contents.clear();
+    invalidate_aggregates();
     return true;
 }
 
 void item_pocket::clear_items()
 {
     contents.clear();
+    invalidate_aggregates();
 }
 
 bool item_pocket::has_item( const item &it ) const
@@ -1989,6 +2069,7 @@ void item_pocket::process( map &here, Character *carrier, const tripoint_bub_ms
                            float insulation,
                            temperature_flag flag, float spoil_multiplier_parent, bool watertight_container )
 {
+    invalidate_aggregates();
     for( auto iter = contents.begin(); iter != contents.end(); ) {
         if( iter->process( here, carrier, pos, insulation, flag,
                            // spoil multipliers on pockets are not additive or multiplicative, they choose the best
@@ -2005,6 +2086,7 @@ void item_pocket::process( map &here, Character *carrier, const tripoint_bub_ms
 void item_pocket::leak( map &here, Character *carrier, const tripoint_bub_ms &pos,
                         item_pocket *pocke )
 {
+    invalidate_aggregates();
     std::vector<item *> erases;
     for( auto iter = contents.begin(); iter != contents.end(); ) {
         if( iter->leak( here, carrier, pos, this ) ) {
@@ -2156,6 +2238,7 @@ void item_pocket::add( const item &it, item **ret )
 
 void item_pocket::add( const item &it, const int copies, std::vector<item *> &added )
 {
+    invalidate_aggregates();
     for( auto iter = contents.insert( contents.end(), copies, it ); iter != contents.end(); iter++ ) {
         added.push_back( &*iter );
     }
@@ -2221,6 +2304,8 @@ int item_pocket::fill_with( const item &contained, Character &guy, int amount,
 
 std::list<item> &item_pocket::edit_contents()
 {
+    // the caller may change anything in here
+    invalidate_aggregates();
     return contents;
 }
 
@@ -2241,6 +2326,7 @@ ret_val<item *> item_pocket::insert_item( const item &it,
         contents.push_back( it );
         inserted = &contents.back();
     }
+    invalidate_aggregates();
     if( restack_charges ) {
         inserted = restack( inserted );
     }
@@ -2332,19 +2418,33 @@ units::length item_pocket::min_containable_length() const
 
 units::volume item_pocket::contents_volume() const
 {
+    aggregate_cache *cache = current_aggregates();
+    if( cache && cache->contents_volume ) {
+        return *cache->contents_volume;
+    }
     units::volume vol = 0_ml;
     for( const item &it : contents ) {
         vol += it.volume();
     }
+    if( cache ) {
+        cache->contents_volume = vol;
+    }
     return vol;
 }
 
 units::mass item_pocket::contains_weight() const
 {
+    aggregate_cache *cache = current_aggregates();
+    if( cache && cache->contains_weight ) {
+        return *cache->contains_weight;
+    }
     units::mass weight = 0_gram;
     for( const item &it : contents ) {
         weight += it.weight();
     }
+    if( cache ) {
+        cache->contains_weight = weight;
+    }
     return weight;
 }
 
@@ -2389,6 +2489,24 @@ int item_pocket::charges_per_remaining_weight( const item &it ) const
     }
 }
 
+std::pair<int, int> item_pocket::charges_per_remaining_weight_and_volume( const item &it ) const
+{
+    units::mass non_it_weight = weight_capacity();
+    units::volume non_it_volume = volume_capacity();
+    int contained_charges = 0;
+    const bool by_charges = it.count_by_charges();
+    for( const item &contained : contents ) {
+        if( by_charges && contained.stacks_with( it ) ) {
+            contained_charges += contained.charges;
+        } else {
+            non_it_weight -= contained.weight();
+            non_it_volume -= contained.volume();
+        }
+    }
+    return { it.charges_per_weight( non_it_weight, true ) - contained_charges,
+             it.charges_per_volume( non_it_volume, true ) - contained_charges };
+}
+
 int item_pocket::best_quality( const quality_id &id ) const
 {
     int ret = 0;
@@ -2400,6 +2518,7 @@ int item_pocket::best_quality( const quality_id &id ) const
 
 void item_pocket::heat_up()
 {
+    invalidate_aggregates();
     for( item &it : contents ) {
         if( it.has_temperature() ) {
             it.heat_up();
@@ -226,11 +226,31 @@ class item_pocket
         // `it.charges_per_weight( pocket.remaining_weight() )`
         int charges_per_remaining_volume( const item &it ) const;
         int charges_per_remaining_weight( const item &it ) const;
+        // both of the above, { weight, volume }, in a single walk over the contents
+        std::pair<int, int> charges_per_remaining_weight_and_volume( const item &it ) const;
 
         units::volume item_size_modifier() const;
         units::mass item_weight_modifier() const;
         units::length item_length_modifier() const;
 
+        /**
+         * While one of these is alive, the aggregates above (contents_volume, contains_weight,
+         * item_size_modifier and item_weight_modifier) are computed once per pocket on this
+         * thread and reused, so nested queries over deep container trees don't walk the whole
+         * tree again for every level. Scopes nest; only the outermost one matters.
+         * Any change to pocket contents drops everything cached by the open scope.
+         */
+        class aggregate_scope
+        {
+            public:
+                aggregate_scope();
+                ~aggregate_scope();
+                aggregate_scope( const aggregate_scope & ) = delete;
+                aggregate_scope &operator=( const aggregate_scope & ) = delete;
+        };
+        // Drops the aggregates cached by the open aggregate_scope, if any.
+        static void invalidate_aggregates();
+
         /** gets the spoilage multiplier depending on sealed data */
         float spoil_multiplier() const;
 
@@ -428,6 +448,18 @@ class item_pocket
         // list of sub body parts that can't currently support rigid ablative armor
         std::set<sub_bodypart_id> no_rigid;
 
+        struct aggregate_cache {
+            // the aggregate_scope generation these values belong to, 0 for none
+            int generation = 0;
+            std::optional<units::volume> contents_volume;
+            std::optional<units::mass> contains_weight;
+            std::optional<units::volume> item_size_modifier;
+            std::optional<units::mass> item_weight_modifier;
+        };
+        mutable aggregate_cache aggregates; // NOLINT(cata-serialize)
+        // the cache for the open aggregate_scope, nullptr if there is none
+        aggregate_cache *current_aggregates() const;
+
         ret_val<contain_code> _can_contain( const item &it, int &copies_remaining,
                                             bool ignore_contents ) const;
 };
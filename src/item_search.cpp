@@ -93,12 +93,14 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
                 return i.type->has_any_quality( filter );
             };
         // both
-        case 'b':
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                return item_filter_from_string( pair.first )( i )
-                       && item_filter_from_string( pair.second )( i );
+        case 'b': {
+            const std::pair<std::string, std::string> pair = get_both( filter );
+            const std::function<bool( const item & )> first = item_filter_from_string( pair.first );
+            const std::function<bool( const item & )> second = item_filter_from_string( pair.second );
+            return [first, second]( const item & i ) {
+                return first( i ) && second( i );
             };
+        }
         // disassembled components
         case 'd':
             return [filter]( const item & i ) {
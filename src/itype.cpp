@@ -387,7 +387,8 @@ bool armor_portion_data::should_consolidate( const armor_portion_data &l,
            l.layers == r.layers;
 }
 
-int armor_portion_data::calc_encumbrance( units::mass weight, bodypart_id bp ) const
+std::optional<int> armor_portion_data::calc_encumbrance( units::mass weight,
+        bodypart_id bp ) const
 {
     // this function takes some fixed points for mass to encumbrance and interpolates them to get results for head encumbrance
     // TODO: Generalize this for other body parts (either with a modifier or separated point graphs)
@@ -400,8 +401,7 @@ int armor_portion_data::calc_encumbrance( units::mass weight, bodypart_id bp ) c
     std::map<units::mass, int>::iterator itt = mass_to_encumbrance.lower_bound( weight );
 
     if( itt == mass_to_encumbrance.begin() || itt == mass_to_encumbrance.end() ) {
-        debugmsg( "Can't find a notable point to match this with" );
-        return 100;
+        return std::nullopt;
     }
 
     // get the bound below our given weight
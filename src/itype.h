@@ -409,7 +409,8 @@ struct armor_portion_data {
     static bool should_consolidate( const armor_portion_data &l, const armor_portion_data &r );
 
     // helper function to return encumbrance value by descriptor and weight
-    int calc_encumbrance( units::mass weight, bodypart_id bp ) const;
+    // returns nothing if the weight falls outside the body part's encumbrance table
+    std::optional<int> calc_encumbrance( units::mass weight, bodypart_id bp ) const;
 
     // converts a specific encumbrance modifier to an actual encumbrance value
     static std::tuple<encumbrance_modifier_type, int> convert_descriptor_to_val(
@@ -1,13 +1,20 @@
 #include "json_loader.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "filesystem.h"
 #include "flexbuffer_cache.h"
 #include "flexbuffer_json.h"
 #include "path_info.h"
+#include "thread_pool.h"
 
 namespace
 {
@@ -112,6 +119,9 @@ std::optional<JsonValue> from_path_at_offset_opt_impl( const cata_path &source_f
     return JsonValue( std::move( buffer ), buffer_root, nullptr, 0 );
 }
 
+// How many files from_paths parses ahead, which bounds how many parsed files it holds at once.
+constexpr size_t parse_ahead_batch = 64;
+
 } // namespace
 
 std::optional<JsonValue> json_loader::from_path_at_offset_opt( const cata_path &source_file,
@@ -150,6 +160,101 @@ JsonValue json_loader::from_path( const cata_path &source_file ) noexcept( false
     return from_path_at_offset( source_file, 0 );
 }
 
+void json_loader::from_paths( const std::vector<cata_path> &source_files,
+                              const std::function<void( const cata_path &, const JsonValue & )> &fn,
+                              const std::string &snapshot_name ) noexcept( false )
+{
+    std::optional<flexbuffer_snapshot::writer> snapshot_writer;
+    if( !snapshot_name.empty() && !source_files.empty() ) {
+        std::vector<std::filesystem::path> paths;
+        bool all_cached = true;
+        for( const cata_path &file : source_files ) {
+            cata_path lexically_normal_path = file.lexically_normal();
+            all_cached &= lexically_normal_path.get_logical_root() != cata_path::root_path::unknown;
+            paths.emplace_back( lexically_normal_path.get_unrelative_path() );
+        }
+        const std::filesystem::path snapshot_path = all_cached ?
+                cache_for_lexically_normal_path( source_files.front().lexically_normal() ).snapshot_path(
+                    snapshot_name ) : std::filesystem::path();
+        const uint64_t key = snapshot_path.empty() ? 0 : flexbuffer_snapshot::key_for( paths );
+        if( key != 0 ) {
+            std::optional<flexbuffer_snapshot> snapshot = flexbuffer_snapshot::open( snapshot_path, key );
+            if( snapshot && snapshot->size() == source_files.size() ) {
+                for( size_t i = 0; i < source_files.size(); ++i ) {
+                    std::shared_ptr<parsed_flexbuffer> buffer = snapshot->get( i, paths[i] );
+                    flexbuffers::Reference buffer_root = flexbuffer_root_from_storage( buffer->get_storage() );
+                    fn( source_files[i], JsonValue( std::move( buffer ), buffer_root, nullptr, 0 ) );
+                }
+                return;
+            }
+            snapshot_writer.emplace( snapshot_path, key );
+        }
+    }
+
+    struct pending_file {
+        cata_path lexically_normal_path;
+        flexbuffer_cache *cache = nullptr;
+        std::shared_ptr<parsed_flexbuffer> buffer;
+        std::vector<uint8_t> parsed;
+        std::exception_ptr error;
+    };
+
+    for( size_t batch_begin = 0; batch_begin < source_files.size();
+         batch_begin += parse_ahead_batch ) {
+        const size_t batch_end = std::min( source_files.size(), batch_begin + parse_ahead_batch );
+        std::vector<pending_file> batch( batch_end - batch_begin );
+
+        // Cache lookups may warn about stale data, so they stay on this thread.
+        for( size_t i = 0; i < batch.size(); ++i ) {
+            pending_file &file = batch[i];
+            file.lexically_normal_path = source_files[batch_begin + i].lexically_normal();
+            if( file.lexically_normal_path.get_logical_root() != cata_path::root_path::unknown ) {
+                file.cache = &cache_for_lexically_normal_path( file.lexically_normal_path );
+                file.buffer = file.cache->find_cached( file.lexically_normal_path.get_unrelative_path() );
+            }
+        }
+
+        cata::get_thread_pool().parallel_for( 0, static_cast<int>( batch.size() ), [&]( int i ) {
+            pending_file &file = batch[i];
+            if( file.buffer || !file.cache ) {
+                return;
+            }
+            try {
+                const std::filesystem::path path = file.lexically_normal_path.get_unrelative_path();
+                if( !file_exist( path ) ) {
+                    throw JsonError( path.generic_u8string() + " does not exist." );
+                }
+                file.parsed = flexbuffer_cache::parse_to_flexbuffer( path );
+            } catch( ... ) {
+                file.error = std::current_exception();
+            }
+        } );
+
+        for( size_t i = 0; i < batch.size(); ++i ) {
+            pending_file &file = batch[i];
+            if( file.error ) {
+                std::rethrow_exception( file.error );
+            }
+            if( !file.cache ) {
+                fn( source_files[batch_begin + i], from_path( source_files[batch_begin + i] ) );
+                continue;
+            }
+            if( !file.buffer ) {
+                file.buffer = file.cache->cache_parsed( file.lexically_normal_path.get_unrelative_path(),
+                                                        std::move( file.parsed ) );
+            }
+            if( snapshot_writer ) {
+                snapshot_writer->add( *file.buffer, file.lexically_normal_path.get_unrelative_path() );
+            }
+            flexbuffers::Reference buffer_root = flexbuffer_root_from_storage( file.buffer->get_storage() );
+            fn( source_files[batch_begin + i], JsonValue( std::move( file.buffer ), buffer_root, nullptr, 0 ) );
+        }
+    }
+    if( snapshot_writer ) {
+        snapshot_writer->finish();
+    }
+}
+
 JsonValue json_loader::from_string( std::string data ) noexcept( false )
 {
     std::shared_ptr<parsed_flexbuffer> buffer = flexbuffer_cache::parse_buffer( std::move( data ) );
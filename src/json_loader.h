@@ -2,6 +2,10 @@
 #ifndef CATA_SRC_JSON_LOADER_H
 #define CATA_SRC_JSON_LOADER_H
 
+#include <functional>
+#include <string>
+#include <vector>
+
 #include "path_info.h"
 #include "flexbuffer_json.h"
 
@@ -20,6 +24,16 @@ class json_loader
         static std::optional<JsonValue> from_path_at_offset_opt( const cata_path &source_file,
                 size_t offset = 0 ) noexcept( false );
 
+        // Like json_loader::from_path for each of the given files in turn, handing each to fn on
+        // the calling thread in order. Files not already in the flexbuffer cache are parsed
+        // ahead in batches on the shared thread pool. Throws the error of the first file that
+        // fails once fn has seen all the files before it.
+        // With a snapshot_name, a flexbuffer_snapshot of all the files is kept under that name.
+        // While none of the files change, later calls map it instead of loading each file.
+        static void from_paths( const std::vector<cata_path> &source_files,
+                                const std::function<void( const cata_path &, const JsonValue & )> &fn,
+                                const std::string &snapshot_name = {} ) noexcept( false );
+
         // Like json_loader::from_path, except instead of parsing data from a file, will parse data from a string in memory.
         static JsonValue from_string( std::string data ) noexcept( false );
         static std::optional<JsonValue> from_string_opt( std::string const &data ) noexcept( false );
@@ -106,6 +106,12 @@ static Character *get_avatar_or_follower( const character_id &id )
 // Legacy value, maintained until kill_xp rework/removal from dependent in-repo mods
 static constexpr int npc_kill_xp = 10;
 
+bool kill_tracker::notified_by( event_type type ) const
+{
+    return type == event_type::character_kills_monster ||
+           type == event_type::character_kills_character;
+}
+
 void kill_tracker::notify( const cata::event &e )
 {
     switch( e.type() ) {
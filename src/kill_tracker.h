@@ -33,6 +33,7 @@ class kill_tracker : public event_subscriber
         void clear();
         using event_subscriber::notify;
         void notify( const cata::event & ) override;
+        bool notified_by( event_type type ) const override;
 
         void serialize( JsonOut & ) const;
         void deserialize( const JsonObject &data );
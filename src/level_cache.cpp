@@ -15,8 +15,8 @@ level_cache::level_cache()
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
-    std::fill_n( &outside_cache[0][0], map_dimensions, false );
-    std::fill_n( &floor_cache[0][0], map_dimensions, false );
+    outside_cache.fill( false );
+    floor_cache.fill( false );
     std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &vision_transparency_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
@@ -67,6 +67,28 @@ void level_cache::clear_vehicle_cache()
     veh_cache_cleared = true;
 }
 
+void level_cache::shift_vehicle_cache( const tripoint_rel_ms &offset,
+                                       const std::unordered_set<const vehicle *> &leaving )
+{
+    if( veh_cache_cleared ) {
+        return;
+    }
+    std::unordered_map<tripoint_bub_ms, std::pair<vehicle *, int>> shifted;
+    shifted.reserve( veh_cached_parts.size() );
+    veh_exists_at.reset();
+    for( const std::pair<const tripoint_bub_ms, std::pair<vehicle *, int>> &part : veh_cached_parts ) {
+        if( leaving.count( part.second.first ) ) {
+            continue;
+        }
+        const tripoint_bub_ms pt = part.first + offset;
+        shifted.emplace( pt, part.second );
+        if( pt.x() >= 0 && pt.x() < MAPSIZE_X && pt.y() >= 0 && pt.y() < MAPSIZE_Y ) {
+            veh_exists_at[pt.x() * MAPSIZE_X + pt.y()] = true;
+        }
+    }
+    veh_cached_parts = std::move( shifted );
+}
+
 void level_cache::clear_veh_from_veh_cached_parts( const tripoint_bub_ms &pt, vehicle *veh )
 {
     auto it = veh_cached_parts.find( pt );
@@ -6,7 +6,9 @@
 #include <bitset>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <stdint.h>
 
@@ -19,6 +21,22 @@
 class vehicle;
 enum class lit_level : uint8_t;
 
+// Light cast by one buffered light source (see map::generate_lightmap), kept between turns so
+// that lamps and fires whose surroundings didn't change are merged back in instead of recast.
+struct light_source_contribution {
+    float luminance = 0.0f;
+    // Bitmask of the octant pairs that were cast, see map::apply_buffered_light_source
+    uint8_t directions = 0;
+    // Value of level_cache::transparency_generation when the light was cast
+    uint64_t generation = 0;
+    // Set when the source was seen during the current generate_lightmap
+    bool used = false;
+    // Covered area; light is stored row by row along y
+    point_bub_ms min;
+    point_bub_ms max;
+    std::vector<four_quadrants> light;
+};
+
 struct level_cache {
     public:
         // Zeros all relevant values
@@ -26,6 +44,14 @@ struct level_cache {
         level_cache( const level_cache &other ) = default;
 
         std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
+        // submaps where build_vision_transparency_cache last overrode tiles that are not
+        // derived from the submap itself (player tile, cover while crouching); they are
+        // recopied on the next build even if their transparency did not change
+        std::bitset<MAPSIZE *MAPSIZE> vision_transparency_adjusted;
+        // Bumped every time build_transparency_cache rebuilds some part of this level; each
+        // submap remembers the generation it was last rebuilt in.
+        uint64_t transparency_generation = 0;
+        std::array<uint64_t, MAPSIZE *MAPSIZE> transparency_changed_at = {};
         bool outside_cache_dirty = false;
         bool floor_cache_dirty = false;
         bool seen_cache_dirty = false;
@@ -43,13 +69,13 @@ struct level_cache {
 
         // if false, means tile is under the roof ("inside"), true means tile is "outside"
         // "inside" tiles are protected from sun, rain, etc. (see ter_furn_flag::TFLAG_INDOORS flag)
-        cata::mdarray<bool, point_bub_ms> outside_cache;
+        cata::mdbitset<point_bub_ms> outside_cache;
 
         // true when vehicle below has "ROOF" or "OPAQUE" part, furniture below has ter_furn_flag::TFLAG_SUN_ROOF_ABOVE
         //      or terrain doesn't have ter_furn_flag::TFLAG_NO_FLOOR flag
         // false otherwise
         // i.e. true == has floor
-        cata::mdarray<bool, point_bub_ms> floor_cache;
+        cata::mdbitset<point_bub_ms> floor_cache;
 
         // stores cached transparency of the tiles
         // units: "transparency" (see LIGHT_TRANSPARENCY_OPEN_AIR)
@@ -80,6 +106,11 @@ struct level_cache {
         std::bitset<MAPSIZE_X *MAPSIZE_Y> map_memory_cache_ter;
         std::bitset<MAPSIZE *MAPSIZE> field_cache;
 
+        // Cached light of buffered light sources by position, only valid while the map
+        // origin is light_source_contributions_origin
+        std::unordered_map<point_bub_ms, light_source_contribution> light_source_contributions;
+        tripoint_abs_sm light_source_contributions_origin;
+
         std::set<vehicle *> vehicle_list;
         std::set<vehicle *> zone_vehicles;
 
@@ -91,6 +122,10 @@ struct level_cache {
         void set_veh_cached_parts( const tripoint_bub_ms &pt, vehicle &veh, int part_num );
 
         void clear_vehicle_cache();
+        // Moves the cached parts by offset after the map shifted, and drops those of
+        // the vehicles in leaving. The same as rebuilding it, without the rebuild.
+        void shift_vehicle_cache( const tripoint_rel_ms &offset,
+                                  const std::unordered_set<const vehicle *> &leaving );
         void clear_veh_from_veh_cached_parts( const tripoint_bub_ms &pt, vehicle *veh );
 
     private:
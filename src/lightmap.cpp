@@ -1,6 +1,7 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
 #include <cstdlib>
@@ -34,6 +35,7 @@
 #include "monster.h"
 #include "mtype.h"
 #include "npc.h"
+#include "perf.h"
 #include "point.h"
 #include "string_formatter.h"
 #include "submap.h"
@@ -97,8 +99,13 @@ void map::add_light_from_items( const tripoint_bub_ms &p, const item_stack &item
     }
 }
 
-// TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
+{
+    return build_transparency_cache( zlev, get_weather().weather_id->sight_penalty );
+}
+
+// TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
+bool map::build_transparency_cache( const int zlev, const float sight_penalty )
 {
     level_cache &map_cache = get_cache( zlev );
     auto &transparent_cache_wo_fields = map_cache.transparent_cache_wo_fields;
@@ -111,6 +118,7 @@ bool map::build_transparency_cache( const int zlev )
 
     // if true, all submaps are invalid (can use batch init)
     bool rebuild_all = map_cache.transparency_cache_dirty.all();
+    const uint64_t generation = ++map_cache.transparency_generation;
 
     if( rebuild_all ) {
         // Default to just barely not transparent.
@@ -121,8 +129,6 @@ bool map::build_transparency_cache( const int zlev )
         }
     }
 
-    const float sight_penalty = get_weather().weather_id->sight_penalty;
-
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
@@ -138,6 +144,7 @@ bool map::build_transparency_cache( const int zlev )
             if( !rebuild_all && !map_cache.transparency_cache_dirty[smx * MAPSIZE + smy] ) {
                 continue;
             }
+            map_cache.transparency_changed_at[smx * MAPSIZE + smy] = generation;
 
             // calculates transparency of a single tile
             // x,y - coords in map local coords
@@ -216,8 +223,32 @@ bool map::build_vision_transparency_cache( int zlev )
     const cata::mdarray<float, point_bub_ms> &transparency_cache = map_cache.transparency_cache;
     cata::mdarray<float, point_bub_ms> &vision_transparency_cache = map_cache.vision_transparency_cache;
 
-    // TODO: Should only copy if transparency_cache was dirty
-    memcpy( &vision_transparency_cache, &transparency_cache, sizeof( transparency_cache ) );
+    // Only the dirty submaps and those holding last build's overrides need a fresh copy.
+    const std::bitset<MAPSIZE *MAPSIZE> recopy = map_cache.transparency_cache_dirty |
+            map_cache.vision_transparency_adjusted;
+    if( recopy.all() ) {
+        memcpy( &vision_transparency_cache, &transparency_cache, sizeof( transparency_cache ) );
+    } else {
+        for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+            for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+                if( !recopy[smx * MAPSIZE + smy] ) {
+                    continue;
+                }
+                for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; ++x ) {
+                    std::copy_n( &transparency_cache[x][smy * SEEY], SEEY,
+                                 &vision_transparency_cache[x][smy * SEEY] );
+                }
+            }
+        }
+    }
+    map_cache.vision_transparency_adjusted.reset();
+    const auto mark_adjusted = [&]( const tripoint_bub_ms & loc ) {
+        if( !inbounds( loc ) ) {
+            return;
+        }
+        const point_bub_sm smp = coords::project_to<coords::sm>( loc.xy() );
+        map_cache.vision_transparency_adjusted.set( smp.x() * MAPSIZE + smp.y() );
+    };
 
     const Character &player_character = get_player_character();
     const tripoint_bub_ms p = player_character.pos_bub();
@@ -243,6 +274,7 @@ bool map::build_vision_transparency_cache( int zlev )
                     // If we're crouching or prone behind an obstacle, we can't see past it.
                     dirty |= vision_transparency_cache[loc.x()][loc.y()] != LIGHT_TRANSPARENCY_SOLID;
                     vision_transparency_cache[loc.x()][loc.y()] = LIGHT_TRANSPARENCY_SOLID;
+                    mark_adjusted( loc );
                 }
             }
         }
@@ -258,7 +290,7 @@ bool map::build_vision_transparency_cache( int zlev )
                           zlev );
                 continue;
             }
-            if( !map_cache.transparency_cache_dirty[smx * MAPSIZE + smy] ) {
+            if( !recopy[smx * MAPSIZE + smy] ) {
                 continue;
             }
             for( int smi = 0; smi < SEEX; smi++ ) {
@@ -279,6 +311,7 @@ bool map::build_vision_transparency_cache( int zlev )
     // Shouldn't this be handled in the player's seen cache instead??
     if( is_player_z && inbounds( p ) ) {
         vision_transparency_cache[p.x()][p.y()] = LIGHT_TRANSPARENCY_OPEN_AIR;
+        mark_adjusted( p );
     }
 
     map_cache.transparency_cache_dirty.reset();
@@ -309,7 +342,12 @@ void map::apply_character_light( Character &p )
 // Once this is complete, additional operations add more dynamic lighting.
 void map::build_sunlight_cache( int pzlev )
 {
-    const int zlev_min = -OVERMAP_DEPTH;
+    // Levels below every active one have nothing simulated for the light to reach.
+    const std::bitset<OVERMAP_LAYERS> active = active_zlevels( pzlev );
+    int zlev_min = -OVERMAP_DEPTH;
+    while( zlev_min < pzlev && !active[zlev_min + OVERMAP_DEPTH] ) {
+        ++zlev_min;
+    }
     // Start at the topmost populated zlevel to avoid unnecessary raycasting
     // Plus one zlevel to prevent clipping inside structures
     const int zlev_max = clamp( calc_max_populated_zlev() + 1, std::min( pzlev + 1, OVERMAP_HEIGHT ),
@@ -446,6 +484,7 @@ void map::build_sunlight_cache( int pzlev )
 
 void map::generate_lightmap( const int zlev )
 {
+    CATA_TRACE_ZONE( "map::generate_lightmap" );
     level_cache &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -655,11 +694,25 @@ void map::generate_lightmap( const int zlev )
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
     */
+    if( map_cache.light_source_contributions_origin != abs_sub ) {
+        map_cache.light_source_contributions.clear();
+        map_cache.light_source_contributions_origin = abs_sub;
+    }
     const tripoint_bub_ms cache_start( 0, 0, zlev );
     const tripoint_bub_ms cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
     for( const tripoint_bub_ms &p : points_in_rectangle( cache_start, cache_end ) ) {
         if( light_source_buffer[p.x()][p.y()] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x()][p.y()] );
+            apply_buffered_light_source( p, light_source_buffer[p.x()][p.y()] );
+        }
+    }
+    // Forget the light of sources that went out or moved.
+    for( auto it = map_cache.light_source_contributions.begin();
+         it != map_cache.light_source_contributions.end(); ) {
+        if( it->second.used ) {
+            it->second.used = false;
+            ++it;
+        } else {
+            it = map_cache.light_source_contributions.erase( it );
         }
     }
     for( const std::pair<tripoint_bub_ms, float> &elem : lm_override ) {
@@ -916,6 +969,9 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
         delta.y = -distance;
         bool started_row = false;
         T current_transparency( 0.0 );
+        // Within a row calc() only varies with the distance, which neighbouring cells mostly
+        // share (always, without trigdist), so only evaluate it when the distance changes.
+        int intensity_dist = -1;
         float away = start - ( -distance + 0.5f ) / ( -distance -
                      0.5f ); //The distance between our first leadingEdge and start
 
@@ -939,7 +995,10 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
             }
 
             const int dist = rl_dist( tripoint::zero, delta ) + offsetDistance;
-            last_intensity = calc( numerator, cumulative_transparency, dist );
+            if( dist != intensity_dist ) {
+                intensity_dist = dist;
+                last_intensity = calc( numerator, cumulative_transparency, dist );
+            }
 
             T new_transparency = input_array[ current.x ][ current.y ];
 
@@ -1060,7 +1119,7 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
     // Cache the caches (pointers to them)
     array_of_grids_of<const float> transparency_caches;
     array_of_grids_of<float> seen_caches;
-    array_of_grids_of<const bool> floor_caches;
+    array_of_floor_caches floor_caches;
     vertical_direction directions_to_cast = vertical_direction::BOTH;
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         level_cache &cur_cache = get_cache( z );
@@ -1152,7 +1211,7 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
 }
 
 void map::seen_cache_process_ledges( array_of_grids_of<float> &seen_caches,
-                                     const array_of_grids_of<const bool> &floor_caches,
+                                     const array_of_floor_caches &floor_caches,
                                      const std::optional<tripoint_bub_ms> &override_p ) const
 {
     Character &player_character = get_player_character();
@@ -1218,29 +1277,30 @@ static bool light_check( const float &transparency, const float &intensity )
     return transparency > LIGHT_TRANSPARENCY_SOLID && intensity > LIGHT_AMBIENT_LOW;
 }
 
-void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
-{
-    level_cache &cache = get_cache( p.z() );
-    cata::mdarray<four_quadrants, point_bub_ms> &lm = cache.lm;
-    cata::mdarray<float, point_bub_ms> &sm = cache.sm;
-    cata::mdarray<float, point_bub_ms> &transparency_cache =
-        cache.transparency_cache;
-    cata::mdarray<float, point_bub_ms> &light_source_buffer =
-        cache.light_source_buffer;
+// Octant pairs cast by a light source, see apply_light_source_octants
+static constexpr uint8_t light_dir_north = 1;
+static constexpr uint8_t light_dir_east = 2;
+static constexpr uint8_t light_dir_south = 4;
+static constexpr uint8_t light_dir_west = 8;
 
-    const point_bub_ms p2( p.xy() );
-
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm[p2.x()][p2.y()] = elementwise_max( lm[p2.x()][p2.y()], min_light );
-        sm[p2.x()][p2.y()] = std::max( sm[p2.x()][p2.y()], luminance );
-    }
+// Applies the light a source casts onto its own tile. Returns false if it is too dim to cast
+// any further, otherwise luminance is adjusted to the value that should be cast.
+static bool apply_light_at_source( level_cache &cache, const point_bub_ms &p2, float &luminance )
+{
+    const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+    cache.lm[p2.x()][p2.y()] = elementwise_max( cache.lm[p2.x()][p2.y()], min_light );
+    cache.sm[p2.x()][p2.y()] = std::max( cache.sm[p2.x()][p2.y()], luminance );
     if( luminance <= lit_level::LOW ) {
-        return;
+        return false;
     } else if( luminance <= lit_level::BRIGHT_ONLY ) {
         luminance = 1.49f;
     }
+    return true;
+}
 
+static uint8_t light_source_directions( const level_cache &cache, const point_bub_ms &p2,
+                                        const float luminance )
+{
     /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
          neighboring fires to the north and west that were applied via light_source_buffer
        If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
@@ -1257,13 +1317,29 @@ void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
         sssSsss
            sy
     */
+    const cata::mdarray<float, point_bub_ms> &light_source_buffer = cache.light_source_buffer;
     const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = p2.y() != 0 && light_source_buffer[p2.x()][p2.y() - 1] < luminance;
-    bool south = p2.y() != peer_inbounds && light_source_buffer[p2.x()][p2.y() + 1] < luminance;
-    bool east = p2.x() != peer_inbounds && light_source_buffer[p2.x() + 1][p2.y()] < luminance;
-    bool west = p2.x() != 0 && light_source_buffer[p2.x() - 1][p2.y()] < luminance;
+    uint8_t directions = 0;
+    if( p2.y() != 0 && light_source_buffer[p2.x()][p2.y() - 1] < luminance ) {
+        directions |= light_dir_north;
+    }
+    if( p2.x() != peer_inbounds && light_source_buffer[p2.x() + 1][p2.y()] < luminance ) {
+        directions |= light_dir_east;
+    }
+    if( p2.y() != peer_inbounds && light_source_buffer[p2.x()][p2.y() + 1] < luminance ) {
+        directions |= light_dir_south;
+    }
+    if( p2.x() != 0 && light_source_buffer[p2.x() - 1][p2.y()] < luminance ) {
+        directions |= light_dir_west;
+    }
+    return directions;
+}
 
-    if( north ) {
+static void apply_light_source_octants( cata::mdarray<four_quadrants, point_bub_ms> &lm,
+                                        const cata::mdarray<float, point_bub_ms> &transparency_cache,
+                                        const point_bub_ms &p2, const float luminance, const uint8_t directions )
+{
+    if( directions & light_dir_north ) {
         castLight < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, p2, 0, luminance );
@@ -1272,7 +1348,7 @@ void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
                       lm, transparency_cache, p2, 0, luminance );
     }
 
-    if( east ) {
+    if( directions & light_dir_east ) {
         castLight < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency > (
                       lm, transparency_cache, p2, 0, luminance );
@@ -1281,7 +1357,7 @@ void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
                       lm, transparency_cache, p2, 0, luminance );
     }
 
-    if( south ) {
+    if( directions & light_dir_south ) {
         castLight<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency>(
                       lm, transparency_cache, p2, 0, luminance );
@@ -1290,7 +1366,7 @@ void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
                       lm, transparency_cache, p2, 0, luminance );
     }
 
-    if( west ) {
+    if( directions & light_dir_west ) {
         castLight<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
                   update_light_quadrants, accumulate_transparency>(
                       lm, transparency_cache, p2, 0, luminance );
@@ -1300,6 +1376,95 @@ void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
     }
 }
 
+void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
+{
+    level_cache &cache = get_cache( p.z() );
+    const point_bub_ms p2( p.xy() );
+
+    if( inbounds( p ) ) {
+        if( !apply_light_at_source( cache, p2, luminance ) ) {
+            return;
+        }
+    } else if( luminance <= lit_level::LOW ) {
+        return;
+    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
+        luminance = 1.49f;
+    }
+
+    apply_light_source_octants( cache.lm, cache.transparency_cache, p2, luminance,
+                                light_source_directions( cache, p2, luminance ) );
+}
+
+// Light starts out with an intensity of luminance and falls off at least inversely with
+// distance, so a cast stops being able to continue well before luminance / LIGHT_AMBIENT_LOW.
+static int light_source_reach( const float luminance )
+{
+    return std::min( MAX_VIEW_DISTANCE, static_cast<int>( luminance / LIGHT_AMBIENT_LOW ) + 2 );
+}
+
+// Scratch light map for capturing the light of a single source, all zero between uses.
+static cata::mdarray<four_quadrants, point_bub_ms> &light_capture_buffer()
+{
+    static std::unique_ptr<cata::mdarray<four_quadrants, point_bub_ms>> buffer;
+    if( !buffer ) {
+        buffer = std::make_unique<cata::mdarray<four_quadrants, point_bub_ms>>();
+        buffer->fill( four_quadrants{} );
+    }
+    return *buffer;
+}
+
+void map::apply_buffered_light_source( const tripoint_bub_ms &p, float luminance )
+{
+    level_cache &cache = get_cache( p.z() );
+    const point_bub_ms p2( p.xy() );
+    if( !apply_light_at_source( cache, p2, luminance ) ) {
+        return;
+    }
+    const uint8_t directions = light_source_directions( cache, p2, luminance );
+
+    light_source_contribution &contrib = cache.light_source_contributions[p2];
+    contrib.used = true;
+    bool valid = !contrib.light.empty() && contrib.luminance == luminance &&
+                 contrib.directions == directions;
+    // The cast only looked at transparency inside the covered area.
+    for( int smx = contrib.min.x() / SEEX; valid && smx <= contrib.max.x() / SEEX; ++smx ) {
+        for( int smy = contrib.min.y() / SEEY; smy <= contrib.max.y() / SEEY; ++smy ) {
+            if( cache.transparency_changed_at[smx * MAPSIZE + smy] > contrib.generation ) {
+                valid = false;
+                break;
+            }
+        }
+    }
+
+    if( !valid ) {
+        const int reach = light_source_reach( luminance );
+        contrib.luminance = luminance;
+        contrib.directions = directions;
+        contrib.generation = cache.transparency_generation;
+        contrib.min = point_bub_ms( std::max( p2.x() - reach, 0 ), std::max( p2.y() - reach, 0 ) );
+        contrib.max = point_bub_ms( std::min( p2.x() + reach, LIGHTMAP_CACHE_X - 1 ),
+                                    std::min( p2.y() + reach, LIGHTMAP_CACHE_Y - 1 ) );
+        const int height = contrib.max.y() - contrib.min.y() + 1;
+        contrib.light.resize( static_cast<size_t>( contrib.max.x() - contrib.min.x() + 1 ) * height );
+
+        cata::mdarray<four_quadrants, point_bub_ms> &capture = light_capture_buffer();
+        apply_light_source_octants( capture, cache.transparency_cache, p2, luminance, directions );
+        auto light_it = contrib.light.begin();
+        for( int x = contrib.min.x(); x <= contrib.max.x(); ++x ) {
+            light_it = std::copy_n( &capture[x][contrib.min.y()], height, light_it );
+            std::fill_n( &capture[x][contrib.min.y()], height, four_quadrants{} );
+        }
+    }
+
+    cata::mdarray<four_quadrants, point_bub_ms> &lm = cache.lm;
+    auto light_it = contrib.light.cbegin();
+    for( int x = contrib.min.x(); x <= contrib.max.x(); ++x ) {
+        for( int y = contrib.min.y(); y <= contrib.max.y(); ++y, ++light_it ) {
+            lm[x][y] = elementwise_max( lm[x][y], *light_it );
+        }
+    }
+}
+
 void map::apply_directional_light( const tripoint_bub_ms &p, int direction, float luminance )
 {
     const point_bub_ms p2( p.xy() );
@@ -2,6 +2,7 @@
 #include "llm_prompt_templates.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cctype>
 #include <chrono>
@@ -53,9 +54,12 @@
 #include "item_location.h"
 #include "itype.h"
 #include "json.h"
+#include "lru_cache.h"
 #include "map.h"
 #include "map_selector.h"
+#include "memory_budget.h"
 #include "memory_fast.h"
+#include "memory_report.h"
 #include "messages.h"
 #include "mod_manager.h"
 #include "npc.h"
@@ -84,8 +88,10 @@
 #include <csignal>
 #include <fcntl.h>
 #include <sys/select.h>
+#include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #endif
@@ -97,6 +103,17 @@ namespace
 std::mutex llm_intent_log_mutex;
 constexpr const char *llm_intent_log_filename = "llm_intent.log";
 constexpr std::streamoff llm_intent_log_rotate_bytes = 50 * 1024 * 1024;
+const option_handle<bool> option_llm_intent_enable( "LLM_INTENT_ENABLE" );
+const option_handle<bool> option_debug_llm_intent_ui( "DEBUG_LLM_INTENT_UI" );
+const option_handle<bool> option_debug_llm_intent_log( "DEBUG_LLM_INTENT_LOG" );
+const option_handle<float> option_llm_intent_temperature( "LLM_INTENT_TEMPERATURE" );
+const option_handle<float> option_llm_intent_top_p( "LLM_INTENT_TOP_P" );
+const option_handle<float> option_llm_intent_repetition_penalty( "LLM_INTENT_REPETITION_PENALTY" );
+const option_handle<bool> option_llm_intent_reply_cache( "LLM_INTENT_REPLY_CACHE" );
+const option_handle<bool> option_llm_intent_batch_shouts( "LLM_INTENT_BATCH_SHOUTS" );
+const option_handle<bool> option_llm_intent_stream_speech( "LLM_INTENT_STREAM_SPEECH" );
+const option_handle<int> option_llm_intent_timeout_ms( "LLM_INTENT_TIMEOUT_MS" );
+const option_handle<int> option_llm_intent_random_call( "LLM_INTENT_RANDOM_CALL" );
 
 std::filesystem::path central_llm_config_dir_path()
 {
@@ -170,18 +187,64 @@ constexpr const char *look_around_prompt_filename = "look_around_prompt.txt";
 constexpr const char *look_inventory_prompt_filename = "look_inventory_prompt.txt";
 constexpr const char *llm_prompt_readme_filename = "README.txt";
 
+struct npc_snapshot;
+
+// Higher goes first, so a direct order never waits behind ambient chatter.
+enum class llm_request_priority : int {
+    ambient = 0,
+    look = 1,
+    primary = 2,
+};
+
 struct llm_intent_request {
     std::string request_id;
     character_id npc_id;
     std::string npc_name;
     std::string prompt;
     std::string snapshot;
+    // Captured on the main thread, turned into snapshot and prompt by the worker.
+    std::shared_ptr<const npc_snapshot> pending_snapshot;
+    std::string player_utterance;
+    bool ambient = false;
+    bool log_prompt = false;
+    llm_request_priority priority = llm_request_priority::primary;
+    // Requests sharing a batch id are sent to the runner as one batch message.
+    std::string batch_id;
+    // Lets the runner keep one prompt-prefix cache entry per NPC.
+    std::string session_key;
+    // Bytes at the start of the prompt that stay the same between this NPC's requests.
+    size_t prompt_prefix_bytes = 0;
+    // Asks the runner for a partial response as soon as the speech field is complete.
+    bool stream = false;
+    // Dropped instead of sent once this passes while still queued.
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    std::chrono::steady_clock::time_point queued_at;
+    double capture_ms = 0.0;
     int max_tokens = 0;
     float temperature = 0.0f;
     float top_p = 0.0f;
     float repetition_penalty = 0.0f;
 };
 
+/** Where the time of one request went, filled in as it moves through the pipeline. */
+struct llm_request_timing {
+    std::chrono::steady_clock::time_point queued_at;
+    std::chrono::steady_clock::time_point runner_started_at;
+    std::chrono::steady_clock::time_point received_at;
+    // Snapshot capture on the game thread.
+    double capture_ms = 0.0;
+    double queue_ms = 0.0;
+    // Snapshot and prompt rendering on the worker.
+    double render_ms = 0.0;
+    double runner_ms = 0.0;
+    // From the runner starting on it to its partial response, -1 without one.
+    double ttft_ms = -1.0;
+    // From queueing to the game handling the response.
+    double total_ms = 0.0;
+    int prompt_tokens = -1;
+    int generated_tokens = -1;
+};
+
 struct llm_intent_response {
     std::string request_id;
     character_id npc_id;
@@ -190,6 +253,9 @@ struct llm_intent_response {
     std::string text;
     std::string error;
     std::string raw;
+    // Speech-only preview sent ahead of the full response.
+    bool partial = false;
+    llm_request_timing timing;
 };
 
 struct runner_config {
@@ -207,6 +273,8 @@ struct runner_config {
     int max_tokens = 0;
     int max_prompt_len = 0;
     bool force_npu = false;
+    // Unix socket of a runner daemon that outlives the game, empty to run one per launch.
+    std::string socket_path;
 
     bool operator==( const runner_config &other ) const {
         return python_path == other.python_path &&
@@ -222,15 +290,33 @@ struct runner_config {
                ollama_model == other.ollama_model &&
                max_tokens == other.max_tokens &&
                max_prompt_len == other.max_prompt_len &&
-               force_npu == other.force_npu;
+               force_npu == other.force_npu &&
+               socket_path == other.socket_path;
     }
 
     bool operator!=( const runner_config &other ) const {
         return !( *this == other );
     }
+
+    // Identifies what a runner was launched with, all but socket_path. A daemon reports the
+    // one it was given, see connect_daemon.
+    std::string fingerprint() const {
+        std::string joined;
+        for( const std::string *field : {
+                 &python_path, &runner_path, &model_dir, &backend, &device, &api_key_env,
+                 &api_provider, &api_model, &ollama_url, &ollama_model
+             } ) {
+            joined += *field;
+            joined.push_back( '\n' );
+        }
+        joined += string_format( "%d %d %d %d", use_api, max_tokens, max_prompt_len, force_npu );
+        return std::to_string( std::hash<std::string>()( joined ) );
+    }
 };
 
 [[maybe_unused]] std::string request_to_json( const llm_intent_request &request );
+[[maybe_unused]] std::string batch_to_json( const std::string &batch_id,
+        const std::vector<llm_intent_request> &requests );
 [[maybe_unused]] std::optional<llm_intent_response> response_from_json( const std::string &line,
         const llm_intent_request &request );
 [[maybe_unused]] std::filesystem::path resolve_path( const std::string &path );
@@ -355,15 +441,26 @@ void broadcast_overheard_memory( const npc &speaker, const std::string &speech,
         return;
     }
     static constexpr int llm_intent_overhear_volume = 12;
-    std::vector<npc *> listeners = g->get_npcs_if( [&]( const npc & guy ) {
-        return guy.getID() != speaker.getID() &&
-               guy.is_player_ally() &&
-               guy.can_hear( speaker.pos_bub(), llm_intent_overhear_volume );
-    } );
-    for( npc *listener : listeners ) {
-        if( listener != nullptr ) {
-            listener->add_llm_overheard_memory( speaker.get_name(), speech, actions );
+    // Keen ears hear further than the volume, but not four times as far.
+    static constexpr int llm_intent_overhear_reach = llm_intent_overhear_volume * 4;
+    std::shared_ptr<npc::llm_overheard_memory_entry> entry;
+    for( Creature *critter : get_creature_tracker().creatures_in_radius( speaker.pos_abs(),
+            llm_intent_overhear_reach, llm_intent_overhear_reach ) ) {
+        npc *listener = critter->as_npc();
+        if( listener == nullptr || listener->getID() == speaker.getID() ||
+            !listener->is_player_ally() ||
+            !listener->can_hear( speaker.pos_bub(), llm_intent_overhear_volume ) ) {
+            continue;
         }
+        // Made once, every listener keeps the same utterance.
+        if( !entry ) {
+            entry = std::make_shared<npc::llm_overheard_memory_entry>();
+            entry->turn = calendar::turn;
+            entry->npc_name = speaker.get_name();
+            entry->npc_response = npc::clip_llm_memory_text( speech );
+            entry->actions = actions;
+        }
+        listener->add_llm_overheard_memory( entry );
     }
 }
 
@@ -373,14 +470,6 @@ struct background_summary_entry {
     std::string source_tag;
 };
 
-struct background_summary_cache {
-    std::unordered_map<std::string, std::string> trait_to_topic;
-    std::unordered_map<std::string, background_summary_entry> summary_by_topic;
-    std::unordered_map<std::string, background_summary_entry> summary_by_selector;
-    std::vector<std::string> loaded_root_keys;
-    bool loaded = false;
-};
-
 void gather_traits_from_condition( const JsonObject &cond, std::vector<std::string> &out )
 {
     cond.allow_omitted_members();
@@ -407,7 +496,7 @@ std::string normalize_summary_line( std::string summary )
 }
 
 void load_background_trait_to_topic( const cata_path &toc_path,
-                                     std::unordered_map<std::string, std::string> &out )
+                                     std::map<std::string, std::string> &out )
 {
     read_from_file_optional_json( toc_path, [&]( const JsonArray & root ) {
         for( const JsonObject entry : root ) {
@@ -441,6 +530,29 @@ enum class background_summary_text_target : int {
     selector
 };
 
+// One indexed summary file; text files hold topics or selectors depending on their directory.
+struct background_summary_source {
+    std::string path;
+    background_summary_text_target text_target = background_summary_text_target::topic;
+};
+
+// What config/llm_background_summary_index.json holds: where each id lives, not its text.
+struct background_summary_index {
+    std::vector<std::string> root_keys;
+    // Stamps of every file and directory the index was built from.
+    std::map<std::string, int64_t> stamps;
+    std::vector<background_summary_source> sources;
+    std::map<std::string, std::string> trait_to_topic;
+    std::map<std::string, int> topic_source;
+    std::map<std::string, int> selector_source;
+};
+
+lru_cache<std::string, background_summary_entry> &get_background_summary_entries()
+{
+    static lru_cache<std::string, background_summary_entry> entries;
+    return entries;
+}
+
 int summary_file_generation_priority( const std::filesystem::path &path )
 {
     const std::string filename = path.filename().generic_u8string();
@@ -618,19 +730,16 @@ void load_background_summary_json_file( const cata_path &summary_path,
     } );
 }
 
-void load_background_summary_dir( const cata_path &summary_root,
-                                  background_summary_text_target text_target,
-                                  std::unordered_map<std::string, background_summary_entry> &summary_by_topic,
-                                  std::unordered_map<std::string, background_summary_entry> &summary_by_selector,
-                                  bool overwrite_existing )
+// Summary files in the order they are loaded, later files overwrite entries of earlier ones.
+std::vector<std::filesystem::path> background_summary_files( const cata_path &summary_root )
 {
     const std::filesystem::path summary_dir = summary_root.get_unrelative_path();
+    std::vector<std::filesystem::path> files;
     std::error_code ec;
     if( !std::filesystem::exists( summary_dir, ec ) ) {
-        return;
+        return files;
     }
 
-    std::vector<std::filesystem::path> files;
     for( const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(
              summary_dir,
              ec ) ) {
@@ -667,19 +776,22 @@ void load_background_summary_dir( const cata_path &summary_root,
         }
         return lhs.generic_u8string() < rhs.generic_u8string();
     } );
+    return files;
+}
 
-    for( const std::filesystem::path &filename : files ) {
-        const cata_path full_path = summary_root / filename.generic_u8string();
-        if( filename.extension() == std::filesystem::u8path( ".json" ) ) {
-            load_background_summary_json_file( full_path, summary_by_topic, summary_by_selector,
-                                               overwrite_existing );
-            continue;
-        }
-        if( text_target == background_summary_text_target::topic ) {
-            load_background_summary_text_file( full_path, summary_by_topic, overwrite_existing );
-        } else {
-            load_background_summary_text_file( full_path, summary_by_selector, overwrite_existing );
-        }
+void load_background_summary_file( const cata_path &full_path,
+                                   background_summary_text_target text_target,
+                                   std::unordered_map<std::string, background_summary_entry> &summary_by_topic,
+                                   std::unordered_map<std::string, background_summary_entry> &summary_by_selector )
+{
+    if( full_path.get_unrelative_path().extension() == std::filesystem::u8path( ".json" ) ) {
+        load_background_summary_json_file( full_path, summary_by_topic, summary_by_selector, true );
+        return;
+    }
+    if( text_target == background_summary_text_target::topic ) {
+        load_background_summary_text_file( full_path, summary_by_topic, true );
+    } else {
+        load_background_summary_text_file( full_path, summary_by_selector, true );
     }
 }
 
@@ -713,36 +825,223 @@ void add_summary_selector( std::vector<std::string> &out, const std::string &sel
     add_summary_id( out, selector );
 }
 
-background_summary_cache &get_background_summaries()
+constexpr int background_summary_index_version = 1;
+constexpr int background_summary_entry_cache_size = 32;
+constexpr int low_memory_background_summary_entry_cache_size = 8;
+
+// Modification stamp of a file or directory, -1 while it doesn't exist.
+int64_t background_summary_stamp( const std::string &path )
 {
-    static background_summary_cache cache;
-    const std::vector<cata_path> roots = background_summary_data_roots();
-    const std::vector<std::string> root_keys = background_summary_root_keys( roots );
-    if( cache.loaded && cache.loaded_root_keys == root_keys ) {
-        return cache;
+    std::error_code ec;
+    const std::filesystem::file_time_type stamp = std::filesystem::last_write_time(
+                std::filesystem::u8path( path ), ec );
+    if( ec ) {
+        return -1;
     }
+    return static_cast<int64_t>( stamp.time_since_epoch().count() );
+}
 
-    cache = background_summary_cache();
-    cache.loaded = true;
-    cache.loaded_root_keys = root_keys;
+cata_path background_summary_source_path( const std::string &path )
+{
+    return cata_path( cata_path::root_path::unknown, std::filesystem::u8path( path ) );
+}
 
-    for( const cata_path &root : roots ) {
-        load_background_trait_to_topic( root / "npcs" / "Backgrounds" /
-                                        "backgrounds_table_of_contents.json", cache.trait_to_topic );
-        load_background_summary_dir( root / "npcs" / "Backgrounds" / "Summaries_short",
-                                     background_summary_text_target::topic,
-                                     cache.summary_by_topic, cache.summary_by_selector, true );
-        load_background_summary_dir( root / "npcs" / "Backgrounds" / "Summaries_extra",
-                                     background_summary_text_target::selector,
-                                     cache.summary_by_topic, cache.summary_by_selector, true );
+bool background_summary_index_is_current( const background_summary_index &index,
+        const std::vector<std::string> &root_keys )
+{
+    if( index.root_keys != root_keys ) {
+        return false;
+    }
+    for( const std::pair<const std::string, int64_t> &stamp : index.stamps ) {
+        if( background_summary_stamp( stamp.first ) != stamp.second ) {
+            return false;
+        }
     }
+    return true;
+}
+
+// Crawls every summary root once, remembering which file holds each id instead of the text.
+background_summary_index build_background_summary_index( const std::vector<cata_path> &roots,
+        const std::vector<std::string> &root_keys )
+{
+    background_summary_index index;
+    index.root_keys = root_keys;
+    const auto add_stamp = [&index]( const cata_path & path ) {
+        const std::string key = path.get_unrelative_path().generic_u8string();
+        index.stamps[key] = background_summary_stamp( key );
+    };
+    const auto index_dir = [&]( const cata_path & summary_root,
+    background_summary_text_target text_target ) {
+        // A file added to or removed from the directory bumps the directory's own stamp.
+        add_stamp( summary_root );
+        for( const std::filesystem::path &filename : background_summary_files( summary_root ) ) {
+            const cata_path full_path = summary_root / filename.generic_u8string();
+            add_stamp( full_path );
+            std::unordered_map<std::string, background_summary_entry> by_topic;
+            std::unordered_map<std::string, background_summary_entry> by_selector;
+            load_background_summary_file( full_path, text_target, by_topic, by_selector );
+            if( by_topic.empty() && by_selector.empty() ) {
+                continue;
+            }
+            const int source = static_cast<int>( index.sources.size() );
+            index.sources.push_back( { full_path.get_unrelative_path().generic_u8string(),
+                                       text_target } );
+            for( const auto &entry : by_topic ) {
+                index.topic_source[entry.first] = source;
+            }
+            for( const auto &entry : by_selector ) {
+                index.selector_source[entry.first] = source;
+            }
+        }
+    };
+
+    for( const cata_path &root : roots ) {
+        const cata_path backgrounds = root / "npcs" / "Backgrounds";
+        const cata_path toc_path = backgrounds / "backgrounds_table_of_contents.json";
+        add_stamp( toc_path );
+        load_background_trait_to_topic( toc_path, index.trait_to_topic );
+        index_dir( backgrounds / "Summaries_short", background_summary_text_target::topic );
+        index_dir( backgrounds / "Summaries_extra", background_summary_text_target::selector );
+    }
+    return index;
+}
+
+void write_background_summary_index( const background_summary_index &index,
+                                     const std::filesystem::path &index_path )
+{
+    std::error_code ec;
+    std::filesystem::create_directories( index_path.parent_path(), ec );
+    write_to_file( index_path.u8string(), [&index]( std::ostream & out ) {
+        JsonOut jsout( out );
+        jsout.start_object();
+        jsout.member( "version", background_summary_index_version );
+        jsout.member( "roots", index.root_keys );
+        jsout.member( "stamps", index.stamps );
+        jsout.member( "sources" );
+        jsout.start_array();
+        for( const background_summary_source &source : index.sources ) {
+            jsout.start_array();
+            jsout.write( source.path );
+            jsout.write( source.text_target == background_summary_text_target::topic ? "topic" :
+                         "selector" );
+            jsout.end_array();
+        }
+        jsout.end_array();
+        jsout.member( "traits", index.trait_to_topic );
+        jsout.member( "topics", index.topic_source );
+        jsout.member( "selectors", index.selector_source );
+        jsout.end_object();
+    }, _( "background summary index" ) );
+}
 
-    return cache;
+std::optional<background_summary_index> read_background_summary_index(
+    const std::filesystem::path &index_path )
+{
+    std::optional<background_summary_index> result;
+    read_from_file_optional_json( cata_path( cata_path::root_path::unknown, index_path ),
+    [&result]( const JsonValue & root ) {
+        if( !root.test_object() ) {
+            return;
+        }
+        JsonObject jo = root.get_object();
+        jo.allow_omitted_members();
+        if( jo.get_int( "version", 0 ) != background_summary_index_version ) {
+            return;
+        }
+        background_summary_index index;
+        for( const JsonValue key : jo.get_array( "roots" ) ) {
+            index.root_keys.push_back( key.get_string() );
+        }
+        for( const JsonMember stamp : jo.get_object( "stamps" ) ) {
+            index.stamps[stamp.name()] = stamp.get_int64();
+        }
+        for( const JsonArray source : jo.get_array( "sources" ) ) {
+            index.sources.push_back( { source.get_string( 0 ), source.get_string( 1 ) == "topic" ?
+                                       background_summary_text_target::topic :
+                                       background_summary_text_target::selector } );
+        }
+        for( const JsonMember trait : jo.get_object( "traits" ) ) {
+            index.trait_to_topic[trait.name()] = trait.get_string();
+        }
+        const int source_count = static_cast<int>( index.sources.size() );
+        const auto read_ids = [source_count]( const JsonObject & ids,
+        std::map<std::string, int> &out ) {
+            for( const JsonMember id : ids ) {
+                const int source = id.get_int();
+                if( source >= 0 && source < source_count ) {
+                    out[id.name()] = source;
+                }
+            }
+        };
+        read_ids( jo.get_object( "topics" ), index.topic_source );
+        read_ids( jo.get_object( "selectors" ), index.selector_source );
+        result = std::move( index );
+    } );
+    return result;
+}
+
+// Index of the summaries under the current roots, read from disk while no stamp has moved.
+background_summary_index &get_background_summary_index()
+{
+    static background_summary_index index;
+    static bool loaded = false;
+    const std::vector<cata_path> roots = background_summary_data_roots();
+    const std::vector<std::string> root_keys = background_summary_root_keys( roots );
+    if( loaded && index.root_keys == root_keys ) {
+        return index;
+    }
+
+    loaded = true;
+    get_background_summary_entries().clear();
+    const std::filesystem::path index_path =
+        central_llm_log_path( "llm_background_summary_index.json" );
+    std::optional<background_summary_index> on_disk = read_background_summary_index( index_path );
+    if( on_disk && background_summary_index_is_current( *on_disk, root_keys ) ) {
+        index = std::move( *on_disk );
+        return index;
+    }
+    index = build_background_summary_index( roots, root_keys );
+    write_background_summary_index( index, index_path );
+    return index;
+}
+
+// Parses only the file the index points at, keeping the few most recent entries around.
+std::optional<background_summary_entry> find_background_summary(
+    const background_summary_index &index, const std::string &id, bool topic )
+{
+    const std::map<std::string, int> &sources = topic ? index.topic_source :
+            index.selector_source;
+    const auto source_it = sources.find( id );
+    if( source_it == sources.end() ) {
+        return std::nullopt;
+    }
+    lru_cache<std::string, background_summary_entry> &entries = get_background_summary_entries();
+    const std::string cache_key = ( topic ? "topic|" : "selector|" ) + id;
+    background_summary_entry cached = entries.get( cache_key, {} );
+    if( !cached.background.empty() ) {
+        return cached;
+    }
+
+    const background_summary_source &source = index.sources[source_it->second];
+    std::unordered_map<std::string, background_summary_entry> by_topic;
+    std::unordered_map<std::string, background_summary_entry> by_selector;
+    load_background_summary_file( background_summary_source_path( source.path ), source.text_target,
+                                  by_topic, by_selector );
+    const std::unordered_map<std::string, background_summary_entry> &loaded = topic ? by_topic :
+            by_selector;
+    const auto entry_it = loaded.find( id );
+    if( entry_it == loaded.end() ) {
+        return std::nullopt;
+    }
+    entries.insert( memory_budget::low_memory_profile() ?
+                    low_memory_background_summary_entry_cache_size :
+                    background_summary_entry_cache_size, cache_key, entry_it->second );
+    return entry_it->second;
 }
 
 background_summary_entry get_background_summary_for( const npc &listener )
 {
-    background_summary_cache &cache = get_background_summaries();
+    const background_summary_index &index = get_background_summary_index();
 
     std::vector<std::string> selectors;
     add_summary_selector( selectors, "name:" + listener.get_name() );
@@ -756,26 +1055,24 @@ background_summary_entry get_background_summary_for( const npc &listener )
     add_summary_selector( selectors, "topic:" + listener.chatbin.talk_stranger_scared );
     add_summary_selector( selectors, "topic:" + listener.chatbin.talk_stranger_aggressive );
     for( const std::string &selector : selectors ) {
-        const auto it = cache.summary_by_selector.find( selector );
-        if( it != cache.summary_by_selector.end() ) {
-            return it->second;
+        if( std::optional<background_summary_entry> found =
+                find_background_summary( index, selector, false ) ) {
+            return *found;
         }
     }
 
-    if( cache.trait_to_topic.empty() || cache.summary_by_topic.empty() ) {
+    if( index.trait_to_topic.empty() || index.topic_source.empty() ) {
         return {};
     }
     for( const trait_id &trait : listener.get_mutations( true, true ) ) {
-        const std::string trait_name = trait.str();
-        const auto topic_it = cache.trait_to_topic.find( trait_name );
-        if( topic_it == cache.trait_to_topic.end() ) {
+        const auto topic_it = index.trait_to_topic.find( trait.str() );
+        if( topic_it == index.trait_to_topic.end() ) {
             continue;
         }
-        const auto summary_it = cache.summary_by_topic.find( topic_it->second );
-        if( summary_it == cache.summary_by_topic.end() ) {
-            continue;
+        if( std::optional<background_summary_entry> found =
+                find_background_summary( index, topic_it->second, true ) ) {
+            return *found;
         }
-        return summary_it->second;
     }
     return {};
 }
@@ -1144,6 +1441,39 @@ struct look_around_item_entry {
     int min_distance = 0;
 };
 
+// Utterances that only differ in case, spacing or punctuation count as the same.
+std::string utterance_class( const std::string &utterance )
+{
+    std::string out;
+    bool pending_space = false;
+    for( const char c : utterance ) {
+        const unsigned char uc = static_cast<unsigned char>( c );
+        if( std::isalnum( uc ) || uc >= 0x80 ) {
+            if( pending_space && !out.empty() ) {
+                out.push_back( ' ' );
+            }
+            pending_space = false;
+            out.push_back( static_cast<char>( std::tolower( uc ) ) );
+        } else {
+            pending_space = true;
+        }
+    }
+    return out.empty() ? "(idle)" : out;
+}
+
+// Item ids in the prompt follow the list order, so the order is part of the key.
+std::string look_around_fingerprint( const npc &listener, const std::string &player_utterance,
+                                     const std::vector<look_around_item_entry> &items )
+{
+    std::string out = string_format( "look|%d|%s|", listener.getID().get_value(),
+                                     utterance_class( player_utterance ) );
+    for( const look_around_item_entry &entry : items ) {
+        out += entry.name;
+        out.push_back( ',' );
+    }
+    return out;
+}
+
 struct look_around_selection {
     std::string name;
     int quantity = -1;
@@ -1830,7 +2160,7 @@ std::vector<creature_snapshot> filter_visible( const npc &listener,
     return out;
 }
 
-float threat_score_for( npc &listener, const Creature &critter, int distance )
+float evaluate_threat( npc &listener, const Creature &critter, int distance )
 {
     if( const monster *mon = critter.as_monster() ) {
         return listener.evaluate_monster( *mon, distance );
@@ -1843,6 +2173,46 @@ float threat_score_for( npc &listener, const Creature &critter, int distance )
     return 0.0f;
 }
 
+// Threat scores of the snapshot being captured. One snapshot asks for the same creature
+// in its threat list, its map legend and the legend trimming order; rating it once keeps
+// those consistent and skips the repeated evaluate_character passes.
+std::map<std::pair<const Creature *, int>, float> *snapshot_threat_scores = nullptr;
+
+class snapshot_threat_scope
+{
+    public:
+        snapshot_threat_scope() : outer( snapshot_threat_scores ) {
+            if( outer == nullptr ) {
+                snapshot_threat_scores = &scores;
+            }
+        }
+        ~snapshot_threat_scope() {
+            if( outer == nullptr ) {
+                snapshot_threat_scores = nullptr;
+            }
+        }
+        snapshot_threat_scope( const snapshot_threat_scope & ) = delete;
+        snapshot_threat_scope &operator=( const snapshot_threat_scope & ) = delete;
+    private:
+        std::map<std::pair<const Creature *, int>, float> *outer;
+        std::map<std::pair<const Creature *, int>, float> scores;
+};
+
+float threat_score_for( npc &listener, const Creature &critter, int distance )
+{
+    if( snapshot_threat_scores == nullptr ) {
+        return evaluate_threat( listener, critter, distance );
+    }
+    const std::pair<const Creature *, int> key( &critter, distance );
+    const auto found = snapshot_threat_scores->find( key );
+    if( found != snapshot_threat_scores->end() ) {
+        return found->second;
+    }
+    const float score = evaluate_threat( listener, critter, distance );
+    snapshot_threat_scores->emplace( key, score );
+    return score;
+}
+
 int threat_level_for_snapshot( npc &listener, const Creature &critter )
 {
     const int distance = rl_dist( listener.pos_bub(), critter.pos_bub() );
@@ -1934,23 +2304,70 @@ std::string build_snapshot_dy_label( int dy )
     return string_format( "dy=%+03d ", -dy );
 }
 
-struct map_snapshot {
-    std::string map;
-    std::string legend;
+/**
+ * Everything the snapshot text needs, read from the game on the main thread and held by
+ * value, so that the worker thread can render it while the game carries on.
+ */
+struct npc_snapshot {
+    static constexpr int map_radius = 20;
+
+    std::string request_id;
+    std::string player_name;
+    std::string player_utterance;
+    time_point taken_at = calendar::before_time_starts;
+    std::vector<npc::llm_intent_memory_entry> memory;
+    std::vector<std::shared_ptr<const npc::llm_overheard_memory_entry>> overheard;
+    std::string name;
+    std::string profession;
+    background_summary_entry background_summary;
+    std::string follow_mode;
+    int morale = 0;
+    int hunger = 0;
+    int thirst = 0;
+    int pain = 0;
+    int stamina = 0;
+    int sleepiness = 0;
+    int hp = 0;
+    std::vector<std::pair<std::string, int>> effects;
+    int danger = 0;
+    int panic = 0;
+    int confidence = 0;
+    int aggression = 0;
+    int bravery = 0;
+    int collector = 0;
+    int altruism = 0;
+    int trust = 0;
+    int intimidation = 0;
+    int respect = 0;
+    int anger = 0;
+    std::vector<std::pair<std::string, float>> threats;
+    std::vector<std::string> friendlies;
+    std::optional<std::string> wielded;
+    std::vector<std::string> weapons;
+    bool bandage_possible = false;
+    // One string of glyphs per row of the map, from dy = -map_radius down.
+    std::vector<std::string> map_rows;
+    std::vector<std::pair<char, std::string>> map_legend;
+    // threat_level_for_snapshot of each legend letter, for trimming the legend.
+    std::map<char, int> legend_threat;
+    // Rough token allowance for the whole snapshot, 0 for no limit.
+    int token_budget = 0;
+};
+
+/** How much of a snapshot to spell out, see render_snapshot_tail(). */
+struct snapshot_detail {
+    int map_radius = npc_snapshot::map_radius;
+    // Long runs of open or unseen tiles are written as "<glyph>*<count>".
+    bool run_length = false;
+    size_t max_creatures = std::numeric_limits<size_t>::max();
 };
 
-map_snapshot build_ascii_map_snapshot( npc &listener, const std::string &request_id )
+void capture_map_snapshot( npc &listener, const std::string &request_id, npc_snapshot &snap )
 {
     map &here = get_map();
     const tripoint_bub_ms player_pos = get_player_character().pos_bub();
     const tripoint_bub_ms center = listener.pos_bub();
-    static constexpr int radius = 20;
-    static constexpr std::string_view header_padding = "        ";
-    std::string out_map;
-    out_map.reserve( ( radius * 2 + 1 ) * ( radius * 2 + 3 ) );
-    out_map += std::string( header_padding ) + build_snapshot_dx_label_line( radius ) + "\n";
-    out_map += std::string( header_padding ) + build_snapshot_dx_marker_line( radius ) + "\n";
-    std::vector<std::pair<char, std::string>> legend_entries;
+    static constexpr int radius = npc_snapshot::map_radius;
     std::unordered_map<const Creature *, char> letter_map;
     std::map<char, weak_ptr_fast<Creature>> legend_targets;
     const bool player_in_map = std::abs( player_pos.x() - center.x() ) <= radius &&
@@ -1958,8 +2375,10 @@ map_snapshot build_ascii_map_snapshot( npc &listener, const std::string &request
                                player_pos.z() == center.z();
     const bool player_letter_active = player_in_map && player_pos != center;
     char next_letter = player_letter_active ? 'b' : 'a';
+    snap.map_rows.reserve( radius * 2 + 1 );
     for( int dy = -radius; dy <= radius; ++dy ) {
-        out_map += build_snapshot_dy_label( dy );
+        std::string row;
+        row.reserve( radius * 2 + 1 );
         for( int dx = -radius; dx <= radius; ++dx ) {
             const tripoint_bub_ms p( center.x() + dx, center.y() + dy, center.z() );
             char glyph = ' ';
@@ -1982,7 +2401,8 @@ map_snapshot build_ascii_map_snapshot( npc &listener, const std::string &request
                             const char letter = cost > 100 ||
                                                 cost <= 0 ? static_cast<char>( std::toupper( base_letter ) ) : base_letter;
                             letter_map.emplace( critter, letter );
-                            legend_entries.emplace_back( letter, creature_legend_entry( listener, *critter ) );
+                            snap.map_legend.emplace_back( letter, creature_legend_entry( listener, *critter ) );
+                            snap.legend_threat[letter] = threat_level_for_snapshot( listener, *critter );
                             legend_targets[letter] = g->shared_from( *critter );
                             glyph = letter;
                         } else {
@@ -1996,8 +2416,9 @@ map_snapshot build_ascii_map_snapshot( npc &listener, const std::string &request
                                 const char letter = cost > 100 ||
                                                     cost <= 0 ? static_cast<char>( std::toupper( base_letter ) ) : base_letter;
                                 letter_map.emplace( critter, letter );
-                                legend_entries.emplace_back( letter,
-                                                             creature_legend_entry( listener, *critter ) );
+                                snap.map_legend.emplace_back( letter,
+                                                              creature_legend_entry( listener, *critter ) );
+                                snap.legend_threat[letter] = threat_level_for_snapshot( listener, *critter );
                                 legend_targets[letter] = g->shared_from( *critter );
                                 glyph = letter;
                                 ++next_letter;
@@ -2016,20 +2437,112 @@ map_snapshot build_ascii_map_snapshot( npc &listener, const std::string &request
                     glyph = '-';
                 }
             }
-            out_map.push_back( glyph );
+            row.push_back( glyph );
         }
-        out_map.push_back( '\n' );
+        snap.map_rows.push_back( std::move( row ) );
     }
-    map_snapshot out;
-    out.map = std::move( out_map );
-    out.legend = build_map_legend( legend_entries );
     listener.set_llm_intent_legend_map( request_id, std::move( legend_targets ) );
+}
+
+std::string run_length_encode_row( const std::string &row )
+{
+    static constexpr size_t min_run = 5;
+    std::string out;
+    for( size_t i = 0; i < row.size(); ) {
+        size_t end = i;
+        while( end < row.size() && row[end] == row[i] ) {
+            ++end;
+        }
+        const size_t run = end - i;
+        if( run >= min_run && ( row[i] == '-' || row[i] == ' ' ) ) {
+            out += string_format( "%c*%d", row[i], run );
+        } else {
+            out.append( row, i, run );
+        }
+        i = end;
+    }
     return out;
 }
 
-std::string build_snapshot_json( npc &listener, const std::string &player_utterance,
-                                 const std::string &request_id )
+std::string render_ascii_map( const npc_snapshot &snap, const snapshot_detail &detail )
+{
+    static constexpr int full_radius = npc_snapshot::map_radius;
+    static constexpr std::string_view header_padding = "        ";
+    const int radius = std::clamp( detail.map_radius, 1, full_radius );
+    const int crop = full_radius - radius;
+    std::string out_map;
+    out_map.reserve( ( radius * 2 + 1 ) * ( radius * 2 + 3 ) );
+    out_map += std::string( header_padding ) + build_snapshot_dx_label_line( radius ) + "\n";
+    out_map += std::string( header_padding ) + build_snapshot_dx_marker_line( radius ) + "\n";
+    for( size_t i = crop; i + crop < snap.map_rows.size(); ++i ) {
+        out_map += build_snapshot_dy_label( static_cast<int>( i ) - full_radius );
+        const std::string row = snap.map_rows[i].substr( crop, radius * 2 + 1 );
+        out_map += detail.run_length ? run_length_encode_row( row ) : row;
+        out_map.push_back( '\n' );
+    }
+    return out_map;
+}
+
+// What the cropped map leaves out, one line per compass side.
+std::string summarize_outside_map( const npc_snapshot &snap, int radius )
+{
+    static constexpr int full_radius = npc_snapshot::map_radius;
+    if( radius >= full_radius ) {
+        return std::string();
+    }
+    struct side_summary {
+        int seen = 0;
+        int open = 0;
+        int obstructed = 0;
+        std::string creatures;
+    };
+    static constexpr std::array<const char *, 4> side_names = { "north", "east", "south", "west" };
+    std::array<side_summary, 4> sides;
+    for( size_t i = 0; i < snap.map_rows.size(); ++i ) {
+        const int dy = full_radius - static_cast<int>( i );
+        const std::string &row = snap.map_rows[i];
+        for( size_t j = 0; j < row.size(); ++j ) {
+            const int dx = static_cast<int>( j ) - full_radius;
+            if( std::abs( dx ) <= radius && std::abs( dy ) <= radius ) {
+                continue;
+            }
+            const char glyph = row[j];
+            if( glyph == ' ' ) {
+                continue;
+            }
+            side_summary &side = std::abs( dy ) >= std::abs( dx ) ? sides[dy > 0 ? 0 : 2] :
+                                 sides[dx > 0 ? 1 : 3];
+            ++side.seen;
+            if( glyph == '-' ) {
+                ++side.open;
+            } else if( glyph == '0' || glyph == '6' ) {
+                ++side.obstructed;
+            } else if( std::isalpha( static_cast<unsigned char>( glyph ) ) ) {
+                side.creatures += string_format( " %c(dx=%+d,dy=%+d)", glyph, dx, dy );
+            }
+        }
+    }
+    std::string out = string_format( "beyond the map (|dx| or |dy| over %d):\n", radius );
+    for( size_t i = 0; i < sides.size(); ++i ) {
+        const side_summary &side = sides[i];
+        if( side.seen == 0 ) {
+            out += string_format( "- %s: unseen\n", side_names[i] );
+            continue;
+        }
+        out += string_format( "- %s: open=%d%% obstructed=%d%%", side_names[i],
+                              side.open * 100 / side.seen, side.obstructed * 100 / side.seen );
+        if( !side.creatures.empty() ) {
+            out += " creatures:" + side.creatures;
+        }
+        out.push_back( '\n' );
+    }
+    return out;
+}
+
+npc_snapshot capture_npc_snapshot( npc &listener, const std::string &player_utterance,
+                                   const std::string &request_id )
 {
+    const snapshot_threat_scope threat_scope;
     static constexpr int visible_range = 12;
     static constexpr size_t max_creatures = 5;
     static constexpr size_t max_effects = 6;
@@ -2052,208 +2565,86 @@ std::string build_snapshot_json( npc &listener, const std::string &player_uttera
         return static_cast<int>( std::round( ratio * 10.0 ) );
     };
 
-    std::ostringstream out;
-    out << "id: " << request_id << "\n";
-    out << "player name: " << sanitize_text( get_player_character().get_name() ) << "\n";
-    const std::string utterance_line = sanitize_text( player_utterance );
-    const bool has_player_utterance = !trim_copy( utterance_line ).empty();
-    out << "player utterance present: " << ( has_player_utterance ? "true" : "false" ) << "\n";
-    out << "player utterance: " << utterance_line << "\n\n";
-    const std::vector<npc::llm_intent_memory_entry> memory = listener.get_llm_intent_memory();
-    const std::vector<npc::llm_overheard_memory_entry> overheard = listener.get_llm_overheard_memory();
-    out << "Recent conversation newest first:\n";
-    if( memory.empty() && overheard.empty() ) {
-        out << "(none)\n\n";
-    } else {
-        const size_t line_count = std::max( memory.size(), overheard.size() );
-        for( size_t i = 0; i < line_count; ++i ) {
-            out << "-";
-            bool has_hours = false;
-            bool has_segment = false;
-            if( i < memory.size() ) {
-                const npc::llm_intent_memory_entry &entry = memory[memory.size() - 1 - i];
-                const time_duration age = calendar::turn - entry.turn;
-                const double hours_ago = to_hours<double>( age );
-                std::ostringstream hours_stream;
-                hours_stream << std::fixed << std::setprecision( 1 ) << hours_ago;
-                out << " hours_ago=" << hours_stream.str();
-                has_hours = true;
-                if( !entry.player_utterance.empty() ) {
-                    out << " player:\"" << sanitize_text( entry.player_utterance ) << "\"";
-                    has_segment = true;
-                }
-                if( !entry.npc_response.empty() ) {
-                    out << " You:\"" << sanitize_text( entry.npc_response ) << "\"";
-                    has_segment = true;
-                }
-                if( !entry.actions.empty() ) {
-                    out << " actions=[" << join_action_tokens( entry.actions ) << "]";
-                    has_segment = true;
-                }
-            }
-            if( i < overheard.size() ) {
-                const npc::llm_overheard_memory_entry &entry = overheard[overheard.size() - 1 - i];
-                if( !has_hours ) {
-                    const time_duration age = calendar::turn - entry.turn;
-                    const double hours_ago = to_hours<double>( age );
-                    std::ostringstream hours_stream;
-                    hours_stream << std::fixed << std::setprecision( 1 ) << hours_ago;
-                    out << " hours_ago=" << hours_stream.str();
-                }
-                if( has_segment ) {
-                    out << " |";
-                }
-                if( !entry.npc_name.empty() ) {
-                    out << " " << sanitize_text( entry.npc_name ) << ":\"";
-                    out << sanitize_text( entry.npc_response ) << "\"";
-                } else if( !entry.npc_response.empty() ) {
-                    out << " Ally:\"" << sanitize_text( entry.npc_response ) << "\"";
-                }
-                if( !entry.actions.empty() ) {
-                    out << " actions=[" << join_action_tokens( entry.actions ) << "]";
-                }
-            }
-            out << "\n";
-        }
-        out << "\n";
-    }
-    out << "your_name: " << sanitize_text( listener.get_name() ) << "\n";
-    const std::string profession = sanitize_text( listener.disp_profession() );
-    out << "your_profession: " << ( profession.empty() ? "no_past" : profession ) << "\n";
-    const background_summary_entry background_summary = get_background_summary_for( listener );
-    if( !background_summary.background.empty() ) {
-        out << "your_tone: " << background_summary.background << "\n";
-    }
-    if( !background_summary.expression.empty() ) {
-        out << "your_example_expression: " << background_summary.expression << "\n";
-    }
-    out << "your_follow_mode: " << follower_mode_snapshot_token( listener ) << "\n";
-    const int morale_scaled = scale_bipolar( listener.get_morale_level(), -100.0, 100.0 );
-    const int hunger_scaled = scale_unipolar( listener.get_hunger(), 300.0 );
-    const int thirst_scaled = scale_unipolar( listener.get_thirst(), 300.0 );
-    const int pain_scaled = scale_unipolar( listener.get_pain(), 100.0 );
+    npc_snapshot snap;
+    snap.request_id = request_id;
+    snap.player_name = sanitize_text( get_player_character().get_name() );
+    snap.player_utterance = sanitize_text( player_utterance );
+    snap.taken_at = calendar::turn;
+    snap.token_budget = get_option<int>( "LLM_INTENT_SNAPSHOT_TOKEN_BUDGET" );
+    snap.memory = listener.get_llm_intent_memory();
+    snap.overheard = listener.get_llm_overheard_memory();
+    snap.name = sanitize_text( listener.get_name() );
+    snap.profession = sanitize_text( listener.disp_profession() );
+    snap.background_summary = get_background_summary_for( listener );
+    snap.follow_mode = follower_mode_snapshot_token( listener );
+
+    snap.morale = scale_bipolar( listener.get_morale_level(), -100.0, 100.0 );
+    snap.hunger = scale_unipolar( listener.get_hunger(), 300.0 );
+    snap.thirst = scale_unipolar( listener.get_thirst(), 300.0 );
+    snap.pain = scale_unipolar( listener.get_pain(), 100.0 );
     const int max_sleepiness = static_cast<int>( sleepiness_levels::MASSIVE_SLEEPINESS );
-    const int sleepiness_scaled = scale_unipolar( listener.get_sleepiness(), max_sleepiness );
-    const int hp_scaled = scale_unipolar( listener.hp_percentage(), 100.0 );
+    snap.sleepiness = scale_unipolar( listener.get_sleepiness(), max_sleepiness );
+    snap.hp = scale_unipolar( listener.hp_percentage(), 100.0 );
     double stamina_percent = 0.0;
     if( listener.get_stamina_max() > 0 ) {
         stamina_percent = static_cast<double>( listener.get_stamina() ) * 100.0 /
                           static_cast<double>( listener.get_stamina_max() );
     }
-    const int stamina_scaled = scale_unipolar( stamina_percent, 100.0 );
-
-    out << "your_state[0-10]: ";
-    out << "morale=" << morale_scaled;
-    out << " hunger=" << hunger_scaled;
-    out << " thirst=" << thirst_scaled;
-    out << " pain=" << pain_scaled;
-    out << " stamina=" << stamina_scaled;
-    out << " sleepiness=" << sleepiness_scaled;
-    out << " hp_percent=" << hp_scaled;
-    out << " effects=[";
-    size_t effect_count = 0;
+    snap.stamina = scale_unipolar( stamina_percent, 100.0 );
     for( const std::reference_wrapper<const effect> &eff_ref : listener.get_effects() ) {
         const effect &eff = eff_ref.get();
-        if( effect_count > 0 ) {
-            out << " ";
-        }
-        out << eff.get_id().str() << ":" << eff.get_intensity();
-        if( ++effect_count >= max_effects ) {
+        snap.effects.emplace_back( eff.get_id().str(), eff.get_intensity() );
+        if( snap.effects.size() >= max_effects ) {
             break;
         }
     }
-    out << "]\n";
-
-    const int danger_scaled = scale_unipolar( listener.danger_assessment(),
-                              static_cast<double>( NPC_CHARACTER_DANGER_MAX ) );
-    const int panic_scaled = scale_unipolar( listener.mem_combat.panic, 20.0 );
-    const int confidence_scaled = scale_unipolar( listener.mem_combat.my_health, 1.0 );
-    out << "your_emotions[0-10]: ";
-    out << "danger_assessment=" << danger_scaled;
-    out << " panic=" << panic_scaled;
-    out << " confidence=" << confidence_scaled << "\n";
 
-    out << "your_personality[0-10]: ";
-    out << "aggression=" << scale_bipolar( listener.personality.aggression, -10.0, 10.0 );
-    out << " bravery=" << scale_bipolar( listener.personality.bravery, -10.0, 10.0 );
-    out << " collector=" << scale_bipolar( listener.personality.collector, -10.0, 10.0 );
-    out << " altruism=" << scale_bipolar( listener.personality.altruism, -10.0, 10.0 ) << "\n";
+    snap.danger = scale_unipolar( listener.danger_assessment(),
+                                  static_cast<double>( NPC_CHARACTER_DANGER_MAX ) );
+    snap.panic = scale_unipolar( listener.mem_combat.panic, 20.0 );
+    snap.confidence = scale_unipolar( listener.mem_combat.my_health, 1.0 );
+    snap.aggression = scale_bipolar( listener.personality.aggression, -10.0, 10.0 );
+    snap.bravery = scale_bipolar( listener.personality.bravery, -10.0, 10.0 );
+    snap.collector = scale_bipolar( listener.personality.collector, -10.0, 10.0 );
+    snap.altruism = scale_bipolar( listener.personality.altruism, -10.0, 10.0 );
+    snap.trust = scale_bipolar( listener.op_of_u.trust, -10.0, 10.0 );
+    snap.intimidation = scale_bipolar( listener.op_of_u.fear, -10.0, 10.0 );
+    snap.respect = scale_bipolar( listener.op_of_u.value, -10.0, 10.0 );
+    snap.anger = scale_bipolar( listener.op_of_u.anger, -10.0, 10.0 );
 
-    out << "your_opinion_of_player[0-10]: ";
-    out << "trust=" << scale_bipolar( listener.op_of_u.trust, -10.0, 10.0 );
-    out << " intimidation=" << scale_bipolar( listener.op_of_u.fear, -10.0, 10.0 );
-    out << " respect=" << scale_bipolar( listener.op_of_u.value, -10.0, 10.0 );
-    out << " anger=" << scale_bipolar( listener.op_of_u.anger, -10.0, 10.0 ) << "\n\n";
-
-    const std::vector<creature_snapshot> hostile = filter_visible( listener,
-            Creature::Attitude::HOSTILE,
-            visible_range );
-    if( hostile.empty() ) {
-        out << "threats: (none)\n";
-    } else {
-        out << "threats: ";
-        size_t count = 0;
-        for( const creature_snapshot &entry : hostile ) {
-            if( entry.critter == nullptr ) {
-                continue;
-            }
-            if( count > 0 ) {
-                out << ", ";
-            }
-            const std::string name = strip_leading_article( sanitize_text( entry.critter->disp_name() ) );
-            out << name << " threat_score[0-100]=";
-            out << threat_score_for( listener, *entry.critter, entry.distance );
-            if( ++count >= max_creatures ) {
-                break;
-            }
+    for( const creature_snapshot &entry : filter_visible( listener, Creature::Attitude::HOSTILE,
+            visible_range ) ) {
+        if( entry.critter == nullptr ) {
+            continue;
+        }
+        snap.threats.emplace_back( strip_leading_article( sanitize_text( entry.critter->disp_name() ) ),
+                                   threat_score_for( listener, *entry.critter, entry.distance ) );
+        if( snap.threats.size() >= max_creatures ) {
+            break;
         }
-        out << "\n";
     }
-
-    const std::vector<creature_snapshot> friendly = filter_visible( listener,
-            Creature::Attitude::FRIENDLY,
-            visible_range );
-    if( friendly.empty() ) {
-        out << "friendlies: (none)\n";
-    } else {
-        out << "friendlies: ";
-        size_t count = 0;
-        for( const creature_snapshot &entry : friendly ) {
-            if( entry.critter == nullptr ) {
-                continue;
-            }
-            if( count > 0 ) {
-                out << ", ";
-            }
-            std::string name = sanitize_text( entry.critter->disp_name() );
-            if( entry.critter->is_avatar() ) {
-                name = "player";
-            }
-            name = strip_leading_article( name );
-            out << name;
-            if( ++count >= max_creatures ) {
-                break;
-            }
+    for( const creature_snapshot &entry : filter_visible( listener, Creature::Attitude::FRIENDLY,
+            visible_range ) ) {
+        if( entry.critter == nullptr ) {
+            continue;
+        }
+        std::string name = sanitize_text( entry.critter->disp_name() );
+        if( entry.critter->is_avatar() ) {
+            name = "player";
+        }
+        snap.friendlies.push_back( strip_leading_article( name ) );
+        if( snap.friendlies.size() >= max_creatures ) {
+            break;
         }
-        out << "\n";
     }
 
-    out << "\n";
-
     item_location wielded = listener.get_wielded_item();
-
-    out << "wielded: ";
     if( wielded ) {
-        const item &weapon = *wielded;
-        out << "wielded=\"" << sanitize_text( weapon.tname() ) << "\"";
-    } else {
-        out << "wielded=none";
+        snap.wielded = sanitize_text( wielded->tname() );
     }
-    out << "\n";
 
     std::vector<std::string> combat_guns;
     std::vector<std::string> combat_melee;
-    bool bandage_possible = false;
     const auto format_gun_label = []( const item & gun ) -> std::string {
         std::string name = sanitize_text( gun.tname() );
         int capacity = 0;
@@ -2293,7 +2684,7 @@ std::string build_snapshot_json( npc &listener, const std::string &player_uttera
             }
         }
         if( it->is_medication() || it->is_medical_tool() ) {
-            bandage_possible = true;
+            snap.bandage_possible = true;
         }
         if( combat_guns.size() >= max_items &&
             combat_melee.size() >= max_items ) {
@@ -2302,49 +2693,294 @@ std::string build_snapshot_json( npc &listener, const std::string &player_uttera
         return VisitResponse::NEXT;
     } );
 
-    std::vector<std::string> combat_items;
-    combat_items.reserve( max_items );
+    snap.weapons.reserve( max_items );
     for( const std::string &gun : combat_guns ) {
-        if( combat_items.size() >= max_items ) {
+        if( snap.weapons.size() >= max_items ) {
             break;
         }
-        combat_items.push_back( gun );
+        snap.weapons.push_back( gun );
     }
     for( const std::string &melee : combat_melee ) {
-        if( combat_items.size() >= max_items ) {
+        if( snap.weapons.size() >= max_items ) {
             break;
         }
-        combat_items.push_back( melee );
+        snap.weapons.push_back( melee );
+    }
+
+    capture_map_snapshot( listener, request_id, snap );
+    return snap;
+}
+
+std::string render_hours_ago( const npc_snapshot &snap, const time_point &turn )
+{
+    std::ostringstream hours_stream;
+    hours_stream << std::fixed << std::setprecision( 1 ) << to_hours<double>( snap.taken_at - turn );
+    return hours_stream.str();
+}
+
+// The snapshot is split so that everything that stays the same between requests for one
+// NPC comes first.  Backends with prefix caching then only re-encode the tail.
+std::string render_snapshot_prefix( const npc_snapshot &snap )
+{
+    std::ostringstream out;
+    out << "your_name: " << snap.name << "\n";
+    out << "your_profession: " << ( snap.profession.empty() ? "no_past" : snap.profession ) << "\n";
+    if( !snap.background_summary.background.empty() ) {
+        out << "your_tone: " << snap.background_summary.background << "\n";
+    }
+    if( !snap.background_summary.expression.empty() ) {
+        out << "your_example_expression: " << snap.background_summary.expression << "\n";
+    }
+    out << "your_personality[0-10]: ";
+    out << "aggression=" << snap.aggression;
+    out << " bravery=" << snap.bravery;
+    out << " collector=" << snap.collector;
+    out << " altruism=" << snap.altruism << "\n";
+
+    out << "player name: " << snap.player_name << "\n\n";
+    out << "legend:\n" << build_snapshot_legend();
+    out << "map axes: +x east/right, -x west/left, +y north/up, -y south/down\n\n";
+    return out.str();
+}
+
+std::string render_snapshot_tail( const npc_snapshot &snap, const snapshot_detail &detail )
+{
+    std::ostringstream out;
+    const std::vector<npc::llm_intent_memory_entry> &memory = snap.memory;
+    const std::vector<std::shared_ptr<const npc::llm_overheard_memory_entry>> &overheard =
+                snap.overheard;
+    out << "Recent conversation newest first:\n";
+    if( memory.empty() && overheard.empty() ) {
+        out << "(none)\n\n";
+    } else {
+        const size_t line_count = std::max( memory.size(), overheard.size() );
+        for( size_t i = 0; i < line_count; ++i ) {
+            out << "-";
+            bool has_hours = false;
+            bool has_segment = false;
+            if( i < memory.size() ) {
+                const npc::llm_intent_memory_entry &entry = memory[memory.size() - 1 - i];
+                out << " hours_ago=" << render_hours_ago( snap, entry.turn );
+                has_hours = true;
+                if( !entry.player_utterance.empty() ) {
+                    out << " player:\"" << sanitize_text( entry.player_utterance ) << "\"";
+                    has_segment = true;
+                }
+                if( !entry.npc_response.empty() ) {
+                    out << " You:\"" << sanitize_text( entry.npc_response ) << "\"";
+                    has_segment = true;
+                }
+                if( !entry.actions.empty() ) {
+                    out << " actions=[" << join_action_tokens( entry.actions ) << "]";
+                    has_segment = true;
+                }
+            }
+            if( i < overheard.size() ) {
+                const npc::llm_overheard_memory_entry &entry = *overheard[overheard.size() - 1 - i];
+                if( !has_hours ) {
+                    out << " hours_ago=" << render_hours_ago( snap, entry.turn );
+                }
+                if( has_segment ) {
+                    out << " |";
+                }
+                if( !entry.npc_name.empty() ) {
+                    out << " " << sanitize_text( entry.npc_name ) << ":\"";
+                    out << sanitize_text( entry.npc_response ) << "\"";
+                } else if( !entry.npc_response.empty() ) {
+                    out << " Ally:\"" << sanitize_text( entry.npc_response ) << "\"";
+                }
+                if( !entry.actions.empty() ) {
+                    out << " actions=[" << join_action_tokens( entry.actions ) << "]";
+                }
+            }
+            out << "\n";
+        }
+        out << "\n";
+    }
+    out << "your_follow_mode: " << snap.follow_mode << "\n";
+
+    out << "your_state[0-10]: ";
+    out << "morale=" << snap.morale;
+    out << " hunger=" << snap.hunger;
+    out << " thirst=" << snap.thirst;
+    out << " pain=" << snap.pain;
+    out << " stamina=" << snap.stamina;
+    out << " sleepiness=" << snap.sleepiness;
+    out << " hp_percent=" << snap.hp;
+    out << " effects=[";
+    for( size_t i = 0; i < snap.effects.size(); ++i ) {
+        if( i > 0 ) {
+            out << " ";
+        }
+        out << snap.effects[i].first << ":" << snap.effects[i].second;
+    }
+    out << "]\n";
+
+    out << "your_emotions[0-10]: ";
+    out << "danger_assessment=" << snap.danger;
+    out << " panic=" << snap.panic;
+    out << " confidence=" << snap.confidence << "\n";
+
+    out << "your_opinion_of_player[0-10]: ";
+    out << "trust=" << snap.trust;
+    out << " intimidation=" << snap.intimidation;
+    out << " respect=" << snap.respect;
+    out << " anger=" << snap.anger << "\n\n";
+
+    std::vector<std::pair<std::string, float>> threats = snap.threats;
+    if( threats.size() > detail.max_creatures ) {
+        std::stable_sort( threats.begin(), threats.end(), []( const auto & lhs, const auto & rhs ) {
+            return lhs.second > rhs.second;
+        } );
+        threats.resize( detail.max_creatures );
+    }
+    if( threats.empty() ) {
+        out << "threats: (none)\n";
+    } else {
+        out << "threats: ";
+        for( size_t i = 0; i < threats.size(); ++i ) {
+            if( i > 0 ) {
+                out << ", ";
+            }
+            out << threats[i].first << " threat_score[0-100]=" << threats[i].second;
+        }
+        out << "\n";
+    }
+
+    if( snap.friendlies.empty() ) {
+        out << "friendlies: (none)\n";
+    } else {
+        out << "friendlies: ";
+        for( size_t i = 0; i < snap.friendlies.size() && i < detail.max_creatures; ++i ) {
+            if( i > 0 ) {
+                out << ", ";
+            }
+            out << snap.friendlies[i];
+        }
+        out << "\n";
     }
 
+    out << "\n";
+
+    out << "wielded: ";
+    if( snap.wielded ) {
+        out << "wielded=\"" << *snap.wielded << "\"";
+    } else {
+        out << "wielded=none";
+    }
+    out << "\n";
+
     out << "weapons: [";
-    for( size_t i = 0; i < combat_items.size(); ++i ) {
+    for( size_t i = 0; i < snap.weapons.size(); ++i ) {
         if( i > 0 ) {
             out << ", ";
         }
-        out << combat_items[i];
+        out << snap.weapons[i];
     }
     out << "]\n";
-    out << "bandage_possible: " << ( bandage_possible ? "true" : "false" ) << "\n\n";
+    out << "bandage_possible: " << ( snap.bandage_possible ? "true" : "false" ) << "\n\n";
 
-    const map_snapshot map_data = build_ascii_map_snapshot( listener, request_id );
-    out << "legend:\n" << build_snapshot_legend();
+    std::vector<std::pair<char, std::string>> legend_entries = snap.map_legend;
+    if( legend_entries.size() > detail.max_creatures ) {
+        const auto threat_of = [&snap]( char letter ) {
+            const auto found = snap.legend_threat.find( letter );
+            return found == snap.legend_threat.end() ? 0 : found->second;
+        };
+        std::stable_sort( legend_entries.begin(), legend_entries.end(),
+        [&threat_of]( const auto & lhs, const auto & rhs ) {
+            return threat_of( lhs.first ) > threat_of( rhs.first );
+        } );
+        legend_entries.resize( detail.max_creatures );
+    }
+    const std::string legend = build_map_legend( legend_entries );
     out << "creature legend with attitude and threat level:\n";
-    if( map_data.legend.empty() ) {
+    if( legend.empty() ) {
         out << "(none)\n";
     } else {
-        out << map_data.legend << "\n";
+        out << legend << "\n";
+    }
+    if( detail.run_length ) {
+        out << "x*n ... n tiles of x in a row\n";
     }
-    out << "map axes: +x east/right, -x west/left, +y north/up, -y south/down\n";
-    out << "map:\n" << map_data.map;
+    out << "map:\n" << render_ascii_map( snap, detail ) << "\n";
+    out << summarize_outside_map( snap, detail.map_radius );
+    out << "id: " << snap.request_id << "\n";
+    const bool has_player_utterance = !trim_copy( snap.player_utterance ).empty();
+    out << "player utterance present: " << ( has_player_utterance ? "true" : "false" ) << "\n";
+    out << "player utterance: " << snap.player_utterance << "\n";
     return out.str();
 }
 
+size_t estimate_prompt_tokens( const std::string &text )
+{
+    // About four characters per token for this kind of text.
+    return ( text.size() + 3 ) / 4;
+}
+
+// Under a token budget, detail is given up step by step: first long runs of empty tiles,
+// then the map shrinks with the rest summarized per side, while the legend keeps only the
+// most threatening creatures.
+std::string render_snapshot_tail( const npc_snapshot &snap )
+{
+    if( snap.token_budget <= 0 ) {
+        return render_snapshot_tail( snap, snapshot_detail() );
+    }
+    static constexpr size_t all_creatures = std::numeric_limits<size_t>::max();
+    static const std::array<snapshot_detail, 5> levels = { {
+            { npc_snapshot::map_radius, false, all_creatures },
+            { npc_snapshot::map_radius, true, all_creatures },
+            { 14, true, 12 },
+            { 10, true, 8 },
+            { 6, true, 5 }
+        }
+    };
+    const size_t budget = snap.token_budget;
+    const size_t prefix_tokens = estimate_prompt_tokens( render_snapshot_prefix( snap ) );
+    std::string tail;
+    for( const snapshot_detail &detail : levels ) {
+        tail = render_snapshot_tail( snap, detail );
+        if( prefix_tokens + estimate_prompt_tokens( tail ) <= budget ) {
+            break;
+        }
+    }
+    return tail;
+}
+
+std::string render_snapshot( const npc_snapshot &snap )
+{
+    return render_snapshot_prefix( snap ) + render_snapshot_tail( snap );
+}
+
+std::string build_snapshot_json( npc &listener, const std::string &player_utterance,
+                                 const std::string &request_id )
+{
+    return render_snapshot( capture_npc_snapshot( listener, player_utterance, request_id ) );
+}
+
+// Coarse view of an ambient snapshot: who is speaking, to what, and roughly in what mood
+// and company.  Replies cached under the same key are interchangeable.
+std::string ambient_reply_fingerprint( const npc_snapshot &snap )
+{
+    static constexpr int mood_bucket = 4;
+    std::set<std::string> threat_names;
+    for( const std::pair<std::string, float> &threat : snap.threats ) {
+        threat_names.insert( threat.first );
+    }
+    std::string out = string_format( "ambient|%s|%s|%s|m%d t%d a%d f%d|", snap.name,
+                                     snap.background_summary.background,
+                                     utterance_class( snap.player_utterance ), snap.morale / mood_bucket,
+                                     snap.trust / mood_bucket, snap.anger / mood_bucket,
+                                     std::min<int>( snap.friendlies.size(), 3 ) );
+    for( const std::string &name : threat_names ) {
+        out += name;
+        out.push_back( ',' );
+    }
+    return out;
+}
+
 std::string default_npc_action_prompt_template()
 {
-    return R"(Situation:
-{{snapshot}}
-<System>You are controlling a human survivor NPC in a cataclysmic world, exhausted, armed, and trying not to die.Return a single line only, with correct syntax, to be parsed by the game.This line has two to four fields separated by ‘|’ :
+    return R"(<System>You are controlling a human survivor NPC in a cataclysmic world, exhausted, armed, and trying not to die.Return a single line only, with correct syntax, to be parsed by the game.This line has two to four fields separated by ‘|’ :
 <Field 1>The first field is an answer to player_utterance.If player_utterance_present is false, this is a spontaneous check-in with no direct player input.You have decided to team up with the player for now, and must answer as the NPC.Stick to your role, with your emotions and opinions.</Field 1>
 <Fields 2-4>Write 1-3 of the following allowed actions exactly:
 {{action_list_with_target}}
@@ -2380,16 +3016,18 @@ Print only Fields 1-4, separated by | .If you break this format, you have failed
 /no_think
 Answer directly. No reasoning.
 </System>
+Situation:
+{{snapshot}}
 )";
 }
 
 std::string default_npc_ambient_prompt_template()
 {
-    return R"(Situation:
-{{snapshot}}
-<System>You are {{npc_name}}, a human survivor NPC speaking to another person in a cataclysmic world.You are not allies, and eyeing them.Even if they seem nice, you never know these days. Everybody does things to survive.Reply deeply in character, informed by the snapshot: your background, your tone, your opinions of the player, and your recent memories.Return exactly one short spoken reply only: 1-3 sentences, no narration, no bullet points, no stage directions, no action tokens, no pipe-separated action line, no tool calls, no menu syntax.If you are unsure, answer briefly and naturally instead of inventing details./no_think
+    return R"(<System>You are {{npc_name}}, a human survivor NPC speaking to another person in a cataclysmic world.You are not allies, and eyeing them.Even if they seem nice, you never know these days. Everybody does things to survive.Reply deeply in character, informed by the snapshot: your background, your tone, your opinions of the player, and your recent memories.Return exactly one short spoken reply only: 1-3 sentences, no narration, no bullet points, no stage directions, no action tokens, no pipe-separated action line, no tool calls, no menu syntax.If you are unsure, answer briefly and naturally instead of inventing details./no_think
 Answer directly. No reasoning.
 </System>
+Situation:
+{{snapshot}}
 <PlayerUtterance>{{player_utterance}}</PlayerUtterance>
 )";
 }
@@ -2442,18 +3080,73 @@ std::string build_ambient_prompt( const std::string &npc_name,
     } );
 }
 
-[[maybe_unused]] std::string request_to_json( const llm_intent_request &request )
+void render_pending_snapshot( llm_intent_request &req )
+{
+    if( !req.pending_snapshot ) {
+        return;
+    }
+    const std::string tail = render_snapshot_tail( *req.pending_snapshot );
+    req.snapshot = render_snapshot_prefix( *req.pending_snapshot ) + tail;
+    req.pending_snapshot.reset();
+    if( req.ambient ) {
+        req.prompt = build_ambient_prompt( req.npc_name, req.player_utterance, req.snapshot );
+    } else {
+        req.prompt = build_prompt( req.npc_name, req.player_utterance, req.snapshot );
+    }
+    // Everything before the volatile tail comes from the template and the stable prefix.
+    const size_t tail_pos = req.prompt.rfind( tail );
+    req.prompt_prefix_bytes = tail_pos == std::string::npos ? 0 : tail_pos;
+    req.session_key = string_format( "npc_%d", req.npc_id.get_value() );
+    if( req.log_prompt ) {
+        append_llm_intent_log( string_format( "%s %s (%s)\n%s\n\n",
+                                              req.ambient ? "ambient prompt" : "prompt",
+                                              req.npc_name, req.request_id, req.prompt ) );
+    }
+}
+
+void write_request_json( JsonOut &jsout, const llm_intent_request &request )
 {
-    std::ostringstream out;
-    JsonOut jsout( out );
     jsout.start_object();
     jsout.member( "request_id", request.request_id );
+    // The snapshot is part of the prompt, the runner needs nothing but the prompt.
     jsout.member( "prompt", request.prompt );
-    jsout.member( "snapshot", request.snapshot );
     jsout.member( "max_tokens", request.max_tokens );
     jsout.member( "temperature", request.temperature );
     jsout.member( "top_p", request.top_p );
     jsout.member( "repetition_penalty", request.repetition_penalty );
+    if( !request.session_key.empty() ) {
+        jsout.member( "session", request.session_key );
+        jsout.member( "prefix_bytes", request.prompt_prefix_bytes );
+    }
+    if( request.stream ) {
+        jsout.member( "stream", true );
+    }
+    jsout.end_object();
+}
+
+[[maybe_unused]] std::string request_to_json( const llm_intent_request &request )
+{
+    std::ostringstream out;
+    JsonOut jsout( out );
+    write_request_json( jsout, request );
+    return out.str();
+}
+
+// The runner answers a batch with one response line per request, in order.
+[[maybe_unused]] std::string batch_to_json( const std::string &batch_id,
+        const std::vector<llm_intent_request> &requests )
+{
+    std::ostringstream out;
+    JsonOut jsout( out );
+    jsout.start_object();
+    jsout.member( "command", "batch" );
+    jsout.member( "request_id", batch_id );
+    jsout.member( "requests" );
+    jsout.start_array();
+    for( const llm_intent_request &request : requests ) {
+        write_request_json( jsout, request );
+    }
+    jsout.end_array();
     jsout.end_object();
     return out.str();
 }
@@ -2509,6 +3202,22 @@ bool should_attempt_parse( const std::string &line )
         response.ok = obj.get_bool( "ok", false );
         response.text = obj.get_string( "text", "" );
         response.error = obj.get_string( "error", "" );
+        response.partial = obj.get_bool( "partial", false );
+        if( obj.has_object( "metrics" ) ) {
+            TextJsonObject metrics = obj.get_object( "metrics" );
+            metrics.allow_omitted_members();
+            // OpenVINO counts with its tokenizer, Ollama reports its own eval counts.
+            if( metrics.has_int( "prompt_tokens" ) ) {
+                response.timing.prompt_tokens = metrics.get_int( "prompt_tokens" );
+            } else if( metrics.has_int( "prompt_eval_count" ) ) {
+                response.timing.prompt_tokens = metrics.get_int( "prompt_eval_count" );
+            }
+            if( metrics.has_int( "generated_tokens" ) ) {
+                response.timing.generated_tokens = metrics.get_int( "generated_tokens" );
+            } else if( metrics.has_int( "eval_count" ) ) {
+                response.timing.generated_tokens = metrics.get_int( "eval_count" );
+            }
+        }
     } catch( const std::exception &err ) {
         return std::nullopt;
     }
@@ -2598,6 +3307,7 @@ bool should_attempt_parse( const std::string &line )
         cfg.max_prompt_len = default_max_prompt_len;
     }
     cfg.force_npu = get_option<bool>( "LLM_INTENT_FORCE_NPU" );
+    cfg.socket_path = get_option<std::string>( "LLM_INTENT_RUNNER_SOCKET" );
     return cfg;
 }
 
@@ -2625,10 +3335,17 @@ std::string quote_windows_arg( const std::string &arg )
 class llm_intent_runner_process
 {
     public:
+        explicit llm_intent_runner_process( std::string log_filename ) : log_filename( std::move( log_filename ) ) {
+        }
+        llm_intent_runner_process( const llm_intent_runner_process & ) = delete;
+        llm_intent_runner_process &operator=( const llm_intent_runner_process & ) = delete;
         ~llm_intent_runner_process() {
             shutdown();
         }
 
+        /** Called on the worker thread for each partial response read while waiting. */
+        std::function<void( llm_intent_response )> on_partial;
+
         bool ensure_running( const runner_config &config, std::string &error ) {
             if( running && config == active_config ) {
                 return true;
@@ -2645,20 +3362,34 @@ class llm_intent_runner_process
             if( !write_all( payload, error ) ) {
                 return false;
             }
-            std::chrono::milliseconds effective_timeout = timeout;
-            if( !warm && timeout.count() > 0 ) {
-                static constexpr auto startup_grace = std::chrono::milliseconds( 120000 );
-                if( effective_timeout < startup_grace ) {
-                    effective_timeout = startup_grace;
-                }
-            }
-            const bool ok = read_response_for_request( request, response_line, effective_timeout, error );
+            const bool ok = read_response_for_request( request, response_line,
+                            effective_timeout( timeout ), error );
             if( ok ) {
                 warm = true;
             }
             return ok;
         }
 
+        /** Sends @p requests as one batch, @p response_lines gets the answers read so far. */
+        bool send_batch( const std::string &batch_id, const std::vector<llm_intent_request> &requests,
+                         std::vector<std::string> &response_lines, std::string &error,
+                         std::chrono::milliseconds timeout ) {
+            std::string payload = batch_to_json( batch_id, requests );
+            payload.push_back( '\n' );
+            if( !write_all( payload, error ) ) {
+                return false;
+            }
+            for( const llm_intent_request &request : requests ) {
+                std::string line;
+                if( !read_response_for_request( request, line, effective_timeout( timeout ), error ) ) {
+                    return false;
+                }
+                response_lines.push_back( std::move( line ) );
+                warm = true;
+            }
+            return true;
+        }
+
         void terminate() {
             if( !running ) {
                 return;
@@ -2670,9 +3401,18 @@ class llm_intent_runner_process
         }
 
     private:
+        std::string log_filename;
         bool running = false;
         bool warm = false;
         runner_config active_config;
+
+        std::chrono::milliseconds effective_timeout( std::chrono::milliseconds timeout ) const {
+            static constexpr auto startup_grace = std::chrono::milliseconds( 120000 );
+            if( !warm && timeout.count() > 0 && timeout < startup_grace ) {
+                return startup_grace;
+            }
+            return timeout;
+        }
         HANDLE child_process = nullptr;
         HANDLE child_thread = nullptr;
         HANDLE stdin_write = nullptr;
@@ -2695,7 +3435,7 @@ class llm_intent_runner_process
             std::filesystem::path python_path = resolve_path( config.python_path );
             std::filesystem::path runner_path = resolve_path( config.runner_path );
             std::filesystem::path model_dir = resolve_path( config.model_dir );
-            std::filesystem::path log_path = central_llm_log_path( "llm_intent_runner.log" );
+            std::filesystem::path log_path = central_llm_log_path( log_filename.c_str() );
             std::error_code mkdir_ec;
             std::filesystem::create_directories( central_llm_config_dir_path(), mkdir_ec );
 
@@ -2888,7 +3628,13 @@ class llm_intent_runner_process
                     if( !trimmed.empty() && trimmed.back() == '\r' ) {
                         trimmed.pop_back();
                     }
-                    if( response_from_json( trimmed, request ) ) {
+                    if( std::optional<llm_intent_response> parsed = response_from_json( trimmed, request ) ) {
+                        if( parsed->partial ) {
+                            if( on_partial ) {
+                                on_partial( std::move( *parsed ) );
+                            }
+                            continue;
+                        }
                         out_line = trimmed;
                         return true;
                     }
@@ -2942,10 +3688,17 @@ class llm_intent_runner_process
 class posix_runner_process
 {
     public:
+        explicit posix_runner_process( std::string log_filename ) : log_filename( std::move( log_filename ) ) {
+        }
+        posix_runner_process( const posix_runner_process & ) = delete;
+        posix_runner_process &operator=( const posix_runner_process & ) = delete;
         ~posix_runner_process() {
             shutdown();
         }
 
+        /** Called on the worker thread for each partial response read while waiting. */
+        std::function<void( llm_intent_response )> on_partial;
+
         bool ensure_running( const runner_config &config, std::string &error ) {
             if( running && config == active_config ) {
                 return true;
@@ -2962,20 +3715,34 @@ class posix_runner_process
             if( !write_all( payload, error ) ) {
                 return false;
             }
-            std::chrono::milliseconds effective_timeout = timeout;
-            if( !warm && timeout.count() > 0 ) {
-                static constexpr auto startup_grace = std::chrono::milliseconds( 120000 );
-                if( effective_timeout < startup_grace ) {
-                    effective_timeout = startup_grace;
-                }
-            }
-            const bool ok = read_response_for_request( request, response_line, effective_timeout, error );
+            const bool ok = read_response_for_request( request, response_line,
+                            effective_timeout( timeout ), error );
             if( ok ) {
                 warm = true;
             }
             return ok;
         }
 
+        /** Sends @p requests as one batch, @p response_lines gets the answers read so far. */
+        bool send_batch( const std::string &batch_id, const std::vector<llm_intent_request> &requests,
+                         std::vector<std::string> &response_lines, std::string &error,
+                         std::chrono::milliseconds timeout ) {
+            std::string payload = batch_to_json( batch_id, requests );
+            payload.push_back( '\n' );
+            if( !write_all( payload, error ) ) {
+                return false;
+            }
+            for( const llm_intent_request &request : requests ) {
+                std::string line;
+                if( !read_response_for_request( request, line, effective_timeout( timeout ), error ) ) {
+                    return false;
+                }
+                response_lines.push_back( std::move( line ) );
+                warm = true;
+            }
+            return true;
+        }
+
         void terminate() {
             if( !running ) {
                 return;
@@ -2987,16 +3754,127 @@ class posix_runner_process
         }
 
     private:
+        std::string log_filename;
         bool running = false;
         bool warm = false;
         runner_config active_config;
+
+        std::chrono::milliseconds effective_timeout( std::chrono::milliseconds timeout ) const {
+            static constexpr auto startup_grace = std::chrono::milliseconds( 120000 );
+            if( !warm && timeout.count() > 0 && timeout < startup_grace ) {
+                return startup_grace;
+            }
+            return timeout;
+        }
         pid_t child_pid = -1;
         int stdin_write = -1;
         int stdout_read = -1;
         std::string stdout_buffer;
         std::filesystem::path runner_log_path;
 
+        // Talks to the daemon listening on config.socket_path over the same lines of JSON. The
+        // daemon greets with the fingerprint of the config it was launched with. One launched
+        // with another is left, with its pid in stale_pid if it gave one, so start replaces it.
+        bool connect_daemon( const runner_config &config, const std::filesystem::path &log_path,
+                             pid_t &stale_pid ) {
+            stale_pid = -1;
+            sockaddr_un addr {};
+            addr.sun_family = AF_UNIX;
+            if( config.socket_path.size() >= sizeof( addr.sun_path ) ) {
+                return false;
+            }
+            std::copy( config.socket_path.begin(), config.socket_path.end(), addr.sun_path );
+            const int fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+            if( fd < 0 ) {
+                return false;
+            }
+            if( connect( fd, reinterpret_cast<const sockaddr *>( &addr ), sizeof( addr ) ) < 0 ) {
+                close( fd );
+                return false;
+            }
+            stdin_write = fd;
+            stdout_read = dup( fd );
+            int flags = fcntl( stdout_read, F_GETFL, 0 );
+            fcntl( stdout_read, F_SETFL, flags | O_NONBLOCK );
+            child_pid = -1;
+            stdout_buffer.clear();
+            llm_intent_request greeting;
+            greeting.request_id = "handshake";
+            std::string line;
+            std::string error;
+            std::string config_id;
+            if( read_response_for_request( greeting, line, std::chrono::milliseconds( 2000 ), error ) ) {
+                try {
+                    std::istringstream in( line );
+                    TextJsonIn jsin( in );
+                    TextJsonObject obj = jsin.get_object();
+                    obj.allow_omitted_members();
+                    config_id = obj.get_string( "config_id", "" );
+                    stale_pid = obj.get_int( "pid", -1 );
+                } catch( const std::exception & ) {
+                    config_id.clear();
+                }
+            }
+            if( config_id != config.fingerprint() ) {
+                // Either a daemon from before handshakes, or one running another model or backend.
+                close_handles();
+                return false;
+            }
+            stale_pid = -1;
+            running = true;
+            // A daemon that was already up has its model loaded, one that just started doesn't.
+            warm = false;
+            runner_log_path = log_path;
+            active_config = config;
+            return true;
+        }
+
+        // Starts the runner as a daemon of its own session, so it stays when the game quits.
+        bool spawn_daemon( const std::filesystem::path &python_path, std::vector<std::string> args,
+                           std::string &error ) {
+            pid_t pid = fork();
+            if( pid < 0 ) {
+                error = "Failed to fork process.";
+                return false;
+            }
+            if( pid == 0 ) {
+                setsid();
+                // Forked again so that the daemon isn't our child and needs no reaping.
+                if( fork() != 0 ) {
+                    _exit( 0 );
+                }
+                const int null_fd = open( "/dev/null", O_RDWR );
+                if( null_fd >= 0 ) {
+                    dup2( null_fd, STDIN_FILENO );
+                    dup2( null_fd, STDOUT_FILENO );
+                    dup2( null_fd, STDERR_FILENO );
+                    close( null_fd );
+                }
+                std::vector<char *> argv;
+                argv.reserve( args.size() + 1 );
+                for( std::string &arg : args ) {
+                    argv.push_back( arg.data() );
+                }
+                argv.push_back( nullptr );
+                execv( python_path.c_str(), argv.data() );
+                _exit( 127 );
+            }
+            int status = 0;
+            waitpid( pid, &status, 0 );
+            return true;
+        }
+
         bool start( const runner_config &config, std::string &error ) {
+            pid_t stale_pid = -1;
+            if( !config.socket_path.empty() ) {
+                if( connect_daemon( config, central_llm_log_path( log_filename.c_str() ), stale_pid ) ) {
+                    return true;
+                }
+                // Launched with other settings, the one started below takes over its socket.
+                if( stale_pid > 0 ) {
+                    kill( stale_pid, SIGTERM );
+                }
+            }
             const std::string backend = lower_copy( config.backend );
             const bool use_api_mode = config.use_api || backend == "api";
             const bool use_ollama_mode = backend == "ollama";
@@ -3011,7 +3889,7 @@ class posix_runner_process
             std::filesystem::path python_path = resolve_path( config.python_path );
             std::filesystem::path runner_path = resolve_path( config.runner_path );
             std::filesystem::path model_dir = resolve_path( config.model_dir );
-            std::filesystem::path log_path = central_llm_log_path( "llm_intent_runner.log" );
+            std::filesystem::path log_path = central_llm_log_path( log_filename.c_str() );
             std::error_code mkdir_ec;
             std::filesystem::create_directories( central_llm_config_dir_path(), mkdir_ec );
 
@@ -3060,6 +3938,29 @@ class posix_runner_process
             args.push_back( "--log-file" );
             args.push_back( log_path.string() );
 
+            if( !config.socket_path.empty() ) {
+                args.push_back( "--listen" );
+                args.push_back( config.socket_path );
+                args.push_back( "--config-id" );
+                args.push_back( config.fingerprint() );
+                if( !spawn_daemon( python_path, args, error ) ) {
+                    return false;
+                }
+                // The daemon listens before it loads the model, so this only waits for Python.
+                for( int attempt = 0; attempt < 100; ++attempt ) {
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+                    if( connect_daemon( config, log_path, stale_pid ) ) {
+                        return true;
+                    }
+                    // The old daemon may still be taking new connections.
+                    if( stale_pid > 0 ) {
+                        kill( stale_pid, SIGTERM );
+                    }
+                }
+                error = "The LLM runner daemon didn't start listening on " + config.socket_path + ".";
+                return false;
+            }
+
             int stdout_pipe[2];
             if( pipe( stdout_pipe ) < 0 ) {
                 error = "Failed to create stdout pipe.";
@@ -3164,6 +4065,15 @@ class posix_runner_process
                     if( errno == EINTR ) {
                         continue;
                     }
+                    // A daemon's socket shares the non-blocking flag of its read end.
+#if EAGAIN != EWOULDBLOCK
+                    if( errno == EAGAIN || errno == EWOULDBLOCK ) {
+#else
+                    if( errno == EAGAIN ) {
+#endif
+                        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+                        continue;
+                    }
                     error = "Failed to write to runner stdin.";
                     return false;
                 }
@@ -3191,7 +4101,13 @@ class posix_runner_process
                     if( !trimmed.empty() && trimmed.back() == '\r' ) {
                         trimmed.pop_back();
                     }
-                    if( response_from_json( trimmed, request ) ) {
+                    if( std::optional<llm_intent_response> parsed = response_from_json( trimmed, request ) ) {
+                        if( parsed->partial ) {
+                            if( on_partial ) {
+                                on_partial( std::move( *parsed ) );
+                            }
+                            continue;
+                        }
                         out_line = trimmed;
                         return true;
                     }
@@ -3267,6 +4183,167 @@ class posix_runner_process
 };
 #endif
 
+double elapsed_ms( std::chrono::steady_clock::time_point from,
+                   std::chrono::steady_clock::time_point to )
+{
+    return std::chrono::duration<double, std::milli>( to - from ).count();
+}
+
+/**
+ * The last few hundred finished requests with their timings, for the debug menu and for
+ * dumps that tools/llm_runner scripts can read.  Game thread only.
+ */
+class llm_telemetry
+{
+    public:
+        struct entry {
+            std::string request_id;
+            std::string npc_name;
+            std::string kind;
+            bool ok = false;
+            bool cached = false;
+            bool parse_failed = false;
+            llm_request_timing timing;
+        };
+
+        void note_partial( const llm_intent_response &partial ) {
+            first_partial_at.emplace( partial.request_id, partial.timing.received_at );
+        }
+
+        void record( const llm_intent_response &resp, const std::string &kind, bool parse_failed ) {
+            entry e;
+            e.request_id = resp.request_id;
+            e.npc_name = resp.npc_name;
+            e.kind = kind;
+            e.ok = resp.ok;
+            e.cached = resp.raw == "(cached)";
+            e.parse_failed = parse_failed;
+            e.timing = resp.timing;
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if( e.timing.queued_at != std::chrono::steady_clock::time_point() ) {
+                e.timing.total_ms = elapsed_ms( e.timing.queued_at, now );
+            }
+            const auto partial = first_partial_at.find( resp.request_id );
+            if( partial != first_partial_at.end() ) {
+                e.timing.ttft_ms = elapsed_ms( e.timing.runner_started_at, partial->second );
+                first_partial_at.erase( partial );
+            }
+            entries.push_back( std::move( e ) );
+            while( entries.size() > max_entries ) {
+                entries.pop_front();
+            }
+        }
+
+        std::string summary() const {
+            std::string out = string_format( "Last %d LLM requests\n", entries.size() );
+            for( const char *kind : {
+                     "all", "primary", "ambient", "look_around", "look_inventory"
+                 } ) {
+                std::vector<const entry *> picked;
+                for( const entry &e : entries ) {
+                    if( std::string_view( kind ) == "all" || e.kind == kind ) {
+                        picked.push_back( &e );
+                    }
+                }
+                if( picked.empty() ) {
+                    continue;
+                }
+                int ok = 0;
+                int cached = 0;
+                int parse_failed = 0;
+                for( const entry *e : picked ) {
+                    ok += e->ok ? 1 : 0;
+                    cached += e->cached ? 1 : 0;
+                    parse_failed += e->parse_failed ? 1 : 0;
+                }
+                out += string_format( "\n%s: %d requests, %d ok, %d cached, %d parse failures\n", kind,
+                                      picked.size(), ok, cached, parse_failed );
+                const auto span = [&]( const char *name, double llm_request_timing::*field ) {
+                    std::vector<double> values;
+                    for( const entry *e : picked ) {
+                        if( !e->cached && e->timing.*field >= 0.0 ) {
+                            values.push_back( e->timing.*field );
+                        }
+                    }
+                    if( values.empty() ) {
+                        return;
+                    }
+                    std::sort( values.begin(), values.end() );
+                    out += string_format( "  %-8s p50 %8.1f ms  p95 %8.1f ms  max %8.1f ms\n", name,
+                                          values[values.size() / 2], values[values.size() * 95 / 100],
+                                          values.back() );
+                };
+                span( "capture", &llm_request_timing::capture_ms );
+                span( "queue", &llm_request_timing::queue_ms );
+                span( "render", &llm_request_timing::render_ms );
+                span( "ttft", &llm_request_timing::ttft_ms );
+                span( "runner", &llm_request_timing::runner_ms );
+                span( "total", &llm_request_timing::total_ms );
+                int64_t prompt_tokens = 0;
+                int64_t generated_tokens = 0;
+                double runner_ms = 0.0;
+                int counted = 0;
+                for( const entry *e : picked ) {
+                    if( e->timing.prompt_tokens >= 0 && e->timing.generated_tokens >= 0 ) {
+                        prompt_tokens += e->timing.prompt_tokens;
+                        generated_tokens += e->timing.generated_tokens;
+                        runner_ms += e->timing.runner_ms;
+                        ++counted;
+                    }
+                }
+                if( counted > 0 ) {
+                    out += string_format( "  tokens   prompt %d  generated %d per request, %.1f generated/s\n",
+                                          prompt_tokens / counted, generated_tokens / counted,
+                                          runner_ms > 0.0 ? generated_tokens * 1000.0 / runner_ms : 0.0 );
+                }
+            }
+            return out;
+        }
+
+        void write_csv( std::ostream &out ) const {
+            out << "request_id,npc,kind,ok,cached,parse_failed,capture_ms,queue_ms,render_ms,ttft_ms,"
+                "runner_ms,total_ms,prompt_tokens,generated_tokens\n";
+            for( const entry &e : entries ) {
+                std::string npc_name = e.npc_name;
+                std::replace( npc_name.begin(), npc_name.end(), ',', ' ' );
+                out << string_format( "%s,%s,%s,%d,%d,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%d,%d\n",
+                                      e.request_id, npc_name, e.kind, e.ok, e.cached, e.parse_failed,
+                                      e.timing.capture_ms, e.timing.queue_ms, e.timing.render_ms,
+                                      e.timing.ttft_ms, e.timing.runner_ms, e.timing.total_ms,
+                                      e.timing.prompt_tokens, e.timing.generated_tokens );
+            }
+        }
+
+        void write_json( std::ostream &out ) const {
+            JsonOut jsout( out, true );
+            jsout.start_array();
+            for( const entry &e : entries ) {
+                jsout.start_object();
+                jsout.member( "request_id", e.request_id );
+                jsout.member( "npc", e.npc_name );
+                jsout.member( "kind", e.kind );
+                jsout.member( "ok", e.ok );
+                jsout.member( "cached", e.cached );
+                jsout.member( "parse_failed", e.parse_failed );
+                jsout.member( "capture_ms", e.timing.capture_ms );
+                jsout.member( "queue_ms", e.timing.queue_ms );
+                jsout.member( "render_ms", e.timing.render_ms );
+                jsout.member( "ttft_ms", e.timing.ttft_ms );
+                jsout.member( "runner_ms", e.timing.runner_ms );
+                jsout.member( "total_ms", e.timing.total_ms );
+                jsout.member( "prompt_tokens", e.timing.prompt_tokens );
+                jsout.member( "generated_tokens", e.timing.generated_tokens );
+                jsout.end_object();
+            }
+            jsout.end_array();
+        }
+
+    private:
+        static constexpr size_t max_entries = 512;
+        std::deque<entry> entries;
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> first_partial_at;
+};
+
 class llm_intent_manager
 {
     private:
@@ -3296,13 +4373,28 @@ class llm_intent_manager
             queue_primary_request( listener, player_utterance );
         }
 
+        void enqueue_random_request( npc &listener ) {
+            queue_primary_request( listener, "", llm_request_priority::ambient );
+        }
+
         void enqueue_ambient_request( npc &listener, const std::string &player_utterance ) {
             queue_ambient_request( listener, player_utterance );
         }
 
         void enqueue_requests_serial( const std::vector<npc *> &listeners,
                                       const std::string &player_utterance ) {
-            if( !get_option<bool>( "LLM_INTENT_ENABLE" ) ) {
+            if( !option_llm_intent_enable.get() ) {
+                return;
+            }
+            if( option_llm_intent_batch_shouts.get() && listeners.size() > 1 ) {
+                // Everyone answers at once, so nobody overhears the others' replies first.
+                const std::string batch_id = string_format( "batch_%d", counter.fetch_add( 1 ) );
+                for( npc *listener : listeners ) {
+                    if( listener != nullptr ) {
+                        queue_primary_request( *listener, player_utterance, llm_request_priority::primary,
+                                               batch_id );
+                    }
+                }
                 return;
             }
             {
@@ -3311,6 +4403,8 @@ class llm_intent_manager
                     if( listener == nullptr ) {
                         continue;
                     }
+                    // A queued serial request dropped here is dispatched again below.
+                    supersede_queued_locked( listener->getID(), llm_request_priority::primary );
                     if( pending_primary_npcs.count( listener->getID() ) > 0 ) {
                         continue;
                     }
@@ -3321,45 +4415,57 @@ class llm_intent_manager
             dispatch_next_serial_primary_request();
         }
 
-        void queue_primary_request( npc &listener, const std::string &player_utterance ) {
-            if( !get_option<bool>( "LLM_INTENT_ENABLE" ) ) {
+        void queue_primary_request( npc &listener, const std::string &player_utterance,
+                                    llm_request_priority priority = llm_request_priority::primary,
+                                    const std::string &batch_id = {} ) {
+            if( !option_llm_intent_enable.get() ) {
                 return;
             }
+            bool dispatch_next_serial = false;
             {
                 std::lock_guard<std::mutex> lock( mutex );
+                if( priority == llm_request_priority::primary ) {
+                    dispatch_next_serial = supersede_queued_locked( listener.getID(), priority );
+                }
                 if( pending_primary_npcs.count( listener.getID() ) > 0 ) {
                     return;
                 }
                 pending_primary_npcs.insert( listener.getID() );
             }
+            if( dispatch_next_serial ) {
+                dispatch_next_serial_primary_request();
+            }
             static constexpr int default_max_tokens = 20000;
             llm_intent_request req;
             req.request_id = next_request_id();
             req.npc_id = listener.getID();
             req.npc_name = listener.get_name();
-            req.snapshot = build_snapshot_json( listener, player_utterance, req.request_id );
-            req.prompt = build_prompt( req.npc_name, player_utterance, req.snapshot );
+            const std::chrono::steady_clock::time_point capture_start = std::chrono::steady_clock::now();
+            req.pending_snapshot = std::make_shared<const npc_snapshot>(
+                                       capture_npc_snapshot( listener, player_utterance, req.request_id ) );
+            req.capture_ms = elapsed_ms( capture_start, std::chrono::steady_clock::now() );
+            req.player_utterance = player_utterance;
             req.max_tokens = default_max_tokens;
-            req.temperature = get_option<float>( "LLM_INTENT_TEMPERATURE" );
-            req.top_p = get_option<float>( "LLM_INTENT_TOP_P" );
-            req.repetition_penalty = get_option<float>( "LLM_INTENT_REPETITION_PENALTY" );
-            if( get_option<bool>( "DEBUG_LLM_INTENT_LOG" ) ) {
-                append_llm_intent_log( string_format( "prompt %s (%s)\n%s\n\n",
-                                                      req.npc_name, req.request_id, req.prompt ) );
-            }
+            req.temperature = option_llm_intent_temperature.get();
+            req.top_p = option_llm_intent_top_p.get();
+            req.repetition_penalty = option_llm_intent_repetition_penalty.get();
+            req.log_prompt = option_debug_llm_intent_log.get();
+            req.priority = priority;
+            req.batch_id = batch_id;
+            req.stream = option_llm_intent_stream_speech.get();
             {
                 std::lock_guard<std::mutex> lock( mutex );
                 utterance_by_request[req.request_id] = player_utterance;
                 snapshot_origin_by_request[req.request_id] = listener.pos_abs();
                 primary_request_ids.insert( req.request_id );
-                request_queue.push( std::move( req ) );
+                push_request_locked( std::move( req ) );
             }
             ensure_worker();
             cv.notify_one();
         }
 
         void queue_ambient_request( npc &listener, const std::string &player_utterance ) {
-            if( !get_option<bool>( "LLM_INTENT_ENABLE" ) ) {
+            if( !option_llm_intent_enable.get() ) {
                 return;
             }
             {
@@ -3374,26 +4480,100 @@ class llm_intent_manager
             req.request_id = next_request_id();
             req.npc_id = listener.getID();
             req.npc_name = listener.get_name();
-            req.snapshot = build_snapshot_json( listener, player_utterance, req.request_id );
-            req.prompt = build_ambient_prompt( req.npc_name, player_utterance, req.snapshot );
+            const std::chrono::steady_clock::time_point capture_start = std::chrono::steady_clock::now();
+            req.pending_snapshot = std::make_shared<const npc_snapshot>(
+                                       capture_npc_snapshot( listener, player_utterance, req.request_id ) );
+            req.capture_ms = elapsed_ms( capture_start, std::chrono::steady_clock::now() );
+            req.player_utterance = player_utterance;
+            req.ambient = true;
+            req.priority = llm_request_priority::ambient;
             req.max_tokens = ambient_max_tokens;
-            req.temperature = get_option<float>( "LLM_INTENT_TEMPERATURE" );
-            req.top_p = get_option<float>( "LLM_INTENT_TOP_P" );
-            req.repetition_penalty = get_option<float>( "LLM_INTENT_REPETITION_PENALTY" );
-            if( get_option<bool>( "DEBUG_LLM_INTENT_LOG" ) ) {
-                append_llm_intent_log( string_format( "ambient prompt %s (%s)\n%s\n\n",
-                                                      req.npc_name, req.request_id, req.prompt ) );
-            }
+            req.temperature = option_llm_intent_temperature.get();
+            req.top_p = option_llm_intent_top_p.get();
+            req.repetition_penalty = option_llm_intent_repetition_penalty.get();
+            req.log_prompt = option_debug_llm_intent_log.get();
+            const std::string fingerprint = ambient_reply_fingerprint( *req.pending_snapshot );
+            const std::optional<std::string> cached = take_cached_reply( fingerprint,
+                    ambient_reply_max_age );
             {
                 std::lock_guard<std::mutex> lock( mutex );
                 utterance_by_request[req.request_id] = player_utterance;
                 ambient_request_ids.insert( req.request_id );
-                request_queue.push( std::move( req ) );
+                if( cached ) {
+                    response_queue.push( cached_response( req, *cached ) );
+                    return;
+                }
+                reply_fingerprint_by_request[req.request_id] = fingerprint;
+                push_request_locked( std::move( req ) );
             }
             ensure_worker();
             cv.notify_one();
         }
 
+        struct cached_reply {
+            std::string text;
+            time_point stored_at = calendar::before_time_starts;
+            int uses = 0;
+        };
+        static constexpr int reply_cache_size = 256;
+        static constexpr int low_memory_reply_cache_size = 32;
+        // An entry is dropped after this many reuses so a fresh reply gets generated.
+        static constexpr int reply_cache_max_uses = 3;
+        static constexpr time_duration ambient_reply_max_age = 2_hours;
+        static constexpr time_duration look_reply_max_age = 30_minutes;
+
+        static int reply_cache_limit() {
+            return memory_budget::low_memory_profile() ? low_memory_reply_cache_size : reply_cache_size;
+        }
+
+        std::optional<std::string> take_cached_reply( const std::string &fingerprint,
+                const time_duration &max_age ) {
+            if( !option_llm_intent_reply_cache.get() ) {
+                return std::nullopt;
+            }
+            std::lock_guard<std::mutex> lock( mutex );
+            cached_reply entry = reply_cache.get( fingerprint, cached_reply() );
+            if( entry.text.empty() ) {
+                return std::nullopt;
+            }
+            if( calendar::turn - entry.stored_at > max_age ) {
+                reply_cache.remove( fingerprint );
+                return std::nullopt;
+            }
+            if( ++entry.uses >= reply_cache_max_uses ) {
+                reply_cache.remove( fingerprint );
+            } else {
+                reply_cache.insert( reply_cache_limit(), fingerprint, entry );
+            }
+            return entry.text;
+        }
+
+        // Files a model reply under the fingerprint its request was queued with, if any.
+        void remember_reply_locked( const std::string &request_id, const std::string &text ) {
+            const auto it = reply_fingerprint_by_request.find( request_id );
+            if( it == reply_fingerprint_by_request.end() ) {
+                return;
+            }
+            if( !text.empty() && option_llm_intent_reply_cache.get() ) {
+                reply_cache.insert( reply_cache_limit(), it->second, cached_reply{ text, calendar::turn, 0 } );
+            }
+            reply_fingerprint_by_request.erase( it );
+        }
+
+        static llm_intent_response cached_response( const llm_intent_request &req,
+                const std::string &text ) {
+            llm_intent_response response;
+            response.request_id = req.request_id;
+            response.npc_id = req.npc_id;
+            response.npc_name = req.npc_name;
+            response.ok = true;
+            response.text = text;
+            response.raw = "(cached)";
+            response.timing.queued_at = std::chrono::steady_clock::now();
+            response.timing.capture_ms = req.capture_ms;
+            return response;
+        }
+
         void dispatch_next_serial_primary_request() {
             while( true ) {
                 pending_primary_request pending;
@@ -3411,7 +4591,7 @@ class llm_intent_manager
                     pending_primary_npcs.erase( pending.npc_id );
                     continue;
                 }
-                if( !get_option<bool>( "LLM_INTENT_ENABLE" ) ) {
+                if( !option_llm_intent_enable.get() ) {
                     std::lock_guard<std::mutex> lock( mutex );
                     pending_primary_npcs.erase( pending.npc_id );
                     while( !pending_primary_requests.empty() ) {
@@ -3425,16 +4605,14 @@ class llm_intent_manager
                 req.request_id = next_request_id();
                 req.npc_id = listener->getID();
                 req.npc_name = listener->get_name();
-                req.snapshot = build_snapshot_json( *listener, pending.player_utterance, req.request_id );
-                req.prompt = build_prompt( req.npc_name, pending.player_utterance, req.snapshot );
+                req.pending_snapshot = std::make_shared<const npc_snapshot>(
+                                           capture_npc_snapshot( *listener, pending.player_utterance, req.request_id ) );
+                req.player_utterance = pending.player_utterance;
                 req.max_tokens = default_max_tokens;
-                req.temperature = get_option<float>( "LLM_INTENT_TEMPERATURE" );
-                req.top_p = get_option<float>( "LLM_INTENT_TOP_P" );
-                req.repetition_penalty = get_option<float>( "LLM_INTENT_REPETITION_PENALTY" );
-                if( get_option<bool>( "DEBUG_LLM_INTENT_LOG" ) ) {
-                    append_llm_intent_log( string_format( "prompt %s (%s)\n%s\n\n",
-                                                          req.npc_name, req.request_id, req.prompt ) );
-                }
+                req.temperature = option_llm_intent_temperature.get();
+                req.top_p = option_llm_intent_top_p.get();
+                req.repetition_penalty = option_llm_intent_repetition_penalty.get();
+                req.log_prompt = option_debug_llm_intent_log.get();
                 {
                     std::lock_guard<std::mutex> lock( mutex );
                     utterance_by_request[req.request_id] = pending.player_utterance;
@@ -3442,7 +4620,7 @@ class llm_intent_manager
                     primary_request_ids.insert( req.request_id );
                     pending_primary_npcs.insert( req.npc_id );
                     serial_primary_request_ids.insert( req.request_id );
-                    request_queue.push( std::move( req ) );
+                    push_request_locked( std::move( req ) );
                 }
                 ensure_worker();
                 cv.notify_one();
@@ -3456,7 +4634,7 @@ class llm_intent_manager
         }
 
         void prewarm() {
-            if( !get_option<bool>( "LLM_INTENT_ENABLE" ) ) {
+            if( !option_llm_intent_enable.get() ) {
                 return;
             }
             const runner_config config = current_runner_config();
@@ -3467,16 +4645,20 @@ class llm_intent_manager
             ensure_worker();
             std::string error;
             if( config.force_npu && config.device != "NPU" ) {
-                if( get_option<bool>( "DEBUG_LLM_INTENT_UI" ) ) {
+                if( option_debug_llm_intent_ui.get() ) {
                     add_msg( "LLM intent prewarm skipped: LLM_INTENT_FORCE_NPU requires device NPU." );
                 }
                 return;
             }
-            if( !runner.ensure_running( config, error ) ) {
-                if( get_option<bool>( "DEBUG_LLM_INTENT_UI" ) ) {
-                    add_msg( "LLM intent prewarm failed: %s", error );
+            for( std::unique_ptr<runner_slot> &slot : workers ) {
+                // A busy runner is already up.
+                std::unique_lock<std::mutex> runner_lock( slot->runner_mutex, std::try_to_lock );
+                if( runner_lock.owns_lock() && !slot->runner.ensure_running( config, error ) ) {
+                    if( option_debug_llm_intent_ui.get() ) {
+                        add_msg( "LLM intent prewarm failed: %s", error );
+                    }
+                    return;
                 }
-                return;
             }
             if( !warmup_enqueued.exchange( true ) ) {
                 llm_intent_request warm;
@@ -3486,14 +4668,17 @@ class llm_intent_manager
                 warm.snapshot = "{}";
                 warm.prompt = build_prompt( "", "", warm.snapshot );
                 warm.max_tokens = 8;
-                warm.temperature = get_option<float>( "LLM_INTENT_TEMPERATURE" );
-                warm.top_p = get_option<float>( "LLM_INTENT_TOP_P" );
-                warm.repetition_penalty = get_option<float>( "LLM_INTENT_REPETITION_PENALTY" );
+                warm.temperature = option_llm_intent_temperature.get();
+                warm.top_p = option_llm_intent_top_p.get();
+                warm.repetition_penalty = option_llm_intent_repetition_penalty.get();
                 {
+                    // One per runner, idle workers each pick one up.
                     std::lock_guard<std::mutex> lock( mutex );
-                    request_queue.push( std::move( warm ) );
+                    for( size_t i = 0; i < workers.size(); ++i ) {
+                        push_request_locked( llm_intent_request( warm ) );
+                    }
                 }
-                cv.notify_one();
+                cv.notify_all();
             }
         }
 
@@ -3514,16 +4699,26 @@ class llm_intent_manager
             req.npc_name = listener.get_name();
             req.snapshot = "{}";
             req.prompt = build_look_around_prompt( player_utterance, items );
+            req.priority = llm_request_priority::look;
             req.max_tokens = look_max_tokens;
-            req.temperature = get_option<float>( "LLM_INTENT_TEMPERATURE" );
-            req.top_p = get_option<float>( "LLM_INTENT_TOP_P" );
-            req.repetition_penalty = get_option<float>( "LLM_INTENT_REPETITION_PENALTY" );
+            req.temperature = option_llm_intent_temperature.get();
+            req.top_p = option_llm_intent_top_p.get();
+            req.repetition_penalty = option_llm_intent_repetition_penalty.get();
 
             look_around_context context;
             context.npc_id = req.npc_id;
             context.npc_name = req.npc_name;
             context.items = items;
 
+            const std::string fingerprint = look_around_fingerprint( listener, player_utterance, items );
+            if( const std::optional<std::string> cached = take_cached_reply( fingerprint,
+                    look_reply_max_age ) ) {
+                std::lock_guard<std::mutex> lock( mutex );
+                look_around_requests.emplace( req.request_id, std::move( context ) );
+                response_queue.push( cached_response( req, *cached ) );
+                return;
+            }
+
             append_llm_intent_log( string_format( "look_around request %s (%s)\n%s\n\n",
                                                   req.npc_name,
                                                   req.request_id,
@@ -3531,7 +4726,8 @@ class llm_intent_manager
             {
                 std::lock_guard<std::mutex> lock( mutex );
                 look_around_requests.emplace( req.request_id, std::move( context ) );
-                request_queue.push( std::move( req ) );
+                reply_fingerprint_by_request[req.request_id] = fingerprint;
+                push_request_locked( std::move( req ) );
             }
             ensure_worker();
             cv.notify_one();
@@ -3605,10 +4801,11 @@ class llm_intent_manager
             req.npc_name = listener.get_name();
             req.snapshot = "{}";
             req.prompt = build_look_inventory_prompt( player_utterance, inventory );
+            req.priority = llm_request_priority::look;
             req.max_tokens = look_max_tokens;
-            req.temperature = get_option<float>( "LLM_INTENT_TEMPERATURE" );
-            req.top_p = get_option<float>( "LLM_INTENT_TOP_P" );
-            req.repetition_penalty = get_option<float>( "LLM_INTENT_REPETITION_PENALTY" );
+            req.temperature = option_llm_intent_temperature.get();
+            req.top_p = option_llm_intent_top_p.get();
+            req.repetition_penalty = option_llm_intent_repetition_penalty.get();
 
             look_inventory_context context;
             context.npc_id = req.npc_id;
@@ -3622,7 +4819,7 @@ class llm_intent_manager
             {
                 std::lock_guard<std::mutex> lock( mutex );
                 look_inventory_requests.emplace( req.request_id, std::move( context ) );
-                request_queue.push( std::move( req ) );
+                push_request_locked( std::move( req ) );
             }
             ensure_worker();
             cv.notify_one();
@@ -3660,7 +4857,77 @@ class llm_intent_manager
             }
         }
 
+        std::string telemetry_summary() const {
+            return telemetry.summary();
+        }
+
+        size_t queue_depth() {
+            std::lock_guard<std::mutex> lock( mutex );
+            return request_queue.size();
+        }
+
+        // The cached replies can't be walked, they are counted at their struct size only.
+        void add_memory_usage( memory_report::report &out ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            size_t request_bytes = 0;
+            for( const llm_intent_request &req : request_queue ) {
+                request_bytes += sizeof( llm_intent_request ) + memory_report::heap_bytes( req.prompt ) +
+                                 memory_report::heap_bytes( req.snapshot ) +
+                                 memory_report::heap_bytes( req.player_utterance );
+            }
+            out.add( "llm_requests", request_queue.size(), request_bytes );
+            out.add( "llm_responses", response_queue.size(),
+                     response_queue.size() * sizeof( llm_intent_response ) );
+            out.add( "llm_reply_cache", reply_cache.size(), reply_cache.size() * sizeof( cached_reply ) );
+        }
+
+        void clear_reply_cache() {
+            std::lock_guard<std::mutex> lock( mutex );
+            reply_cache.clear();
+        }
+
+        // Dumps the recent request timings as CSV and JSON, returns the CSV path or "" on failure.
+        std::string write_telemetry() const {
+            const std::filesystem::path config_dir = central_llm_config_dir_path();
+            std::error_code ec;
+            std::filesystem::create_directories( config_dir, ec );
+            const std::string csv_path = central_llm_log_path( "llm_intent_telemetry.csv" ).u8string();
+            const std::string json_path = central_llm_log_path( "llm_intent_telemetry.json" ).u8string();
+            const bool ok = write_to_file( csv_path, [this]( std::ostream & out ) {
+                telemetry.write_csv( out );
+            }, _( "LLM telemetry" ) ) && write_to_file( json_path, [this]( std::ostream & out ) {
+                telemetry.write_json( out );
+            }, _( "LLM telemetry" ) );
+            return ok ? csv_path : std::string();
+        }
+
+        // Prints the speech of a primary response early, its actions wait for the full payload.
+        void show_streamed_speech( const llm_intent_response &partial ) {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                if( ambient_request_ids.count( partial.request_id ) > 0 ||
+                    look_around_requests.count( partial.request_id ) > 0 ||
+                    look_inventory_requests.count( partial.request_id ) > 0 ) {
+                    return;
+                }
+            }
+            const std::string csv_text = sanitize_llm_csv( extract_csv_from_text( partial.text ) );
+            const std::string speak_text = strip_speaker_prefix( extract_speech_field( csv_text ) );
+            if( speak_text.empty() || !g->find_npc( partial.npc_id ) ||
+                !streamed_speech_requests.insert( partial.request_id ).second ) {
+                return;
+            }
+            add_msg( _( "%s says: \"%s\"" ), partial.npc_name, speak_text );
+            if( option_debug_llm_intent_log.get() ) {
+                append_llm_intent_log( string_format( "say streamed %s (%s)\n%s\n\n",
+                                                      partial.npc_name, partial.request_id, speak_text ) );
+            }
+        }
+
         void process_responses() {
+            if( g != nullptr ) {
+                cancel_stale_requests();
+            }
             std::queue<llm_intent_response> local;
             {
                 std::lock_guard<std::mutex> lock( mutex );
@@ -3671,20 +4938,28 @@ class llm_intent_manager
                 return;
             }
 
-            const bool debug_ui = get_option<bool>( "DEBUG_LLM_INTENT_UI" );
-            const bool debug_log = get_option<bool>( "DEBUG_LLM_INTENT_LOG" );
+            const bool debug_ui = option_debug_llm_intent_ui.get();
+            const bool debug_log = option_debug_llm_intent_log.get();
             while( !local.empty() ) {
                 const llm_intent_response &resp = local.front();
                 if( resp.request_id == "prewarm" ) {
                     local.pop();
                     continue;
                 }
+                if( resp.partial ) {
+                    telemetry.note_partial( resp );
+                    show_streamed_speech( resp );
+                    local.pop();
+                    continue;
+                }
                 {
                     std::lock_guard<std::mutex> lock( mutex );
                     auto it = look_around_requests.find( resp.request_id );
                     if( it != look_around_requests.end() ) {
                         look_around_context context = std::move( it->second );
                         look_around_requests.erase( it );
+                        remember_reply_locked( resp.request_id, resp.ok ? resp.text : std::string() );
+                        telemetry.record( resp, "look_around", false );
                         process_look_around_response( resp, context );
                         local.pop();
                         continue;
@@ -3696,6 +4971,7 @@ class llm_intent_manager
                     if( it != look_inventory_requests.end() ) {
                         look_inventory_context context = std::move( it->second );
                         look_inventory_requests.erase( it );
+                        telemetry.record( resp, "look_inventory", false );
                         process_look_inventory_response( resp, context );
                         local.pop();
                         continue;
@@ -3722,6 +4998,11 @@ class llm_intent_manager
                     } else {
                         ambient_error = resp.error;
                     }
+                    {
+                        std::lock_guard<std::mutex> lock( mutex );
+                        remember_reply_locked( resp.request_id, ambient_error.empty() ? resp.text : std::string() );
+                    }
+                    telemetry.record( resp, "ambient", resp.ok && !ambient_error.empty() );
                     if( ambient_error.empty() ) {
                         if( npc *target = g->find_npc( resp.npc_id ) ) {
                             add_msg( _( "%s says: \"%s\"" ), resp.npc_name, ambient_speech );
@@ -3777,7 +5058,8 @@ class llm_intent_manager
                     std::string csv_text = extract_csv_from_text( resp.text );
                     csv_text = sanitize_llm_csv( csv_text );
                     speak_text = strip_speaker_prefix( extract_speech_field( csv_text ) );
-                    if( !speak_text.empty() ) {
+                    const bool already_said = streamed_speech_requests.erase( resp.request_id ) > 0;
+                    if( !speak_text.empty() && !already_said ) {
                         if( g->find_npc( resp.npc_id ) ) {
                             add_msg( _( "%s says: \"%s\"" ), resp.npc_name, speak_text );
                             if( debug_log ) {
@@ -3961,6 +5243,8 @@ class llm_intent_manager
                 }
                 bool dispatch_next_serial = false;
                 bool is_primary_response = false;
+                streamed_speech_requests.erase( resp.request_id );
+                telemetry.record( resp, "primary", resp.ok && !parse_error.empty() );
                 {
                     std::lock_guard<std::mutex> lock( mutex );
                     utterance_by_request.erase( resp.request_id );
@@ -3981,7 +5265,8 @@ class llm_intent_manager
     private:
         std::mutex mutex;
         std::condition_variable cv;
-        std::queue<llm_intent_request> request_queue;
+        // In arrival order, pop_request_locked picks the most urgent.
+        std::deque<llm_intent_request> request_queue;
         std::queue<llm_intent_response> response_queue;
         std::unordered_map<std::string, std::string> utterance_by_request;
         std::unordered_map<std::string, tripoint_abs_ms> snapshot_origin_by_request;
@@ -3993,30 +5278,99 @@ class llm_intent_manager
         std::unordered_set<std::string> serial_primary_request_ids;
         std::unordered_map<std::string, look_around_context> look_around_requests;
         std::unordered_map<std::string, look_inventory_context> look_inventory_requests;
-        std::thread worker;
-        std::atomic<bool> stopping = false;
-        std::atomic<int> counter = 0;
-        std::atomic<bool> warmup_enqueued = false;
+        // Recent ambient and look_around replies by fingerprint, and the fingerprint each
+        // uncached request of those kinds was queued under.
+        lru_cache<std::string, cached_reply> reply_cache;
+        std::unordered_map<std::string, std::string> reply_fingerprint_by_request;
+        llm_telemetry telemetry;
+        // Requests whose speech was already printed from a partial response, main thread only.
+        std::unordered_set<std::string> streamed_speech_requests;
+        /** One runner process and the worker thread that feeds it. */
+        struct runner_slot {
+            explicit runner_slot( const std::string &log_filename ) : runner( log_filename ) {
+            }
+            std::thread thread;
+            // Held by the worker while it talks to the runner, so prewarm can't start it twice.
+            std::mutex runner_mutex;
+            // Set once the slot is no longer wanted, the worker exits after its current request.
+            std::atomic<bool> retired = false;
+            // Set by the worker on its way out, the thread can then be joined without waiting.
+            std::atomic<bool> finished = false;
 #if defined(_WIN32)
-        llm_intent_runner_process runner;
+            llm_intent_runner_process runner;
 #else
-        posix_runner_process runner;
+            posix_runner_process runner;
 #endif
+        };
+        // One slot per runner that runner_slots_for currently allows.
+        std::vector<std::unique_ptr<runner_slot>> workers;
+        // Slots retired by ensure_worker whose worker may still be finishing a request.
+        std::vector<std::unique_ptr<runner_slot>> retired_workers;
+        std::atomic<bool> stopping = false;
+        std::atomic<int> counter = 0;
+        std::atomic<bool> warmup_enqueued = false;
+
+        // A local model on the NPU can't be shared, every other backend runs one request per
+        // runner process and gets as many as LLM_INTENT_RUNNERS allows.
+        static int runner_slots_for( const runner_config &config ) {
+            if( !config.use_api && lower_copy( config.backend ) == "openvino" && config.device == "NPU" ) {
+                return 1;
+            }
+            return std::max( get_option<int>( "LLM_INTENT_RUNNERS" ), 1 );
+        }
 
         void ensure_worker() {
-            if( worker.joinable() ) {
-                return;
+            const size_t wanted = runner_slots_for( current_runner_config() );
+            // Lowering LLM_INTENT_RUNNERS or moving to the NPU leaves slots over.
+            if( workers.size() > wanted ) {
+                {
+                    // Under the lock, so no worker misses it between checking and waiting.
+                    std::lock_guard<std::mutex> lock( mutex );
+                    while( workers.size() > wanted ) {
+                        workers.back()->retired = true;
+                        retired_workers.push_back( std::move( workers.back() ) );
+                        workers.pop_back();
+                    }
+                }
+                cv.notify_all();
+            }
+            // Dropping a slot shuts its runner down.
+            for( auto it = retired_workers.begin(); it != retired_workers.end(); ) {
+                if( ( *it )->finished ) {
+                    ( *it )->thread.join();
+                    it = retired_workers.erase( it );
+                } else {
+                    ++it;
+                }
+            }
+            while( workers.size() < wanted ) {
+                const std::string log_filename = workers.empty() ? "llm_intent_runner.log" :
+                                                 string_format( "llm_intent_runner.%d.log", workers.size() );
+                workers.push_back( std::make_unique<runner_slot>( log_filename ) );
+                runner_slot &slot = *workers.back();
+                slot.runner.on_partial = [this]( llm_intent_response partial ) {
+                    partial.timing.received_at = std::chrono::steady_clock::now();
+                    std::lock_guard<std::mutex> lock( mutex );
+                    response_queue.push( std::move( partial ) );
+                };
+                slot.thread = std::thread( [this, &slot]() {
+                    worker_loop( slot );
+                } );
             }
-            worker = std::thread( [this]() {
-                worker_loop();
-            } );
         }
 
         void stop() {
             stopping = true;
-            cv.notify_one();
-            if( worker.joinable() ) {
-                worker.join();
+            cv.notify_all();
+            for( std::unique_ptr<runner_slot> &slot : workers ) {
+                if( slot->thread.joinable() ) {
+                    slot->thread.join();
+                }
+            }
+            for( std::unique_ptr<runner_slot> &slot : retired_workers ) {
+                if( slot->thread.joinable() ) {
+                    slot->thread.join();
+                }
             }
         }
 
@@ -4024,29 +5378,238 @@ class llm_intent_manager
             return string_format( "req_%d", counter.fetch_add( 1 ) );
         }
 
-        void worker_loop() {
-            while( !stopping ) {
-                llm_intent_request req;
+        static std::chrono::seconds queue_deadline_for( llm_request_priority priority ) {
+            switch( priority ) {
+                case llm_request_priority::ambient:
+                    return std::chrono::seconds( 30 );
+                case llm_request_priority::look:
+                    return std::chrono::seconds( 60 );
+                case llm_request_priority::primary:
+                    break;
+            }
+            return std::chrono::seconds( 120 );
+        }
+
+        // All push_/pop_/..._locked functions need mutex held.
+        void push_request_locked( llm_intent_request &&req ) {
+            req.queued_at = std::chrono::steady_clock::now();
+            if( req.npc_id.is_valid() ) {
+                req.deadline = std::chrono::steady_clock::now() + queue_deadline_for( req.priority );
+                supersede_queued_locked( req.npc_id, req.priority );
+            }
+            request_queue.push_back( std::move( req ) );
+        }
+
+        // Answered as failed, so process_responses cleans up after it like after any other.
+        void cancel_locked( const llm_intent_request &req, const std::string &reason ) {
+            llm_intent_response response;
+            response.request_id = req.request_id;
+            response.npc_id = req.npc_id;
+            response.npc_name = req.npc_name;
+            response.ok = false;
+            response.error = reason;
+            response.timing.queued_at = req.queued_at;
+            response.timing.capture_ms = req.capture_ms;
+            response_queue.push( std::move( response ) );
+        }
+
+        bool pop_request_locked( llm_intent_request &out ) {
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            auto best = request_queue.end();
+            for( auto it = request_queue.begin(); it != request_queue.end(); ) {
+                if( it->deadline < now ) {
+                    cancel_locked( *it, "Request expired before a runner was free." );
+                    // best is always before it, but erasing from a deque invalidates iterators
+                    const bool was_best = best != request_queue.end();
+                    const size_t best_index = was_best ? best - request_queue.begin() : 0;
+                    it = request_queue.erase( it );
+                    best = was_best ? request_queue.begin() + best_index : request_queue.end();
+                    continue;
+                }
+                if( best == request_queue.end() || it->priority > best->priority ) {
+                    best = it;
+                }
+                ++it;
+            }
+            if( best == request_queue.end() ) {
+                return false;
+            }
+            out = std::move( *best );
+            request_queue.erase( best );
+            return true;
+        }
+
+        /**
+         * Drops the queued requests for @p npc_id that a new request of @p priority makes
+         * pointless, without an answer. Returns whether one of them was the serial request
+         * in flight, so the next one has to be dispatched.
+         */
+        bool supersede_queued_locked( const character_id &npc_id, llm_request_priority priority ) {
+            bool was_serial = false;
+            for( auto it = request_queue.begin(); it != request_queue.end(); ) {
+                if( it->npc_id != npc_id || it->priority > priority ) {
+                    ++it;
+                    continue;
+                }
+                const std::string &id = it->request_id;
+                utterance_by_request.erase( id );
+                snapshot_origin_by_request.erase( id );
+                if( primary_request_ids.erase( id ) > 0 ) {
+                    pending_primary_npcs.erase( npc_id );
+                }
+                if( ambient_request_ids.erase( id ) > 0 ) {
+                    pending_ambient_npcs.erase( npc_id );
+                }
+                look_around_requests.erase( id );
+                look_inventory_requests.erase( id );
+                reply_fingerprint_by_request.erase( id );
+                was_serial |= serial_primary_request_ids.erase( id ) > 0;
+                if( option_debug_llm_intent_log.get() ) {
+                    append_llm_intent_log( string_format( "superseded %s (%s)\n", it->npc_name, id ) );
+                }
+                it = request_queue.erase( it );
+            }
+            return was_serial;
+        }
+
+        // Requests for NPCs that died or wandered off would only waste a runner.
+        void cancel_stale_requests() {
+            static constexpr int stale_distance = 60;
+            const tripoint_abs_ms player_pos = get_player_character().pos_abs();
+            std::lock_guard<std::mutex> lock( mutex );
+            for( auto it = request_queue.begin(); it != request_queue.end(); ) {
+                if( !it->npc_id.is_valid() ) {
+                    ++it;
+                    continue;
+                }
+                const npc *guy = g->find_npc( it->npc_id );
+                if( guy != nullptr && !guy->is_dead() &&
+                    rl_dist( guy->pos_abs(), player_pos ) <= stale_distance ) {
+                    ++it;
+                    continue;
+                }
+                cancel_locked( *it, "NPC is gone or out of range." );
+                it = request_queue.erase( it );
+            }
+        }
+
+        void worker_loop( runner_slot &slot ) {
+            while( !stopping && !slot.retired ) {
+                std::vector<llm_intent_request> batch( 1 );
                 {
                     std::unique_lock<std::mutex> lock( mutex );
-                    cv.wait( lock, [this]() {
-                        return stopping || !request_queue.empty();
+                    cv.wait( lock, [this, &slot]() {
+                        return stopping || slot.retired || !request_queue.empty();
                     } );
-                    if( stopping ) {
+                    if( stopping || slot.retired ) {
                         break;
                     }
-                    req = std::move( request_queue.front() );
-                    request_queue.pop();
+                    if( !pop_request_locked( batch.front() ) ) {
+                        continue;
+                    }
+                    if( !batch.front().batch_id.empty() ) {
+                        take_batch_locked( batch );
+                    }
+                }
+                const std::chrono::steady_clock::time_point popped_at = std::chrono::steady_clock::now();
+                std::vector<double> render_ms;
+                for( llm_intent_request &req : batch ) {
+                    const std::chrono::steady_clock::time_point render_start = std::chrono::steady_clock::now();
+                    render_pending_snapshot( req );
+                    render_ms.push_back( elapsed_ms( render_start, std::chrono::steady_clock::now() ) );
+                }
+                std::vector<llm_intent_response> responses;
+                std::chrono::steady_clock::time_point runner_started_at;
+                {
+                    std::lock_guard<std::mutex> runner_lock( slot.runner_mutex );
+                    runner_started_at = std::chrono::steady_clock::now();
+                    if( batch.size() == 1 ) {
+                        responses.push_back( handle_request( slot.runner, batch.front() ) );
+                    } else {
+                        responses = handle_batch( slot.runner, batch );
+                    }
+                }
+                const std::chrono::steady_clock::time_point received_at = std::chrono::steady_clock::now();
+                for( size_t i = 0; i < responses.size() && i < batch.size(); ++i ) {
+                    llm_request_timing &timing = responses[i].timing;
+                    timing.queued_at = batch[i].queued_at;
+                    timing.runner_started_at = runner_started_at;
+                    timing.received_at = received_at;
+                    timing.capture_ms = batch[i].capture_ms;
+                    timing.queue_ms = elapsed_ms( batch[i].queued_at, popped_at );
+                    timing.render_ms = render_ms[i];
+                    timing.runner_ms = elapsed_ms( runner_started_at, received_at );
                 }
-                llm_intent_response response = handle_request( req );
                 {
                     std::lock_guard<std::mutex> lock( mutex );
-                    response_queue.push( std::move( response ) );
+                    for( llm_intent_response &response : responses ) {
+                        response_queue.push( std::move( response ) );
+                    }
                 }
             }
+            slot.finished = true;
         }
 
-        llm_intent_response handle_request( const llm_intent_request &req ) {
+        // Moves the queued requests of batch.front()'s batch behind it.
+        void take_batch_locked( std::vector<llm_intent_request> &batch ) {
+            const std::string batch_id = batch.front().batch_id;
+            for( auto it = request_queue.begin(); it != request_queue.end(); ) {
+                if( it->batch_id == batch_id ) {
+                    batch.push_back( std::move( *it ) );
+                    it = request_queue.erase( it );
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        template<typename Runner>
+        static std::vector<llm_intent_response> handle_batch( Runner &runner,
+                const std::vector<llm_intent_request> &batch ) {
+            std::vector<llm_intent_response> responses;
+            for( const llm_intent_request &req : batch ) {
+                llm_intent_response response;
+                response.request_id = req.request_id;
+                response.npc_id = req.npc_id;
+                response.npc_name = req.npc_name;
+                response.ok = false;
+                responses.push_back( std::move( response ) );
+            }
+            const auto fail_all = [&responses]( const std::string & error ) {
+                for( llm_intent_response &response : responses ) {
+                    response.error = error;
+                }
+                return responses;
+            };
+            const runner_config config = current_runner_config();
+            std::string error;
+            if( !config.use_api && config.force_npu && config.device != "NPU" ) {
+                return fail_all( "LLM_INTENT_FORCE_NPU requires device NPU." );
+            }
+            if( !runner.ensure_running( config, error ) ) {
+                return fail_all( error );
+            }
+            std::vector<std::string> lines;
+            const int timeout_ms = option_llm_intent_timeout_ms.get();
+            const bool sent = runner.send_batch( batch.front().batch_id, batch, lines, error,
+                                                 std::chrono::milliseconds( timeout_ms ) );
+            if( !sent ) {
+                runner.terminate();
+            }
+            for( size_t i = 0; i < batch.size(); ++i ) {
+                if( i >= lines.size() ) {
+                    responses[i].error = error;
+                } else if( auto parsed = response_from_json( lines[i], batch[i] ) ) {
+                    responses[i] = std::move( *parsed );
+                } else {
+                    responses[i].error = "Runner returned invalid JSON.";
+                }
+            }
+            return responses;
+        }
+
+        template<typename Runner>
+        static llm_intent_response handle_request( Runner &runner, const llm_intent_request &req ) {
             llm_intent_response response;
             response.request_id = req.request_id;
             response.npc_id = req.npc_id;
@@ -4064,7 +5627,7 @@ class llm_intent_manager
                 return response;
             }
             std::string line;
-            const int timeout_ms = get_option<int>( "LLM_INTENT_TIMEOUT_MS" );
+            const int timeout_ms = option_llm_intent_timeout_ms.get();
             if( !runner.send_request( req, line, error,
                                       std::chrono::milliseconds( timeout_ms ) ) ) {
                 runner.terminate();
@@ -4123,10 +5686,10 @@ void process_responses()
 
 void enqueue_random_requests()
 {
-    if( !get_option<bool>( "LLM_INTENT_ENABLE" ) ) {
+    if( !option_llm_intent_enable.get() ) {
         return;
     }
-    const int base_turns = get_option<int>( "LLM_INTENT_RANDOM_CALL" );
+    const int base_turns = option_llm_intent_random_call.get();
     if( g == nullptr ) {
         return;
     }
@@ -4149,7 +5712,7 @@ void enqueue_random_requests()
         if( get_manager().has_pending_primary_request_for( listener->getID() ) ) {
             continue;
         }
-        get_manager().enqueue_request( *listener, "" );
+        get_manager().enqueue_random_request( *listener );
         listener->schedule_next_llm_random_call( base_turns );
     }
 }
@@ -4159,6 +5722,32 @@ void log_event( const std::string &message )
     append_llm_intent_log( message + "\n" );
 }
 
+std::string telemetry_summary()
+{
+    return get_manager().telemetry_summary();
+}
+
+size_t queue_depth()
+{
+    return get_manager().queue_depth();
+}
+
+void add_memory_usage( memory_report::report &out )
+{
+    get_manager().add_memory_usage( out );
+}
+
+void clear_caches()
+{
+    get_manager().clear_reply_cache();
+    get_background_summary_entries().clear();
+}
+
+std::string write_telemetry()
+{
+    return get_manager().write_telemetry();
+}
+
 std::string build_snapshot_for_test( npc &listener, const std::string &player_utterance,
                                      const std::string &request_id )
 {
@@ -4188,4 +5777,22 @@ tripoint_abs_ms resolve_move_target_for_test( const tripoint_abs_ms &origin,
 {
     return resolve_move_target_from_origin( origin, delta );
 }
+
+std::string build_budgeted_snapshot_for_test( npc &listener, const std::string &player_utterance,
+        int token_budget )
+{
+    npc_snapshot snap = capture_npc_snapshot( listener, player_utterance, "budget" );
+    snap.token_budget = token_budget;
+    return render_snapshot( snap );
+}
+
+std::string ambient_reply_fingerprint_for_test( npc &listener, const std::string &player_utterance )
+{
+    return ambient_reply_fingerprint( capture_npc_snapshot( listener, player_utterance, "fingerprint" ) );
+}
+
+void broadcast_overheard_memory_for_test( const npc &speaker, const std::string &speech )
+{
+    broadcast_overheard_memory( speaker, speech, {} );
+}
 } // namespace llm_intent
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
 class npc;
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 
 namespace llm_intent
 {
@@ -16,4 +21,14 @@ void prewarm();
 void process_responses();
 void enqueue_random_requests();
 void log_event( const std::string &message );
+/** Per-kind counts and latency percentiles of the recent requests, for the debug menu. */
+std::string telemetry_summary();
+/** Requests waiting for the runner, for the performance HUD. */
+size_t queue_depth();
+/** Adds the queued requests and responses and the reply cache, for the memory report. */
+void add_memory_usage( memory_report::report &out );
+/** Drops the cached replies and background summaries, they are rebuilt as needed. */
+void clear_caches();
+/** Writes the recent request timings as CSV and JSON to the config dir, returns the CSV path. */
+std::string write_telemetry();
 } // namespace llm_intent
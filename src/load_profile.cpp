@@ -0,0 +1,107 @@
+#include "load_profile.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "json.h"
+
+namespace
+{
+
+int64_t to_us( load_profile::clock::duration d )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( d ).count();
+}
+
+} // namespace
+
+load_profile &get_load_profile()
+{
+    static load_profile profile;
+    return profile;
+}
+
+void load_profile::reset( bool enable )
+{
+    enabled = enable;
+    origin = clock::now();
+    phases.clear();
+    loaders.clear();
+}
+
+void load_profile::add_phase( const std::string &category, const std::string &name,
+                              clock::time_point start, clock::time_point end )
+{
+    if( enabled ) {
+        phases.push_back( { category, name, start, end - start } );
+    }
+}
+
+void load_profile::add_object( const std::string &type, const std::string &src,
+                               clock::duration took )
+{
+    if( !enabled ) {
+        return;
+    }
+    loader_stats &stats = loaders[std::make_pair( type, src )];
+    stats.count++;
+    stats.total += took;
+    stats.max = std::max( stats.max, took );
+}
+
+void load_profile::write( const cata_path &path ) const
+{
+    write_to_file( path, [this]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "displayTimeUnit", "ms" );
+        jsout.member( "traceEvents" );
+        jsout.start_array();
+        for( const phase &p : phases ) {
+            jsout.start_object();
+            jsout.member( "name", p.name );
+            jsout.member( "cat", p.category );
+            // a complete event, with its duration
+            jsout.member( "ph", "X" );
+            jsout.member( "ts", to_us( p.start - origin ) );
+            jsout.member( "dur", to_us( p.took ) );
+            jsout.member( "pid", 1 );
+            jsout.member( "tid", 1 );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.member( "loaders" );
+        jsout.start_array();
+        for( const auto &[key, stats] : loaders ) {
+            jsout.start_object();
+            jsout.member( "type", key.first );
+            jsout.member( "src", key.second );
+            jsout.member( "count", stats.count );
+            jsout.member( "total_us", to_us( stats.total ) );
+            jsout.member( "max_us", to_us( stats.max ) );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, "load profile" );
+}
+
+load_profile_phase::load_profile_phase( const std::string &category, const std::string &name )
+    : enabled( get_load_profile().is_enabled() )
+{
+    if( enabled ) {
+        this->category = category;
+        this->name = name;
+        start = load_profile::clock::now();
+    }
+}
+
+load_profile_phase::~load_profile_phase()
+{
+    if( enabled ) {
+        get_load_profile().add_phase( category, name, start, load_profile::clock::now() );
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef CATA_SRC_LOAD_PROFILE_H
+#define CATA_SRC_LOAD_PROFILE_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class cata_path;
+
+/**
+ * Records where the time goes while the game data is loaded, finalized and checked.
+ *
+ * Loading a data folder, every finalize step and every consistency check become one event
+ * each, the objects handed to the JSON type loaders are only counted and timed per type and
+ * source. @ref write produces a Chrome trace (chrome://tracing or Perfetto can open it) with
+ * the per loader totals in its "loaders" member.
+ */
+class load_profile
+{
+    public:
+        using clock = std::chrono::steady_clock;
+
+        bool is_enabled() const {
+            return enabled;
+        }
+        /** Drops everything recorded so far, then records from now on if @p enable is set. */
+        void reset( bool enable );
+
+        /** Adds a finished phase, @p category groups them, e.g. "load", "finalize" or "check". */
+        void add_phase( const std::string &category, const std::string &name,
+                        clock::time_point start, clock::time_point end );
+        /** Adds one object loaded by the loader for @p type from the mod or folder @p src. */
+        void add_object( const std::string &type, const std::string &src, clock::duration took );
+
+        void write( const cata_path &path ) const;
+
+    private:
+        struct phase {
+            std::string category;
+            std::string name;
+            clock::time_point start;
+            clock::duration took;
+        };
+        struct loader_stats {
+            int count = 0;
+            clock::duration total = clock::duration::zero();
+            clock::duration max = clock::duration::zero();
+        };
+
+        bool enabled = false;
+        clock::time_point origin;
+        std::vector<phase> phases;
+        // keyed on type, then source
+        std::map<std::pair<std::string, std::string>, loader_stats> loaders;
+};
+
+load_profile &get_load_profile();
+
+/** Adds the time between its construction and destruction as a phase, if profiling is on. */
+class load_profile_phase
+{
+    public:
+        load_profile_phase( const std::string &category, const std::string &name );
+        load_profile_phase( const load_profile_phase & ) = delete;
+        load_profile_phase &operator=( const load_profile_phase & ) = delete;
+        ~load_profile_phase();
+
+    private:
+        bool enabled;
+        std::string category;
+        std::string name;
+        load_profile::clock::time_point start;
+};
+
+#endif // CATA_SRC_LOAD_PROFILE_H
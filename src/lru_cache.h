@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_LRU_CACHE_H
 #define CATA_SRC_LRU_CACHE_H
 
+#include <cstddef>
 #include <list>
 #include <unordered_map>
 #include <utility>
@@ -14,11 +15,19 @@ class lru_cache
 
         Value get( const Key &, const Value &default_ ) const;
         void insert( int limit, const Key &, const Value & );
+        /** Same as above, handing every entry it pushes out to @p on_evict once it's removed. */
+        template<typename OnEvict>
+        void insert( int limit, const Key &, const Value &, OnEvict &&on_evict );
         void remove( const Key & );
+        size_t size() const {
+            return map.size();
+        }
 
         void clear();
     protected:
         void trim( int limit );
+        template<typename OnEvict>
+        void trim( int limit, OnEvict &&on_evict );
         void touch( typename std::list<Pair>::iterator iter ) const;
         mutable std::list<Pair> ordered_list;
         std::unordered_map<Key, typename std::list<Pair>::iterator> map;
@@ -63,12 +72,38 @@ inline void lru_cache<Key, Value>::insert( int limit, const Key &pos, const Valu
     }
 }
 
+template<typename Key, typename Value>
+template<typename OnEvict>
+inline void lru_cache<Key, Value>::insert( int limit, const Key &pos, const Value &t,
+        OnEvict &&on_evict )
+{
+    auto found = map.find( pos );
+    if( found == map.end() ) {
+        ordered_list.emplace_back( pos, t );
+        map.emplace( pos, std::prev( ordered_list.end() ) );
+        trim( limit, std::forward<OnEvict>( on_evict ) );
+    } else {
+        auto list_iterator = found->second;
+        touch( list_iterator );
+        list_iterator->second = t;
+    }
+}
+
 template<typename Key, typename Value>
 inline void lru_cache<Key, Value>::trim( int limit )
+{
+    trim( limit, []( const Pair & ) {} );
+}
+
+template<typename Key, typename Value>
+template<typename OnEvict>
+inline void lru_cache<Key, Value>::trim( int limit, OnEvict &&on_evict )
 {
     while( map.size() > static_cast<size_t>( limit ) ) {
-        map.erase( ordered_list.front().first );
+        Pair evicted = std::move( ordered_list.front() );
+        map.erase( evicted.first );
         ordered_list.pop_front();
+        on_evict( evicted );
     }
 }
 
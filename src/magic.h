@@ -189,6 +189,7 @@ class spell_events : public event_subscriber
     public:
         using event_subscriber::notify;
         void notify( const cata::event & ) override;
+        bool notified_by( event_type type ) const override;
 };
 
 // NOLINTNEXTLINE(clang-analyzer-optin.performance.Padding)
@@ -339,23 +339,21 @@ enchantment_id enchantment::load_inline_enchantment( const JsonValue &jv,
 
 bool enchantment::is_active( const Character &guy, const item &parent ) const
 {
-    if( !guy.has_item( parent ) ) {
+    if( !is_carried_right( guy, parent ) ) {
         return false;
     }
+    return !is_conditional() || is_active( guy, parent.active );
+}
 
-    if( active_conditions.first == has::HELD &&
-        active_conditions.second == condition::ALWAYS ) {
-        return true;
+bool enchantment::is_carried_right( const Character &guy, const item &parent ) const
+{
+    if( !guy.has_item( parent ) ) {
+        return false;
     }
-
-    if( !( active_conditions.first == has::HELD ||
+    return active_conditions.first == has::HELD ||
            ( active_conditions.first == has::WIELD && guy.is_wielding( parent ) ) ||
            ( active_conditions.first == has::WORN &&
-             ( guy.is_worn( parent ) || guy.is_worn_module( parent ) ) ) ) ) {
-        return false;
-    }
-
-    return is_active( guy, parent.active );
+             ( guy.is_worn( parent ) || guy.is_worn_module( parent ) ) );
 }
 
 bool enchantment::is_active( const Character &guy, const bool active ) const
@@ -190,6 +190,12 @@ class enchantment
 
         // this enchantment has a valid condition and is in the right location
         bool is_active( const Character &guy, const item &parent ) const;
+        // the location half of the above, it only changes as the inventory does
+        bool is_carried_right( const Character &guy, const item &parent ) const;
+        // whether being in the right location is not enough, see the overload below
+        bool is_conditional() const {
+            return active_conditions.second != condition::ALWAYS;
+        }
 
         // this enchantment has a valid item independent conditions
         // @active means the container for the enchantment is active, for comparison to active flag.
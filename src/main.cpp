@@ -52,6 +52,7 @@
 #include "main_menu.h"
 #include "mapsharing.h"
 #include "memory_fast.h"
+#include "memory_report.h"
 #include "options.h"
 #include "ordered_static_globals.h"
 #include "output.h"
@@ -59,6 +60,7 @@
 #include "rng.h"
 #include "system_locale.h"
 #include "translations.h"
+#include "turn_replay.h"
 #include "type_id.h"
 #include "ui_manager.h"
 #include "cata_imgui.h"
@@ -282,6 +284,9 @@ struct cli_opts {
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
     bool disable_ascii_art = false;
+    bool memory_report = false; /** write memory_report.json once the first game is loaded */
+    std::string replay; /** if set replay the turn recording in this folder and exit */
+    int record_turns = 0; /** if set record this many turns for replay once a game is loaded */
 };
 
 cli_opts parse_commandline( int argc, const char **argv )
@@ -304,6 +309,36 @@ cli_opts parse_commandline( int argc, const char **argv )
                     return 1;
                 }
             },
+            {
+                "--memory-report", {},
+                "Writes memory_report.json to the config directory once a game is loaded",
+                section_default,
+                0,
+                [&result]( int, const char ** ) -> int {
+                    result.memory_report = true;
+                    return 0;
+                }
+            },
+            {
+                "--record-turns", "<turns>",
+                "Records the first turns of the loaded game to turn_replay in the config directory",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.record_turns = std::max( 0, std::atoi( params[0] ) );
+                    return 1;
+                }
+            },
+            {
+                "--replay", "<folder>",
+                "Replays a turn recording with hot path tracing and exits",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.replay = params[0];
+                    return 1;
+                }
+            },
             {
                 "--jsonverify", {},
                 "Checks the CDDA json files and exits",
@@ -859,6 +894,14 @@ int main( int argc, const char *argv[] )
 #endif
     replay_buffered_debugmsg_prompts();
 
+    if( !cli.replay.empty() ) {
+        if( !turn_replay::prepare_replay( cata_path( cata_path::root_path::unknown, cli.replay ),
+                                          cli.world, main_menu::queued_save_id_to_load ) ) {
+            debugmsg( "Can't replay the turn recording in %s", cli.replay );
+            exit_handler( -999 );
+            return 0;
+        }
+    }
     main_menu::queued_world_to_load = std::move( cli.world );
 
     while( true ) {
@@ -869,7 +912,18 @@ int main( int argc, const char *argv[] )
 
         shared_ptr_fast<ui_adaptor> ui = g->create_or_get_main_ui_adaptor();
         get_event_bus().send<event_type::game_begin>( getVersionString() );
+        if( cli.memory_report ) {
+            cli.memory_report = false;
+            memory_report::write( memory_report::collect(),
+                                  PATH_INFO::config_dir_path() / "memory_report.json" );
+        }
+        if( cli.record_turns > 0 ) {
+            turn_replay::request_recording( std::exchange( cli.record_turns, 0 ) );
+        }
         while( !do_turn() ) {}
+        if( turn_replay::replay_finished() ) {
+            break;
+        }
     }
 
     exit_handler( -999 );
@@ -8,7 +8,9 @@
 #include <optional>
 #include <ostream>
 #include <queue>
+#include <set>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -72,16 +74,19 @@
 #include "material.h"
 #include "math_defines.h"
 #include "mission.h"
+#include "memory_budget.h"
 #include "memory_fast.h"
 #include "messages.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
+#include "options.h"
 #include "output.h"
 #include "overmap.h"
 #include "overmap_map_data_cache.h"
 #include "overmapbuffer.h"
 #include "pathfinding.h"
+#include "perf.h"
 #include "pocket_type.h"
 #include "projectile.h"
 #include "ranged.h"
@@ -94,6 +99,7 @@
 #include "sounds.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "translations.h"
 #include "trap.h"
@@ -104,9 +110,11 @@
 #include "vehicle.h"
 #include "vehicle_selector.h"
 #include "viewer.h"
+#include "visibility_oracle.h"
 #include "vpart_position.h"
 #include "vpart_range.h"
 #include "weather.h"
+#include "weather_type.h"
 #include "weighted_list.h"
 
 #if defined(TILES)
@@ -263,6 +271,8 @@ static const ter_str_id ter_t_window_no_curtains( "t_window_no_curtains" );
 static const trap_str_id tr_portal( "tr_portal" );
 static const trap_str_id tr_unfinished_construction( "tr_unfinished_construction" );
 
+static const option_handle<int> option_active_z_range( "ACTIVE_Z_RANGE" );
+
 #define dbg(x) DebugLog((x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
 static cata::colony<item> nulitems;          // Returned when &i_at() is asked for an OOB value
@@ -310,6 +320,11 @@ map::map( int mapsize, bool zlev ) : my_MAPSIZE( mapsize ), my_HALF_MAPSIZE( map
     for( auto &ptr : pathfinding_caches ) {
         ptr = std::make_unique<pathfinding_cache>();
     }
+    route_memos = std::make_unique<route_memo>();
+    sight_oracle = std::make_unique<visibility_oracle>();
+    sight_oracle_wo_fields = std::make_unique<visibility_oracle>();
+    skew_vision_cache = std::make_unique<skew_sight_cache>();
+    skew_vision_wo_fields_cache = std::make_unique<skew_sight_cache>();
 
     dbg( D_INFO ) << "map::map(): my_MAPSIZE: " << my_MAPSIZE << " z-levels enabled:" << zlevels;
     traplocs.resize( trap::count() );
@@ -349,6 +364,25 @@ void map::set_transparency_cache_dirty( const tripoint_bub_ms &p, bool field )
     }
 }
 
+void map::set_transparency_cache_dirty( const tripoint_bub_ms &from, const tripoint_bub_ms &to )
+{
+    if( !inbounds_z( from.z() ) ) {
+        return;
+    }
+    const int max_sm = my_MAPSIZE - 1;
+    const int min_smx = std::clamp( std::min( from.x(), to.x() ) / SEEX, 0, max_sm );
+    const int max_smx = std::clamp( std::max( from.x(), to.x() ) / SEEX, 0, max_sm );
+    const int min_smy = std::clamp( std::min( from.y(), to.y() ) / SEEY, 0, max_sm );
+    const int max_smy = std::clamp( std::max( from.y(), to.y() ) / SEEY, 0, max_sm );
+    std::bitset<MAPSIZE *MAPSIZE> &dirty = get_cache( from.z() ).transparency_cache_dirty;
+    for( int smx = min_smx; smx <= max_smx; ++smx ) {
+        for( int smy = min_smy; smy <= max_smy; ++smy ) {
+            dirty.set( smx * MAPSIZE + smy );
+        }
+    }
+    get_creature_tracker().invalidate_reachability_cache();
+}
+
 void map::set_seen_cache_dirty( const tripoint_bub_ms &change_location )
 {
     if( inbounds( change_location ) ) {
@@ -645,6 +679,7 @@ void map::update_vehicle_list( const submap *const to, const int zlev )
 
 std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
 {
+    vehicle::invalidate_power_grids();
     if( veh == nullptr ) {
         debugmsg( "map::detach_vehicle was passed nullptr" );
         return std::unique_ptr<vehicle>();
@@ -716,6 +751,7 @@ void map::on_vehicle_moved( const int smz )
 
 void map::vehmove()
 {
+    CATA_TRACE_ZONE( "map::vehmove" );
     // give vehicles movement points
     VehicleList vehicle_list;
     int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z();
@@ -784,6 +820,24 @@ void map::vehmove()
 
     // refresh vehicle zones for moved vehicles
     zone_manager::get_manager().cache_vzones( this );
+
+    // Read ahead the submaps the player's vehicle is heading into, so the shift
+    // that needs them doesn't stall on decompressing and parsing them.
+    if( this == &get_map() ) {
+        const Character &player = get_player_character();
+        const optional_vpart_position vp = veh_at( player.pos_bub() );
+        if( vp && vp->vehicle().velocity != 0 ) {
+            const vehicle &veh = vp->vehicle();
+            // A couple of turns at the current speed, plus a submap of slack.
+            const float tiles_ahead = std::abs( veh.velocity ) / vehicles::vmiph_per_tile * 2 + SEEX;
+            const units::angle heading = veh.velocity > 0 ? veh.move.dir() :
+                                         veh.move.dir() + 180_degrees;
+            const int dx = static_cast<int>( std::lround( tiles_ahead * units::cos( heading ) ) );
+            const int dy = static_cast<int>( std::lround( tiles_ahead * units::sin( heading ) ) );
+            prefetch_shift_toward( player.pos_abs() + tripoint_rel_ms( dx, dy, 0 ) );
+            queue_mapgen_toward( player.pos_abs() + tripoint_rel_ms( dx, dy, 0 ) );
+        }
+    }
 }
 
 bool map::vehproceed( VehicleList &vehicle_list )
@@ -1523,6 +1577,7 @@ void map::unboard_vehicle( const tripoint_bub_ms &p, bool dead_passenger )
 bool map::displace_vehicle( vehicle &veh, const tripoint_rel_ms &dp, const bool adjust_pos,
                             const std::set<int> &parts_to_move )
 {
+    vehicle::invalidate_power_grids();
     const tripoint_bub_ms src = veh.pos_bub( *this );
     // handle vehicle ramps
     int ramp_offset = 0;
@@ -1840,6 +1895,7 @@ bool map::furn_set( const tripoint_bub_ms &p, const furn_id &new_furniture, cons
         current_submap->player_adjusted_map = true;
     }
     current_submap->set_furn( l, new_target_furniture );
+    current_submap->bump_content_version();
     current_submap->set_map_damage( point_sm_ms( l ), 0 );
     clear_original_terrain_at( p );
 
@@ -2348,6 +2404,7 @@ bool map::ter_set( const tripoint_bub_ms &p, const ter_id &new_terrain, bool avo
         current_submap->player_adjusted_map = true;
     }
     current_submap->set_ter( l, new_terrain );
+    current_submap->bump_content_version();
     current_submap->set_map_damage( point_sm_ms( l ), 0 );
     // Clear any recorded original terrain when terrain is explicitly set here.
     clear_original_terrain_at( p );
@@ -5260,6 +5317,7 @@ map_stack::iterator map::i_rem( const tripoint_bub_ms &p, const map_stack::const
     }
 
     current_submap->update_lum_rem( l, *it );
+    current_submap->bump_content_version();
 
     return current_submap->get_items( l ).erase( it );
 }
@@ -5283,6 +5341,7 @@ void map::i_clear( const tripoint_bub_ms &p )
     }
 
     current_submap->set_lum( l, 0 );
+    current_submap->bump_content_version();
     current_submap->get_items( l ).clear();
 }
 
@@ -5605,6 +5664,7 @@ item &map::add_item( const tripoint_bub_ms &p, item new_item, int copies )
     invalidate_max_populated_zlev( p.z() );
 
     current_submap->update_lum_add( l, new_item );
+    current_submap->bump_content_version();
 
     const map_stack::iterator new_pos = current_submap->get_items( l ).insert( new_item );
     while( --copies > 0 ) {
@@ -6013,6 +6073,7 @@ static void process_vehicle_items( vehicle &cur_veh, int part )
 
 void map::process_items()
 {
+    CATA_TRACE_ZONE( "map::process_items" );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z();
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z();
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -6629,6 +6690,121 @@ partial_con *map::partial_con_at( const tripoint_bub_ms &p )
     return nullptr;
 }
 
+uint64_t map::content_version( const tripoint_bub_ms &p, int radius ) const
+{
+    if( !inbounds_z( p.z() ) ) {
+        return 0;
+    }
+    const int max_sm = my_MAPSIZE - 1;
+    const int min_x = std::clamp( ( p.x() - radius ) / SEEX, 0, max_sm );
+    const int max_x = std::clamp( ( p.x() + radius ) / SEEX, 0, max_sm );
+    const int min_y = std::clamp( ( p.y() - radius ) / SEEY, 0, max_sm );
+    const int max_y = std::clamp( ( p.y() + radius ) / SEEY, 0, max_sm );
+    uint64_t ret = 0;
+    for( int y = min_y; y <= max_y; ++y ) {
+        for( int x = min_x; x <= max_x; ++x ) {
+            if( const submap *sm = get_submap_at_grid( tripoint_rel_sm( x, y, p.z() ) ) ) {
+                ret += sm->get_content_version();
+            }
+        }
+    }
+    return ret;
+}
+
+std::vector<tripoint_bub_ms> map::item_tiles_near( const tripoint_bub_ms &p, int radius ) const
+{
+    std::vector<tripoint_bub_ms> ret;
+    if( !inbounds_z( p.z() ) ) {
+        return ret;
+    }
+    const int max_sm = my_MAPSIZE - 1;
+    const int min_x = std::clamp( ( p.x() - radius ) / SEEX, 0, max_sm );
+    const int max_x = std::clamp( ( p.x() + radius ) / SEEX, 0, max_sm );
+    const int min_y = std::clamp( ( p.y() - radius ) / SEEY, 0, max_sm );
+    const int max_y = std::clamp( ( p.y() + radius ) / SEEY, 0, max_sm );
+    for( int y = min_y; y <= max_y; ++y ) {
+        for( int x = min_x; x <= max_x; ++x ) {
+            const submap *sm = get_submap_at_grid( tripoint_rel_sm( x, y, p.z() ) );
+            if( sm == nullptr ) {
+                continue;
+            }
+            for( const point_sm_ms &l : sm->get_item_tiles() ) {
+                const tripoint_bub_ms tile( x * SEEX + l.x(), y * SEEY + l.y(), p.z() );
+                if( square_dist( p, tile ) <= radius ) {
+                    ret.push_back( tile );
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+std::vector<tripoint_bub_ms> map::trap_tiles_near( const tripoint_bub_ms &p, int radius ) const
+{
+    std::vector<tripoint_bub_ms> ret;
+    if( !inbounds_z( p.z() ) ) {
+        return ret;
+    }
+    const int max_sm = my_MAPSIZE - 1;
+    const int min_x = std::clamp( ( p.x() - radius ) / SEEX, 0, max_sm );
+    const int max_x = std::clamp( ( p.x() + radius ) / SEEX, 0, max_sm );
+    const int min_y = std::clamp( ( p.y() - radius ) / SEEY, 0, max_sm );
+    const int max_y = std::clamp( ( p.y() + radius ) / SEEY, 0, max_sm );
+    for( int y = min_y; y <= max_y; ++y ) {
+        for( int x = min_x; x <= max_x; ++x ) {
+            const submap *sm = get_submap_at_grid( tripoint_rel_sm( x, y, p.z() ) );
+            if( sm == nullptr ) {
+                continue;
+            }
+            for( const point_sm_ms &l : sm->get_trap_tiles() ) {
+                const tripoint_bub_ms tile( x * SEEX + l.x(), y * SEEY + l.y(), p.z() );
+                if( square_dist( p, tile ) <= radius ) {
+                    ret.push_back( tile );
+                }
+            }
+        }
+    }
+    std::sort( ret.begin(), ret.end(), []( const tripoint_bub_ms & a, const tripoint_bub_ms & b ) {
+        return std::make_pair( a.y(), a.x() ) < std::make_pair( b.y(), b.x() );
+    } );
+    return ret;
+}
+
+std::vector<std::pair<tripoint_bub_ms, int>> map::heat_sources_near( const tripoint_bub_ms &p,
+        int radius ) const
+{
+    std::vector<std::pair<tripoint_bub_ms, int>> ret;
+    if( !inbounds_z( p.z() ) ) {
+        return ret;
+    }
+    const int max_sm = my_MAPSIZE - 1;
+    const int min_x = std::clamp( ( p.x() - radius ) / SEEX, 0, max_sm );
+    const int max_x = std::clamp( ( p.x() + radius ) / SEEX, 0, max_sm );
+    const int min_y = std::clamp( ( p.y() - radius ) / SEEY, 0, max_sm );
+    const int max_y = std::clamp( ( p.y() + radius ) / SEEY, 0, max_sm );
+    for( int y = min_y; y <= max_y; ++y ) {
+        for( int x = min_x; x <= max_x; ++x ) {
+            const submap *sm = get_submap_at_grid( tripoint_rel_sm( x, y, p.z() ) );
+            if( sm == nullptr ) {
+                continue;
+            }
+            for( const std::pair<point_sm_ms, int> &heat : sm->get_heat_tiles() ) {
+                const tripoint_bub_ms tile( x * SEEX + heat.first.x(), y * SEEY + heat.first.y(), p.z() );
+                if( square_dist( p, tile ) <= radius ) {
+                    ret.emplace_back( tile, heat.second );
+                }
+            }
+        }
+    }
+    // Callers sum what they find, keep the order the sum was taken in before.
+    std::sort( ret.begin(), ret.end(), []( const std::pair<tripoint_bub_ms, int> &lhs,
+    const std::pair<tripoint_bub_ms, int> &rhs ) {
+        return std::make_pair( lhs.first.y(), lhs.first.x() ) <
+               std::make_pair( rhs.first.y(), rhs.first.x() );
+    } );
+    return ret;
+}
+
 void map::partial_con_remove( const tripoint_bub_ms &p )
 {
     partial_con_remove_impl( p );
@@ -6656,6 +6832,7 @@ void map::partial_con_remove_impl( const tripoint_bub_ms &p )
         return;
     }
     current_submap->partial_constructions.erase( tripoint_sm_ms( l, p.z() ) );
+    current_submap->bump_content_version();
 }
 
 void map::partial_con_set( const tripoint_bub_ms &p, const partial_con &con )
@@ -6672,6 +6849,7 @@ void map::partial_con_set( const tripoint_bub_ms &p, const partial_con &con )
     if( !current_submap->partial_constructions.emplace( tripoint_sm_ms( l, p.z() ), con ).second ) {
         debugmsg( "set partial con on top of terrain which already has a partial con" );
     }
+    current_submap->bump_content_version();
 }
 
 void map::trap_set( const tripoint_bub_ms &p, const trap_id &type )
@@ -6705,6 +6883,7 @@ void map::trap_set( const tripoint_bub_ms &p, const trap_id &type )
     }
 
     current_submap->set_trap( l, type );
+    current_submap->bump_content_version();
     if( type != tr_null ) {
         traplocs[type.to_i()].push_back( p );
     }
@@ -6735,6 +6914,7 @@ void map::remove_trap( const tripoint_bub_ms &p )
         }
 
         current_submap->set_trap( l, tr_null );
+        current_submap->bump_content_version();
         auto &traps = traplocs[tid.to_i()];
         const auto iter = std::find( traps.begin(), traps.end(), p );
         if( iter != traps.end() ) {
@@ -6986,6 +7166,7 @@ bool map::add_field( const tripoint_bub_ms &p, const field_type_id &type_id, int
     current_submap->ensure_nonuniform();
     invalidate_max_populated_zlev( p.z() );
 
+    current_submap->note_field_cell( l );
     if( current_submap->get_field( l ).add_field( converted_type_id, intensity, age, source ) ) {
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
@@ -7047,6 +7228,12 @@ void map::on_field_modified( const tripoint_bub_ms &p, const field_type &fd_type
 {
     invalidate_max_populated_zlev( p.z() );
 
+    if( fd_type.id == fd_fire ) {
+        if( const submap *sm = get_submap_at( p ) ) {
+            sm->invalidate_heat_tiles();
+        }
+    }
+
     get_cache( p.z() ).field_cache.set(
         static_cast<size_t>( p.x() / SEEX ) + ( ( p.y() / SEEX ) * MAPSIZE ) );
 
@@ -7752,21 +7939,6 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
     return sees( F, T, range, dummy, with_fields );
 }
 
-// TODO: Change this to a hash function on the map implementation. This will also allow us to
-// account for the complete lack of entropy in the top 16 bits.
-point map::sees_cache_key( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const
-{
-    // Canonicalize the order of the tripoints so the cache is reflexive.
-    const tripoint_bub_ms &min = from < to ? from : to;
-    const tripoint_bub_ms &max = !( from < to ) ? from : to;
-
-    // A little gross, just pack the values into an integer.
-    return point(
-               min.x() << 20 | min.y() << 10 | ( min.z() + OVERMAP_DEPTH ),
-               max.x() << 20 | max.y() << 10 | ( max.z() + OVERMAP_DEPTH )
-           );
-}
-
 /**
  * This one is internal-only, we don't want to expose the slope tweaking ickiness outside the map class.
  **/
@@ -7775,40 +7947,35 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
 {
     bool ( map:: * f_transparent )( const tripoint_bub_ms & p ) const =
         with_fields ? &map::is_transparent : &map::is_transparent_wo_fields;
-    lru_cache_t &skew_cache = with_fields ? skew_vision_cache : skew_vision_wo_fields_cache;
+    skew_sight_cache &skew_cache = with_fields ? *skew_vision_cache : *skew_vision_wo_fields_cache;
     if( std::abs( F.z() - T.z() ) > fov_3d_z_range ||
         ( range >= 0 && range < rl_dist( F, T ) ) ||
         !inbounds( T ) ) {
         bresenham_slope = 0;
         return false; // Out of range!
     }
-    const point key = sees_cache_key( F, T );
-    if( allow_cached ) {
-        char cached = skew_cache.get( key, -1 );
-        if( cached != -1 ) {
-            return cached > 0;
-        }
-    }
     bool visible = true;
 
     // Ugly `if` for now
     if( F.z() == T.z() ) {
-        bresenham( F.xy(), T.xy(), bresenham_slope,
-        [this, f_transparent, &visible, &T]( const point_bub_ms & new_point ) {
-            // Exit before checking the last square, it's still visible even if opaque.
-            if( new_point.x() == T.x() && new_point.y() == T.y() ) {
-                return false;
+        visibility_oracle &oracle = with_fields ? *sight_oracle : *sight_oracle_wo_fields;
+        if( allow_cached ) {
+            const int known = oracle.lookup( F, T );
+            if( known != -1 ) {
+                return known > 0;
             }
-            if( !( this->*f_transparent )( { new_point.x(), new_point.y(), T.z()} ) ) {
-                visible = false;
-                return false;
-            }
-            return true;
-        } );
-        skew_cache.insert( 100000, key, visible ? 1 : 0 );
+        }
+        visible = trace_sight_line( F, T, bresenham_slope, with_fields );
+        oracle.store( F, T, visible );
         return visible;
     }
 
+    if( allow_cached ) {
+        const int cached = skew_cache.lookup( F, T );
+        if( cached != -1 ) {
+            return cached > 0;
+        }
+    }
     tripoint_bub_ms last_point = F;
     bresenham( F, T, bresenham_slope, 0,
     [this, f_transparent, &visible, &T, &last_point]( const tripoint_bub_ms & new_point ) {
@@ -7838,10 +8005,61 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
         last_point = new_point;
         return true;
     } );
-    skew_cache.insert( 100000, key, visible ? 1 : 0 );
+    skew_cache.store( F, T, visible );
+    return visible;
+}
+
+bool map::trace_sight_line( const tripoint_bub_ms &F, const tripoint_bub_ms &T,
+                            int &bresenham_slope, bool with_fields ) const
+{
+    bool ( map:: * f_transparent )( const tripoint_bub_ms & p ) const =
+        with_fields ? &map::is_transparent : &map::is_transparent_wo_fields;
+    bool visible = true;
+    bresenham( F.xy(), T.xy(), bresenham_slope,
+    [this, f_transparent, &visible, &T]( const point_bub_ms & new_point ) {
+        // Exit before checking the last square, it's still visible even if opaque.
+        if( new_point.x() == T.x() && new_point.y() == T.y() ) {
+            return false;
+        }
+        if( !( this->*f_transparent )( { new_point.x(), new_point.y(), T.z()} ) ) {
+            visible = false;
+            return false;
+        }
+        return true;
+    } );
     return visible;
 }
 
+void map::prefetch_sight_lines( const std::vector<std::pair<tripoint_bub_ms, tripoint_bub_ms>>
+                                &pairs, bool with_fields ) const
+{
+    visibility_oracle &oracle = with_fields ? *sight_oracle : *sight_oracle_wo_fields;
+    std::vector<std::pair<tripoint_bub_ms, tripoint_bub_ms>> todo;
+    todo.reserve( pairs.size() );
+    for( const std::pair<tripoint_bub_ms, tripoint_bub_ms> &line : pairs ) {
+        if( line.first.z() == line.second.z() && line.first != line.second &&
+            inbounds( line.first ) && inbounds( line.second ) &&
+            oracle.lookup( line.first, line.second ) == -1 ) {
+            todo.push_back( line );
+        }
+    }
+    // The lines only read the transparency caches, only the oracle is written, and that
+    // happens back on this thread.
+    static constexpr int lines_per_chunk = 32;
+    const int chunks = ( static_cast<int>( todo.size() ) + lines_per_chunk - 1 ) / lines_per_chunk;
+    std::vector<char> visible( todo.size(), 0 );
+    cata::get_thread_pool().parallel_for( 0, chunks, [&]( int chunk ) {
+        const size_t end = std::min( todo.size(), static_cast<size_t>( chunk + 1 ) * lines_per_chunk );
+        for( size_t i = static_cast<size_t>( chunk ) * lines_per_chunk; i < end; ++i ) {
+            int slope = 0;
+            visible[i] = trace_sight_line( todo[i].first, todo[i].second, slope, with_fields ) ? 1 : 0;
+        }
+    } );
+    for( size_t i = 0; i < todo.size(); ++i ) {
+        oracle.store( todo[i].first, todo[i].second, visible[i] != 0 );
+    }
+}
+
 int map::obstacle_coverage( const tripoint_bub_ms &loc1, const tripoint_bub_ms &loc2 ) const
 {
     // Can't hide if you are standing on furniture, or non-flat slowing-down terrain tile.
@@ -8392,6 +8610,109 @@ shift_bitset_cache<MAPSIZE_X, SEEX>( std::bitset<MAPSIZE_X *MAPSIZE_X> &cache,
 template void
 shift_bitset_cache<MAPSIZE, 1>( std::bitset<MAPSIZE *MAPSIZE> &cache, const point_rel_sm &s );
 
+// The shift that puts @p center in the middle of a map at @p abs_sub.
+static point_rel_sm shift_to_center( const tripoint_abs_sm &abs_sub,
+                                     const tripoint_abs_ms &center )
+{
+    const tripoint_abs_sm center_sm = project_to<coords::sm>( center );
+    return point_rel_sm( center_sm.x() - HALF_MAPSIZE - abs_sub.x(),
+                         center_sm.y() - HALF_MAPSIZE - abs_sub.y() );
+}
+
+// Whether every submap of the OMT stack at @p omt is buffered or saved, loading them if saved.
+static bool omt_stack_generated( const point_abs_omt &omt )
+{
+    const point_abs_sm base = project_to<coords::sm>( omt );
+    // It might be possible to just check the (0, 0) submap as we should never have
+    // a case where only one submap is missing from an OMT level.
+    for( int gridx = 0; gridx <= 1; gridx++ ) {
+        for( int gridy = 0; gridy <= 1; gridy++ ) {
+            for( int gridz = -OVERMAP_DEPTH; gridz <= OVERMAP_HEIGHT; gridz++ ) {
+                if( !MAPBUFFER.submap_exists( tripoint_abs_sm( base + point( gridx, gridy ), gridz ) ) ) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void map::prefetch_shift_toward( const tripoint_abs_ms &center ) const
+{
+    const point_rel_sm shift = shift_to_center( abs_sub, center );
+    if( shift == point_rel_sm::zero ) {
+        return;
+    }
+    const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z();
+    const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z();
+    for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+        for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+            // The same submap in the grid of the current map.
+            const point old_grid( gridx + shift.x(), gridy + shift.y() );
+            if( old_grid.x >= 0 && old_grid.x < my_MAPSIZE && old_grid.y >= 0 &&
+                old_grid.y < my_MAPSIZE ) {
+                // Already loaded.
+                continue;
+            }
+            for( int gridz = minz; gridz <= maxz; gridz++ ) {
+                MAPBUFFER.prefetch( { abs_sub.x() + old_grid.x, abs_sub.y() + old_grid.y, gridz } );
+            }
+        }
+    }
+}
+
+void map::queue_mapgen_toward( const tripoint_abs_ms &center )
+{
+    // Past this the oldest are dropped, the map has likely moved on from them.
+    static constexpr size_t max_queued_mapgen = 32;
+    if( this != &reality_bubble() || memory_budget::low_memory_profile() ) {
+        return;
+    }
+    const point_rel_sm shift = shift_to_center( abs_sub, center );
+    if( shift == point_rel_sm::zero ) {
+        return;
+    }
+    for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+        for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+            const point old_grid( gridx + shift.x(), gridy + shift.y() );
+            if( old_grid.x >= 0 && old_grid.x < my_MAPSIZE && old_grid.y >= 0 &&
+                old_grid.y < my_MAPSIZE ) {
+                continue;
+            }
+            const point_abs_omt omt = project_to<coords::omt>( point_abs_sm( abs_sub.x() + old_grid.x,
+                                      abs_sub.y() + old_grid.y ) );
+            if( std::find( queued_mapgen.begin(), queued_mapgen.end(), omt ) == queued_mapgen.end() ) {
+                queued_mapgen.push_back( omt );
+            }
+        }
+    }
+    if( queued_mapgen.size() > max_queued_mapgen ) {
+        queued_mapgen.erase( queued_mapgen.begin(),
+                             queued_mapgen.end() - max_queued_mapgen );
+    }
+}
+
+void map::generate_queued_mapgen( const std::chrono::steady_clock::duration budget )
+{
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + budget;
+    while( !queued_mapgen.empty() ) {
+        const point_abs_omt omt = queued_mapgen.front();
+        queued_mapgen.erase( queued_mapgen.begin() );
+        // Saved stacks are left to the map buffer's prefetch, loading them here would stall.
+        if( !MAPBUFFER.submap_exists_approx( tripoint_abs_sm( project_to<coords::sm>( omt ), 0 ) ) &&
+            !omt_stack_generated( omt ) ) {
+            // The same stream loadn would generate it from, see map::generate.
+            smallmap tmp_map;
+            swap_map swap( *tmp_map.cast_to_map() );
+            tmp_map.main_cleanup_override( false );
+            tmp_map.generate( tripoint_abs_omt( omt, abs_sub.z() ), calendar::turn, true );
+        }
+        if( std::chrono::steady_clock::now() >= deadline ) {
+            break;
+        }
+    }
+}
+
 void map::shift( const point_rel_sm &sp )
 {
     if( !zlevels ) {
@@ -8411,6 +8732,10 @@ void map::shift( const point_rel_sm &sp )
 
     const tripoint_abs_sm abs = get_abs_sub();
     std::vector<tripoint_rel_sm> loaded_grids;
+    // Sight lines are stored by local tile.
+    sight_oracle->clear();
+    sight_oracle_wo_fields->clear();
+    ++sight_generation;
 
     const int zmin = -OVERMAP_DEPTH;
     const int zmax = OVERMAP_HEIGHT;
@@ -8422,6 +8747,9 @@ void map::shift( const point_rel_sm &sp )
     const int y_stop = sp.y() >= 0 ? my_MAPSIZE : -1;
     const int y_step = sp.y() >= 0 ? 1 : -1;
 
+    // Vehicles on the submaps that drop off the map, everything else in the vehicle
+    // lists and caches stays and is only moved.
+    std::unordered_set<const vehicle *> leaving;
     // Have to run on_unload before changing the abs_sub for the map.
     // TODO: can probably skip a bunch of iteration here.
     for( int gridx = x_start; gridx != x_stop; gridx += x_step ) {
@@ -8433,6 +8761,17 @@ void map::shift( const point_rel_sm &sp )
                 for( int gridz = zmin; gridz <= zmax; gridz++ ) {
                     const tripoint_rel_sm grid( gridx, gridy, gridz );
                     on_unload( grid );
+                    note_leaving_fire( grid );
+                    const submap *const old_submap = get_submap_at_grid( grid );
+                    level_cache *const cache = get_cache_lazy( gridz );
+                    if( old_submap == nullptr || cache == nullptr ) {
+                        continue;
+                    }
+                    for( const auto &veh : old_submap->vehicles ) {
+                        leaving.insert( veh.get() );
+                        cache->vehicle_list.erase( veh.get() );
+                        cache->zone_vehicles.erase( veh.get() );
+                    }
                 }
             }
         }
@@ -8458,15 +8797,12 @@ void map::shift( const point_rel_sm &sp )
     // Shift the map sx submaps to the right and sy submaps down.
     // sx and sy should never be bigger than +/-1.
     // absx and absy are our position in the world, for saving/loading purposes.
-    clear_vehicle_level_caches();
-
+    const tripoint_rel_ms veh_offset( -sp.x() * SEEX, -sp.y() * SEEY, 0 );
     for( int gridz = zmin; gridz <= zmax; gridz++ ) {
-        // Clear vehicle list and rebuild after shift
-        // mlangsdorf 2020 - this is kind of insane, building the cache is not free, why are
-        // we doing this?
-        clear_vehicle_list( gridz );
         level_cache *cache = get_cache_lazy( gridz );
         if( cache ) {
+            // The vehicles that stay keep their parts where they were on the ground.
+            cache->shift_vehicle_cache( veh_offset, leaving );
             shift_bitset_cache<MAPSIZE_X, SEEX>( cache->map_memory_cache_dec, sp );
             shift_bitset_cache<MAPSIZE_X, SEEX>( cache->map_memory_cache_ter, sp );
             shift_bitset_cache<MAPSIZE, 1>( cache->field_cache, sp );
@@ -8478,14 +8814,7 @@ void map::shift( const point_rel_sm &sp )
             if( gridx + sp.x() != x_stop && gridy + sp.y() != y_stop ) {
                 for( int gridz = zmin; gridz <= zmax; gridz++ ) {
                     const tripoint_rel_sm grid( gridx, gridy, gridz );
-
                     copy_grid( grid, grid + sp );
-                    submap *const cur_submap = get_submap_at_grid( grid );
-                    if( cur_submap == nullptr ) {
-                        debugmsg( "Tried to update vehicle list at %s but the submap is not loaded", grid.to_string() );
-                        continue;
-                    }
-                    update_vehicle_list( cur_submap, gridz );
                 }
             } else {
                 loadn( { gridx, gridy }, true );
@@ -8497,7 +8826,14 @@ void map::shift( const point_rel_sm &sp )
         }
     }
 
-    rebuild_vehicle_level_caches();
+    // Only the vehicles that came in with the new submaps are missing from the caches.
+    for( const tripoint_rel_sm &loaded_grid : loaded_grids ) {
+        if( const submap *const new_submap = get_submap_at_grid( loaded_grid ) ) {
+            for( const auto &veh : new_submap->vehicles ) {
+                add_vehicle_to_cache( veh.get() );
+            }
+        }
+    }
 
     g->setremoteveh( remoteveh );
 
@@ -8513,6 +8849,13 @@ void map::shift( const point_rel_sm &sp )
     for( tripoint_rel_sm loaded_grid : loaded_grids ) {
         actualize( loaded_grid );
     }
+
+    // Whatever moved the map is likely to keep going, so have the stacks past the edge ready.
+    // An OMT is two submaps across, so the next one over is two shifts away.
+    if( this == &reality_bubble() ) {
+        queue_mapgen_toward( project_to<coords::ms>( tripoint_abs_sm( abs_sub.x() + HALF_MAPSIZE + 2 * sp.x(),
+                             abs_sub.y() + HALF_MAPSIZE + 2 * sp.y(), abs_sub.z() ) ) );
+    }
 }
 
 void map::vertical_shift( const int newz )
@@ -8613,30 +8956,12 @@ void map::loadn( const point_bub_sm &grid, bool update_vehicles )
     const tripoint_abs_omt grid_abs_omt = project_to<coords::omt>( grid_abs_sub );
     // Get the base submap "grid" is an offset from.
     const tripoint_abs_sm grid_sm_base = project_to<coords::sm>( grid_abs_omt );
-    bool map_incomplete = false;
-
     map &bubble_map = reality_bubble();
 
     bool const main_inbounds =
         this != &bubble_map && bubble_map.inbounds( project_to<coords::ms>( grid_abs_sub ) );
 
-    // It might be possible to just check the (0, 0) submap as we should never have
-    // a case where only one submap is missing from an OMT level.
-    for( int gridx = 0; gridx <= 1; gridx++ ) {
-        for( int gridy = 0; gridy <= 1; gridy++ ) {
-            for( int gridz = -OVERMAP_DEPTH; gridz <= OVERMAP_HEIGHT; gridz++ ) {
-                const tripoint grid_pos( gridx, gridy, gridz );
-                const tripoint_abs_sm check_pos = grid_sm_base.xy() + grid_pos;
-                const bool submap_exists = MAPBUFFER.submap_exists( check_pos );
-                if( !submap_exists ) {
-                    map_incomplete = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    if( map_incomplete ) {
+    if( !omt_stack_generated( grid_abs_omt.xy() ) ) {
         smallmap tmp_map;
         swap_map swap( *tmp_map.cast_to_map() );
         tmp_map.main_cleanup_override( false );
@@ -9214,10 +9539,74 @@ void map::actualize( const tripoint_rel_sm &grid )
         }
     }
 
+    if( this == &get_map() ) {
+        materialize_overmap_fire( grid );
+    }
+
     // the last time we touched the submap, is right now.
     tmpsub->last_touched = calendar::turn;
 }
 
+void map::note_leaving_fire( const tripoint_rel_sm &grid )
+{
+    // Overmap fires only burn on the surface.
+    const submap *const sm = get_submap_at_grid( grid );
+    if( grid.z() != 0 || sm == nullptr || sm->field_count == 0 ) {
+        return;
+    }
+    const tripoint_bub_ms origin = rebase_bub( project_to<coords::ms>( grid ) );
+    // The flammable squares next to or under a fire that could spread, each counted once.
+    std::set<tripoint_bub_ms> fuel_squares;
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const tripoint_bub_ms p = origin + point( x, y );
+            // Fires in fireplaces, stoves and the like don't spread, see map_field.
+            if( sm->get_field( { x, y } ).find_field( fd_fire ) == nullptr ||
+                has_flag_ter_or_furn( ter_furn_flag::TFLAG_FIRE_CONTAINER, p ) ) {
+                continue;
+            }
+            for( const tripoint_bub_ms &near : points_in_radius( p, 1 ) ) {
+                if( inbounds( near ) && is_flammable( near ) ) {
+                    fuel_squares.insert( near );
+                }
+            }
+        }
+    }
+    // The submap stands in for the whole OMT, nothing flammable means nothing to hand off.
+    overmap_buffer.note_fire( project_to<coords::omt>( get_abs_sub().xy() + grid ),
+                              static_cast<int>( fuel_squares.size() ) * 4 );
+}
+
+void map::materialize_overmap_fire( const tripoint_rel_sm &grid )
+{
+    tripoint_abs_omt omt;
+    point_omt_sm quadrant;
+    std::tie( omt, quadrant ) = project_remain<coords::omt>( get_abs_sub().xy() + grid );
+    om_fire *const fire = overmap_buffer.fire_at( omt );
+    if( fire == nullptr ) {
+        return;
+    }
+    const uint8_t bit = 1 << ( quadrant.y() * 2 + quadrant.x() );
+    if( !( fire->materialized & bit ) && fire->fuel > 0 ) {
+        // A fresh forest fire sets about one flammable square in ten alight, the fields
+        // spread on their own from there.
+        const tripoint_bub_ms origin = rebase_bub( project_to<coords::ms>( grid ) );
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                const tripoint_bub_ms p = origin + point( x, y );
+                if( is_flammable( p ) && x_in_y( fire->fuel, 4500 ) ) {
+                    add_field( p, fd_fire, 1 );
+                }
+            }
+        }
+    }
+    fire->materialized |= bit;
+    // Every part of the OMT is in the reality bubble now, its fields take over.
+    if( fire->materialized == 0xF ) {
+        overmap_buffer.remove_fire( omt );
+    }
+}
+
 void map::add_tree_tops( const tripoint_rel_sm &grid )
 {
     if( !zlevels ) {
@@ -9346,14 +9735,19 @@ void map::copy_grid( const tripoint_rel_sm &to, const tripoint_rel_sm &from )
     }
 }
 
-void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &group,
-                                       bool ignore_sight )
+struct map::monster_spawn_cells {
+    bool found = false;
+    // A uniform submap no monster can stand on.
+    bool unfit = false;
+    // Tiles a monster may spawn at if no creature is there yet, x-major.
+    std::vector<tripoint_bub_ms> cells;
+};
+
+void map::find_monster_spawn_cells( const tripoint_rel_sm &gp, const submap &current_submap,
+                                    bool ignore_sight, monster_spawn_cells &cells ) const
 {
+    cells.found = true;
     Character &player_character = get_player_character();
-    const int s_range = std::min( HALF_MAPSIZE_X,
-                                  player_character.sight_range( g->light_level( player_character.posz() ) ) );
-    int pop = group.population;
-    std::vector<tripoint_bub_ms> locations;
     if( !ignore_sight ) {
         // If the submap is one of the outermost submaps, assume that monsters are
         // invisible there.
@@ -9366,6 +9760,8 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
         // Note: this is only OK because 3D vision isn't a thing yet. 3D vision is a thing! Is this still OK?
         ignore_sight = true;
     }
+    const int s_range = ignore_sight ? 0 : std::min( HALF_MAPSIZE_X,
+                        player_character.sight_range( g->light_level( player_character.posz() ) ) );
 
     const auto allow_on_terrain = [&]( const tripoint_bub_ms & p ) {
         // TODO: flying creatures should be allowed to spawn without a floor,
@@ -9375,22 +9771,13 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
     };
 
     // If the submap is uniform, we can skip many checks
-    const submap *current_submap = get_submap_at_grid( gp );
-    if( current_submap == nullptr ) {
-        debugmsg( "Tried spawn monster group at (%d,%d,%d) but the submap is not loaded", gp.x(), gp.y(),
-                  gp.z() );
-        return;
-    }
     bool ignore_terrain_checks = false;
     bool ignore_inside_checks = gp.z() < 0;
-    if( current_submap->is_uniform() ) {
+    if( current_submap.is_uniform() ) {
         const tripoint_bub_ms upper_left{ SEEX * gp.x(), SEEY * gp.y(), gp.z()};
         if( !allow_on_terrain( upper_left ) ||
             ( !ignore_inside_checks && has_flag_ter_or_furn( ter_furn_flag::TFLAG_INDOORS, upper_left ) ) ) {
-            const tripoint_abs_ms glp = get_abs( tripoint_bub_ms( gp.x() * SEEX, gp.y() * SEEY, gp.z() ) );
-            dbg( D_WARNING ) << "Empty locations for group " << group.type.str() <<
-                             " at uniform submap " << gp.x() << "," << gp.y() << "," << gp.z() <<
-                             " global " << glp.x() << "," << glp.y() << "," << glp.z();
+            cells.unfit = true;
             return;
         }
 
@@ -9398,27 +9785,54 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
         ignore_inside_checks = true;
     }
 
-    creature_tracker &creatures = get_creature_tracker();
     for( int x = 0; x < SEEX; ++x ) {
         for( int y = 0; y < SEEY; ++y ) {
             point_bub_ms f( x + SEEX * gp.x(), y + SEEY * gp.y() );
             tripoint_bub_ms fp{ f, gp.z()};
-            if( creatures.creature_at( fp ) != nullptr ) {
-                continue; // there is already some creature
-            }
-
             if( !ignore_terrain_checks && !allow_on_terrain( fp ) ) {
                 continue; // solid area, impassable
             }
 
+            if( !ignore_inside_checks && has_flag_ter_or_furn( ter_furn_flag::TFLAG_INDOORS, fp ) ) {
+                continue; // monster must spawn outside.
+            }
+
+            // Last, it's the costly one.
             if( !ignore_sight && sees( player_character.pos_bub(), fp, s_range ) ) {
                 continue; // monster must spawn outside the viewing range of the player
             }
 
-            if( !ignore_inside_checks && has_flag_ter_or_furn( ter_furn_flag::TFLAG_INDOORS, fp ) ) {
-                continue; // monster must spawn outside.
-            }
+            cells.cells.push_back( fp );
+        }
+    }
+}
 
+void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &group,
+                                       bool ignore_sight, monster_spawn_cells &cells )
+{
+    int pop = group.population;
+    const submap *current_submap = get_submap_at_grid( gp );
+    if( current_submap == nullptr ) {
+        debugmsg( "Tried spawn monster group at (%d,%d,%d) but the submap is not loaded", gp.x(), gp.y(),
+                  gp.z() );
+        return;
+    }
+    if( !cells.found ) {
+        find_monster_spawn_cells( gp, *current_submap, ignore_sight, cells );
+    }
+    if( cells.unfit ) {
+        const tripoint_abs_ms glp = get_abs( tripoint_bub_ms( gp.x() * SEEX, gp.y() * SEEY, gp.z() ) );
+        dbg( D_WARNING ) << "Empty locations for group " << group.type.str() <<
+                         " at uniform submap " << gp.x() << "," << gp.y() << "," << gp.z() <<
+                         " global " << glp.x() << "," << glp.y() << "," << glp.z();
+        return;
+    }
+
+    // Earlier groups may have taken some of the tiles.
+    creature_tracker &creatures = get_creature_tracker();
+    std::vector<tripoint_bub_ms> locations;
+    for( const tripoint_bub_ms &fp : cells.cells ) {
+        if( creatures.creature_at( fp ) == nullptr ) {
             locations.push_back( fp );
         }
     }
@@ -9500,8 +9914,9 @@ void map::spawn_monsters_submap( const tripoint_rel_sm &gp, bool ignore_sight, b
     overmap_buffer.spawn_monster( submap_pos, spawn_nonlocal );
     // Only spawn new monsters after existing monsters are loaded.
     std::vector<mongroup *> groups = overmap_buffer.groups_at( submap_pos );
+    monster_spawn_cells cells;
     for( mongroup *&mgp : groups ) {
-        spawn_monsters_submap_group( gp, *mgp, ignore_sight );
+        spawn_monsters_submap_group( gp, *mgp, ignore_sight, cells );
     }
 
     submap *const current_submap = get_submap_at_grid( gp );
@@ -9861,8 +10276,7 @@ void map::build_outside_cache( const int zlev )
 
     auto &outside_cache = ch.outside_cache;
     if( zlev < 0 ) {
-        std::uninitialized_fill_n(
-            &outside_cache[0][0], MAPSIZE_X * MAPSIZE_Y, false );
+        outside_cache.fill( false );
         return;
     }
 
@@ -9897,7 +10311,9 @@ void map::build_outside_cache( const int zlev )
 
     // Copy the padded cache back to the proper one, but with no padding
     for( int x = 0; x < SEEX * my_MAPSIZE; x++ ) {
-        std::copy_n( &padded_cache[x + 1][1], SEEX * my_MAPSIZE, &outside_cache[x][0] );
+        for( int y = 0; y < SEEY * my_MAPSIZE; y++ ) {
+            outside_cache[x][y] = padded_cache[x + 1][y + 1];
+        }
     }
 
     ch.outside_cache_dirty = false;
@@ -10002,6 +10418,38 @@ std::bitset<OVERMAP_LAYERS> map::get_inter_level_visibility( const int origin_zl
     return seen_levels;
 }
 
+std::bitset<OVERMAP_LAYERS> map::active_zlevels( const int zlev ) const
+{
+    std::bitset<OVERMAP_LAYERS> active;
+    if( !zlevels ) {
+        active.set( zlev + OVERMAP_DEPTH );
+        return active;
+    }
+    int range = option_active_z_range.get();
+    if( memory_budget::low_memory_profile() ) {
+        range = range <= 0 ? memory_budget::low_memory_z_range :
+                std::min( range, memory_budget::low_memory_z_range );
+    }
+    if( range <= 0 || this != &get_map() ) {
+        active.set();
+        return active;
+    }
+    for( int z = std::max( zlev - range, -OVERMAP_DEPTH );
+         z <= std::min( zlev + range, OVERMAP_HEIGHT ); ++z ) {
+        active.set( z + OVERMAP_DEPTH );
+    }
+    for( const Creature &critter : g->all_creatures() ) {
+        active.set( critter.posz() + OVERMAP_DEPTH );
+    }
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        const level_cache *ch = get_cache_lazy( z );
+        if( ch != nullptr && !ch->vehicle_list.empty() ) {
+            active.set( z + OVERMAP_DEPTH );
+        }
+    }
+    return active;
+}
+
 bool map::build_floor_cache( const int zlev )
 {
     auto *ch_lazy = get_cache_lazy( zlev );
@@ -10011,8 +10459,7 @@ bool map::build_floor_cache( const int zlev )
     level_cache &ch = *ch_lazy;
 
     auto &floor_cache = ch.floor_cache;
-    std::uninitialized_fill_n(
-        &floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y, true );
+    floor_cache.fill( true );
     bool &no_floor_gaps = ch.no_floor_gaps;
     no_floor_gaps = true;
 
@@ -10063,11 +10510,29 @@ void map::build_floor_caches()
 {
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z();
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z();
-    for( int z = minz; z <= maxz; z++ ) {
-        build_floor_cache( z );
+    const std::bitset<OVERMAP_LAYERS> active = active_zlevels( get_avatar().posz() );
+    const auto build_level = [&]( const int z ) {
+        if( active[z + OVERMAP_DEPTH] ) {
+            build_floor_cache( z );
+        }
+    };
+    // Same reasoning as in build_map_cache: each level only writes its own floor cache.
+    if( minz != maxz && all_submaps_loaded() ) {
+        cata::get_thread_pool().parallel_for( minz, maxz + 1, build_level );
+    } else {
+        for( int z = minz; z <= maxz; z++ ) {
+            build_level( z );
+        }
     }
 }
 
+bool map::all_submaps_loaded() const
+{
+    return std::all_of( grid.begin(), grid.end(), []( const submap * sm ) {
+        return sm != nullptr;
+    } );
+}
+
 static void vehicle_caching_internal( level_cache &zch, const vpart_reference &vp, vehicle *v )
 {
     // TODO: Check if this is actually reasonable. Probably need to feed the map in.
@@ -10136,29 +10601,58 @@ void map::do_vehicle_caching( int z )
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    CATA_TRACE_ZONE( "map::build_map_cache" );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
     bool camera_cache_dirty = false;
-    for( int z = minz; z <= maxz; z++ ) {
+    // The outside, transparency and floor caches of one z-level only read submaps and write
+    // that level's own cache, so the levels can be built side by side. Missing submaps make
+    // the builders call debugmsg, which must stay on the main thread.
+    const bool parallel = minz != maxz && all_submaps_loaded();
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+    const std::bitset<OVERMAP_LAYERS> active = active_zlevels( zlev );
+    std::array<bool, OVERMAP_LAYERS> floor_cache_was_dirty{};
+    const auto build_level_caches = [&]( const int z ) {
+        if( !active[z + OVERMAP_DEPTH] ) {
+            return;
+        }
         build_outside_cache( z );
-        build_transparency_cache( z );
-        bool floor_cache_was_dirty = build_floor_cache( z );
-        seen_cache_dirty |= floor_cache_was_dirty;
-        seen_cache_dirty |= get_cache( z ).seen_cache_dirty;
+        build_transparency_cache( z, sight_penalty );
+        floor_cache_was_dirty[z + OVERMAP_DEPTH] = build_floor_cache( z );
+    };
+    if( parallel ) {
+        cata::get_thread_pool().parallel_for( minz, maxz + 1, build_level_caches );
+    } else {
+        for( int z = minz; z <= maxz; z++ ) {
+            build_level_caches( z );
+        }
+    }
+    for( int z = minz; z <= maxz; z++ ) {
+        if( active[z + OVERMAP_DEPTH] ) {
+            seen_cache_dirty |= floor_cache_was_dirty[z + OVERMAP_DEPTH];
+            seen_cache_dirty |= get_cache( z ).seen_cache_dirty;
+        }
     }
     // needs a separate pass as it changes the caches on neighbour z-levels (e.g. floor_cache);
     // otherwise such changes might be overwritten by main cache-building logic
     for( int z = minz; z <= maxz; z++ ) {
-        do_vehicle_caching( z );
+        if( active[z + OVERMAP_DEPTH] ) {
+            do_vehicle_caching( z );
+        }
     }
     for( int z = minz; z <= maxz; z++ ) {
-        seen_cache_dirty |= build_vision_transparency_cache( z );
+        if( active[z + OVERMAP_DEPTH] ) {
+            seen_cache_dirty |= build_vision_transparency_cache( z );
+        }
     }
 
     if( seen_cache_dirty ) {
-        skew_vision_cache.clear();
-        skew_vision_wo_fields_cache.clear();
+        skew_vision_cache->clear();
+        skew_vision_wo_fields_cache->clear();
+        sight_oracle->clear();
+        sight_oracle_wo_fields->clear();
+        ++sight_generation;
     }
     avatar &u = get_avatar();
     Character::moncam_cache_t mcache = u.get_active_moncams();
@@ -10932,34 +11426,53 @@ std::list<tripoint_bub_ms> map::find_furnitures_with_flag_in_radius( const tripo
     return furn_locs;
 }
 
-std::list<Creature *> map::get_creatures_in_radius( const tripoint_bub_ms &center, size_t radius,
-        size_t radiusz ) const
+// The creature on each occupied tile of the box that passes |keep|, in the order
+// tripoint_range walks the box: one per tile, as creature_at picks it.
+template<typename Predicate>
+static std::list<Creature *> creatures_on_tiles( const map &here, const tripoint_bub_ms &min,
+        const tripoint_bub_ms &max, Predicate &&keep )
 {
     creature_tracker &creatures = get_creature_tracker();
+    std::vector<tripoint_bub_ms> occupied;
+    for( Creature *critter : creatures.creatures_in_box( here.get_abs( min ), here.get_abs( max ) ) ) {
+        const tripoint_bub_ms loc = critter->pos_bub( here );
+        if( keep( loc ) ) {
+            occupied.push_back( loc );
+        }
+    }
+    std::sort( occupied.begin(), occupied.end(), []( const tripoint_bub_ms & a,
+    const tripoint_bub_ms & b ) {
+        return std::make_tuple( a.z(), a.y(), a.x() ) < std::make_tuple( b.z(), b.y(), b.x() );
+    } );
+    occupied.erase( std::unique( occupied.begin(), occupied.end() ), occupied.end() );
+
     std::list<Creature *> creature_list;
-    for( const tripoint_bub_ms &loc : points_in_radius( center, radius, radiusz ) ) {
+    for( const tripoint_bub_ms &loc : occupied ) {
         Creature *tmp_critter = creatures.creature_at( loc );
         if( tmp_critter != nullptr ) {
             creature_list.push_back( tmp_critter );
         }
-
     }
     return creature_list;
 }
 
+std::list<Creature *> map::get_creatures_in_radius( const tripoint_bub_ms &center, size_t radius,
+        size_t radiusz ) const
+{
+    const tripoint_range<tripoint_bub_ms> range = points_in_radius( center, radius, radiusz );
+    return creatures_on_tiles( *this, range.min(), range.max(), []( const tripoint_bub_ms & ) {
+        return true;
+    } );
+}
+
 std::list<Creature *> map::get_creatures_in_radius_circ( const tripoint_bub_ms &center,
         size_t radius, size_t radiusz ) const
 {
-    creature_tracker &creatures = get_creature_tracker();
-    std::list<Creature *> creature_list;
-    for( const tripoint_bub_ms &loc : points_in_radius_circ( center, radius, radiusz ) ) {
-        Creature *tmp_critter = creatures.creature_at( loc );
-        if( tmp_critter != nullptr ) {
-            creature_list.push_back( tmp_critter );
-        }
-
-    }
-    return creature_list;
+    const tripoint offset( radius, radius, radiusz );
+    return creatures_on_tiles( *this, center - offset, center + offset,
+    [&center, radius]( const tripoint_bub_ms & loc ) {
+        return trig_dist( center, loc ) < radius + 0.5f;
+    } );
 }
 
 level_cache &map::access_cache( int zlev )
@@ -11004,6 +11517,7 @@ void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
         get_pathfinding_cache( zlev ).dirty = true;
+        route_memos->clear();
     }
 }
 
@@ -11011,6 +11525,7 @@ void map::set_pathfinding_cache_dirty( const tripoint_bub_ms &p )
 {
     if( inbounds( p ) ) {
         get_pathfinding_cache( p.z() ).dirty_points.insert( p.xy() );
+        route_memos->clear();
     }
 }
 
@@ -11070,6 +11585,9 @@ void map::update_pathfinding_cache( const tripoint_bub_ms &p ) const
         if( terrain.has_flag( ter_furn_flag::TFLAG_CLIMBABLE ) ) {
             cur_value |= PathfindingFlag::Climbable;
         }
+        if( veh == nullptr && ( terrain.open || furniture.open ) ) {
+            cur_value |= PathfindingFlag::Door;
+        }
     }
 
     if( veh != nullptr ) {
@@ -11117,7 +11635,11 @@ void map::update_pathfinding_cache( const tripoint_bub_ms &p ) const
         cur_value |= ( PathfindingFlag::RestrictLarge | PathfindingFlag::RestrictHuge );
     }
 
-    cache.special[p.x()][p.y()] = cur_value;
+    PathfindingFlags &special = cache.special[p.x()][p.y()];
+    if( special != cur_value ) {
+        special = cur_value;
+        cache.set_submap_graph_dirty( p.xy() );
+    }
 }
 
 void map::update_pathfinding_cache( int zlev ) const
@@ -11131,6 +11653,7 @@ void map::update_pathfinding_cache( int zlev ) const
                 update_pathfinding_cache( { x, y, zlev } );
             }
         }
+        cache.set_submap_graphs_dirty();
         cache.dirty = false;
     } else {
         for( const point_bub_ms &p : cache.dirty_points ) {
@@ -11247,12 +11770,10 @@ void map::invalidate_max_populated_zlev( int zlev )
 
 bool map::has_potential_los( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const
 {
-    const point key = sees_cache_key( from, to );
-    char cached = skew_vision_cache.get( key, -1 );
-    if( cached != -1 ) {
-        return cached > 0;
+    if( from.z() == to.z() ) {
+        return sight_oracle->lookup( from, to ) != 0;
     }
-    return true;
+    return skew_vision_cache->lookup( from, to ) != 0;
 }
 
 static bool is_haulable( const item &it )
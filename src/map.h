@@ -4,6 +4,7 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
@@ -35,7 +36,6 @@
 #include "level_cache.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
 #include "map_iterator.h"
 #include "map_selector.h"
 #include "mapdata.h"
@@ -99,6 +99,9 @@ class weather_generator;
 
 enum class ter_furn_flag : int;
 struct pathfinding_cache;
+class route_memo;
+class skew_sight_cache;
+class visibility_oracle;
 struct pathfinding_settings;
 struct pathfinding_target;
 template<typename T>
@@ -429,6 +432,9 @@ class map
         //      fields are not considered for some caches, such as reachability_caches
         //      so passing field=true allows to skip rebuilding of such caches
         void set_transparency_cache_dirty( const tripoint_bub_ms &p, bool field = false );
+        // invalidates only the submaps overlapping the rectangle between the corners (inclusive,
+        // clipped to the map) on the z-level of `from`, for changes whose extent is known
+        void set_transparency_cache_dirty( const tripoint_bub_ms &from, const tripoint_bub_ms &to );
         void set_seen_cache_dirty( const tripoint_bub_ms &change_location );
 
         // invalidates seen cache for the whole zlevel unconditionally
@@ -545,6 +551,22 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( const point_rel_sm &s );
+        /**
+         * Have the mapbuffer read ahead the submaps that shifting the map to
+         * keep @p center in the middle would load, see @ref mapbuffer::prefetch.
+         */
+        void prefetch_shift_toward( const tripoint_abs_ms &center ) const;
+        /**
+         * Queues the OMT stacks that shifting the map to keep @p center in the middle would
+         * have to generate, for @ref generate_queued_mapgen. Only the reality bubble queues,
+         * and not in the low-memory profile.
+         */
+        void queue_mapgen_toward( const tripoint_abs_ms &center );
+        /**
+         * Generates queued OMT stacks into the map buffer, as loadn would, for up to @p budget.
+         * Always takes at least one off the queue. Main thread only.
+         */
+        void generate_queued_mapgen( std::chrono::steady_clock::duration budget );
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -654,7 +676,18 @@ class map
         */
         bool sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, int range,
                    bool with_fields = true ) const;
+        /**
+         * Traces the same z-level sight lines of @p pairs on the shared thread pool and stores
+         * them where map::sees looks first, so asking about them later is a lookup. Pairs on
+         * different z-levels, out of bounds or already known are skipped. Needs up to date
+         * transparency caches.
+         */
+        void prefetch_sight_lines( const std::vector<std::pair<tripoint_bub_ms, tripoint_bub_ms>>
+                                   &pairs, bool with_fields = true ) const;
     private:
+        // Walks the bresenham line between two tiles of one z-level without any caching.
+        bool trace_sight_line( const tripoint_bub_ms &F, const tripoint_bub_ms &T, int &bresenham_slope,
+                               bool with_fields ) const;
         /**
          * Don't expose the slope adjust outside map functions.
          *
@@ -667,7 +700,6 @@ class map
         **/
         bool sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, int range, int &bresenham_slope,
                    bool with_fields = true, bool allow_cached = true ) const;
-        point sees_cache_key( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const;
     public:
         /**
         * Returns coverage of target in relation to the observer. Target is loc2, observer is loc1.
@@ -714,6 +746,13 @@ class map
          */
         std::vector<tripoint_bub_ms> find_clear_path( const tripoint_bub_ms &source,
                 const tripoint_bub_ms &destination, bool empty_on_fail = false ) const;
+        /**
+         * Goes up whenever the transparency the same z-level paths of find_clear_path depend on
+         * changes, so such a path found at the same generation is still the path.
+         */
+        int get_sight_generation() const {
+            return sight_generation;
+        }
 
         /**
          * Check whether the player can access the items located @p. Certain furniture/terrain
@@ -770,6 +809,20 @@ class map
         int extra_cost( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
                         const pathfinding_settings &settings,
                         PathfindingFlags p_special ) const;
+        // Long same-level routes: plan over the per-submap entrance graph of the
+        // pathfinding cache, then refine each leg with the regular A*.
+        // Returns nullopt when the abstract graph can't answer and the flat
+        // search should be used instead.
+        std::optional<std::vector<tripoint_bub_ms>> route_hierarchical( const tripoint_bub_ms &f,
+                const pathfinding_target &target, const pathfinding_settings &settings,
+                const std::function<bool( const tripoint_bub_ms & )> &avoid ) const;
+        // Routes towards a target many creatures are heading for this turn: one
+        // Dijkstra from the target over its z-level, which every later request
+        // just walks down. Returns nullopt while the target isn't popular enough,
+        // or when the field has no acceptable route from |f|.
+        std::optional<std::vector<tripoint_bub_ms>> route_by_flow_field( const tripoint_bub_ms &f,
+                const pathfinding_target &target, const pathfinding_settings &settings,
+                const std::function<bool( const tripoint_bub_ms & )> &avoid ) const;
     public:
 
         // Vehicles: Common to 2D and 3D
@@ -1436,6 +1489,30 @@ class map
             create_anomaly( tripoint_bub_ms( cp, abs_sub.z() ), prop, create_rubble );
         }
 
+        /**
+         * Sum of submap::get_content_version over the loaded submaps within radius tiles of p on
+         * its z-level. Goes up whenever something there is built, dropped, picked up or removed.
+         */
+        uint64_t content_version( const tripoint_bub_ms &p, int radius = 0 ) const;
+        /**
+         * Tiles within radius of p on its z-level with items on the ground, x-major within each
+         * submap. Uses submap::get_item_tiles, so empty tiles cost nothing. Vehicle cargo isn't
+         * included.
+         */
+        std::vector<tripoint_bub_ms> item_tiles_near( const tripoint_bub_ms &p, int radius ) const;
+        /**
+         * Tiles within radius of p on its z-level giving off heat and how much, in the order
+         * points_in_radius visits them. Uses submap::get_heat_tiles, so each submap looks for
+         * fires and hot terrain once a turn however many callers ask.
+         */
+        std::vector<std::pair<tripoint_bub_ms, int>> heat_sources_near( const tripoint_bub_ms &p,
+                int radius ) const;
+        /**
+         * Tiles within radius of p on its z-level with a trap, in the order points_in_radius
+         * visits them. Uses submap::get_trap_tiles, so tiles without one cost nothing.
+         */
+        std::vector<tripoint_bub_ms> trap_tiles_near( const tripoint_bub_ms &p, int radius ) const;
+
         // Partial construction functions
         void partial_con_set( const tripoint_bub_ms &p, const partial_con &con );
         void partial_con_remove( const tripoint_bub_ms &p );
@@ -1863,9 +1940,13 @@ class map
         // Helper #1 - spawns monsters on one submap
         void spawn_monsters_submap( const tripoint_rel_sm &gp, bool ignore_sight,
                                     bool spawn_nonlocal = false );
-        // Helper #2 - spawns monsters on one submap and from one group on this submap
+        struct monster_spawn_cells;
+        // Helper #2 - spawns monsters on one submap and from one group on this submap. The
+        // tiles they may spawn at are the same for every group there, so they are found once.
         void spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &group,
-                                          bool ignore_sight );
+                                          bool ignore_sight, monster_spawn_cells &cells );
+        void find_monster_spawn_cells( const tripoint_rel_sm &gp, const submap &current_submap,
+                                       bool ignore_sight, monster_spawn_cells &cells ) const;
 
     protected:
         void saven( const tripoint_bub_sm &grid );
@@ -1929,12 +2010,22 @@ class map
         void shift_traps( const point_rel_sm &shift );
 
         void on_unload( const tripoint_rel_sm &loc );
+        /** Hands a fire burning in the submap at @p grid to the overmap as it leaves the map. */
+        void note_leaving_fire( const tripoint_rel_sm &grid );
+        /**
+         * Brings the overmap fire of the OMT of the just loaded submap at @p grid back as fire
+         * fields, see @ref overmapbuffer::process_fires.
+         */
+        void materialize_overmap_fire( const tripoint_rel_sm &grid );
         void copy_grid( const tripoint_rel_sm &to, const tripoint_rel_sm &from );
         void draw_map( mapgendata &dat );
 
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
         bool build_transparency_cache( int zlev );
+        // As above, with the weather sight penalty looked up by the caller, so that
+        // several z-levels can be built at the same time on worker threads.
+        bool build_transparency_cache( int zlev, float sight_penalty );
         bool build_vision_transparency_cache( int zlev );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
@@ -1942,13 +2033,22 @@ class map
         void build_outside_cache( int zlev );
         // Get a bitmap indicating which layers are potentially visible from the target layer.
         std::bitset<OVERMAP_LAYERS> get_inter_level_visibility( int origin_zlevel )const ;
+        // Layers that get their caches built and their fields processed this turn: those within
+        // the ACTIVE_Z_RANGE option of zlev and those holding creatures or vehicles, or every
+        // layer while the option is 0 or on maps other than the reality bubble. The low-memory
+        // profile caps the range at memory_budget::low_memory_z_range. The others keep
+        // their caches dirty and their fields as they are until they are active again.
+        std::bitset<OVERMAP_LAYERS> active_zlevels( int zlev ) const;
+        // Whether every submap of the bubble is loaded. The cache builders and the scent code
+        // only debugmsg about missing submaps, so they may run off the main thread when it holds.
+        bool all_submaps_loaded() const;
         // Builds a floor cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
         bool build_floor_cache( int zlev );
         // We want this visible in `game`, because we want it built earlier in the turn than the rest
         void build_floor_caches();
         void seen_cache_process_ledges( array_of_grids_of<float> &seen_caches,
-                                        const array_of_grids_of<const bool> &floor_caches,
+                                        const array_of_floor_caches &floor_caches,
                                         const std::optional<tripoint_bub_ms> &override_p ) const;
 
     protected:
@@ -2086,6 +2186,9 @@ class map
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint_bub_ms &p, float luminance );
+        // Applies a light source from the buffer filled by add_light_source, reusing the light
+        // it cast on an earlier turn if nothing it could reach changed since.
+        void apply_buffered_light_source( const tripoint_bub_ms &p, float luminance );
         // Handle just cardinal directions and 45 deg angles.
         void apply_directional_light( const tripoint_bub_ms &p, int direction, float luminance );
         void apply_light_arc( const tripoint_bub_ms &p, const units::angle &angle, float luminance,
@@ -2171,18 +2274,22 @@ class map
         mutable std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        // Routes already found this turn, see route_memo
+        mutable std::unique_ptr<route_memo> route_memos;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
         std::set<tripoint_abs_sm> submaps_with_active_items;
         std::set<tripoint_abs_sm> submaps_with_active_items_dirty;
 
-        /**
-         * Cache of coordinate pairs recently checked for visibility.
-         */
-        using lru_cache_t = lru_cache<point, char>;
-        mutable lru_cache_t skew_vision_cache;
-        mutable lru_cache_t skew_vision_wo_fields_cache;
+        // Sight lines across z-levels, see skew_sight_cache
+        std::unique_ptr<skew_sight_cache> skew_vision_cache;
+        std::unique_ptr<skew_sight_cache> skew_vision_wo_fields_cache;
+        // Same z-level sight lines by observer, see visibility_oracle
+        std::unique_ptr<visibility_oracle> sight_oracle;
+        std::unique_ptr<visibility_oracle> sight_oracle_wo_fields;
+        // See get_sight_generation()
+        int sight_generation = 0;
 
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
@@ -2206,6 +2313,8 @@ class map
         std::optional<std::pair<tripoint_abs_sm, int>> max_populated_zlev = std::nullopt;
 
         bool mapgen_in_progress = false;
+        // OMT stacks to generate before a shift needs them, oldest first.
+        std::vector<point_abs_omt> queued_mapgen;
         // this is set for maps loaded in bounds of the main map (g->m)
         bool _main_requires_cleanup = false;
         std::optional<bool> _main_cleanup_override = std::nullopt;
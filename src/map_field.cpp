@@ -50,6 +50,7 @@
 #include "mtype.h"
 #include "npc.h"
 #include "overmapbuffer.h"
+#include "perf.h"
 #include "point.h"
 #include "rng.h"
 #include "scent_block.h"
@@ -163,8 +164,15 @@ int map::burn_body_part( Character &you, field_entry &cur, const bodypart_id &bp
 
 void map::process_fields()
 {
+    CATA_TRACE_ZONE( "map::process_fields" );
+    const std::bitset<OVERMAP_LAYERS> active = active_zlevels( get_avatar().posz() );
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
-        auto &field_cache = get_cache( z ).field_cache;
+        // Adding a field creates the level's cache, a level without one has none to process.
+        level_cache *ch = get_cache_lazy( z );
+        if( ch == nullptr || !active[z + OVERMAP_DEPTH] ) {
+            continue;
+        }
+        auto &field_cache = ch->field_cache;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
             for( int y = 0; y < my_MAPSIZE; y++ ) {
                 if( field_cache[ x + y * MAPSIZE ] ) {
@@ -174,6 +182,8 @@ void map::process_fields()
                         continue;
                     }
                     process_fields_in_submap( current_submap, { x, y, z } );
+                    // Fires grew, spread or went out in place.
+                    current_submap->invalidate_heat_tiles();
                     if( current_submap->field_count == 0 ) {
                         field_cache[ x + y * MAPSIZE ] = false;
                     }
@@ -276,13 +286,6 @@ void map::gas_spread_to( field_entry &cur, maptile &dst, const tripoint_bub_ms &
 void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_spread,
                       const time_duration &outdoor_age_speedup, scent_block &sblk, const oter_id &om_ter )
 {
-    const bool sheltered = g->is_sheltered( p );
-    weather_manager &weather = get_weather();
-    const int winddirection = weather.winddirection;
-    const int windpower = get_local_windpower( weather.windspeed, om_ter, get_abs( p ),
-                          winddirection,
-                          sheltered );
-
     const int current_intensity = cur.get_field_intensity();
     const field_type_id ft_id = cur.get_field_type();
 
@@ -302,8 +305,20 @@ void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_sp
         cur.set_field_age( current_age + outdoor_age_speedup );
     }
 
-    // Bail out if we don't meet the spread chance or required intensity.
-    if( current_intensity <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
+    // Thin gas never spreads, so don't bother asking about shelter and wind for it.
+    if( current_intensity <= 1 ) {
+        return;
+    }
+
+    const bool sheltered = g->is_sheltered( p );
+    weather_manager &weather = get_weather();
+    const int winddirection = weather.winddirection;
+    const int windpower = get_local_windpower( weather.windspeed, om_ter, get_abs( p ),
+                          winddirection,
+                          sheltered );
+
+    // Bail out if we don't meet the spread chance.
+    if( rng( 1, 100 - windpower ) > percent_spread ) {
         return;
     }
 
@@ -320,7 +335,9 @@ void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_sp
 
     auto neighs = get_neighbors( p );
     size_t end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
-    std::vector<size_t> spread;
+    // At most one candidate per neighbor, so these never need the heap.
+    std::array<size_t, 8> spread;
+    size_t spread_count = 0;
     // Then, spread to a nearby point.
     // If not possible (or randomly), try to spread up
     // Wind direction will block the field spreading into the wind.
@@ -330,33 +347,36 @@ void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_sp
          i = ( i + 1 ) % neighs.size(), count++ ) {
         const auto &neigh = neighs[i];
         if( gas_can_spread_to( cur, neigh.second ) ) {
-            spread.push_back( i );
+            spread[spread_count++] = i;
         }
     }
 
-    if( !spread.empty() && one_in( spread.size() ) ) {
+    if( spread_count > 0 && one_in( spread_count ) ) {
         // Construct the destination from offset and p
         if( sheltered || windpower < 5 ) {
-            std::pair<tripoint_bub_ms, maptile> &n = neighs[ random_entry( spread ) ];
+            std::pair<tripoint_bub_ms, maptile> &n = neighs[ spread[rng( 0, spread_count - 1 )] ];
             gas_spread_to( cur, n.second, n.first );
         } else {
-            std::vector<size_t> neighbour_vec;
+            std::array<size_t, 8> neighbour_vec;
+            size_t neighbour_count = 0;
             auto maptiles = get_wind_blockers( winddirection, p );
             // Three map tiles that are facing the wind direction.
             const maptile &remove_tile = std::get<0>( maptiles );
             const maptile &remove_tile2 = std::get<1>( maptiles );
             const maptile &remove_tile3 = std::get<2>( maptiles );
-            for( const size_t &i : spread ) {
+            for( size_t s = 0; s < spread_count; s++ ) {
+                const size_t i = spread[s];
                 const maptile &neigh = neighs[i].second;
                 if( ( neigh.pos_ != remove_tile.pos_ &&
                       neigh.pos_ != remove_tile2.pos_ &&
                       neigh.pos_ != remove_tile3.pos_ ) ||
                     x_in_y( 1, std::max( 2, windpower ) ) ) {
-                    neighbour_vec.push_back( i );
+                    neighbour_vec[neighbour_count++] = i;
                 }
             }
-            if( !neighbour_vec.empty() ) {
-                std::pair<tripoint_bub_ms, maptile> &n = neighs[ random_entry( neighbour_vec ) ];
+            if( neighbour_count > 0 ) {
+                const size_t picked = neighbour_vec[rng( 0, neighbour_count - 1 )];
+                std::pair<tripoint_bub_ms, maptile> &n = neighs[ picked ];
                 gas_spread_to( cur, n.second, n.first );
             }
         }
@@ -443,58 +463,77 @@ void map::process_fields_in_submap( submap *const current_submap,
         &( *fd_null )
     };
 
-    // Loop through all tiles in this submap indicated by current_submap
-    for( locx = 0; locx < SEEX; locx++ ) {
-        for( locy = 0; locy < SEEY; locy++ ) {
-            // Get a reference to the field variable from the submap;
-            // contains all the pointers to the real field effects.
-            field &curfield = current_submap->get_field( { static_cast<int>( locx ), static_cast<int>( locy ) } );
-
-            // when displayed_field_type == fd_null it means that `curfield` has no fields inside
-            // avoids instantiating (relatively) expensive map iterator
-            if( !curfield.displayed_field_type() ) {
-                continue;
+    if( !current_submap->field_cells_known ) {
+        current_submap->field_cells.reset();
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                if( current_submap->get_field( { x, y } ).displayed_field_type() ) {
+                    current_submap->note_field_cell( { x, y } );
+                }
             }
+        }
+        current_submap->field_cells_known = true;
+    }
 
-            // This is a translation from local coordinates to submap coordinates.
-            const tripoint_bub_ms p{sm_offset + rebase_rel( map_tile.pos() ), submap.z()};
+    // Loop through the tiles of this submap that hold fields, in the same column-major order
+    // as a full scan. Fields spreading into a tile of this submap mark it through
+    // map::add_field, so tiles further along still get their turn.
+    std::bitset<SEEX * SEEY> &cells = current_submap->field_cells;
+    for( size_t cell = 0; cell < cells.size(); cell++ ) {
+        if( !cells.test( cell ) ) {
+            continue;
+        }
+        locx = static_cast<int>( cell / SEEY );
+        locy = static_cast<int>( cell % SEEY );
+        // Get a reference to the field variable from the submap;
+        // contains all the pointers to the real field effects.
+        field &curfield = current_submap->get_field( { static_cast<int>( locx ), static_cast<int>( locy ) } );
 
-            for( auto it = curfield.begin(); it != curfield.end(); ) {
-                // Iterating through all field effects in the submap's field.
-                field_entry &cur = it->second;
-                const int prev_intensity = cur.is_field_alive() ? cur.get_field_intensity() : 0;
+        // when displayed_field_type == fd_null it means that `curfield` has no fields inside
+        // avoids instantiating (relatively) expensive map iterator
+        if( !curfield.displayed_field_type() ) {
+            cells.reset( cell );
+            continue;
+        }
 
-                pd.cur_fd_type_id = cur.get_field_type();
-                pd.cur_fd_type = &( *pd.cur_fd_type_id );
+        // This is a translation from local coordinates to submap coordinates.
+        const tripoint_bub_ms p{sm_offset + rebase_rel( map_tile.pos() ), submap.z()};
 
-                // The field might have been killed by processing a neighbor field
-                if( prev_intensity == 0 ) {
-                    on_field_modified( p, *pd.cur_fd_type );
-                    --current_submap->field_count;
-                    curfield.remove_field( it++ );
-                    continue;
-                }
+        for( auto it = curfield.begin(); it != curfield.end(); ) {
+            // Iterating through all field effects in the submap's field.
+            field_entry &cur = it->second;
+            const int prev_intensity = cur.is_field_alive() ? cur.get_field_intensity() : 0;
 
-                // Don't process "newborn" fields. This gives the player time to run if they need to.
-                if( cur.get_field_age() == 0_turns ) {
-                    cur.do_decay();
-                    if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
-                        on_field_modified( p, *pd.cur_fd_type );
-                    }
-                    ++it;
-                    continue;
-                }
+            pd.cur_fd_type_id = cur.get_field_type();
+            pd.cur_fd_type = &( *pd.cur_fd_type_id );
 
-                for( const FieldProcessorPtr &proc : pd.cur_fd_type->get_processors() ) {
-                    proc( p, cur, pd );
-                }
+            // The field might have been killed by processing a neighbor field
+            if( prev_intensity == 0 ) {
+                on_field_modified( p, *pd.cur_fd_type );
+                --current_submap->field_count;
+                curfield.remove_field( it++ );
+                continue;
+            }
 
+            // Don't process "newborn" fields. This gives the player time to run if they need to.
+            if( cur.get_field_age() == 0_turns ) {
                 cur.do_decay();
                 if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
                     on_field_modified( p, *pd.cur_fd_type );
                 }
                 ++it;
+                continue;
+            }
+
+            for( const FieldProcessorPtr &proc : pd.cur_fd_type->get_processors() ) {
+                proc( p, cur, pd );
+            }
+
+            cur.do_decay();
+            if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
+                on_field_modified( p, *pd.cur_fd_type );
             }
+            ++it;
         }
     }
     sblk.commit_modifications();
@@ -6,6 +6,8 @@
 #include <limits>
 #include <memory>
 #include <ostream>
+#include <set>
+#include <string>
 #include <tuple>
 #include <utility>
 
@@ -21,6 +23,8 @@
 #include "game_constants.h"
 #include "json_loader.h"
 #include "map_memory.h"
+#include "memory_budget.h"
+#include "memory_report.h"
 #include "path_info.h"
 #include "string_formatter.h"
 #include "translations.h"
@@ -74,6 +78,15 @@ bool mm_submap::is_valid() const
     return valid;
 }
 
+size_t mm_submap::heap_bytes() const
+{
+    size_t bytes = tiles.capacity() * sizeof( memorized_tile );
+    for( const memorized_tile &tile : tiles ) {
+        bytes += memory_report::heap_bytes( tile.dec_id );
+    }
+    return bytes;
+}
+
 const memorized_tile &mm_submap::get_tile( const point_sm_ms &p ) const
 {
     if( tiles.empty() ) {
@@ -223,6 +236,7 @@ void map_memory::set_tile_terrain( const tripoint_abs_ms &pos, std::string_view
     if( !sm.is_valid() ) {
         return;
     }
+    mark_dirty( p.sm );
     memorized_tile mt = sm.get_tile( p.loc );
     mt.set_ter_id( id );
     mt.set_ter_subtile( subtile );
@@ -238,6 +252,7 @@ void map_memory::set_tile_decoration( const tripoint_abs_ms &pos, std::string_vi
     if( !sm.is_valid() ) {
         return;
     }
+    mark_dirty( p.sm );
     memorized_tile mt = sm.get_tile( p.loc );
     mt.set_dec_id( id );
     mt.set_dec_subtile( subtile );
@@ -252,6 +267,7 @@ void map_memory::set_tile_symbol( const tripoint_abs_ms &pos, char32_t symbol )
     if( !sm.is_valid() ) {
         return;
     }
+    mark_dirty( p.sm );
     memorized_tile mt = sm.get_tile( p.loc );
     mt.symbol = symbol;
     sm.set_tile( p.loc, mt );
@@ -264,6 +280,7 @@ void map_memory::clear_tile_decoration( const tripoint_abs_ms &pos, std::string_
     if( !sm.is_valid() ) {
         return;
     }
+    mark_dirty( p.sm );
     memorized_tile mt = sm.get_tile( p.loc );
     if( string_starts_with( mt.get_dec_id(), prefix ) ) {
         mt.set_dec_id( "" );
@@ -317,14 +334,104 @@ bool map_memory::prepare_region( const tripoint_abs_ms &p1, const tripoint_abs_m
 shared_ptr_fast<mm_submap> map_memory::fetch_submap( const tripoint_abs_sm &sm_pos )
 {
     shared_ptr_fast<mm_submap> sm = find_submap( sm_pos );
-    if( sm ) {
-        return sm;
+    if( !sm ) {
+        sm = load_submap( sm_pos );
+    }
+    if( !sm ) {
+        sm = allocate_submap( sm_pos );
+    }
+    // Regions in view are fetched on every recache, so they are never the ones pushed out.
+    const int limit = memory_budget::low_memory_profile() ? low_memory_loaded_regions :
+                      max_loaded_regions;
+    loaded.insert( limit, reg_coord_pair( sm_pos ).reg, true,
+    [this]( const std::pair<tripoint, bool> &evicted ) {
+        unload_region( evicted.first );
+    } );
+    return sm;
+}
+
+void map_memory::mark_dirty( const tripoint_abs_sm &sm_pos )
+{
+    dirty_regions.insert( reg_coord_pair( sm_pos ).reg );
+}
+
+size_t map_memory::loaded_regions() const
+{
+    return loaded.size();
+}
+
+void map_memory::add_memory_usage( memory_report::report &out ) const
+{
+    // std::map nodes hold three pointers and a colour besides the value.
+    constexpr size_t node_overhead = 4 * sizeof( void * );
+    size_t bytes = 0;
+    for( const auto &[pos, sm] : submaps ) {
+        bytes += sizeof( decltype( submaps )::value_type ) + node_overhead + sizeof( mm_submap ) +
+                 sm->heap_bytes();
     }
-    sm = load_submap( sm_pos );
-    if( sm ) {
-        return sm;
+    out.add( "map_memory", submaps.size(), bytes );
+}
+
+void map_memory::unload_region( const tripoint &reg )
+{
+    // Nothing is ever read back in test mode, so there's no point writing it.
+    if( dirty_regions.erase( reg ) != 0 && !test_mode ) {
+        std::shared_ptr<zzip_stack> z;
+        if( !write_region( reg, z ) ) {
+            debugmsg( "Failed to save memory map region (%d,%d,%d)", reg.x, reg.y, reg.z );
+        }
+    }
+    dbg( D_INFO ) << "Unloaded mm_region " << reg << " [" << mmr_to_sm_copy( reg ) << "]";
+    const tripoint_abs_sm reg_sm = mmr_to_sm_copy( reg );
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            submaps.erase( reg_sm + tripoint( x, y, 0 ) );
+        }
     }
-    return allocate_submap( sm_pos );
+}
+
+bool map_memory::write_region( const tripoint &regp, std::shared_ptr<zzip_stack> &z )
+{
+    // Since mm_submaps are always allocated in regions, a loaded region is complete.
+    mm_region reg;
+    const tripoint_abs_sm regp_sm = mmr_to_sm_copy( regp );
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            shared_ptr_fast<mm_submap> sm = find_submap( regp_sm + tripoint( x, y, 0 ) );
+            if( !sm ) {
+                // Memorized while not loaded, there's nothing to write.
+                return true;
+            }
+            reg.submaps[x][y] = sm;
+        }
+    }
+    if( reg.is_empty() ) {
+        return true;
+    }
+
+    const cata_path dirname = find_mm_dir();
+    const std::filesystem::path mm_filename = std::filesystem::u8path( find_region_filename( regp ) );
+    std::string mm_str = serialize_wrapper( [&]( JsonOut & jsout ) {
+        reg.serialize( jsout );
+    } );
+
+    if( world_generator->active_world->has_compression_enabled() ) {
+        if( !z ) {
+            assure_dir_exist( dirname );
+            z = zzip_stack::load( dirname.get_unrelative_path(),
+                                  ( PATH_INFO::world_base_save_path() / "mmr.dict" ).get_unrelative_path() );
+        }
+        return z && z->add_file( mm_filename, mm_str );
+    }
+    assure_dir_exist( dirname );
+    const std::string descr = string_format(
+                                  _( "memory map region for (%d,%d,%d)" ),
+                                  regp.x, regp.y, regp.z
+                              );
+    const auto writer = [&]( std::ostream & fout ) -> void {
+        fout << mm_str;
+    };
+    return write_to_file( dirname / mm_filename, writer, descr.c_str() );
 }
 
 shared_ptr_fast<mm_submap> map_memory::allocate_submap( const tripoint_abs_sm &sm_pos )
@@ -474,15 +581,6 @@ bool map_memory::save( const tripoint_abs_ms &pos )
 
     dbg( D_INFO ) << "N submaps before save: " << submaps.size();
 
-    // Since mm_submaps are always allocated in regions,
-    // we are certain that each region will be filled.
-    std::map<tripoint, mm_region> regions;
-    for( auto &it : submaps ) {
-        const reg_coord_pair p( it.first );
-        regions[p.reg].submaps[p.sm_loc.x()][p.sm_loc.y()] = it.second;
-    }
-    submaps.clear();
-
     constexpr point MM_HSIZE_P = point( MM_SIZE / 2, MM_SIZE / 2 );
     rectangle<point_abs_sm> rect_keep( sm_center.xy() - MM_HSIZE_P, sm_center.xy() + MM_HSIZE_P );
 
@@ -491,62 +589,33 @@ bool map_memory::save( const tripoint_abs_ms &pos )
 
     bool result = true;
 
+    // Regions that weren't memorized into are the same as on disk already.
     std::shared_ptr<zzip_stack> z;
-    if( world_generator->active_world->has_compression_enabled() ) {
-        z = zzip_stack::load( dirname.get_unrelative_path(),
-                              ( PATH_INFO::world_base_save_path() / "mmr.dict" ).get_unrelative_path() );
-    }
-    for( auto &it : regions ) {
-        const tripoint &regp = it.first;
-        mm_region &reg = it.second;
-        if( !reg.is_empty() ) {
-            const std::filesystem::path mm_filename = std::filesystem::u8path( find_region_filename( regp ) );
-            const std::string descr = string_format(
-                                          _( "memory map region for (%d,%d,%d)" ),
-                                          regp.x, regp.y, regp.z
-                                      );
-            std::string mm_str = serialize_wrapper( [&]( JsonOut & jsout ) {
-                reg.serialize( jsout );
-            } );
-
-            if( world_generator->active_world->has_compression_enabled() ) {
-                if( z ) {
-                    result = z->add_file( mm_filename, mm_str ) && result;
-                } else {
-                    result = false;
-                }
-
-            } else {
-                const cata_path path = dirname / mm_filename;
-                const auto writer = [&]( std::ostream & fout ) -> void {
-                    fout << mm_str;
-                };
-
-                const bool res = write_to_file( path, writer, descr.c_str() );
-                result = result && res;
-            }
-        }
+    for( const tripoint &regp : dirty_regions ) {
+        result = write_region( regp, z ) && result;
+    }
+    dirty_regions.clear();
+    if( z ) {
+        z->compact( 3.0 );
+    }
+
+    std::set<tripoint> dropped;
+    for( auto it = submaps.begin(); it != submaps.end(); ) {
+        const tripoint regp = reg_coord_pair( it->first ).reg;
         const tripoint_abs_sm regp_sm( mmr_to_sm_copy( regp ) );
         const half_open_rectangle<point_abs_sm> rect_reg(
             regp_sm.xy(),
             regp_sm.xy() + point( MM_REG_SIZE, MM_REG_SIZE ) );
-
         if( rect_reg.overlaps( rect_keep ) ) {
-            dbg( D_INFO ) << "Keeping mm_region " << regp << " [" << regp_sm << "]";
-            // Put submaps back
-            for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
-                for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
-                    const tripoint_abs_sm p = regp_sm + tripoint( x, y, 0 );
-                    shared_ptr_fast<mm_submap> &sm = reg.submaps[x][y];
-                    submaps.insert( std::make_pair( p, sm ) );
-                }
-            }
+            ++it;
         } else {
-            dbg( D_INFO ) << "Dropping mm_region " << regp << " [" << regp_sm << "]";
+            dropped.insert( regp );
+            it = submaps.erase( it );
         }
     }
-    if( z ) {
-        z->compact( 3.0 );
+    for( const tripoint &regp : dropped ) {
+        dbg( D_INFO ) << "Dropping mm_region " << regp << " [" << mmr_to_sm_copy( regp ) << "]";
+        loaded.remove( regp );
     }
 
     dbg( D_INFO ) << "[SAVE] Done.";
@@ -558,6 +627,8 @@ void map_memory::clear()
 {
     clear_cache();
     submaps.clear();
+    loaded.clear();
+    dirty_regions.clear();
     dbg( D_INFO ) << "[CLEAR] Done.";
 }
 void map_memory::clear_cache()
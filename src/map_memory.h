@@ -4,11 +4,14 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "coordinates.h"
+#include "lru_cache.h"
 #include "map_scale_constants.h"
 #include "mdarray.h"
 #include "memory_fast.h"
@@ -18,6 +21,11 @@
 class JsonArray;
 class JsonOut;
 class JsonValue;
+class zzip_stack;
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 
 class memorized_tile
 {
@@ -72,6 +80,9 @@ struct mm_submap {
         void serialize( JsonOut &jsout ) const;
         void deserialize( int version, const JsonArray &ja );
 
+        /** Bytes held by the tiles and their decoration ids. */
+        size_t heap_bytes() const;
+
     private:
         // NOLINTNEXTLINE(cata-serialize)
         std::vector<memorized_tile> tiles; // holds either 0 or SEEX*SEEY elements
@@ -168,10 +179,28 @@ class map_memory
          */
         void clear_tile_decoration( const tripoint_abs_ms &pos, std::string_view prefix = "" );
 
+        /** Number of regions currently held in memory. */
+        size_t loaded_regions() const;
+
+        /** Adds the memorized submaps held in memory to @p out. */
+        void add_memory_usage( memory_report::report &out ) const;
+
+        /**
+         * Regions held in memory beyond this many are dropped least recently used first,
+         * writing them out first if they were memorized into since they were loaded.
+         */
+        static constexpr int max_loaded_regions = 256;
+        /** Same as above in the low-memory profile, still more than a zoomed out view needs. */
+        static constexpr int low_memory_loaded_regions = 128;
+
     private:
         std::map<tripoint_abs_sm, shared_ptr_fast<mm_submap>> submaps;
 
         mutable std::map<int, std::vector<shared_ptr_fast<mm_submap>>> cached;
+        // All regions that have submaps in `submaps`, by mm_region coords.
+        lru_cache<tripoint, bool> loaded;
+        // Regions memorized into since they were last written or loaded.
+        std::set<tripoint> dirty_regions;
         tripoint_abs_sm cache_pos;
         point cache_size;
 
@@ -191,6 +220,15 @@ class map_memory
         //@}
 
         void clear_cache();
+        /** Marks the region holding the submap as in need of saving. */
+        void mark_dirty( const tripoint_abs_sm &sm_pos );
+        /** Drops a loaded region from memory, writing it out first if it is dirty. */
+        void unload_region( const tripoint &reg );
+        /**
+         * Writes a loaded region to disk, opening @p z on first use if the world is
+         * compressed. @returns false if the region couldn't be written.
+         */
+        bool write_region( const tripoint &reg, std::shared_ptr<zzip_stack> &z );
 };
 
 #endif // CATA_SRC_MAP_MEMORY_H
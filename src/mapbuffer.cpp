@@ -1,16 +1,21 @@
 #include "mapbuffer.h"
 
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <exception>
 #include <filesystem>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -25,6 +30,8 @@
 #include "json.h"
 #include "json_loader.h"
 #include "map.h"
+#include "memory_report.h"
+#include "ofstream_wrapper.h"
 #include "output.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
@@ -55,16 +62,397 @@ static cata_path find_dirname( const tripoint_abs_omt &om_addr )
     return PATH_INFO::current_dimension_save_path() / "maps" / segment;
 }
 
+// Serialized quads of one segment, ready to be written without touching game state.
+struct mapbuffer::segment_save {
+    // All paths are resolved up front, the background thread doesn't use PATH_INFO.
+    std::filesystem::path dirname;
+    std::filesystem::path zzip_name;
+    std::filesystem::path dictionary;
+    bool compressed = false;
+    // Quad file names within the segment, with their contents.
+    std::vector<std::pair<std::filesystem::path, std::string>> files;
+    // Quads that reverted to uniform, their files are deleted after they are written.
+    std::vector<std::filesystem::path> removals;
+    // Every quad in this job, their prefetched contents are stale once it is written.
+    std::vector<tripoint_abs_omt> quads;
+};
+
+// A quad to read and parse ahead of time, see @ref mapbuffer::prefetch.
+struct mapbuffer::quad_read {
+    tripoint_abs_omt quad;
+    std::filesystem::path dirname;
+    std::filesystem::path zzip_name;
+    std::filesystem::path dictionary;
+    bool compressed = false;
+    std::filesystem::path file_name;
+};
+
+// Parsed quads are dropped oldest first beyond this many.
+static constexpr size_t max_prefetched_quads = 1024;
+
+// Saving compacts a segment once its archive is twice the size of its contents. Archives that
+// are no longer written to are tidied up to this during quiet turns instead.
+static constexpr double idle_compaction_bloat = 1.25;
+// Archives checked per call to mapbuffer::compact_idle_archives.
+static constexpr size_t idle_compactions_per_call = 4;
+
+// Runs saves and prefetches in order on a single thread. Jobs must not touch debugmsg or the UI,
+// save failures are kept and rethrown on the main thread.
+class mapbuffer::background_io
+{
+    public:
+        ~background_io() {
+            {
+                std::lock_guard<std::mutex> lock( jobs_mutex );
+                stopping = true;
+            }
+            jobs_cv.notify_all();
+            if( thread.joinable() ) {
+                thread.join();
+            }
+        }
+
+        void push_save( segment_save &&save ) {
+            std::filesystem::path dirname = save.dirname;
+            push( std::move( dirname ), [this, save = std::move( save )]() {
+                write( save );
+                std::lock_guard<std::mutex> lock( jobs_mutex );
+                for( const tripoint_abs_omt &quad : save.quads ) {
+                    prefetched.erase( quad );
+                }
+            } );
+        }
+
+        void push_compaction( std::filesystem::path &&dirname, std::filesystem::path &&zzip_name,
+                              std::filesystem::path &&dictionary ) {
+            push( std::move( dirname ), [zzip_name = std::move( zzip_name ),
+                  dictionary = std::move( dictionary )]() {
+                if( !std::filesystem::exists( zzip_name ) ) {
+                    return;
+                }
+                std::optional<zzip> z = zzip::load( zzip_name, dictionary );
+                if( !z ) {
+                    // Whoever writes the segment next reports it.
+                    return;
+                }
+                compact( z, zzip_name, idle_compaction_bloat );
+            } );
+        }
+
+        // Returns false if the quad is already queued or read.
+        bool push_prefetch( quad_read &&read ) {
+            {
+                std::lock_guard<std::mutex> lock( jobs_mutex );
+                if( prefetched.count( read.quad ) != 0 ||
+                    !queued_prefetches.insert( read.quad ).second ) {
+                    return false;
+                }
+            }
+            std::filesystem::path dirname = read.dirname;
+            push( std::move( dirname ), [this, read = std::move( read )]() {
+                std::optional<JsonValue> contents;
+                try {
+                    contents = parse( read );
+                } catch( const std::exception & ) {
+                    // The main thread reads it again and reports the error.
+                }
+                std::lock_guard<std::mutex> lock( jobs_mutex );
+                queued_prefetches.erase( read.quad );
+                prefetched.emplace( read.quad, std::move( contents ) );
+                prefetch_order.push_back( read.quad );
+                while( prefetch_order.size() > max_prefetched_quads ) {
+                    prefetched.erase( prefetch_order.front() );
+                    prefetch_order.pop_front();
+                }
+            }, true );
+            return true;
+        }
+
+        // Parsed contents of the quad, if it was prefetched and had a file.
+        std::optional<JsonValue> take_prefetched( const tripoint_abs_omt &quad ) {
+            std::lock_guard<std::mutex> lock( jobs_mutex );
+            auto iter = prefetched.find( quad );
+            if( iter == prefetched.end() ) {
+                return std::nullopt;
+            }
+            std::optional<JsonValue> contents = std::move( iter->second );
+            prefetched.erase( iter );
+            return contents;
+        }
+
+        void forget_prefetched( const tripoint_abs_omt &quad ) {
+            std::lock_guard<std::mutex> lock( jobs_mutex );
+            prefetched.erase( quad );
+        }
+
+        void forget_all_prefetched() {
+            std::lock_guard<std::mutex> lock( jobs_mutex );
+            prefetched.clear();
+            prefetch_order.clear();
+        }
+
+        // True while any job is queued or running.
+        bool busy() {
+            std::lock_guard<std::mutex> lock( jobs_mutex );
+            return !pending.empty() || !pending_reads.empty();
+        }
+
+        // Readers of the directory only wait for jobs writing to it, writers for prefetches too.
+        void wait_for( const std::filesystem::path &dirname, bool for_writing ) {
+            std::unique_lock<std::mutex> lock( jobs_mutex );
+            jobs_cv.wait( lock, [&]() {
+                return pending.count( dirname ) == 0 &&
+                       ( !for_writing || pending_reads.count( dirname ) == 0 );
+            } );
+        }
+
+        void wait_for_all() {
+            std::unique_lock<std::mutex> lock( jobs_mutex );
+            jobs_cv.wait( lock, [&]() {
+                return pending.empty() && pending_reads.empty();
+            } );
+        }
+
+        // Throws the first failure since the last call, if there was one.
+        void rethrow_error() {
+            std::string failure;
+            {
+                std::lock_guard<std::mutex> lock( jobs_mutex );
+                failure.swap( error );
+            }
+            if( !failure.empty() ) {
+                throw std::runtime_error( failure );
+            }
+        }
+
+    private:
+        struct job {
+            std::filesystem::path dirname;
+            std::function<void()> run;
+            bool read_only;
+        };
+
+        void push( std::filesystem::path &&dirname, std::function<void()> &&run,
+                   bool read_only = false ) {
+            {
+                std::lock_guard<std::mutex> lock( jobs_mutex );
+                ( read_only ? pending_reads : pending )[dirname]++;
+                jobs.push_back( { std::move( dirname ), std::move( run ), read_only } );
+                if( !thread.joinable() ) {
+                    thread = std::thread( [this]() {
+                        run_jobs();
+                    } );
+                }
+            }
+            jobs_cv.notify_all();
+        }
+
+        void run_jobs() {
+            std::unique_lock<std::mutex> lock( jobs_mutex );
+            while( true ) {
+                jobs_cv.wait( lock, [this]() {
+                    return stopping || !jobs.empty();
+                } );
+                if( jobs.empty() ) {
+                    return;
+                }
+                // The job stays counted as pending until it is done.
+                job next = std::move( jobs.front() );
+                jobs.pop_front();
+                lock.unlock();
+                std::string failure;
+                try {
+                    next.run();
+                } catch( const std::exception &err ) {
+                    failure = err.what();
+                }
+                lock.lock();
+                if( !failure.empty() && error.empty() ) {
+                    error = failure;
+                }
+                std::map<std::filesystem::path, int> &counts = next.read_only ? pending_reads : pending;
+                if( --counts[next.dirname] == 0 ) {
+                    counts.erase( next.dirname );
+                }
+                jobs_cv.notify_all();
+            }
+        }
+
+        static std::optional<JsonValue> parse( const quad_read &read ) {
+            if( read.compressed ) {
+                if( !std::filesystem::exists( read.zzip_name ) ) {
+                    return std::nullopt;
+                }
+                std::optional<zzip> z = zzip::load( read.zzip_name, read.dictionary );
+                if( !z || !z->has_file( read.file_name ) ) {
+                    return std::nullopt;
+                }
+                return json_loader::from_string( z->get_file_string( read.file_name ) );
+            }
+            std::optional<std::string> contents = read_whole_file( read.dirname / read.file_name );
+            if( !contents ) {
+                return std::nullopt;
+            }
+            return json_loader::from_string( std::move( *contents ) );
+        }
+
+        // Swaps in a compacted copy of the archive if it has grown past @p bloat_factor.
+        static void compact( std::optional<zzip> &z, const std::filesystem::path &zzip_name,
+                             double bloat_factor ) {
+            std::filesystem::path tmp_path = zzip_name;
+            tmp_path.concat( ".tmp" ); // NOLINT(cata-u8-path)
+            if( z->compact_to( tmp_path, bloat_factor ) ) {
+                z.reset();
+                rename_file( tmp_path, zzip_name );
+            }
+        }
+
+        static void write( const segment_save &job ) {
+            if( job.compressed ) {
+                std::optional<zzip> z = zzip::load( job.zzip_name, job.dictionary );
+                if( !z ) {
+                    throw std::runtime_error( "Failed opening compressed save file " +
+                                              job.zzip_name.generic_u8string() );
+                }
+                std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+                files.reserve( job.files.size() );
+                for( const std::pair<std::filesystem::path, std::string> &file : job.files ) {
+                    files.emplace_back( file.first, file.second );
+                }
+                if( !z->add_files( files ) ) {
+                    throw std::runtime_error( "Failed writing " + std::to_string( files.size() ) +
+                                              " files to " + job.zzip_name.generic_u8string() );
+                }
+                if( !job.removals.empty() ) {
+                    z->delete_files( { job.removals.begin(), job.removals.end() } );
+                }
+                compact( z, job.zzip_name, 2.0 );
+                return;
+            }
+            if( !job.files.empty() ) {
+                // Don't create the directory if it would be empty
+                assure_dir_exist( job.dirname );
+            }
+            for( const std::pair<std::filesystem::path, std::string> &file : job.files ) {
+                // Goes through a temporary file that is renamed into place once complete.
+                ofstream_wrapper fout( job.dirname / file.first, std::ios::binary );
+                fout.stream() << file.second;
+                fout.close();
+            }
+            for( const std::filesystem::path &removal : job.removals ) {
+                std::error_code ec;
+                std::filesystem::remove( job.dirname / removal, ec );
+            }
+        }
+
+        std::thread thread;
+        std::deque<job> jobs;
+        // Number of queued or running jobs per segment directory, other than prefetches.
+        std::map<std::filesystem::path, int> pending;
+        // Number of queued or running prefetches per segment directory.
+        std::map<std::filesystem::path, int> pending_reads;
+        std::string error;
+        // Read quads, without a value if they had no file.
+        std::map<tripoint_abs_omt, std::optional<JsonValue>> prefetched;
+        std::deque<tripoint_abs_omt> prefetch_order;
+        std::set<tripoint_abs_omt> queued_prefetches;
+        std::mutex jobs_mutex;
+        std::condition_variable jobs_cv;
+        bool stopping = false;
+};
+
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer() = default;
 mapbuffer::~mapbuffer() = default;
 
+void mapbuffer::add_memory_usage( memory_report::report &out ) const
+{
+    for( const auto &[p, sm] : submaps ) {
+        sm->add_memory_usage( out );
+    }
+}
+
 void mapbuffer::clear()
 {
+    try {
+        finish_pending_saves();
+    } catch( const std::exception &err ) {
+        debugmsg( "Failed to save the maps: %s", err.what() );
+    }
+    if( io ) {
+        io->forget_all_prefetched();
+    }
+    compaction_candidates.clear();
+    next_compaction_candidate = 0;
     submaps.clear();
 }
 
+void mapbuffer::finish_pending_saves()
+{
+    if( io ) {
+        io->wait_for_all();
+        io->rethrow_error();
+    }
+}
+
+void mapbuffer::compact_idle_archives()
+{
+    if( !world_generator->active_world->has_compression_enabled() || ( io && io->busy() ) ) {
+        return;
+    }
+    if( next_compaction_candidate >= compaction_candidates.size() ) {
+        // Start another pass over whatever has been saved by now.
+        compaction_candidates = get_files_from_path( std::string( zzip_suffix ),
+                                PATH_INFO::current_dimension_save_path() / "maps", false, true );
+        next_compaction_candidate = 0;
+    }
+    if( compaction_candidates.empty() ) {
+        return;
+    }
+    if( !io ) {
+        io = std::make_unique<background_io>();
+    }
+    const std::filesystem::path dictionary = ( PATH_INFO::world_base_save_path() /
+            "maps.dict" ).get_unrelative_path();
+    for( size_t i = 0; i < idle_compactions_per_call &&
+         next_compaction_candidate < compaction_candidates.size(); ++i ) {
+        std::filesystem::path zzip_name =
+            compaction_candidates[next_compaction_candidate++].get_unrelative_path();
+        // Queued under the segment directory, so reads and writes of the segment wait for it.
+        std::filesystem::path dirname = zzip_name.parent_path() / zzip_name.stem();
+        std::filesystem::path dictionary_copy = dictionary;
+        io->push_compaction( std::move( dirname ), std::move( zzip_name ),
+                             std::move( dictionary_copy ) );
+    }
+}
+
+void mapbuffer::prefetch( const tripoint_abs_sm &p )
+{
+    if( submaps.count( p ) != 0 ) {
+        return;
+    }
+    quad_read read;
+    read.quad = project_to<coords::omt>( p );
+    const cata_path dirname = find_dirname( read.quad );
+    read.dirname = dirname.get_unrelative_path();
+    read.zzip_name = ( dirname + zzip_suffix ).get_unrelative_path();
+    read.dictionary = ( PATH_INFO::world_base_save_path() / "maps.dict" ).get_unrelative_path();
+    read.compressed = world_generator->active_world->has_compression_enabled();
+    read.file_name = std::filesystem::u8path( quad_file_name( read.quad ) );
+    if( !io ) {
+        io = std::make_unique<background_io>();
+    }
+    io->push_prefetch( std::move( read ) );
+}
+
+void mapbuffer::finish_saves_to( const cata_path &dirname, bool for_writing )
+{
+    if( io ) {
+        io->wait_for( dirname.get_unrelative_path(), for_writing );
+    }
+}
+
 void mapbuffer::clear_outside_reality_bubble()
 {
     map &here = get_map();
@@ -153,6 +541,7 @@ bool mapbuffer::submap_exists_approx( const tripoint_abs_sm &p )
             const tripoint_abs_omt om_addr = project_to<coords::omt>( p );
             const cata_path dirname = find_dirname( om_addr );
             std::string file_name = quad_file_name( om_addr );
+            finish_saves_to( dirname );
 
             if( world_generator->active_world->has_compression_enabled() ) {
                 cata_path zzip_name = dirname;
@@ -175,8 +564,11 @@ bool mapbuffer::submap_exists_approx( const tripoint_abs_sm &p )
     return true;
 }
 
-void mapbuffer::save( bool delete_after_save )
+void mapbuffer::save( bool delete_after_save, bool in_background )
 {
+    if( io ) {
+        io->rethrow_error();
+    }
     assure_dir_exist( PATH_INFO::current_dimension_save_path() / "maps" );
     int num_saved_submaps = 0;
     int num_total_submaps = submaps.size();
@@ -188,6 +580,9 @@ void mapbuffer::save( bool delete_after_save )
     // A set of already-saved submaps, in global overmap coordinates.
     std::set<tripoint_abs_omt> saved_submaps;
     std::list<tripoint_abs_sm> submaps_to_delete;
+    // Background saves, by segment directory.
+    std::map<std::filesystem::path, segment_save> segments;
+    const bool compressed = world_generator->active_world->has_compression_enabled();
     static constexpr std::chrono::milliseconds update_interval( 500 );
     std::chrono::steady_clock::time_point last_update = std::chrono::steady_clock::now();
 
@@ -218,21 +613,45 @@ void mapbuffer::save( bool delete_after_save )
         const cata_path dirname = find_dirname( om_addr );
         const cata_path quad_path = dirname / quad_file_name( om_addr );
 
+        segment_save *deferred = nullptr;
+        if( in_background ) {
+            std::filesystem::path segment_dir = dirname.get_unrelative_path();
+            auto segment = segments.find( segment_dir );
+            if( segment == segments.end() ) {
+                segment = segments.emplace( segment_dir, segment_save() ).first;
+                segment->second.dirname = segment_dir;
+                segment->second.zzip_name = ( dirname + zzip_suffix ).get_unrelative_path();
+                segment->second.dictionary = ( PATH_INFO::world_base_save_path() /
+                                               "maps.dict" ).get_unrelative_path();
+                segment->second.compressed = compressed;
+            }
+            deferred = &segment->second;
+        }
+
         bool inside_reality_bubble = here.inbounds( om_addr );
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
         save_quad( dirname, quad_path, om_addr, submaps_to_delete,
-                   delete_after_save || !inside_reality_bubble );
+                   delete_after_save || !inside_reality_bubble, deferred );
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    if( segments.empty() ) {
+        return;
+    }
+    if( !io ) {
+        io = std::make_unique<background_io>();
+    }
+    for( auto &segment : segments ) {
+        io->push_save( std::move( segment.second ) );
+    }
 }
 
 void mapbuffer::save_quad(
     const cata_path &dirname, const cata_path &filename, const tripoint_abs_omt &om_addr,
-    std::list<tripoint_abs_sm> &submaps_to_delete, bool delete_after_save )
+    std::list<tripoint_abs_sm> &submaps_to_delete, bool delete_after_save, segment_save *deferred )
 {
     std::vector<point_rel_sm> offsets;
     std::vector<tripoint_abs_sm> submap_addrs;
@@ -243,6 +662,25 @@ void mapbuffer::save_quad(
     offsets.push_back( point_rel_sm::east );
     offsets.push_back( point_rel_sm::south_east );
 
+    // A quad that hasn't changed since it was read or written is already on disk as it is.
+    bool unchanged = true;
+    for( const point_rel_sm &offset : offsets ) {
+        const auto it = submaps.find( project_to<coords::sm>( om_addr ) + offset.raw() );
+        if( it == submaps.end() || !it->second ||
+            it->second->changed_since_saved( delete_after_save ) ) {
+            unchanged = false;
+            break;
+        }
+    }
+    if( unchanged ) {
+        if( delete_after_save ) {
+            for( const point_rel_sm &offset : offsets ) {
+                submaps_to_delete.push_back( project_to<coords::sm>( om_addr ) + offset.raw() );
+            }
+        }
+        return;
+    }
+
     bool all_uniform = true;
     bool reverted_to_uniform = false;
     bool file_exists = false;
@@ -253,7 +691,12 @@ void mapbuffer::save_quad(
     // The number of uniform submaps is so enormous that the filesystem overhead
     // for this step of just checking if the quad exists approaches 70% of the
     // total cost of saving the mapbuffer, in one test save I had.
-    if( world_generator->active_world->has_compression_enabled() ) {
+    if( deferred != nullptr ) {
+        // The writer only deletes files that exist, so assume this one does.
+        file_exists = true;
+        deferred->quads.push_back( om_addr );
+    } else if( world_generator->active_world->has_compression_enabled() ) {
+        finish_saves_to( dirname, true );
         z = zzip::load( zzip_name.get_unrelative_path(),
                         ( PATH_INFO::world_base_save_path() / "maps.dict" ).get_unrelative_path() );
         if( !z ) {
@@ -262,8 +705,13 @@ void mapbuffer::save_quad(
         }
         file_exists = z->has_file( filename.get_relative_path().filename() );
     } else {
+        finish_saves_to( dirname, true );
         file_exists = std::filesystem::exists( filename.get_unrelative_path() );
     }
+    if( deferred == nullptr && io ) {
+        // Whatever was read ahead is about to be outdated.
+        io->forget_prefetched( om_addr );
+    }
 
     for( point_rel_sm &offsets_offset : offsets ) {
         tripoint_abs_sm submap_addr = project_to<coords::sm>( om_addr );
@@ -322,6 +770,7 @@ void mapbuffer::save_quad(
         jsout.end_array();
 
         sm->store( jsout );
+        sm->mark_saved();
 
         jsout.end_object();
 
@@ -334,6 +783,15 @@ void mapbuffer::save_quad(
 
     std::string s = std::move( stringout ).str();
 
+    if( deferred != nullptr ) {
+        const std::filesystem::path file_name = filename.get_relative_path().filename();
+        deferred->files.emplace_back( file_name, std::move( s ) );
+        if( all_uniform && reverted_to_uniform ) {
+            deferred->removals.push_back( file_name );
+        }
+        return;
+    }
+
     if( z ) {
         z->add_file( filename.get_relative_path().filename(), s );
     } else {
@@ -370,8 +828,25 @@ submap *mapbuffer::unserialize_submaps( const tripoint_abs_sm &p )
     std::string file_name = quad_file_name( om_addr );
     std::filesystem::path file_name_path = std::filesystem::u8path( file_name );
     cata_path quad_path = dirname / file_name;
+    finish_saves_to( dirname );
 
     bool read = [&] {
+        std::optional<JsonValue> prefetched;
+        if( io )
+        {
+            prefetched = io->take_prefetched( om_addr );
+        }
+        if( prefetched )
+        {
+            try {
+                deserialize( *prefetched );
+            } catch( std::exception &err ) {
+                debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), quad_path.generic_u8string(),
+                          err.what() );
+                return false;
+            }
+            return true;
+        }
         if( world_generator->active_world->has_compression_enabled() )
         {
             cata_path zzip_name = dirname;
@@ -389,9 +864,7 @@ submap *mapbuffer::unserialize_submaps( const tripoint_abs_sm &p )
             if( !z->has_file( file_name_path ) ) {
                 return false;
             }
-            std::vector<std::byte> contents = z->get_file( file_name_path );
-            std::string_view string_contents{ reinterpret_cast<char *>( contents.data() ), contents.size() };
-            JsonValue jsin = json_loader::from_string( std::string( string_contents ) );
+            JsonValue jsin = json_loader::from_string( z->get_file_string( file_name_path ) );
             try {
                 deserialize( jsin );
             } catch( std::exception &err ) {
@@ -444,6 +917,8 @@ void mapbuffer::deserialize( const JsonArray &ja )
                 sm->load( submap_member, submap_member_name, version );
             }
         }
+        // Exactly what is on disk, until something changes it.
+        sm->mark_saved();
 
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %s was already loaded", submap_coordinates.to_string() );
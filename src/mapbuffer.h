@@ -2,15 +2,21 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <cstddef>
 #include <list>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "coordinates.h"
 
 class JsonArray;
 class cata_path;
 class submap;
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -24,10 +30,18 @@ class mapbuffer
         /** Store all submaps in this instance into savefiles.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
+         * @param in_background If true, the submaps are only serialized here,
+         * compressing and writing the files is left to a background thread.
+         * Throws if an earlier background save failed.
          **/
-        void save( bool delete_after_save = false );
+        void save( bool delete_after_save = false, bool in_background = false );
+
+        /** Block until every background save has been written to disk.
+         * Throws if any of them failed.
+         */
+        void finish_pending_saves();
 
-        /** Delete all buffered submaps. **/
+        /** Delete all buffered submaps. Waits for background saves first. **/
         void clear();
 
         /** Delete all buffered submaps except those inside the reality bubble.
@@ -67,6 +81,22 @@ class mapbuffer
         // Cheaper version of the above for when you don't mind some false results
         bool submap_exists_approx( const tripoint_abs_sm &p );
 
+        /** Start reading and parsing the quad holding @p p on the background thread,
+         * so a later @ref lookup_submap only has to deserialize it.
+         * Does nothing if the submap is already loaded or its quad is already queued.
+         */
+        void prefetch( const tripoint_abs_sm &p );
+
+        /** Queue a check of the next few saved segment archives on the background thread.
+         * Those that have grown well past their contents, from files being rewritten or reverted
+         * to uniform, are compacted and the copy renamed into place.
+         * Does nothing while background saves or prefetches are running, call it on quiet turns.
+         */
+        void compact_idle_archives();
+
+        /** Adds every buffered submap and what it holds to @p out. */
+        void add_memory_usage( memory_report::report &out ) const;
+
     private:
         using submap_map_t = std::map<tripoint_abs_sm, std::unique_ptr<submap>>;
 
@@ -77,8 +107,15 @@ class mapbuffer
         inline submap_map_t::iterator end() {
             return submaps.end();
         }
+        inline size_t size() const {
+            return submaps.size();
+        }
 
     private:
+        struct segment_save;
+        struct quad_read;
+        class background_io;
+
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( const tripoint_abs_sm &addr );
@@ -88,8 +125,15 @@ class mapbuffer
         void save_quad(
             const cata_path &dirname, const cata_path &filename,
             const tripoint_abs_omt &om_addr, std::list<tripoint_abs_sm> &submaps_to_delete,
-            bool delete_after_save );
+            bool delete_after_save, segment_save *deferred );
+        // Wait until no background save is writing into the given segment directory. Before
+        // writing to it, also wait for prefetches still reading from it.
+        void finish_saves_to( const cata_path &dirname, bool for_writing = false );
         submap_map_t submaps; // NOLINT(cata-serialize)
+        std::unique_ptr<background_io> io; // NOLINT(cata-serialize)
+        // Segment archives still to be checked by compact_idle_archives in this pass.
+        std::vector<cata_path> compaction_candidates; // NOLINT(cata-serialize)
+        size_t next_compaction_candidate = 0; // NOLINT(cata-serialize)
 };
 
 extern mapbuffer MAPBUFFER;
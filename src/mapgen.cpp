@@ -722,6 +722,11 @@ void map::generate( const tripoint_abs_omt &p, const time_point &when, bool save
         this->mapgen_in_progress = false;
     } );
     mapgen_in_progress = true;
+    // Each OMT stack rolls from its own stream, so what it looks like doesn't depend on which
+    // other OMTs were generated first, and generating it doesn't shift the game's own rolls.
+    // Seeded by the stack, not the z-level of the map that asked for it.
+    const scoped_rng_stream rng_scope( overmap_buffer.generation_seed( tripoint_abs_omt( p.xy(), 0 ),
+                                       "mapgen" ) );
 
     const tripoint_abs_sm p_sm_base = project_to<coords::sm>( p );
     std::vector<bool> generated;
@@ -790,9 +795,13 @@ void map::generate( const tripoint_abs_omt &p, const time_point &when, bool save
         // This attempts to scale density of zombies inversely with distance from the nearest city.
         // In other words, make city centers dense and perimeters sparse.
         float density = 0.0f;
-        for( int i = -MON_RADIUS; i <= MON_RADIUS; i++ ) {
-            for( int j = -MON_RADIUS; j <= MON_RADIUS; j++ ) {
-                density += overmap_buffer.ter( { p.x() + i, p.y() + j, gridz } )->get_mondensity();
+        const inclusive_rectangle<point_abs_omt> nearby_area( p.xy() - point( MON_RADIUS, MON_RADIUS ),
+                p.xy() + point( MON_RADIUS, MON_RADIUS ) );
+        const std::vector<oter_id> nearby = overmap_buffer.ter_block( nearby_area, gridz );
+        // Summed in the same order as ever, the block comes in rows.
+        for( int i = 0; i <= 2 * MON_RADIUS; i++ ) {
+            for( int j = 0; j <= 2 * MON_RADIUS; j++ ) {
+                density += nearby[j * ( 2 * MON_RADIUS + 1 ) + i]->get_mondensity();
             }
         }
         density = density / 100;
@@ -825,7 +834,7 @@ void map::generate( const tripoint_abs_omt &p, const time_point &when, bool save
         }
 
         if( any_missing || !save_results ) {
-            const region_settings_map_extras settings_mx =
+            const region_settings_map_extras &settings_mx =
                 overmap_buffer.get_settings( p ).get_settings_map_extras();
             auto mx_iter = settings_mx.extras.find( map_extra_collection_id( terrain_type->get_extras() ) );
             if( mx_iter != settings_mx.extras.end() ) {
@@ -1007,6 +1016,8 @@ class mapgen_basic_container
         //mapgens that need to be recalculated with a function when spawned
         std::vector<std::shared_ptr<mapgen_function>> mapgens_to_recalc_;
         weighted_int_list<std::shared_ptr<mapgen_function>> weights_;
+        // Functions picked by setup() whose own setup waits until they are first needed.
+        std::vector<std::shared_ptr<mapgen_function>> pending_setup_;
 
     public:
         int add( const std::shared_ptr<mapgen_function> &ptr ) {
@@ -1027,6 +1038,14 @@ class mapgen_basic_container
          * false is returned. If unsure, just use 0 for it.
          */
         bool generate( mapgendata &dat, const int hardcoded_weight ) {
+            try {
+                ensure_ready();
+            } catch( const std::exception &err ) {
+                // Don't keep generating from functions that failed to set up.
+                debugmsg( "%s", err.what() );
+                weights_.clear();
+                mapgens_to_recalc_.clear();
+            }
             for( const std::shared_ptr<mapgen_function> &ptr : mapgens_to_recalc_ ) {
                 dialogue d( get_talker_for( get_avatar() ), std::make_unique<talker>() );
                 int const weight = ptr->weight.evaluate( d );
@@ -1050,9 +1069,11 @@ class mapgen_basic_container
             return true;
         }
         /**
-         * Calls @ref mapgen_function::setup and sets up the internal weighted list using
-         * the **current** value of @ref mapgen_function::weight. This value may have
-         * changed since it was first added, so this is needed to recalculate the weighted list.
+         * Sets up the internal weighted list using the **current** value of
+         * @ref mapgen_function::weight. This value may have changed since it was first added,
+         * so this is needed to recalculate the weighted list.
+         * Most mapgen is never used in a game, so @ref mapgen_function::setup and
+         * @ref mapgen_function::finalize_parameters are left to @ref ensure_ready.
          */
         void setup() {
             for( const std::shared_ptr<mapgen_function> &ptr : mapgens_ ) {
@@ -1066,29 +1087,46 @@ class mapgen_basic_container
                     mapgens_to_recalc_.push_back( ptr );
                 }
 
-                ptr->setup();
+                pending_setup_.push_back( ptr );
             }
             // Not needed anymore, pointers are now stored in weights_ (or not used at all)
             mapgens_.clear();
         }
-        void finalize_parameters() {
+        /**
+         * Calls @ref mapgen_function::setup and then @ref mapgen_function::finalize_parameters
+         * for the functions of this container, unless that already happened. Nested mapgen is
+         * set up and finalized at load time, so it's ready by then.
+         * @throws JsonError if a function fails to set up.
+         */
+        void ensure_ready() {
+            if( pending_setup_.empty() ) {
+                return;
+            }
+            const std::vector<std::shared_ptr<mapgen_function>> pending = std::move( pending_setup_ );
+            pending_setup_.clear();
+            for( const std::shared_ptr<mapgen_function> &ptr : pending ) {
+                ptr->setup();
+            }
             for( auto &mapgen_function_ptr : weights_ ) {
                 mapgen_function_ptr.first->finalize_parameters();
             }
         }
-        void check_consistency() const {
+        void check_consistency() {
+            ensure_ready();
             for( const auto &mapgen_function_ptr : weights_ ) {
                 mapgen_function_ptr.first->check();
             }
         }
-        void check_consistency_with( const oter_t &ter ) const {
+        void check_consistency_with( const oter_t &ter ) {
+            ensure_ready();
             for( const auto &mapgen_function_ptr : weights_ ) {
                 mapgen_function_ptr.first->check_consistent_with( ter );
             }
         }
 
         mapgen_parameters get_mapgen_params( mapgen_parameter_scope scope,
-                                             const std::string &context ) const {
+                                             const std::string &context ) {
+            ensure_ready();
             mapgen_parameters result;
             for( const std::pair<std::shared_ptr<mapgen_function>, int> &p : weights_ ) {
                 result.check_and_merge( p.first->get_mapgen_params( scope ), context );
@@ -1132,16 +1170,11 @@ class mapgen_factory
             // therefore never generated.
             mapgens_.erase( "null" );
         }
-        void finalize_parameters() {
-            for( std::pair<const std::string, mapgen_basic_container> &omw : mapgens_ ) {
-                omw.second.finalize_parameters();
-            }
-        }
-        void check_consistency() const {
+        void check_consistency() {
             // Cache all strings that may get looked up here so we don't have to go through
             // all the sources for them upon each loop.
             const std::set<std::string> usages = get_usages();
-            for( const std::pair<const std::string, mapgen_basic_container> &omw : mapgens_ ) {
+            for( std::pair<const std::string, mapgen_basic_container> &omw : mapgens_ ) {
                 omw.second.check_consistency();
                 if( usages.count( omw.first ) == 0 ) {
                     debugmsg( "Mapgen %s is not used by anything!", omw.first );
@@ -1156,7 +1189,7 @@ class mapgen_factory
         bool has( const std::string &key ) const {
             return mapgens_.count( key ) != 0;
         }
-        const mapgen_basic_container *find( const std::string &key ) const {
+        mapgen_basic_container *find( const std::string &key ) {
             auto it = mapgens_.find( key );
             if( it == mapgens_.end() ) {
                 return nullptr;
@@ -1177,7 +1210,7 @@ class mapgen_factory
             return iter->second.generate( dat, hardcoded_weight );
         }
 
-        mapgen_parameters get_map_special_params( const std::string &key ) const {
+        mapgen_parameters get_map_special_params( const std::string &key ) {
             const auto iter = mapgens_.find( key );
             if( iter == mapgens_.end() ) {
                 return mapgen_parameters();
@@ -1251,8 +1284,8 @@ void calculate_mapgen_weights()   // TODO: rename as it runs jsonfunction setup
         }
     }
     // Having set up all the mapgens we can now perform a second
-    // pass of finalizing their parameters
-    oter_mapgen.finalize_parameters();
+    // pass of finalizing their parameters. The overmap terrain mapgen does both once it's
+    // first needed.
     for( auto &pr : nested_mapgens ) {
         for( const std::pair<std::shared_ptr<mapgen_function_json_nested>, int> &ptr :
              pr.second.funcs() ) {
@@ -1937,6 +1970,8 @@ class mapgen_value
         struct param_source : value_source {
             std::string param_name;
             std::optional<StringId> fallback;
+            mutable std::string last_value;
+            mutable std::optional<StringId> last_id;
 
             explicit param_source( const JsonObject &jo )
                 : param_name( jo.get_string( "param" ) ) {
@@ -1944,11 +1979,21 @@ class mapgen_value
             }
 
             Id get( const mapgendata &dat ) const override {
-                if( fallback ) {
-                    return Id( dat.get_arg_or<StringId>( param_name, *fallback ) );
-                } else {
+                const cata_variant *arg = dat.find_arg( param_name );
+                if( !arg ) {
+                    if( fallback ) {
+                        return Id( *fallback );
+                    }
                     return Id( dat.get_arg<StringId>( param_name ) );
                 }
+                // A parameter keeps its value for a whole OMT, while this is asked once per
+                // cell that uses it. Keeping the last id around lets string_id remember its
+                // int_id instead of a fresh one being built and looked up every time.
+                if( !last_id || arg->get_string() != last_value ) {
+                    last_value = arg->get_string();
+                    last_id = mapgendata_detail::extract_variant_value<StringId>( *arg );
+                }
+                return Id( *last_id );
             }
 
             void check( const std::string &context, const mapgen_parameters &parameters
@@ -7809,7 +7854,7 @@ void update_mapgen_function_json::check() const
 
 void check_mapgen_consistent_with( const std::string &key, const oter_t &ter )
 {
-    if( const mapgen_basic_container *container = oter_mapgen.find( key ) ) {
+    if( mapgen_basic_container *container = oter_mapgen.find( key ) ) {
         container->check_consistency_with( ter );
     }
 }
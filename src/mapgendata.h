@@ -256,6 +256,12 @@ class mapgendata
         const oter_id &last_predecessor() const;
         void pop_last_predecessor();
 
+        // The raw value of parameter @p name, or nullptr if there's no such parameter.
+        const cata_variant *find_arg( const std::string &name ) const {
+            auto it = mapgen_args_.map.find( name );
+            return it == mapgen_args_.map.end() ? nullptr : &it->second;
+        }
+
         template<typename Result>
         Result get_arg( const std::string &name ) const {
             auto it = mapgen_args_.map.find( name );
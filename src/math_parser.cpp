@@ -195,6 +195,16 @@ bool is_assign_target( thingie const &thing )
              std::get<func_diag>( thing.data ).fa != nullptr );
 }
 
+bool is_constant( thingie const &thing )
+{
+    return std::holds_alternative<double>( thing.data );
+}
+
+bool all_constant( std::vector<thingie> const &things )
+{
+    return std::all_of( things.begin(), things.end(), is_constant );
+}
+
 std::vector<double> _eval_params( std::vector<thingie> const &params, const_dialogue const &d )
 {
     std::vector<double> elems( params.size() );
@@ -834,7 +844,16 @@ void math_exp::math_exp_impl::new_func()
             },
             [&params, this]( pmath_func v )
             {
-                output.emplace( std::in_place_type_t<func>(), std::move( params ), v->f );
+                if( v->pure && all_constant( params ) ) {
+                    std::vector<double> args( params.size() );
+                    std::transform( params.begin(), params.end(), args.begin(),
+                    []( thingie const & e ) {
+                        return std::get<double>( e.data );
+                    } );
+                    output.emplace( v->f( args ) );
+                } else {
+                    output.emplace( std::in_place_type_t<func>(), std::move( params ), v->f );
+                }
             },
             [&params, this]( jmath_func_id const & v )
             {
@@ -872,6 +891,10 @@ void math_exp::math_exp_impl::new_ternary( thingie &lhs, thingie &rhs )
     thingie cond = std::move( output.top() );
     _validate_operand( cond, "?:" );
     output.pop();
+    if( is_constant( cond ) ) {
+        output.emplace( std::get<double>( cond.data ) > 0 ? std::move( lhs ) : std::move( rhs ) );
+        return;
+    }
     output.emplace( std::in_place_type_t<ternary>(), cond, lhs, rhs );
 }
 
@@ -938,7 +961,11 @@ void math_exp::math_exp_impl::new_oper()
                 if( output.empty() && arity.empty() ) {
                     type = v->type;
                 }
-                output.emplace( std::in_place_type_t<oper>(), lhs, rhs, v->f );
+                if( is_constant( lhs ) && is_constant( rhs ) ) {
+                    output.emplace( v->f( std::get<double>( lhs.data ), std::get<double>( rhs.data ) ) );
+                } else {
+                    output.emplace( std::in_place_type_t<oper>(), lhs, rhs, v->f );
+                }
             }
         },
         [this, &op]( punary_op v )
@@ -948,7 +975,11 @@ void math_exp::math_exp_impl::new_oper()
             output.pop();
             parse_position = op.pos;
             _validate_operand( rhs, v->symbol );
-            output.emplace( std::in_place_type_t<oper>(), thingie { 0.0 }, rhs, v->f );
+            if( is_constant( rhs ) ) {
+                output.emplace( v->f( 0.0, std::get<double>( rhs.data ) ) );
+            } else {
+                output.emplace( std::in_place_type_t<oper>(), thingie { 0.0 }, rhs, v->f );
+            }
         },
         [this, &op]( pass_op v )
         {
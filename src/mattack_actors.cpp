@@ -140,6 +140,15 @@ std::unique_ptr<mattack_actor> leap_actor::clone() const
     return std::make_unique<leap_actor>( *this );
 }
 
+bool leap_actor::may_fire( const monster &z ) const
+{
+    if( !z.has_dest() ) {
+        return false;
+    }
+    const float dist = rl_dist( z.pos_abs(), z.get_dest() );
+    return dist >= min_consider_range && dist <= max_consider_range;
+}
+
 bool leap_actor::call( monster &z ) const
 {
     if( !z.has_dest() || !z.can_act() || !z.move_effects( false ) ) {
@@ -771,6 +780,12 @@ int melee_actor::do_grab( monster &z, Creature *target, bodypart_id bp_id ) cons
     return 1;
 }
 
+bool melee_actor::may_fire( const monster &z ) const
+{
+    // find_target() needs a visible target within range, or adjacent for range 1.
+    return target_at_dest( z, std::max( range, 1 ) );
+}
+
 bool melee_actor::call( monster &z ) const
 {
     map &here = get_map();
@@ -1262,6 +1277,15 @@ int gun_actor::get_max_range()  const
     return max_range;
 }
 
+bool gun_actor::may_fire( const monster &z ) const
+{
+    // Friendly turrets pick their own targets, and some guns fire at moving vehicles.
+    if( z.friendly != 0 || target_moving_vehicles ) {
+        return true;
+    }
+    return target_at_dest( z, std::numeric_limits<int>::max() );
+}
+
 bool gun_actor::call( monster &z ) const
 {
     map &here = get_map();
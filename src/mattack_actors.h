@@ -62,6 +62,7 @@ class leap_actor : public mattack_actor
 
         void load_internal( const JsonObject &obj, const std::string &src ) override;
         bool call( monster & ) const override;
+        bool may_fire( const monster &z ) const override;
         std::unique_ptr<mattack_actor> clone() const override;
 };
 
@@ -211,6 +212,7 @@ class melee_actor : public mattack_actor
         0 fails loudly (resetting the cooldown), 1 succeeds */
         int do_grab( monster &, Creature *target, bodypart_id bp_id ) const;
         bool call( monster & ) const override;
+        bool may_fire( const monster &z ) const override;
         std::unique_ptr<mattack_actor> clone() const override;
 };
 
@@ -298,6 +300,7 @@ class gun_actor : public mattack_actor
 
         void load_internal( const JsonObject &obj, const std::string &src ) override;
         bool call( monster & ) const override;
+        bool may_fire( const monster &z ) const override;
         std::unique_ptr<mattack_actor> clone() const override;
 };
 
@@ -39,6 +39,15 @@ class mattack_actor
         virtual bool call( monster & ) const = 0;
         virtual std::unique_ptr<mattack_actor> clone() const = 0;
         virtual void load_internal( const JsonObject &jo, const std::string &src ) = 0;
+        // Cheap precondition checked before call(), without touching the RNG or the map.
+        // Returns false only when call() would certainly fail, e.g. with no target in reach.
+        virtual bool may_fire( const monster & ) const {
+            return true;
+        }
+
+    protected:
+        // True if a creature other than z stands on z's destination, at most range tiles away.
+        static bool target_at_dest( const monster &z, int range );
 };
 
 struct mtype_special_attack {
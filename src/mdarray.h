@@ -3,6 +3,7 @@
 #define CATA_SRC_MDARRAY_H
 
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <initializer_list>
 #include <type_traits>
@@ -117,6 +118,58 @@ class mdarray : public std::conditional_t <
         using base::base;
 };
 
+/**
+ * A grid of flags with one bit per element. Each column is a std::bitset, so a column's
+ * elements read and assign like bools, but a bubble-sized grid takes an eighth of the
+ * memory of an mdarray<bool> and a column fits in a few words.
+ */
+template<typename Point, size_t DimX = mdarray_default_size<Point>,
+         size_t DimY = mdarray_default_size<Point>>
+class mdbitset
+{
+    private:
+        static_assert( Point::dimension == 2, "mdbitset only for use with 2D point types" );
+        using Traits = point_traits<Point>;
+    public:
+        using column_type = std::bitset<DimY>;
+
+        static constexpr size_t size_x = DimX;
+        static constexpr size_t size_y = DimY;
+
+        mdbitset() = default;
+        explicit mdbitset( bool value ) {
+            fill( value );
+        }
+
+        column_type &operator[]( size_t x ) {
+            return data_[x];
+        }
+
+        const column_type &operator[]( size_t x ) const {
+            return data_[x];
+        }
+
+        typename column_type::reference operator[]( const Point &p ) {
+            return data_[Traits::x( p )][Traits::y( p )];
+        }
+
+        bool operator[]( const Point &p ) const {
+            return data_[Traits::x( p )][Traits::y( p )];
+        }
+
+        void fill( bool value ) {
+            for( column_type &col : data_ ) {
+                if( value ) {
+                    col.set();
+                } else {
+                    col.reset();
+                }
+            }
+        }
+    private:
+        std::array<column_type, DimX> data_;
+};
+
 } // namespace cata
 
 #endif // CATA_SRC_MDARRAY_H
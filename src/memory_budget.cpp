@@ -0,0 +1,119 @@
+#include "memory_budget.h"
+
+#include <fstream>
+
+#include "cata_allocator.h"
+#include "game.h"
+#include "llm_intent.h"
+#include "map_scale_constants.h"
+#include "mapbuffer.h"
+#include "messages.h"
+#include "options.h"
+#include "translations.h"
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace memory_budget
+{
+
+namespace
+{
+
+const option_handle<bool> option_low_memory_profile( "LOW_MEMORY_PROFILE" );
+const option_handle<int> option_memory_budget_mb( "MEMORY_BUDGET_MB" );
+
+constexpr size_t bubble_submaps = static_cast<size_t>( MAPSIZE ) * MAPSIZE * OVERMAP_LAYERS;
+// The low-memory profile sheds once the map buffer holds this many bubbles besides its own.
+constexpr size_t spare_bubbles = 3;
+
+struct monitor_state {
+    // Resident bytes right after the last shed that left the process over budget.
+    size_t shed_at = 0;
+    bool warned = false;
+    // Map buffer size right after the last low-memory shed, 0 once it was back under the mark.
+    size_t submaps_after_shed = 0;
+};
+
+monitor_state &state()
+{
+    static monitor_state instance;
+    return instance;
+}
+
+} // namespace
+
+bool low_memory_profile()
+{
+    return option_low_memory_profile.get();
+}
+
+size_t budget_bytes()
+{
+    return static_cast<size_t>( option_memory_budget_mb.get() ) * 1024 * 1024;
+}
+
+size_t resident_bytes()
+{
+#if defined(__linux__)
+    // Total and resident pages.
+    std::ifstream statm( "/proc/self/statm" );
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if( statm >> total_pages >> resident_pages ) {
+        return resident_pages * static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+    }
+#endif
+    const cata::allocator_stats allocator = cata::get_allocator_stats();
+    return allocator.available ? allocator.current_bytes : 0;
+}
+
+bool check()
+{
+    monitor_state &st = state();
+    const size_t budget = budget_bytes();
+    if( budget > 0 ) {
+        const size_t resident = resident_bytes();
+        if( resident <= budget ) {
+            st.shed_at = 0;
+            // Freed memory isn't always handed back to the system, so once shedding couldn't get
+            // the process under budget it only sheds again after growing by a tenth of it.
+        } else if( resident > st.shed_at + budget / 10 ) {
+            shed();
+            st.shed_at = resident_bytes();
+            if( st.shed_at > budget && !st.warned ) {
+                add_msg( m_bad, _( "The game holds %d MiB, more than its memory budget of %d MiB." ),
+                         st.shed_at / ( 1024 * 1024 ), budget / ( 1024 * 1024 ) );
+                st.warned = true;
+            }
+            return true;
+        }
+    }
+    if( !low_memory_profile() ) {
+        return false;
+    }
+    const size_t mark = bubble_submaps * ( spare_bubbles + 1 );
+    if( MAPBUFFER.size() <= mark ) {
+        st.submaps_after_shed = 0;
+        return false;
+    }
+    // Saving had nothing to drop, for example because the game was just saved. Wait until
+    // there is at least a bubble's worth more before trying again.
+    if( st.submaps_after_shed > 0 && MAPBUFFER.size() <= st.submaps_after_shed + bubble_submaps ) {
+        return false;
+    }
+    shed();
+    st.submaps_after_shed = MAPBUFFER.size();
+    return true;
+}
+
+void shed()
+{
+    llm_intent::clear_caches();
+    // The submaps can't be dropped without saving the rest of the game with them, or a crash
+    // afterwards would leave the world and the character out of step.
+    g->quicksave();
+}
+
+} // namespace memory_budget
@@ -0,0 +1,44 @@
+#pragma once
+#ifndef CATA_SRC_MEMORY_BUDGET_H
+#define CATA_SRC_MEMORY_BUDGET_H
+
+#include <cstddef>
+
+/**
+ * Keeps the game within the memory of small machines. The low-memory profile shrinks the
+ * caches that grow with play and writes out submaps far from the player early, the budget
+ * monitor notices when the process comes close to MEMORY_BUDGET_MB and sheds what can be
+ * rebuilt before the OS runs out and kills it.
+ */
+namespace memory_budget
+{
+
+/** Whether the LOW_MEMORY_PROFILE option is on. */
+bool low_memory_profile();
+/** The largest ACTIVE_Z_RANGE the low-memory profile allows, it also stands in for 0. */
+constexpr int low_memory_z_range = 1;
+/** The budget in bytes, 0 if there is none. */
+size_t budget_bytes();
+/**
+ * Memory the process holds: the resident set where the system tells it, otherwise what
+ * the allocator holds from the system, 0 if neither is known.
+ */
+size_t resident_bytes();
+
+/**
+ * Called by do_turn. Sheds when the process is over its budget, or in the low-memory
+ * profile when the map buffer holds several bubbles worth of submaps. After a shed the
+ * map buffer has to grow by another bubble first, so one that dropped nothing isn't
+ * repeated on every call.
+ * @returns whether it shed anything.
+ */
+bool check();
+/**
+ * Drops the LLM caches and saves the game, which writes out and drops the submaps and map
+ * memory far from the player.
+ */
+void shed();
+
+} // namespace memory_budget
+
+#endif // CATA_SRC_MEMORY_BUDGET_H
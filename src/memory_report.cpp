@@ -0,0 +1,129 @@
+#include "memory_report.h"
+
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_allocator.h"
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "creature_tracker.h"
+#include "flexbuffer_cache.h"
+#include "json.h"
+#include "llm_intent.h"
+#include "mapbuffer.h"
+#include "monster.h"
+#include "overmapbuffer.h"
+#include "string_formatter.h"
+#include "visitable.h"
+
+#if defined(TILES)
+#include "sdltiles.h"
+#endif
+
+namespace memory_report
+{
+
+namespace
+{
+
+std::vector<std::pair<std::string, usage>> largest_first( const report &rep )
+{
+    std::vector<std::pair<std::string, usage>> sorted( rep.entries().begin(), rep.entries().end() );
+    std::stable_sort( sorted.begin(), sorted.end(), []( const auto & lhs, const auto & rhs ) {
+        return lhs.second.bytes > rhs.second.bytes;
+    } );
+    return sorted;
+}
+
+} // namespace
+
+void report::add( const std::string &kind, size_t count, size_t bytes )
+{
+    usage &u = entries_[kind];
+    u.count += count;
+    u.bytes += bytes;
+}
+
+void report::add_items( const std::string &kind, const visitable &v )
+{
+    size_t count = 0;
+    v.visit_items( [&count]( const item *, const item * ) {
+        ++count;
+        return VisitResponse::NEXT;
+    } );
+    add( kind, count, count * sizeof( item ) );
+}
+
+size_t report::total_bytes() const
+{
+    size_t total = 0;
+    for( const std::pair<const std::string, usage> &entry : entries_ ) {
+        total += entry.second.bytes;
+    }
+    return total;
+}
+
+size_t heap_bytes( const std::string &str )
+{
+    static const size_t small_capacity = std::string().capacity();
+    return str.capacity() > small_capacity ? str.capacity() + 1 : 0;
+}
+
+report collect()
+{
+    report rep;
+    MAPBUFFER.add_memory_usage( rep );
+    overmap_buffer.add_memory_usage( rep );
+    get_avatar().add_memory_usage( rep );
+    const creature_tracker &creatures = get_creature_tracker();
+    rep.add( "monsters", creatures.size(), creatures.size() * sizeof( monster ) );
+    flexbuffer_cache::add_memory_usage( rep );
+    llm_intent::add_memory_usage( rep );
+#if defined(TILES)
+    add_tileset_memory_usage( rep );
+#endif
+    return rep;
+}
+
+std::string summary( const report &rep )
+{
+    std::string ret = string_format( "%d KiB in total\n", rep.total_bytes() / 1024 );
+    for( const std::pair<std::string, usage> &entry : largest_first( rep ) ) {
+        ret += string_format( "%s: %d, %d KiB\n", entry.first, entry.second.count,
+                              entry.second.bytes / 1024 );
+    }
+    return ret;
+}
+
+bool write( const report &rep, const cata_path &path )
+{
+    const cata::allocator_stats allocator = cata::get_allocator_stats();
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "turn", to_turns<int>( calendar::turn - calendar::turn_zero ) );
+        jsout.member( "total_bytes", rep.total_bytes() );
+        if( allocator.available ) {
+            jsout.member( "allocator_bytes", allocator.current_bytes );
+            jsout.member( "allocator_peak_bytes", allocator.peak_bytes );
+        }
+        jsout.member( "entries" );
+        jsout.start_array();
+        for( const std::pair<std::string, usage> &entry : largest_first( rep ) ) {
+            jsout.start_object();
+            jsout.member( "kind", entry.first );
+            jsout.member( "count", entry.second.count );
+            jsout.member( "bytes", entry.second.bytes );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, "memory report" );
+}
+
+} // namespace memory_report
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef CATA_SRC_MEMORY_REPORT_H
+#define CATA_SRC_MEMORY_REPORT_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+class cata_path;
+class visitable;
+
+/**
+ * Approximate memory use of the game's major containers, to find out which worlds grow too
+ * big for the machine and which subsystem is to blame. Each container adds its own
+ * entries through an add_memory_usage method, the sizes are estimates: the objects and the
+ * heap blocks they own are counted, allocator and container node overhead only roughly.
+ */
+namespace memory_report
+{
+
+struct usage {
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+class report
+{
+    public:
+        /** Adds @p count objects holding @p bytes to the entry called @p kind. */
+        void add( const std::string &kind, size_t count, size_t bytes );
+        /** Adds every item @p v holds, and @p v itself if it is an item, to @p kind. */
+        void add_items( const std::string &kind, const visitable &v );
+
+        const std::map<std::string, usage> &entries() const {
+            return entries_;
+        }
+        size_t total_bytes() const;
+
+    private:
+        std::map<std::string, usage> entries_;
+};
+
+/** Heap bytes held by the string, none when it fits in the small string buffer. */
+size_t heap_bytes( const std::string &str );
+
+/** Walks the containers of the loaded game. */
+report collect();
+/** One line per entry, largest first, for the debug menu. */
+std::string summary( const report &rep );
+/** Writes @p rep as JSON, returns false on failure. */
+bool write( const report &rep, const cata_path &path );
+
+} // namespace memory_report
+
+#endif // CATA_SRC_MEMORY_REPORT_H
@@ -6,6 +6,7 @@
 #include <deque>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <type_traits>
 #include <unordered_set>
@@ -651,17 +652,14 @@ void Messages::dialog::init( ui_adaptor &ui )
     filter.window( w_filter_help, point( border_width + 2, w_fh_height - 1 ),
                    w_fh_width - border_width - 2 );
 
-    // Initialize folded messages
+    // Initialize folded messages, do_filter() below picks which of them to show
     folded_all.clear();
-    folded_filtered.clear();
     const size_t msg_count = size();
     for( size_t ind = 0; ind < msg_count; ++ind ) {
         const size_t msg_ind = log_from_top ? ind : msg_count - 1 - ind;
         const game_message &msg = player_messages.history( msg_ind );
-        const auto &folded = foldstring( msg.get_with_count(), msg_width );
-        for( const auto &it : folded ) {
-            folded_filtered.emplace_back( folded_all.size() );
-            folded_all.emplace_back( msg_ind, it );
+        for( std::string &it : foldstring( msg.get_with_count(), msg_width ) ) {
+            folded_all.emplace_back( msg_ind, std::move( it ) );
         }
     }
 
@@ -790,16 +788,24 @@ void Messages::dialog::do_filter( const std::string &filter_str )
 
     // Start filtering the log
     folded_filtered.clear();
-    for( size_t folded_ind = 0; folded_ind < folded_all.size(); ) {
-        const size_t msg_ind = folded_all[folded_ind].first;
-        const game_message &msg = player_messages.history( msg_ind );
-        const bool match = ( !has_type_filter || filter_type == msg.type ) &&
-                           ci_find_substr( remove_color_tags( msg.get_with_count() ), filter_text ) >= 0;
-
-        // Always advance the index, but only add to filtered list if the original message matches
-        for( ; folded_ind < folded_all.size() && folded_all[folded_ind].first == msg_ind; ++folded_ind ) {
-            if( match ) {
-                folded_filtered.emplace_back( folded_ind );
+    if( filter_str.empty() ) {
+        // Everything matches, no need to strip and search every message
+        folded_filtered.resize( folded_all.size() );
+        std::iota( folded_filtered.begin(), folded_filtered.end(), size_t( 0 ) );
+    } else {
+        for( size_t folded_ind = 0; folded_ind < folded_all.size(); ) {
+            const size_t msg_ind = folded_all[folded_ind].first;
+            const game_message &msg = player_messages.history( msg_ind );
+            const bool match = ( !has_type_filter || filter_type == msg.type ) &&
+                               ci_find_substr( remove_color_tags( msg.get_with_count() ),
+                                               filter_text ) >= 0;
+
+            // Always advance the index, but only add to filtered list if the original message matches
+            for( ; folded_ind < folded_all.size() && folded_all[folded_ind].first == msg_ind;
+                 ++folded_ind ) {
+                if( match ) {
+                    folded_filtered.emplace_back( folded_ind );
+                }
             }
         }
     }
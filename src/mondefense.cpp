@@ -95,7 +95,7 @@ void mdefense::zapback( monster &m, Creature *const source,
 void mdefense::acidsplash( monster &m, Creature *const source,
                            dealt_projectile_attack const *const proj )
 {
-    const map &here = get_map();
+    map &here = get_map();
 
     if( source == nullptr ) {
         return;
@@ -139,9 +139,11 @@ void mdefense::acidsplash( monster &m, Creature *const source,
     prj.proj_effects.insert( ammo_effect_NO_DAMAGE_SCALING );
     prj.impact.add_damage( damage_acid, rng( 1, 3 ) );
     dealt_projectile_attack atk;
+    projectile_burst burst( here );
     for( size_t i = 0; i < num_drops; i++ ) {
         const tripoint_bub_ms &target = random_entry( pts );
-        projectile_attack( atk, prj, m.pos_bub( here ), target, dispersion_sources{ 1200 }, &m );
+        projectile_attack( atk, prj, &here, m.pos_bub( here ), target, dispersion_sources{ 1200 }, &m,
+                           nullptr, weakpoint_attack(), &burst );
     }
 
     if( get_player_view().sees( here, m.pos_bub( here ) ) ) {
@@ -26,6 +26,8 @@
 #include "field_type.h"
 #include "game.h"
 #include "item.h"
+#include "level_cache.h"
+#include "lightmap.h"
 #include "line.h"
 #include "map.h"
 #include "map_iterator.h"
@@ -102,6 +104,16 @@ static const ter_str_id ter_t_pit( "t_pit" );
 static const ter_str_id ter_t_pit_glass( "t_pit_glass" );
 static const ter_str_id ter_t_pit_spiked( "t_pit_spiked" );
 
+// Monsters this close to the player or an NPC run their full AI, see monster::ai_lod().
+static constexpr int MONSTER_LOD_FULL_RANGE = 2 * SEEX;
+// Up to this far they plan every MONSTER_LOD_PLAN_INTERVAL, beyond it they just idle.
+static constexpr int MONSTER_LOD_REDUCED_RANGE = 4 * SEEX;
+static constexpr time_duration MONSTER_LOD_PLAN_INTERVAL = 4_turns;
+// How long being hurt keeps a monster at full detail.
+static constexpr time_duration MONSTER_LOD_ALERT = 30_turns;
+
+static const option_handle<bool> option_log_monster_movement( "LOG_MONSTER_MOVEMENT" );
+
 bool monster::is_immune_field( const field_type_id &fid ) const
 {
     if( fid == fd_fungal_haze ) {
@@ -509,6 +521,7 @@ bool monster::mating_angry() const
 
 void monster::plan()
 {
+    last_plan = calendar::turn;
     monster_plan mon_plan( *this );
 
     map &here = get_map();
@@ -540,7 +553,13 @@ void monster::plan()
         }
         anger_cub_threatened( mon_plan );
     } else if( friendly != 0 && !mon_plan.docile ) {
-        for( monster &tmp : g->all_monsters() ) {
+        // Nothing past sight range can be rated as a target.
+        for( Creature *nearby : get_creature_tracker().creatures_in_radius( pos_abs(),
+                MAX_VIEW_DISTANCE, fov_3d_z_range ) ) {
+            if( !nearby->is_monster() ) {
+                continue;
+            }
+            monster &tmp = *nearby->as_monster();
             if( tmp.friendly == 0 && tmp.attitude_to( *this ) == Attitude::HOSTILE &&
                 seen_levels.test( tmp.posz() + OVERMAP_DEPTH ) ) {
                 float rating = rate_target( tmp, mon_plan.dist, mon_plan.smart_planning );
@@ -857,6 +876,65 @@ bool monster::die_if_drowning( const tripoint_bub_ms &at_pos, const int chance )
 // 2) Sight-based tracking
 // 3) Scent-based tracking
 // 4) Sound-based tracking
+monster_lod monster::ai_lod() const
+{
+    // Anything with a goal, a sound to follow, an owner or a reason to be upset gets it all.
+    if( friendly != 0 || is_hallucination() || !is_wandering() || wandf > 0 ||
+        calendar::turn - lod_disturbed < MONSTER_LOD_ALERT || has_effect( effect_dragging ) ||
+        has_effect( effect_operating ) ) {
+        return monster_lod::full;
+    }
+    const map &here = get_map();
+    const Character &player_character = get_player_character();
+    const tripoint_bub_ms pos = pos_bub( here );
+    // The player's field of view doubles as the monster's sight lines to the player.
+    if( posz() == player_character.posz() && here.inbounds( pos ) &&
+        here.get_cache_ref( posz() ).seen_cache[pos.x()][pos.y()] > LIGHT_TRANSPARENCY_SOLID ) {
+        return monster_lod::full;
+    }
+    int dist = rl_dist( pos_abs(), player_character.pos_abs() );
+    for( const npc &guy : g->all_npcs() ) {
+        dist = std::min( dist, rl_dist( pos_abs(), guy.pos_abs() ) );
+    }
+    if( dist <= MONSTER_LOD_FULL_RANGE ) {
+        return monster_lod::full;
+    }
+    return dist <= MONSTER_LOD_REDUCED_RANGE ? monster_lod::reduced : monster_lod::coarse;
+}
+
+bool monster::lod_plan_due( monster_lod lod ) const
+{
+    switch( lod ) {
+        case monster_lod::full:
+            return true;
+        case monster_lod::reduced:
+            return calendar::turn - last_plan >= MONSTER_LOD_PLAN_INTERVAL;
+        case monster_lod::coarse:
+            break;
+    }
+    return false;
+}
+
+void monster::lod_disturb()
+{
+    lod_disturbed = calendar::turn;
+}
+
+void monster::coarse_move()
+{
+    moves = 0;
+    gravity_check();
+    if( is_dead() || die_if_drowning( pos_bub(), 10 ) ) {
+        return;
+    }
+    if( has_flag( mon_flag_IMMOBILE ) || has_flag( mon_flag_RIDEABLE_MECH ) ||
+        has_flag( json_flag_CANNOT_MOVE ) || has_effect( effect_immobilization ) ) {
+        return;
+    }
+    // An idle monster without plans does the same at the end of move().
+    stumble_voluntary();
+}
+
 void monster::move()
 {
     map &here = get_map();
@@ -919,6 +997,11 @@ void monster::move()
             // Cooldowns are decremented in monster::process_turn
 
             if( local_attack_data.cooldown == 0 && !pacified && !is_hallucination() ) {
+                // Skip the full attack logic when it has no one to act on.
+                if( !sp_type.second->may_fire( *this ) ) {
+                    add_msg_debug( debugmode::DF_MATTACK, "Attack preconditions not met" );
+                    continue;
+                }
                 if( !sp_type.second->call( *this ) ) {
                     add_msg_debug( debugmode::DF_MATTACK, "Attack failed" );
                     continue;
@@ -2051,7 +2134,7 @@ bool monster::move_to( const tripoint_bub_ms &p, bool force, bool step_on_critte
         ) && ( here.is_divable( destination ) ||
                here.has_flag( ter_furn_flag::TFLAG_SWIM_UNDER, destination ) );
 
-    if( get_option<bool>( "LOG_MONSTER_MOVEMENT" ) ) {
+    if( option_log_monster_movement.get() ) {
         //Birds and other flying creatures flying over the deep water terrain
         if( was_water && flies() ) {
             if( one_in( 4 ) ) {
@@ -2416,6 +2416,7 @@ void monster::apply_damage( Creature *source, bodypart_id /*bp*/, int dam,
     }
     // Ensure we can try to get at what hit us.
     reset_pathfinding_cd();
+    lod_disturb();
     hp -= dam;
 
     cata::event e = cata::event::make<event_type::monster_takes_damage>( dam, hp < 1 );
@@ -3427,17 +3428,20 @@ void monster::process_one_effect( effect &it, bool is_new )
         return it.get_mod( arg, reduced );
     };
 
-    mod_speed_bonus( get_effect( "SPEED", reduced ) );
-    mod_dodge_bonus( get_effect( "DODGE", reduced ) );
-    mod_hit_bonus( get_effect( "HIT", reduced ) );
-    mod_bash_bonus( get_effect( "BASH", reduced ) );
-    mod_cut_bonus( get_effect( "CUT", reduced ) );
-    mod_size_bonus( get_effect( "SIZE", reduced ) );
-
-    int val = get_effect( "HURT", reduced );
-    if( val > 0 ) {
-        if( is_new || it.activated( calendar::turn, "HURT", val, reduced, 1 ) ) {
-            apply_damage( it.get_source().resolve_creature(), bodypart_id( "torso" ), val );
+    // Without any modifier they are all 0.
+    if( it.get_effect_type()->has_mod_data() ) {
+        mod_speed_bonus( get_effect( "SPEED", reduced ) );
+        mod_dodge_bonus( get_effect( "DODGE", reduced ) );
+        mod_hit_bonus( get_effect( "HIT", reduced ) );
+        mod_bash_bonus( get_effect( "BASH", reduced ) );
+        mod_cut_bonus( get_effect( "CUT", reduced ) );
+        mod_size_bonus( get_effect( "SIZE", reduced ) );
+
+        int val = get_effect( "HURT", reduced );
+        if( val > 0 ) {
+            if( is_new || it.activated( calendar::turn, "HURT", val, reduced, 1 ) ) {
+                apply_damage( it.get_source().resolve_creature(), bodypart_id( "torso" ), val );
+            }
         }
     }
 
@@ -3496,6 +3500,14 @@ void monster::process_one_effect( effect &it, bool is_new )
         }
     }
 
+    // Once per turn in process_effects, rather than once per effect.
+    if( is_new ) {
+        refresh_effect_enchantments();
+    }
+}
+
+void monster::refresh_effect_enchantments()
+{
     //Process enchantments that apply to monsters.
     enchantment_cache->clear();
 
@@ -3522,6 +3534,9 @@ void monster::process_effects()
             process_one_effect( _effect_it.second, false );
         }
     }
+    if( !effects->empty() ) {
+        refresh_effect_enchantments();
+    }
 
     // Like with player/NPCs - keep the speed above 0
     const int min_speed_bonus = -0.75 * get_speed_base();
@@ -77,6 +77,13 @@ enum monster_horde_attraction {
     NUM_MONSTER_HORDE_ATTRACTION
 };
 
+// How much of the AI monmove() runs for a monster, see monster::ai_lod().
+enum class monster_lod : int {
+    full = 0,   // plan() on every move
+    reduced,    // plan() every few turns, moves as usual
+    coarse,     // idles about, no plan(), special attacks or pathfinding
+};
+
 class monster : public Creature
 {
         friend class editmap_ui;
@@ -268,6 +275,13 @@ class monster : public Creature
         // will change mon_plan::dist
         void anger_cub_threatened( monster_plan &mon_plan );
         void move(); // Actual movement
+        monster_lod ai_lod() const;
+        // Whether plan() should run this move at the given level of detail
+        bool lod_plan_due( monster_lod lod ) const;
+        // Keeps the monster at full level of detail for a while, e.g. after being hurt
+        void lod_disturb();
+        // A coarse LOD move: spend the turn idling as an undisturbed monster would
+        void coarse_move();
         void footsteps( const tripoint_bub_ms &p ); // noise made by movement
         void shove_vehicle( const tripoint_bub_ms &remote_destination,
                             const tripoint_bub_ms &nearby_destination ); // shove vehicles out of the way
@@ -668,6 +682,9 @@ class monster : public Creature
 
         std::bitset<NUM_MEFF> effect_cache;
         int turns_since_target = 0;
+        // Turn of the last plan(), and of the last disturbance, for ai_lod()
+        time_point last_plan = calendar::before_time_starts; // NOLINT(cata-serialize)
+        time_point lod_disturbed = calendar::before_time_starts; // NOLINT(cata-serialize)
 
         Character *find_dragged_foe();
         void nursebot_operate( Character *dragged_foe );
@@ -680,6 +697,8 @@ class monster : public Creature
         void on_move( const tripoint_abs_ms &old_pos ) override;
         /** Processes monster-specific effects of an effect. */
         void process_one_effect( effect &it, bool is_new ) override;
+        /** Rebuilds the enchantments effects give and the speed bonus they leave. */
+        void refresh_effect_enchantments();
 };
 
 #endif // CATA_SRC_MONSTER_H
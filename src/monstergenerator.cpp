@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <limits>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -14,6 +15,7 @@
 #include "color.h"
 #include "condition.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "damage.h"
 #include "debug.h"
 #include "enums.h"
@@ -23,6 +25,7 @@
 #include "generic_factory.h"
 #include "item.h"
 #include "item_group.h"
+#include "line.h"
 #include "magic.h"
 #include "mattack_actors.h"
 #include "monattack.h"
@@ -1249,6 +1252,18 @@ mtype_id MonsterGenerator::get_valid_hallucination() const
     return random_entry( hallucination_monsters );
 }
 
+// Hardcoded attacks that give up before doing anything when monster::attack_target()
+// finds nobody, so they can be skipped without a creature on the monster's destination.
+static bool needs_target_at_dest( const mattack_id &id )
+{
+    static const std::set<mattack_id> target_gated = {
+        "ACID", "ACID_BARF", "COPBOT", "EVOLVE_KILL_STRIKE", "FLESH_GOLEM", "LUNGE",
+        "RIOTBOT", "SHOCKSTORM", "SHRIEK", "SHRIEK_ALERT", "SHRIEK_STUN", "SMASH",
+        "SPIT_SAP", "SUICIDE", "TAZER"
+    };
+    return target_gated.count( id ) != 0;
+}
+
 class mattack_hardcoded_wrapper : public mattack_actor
 {
     private:
@@ -1262,6 +1277,9 @@ class mattack_hardcoded_wrapper : public mattack_actor
         bool call( monster &m ) const override {
             return cpp_function( &m );
         }
+        bool may_fire( const monster &m ) const override {
+            return !needs_target_at_dest( id ) || target_at_dest( m, std::numeric_limits<int>::max() );
+        }
         std::unique_ptr<mattack_actor> clone() const override {
             return std::make_unique<mattack_hardcoded_wrapper>( *this );
         }
@@ -1341,6 +1359,19 @@ mtype_special_attack MonsterGenerator::create_actor( const JsonObject &obj,
     return mtype_special_attack( std::move( new_attack ) );
 }
 
+bool mattack_actor::target_at_dest( const monster &z, int range )
+{
+    if( !z.has_dest() ) {
+        return false;
+    }
+    const tripoint_abs_ms dest = z.get_dest();
+    if( rl_dist( z.pos_abs(), dest ) > range ) {
+        return false;
+    }
+    const Creature *target = get_creature_tracker().creature_at( dest );
+    return target != nullptr && target != &z;
+}
+
 void mattack_actor::load( const JsonObject &jo, const std::string &src )
 {
     if( jo.has_string( "id" ) ) {
@@ -408,6 +408,11 @@ void input_manager::pump_events()
     previously_pressed_key = 0;
 }
 
+bool input_manager::has_pending_key_input() const
+{
+    return false;
+}
+
 // there isn't a portable way to get raw key code on curses,
 // ignoring preferred keyboard mode
 input_event input_manager::get_input_event( const keyboard_mode /*preferred_keyboard_mode*/ )
@@ -355,6 +355,13 @@ npc::llm_intent_state &npc::llm_intent_state_for( const npc &guy )
     return llm_intent_state_map()[guy.getID()];
 }
 
+const npc::llm_intent_state *npc::find_llm_intent_state( const npc &guy )
+{
+    const std::map<character_id, llm_intent_state> &states = llm_intent_state_map();
+    const auto found = states.find( guy.getID() );
+    return found == states.end() ? nullptr : &found->second;
+}
+
 void npc::begin_llm_action( llm_action_kind kind,
                             const std::string &target_hint,
                             const std::string &target_name,
@@ -444,6 +451,9 @@ void npc::finish_llm_action( llm_action_phase terminal_phase,
 
 void npc::clear_llm_action_status() const
 {
+    if( find_llm_intent_state( *this ) == nullptr ) {
+        return;
+    }
     llm_intent_state &state = llm_intent_state_for( *this );
     state.active_status = llm_action_status{};
     state.recent_statuses.clear();
@@ -452,8 +462,8 @@ void npc::clear_llm_action_status() const
 
 bool npc::has_active_llm_action_status() const
 {
-    const llm_intent_state &state = llm_intent_state_for( *this );
-    return state.active_status.kind != llm_action_kind::none;
+    const llm_intent_state *state = find_llm_intent_state( *this );
+    return state != nullptr && state->active_status.kind != llm_action_kind::none;
 }
 
 std::string npc::llm_action_bark_for_reason( const std::string &reason_code )
@@ -2184,6 +2194,7 @@ void npc::on_attacked( const Creature &attacker )
     map &here = get_map();
 
     hallucination_die( &here, nullptr );
+    request_replan();
 
     if( attacker.is_avatar() && !is_enemy() && !is_dead() && !guaranteed_hostile() ) {
         make_angry();
@@ -2893,6 +2904,10 @@ void npc::clear_llm_intent_actions()
     if( has_active_llm_action_status() ) {
         finish_llm_action( llm_action_phase::cancelled, "intent.cleared" );
     }
+    goto_to_this_pos = std::nullopt;
+    if( find_llm_intent_state( *this ) == nullptr ) {
+        return;
+    }
     llm_intent_state &state = llm_intent_state_for( *this );
     state.queue.clear();
     state.active = llm_intent_action::none;
@@ -2910,7 +2925,6 @@ void npc::clear_llm_intent_actions()
     state.legend_targets_by_request.clear();
     state.move_arrival_state = llm_intent_action::none;
     state.hold_position_active = false;
-    goto_to_this_pos = std::nullopt;
     state.look_around_targets.clear();
     state.look_around_active_target = npc::llm_item_target{};
 }
@@ -2966,8 +2980,8 @@ void npc::add_llm_intent_memory( const std::string &player_utterance,
     llm_intent_state &state = llm_intent_state_for( *this );
     llm_intent_memory_entry entry;
     entry.turn = calendar::turn;
-    entry.player_utterance = player_utterance;
-    entry.npc_response = npc_response;
+    entry.player_utterance = clip_llm_memory_text( player_utterance );
+    entry.npc_response = clip_llm_memory_text( npc_response );
     entry.actions = actions;
     state.conversation_memory.push_back( std::move( entry ) );
     const size_t max_entries = actions.empty() ? 5 : 2;
@@ -2978,9 +2992,12 @@ void npc::add_llm_intent_memory( const std::string &player_utterance,
 
 std::vector<npc::llm_intent_memory_entry> npc::get_llm_intent_memory() const
 {
-    const llm_intent_state &state = llm_intent_state_for( *this );
-    return std::vector<llm_intent_memory_entry>( state.conversation_memory.begin(),
-            state.conversation_memory.end() );
+    const llm_intent_state *state = find_llm_intent_state( *this );
+    if( state == nullptr ) {
+        return {};
+    }
+    return std::vector<llm_intent_memory_entry>( state->conversation_memory.begin(),
+            state->conversation_memory.end() );
 }
 
 void npc::add_llm_overheard_memory( const std::string &npc_name,
@@ -2990,24 +3007,51 @@ void npc::add_llm_overheard_memory( const std::string &npc_name,
     if( npc_name.empty() && npc_response.empty() && actions.empty() ) {
         return;
     }
+    auto entry = std::make_shared<llm_overheard_memory_entry>();
+    entry->turn = calendar::turn;
+    entry->npc_name = npc_name;
+    entry->npc_response = clip_llm_memory_text( npc_response );
+    entry->actions = actions;
+    add_llm_overheard_memory( entry );
+}
+
+void npc::add_llm_overheard_memory( const std::shared_ptr<const llm_overheard_memory_entry> &entry )
+const
+{
+    if( !entry ) {
+        return;
+    }
     llm_intent_state &state = llm_intent_state_for( *this );
-    llm_overheard_memory_entry entry;
-    entry.turn = calendar::turn;
-    entry.npc_name = npc_name;
-    entry.npc_response = npc_response;
-    entry.actions = actions;
-    state.overheard_memory.push_back( std::move( entry ) );
-    const size_t max_entries = actions.empty() ? 4 : 2;
+    const size_t max_entries = entry->actions.empty() ? 4 : 2;
+    state.overheard_memory.push_back( entry );
     while( state.overheard_memory.size() > max_entries ) {
         state.overheard_memory.pop_front();
     }
 }
 
-std::vector<npc::llm_overheard_memory_entry> npc::get_llm_overheard_memory() const
+std::string npc::clip_llm_memory_text( const std::string &text )
+{
+    static constexpr size_t llm_memory_text_limit = 320;
+    if( text.size() <= llm_memory_text_limit ) {
+        return text;
+    }
+    // Counted in bytes, so never cut a character in half.
+    size_t end = llm_memory_text_limit;
+    while( end > 0 && ( static_cast<unsigned char>( text[end] ) & 0xC0 ) == 0x80 ) {
+        --end;
+    }
+    return text.substr( 0, end ) + "...";
+}
+
+std::vector<std::shared_ptr<const npc::llm_overheard_memory_entry>>
+        npc::get_llm_overheard_memory() const
 {
-    const llm_intent_state &state = llm_intent_state_for( *this );
-    return std::vector<llm_overheard_memory_entry>( state.overheard_memory.begin(),
-            state.overheard_memory.end() );
+    const llm_intent_state *state = find_llm_intent_state( *this );
+    if( state == nullptr ) {
+        return {};
+    }
+    return std::vector<std::shared_ptr<const llm_overheard_memory_entry>>(
+               state->overheard_memory.begin(), state->overheard_memory.end() );
 }
 
 void npc::schedule_next_llm_random_call( int base_turns ) const
@@ -3040,8 +3084,8 @@ bool npc::llm_random_call_due( int base_turns ) const
 
 bool npc::has_llm_intent_actions() const
 {
-    llm_intent_state &state = llm_intent_state_for( *this );
-    return state.active != llm_intent_action::none || !state.queue.empty();
+    const llm_intent_state *state = find_llm_intent_state( *this );
+    return state != nullptr && ( state->active != llm_intent_action::none || !state->queue.empty() );
 }
 
 bool npc::is_friendly( const Character &p ) const
@@ -3117,9 +3161,9 @@ bool npc::is_travelling() const
 Creature::Attitude npc::attitude_to( const Creature &other ) const
 {
     if( get_option<bool>( "LLM_INTENT_ENABLE" ) ) {
-        const llm_intent_state &state = llm_intent_state_for( *this );
-        if( state.target_attacks_remaining > 0 && state.target_turns_remaining > 0 &&
-            !state.target_hint.empty() ) {
+        const llm_intent_state *state = find_llm_intent_state( *this );
+        if( state != nullptr && state->target_attacks_remaining > 0 &&
+            state->target_turns_remaining > 0 && !state->target_hint.empty() ) {
             const Creature *forced = current_target();
             if( forced != nullptr && forced == &other ) {
                 return Creature::Attitude::HOSTILE;
@@ -3766,6 +3810,41 @@ void npc::on_unload()
 {
 }
 
+void npc::hibernate()
+{
+    if( hibernating ) {
+        return;
+    }
+    hibernating = true;
+    request_replan();
+    path = std::vector<tripoint_bub_ms>();
+    ai_cache.target.reset();
+    ai_cache.ally.reset();
+    ai_cache.current_attack.reset();
+    ai_cache.sound_alerts = std::vector<dangerous_sound>();
+    ai_cache.hostile_guys = std::vector<weak_ptr_fast<Creature>>();
+    ai_cache.neutral_guys = std::vector<weak_ptr_fast<Creature>>();
+    ai_cache.friends = std::vector<weak_ptr_fast<Creature>>();
+    ai_cache.dangerous_explosives = std::vector<sphere>();
+    ai_cache.threat_map.clear();
+    ai_cache.searched_tiles.clear();
+    shed_caches();
+}
+
+void npc::wake()
+{
+    if( !hibernating ) {
+        return;
+    }
+    hibernating = false;
+    request_replan();
+}
+
+bool npc::is_hibernating() const
+{
+    return hibernating;
+}
+
 // A throtled version of player::update_body since npc's don't need to-the-turn updates.
 void npc::npc_update_body()
 {
@@ -3777,6 +3856,7 @@ void npc::npc_update_body()
 
 void npc::on_load( map *here )
 {
+    wake();
     const auto advance_effects = [&]( const time_duration & elapsed_dur ) {
         for( auto &elem : *effects ) {
             for( auto &_effect_it : elem.second ) {
@@ -3807,7 +3887,9 @@ void npc::on_load( map *here )
     last_updated = calendar::turn;
     time_point cur = calendar::turn - dt;
     add_msg_debug( debugmode::DF_NPC, "on_load() by %s, %d turns", get_name(), to_turns<int>( dt ) );
-    // First update with 30 minute granularity, then 5 minutes, then turns
+    // First update with 30 minute granularity, then 5 minutes, then minutes, then turns.
+    // update_body takes care of needs, vitamins and healing over a whole step at once, only
+    // effects take turns to interact, so only the last minute goes turn by turn.
     for( ; cur < calendar::turn - 30_minutes; cur += 30_minutes + 1_turns ) {
         update_body( cur, cur + 30_minutes );
         advance_effects( 30_minutes );
@@ -3818,6 +3900,11 @@ void npc::on_load( map *here )
         advance_effects( 5_minutes );
         advance_focus( 5 );
     }
+    for( ; cur < calendar::turn - 1_minutes; cur += 1_minutes + 1_turns ) {
+        update_body( cur, cur + 1_minutes );
+        advance_effects( 1_minutes );
+        update_mental_focus();
+    }
     for( ; cur < calendar::turn; cur += 1_turns ) {
         update_body( cur, cur + 1_turns );
         process_effects();
@@ -3894,9 +3981,10 @@ void npc::process_turn()
     Character::process_turn();
 
     if( get_option<bool>( "LLM_INTENT_ENABLE" ) ) {
-        llm_intent_state &state = llm_intent_state_for( *this );
-        if( state.active == llm_intent_action::none &&
-            state.last_applied_turn != calendar::turn && !state.queue.empty() ) {
+        const llm_intent_state *found = find_llm_intent_state( *this );
+        if( found != nullptr && found->active == llm_intent_action::none &&
+            found->last_applied_turn != calendar::turn && !found->queue.empty() ) {
+            llm_intent_state &state = llm_intent_state_for( *this );
             state.active = state.queue.front();
             state.active_turn = calendar::turn;
         }
@@ -4271,6 +4359,7 @@ void npc::set_attitude( npc_attitude new_attitude )
         return;
     }
     previous_attitude = attitude;
+    request_replan();
     if( new_attitude == NPCATT_FLEE ) {
         new_attitude = NPCATT_FLEE_TEMP;
     }
@@ -24,11 +24,11 @@
 #include "compatibility.h"
 #include "coordinates.h"
 #include "dialogue_chatbin.h"
+#include "flat_lru_cache.h"
 #include "inventory.h"
 #include "item.h"
 #include "item_location.h"
 #include "line.h"
-#include "lru_cache.h"
 #include "map_scale_constants.h"
 #include "memory_fast.h"
 #include "mission_companion.h"
@@ -525,6 +525,13 @@ struct healing_options {
 };
 
 // Data relevant only for this action
+// How often npc::move() re-runs the full AI pipeline for an NPC, see npc::ai_priority().
+enum class npc_ai_priority : int {
+    combat = 0,     // re-plans on every move
+    near_player,    // re-plans on every move while the per-turn budget lasts
+    background,     // idle camp workers and other distant NPCs, re-plans every few turns
+};
+
 struct npc_short_term_cache {
     float danger = 0.0f;
     float total_danger = 0.0f;
@@ -555,8 +562,12 @@ struct npc_short_term_cache {
     std::vector<weak_ptr_fast<Creature>> friends;
     std::vector<sphere> dangerous_explosives;
     std::map<direction, float> threat_map;
+    // Turn of the last full re-plan in npc::move(), see npc::take_replan_slot()
+    time_point last_replan = calendar::before_time_starts;
+    // Something happened that the cached plan can't have accounted for
+    bool replan_requested = true;
     // Cache of locations the NPC has searched recently in npc::find_item()
-    lru_cache<tripoint_abs_ms, int> searched_tiles;
+    flat_lru_cache<tripoint_abs_ms, int> searched_tiles{ 1000, "npc_searched_tiles" };
     // returns the value of the distance between a friendly creature and the closest enemy to that
     // friendly creature.
     // returns nullopt if not applicable
@@ -1004,7 +1015,12 @@ class npc : public Character
         void add_llm_overheard_memory( const std::string &npc_name,
                                        const std::string &npc_response,
                                        const std::vector<std::string> &actions ) const;
-        std::vector<llm_overheard_memory_entry> get_llm_overheard_memory() const;
+        /** Same as above, for an utterance every listener shares rather than copies. */
+        void add_llm_overheard_memory( const std::shared_ptr<const llm_overheard_memory_entry> &entry )
+        const;
+        std::vector<std::shared_ptr<const llm_overheard_memory_entry>> get_llm_overheard_memory() const;
+        /** Speech as a memory keeps it: cut to a few hundred bytes, so prompts stay bounded. */
+        static std::string clip_llm_memory_text( const std::string &text );
         bool llm_random_call_due( int base_turns ) const;
         void schedule_next_llm_random_call( int base_turns ) const;
         // Isn't moving
@@ -1086,6 +1102,11 @@ class npc : public Character
 
         // AI helpers
         void regen_ai_cache();
+        npc_ai_priority ai_priority() const;
+        // Makes the next move() re-plan in full, whatever the priority
+        void request_replan();
+        // Whether this move() should re-plan in full, uses up the per-turn budget if so
+        bool take_replan_slot();
         const Creature *current_target() const;
         Creature *current_target();
         const Creature *current_ally() const;
@@ -1449,12 +1470,14 @@ class npc : public Character
             std::deque<llm_action_status> recent_statuses;
             int next_action_serial = 1;
             std::deque<llm_intent_memory_entry> conversation_memory;
-            std::deque<llm_overheard_memory_entry> overheard_memory;
+            std::deque<std::shared_ptr<const llm_overheard_memory_entry>> overheard_memory;
             time_point random_call_next_turn = calendar::before_time_starts;
             int random_call_base_turns = 0;
         };
         static std::map<character_id, llm_intent_state> &llm_intent_state_map();
         static llm_intent_state &llm_intent_state_for( const npc &guy );
+        /** The state of @p guy, or nullptr if it has none. Unlike the above, never adds one. */
+        static const llm_intent_state *find_llm_intent_state( const npc &guy );
         void apply_llm_intent_target();
         bool apply_llm_intent_item_targets();
 
@@ -1546,6 +1569,15 @@ class npc : public Character
          * Retroactively update npc.
          */
         void on_load( map *here );
+        /**
+         * Drop what the NPC only needs in the reality bubble: AI caches, the tile path and the
+         * Character caches. Everything dropped is rebuilt on demand, so a hibernating NPC can
+         * still be travelled, traded with over the radio or sent on camp missions.
+         */
+        void hibernate();
+        /** Counterpart of hibernate(), the next move() re-plans from scratch. */
+        void wake();
+        bool is_hibernating() const;
         /**
          * Update body, but throttled.
          */
@@ -1589,6 +1621,10 @@ class npc : public Character
         bool dead = false;  // If true, we need to be cleaned up
         // Temporary variable for preventing from death (used by EoC event)
         bool prevent_death_reminder = false; // NOLINT(cata-serialize)
+    private:
+        // Set by hibernate() while the NPC is outside the reality bubble
+        bool hibernating = false; // NOLINT(cata-serialize)
+    public:
 
         bool sees_dangerous_field( const tripoint_bub_ms &p ) const;
         bool could_move_onto( const tripoint_bub_ms &p ) const;
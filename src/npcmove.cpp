@@ -50,6 +50,7 @@
 #include "field.h"
 #include "field_type.h"
 #include "flag.h"
+#include "flat_lru_cache.h"
 #include "flat_set.h"  // IWYU pragma: keep // iwyu is being silly here
 #include "game.h"
 #include "game_constants.h"
@@ -59,13 +60,13 @@
 #include "item.h"
 #include "item_factory.h"
 #include "item_location.h"
+#include "item_pocket.h"
 #include "item_transformation.h"
 #include "itype.h"
 #include "iuse.h"
 #include "iuse_actor.h"
 #include "line.h"
 #include "llm_intent.h"
-#include "lru_cache.h"
 #include "magic.h"
 #include "map.h"
 #include "map_iterator.h"
@@ -87,6 +88,7 @@
 #include "overmap_location.h"
 #include "overmapbuffer.h"
 #include "pathfinding.h"
+#include "perf.h"
 #include "pimpl.h"
 #include "player_activity.h"
 #include "point.h"
@@ -215,6 +217,18 @@ static constexpr int NPC_HUNGER_CONSUME =
 static constexpr int NPC_HUNGER_COMPLAIN =
     160; // The level at which we refuse to do some tasks.
 
+// Full re-plans per turn shared by every NPC outside combat, see npc::take_replan_slot().
+static constexpr int NPC_REPLAN_BUDGET = 8;
+// NPCs this close to the player re-plan on every move while the budget lasts.
+static constexpr int NPC_REPLAN_NEAR_PLAYER = 2 * SEEX;
+// A hostile creature this close drops any NPC into the combat tier.
+static constexpr int NPC_REPLAN_WAKE_RADIUS = 2 * SEEX;
+// Farthest npc::find_item looks, when the light lets them see that far.
+static constexpr int NPC_ITEM_SEARCH_RANGE = 12;
+
+static const option_handle<bool> option_llm_intent_enable( "LLM_INTENT_ENABLE" );
+static const option_handle<bool> option_debug_llm_intent_ui( "DEBUG_LLM_INTENT_UI" );
+
 enum npc_action : int {
   npc_undecided = 0,
   npc_pause,
@@ -812,6 +826,11 @@ float npc::evaluate_self(bool my_gun) {
 }
 
 float npc::estimate_armour(const Character &candidate) const {
+  // The rating only depends on what the candidate wears, so every NPC sizing
+  // them up this turn can share it. Wearing something new resets it early.
+  if (candidate.cached_armour_estimate_turn == calendar::turn) {
+    return candidate.cached_armour_estimate;
+  }
   float armour = 0.0f;
   int armour_step;
   int number_of_parts = 0;
@@ -841,8 +860,8 @@ float npc::estimate_armour(const Character &candidate) const {
       debugmode::DF_NPC_ITEMAI,
       "<color_light_gray>%s rates </color>%s total armour value: %1.2f.", name,
       candidate.disp_name(true), armour);
-  // this is a value we could easily cache.
-    // I don't know how to do that, I'm supposed to be a writer.
+  candidate.cached_armour_estimate = armour;
+  candidate.cached_armour_estimate_turn = calendar::turn;
   return armour;
 }
 
@@ -1591,6 +1610,94 @@ void npc::regen_ai_cache() {
   }
 }
 
+namespace {
+struct npc_replan_budget_state {
+    time_point turn = calendar::before_time_starts;
+    int used = 0;
+};
+
+npc_replan_budget_state &npc_replan_budget()
+{
+    static npc_replan_budget_state budget;
+    return budget;
+}
+
+// Turns between full re-plans, and the staleness at which the budget is ignored.
+std::pair<int, int> npc_replan_interval( npc_ai_priority priority )
+{
+    switch( priority ) {
+        case npc_ai_priority::combat:
+            return { 0, 0 };
+        case npc_ai_priority::near_player:
+            return { 0, 2 };
+        case npc_ai_priority::background:
+            break;
+    }
+    return { 5, 15 };
+}
+} // namespace
+
+npc_ai_priority npc::ai_priority() const
+{
+    if( ai_cache.replan_requested || ai_cache.danger > 0.0f || ai_cache.total_danger > 0.0f ||
+        !ai_cache.hostile_guys.empty() || !ai_cache.sound_alerts.empty() ||
+        !ai_cache.dangerous_explosives.empty() || current_target() != nullptr ||
+        mem_combat.panic > 0 || mem_combat.repositioning || mem_combat.reposition_countdown > 0 ||
+        has_effect( effect_npc_run_away ) || has_effect( effect_npc_fire_bad ) ||
+        is_enemy() || attitude == NPCATT_FLEE_TEMP ) {
+        return npc_ai_priority::combat;
+    }
+    const auto state = llm_intent_state_map().find( getID() );
+    if( state != llm_intent_state_map().end() &&
+        ( state->second.panic_forced_turns_remaining > 0 ||
+          state->second.calm_turns_remaining > 0 || state->second.target_turns_remaining > 0 ||
+          !state->second.queue.empty() || !state->second.look_around_targets.empty() ) ) {
+        return npc_ai_priority::combat;
+    }
+    // The cached plan can't know about anything that showed up since it was made.
+    for( Creature *critter : get_creature_tracker().creatures_in_radius( pos_abs(),
+            NPC_REPLAN_WAKE_RADIUS, 1 ) ) {
+        if( critter != this && critter->attitude_to( *this ) == Attitude::HOSTILE ) {
+            return npc_ai_priority::combat;
+        }
+    }
+    if( is_walking_with() ||
+        rl_dist( pos_abs(), get_player_character().pos_abs() ) <= NPC_REPLAN_NEAR_PLAYER ) {
+        return npc_ai_priority::near_player;
+    }
+    return npc_ai_priority::background;
+}
+
+void npc::request_replan()
+{
+    ai_cache.replan_requested = true;
+}
+
+bool npc::take_replan_slot()
+{
+    const npc_ai_priority priority = ai_priority();
+    bool replan = priority == npc_ai_priority::combat;
+    if( !replan ) {
+        const std::pair<int, int> interval = npc_replan_interval( priority );
+        const int since = to_turns<int>( calendar::turn - ai_cache.last_replan );
+        npc_replan_budget_state &budget = npc_replan_budget();
+        if( budget.turn != calendar::turn ) {
+            budget.turn = calendar::turn;
+            budget.used = 0;
+        }
+        replan = since >= interval.second ||
+                 ( since >= interval.first && budget.used < NPC_REPLAN_BUDGET );
+        if( replan ) {
+            budget.used++;
+        }
+    }
+    if( replan ) {
+        ai_cache.last_replan = calendar::turn;
+        ai_cache.replan_requested = false;
+    }
+    return replan;
+}
+
 void npc::execute_llm_intent_action(llm_intent_action action) {
   switch (action) {
   case llm_intent_action::wait_here: {
@@ -1689,7 +1796,7 @@ void npc::apply_llm_intent_target() {
       state.target_turns_remaining <= 0 || state.target_hint.empty()) {
     return;
   }
-  if (get_option<bool>("DEBUG_LLM_INTENT_UI")) {
+  if (option_debug_llm_intent_ui.get()) {
         add_msg( _( "LLM intent target hint: %s (attacks %d, turns %d)" ),
                  state.target_hint, state.target_attacks_remaining,
                  state.target_turns_remaining );
@@ -1869,12 +1976,12 @@ void npc::apply_llm_intent_target() {
         {string_format("resolved_target=%s", best->disp_name()),
          string_format("dist=%d", best_dist),
          matched_legend ? "matched_legend=true" : "matched_legend=false"});
-    if (get_option<bool>("DEBUG_LLM_INTENT_UI")) {
+    if (option_debug_llm_intent_ui.get()) {
       add_msg(_("LLM intent target resolved to %s at dist %d"),
               best->disp_name(), best_dist);
         }
     } else {
-        if( get_option<bool>( "DEBUG_LLM_INTENT_UI" ) ) {
+        if( option_debug_llm_intent_ui.get() ) {
             add_msg( _( "LLM intent target '%s' not found" ), state.target_hint );
         }
     }
@@ -1992,6 +2099,7 @@ bool npc::apply_llm_intent_item_targets() {
 }
 
 void npc::move() {
+  CATA_TRACE_ZONE( "npc::move" );
   const map &here = get_map();
 
   // don't just return from this function without doing something
@@ -2003,7 +2111,11 @@ void npc::move() {
              !has_effect(effect_npc_flee_player)) {
     set_attitude(NPCATT_NULL);
   }
-  regen_ai_cache();
+  // Calm NPCs keep following the plan from their last full re-plan on cheap turns.
+  const bool replan = take_replan_slot();
+  if (replan) {
+    regen_ai_cache();
+  }
     {
         llm_intent_state &state = llm_intent_state_for( *this );
         if( state.panic_forced_turns_remaining > 0 ) {
@@ -2033,7 +2145,9 @@ void npc::move() {
         execute_action( npc_player_activity );
         return;
     }
-    act_on_danger_assessment();
+    if( replan ) {
+        act_on_danger_assessment();
+    }
     npc_action action = npc_undecided;
 
     apply_llm_intent_target();
@@ -2054,7 +2168,7 @@ void npc::move() {
   const bool llm_item_safe = ai_cache.danger <= 0 && target == nullptr &&
                              !sees_dangerous_field(pos_bub()) &&
                              !has_effect(effect_npc_fire_bad);
-  if (get_option<bool>("LLM_INTENT_ENABLE") && !fetching_item &&
+  if (option_llm_intent_enable.get() && !fetching_item &&
       !state.look_around_targets.empty()) {
     if (!llm_item_safe) {
       const bool panic_block = attitude == NPCATT_FLEE ||
@@ -2110,7 +2224,7 @@ void npc::move() {
             llm_action_phase::waiting, "attack.reacquire_grace",
             {string_format("grace=%d",
                            state.target_loss_grace_turns_remaining)});
-        if (get_option<bool>("DEBUG_LLM_INTENT_UI")) {
+        if (option_debug_llm_intent_ui.get()) {
           add_msg(_("LLM intent target lost; grace %d"),
                   state.target_loss_grace_turns_remaining);
                 }
@@ -2118,7 +2232,7 @@ void npc::move() {
                 return true;
             }
             finish_llm_action( llm_action_phase::blocked, "attack.target_missing" );
-            if( get_option<bool>( "DEBUG_LLM_INTENT_UI" ) ) {
+            if( option_debug_llm_intent_ui.get() ) {
                 add_msg( _( "LLM intent target '%s' lost; reverting" ), state.target_hint );
             }
             state.target_hint.clear();
@@ -2131,7 +2245,7 @@ void npc::move() {
         state.target_loss_grace_turns_remaining = 3;
         npc_action forced = method_of_attack();
         if( forced == npc_do_attack ) {
-            if( get_option<bool>( "DEBUG_LLM_INTENT_UI" ) ) {
+            if( option_debug_llm_intent_ui.get() ) {
                 add_msg( _( "LLM intent forced immediate attack" ) );
             }
             execute_action( forced );
@@ -2147,7 +2261,7 @@ void npc::move() {
                                 {string_format("dist=%d", dist),
                                  string_format("confident_range=%d", conf)});
         execute_action(npc_aim);
-        if (get_option<bool>("DEBUG_LLM_INTENT_UI")) {
+        if (option_debug_llm_intent_ui.get()) {
           add_msg(_("LLM intent aiming at %s"), forced_target->disp_name());
                 }
                 return true;
@@ -2162,7 +2276,7 @@ void npc::move() {
                          rl_dist(pos_bub(), forced_target->pos_bub()))});
       update_path(forced_target->pos_bub());
       move_to_next();
-      if (get_option<bool>("DEBUG_LLM_INTENT_UI")) {
+      if (option_debug_llm_intent_ui.get()) {
         add_msg(_("LLM intent advancing toward %s"),
                 forced_target->disp_name());
       }
@@ -2172,7 +2286,7 @@ void npc::move() {
         execute_action( npc_pause );
         return true;
     };
-    if( get_option<bool>( "LLM_INTENT_ENABLE" ) &&
+    if( option_llm_intent_enable.get() &&
         state.active != llm_intent_action::none &&
         state.last_applied_turn != calendar::turn ) {
         if( !is_player_ally() ) {
@@ -2204,7 +2318,7 @@ void npc::move() {
             }
         }
     }
-    if( get_option<bool>( "LLM_INTENT_ENABLE" ) && attempt_llm_forced_attack() ) {
+    if( option_llm_intent_enable.get() && attempt_llm_forced_attack() ) {
     return;
   }
   Character &player_character = get_player_character();
@@ -2212,7 +2326,7 @@ void npc::move() {
       rl_dist(pos_bub(), player_character.pos_bub()) > 15) {
     state.hold_position_active = false;
     talk_function::stop_guard(*this);
-    if (get_option<bool>("DEBUG_LLM_INTENT_UI")) {
+    if (option_debug_llm_intent_ui.get()) {
             add_msg( _( "LLM hold_position released; resuming follow" ) );
         }
     }
@@ -4451,6 +4565,18 @@ void npc::worker_downtime() {
           }
 
           const tripoint_bub_ms local_patrol_target = here.get_bub( patrol_target );
+          // Starting a leg of the loop, walk the camp's cached route instead of pathing anew
+          if( patrol_runtime->behavior == camp_patrol_guard_behavior::loop &&
+              pos_abs() == patrol_runtime->leg_start &&
+              ( path.empty() || path.back() != local_patrol_target ) ) {
+            if( const std::vector<tripoint_abs_ms> *leg =
+                    ( *camp )->get_patrol_leg( *this, patrol_runtime->leg_start, patrol_target ) ) {
+              path.clear();
+              for( const tripoint_abs_ms &step : *leg ) {
+                path.push_back( here.get_bub( step ) );
+              }
+            }
+          }
           update_path( local_patrol_target );
           if( pos_abs() == patrol_target || path.empty() ) {
             move_pause();
@@ -4673,6 +4799,54 @@ void npc::see_item_say_smth(const itype_id &object, const std::string &smth) {
   }
 }
 
+namespace {
+// Position of each offset in closest_points_first( point::zero, MAX_VIEW_DISTANCE ), so a
+// handful of tiles can be visited in the same order as the full spiral.
+int closest_first_rank( const point_rel_ms &offset )
+{
+    static constexpr int side = 2 * MAX_VIEW_DISTANCE + 1;
+    static const std::vector<int> ranks = []() {
+        std::vector<int> ret( side * side, INT_MAX );
+        int rank = 0;
+        for( const point &p : closest_points_first( point::zero, MAX_VIEW_DISTANCE ) ) {
+            ret[( p.y + MAX_VIEW_DISTANCE ) * side + p.x + MAX_VIEW_DISTANCE] = rank++;
+        }
+        return ret;
+    }();
+    if( std::abs( offset.x() ) > MAX_VIEW_DISTANCE || std::abs( offset.y() ) > MAX_VIEW_DISTANCE ) {
+        return INT_MAX;
+    }
+    return ranks[( offset.y() + MAX_VIEW_DISTANCE ) * side + offset.x() + MAX_VIEW_DISTANCE];
+}
+
+// Tiles npc::find_item has to look at, closest first. Only tiles with items on the ground or
+// in vehicle cargo matter, unless the NPC may also harvest plants by name.
+std::vector<tripoint_bub_ms> item_search_tiles( map &here, const npc &who, int range )
+{
+    const tripoint_bub_ms center = who.pos_bub( here );
+    if( who.has_item_whitelist() ) {
+        return closest_points_first( center, range );
+    }
+    std::vector<tripoint_bub_ms> ret = here.item_tiles_near( center, range );
+    const tripoint_bub_ms min = center - tripoint_rel_ms( range, range, 0 );
+    const tripoint_bub_ms max = center + tripoint_rel_ms( range, range, 0 );
+    for( const wrapped_vehicle &veh : here.get_vehicles( min, max ) ) {
+        for( const vpart_reference &vpr : veh.v->get_any_parts( VPFLAG_CARGO ) ) {
+            const tripoint_bub_ms p = vpr.pos_bub( here );
+            if( p.z() == center.z() && square_dist( center, p ) <= range && !vpr.items().empty() ) {
+                ret.push_back( p );
+            }
+        }
+    }
+    std::sort( ret.begin(), ret.end(), [&center]( const tripoint_bub_ms & a,
+    const tripoint_bub_ms & b ) {
+        return closest_first_rank( ( a - center ).xy() ) < closest_first_rank( ( b - center ).xy() );
+    } );
+    ret.erase( std::unique( ret.begin(), ret.end() ), ret.end() );
+    return ret;
+}
+} // namespace
+
 void npc::find_item() {
   if (is_hallucination()) {
     see_item_say_smth(itype_thorazine,
@@ -4691,14 +4865,14 @@ void npc::find_item() {
 
     fetching_item = false;
     wanted_item = {};
+    // Nothing here changes our inventory, and every candidate asks how much room it has.
+    item_pocket::aggregate_scope aggregates;
     int best_value = minimum_item_value();
     // Not perfect, but has to mirror pickup code
     units::volume volume_allowed = free_space();
     units::mass   weight_allowed = weight_capacity() - weight_carried();
-    // For some reason range limiting by vision doesn't work properly
-    const int range = 6;
-    //int range = sight_range( g->light_level( posz() ) );
-  // range = std::max( 1, std::min( 12, range ) );
+    const int range = std::clamp( sight_range( g->light_level( posz() ) ), 1,
+                                  NPC_ITEM_SEARCH_RANGE );
 
   if (volume_allowed <= 0_ml || weight_allowed <= 0_gram) {
     add_msg_debug(debugmode::DF_NPC_ITEMAI,
@@ -4739,7 +4913,7 @@ void npc::find_item() {
         }
     };
 
-    for( const tripoint_bub_ms &p : closest_points_first( pos_bub(), range ) ) {
+    for( const tripoint_bub_ms &p : item_search_tiles( here, *this, range ) ) {
     // TODO: Make this sight check not overdraw nearby tiles
     // TODO: Optimize that zone check
     if (is_player_ally() && g->check_zone(zone_type_NO_NPC_PICKUP, p)) {
@@ -4766,7 +4940,7 @@ void npc::find_item() {
         }
         auto cache_tile = [this, &abs_p, num_items]() {
             if( wanted_item.get_item() == nullptr ) {
-                ai_cache.searched_tiles.insert( 1000, abs_p, num_items );
+                ai_cache.searched_tiles.insert( abs_p, num_items );
             }
         };
         bool can_see = false;
@@ -3119,6 +3119,7 @@ talk_data talk_response::create_option_line( dialogue &d, const input_event &hot
 {
     std::string ftext;
     text = ( truefalse_condition( d ) ? truetext : falsetext ).translated();
+    const int chance = trial.calc_chance( d );
     if( trial.type == TALK_TRIAL_NONE || trial.type == TALK_TRIAL_CONDITION ) {
         // regular dialogue
         ftext = text;
@@ -3134,7 +3135,7 @@ talk_data talk_response::create_option_line( dialogue &d, const input_event &hot
         // dialogue w/ a % chance to work
         //~ %1$s is translated trial type, %2$d is a number, and %3$s is the translated response text
         ftext = string_format( pgettext( "talk option", "[%1$s %2$d%%] %3$s" ),
-                               trial.name(), trial.calc_chance( d ), text );
+                               trial.name(), chance, text );
     }
 
     if( ignore_conditionals ) {
@@ -3153,7 +3154,7 @@ talk_data talk_response::create_option_line( dialogue &d, const input_event &hot
     }
 
     nc_color color;
-    std::set<dialogue_consequence> consequences = get_consequences( d );
+    std::set<dialogue_consequence> consequences = get_consequences( d, chance );
     if( consequences.count( dialogue_consequence::hostile ) > 0 ) {
         color = c_red;
     } else if( text[0] == '*' || consequences.count( dialogue_consequence::helpless ) > 0 ) {
@@ -3173,7 +3174,11 @@ talk_data talk_response::create_option_line( dialogue &d, const input_event &hot
 
 std::set<dialogue_consequence> talk_response::get_consequences( dialogue &d ) const
 {
-    int chance = trial.calc_chance( d );
+    return get_consequences( d, trial.calc_chance( d ) );
+}
+
+std::set<dialogue_consequence> talk_response::get_consequences( dialogue &d, int chance ) const
+{
     if( chance >= 100 ) {
         return { success.get_consequence( d ) };
     } else if( chance <= 0 ) {
@@ -3288,17 +3293,16 @@ talk_topic dialogue::opt( dialogue_window &d_win, const talk_topic &topic )
     ctxt.register_action( "QUIT" );
     std::vector<talk_data> response_lines;
     std::vector<input_event> response_hotkeys;
-    const auto generate_response_lines = [&]() {
+    // Hands out hotkeys to the lines already built, which is all a keybinding change needs.
+    const auto assign_response_hotkeys = [&]() {
 #if defined(__ANDROID__)
         ctxt.get_registered_manual_keys().clear();
 #endif
         const hotkey_queue &queue = hotkey_queue::alphabets();
-        response_lines.clear();
         response_hotkeys.clear();
         input_event evt = ctxt.first_unassigned_hotkey( queue );
-        for( talk_response &response : responses ) {
-            const talk_data &td = response.create_option_line( *this, evt, d_win.is_computer );
-            response_lines.emplace_back( td );
+        for( talk_data &td : response_lines ) {
+            td.hotkey_desc = right_justify( evt.short_description(), 2 );
             response_hotkeys.emplace_back( evt );
 #if defined(__ANDROID__)
             ctxt.register_manual_key( evt.get_first_input(), td.text );
@@ -3307,6 +3311,15 @@ talk_topic dialogue::opt( dialogue_window &d_win, const talk_topic &topic )
         }
         d_win.set_responses( response_lines );
     };
+    const auto generate_response_lines = [&]() {
+        response_lines.clear();
+        response_lines.reserve( responses.size() );
+        for( talk_response &response : responses ) {
+            response_lines.emplace_back( response.create_option_line( *this, input_event(),
+                                         d_win.is_computer ) );
+        }
+        assign_response_hotkeys();
+    };
     generate_response_lines();
 
     ui.on_redraw( [&]( const ui_adaptor & ) {
@@ -3336,7 +3349,7 @@ talk_topic dialogue::opt( dialogue_window &d_win, const talk_topic &topic )
             }
             if( action == "HELP_KEYBINDINGS" ) {
                 // Reallocate hotkeys as keybindings may have changed
-                generate_response_lines();
+                assign_response_hotkeys();
             } else if( action == "CONFIRM" ) {
                 response_ind = d_win.sel_response;
                 //response condition must be reverified since non-selectable responses can be displayed
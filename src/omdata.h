@@ -1239,22 +1239,40 @@ class joins_tracker
 struct mutable_overmap_phase_remainder {
     std::vector<mutable_overmap_placement_rule_remainder> rules;
 
+    // For debugging purposes it's really handy to have a record of exactly
+    // what happened during placement of a mutable special when it fails.
+    // It's only turned into text in the event of a placement error, as
+    // formatting it for every step would cost more than the placement.
+    struct choice_record {
+        tripoint_om_omt pos;
+        // The rule chosen, or null if none of them fit.
+        const mutable_overmap_placement_rule *rule = nullptr;
+        om_direction::type dir = om_direction::type::invalid;
+        // The terrain at pos and to its north, east, south and west at the time.
+        std::array<oter_id, 5> terrain;
+        std::vector<std::pair<cube_direction, const mutable_overmap_join *>> constraints;
+        // When none fit, the rules to choose from and whether each was exhausted.
+        std::vector<std::pair<const mutable_overmap_placement_rule *, bool>> rules;
+
+        std::string describe() const;
+    };
+
     struct satisfy_result {
         tripoint_om_omt origin;
         om_direction::type dir;
         mutable_overmap_placement_rule_remainder *rule;
         std::vector<om_pos_dir> suppressed_joins;
-        // For debugging purposes it's really handy to have a record of exactly
-        // what happened during placement of a mutable special when it fails,
-        // so to aid that we provide a human-readable description here which is
-        // only used in the event of a placement error.
-        std::string description;
+        choice_record record;
 
         explicit satisfy_result( const tripoint_om_omt origin, const om_direction::type dir,
                                  mutable_overmap_placement_rule_remainder *rule,
-                                 std::vector<om_pos_dir> suppressed_joins, std::string description ) :
+                                 std::vector<om_pos_dir> suppressed_joins ) :
             origin( origin ), dir( dir ), rule( rule ),
-            suppressed_joins( std::move( suppressed_joins ) ), description( std::move( description ) ) {
+            suppressed_joins( std::move( suppressed_joins ) ) {
+        }
+        explicit satisfy_result( choice_record record ) :
+            origin(), dir( om_direction::type::invalid ), rule( nullptr ),
+            record( std::move( record ) ) {
         }
     };
 
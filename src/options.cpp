@@ -24,6 +24,7 @@
 #include "json.h"
 #include "lang_stats.h"
 #include "line.h"
+#include "map_scale_constants.h"
 #include "mapsharing.h"
 #include "output.h"
 #include "path_info.h"
@@ -960,6 +961,8 @@ int options_manager::cOpt::getMaxLength() const
     return 0;
 }
 
+std::atomic<uint64_t> options_manager::change_count{ 0 };
+
 //set to next item
 void options_manager::cOpt::setNext()
 {
@@ -1001,6 +1004,8 @@ void options_manager::cOpt::setNext()
             fSet = fMin;
         }
     }
+    // After the store, so a reader can't cache the old value under the new count.
+    note_change();
 }
 
 //set to previous item
@@ -1039,6 +1044,7 @@ void options_manager::cOpt::setPrev()
             fSet = fMax;
         }
     }
+    note_change();
 }
 
 //set value
@@ -1052,6 +1058,7 @@ void options_manager::cOpt::setValue( float fSetIn )
     if( fSet < fMin || fSet > fMax ) {
         fSet = fDefault;
     }
+    note_change();
 }
 
 //set value
@@ -1065,6 +1072,7 @@ void options_manager::cOpt::setValue( int iSetIn )
     if( iSet < iMin || iSet > iMax ) {
         iSet = iDefault;
     }
+    note_change();
 }
 
 //set value
@@ -1126,6 +1134,7 @@ void options_manager::cOpt::setValue( const std::string &sSetIn )
             debugmsg( "invalid floating point option: %s", sSetIn );
         }
     }
+    note_change();
 }
 
 /** Fill a mapping with values.
@@ -1732,6 +1741,22 @@ void options_manager::add_options_general()
 
     add_empty_line();
 
+    add_option_group( "general", Group( "memory_opts", to_translation( "Memory options" ),
+                                        to_translation( "Options for machines with little memory." ) ),
+    [&]( const std::string & page_id ) {
+        add( "LOW_MEMORY_PROFILE", page_id, to_translation( "Low memory profile" ),
+             to_translation( "If true, map memory and LLM caches are kept smaller, only the z-levels next to yours stay active, and the game is saved to drop the map far from you once several times the reality bubble is loaded." ),
+             false
+           );
+
+        add( "MEMORY_BUDGET_MB", page_id, to_translation( "Memory budget (MiB)" ),
+             to_translation( "When the game holds more memory than this, it drops its caches and saves to drop the map far from you.  0 disables the budget." ),
+             0, 65536, 0
+           );
+    } );
+
+    add_empty_line();
+
     add_option_group( "general", Group( "soundpacks_opts", to_translation( "Soundpack options" ),
                                         to_translation( "Options regarding soundpack." ) ),
     [&]( const std::string & page_id ) {
@@ -2830,6 +2855,11 @@ void options_manager::add_options_world_default()
              to_translation( "If true, spawn zombies at shelters.  Makes the starting game a lot harder." ),
              false
            );
+
+        add( "PACKED_SUBMAPS", page_id, to_translation( "Packed map saves" ),
+             to_translation( "If true, map terrain and furniture are saved in a compact encoding that is smaller and faster to load.  Maps saved either way can be loaded, but builds older than this option can't read packed maps." ),
+             false
+           );
     } );
 
     add_empty_line();
@@ -2917,6 +2947,28 @@ void options_manager::add_options_debug()
          false
 #endif
        );
+
+    add( "CACHE_VERIFICATION", "debug", to_translation( "Remember verified game data" ),
+         to_translation( "If enabled, the verification step is skipped for game data that already passed it, as long as none of its files changed." ),
+         false
+       );
+
+    add( "PROFILE_LOADING", "debug", to_translation( "Profile game data loading" ),
+         to_translation( "If enabled, the time spent on every data folder, type of JSON object, finalization step and verification step is written to load_profile.json in the config folder, in Chrome trace format." ),
+         false
+       );
+
+    add( "DATA_SNAPSHOT", "debug", to_translation( "Keep a snapshot of parsed game data" ),
+         to_translation( "If enabled, the parsed JSON of each data folder is kept in a single snapshot file.  While the folder doesn't change, loading maps that one file instead of every JSON file in it." ),
+         false
+       );
+
+    add_empty_line();
+
+    add( "ACTIVE_Z_RANGE", "debug", to_translation( "Active z-level range" ),
+         to_translation( "How many z-levels above and below the one you are on get their map caches rebuilt and their fields processed every turn.  Levels holding monsters, NPCs or vehicles always do.  The others keep their state until they are in range again.  0 keeps every z-level active." ),
+         0, OVERMAP_HEIGHT, 0
+       );
 }
 
 void options_manager::add_options_llm()
@@ -3022,6 +3074,36 @@ void options_manager::add_options_llm()
          0, 600000, 0
        );
 
+    add( "LLM_INTENT_RUNNER_SOCKET", "llm", to_translation( "LLM runner daemon socket" ),
+         to_translation( "Path of a Unix socket for a runner that keeps running, and keeps its model loaded, after the game quits.  The game starts it there if nothing listens yet.  Leave empty to start a runner with every launch.  Not supported on Windows." ),
+         "", 1024
+       );
+
+    add( "LLM_INTENT_RUNNERS", "llm", to_translation( "Concurrent LLM runners" ),
+         to_translation( "How many LLM requests may run at once, each in its own runner process.  A local model loads once per runner, so raise this for API and Ollama backends first.  NPU always uses one." ),
+         1, 8, 1
+       );
+
+    add( "LLM_INTENT_SNAPSHOT_TOKEN_BUDGET", "llm", to_translation( "Snapshot token budget" ),
+         to_translation( "Rough number of tokens the situation snapshot may use.  Above it the map is shortened and cropped and only the most threatening creatures are listed.  0 for no limit." ),
+         0, 8000, 0
+       );
+
+    add( "LLM_INTENT_REPLY_CACHE", "llm", to_translation( "Reuse ambient replies" ),
+         to_translation( "If true, ambient chatter and look around results are reused for a while when an NPC is asked the same thing in much the same situation, instead of asking the model again." ),
+         true
+       );
+
+    add( "LLM_INTENT_STREAM_SPEECH", "llm", to_translation( "Stream NPC speech" ),
+         to_translation( "If true, an NPC's reply is printed as soon as the runner has generated it, before its actions.  The actions still wait for the full response." ),
+         true
+       );
+
+    add( "LLM_INTENT_BATCH_SHOUTS", "llm", to_translation( "Batch shout replies" ),
+         to_translation( "If true, allies who hear the same shout are sent to the runner as one batch instead of one after another.  Much faster on OpenVINO, but they no longer hear each other's replies first." ),
+         false
+       );
+
     add( "LLM_INTENT_FORCE_NPU", "llm", to_translation( "Force NPU (advanced)" ),
          to_translation( "If true, fail when NPU is not available instead of falling back." ),
          false
@@ -4086,6 +4168,7 @@ std::string options_manager::show( bool ingame, const bool world_options_only, b
             if( ingame && world_options_changed ) {
                 ACTIVE_WORLD_OPTIONS = WOPTIONS_OLD;
             }
+            note_change();
         }
     }
 
@@ -4205,6 +4288,7 @@ std::string options_manager::migrateOptionValue( const std::string &name,
 
 void options_manager::update_options_cache()
 {
+    note_change();
     // cache to global due to heavy usage.
     trigdist = ::get_option<bool>( "CIRCLEDIST" );
     use_tiles = ::get_option<bool>( "USE_TILES" );
@@ -4336,6 +4420,7 @@ void options_manager::set_world_options( options_container *options )
     } else {
         world_options = options;
     }
+    note_change();
 }
 
 void options_manager::update_global_locale()
@@ -3,11 +3,14 @@
 #define CATA_SRC_OPTIONS_H
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -224,6 +227,15 @@ class options_manager
         // updates the caches in options_cache.h
         static void update_options_cache();
 
+        /** Goes up whenever the value of any option may have changed, see @ref option_handle. */
+        static uint64_t get_change_count() {
+            return change_count.load( std::memory_order_acquire );
+        }
+        /** Call after the new value is stored, a read in between would keep the old one. */
+        static void note_change() {
+            change_count.fetch_add( 1, std::memory_order_acq_rel );
+        }
+
         /**
          * Returns a copy of the options in the "world default" page. The options have their
          * current value, which acts as the default for new worlds.
@@ -287,6 +299,7 @@ class options_manager
     private:
         options_container options;
         std::optional<options_container *> world_options; // NOLINT(cata-serialize)
+        static std::atomic<uint64_t> change_count;
 
         /** Option group. */
         class Group
@@ -510,4 +523,38 @@ inline T get_option( const std::string &name, bool convert = false )
     return get_options().get_option( name ).value_as<T>( convert );
 }
 
+/**
+ * An option that is read often, looked up by name only when some option changed since the
+ * last read. Keep one as a static next to the code reading it:
+ *
+ *     static const option_handle<bool> llm_enable( "LLM_INTENT_ENABLE" );
+ *     if( llm_enable.get() ) { ...
+ *
+ * The value is atomic, so worker threads may read it too. Only numbers and bools are
+ * supported, string options still go through get_option.
+ */
+template<typename T>
+class option_handle
+{
+        static_assert( std::is_arithmetic_v<T>, "option_handle only holds numbers and bools" );
+    public:
+        explicit option_handle( std::string name ) : name( std::move( name ) ) {}
+
+        T get() const {
+            const uint64_t changes = options_manager::get_change_count();
+            // The counter starts at 0, so the first read always looks the option up.
+            if( seen.load( std::memory_order_acquire ) != changes + 1 ) {
+                value.store( get_option<T>( name ), std::memory_order_relaxed );
+                seen.store( changes + 1, std::memory_order_release );
+            }
+            return value.load( std::memory_order_relaxed );
+        }
+
+    private:
+        std::string name;
+        mutable std::atomic<T> value{};
+        // change count + 1 when value was read
+        mutable std::atomic<uint64_t> seen{ 0 };
+};
+
 #endif // CATA_SRC_OPTIONS_H
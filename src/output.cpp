@@ -2389,7 +2389,12 @@ void multiline_list::set_up_navigation( input_context &ctxt )
 
 void scrolling_text_view::set_text( const std::string &text, const bool scroll_to_top )
 {
-    text_ = foldstring( text, text_width() );
+    set_lines( foldstring( text, text_width() ), scroll_to_top );
+}
+
+void scrolling_text_view::set_lines( std::vector<std::string> lines, const bool scroll_to_top )
+{
+    text_ = std::move( lines );
     if( scroll_to_top ) {
         offset_ = 0;
     } else {
@@ -1077,13 +1077,15 @@ class scrolling_text_view
         void set_up_navigation( input_context &ctxt,
                                 scrolling_key_scheme scheme = scrolling_key_scheme::no_scheme, bool enable_paging = false );
         void set_text( const std::string &text, bool scroll_to_top = true );
+        /** Like @ref set_text, but with the text already folded to @ref text_width. */
+        void set_lines( std::vector<std::string> lines, bool scroll_to_top = true );
         void scroll_up();
         void scroll_down();
         void page_up();
         void page_down();
         void draw( const nc_color &base_color );
-    private:
         int text_width();
+    private:
         int num_lines();
         int max_offset();
 
@@ -18,6 +18,7 @@
 #include "calendar.h"
 #include "cata_assert.h"
 #include "cata_path.h"
+#include "cata_scope_helpers.h"
 #include "cata_utility.h"
 #include "character_id.h"
 #include "coordinates.h"
@@ -35,6 +36,7 @@
 #include "map_iterator.h"
 #include "mapbuffer.h"
 #include "math_defines.h"
+#include "memory_report.h"
 #include "messages.h"
 #include "mongroup.h"
 #include "monster.h"
@@ -264,12 +266,20 @@ void overmap::populate( overmap_special_batch &enabled_specials )
 {
     try {
         open( enabled_specials );
+        // From here on most layers are only read, so don't hold full arrays for them.
+        compact_layers();
     } catch( const std::exception &err ) {
         debugmsg( "overmap (%d,%d) failed to load: %s", loc.x(), loc.y(), err.what() );
     }
 }
 
 void overmap::populate()
+{
+    overmap_special_batch enabled_specials = filtered_default_specials();
+    populate( enabled_specials );
+}
+
+overmap_special_batch overmap::filtered_default_specials() const
 {
     overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc );
     const region_settings_feature_flag &overmap_feature_flag = settings->overmap_feature_flag;
@@ -304,7 +314,7 @@ void overmap::populate()
         }
     }
 
-    populate( enabled_specials );
+    return enabled_specials;
 }
 
 oter_id overmap::get_default_terrain( int z ) const
@@ -329,6 +339,16 @@ void overmap::init_layers()
     }
 }
 
+void overmap::compact_layers()
+{
+    for( map_layer &l : layer ) {
+        l.terrain.compact();
+        l.visible.compact();
+        l.explored.compact();
+        l.map_cache.compact();
+    }
+}
+
 void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
 {
     if( !inbounds( p ) ) {
@@ -336,7 +356,8 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    oter_id &current_oter = layer[p.z() + OVERMAP_DEPTH].terrain[p.xy()];
+    om_layer_array<oter_id> &terrain = layer[p.z() + OVERMAP_DEPTH].terrain;
+    const oter_id current_oter = terrain[p.xy()];
     const oter_type_str_id &current_type_id = current_oter->get_type_id();
     const oter_type_str_id &incoming_type_id = id->get_type_id();
     const bool current_type_same = current_type_id == incoming_type_id;
@@ -369,7 +390,7 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
     }
     // TODO: maaaaybe this can be set after underlying map data has been changed? IDK.
     set_passable( project_combine( loc, p ), id->get_type_id()->default_map_data );
-    current_oter = id;
+    terrain.set( p.xy(), id );
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -424,7 +445,7 @@ void overmap::set_seen( const tripoint_om_omt &p, om_vision_level val, bool forc
         return;
     }
 
-    layer[p.z() + OVERMAP_DEPTH].visible[p.xy()] = val;
+    layer[p.z() + OVERMAP_DEPTH].visible.set( p.xy(), val );
 
     if( val > om_vision_level::details ) {
         add_extra_note( p );
@@ -445,7 +466,7 @@ bool &overmap::explored( const tripoint_om_omt &p )
         nullbool = false;
         return nullbool;
     }
-    return layer[p.z() + OVERMAP_DEPTH].explored[p.xy()];
+    return layer[p.z() + OVERMAP_DEPTH].explored.mutable_at( p.xy() );
 }
 
 bool overmap::is_explored( const tripoint_om_omt &p ) const
@@ -779,7 +800,7 @@ bool overmap::passable( const tripoint_om_ms &p )
     point_om_omt omt_origin;
     tripoint_omt_ms index;
     std::tie( omt_origin, index ) = project_remain<coords::omt>( p );
-    std::shared_ptr<map_data_summary> &ptr = layer[index.z() +
+    const std::shared_ptr<map_data_summary> &ptr = layer[index.z() +
             OVERMAP_DEPTH].map_cache[omt_origin];
     if( !ptr ) {
         // Oh no we aren't populated???
@@ -794,7 +815,7 @@ bool overmap::passable( const tripoint_om_ms &p )
 
 std::shared_ptr<map_data_summary> overmap::get_omt_summary( const tripoint_om_omt &p )
 {
-    std::shared_ptr<map_data_summary> &ptr = layer[p.z() +
+    const std::shared_ptr<map_data_summary> &ptr = layer[p.z() +
             OVERMAP_DEPTH].map_cache[p.xy()];
     if( !ptr ) {
         // Oh no we aren't populated???
@@ -810,7 +831,7 @@ void overmap::set_passable( const tripoint_om_ms &p, bool new_passable )
     tripoint_omt_ms index;
     std::tie( omt_origin, index ) = project_remain<coords::omt>( p );
     std::shared_ptr<map_data_summary> &ptr = layer[index.z() +
-            OVERMAP_DEPTH].map_cache[omt_origin];
+            OVERMAP_DEPTH].map_cache.mutable_at( omt_origin );
     if( !ptr ) {
         // Oh no we aren't populated???
         // Promote to error later.
@@ -833,7 +854,7 @@ void overmap::set_passable( const tripoint_abs_omt &p,
     if( overmap_coord != loc ) {
         return;
     }
-    layer[omt_coord.z() + OVERMAP_DEPTH].map_cache[omt_coord.xy()] = std::move( new_passable );
+    layer[omt_coord.z() + OVERMAP_DEPTH].map_cache.set( omt_coord.xy(), new_passable );
 }
 
 void overmap::set_passable( const tripoint_abs_omt &p,
@@ -845,13 +866,11 @@ void overmap::set_passable( const tripoint_abs_omt &p,
     if( overmap_coord != loc ) {
         return;
     }
-    std::shared_ptr<map_data_summary> &ptr = layer[omt_coord.z() +
-            OVERMAP_DEPTH].map_cache[omt_coord.xy()];
     // overmap pinky promises to never write to this map_data_summary.
     // This is enforced by all writes to map_cache[] checking for placeholder == true.
     // If so, we CoW to a new map_data_summary then edit that.
-    ptr = std::const_pointer_cast<map_data_summary>( map_data_placeholders::get_ptr(
-                new_passable ) );
+    layer[omt_coord.z() + OVERMAP_DEPTH].map_cache.set( omt_coord.xy(),
+            std::const_pointer_cast<map_data_summary>( map_data_placeholders::get_ptr( new_passable ) ) );
 }
 
 void overmap::set_passable( const tripoint_abs_omt &p, const std::bitset<24 * 24> &new_passable )
@@ -862,14 +881,14 @@ void overmap::set_passable( const tripoint_abs_omt &p, const std::bitset<24 * 24
     if( overmap_coord != loc ) {
         return;
     }
-    std::shared_ptr<map_data_summary> &ptr = layer[omt_coord.z() +
-            OVERMAP_DEPTH].map_cache[omt_coord.xy()];
-    if( !ptr ) {
+    om_layer_array<std::shared_ptr<map_data_summary>> &map_cache = layer[omt_coord.z() +
+            OVERMAP_DEPTH].map_cache;
+    if( !map_cache[omt_coord.xy()] ) {
         // Oh no we aren't populated???
         // Promote to error later.
         return;
     }
-    ptr = std::make_shared<map_data_summary>( new_passable );
+    map_cache.set( omt_coord.xy(), std::make_shared<map_data_summary>( new_passable ) );
 }
 
 bool overmap::inbounds( const tripoint_abs_ms &p )
@@ -910,15 +929,65 @@ void overmap::set_scent( const tripoint_abs_omt &loc, const scent_trace &new_sce
     scents[loc] = new_scent;
 }
 
+om_fire *overmap::fire_at( const tripoint_abs_omt &loc )
+{
+    const auto found = fires.find( loc );
+    return found == fires.end() ? nullptr : &found->second;
+}
+
+void overmap::set_fire( const tripoint_abs_omt &loc, const om_fire &fire )
+{
+    fires[loc] = fire;
+}
+
+void overmap::remove_fire( const tripoint_abs_omt &loc )
+{
+    fires.erase( loc );
+}
+
+int overmap::estimated_fire_fuel( const tripoint_om_omt &p ) const
+{
+    if( p.z() != 0 || !inbounds( p ) ) {
+        return 0;
+    }
+    const oter_id &here = ter( p );
+    if( here->is_water() || here->is_river() || here->is_lake() || here->is_ocean() ||
+        here->is_road() || here->is_highway() || here->has_flag( oter_flags::bridge ) ||
+        here->is_ravine() ) {
+        return 0;
+    }
+    const overmap_land_use_code_id &land_use = here->get_land_use_code();
+    if( land_use == land_use_code_forest || land_use == land_use_code_wetland_forest ) {
+        return 450;
+    }
+    return 200;
+}
+
 void overmap::generate( const std::vector<const overmap *> &neighbor_overmaps,
                         overmap_special_batch &enabled_specials )
 {
     dbg( D_INFO ) << "overmap::generate start…";
-    const oter_id omt_outside_defined_omap = static_cast<oter_id>
-            ( get_option<std::string>( "OUTSIDE_DEFINED_OMAP_OMT" ) );
-    const std::string overmap_pregenerated_path =
-        get_option<std::string>( "OVERMAP_PREGENERATED_PATH" );
-    if( !overmap_pregenerated_path.empty() ) {
+    std::vector<Highway_path> highway_paths;
+    for( const std::function<void()> &step : generation_steps( neighbor_overmaps, enabled_specials,
+            highway_paths ) ) {
+        step();
+    }
+    dbg( D_INFO ) << "overmap::generate done";
+}
+
+std::vector<std::function<void()>> overmap::generation_steps(
+                                    const std::vector<const overmap *> &neighbor_overmaps,
+                                    overmap_special_batch &enabled_specials, std::vector<Highway_path> &highway_paths )
+{
+    std::vector<std::function<void()>> steps;
+    steps.emplace_back( [this]() {
+        const oter_id omt_outside_defined_omap = static_cast<oter_id>
+                ( get_option<std::string>( "OUTSIDE_DEFINED_OMAP_OMT" ) );
+        const std::string overmap_pregenerated_path =
+            get_option<std::string>( "OVERMAP_PREGENERATED_PATH" );
+        if( overmap_pregenerated_path.empty() ) {
+            return;
+        }
         // HACK: For some reason gz files are automatically unpacked and renamed during Android build process
 #if defined(__ANDROID__)
         static const std::string fname = "%s/overmap_%d_%d.omap";
@@ -938,104 +1007,149 @@ void overmap::generate( const std::vector<const overmap *> &neighbor_overmaps,
                 for( int i = 0; i < OMAPX; i++ ) {
                     set_passable( project_combine( loc, tripoint_om_omt( i, j, z ) ),
                                   omt_outside_defined_omap->get_type_id()->default_map_data );
-                    layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
+                    layer[z + OVERMAP_DEPTH].terrain.set( point_om_omt( i, j ), omt_outside_defined_omap );
                 }
             }
         }
-    }
-
-    std::vector<Highway_path> highway_paths;
-    calculate_urbanity();
-    calculate_forestosity();
+    } );
+    steps.emplace_back( [this]() {
+        calculate_urbanity();
+        calculate_forestosity();
+    } );
     if( settings->neighbor_connections ) {
-        populate_connections_out_from_neighbors( neighbor_overmaps );
+        steps.emplace_back( [this, &neighbor_overmaps]() {
+            populate_connections_out_from_neighbors( neighbor_overmaps );
+        } );
     }
     if( settings->overmap_river ) {
-        place_rivers( neighbor_overmaps );
+        steps.emplace_back( [this, &neighbor_overmaps]() {
+            place_rivers( neighbor_overmaps );
+        } );
     }
     if( settings->overmap_lake ) {
-        place_lakes( neighbor_overmaps );
+        steps.emplace_back( [this, &neighbor_overmaps]() {
+            place_lakes( neighbor_overmaps );
+        } );
     }
     if( settings->overmap_ocean ) {
-        place_oceans( neighbor_overmaps );
+        steps.emplace_back( [this, &neighbor_overmaps]() {
+            place_oceans( neighbor_overmaps );
+        } );
     }
     if( settings->overmap_forest ) {
-        place_forests();
+        steps.emplace_back( [this]() {
+            place_forests();
+        } );
     }
     if( settings->overmap_forest && settings->place_swamps ) {
-        place_swamps();
+        steps.emplace_back( [this]() {
+            place_swamps();
+        } );
     }
     if( settings->overmap_ravine ) {
-        place_ravines();
+        steps.emplace_back( [this]() {
+            place_ravines();
+        } );
     }
     if( settings->overmap_river ) {
         // Polish rivers now so highways get the correct predecessors rather than river_center
-        polish_river( neighbor_overmaps );
+        steps.emplace_back( [this, &neighbor_overmaps]() {
+            polish_river( neighbor_overmaps );
+        } );
     }
     if( settings->overmap_highway ) {
-        highway_paths = place_highways( neighbor_overmaps );
+        steps.emplace_back( [this, &neighbor_overmaps, &highway_paths]() {
+            highway_paths = place_highways( neighbor_overmaps );
+        } );
     }
     if( settings->city_spec ) {
-        place_cities();
+        steps.emplace_back( [this]() {
+            place_cities();
+        } );
     }
     if( settings->overmap_highway ) {
-        place_highway_interchanges( highway_paths );
+        steps.emplace_back( [this, &highway_paths]() {
+            place_highway_interchanges( highway_paths );
+        } );
     }
     if( settings->city_spec ) {
-        build_cities();
+        steps.emplace_back( [this]() {
+            build_cities();
+        } );
     }
     if( settings->forest_trail ) {
-        place_forest_trails();
+        steps.emplace_back( [this]() {
+            place_forest_trails();
+        } );
     }
+    const auto railroads = [this, &neighbor_overmaps]() {
+        place_railroads( neighbor_overmaps );
+    };
+    const auto roads = [this, &neighbor_overmaps]() {
+        place_roads( neighbor_overmaps );
+    };
     if( settings->place_railroads_before_roads ) {
         if( settings->place_railroads ) {
-            place_railroads( neighbor_overmaps );
+            steps.emplace_back( railroads );
         }
         if( settings->place_roads ) {
-            place_roads( neighbor_overmaps );
+            steps.emplace_back( roads );
         }
     } else {
         if( settings->place_roads ) {
-            place_roads( neighbor_overmaps );
+            steps.emplace_back( roads );
         }
         if( settings->place_railroads ) {
-            place_railroads( neighbor_overmaps );
+            steps.emplace_back( railroads );
         }
     }
     if( settings->place_specials ) {
-        place_specials( enabled_specials );
+        steps.emplace_back( [this, &enabled_specials]() {
+            place_specials( enabled_specials );
+        } );
     }
     if( settings->overmap_highway ) {
-        finalize_highways( highway_paths );
+        steps.emplace_back( [this, &highway_paths]() {
+            finalize_highways( highway_paths );
+        } );
     }
     if( settings->forest_trail ) {
-        place_forest_trailheads();
+        steps.emplace_back( [this]() {
+            place_forest_trailheads();
+        } );
     }
     if( settings->overmap_river ) {
-        polish_river( neighbor_overmaps ); // Polish again for placed specials
+        // Polish again for placed specials
+        steps.emplace_back( [this, &neighbor_overmaps]() {
+            polish_river( neighbor_overmaps );
+        } );
     }
 
     // TODO: there is no reason we can't generate the sublevels in one pass
     //       for that matter there is no reason we can't as we add the entrance ways either
 
-    // Always need at least one sublevel, but how many more
-    int z = -1;
-    bool requires_sub = false;
-    do {
-        requires_sub = generate_sub( z );
-    } while( requires_sub && ( --z >= -OVERMAP_DEPTH ) );
-
-    // Always need at least one overlevel, but how many more
-    z = 1;
-    bool requires_over = false;
-    do {
-        requires_over = generate_over( z );
-    } while( requires_over && ( ++z <= OVERMAP_HEIGHT ) );
-
-    // Place the monsters, now that the terrain is laid out
-    place_mongroups();
-    place_radios();
-    dbg( D_INFO ) << "overmap::generate done";
+    steps.emplace_back( [this]() {
+        // Always need at least one sublevel, but how many more
+        int z = -1;
+        bool requires_sub = false;
+        do {
+            requires_sub = generate_sub( z );
+        } while( requires_sub && ( --z >= -OVERMAP_DEPTH ) );
+    } );
+    steps.emplace_back( [this]() {
+        // Always need at least one overlevel, but how many more
+        int z = 1;
+        bool requires_over = false;
+        do {
+            requires_over = generate_over( z );
+        } while( requires_over && ( ++z <= OVERMAP_HEIGHT ) );
+    } );
+    steps.emplace_back( [this]() {
+        // Place the monsters, now that the terrain is laid out
+        place_mongroups();
+        place_radios();
+    } );
+    return steps;
 }
 
 bool overmap::generate_sub( const int z )
@@ -1540,83 +1654,165 @@ std::vector<std::unordered_map<tripoint_abs_ms, horde_entity>*> overmap::hordes_
     return hordes.entity_group_at( p, filter );
 }
 
-/**
- * Moves hordes around the map according to their behaviour and target.
- * If they enter the coordinate space of the loaded map, spawn them there.
- */
-void overmap::move_hordes()
+// True if the terrain of its own OMT keeps an entity at from from ever getting to to,
+// nothing passable links it to the sides of the OMT or to to itself.
+// Other entities are ignored, they move out of the way eventually.
+bool overmap::horde_walled_in( const tripoint_abs_ms &from, const tripoint_abs_ms &to )
+{
+    tripoint_om_ms local = project_remain<coords::om>( from ).remainder_tripoint;
+    point_om_omt omt_origin;
+    tripoint_omt_ms index;
+    std::tie( omt_origin, index ) = project_remain<coords::omt>( local );
+    const std::shared_ptr<map_data_summary> summary =
+        get_omt_summary( tripoint_om_omt( omt_origin, index.z() ) );
+    if( !summary ) {
+        return false;
+    }
+    std::bitset<24 * 24> seed;
+    seed.set( index.y() * 24 + index.x() );
+    const std::bitset<24 * 24> reached = summary->reachable_from( seed );
+    if( ( reached & map_data_summary::edges() ).any() ) {
+        return false;
+    }
+    if( project_to<coords::omt>( to ) != project_to<coords::omt>( from ) ) {
+        return true;
+    }
+    const tripoint_omt_ms target = project_remain<coords::omt>( to ).remainder_tripoint;
+    return !reached[target.y() * 24 + target.x()];
+}
+
+std::vector<overmap::horde_move_plan> overmap::plan_horde_moves( int ticks )
 {
+    std::vector<horde_move_plan> plans;
     // TODO: throttle processing of monsters.
     // Specifically for throttling, only a process a subset of the eligible monster buckets per invocation.
-    std::unordered_map<tripoint_abs_ms, horde_entity> migrating_hordes;
-    for( horde_map::iterator mon = hordes.get_view( horde_map_flavors::active ).begin(),
-         mon_end = hordes.end(); mon != mon_end; ) {
+    for( std::pair<const tripoint_abs_ms, horde_entity> &mon : hordes.get_view(
+             horde_map_flavors::active ) ) {
+        horde_entity &entity = mon.second;
         // This might have an issue where a monster prevented from acting possibly should
         // get another chance to act?
         // This is here so that when a entity moves from one bucket to another it doesn't
         // get a second set of moves.
-        if( mon->second.last_processed == calendar::turn ) {
-            mon++;
+        if( entity.last_processed == calendar::turn ) {
             continue;
         }
-        mon->second.last_processed = calendar::turn;
+        entity.last_processed = calendar::turn;
         // If we have a goal, proceed toward it.
-        if( mon->second.tracking_intensity > 0 && mon->first != mon->second.destination ) {
-            mon->second.tracking_intensity--;
-            mon->second.moves += mon->second.type_id->speed;
-            if( mon->second.moves <= 0 ) {
-                mon++;
+        if( entity.tracking_intensity <= 0 || mon.first == entity.destination ) {
+            continue;
+        }
+        // Shut in a building it can't leave, stepping around inside gets it nowhere.
+        if( horde_walled_in( mon.first, entity.destination ) ) {
+            continue;
+        }
+        horde_move_plan &plan = plans.emplace_back();
+        plan.origin = mon.first;
+        // Play the ticks through on copies, apply_horde_moves repeats this on the real values.
+        int intensity = entity.tracking_intensity;
+        int moves = entity.moves;
+        tripoint_abs_ms cur = mon.first;
+        for( int tick = 0; tick < ticks && intensity > 0 && cur != entity.destination; ++tick ) {
+            intensity--;
+            moves += entity.type_id->speed;
+            if( moves <= 0 ) {
                 continue;
             }
             std::vector<tripoint_abs_ms> viable_candidates;
-            // Call up to overmapbuffer in case it needs to dispatch to an adjacent overmap.
-            for( const tripoint_abs_ms &candidate :
-                 squares_closer_to( mon->first, mon->second.destination ) ) {
+            for( const tripoint_abs_ms &candidate : squares_closer_to( cur, entity.destination ) ) {
                 // Just filter out cross-level candidates for now.
-                if( candidate.z() == mon->first.z() && overmap_buffer.passable( candidate ) ) {
+                if( candidate.z() != cur.z() ) {
+                    continue;
+                }
+                point_abs_om omp;
+                tripoint_om_ms local;
+                std::tie( omp, local ) = project_remain<coords::om>( candidate );
+                // Other overmaps are checked when applying the plan.
+                if( omp != pos() || passable( local ) ) {
                     viable_candidates.push_back( candidate );
                 }
             }
             if( viable_candidates.empty() ) {
                 // We're stuck.
                 // TODO: try to wander to get around obstacles, or smash.
-                mon++;
                 continue;
             }
             // TODO: nuanced move costs.
-            mon->second.moves -= 100;
-            if( viable_candidates.front() == mon->second.destination ) {
-                mon->second.tracking_intensity = 0;
+            moves -= 100;
+            if( viable_candidates.front() == entity.destination ) {
+                intensity = 0;
             }
             // squares_closer_to already orders candidates by how close to the main line they are.
             // For now just pick the first non-blocked square, later we could fuzz/stumble.
-            if( get_map().inbounds( viable_candidates.front() ) ) {
-                monster *placed_monster = nullptr;
-                if( mon->second.monster_data ) {
-                    placed_monster = g->place_critter_around( make_shared_fast<monster>( *mon->second.monster_data ),
-                                     get_map().get_bub( viable_candidates.front() ), 1 );
-                } else {
-                    placed_monster = g->place_critter_around( mon->second.type_id->id,
-                                     get_map().get_bub( viable_candidates.front() ), 1 );
-                }
-                if( placed_monster == nullptr ) {
-                    // If the tile is occupied it can't enter, just don't move for now.
-                    mon++;
-                    continue;
-                }
-                // TODO: this should be bundled into a constructor.
-                if( mon->second.tracking_intensity > 0 ) {
-                    placed_monster->wander_to( mon->second.destination, mon->second.tracking_intensity );
+            cur = viable_candidates.front();
+            plan.steps.push_back( { tick, std::move( viable_candidates ) } );
+            if( project_to<coords::om>( cur.xy() ) != pos() ) {
+                // Leaving this overmap, the rest is up to the next tick over there.
+                break;
+            }
+        }
+    }
+    return plans;
+}
+
+void overmap::apply_horde_moves( const std::vector<horde_move_plan> &plans, int ticks,
+                                 std::vector<horde_arrival> &arrivals )
+{
+    map &here = get_map();
+    std::unordered_map<tripoint_abs_ms, horde_entity> migrating_hordes;
+    for( const horde_move_plan &plan : plans ) {
+        point_abs_om omp;
+        tripoint_om_ms origin_local;
+        std::tie( omp, origin_local ) = project_remain<coords::om>( plan.origin );
+        horde_map::iterator mon = hordes.find( origin_local );
+        if( mon == hordes.end() ) {
+            continue;
+        }
+        horde_entity &entity = mon->second;
+        tripoint_abs_ms cur = plan.origin;
+        size_t next_step = 0;
+        // False once the entity took a different square than planned, or got stuck
+        bool on_plan = true;
+        bool arrived = false;
+        for( int tick = 0; tick < ticks && entity.tracking_intensity > 0 &&
+             cur != entity.destination; ++tick ) {
+            entity.tracking_intensity--;
+            entity.moves += entity.type_id->speed;
+            if( entity.moves <= 0 || !on_plan || next_step == plan.steps.size() ||
+                plan.steps[next_step].tick != tick ) {
+                continue;
+            }
+            const horde_move_plan::step &step = plan.steps[next_step++];
+            std::optional<tripoint_abs_ms> chosen;
+            for( const tripoint_abs_ms &candidate : step.candidates ) {
+                point_abs_om omp;
+                tripoint_om_ms local;
+                std::tie( omp, local ) = project_remain<coords::om>( candidate );
+                // Terrain in this overmap was already checked while planning.
+                if( omp == pos() ? hordes.entity_at( local ) == nullptr : overmap_buffer.passable( candidate ) ) {
+                    chosen = candidate;
+                    break;
                 }
-                mon = hordes.erase( mon );
+            }
+            if( !chosen ) {
+                on_plan = false;
                 continue;
             }
-
-            horde_map::iterator moving_mon = mon;
-            // Advance the loop iterator past the current node, which we will be removing.
-            mon++;
-            auto monster_node = hordes.extract( moving_mon );
-            monster_node.key() = viable_candidates.front();
+            entity.moves -= 100;
+            if( here.inbounds( *chosen ) ) {
+                // Spawned or held back once every overmap has moved.
+                arrivals.push_back( { plan.origin, cur, *chosen } );
+                arrived = true;
+                break;
+            }
+            if( *chosen == entity.destination ) {
+                entity.tracking_intensity = 0;
+            }
+            on_plan = *chosen == step.candidates.front() && project_to<coords::om>( chosen->xy() ) == pos();
+            cur = *chosen;
+        }
+        if( !arrived && cur != plan.origin ) {
+            auto monster_node = hordes.extract( mon );
+            monster_node.key() = cur;
             migrating_hordes.insert( std::move( monster_node ) );
         }
     }
@@ -1635,6 +1831,91 @@ void overmap::move_hordes()
     }
 }
 
+// Turning an entity into a monster is what makes a big horde reaching the reality
+// bubble slow, so only this many do per turn.
+static constexpr int horde_spawns_per_turn = 16;
+
+void overmap::settle_horde_arrivals( const std::vector<horde_arrival> &arrivals )
+{
+    if( arrivals.empty() ) {
+        return;
+    }
+    map &here = get_map();
+    const Character &player_character = get_player_character();
+    const tripoint_abs_ms player_pos = player_character.pos_abs();
+    // Seen first, then closest, ties keep the order they arrived in.
+    std::vector<std::pair<std::pair<bool, int>, size_t>> order;
+    order.reserve( arrivals.size() );
+    for( size_t i = 0; i < arrivals.size(); ++i ) {
+        const tripoint_abs_ms &to = arrivals[i].to;
+        const bool seen = player_character.sees( here, here.get_bub( to ) );
+        order.emplace_back( std::make_pair( !seen, rl_dist( player_pos, to ) ), i );
+    }
+    std::sort( order.begin(), order.end() );
+    int budget = horde_spawns_per_turn;
+    for( const std::pair<std::pair<bool, int>, size_t> &entry : order ) {
+        const horde_arrival &arrival = arrivals[entry.second];
+        overmap *om = overmap_buffer.get_existing( project_to<coords::om>( arrival.origin.xy() ) );
+        if( om != nullptr && om->settle_horde_arrival( arrival, budget > 0 ) ) {
+            budget--;
+        }
+    }
+}
+
+bool overmap::settle_horde_arrival( const horde_arrival &arrival, bool spawn )
+{
+    map &here = get_map();
+    const tripoint_om_ms origin_local = project_remain<coords::om>( arrival.origin ).remainder_tripoint;
+    horde_map::iterator mon = hordes.find( origin_local );
+    if( mon == hordes.end() ) {
+        return false;
+    }
+    horde_entity &entity = mon->second;
+    if( spawn ) {
+        monster *placed_monster = nullptr;
+        if( entity.monster_data ) {
+            placed_monster = g->place_critter_around( make_shared_fast<monster>( *entity.monster_data ),
+                             here.get_bub( arrival.to ), 1 );
+        } else {
+            placed_monster = g->place_critter_around( entity.type_id->id,
+                             here.get_bub( arrival.to ), 1 );
+        }
+        // If the tile is occupied it can't enter, just don't move for now.
+        if( placed_monster != nullptr ) {
+            // TODO: this should be bundled into a constructor.
+            if( arrival.to != entity.destination && entity.tracking_intensity > 0 ) {
+                placed_monster->wander_to( entity.destination, entity.tracking_intensity );
+            }
+            hordes.erase( mon );
+            return true;
+        }
+    }
+    // The step in is taken again next turn, from the square before it. Catching up several
+    // turns at once, that square may be in the next overmap over.
+    point_abs_om from_omp;
+    tripoint_om_ms from_local;
+    std::tie( from_omp, from_local ) = project_remain<coords::om>( arrival.from );
+    overmap *from_om = from_omp == pos() ? this : overmap_buffer.get_existing( from_omp );
+    if( arrival.from != arrival.origin && from_om != nullptr &&
+        from_om->hordes.entity_at( from_local ) == nullptr ) {
+        auto monster_node = hordes.extract( mon );
+        monster_node.key() = arrival.from;
+        from_om->hordes.insert( std::move( monster_node ) );
+    }
+    return false;
+}
+
+/**
+ * Moves hordes around the map according to their behaviour and target.
+ * If they enter the coordinate space of the loaded map, spawn them there.
+ */
+void overmap::move_hordes( int ticks )
+{
+    std::vector<horde_arrival> arrivals;
+    apply_horde_moves( plan_horde_moves( ticks ), ticks, arrivals );
+    settle_horde_arrivals( arrivals );
+}
+
 /**
  * Move the nemesis horde towards the player.
  * Currently only works for the first nemesis horde. If there are multiple, only the first one will be moved.
@@ -2033,7 +2314,8 @@ void overmap::place_forests()
 {
     const region_settings_forest &settings_forest = settings->get_settings_forest();
     const oter_id default_oter_id( settings->default_oter[OVERMAP_DEPTH] );
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_forest forest_noise( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( forest_noise, 0 );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -2058,30 +2340,43 @@ void overmap::place_forests()
     }
 }
 
+// credit to ehughsbaird for thinking up this inbounds solution to infinite flood fill lag.
+static bool lake_noise_inbounds( const point_om_omt &offset )
+{
+    return offset.x() > -5 && offset.y() > -5 && offset.x() < OMAPX + 5 && offset.y() < OMAPY + 5;
+}
+
 bool overmap::omt_lake_noise_threshold( const point_abs_omt &origin, const point_om_omt &offset,
                                         const double noise_threshold )
 {
     const om_noise::om_noise_layer_lake noise_func( origin, g->get_seed() );
-    // credit to ehughsbaird for thinking up this inbounds solution to infinite flood fill lag.
-    bool inbounds = offset.x() > -5 && offset.y() > -5 && offset.x() < OMAPX + 5 &&
-                    offset.y() < OMAPY + 5;
-    if( !inbounds ) {
+    if( !lake_noise_inbounds( offset ) ) {
         return false;
     }
     return noise_func.noise_at( offset ) > noise_threshold;
 }
 
+bool overmap::omt_lake_noise_threshold( const om_noise::om_noise_grid &lake_noise,
+                                        const point_om_omt &offset, const double noise_threshold )
+{
+    if( !lake_noise_inbounds( offset ) ) {
+        return false;
+    }
+    return lake_noise.noise_at( offset ) > noise_threshold;
+}
+
 bool overmap::guess_has_lake( const point_abs_om &p, const double noise_threshold,
                               int max_tile_count )
 {
     const point_abs_omt origin = project_to<coords::omt>( p );
-    const om_noise::om_noise_layer_lake noise_func( origin, g->get_seed() );
+    const std::shared_ptr<const om_noise::om_noise_grid> lake_noise =
+        om_noise::water_noise_grid( origin, g->get_seed() );
 
     int lake_tiles = 0;
     for( int i = 0; i < OMAPX; i++ ) {
         for( int j = 0; j < OMAPY; j++ ) {
             const point_om_omt seed_point( i, j );
-            if( omt_lake_noise_threshold( origin, seed_point, noise_threshold ) ) {
+            if( omt_lake_noise_threshold( *lake_noise, seed_point, noise_threshold ) ) {
                 lake_tiles++;
             }
         }
@@ -2119,7 +2414,8 @@ void overmap::place_swamps()
     }
 
     // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_floodplain floodplain_noise( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( floodplain_noise, 0 );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -3479,11 +3775,14 @@ void overmap::place_mongroups()
     if( settings->overmap_ocean ) {
         // Now place ocean mongroup. Weights may need to be altered.
         const region_settings_ocean &settings_ocean = settings->get_settings_ocean();
-        const om_noise::om_noise_layer_ocean f( global_base_point(), g->get_seed() );
         const point_abs_om this_om = pos();
         const bool oceans_disabled = !settings_ocean.ocean_start_north.has_value() &&
                                      !settings_ocean.ocean_start_east.has_value() &&
                                      !settings_ocean.ocean_start_west.has_value() && !settings_ocean.ocean_start_south.has_value();
+        std::shared_ptr<const om_noise::om_noise_grid> f;
+        if( !oceans_disabled ) {
+            f = om_noise::water_noise_grid( global_base_point(), g->get_seed() );
+        }
 
         // noise threshold adjuster for deep ocean. Increase to make deep ocean move further from the shore.
         constexpr float DEEP_OCEAN_THRESHOLD_ADJUST = 1.25;
@@ -3504,7 +3803,7 @@ void overmap::place_mongroups()
                 // It's too soon!  Too soon for an ocean!!  ABORT!!!
                 return false;
             }
-            return f.noise_at( p ) + ocean_adjust > settings_ocean.noise_threshold_ocean *
+            return f->noise_at( p ) + ocean_adjust > settings_ocean.noise_threshold_ocean *
                    DEEP_OCEAN_THRESHOLD_ADJUST;
         };
 
@@ -3632,13 +3931,50 @@ void overmap::open( overmap_special_batch &enabled_specials )
         }
     }
 
+    const std::vector<const overmap *> neighbors = existing_neighbors();
+    // Overmap generation draws from its own stream. That way when an overmap is generated doesn't
+    // change how it looks, nor what the rest of the game rolls afterwards.
+    const scoped_rng_stream rng_scope( overmap_buffer.generation_seed( loc ) );
+    generate( neighbors, enabled_specials );
+}
+
+std::vector<const overmap *> overmap::existing_neighbors() const
+{
     // pointers looks like (north, south, west, east)
     std::vector<const overmap *> neighbors;
     neighbors.reserve( four_adjacent_offsets.size() );
     for( const point &adjacent : four_adjacent_offsets ) {
         neighbors.emplace_back( overmap_buffer.get_existing( loc + adjacent ) );
     }
-    generate( neighbors, enabled_specials );
+    return neighbors;
+}
+
+overmap_generation_job::overmap_generation_job( overmap &target )
+    : om( target ), neighbors( target.existing_neighbors() ),
+      enabled_specials( target.filtered_default_specials() ),
+      steps( target.generation_steps( neighbors, enabled_specials, highway_paths ) ),
+      engine( overmap_buffer.generation_seed( target.pos() ) )
+{
+}
+
+bool overmap_generation_job::run_for( const std::chrono::steady_clock::duration budget )
+{
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + budget;
+    {
+        // Same stream as overmap::open draws from, carried over between runs.
+        cata_default_random_engine &rng_engine = rng_get_engine();
+        restore_on_out_of_scope<cata_default_random_engine> restore_engine( rng_engine );
+        rng_engine = engine;
+        do {
+            steps[next_step++]();
+        } while( next_step < steps.size() && std::chrono::steady_clock::now() < deadline );
+        engine = rng_engine;
+    }
+    if( next_step < steps.size() ) {
+        return false;
+    }
+    om.compact_layers();
+    return true;
 }
 
 // Note: this may throw io errors from std::ofstream
@@ -3829,6 +4165,43 @@ void overmap::remove_camp( const point_abs_omt &p )
     }
 }
 
+void overmap::add_memory_usage( memory_report::report &out ) const
+{
+    size_t bytes = sizeof( overmap );
+    // Placeholder summaries are shared with the json data, only the real ones belong here.
+    std::unordered_set<const map_data_summary *> summaries;
+    for( const map_layer &l : layer ) {
+        bytes += l.terrain.heap_bytes() + l.visible.heap_bytes() + l.explored.heap_bytes() +
+                 l.map_cache.heap_bytes() + l.notes.capacity() * sizeof( om_note ) +
+                 l.extras.capacity() * sizeof( om_map_extra );
+        for( const om_note &note : l.notes ) {
+            bytes += memory_report::heap_bytes( note.text );
+        }
+        if( l.map_cache.is_compact() ) {
+            const map_data_summary *summary = l.map_cache[point_om_omt::zero].get();
+            if( summary != nullptr && !summary->placeholder ) {
+                summaries.insert( summary );
+            }
+            continue;
+        }
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                const map_data_summary *summary = l.map_cache[point_om_omt( x, y )].get();
+                if( summary != nullptr && !summary->placeholder ) {
+                    summaries.insert( summary );
+                }
+            }
+        }
+    }
+    out.add( "overmaps", 1, bytes );
+    out.add( "map_data_summary", summaries.size(), summaries.size() * sizeof( map_data_summary ) );
+    hordes.add_memory_usage( out );
+    for( const shared_ptr_fast<npc> &guy : npcs ) {
+        out.add( "npcs", 1, sizeof( npc ) );
+        out.add_items( "npc_items", *guy );
+    }
+}
+
 void overmap::clear_camps()
 {
     auto iter = camps.begin();
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <climits>
 #include <cstdlib>
 #include <functional>
@@ -23,6 +24,7 @@
 #include <vector>
 
 #include "basecamp.h"
+#include "calendar.h"
 #include "catacharset.h"
 #include "cata_variant.h"
 #include "city.h"
@@ -60,6 +62,15 @@ class overmap_connection;
 struct horde_entity;
 struct map_data_summary;
 struct region_settings;
+
+namespace memory_report
+{
+class report;
+} // namespace memory_report
+namespace om_noise
+{
+class om_noise_grid;
+} // namespace om_noise
 template <typename T> struct enum_traits;
 
 struct om_note {
@@ -158,6 +169,17 @@ struct om_vehicle {
     std::string name;
 };
 
+/**
+ * A fire burning in an OMT outside the reality bubble, see @ref overmapbuffer::process_fires.
+ */
+struct om_fire {
+    // What is left to burn, in the units of @ref overmap::estimated_fire_fuel.
+    int fuel = 0;
+    // One bit per submap of the OMT whose fire fields are up to date with this fire. Set for
+    // all of them when the fire left the reality bubble as fields, cleared when it burns on.
+    uint8_t materialized = 0;
+};
+
 enum class radio_type : int {
     MESSAGE_BROADCAST,
     WEATHER_RADIO
@@ -211,11 +233,86 @@ struct enum_traits<om_vision_level> {
     static constexpr om_vision_level last = om_vision_level::last;
 };
 
+// One value per OMT of an overmap layer, stored as a single value for as long as they are all
+// the same. Most layers far above or below ground stay that way for good, so they don't need
+// a full array each. Writing a different value expands it into one, compact() folds it back.
+template<typename T>
+class om_layer_array
+{
+    public:
+        using value_type = T;
+        static constexpr size_t size_x = OMAPX;
+        static constexpr size_t size_y = OMAPY;
+
+        om_layer_array() = default;
+        om_layer_array( const om_layer_array &other ) : uniform( other.uniform ),
+            dense( other.dense ? std::make_unique<cata::mdarray<T, point_om_omt>>( *other.dense ) :
+                   nullptr ) {}
+        om_layer_array( om_layer_array && ) noexcept = default;
+        om_layer_array &operator=( const om_layer_array &other ) {
+            if( this != &other ) {
+                *this = om_layer_array( other );
+            }
+            return *this;
+        }
+        om_layer_array &operator=( om_layer_array && ) noexcept = default;
+
+        const T &operator[]( const point_om_omt &p ) const {
+            return dense ? ( *dense )[p] : uniform;
+        }
+        // Only expands if the value differs from what's already there.
+        void set( const point_om_omt &p, const T &value ) {
+            if( dense || !( value == uniform ) ) {
+                mutable_at( p ) = value;
+            }
+        }
+        T &mutable_at( const point_om_omt &p ) {
+            return expanded()[p];
+        }
+        cata::mdarray<T, point_om_omt> &expanded() {
+            if( !dense ) {
+                dense = std::make_unique<cata::mdarray<T, point_om_omt>>();
+                dense->fill( uniform );
+            }
+            return *dense;
+        }
+        void fill( const T &value ) {
+            dense.reset();
+            uniform = value;
+        }
+        // Goes back to a single value if every OMT has the same one.
+        // Invalidates references into the array.
+        void compact() {
+            if( !dense ) {
+                return;
+            }
+            const T &first = ( *dense )[point_om_omt::zero];
+            for( size_t x = 0; x < size_x; ++x ) {
+                for( size_t y = 0; y < size_y; ++y ) {
+                    if( !( ( *dense )[x][y] == first ) ) {
+                        return;
+                    }
+                }
+            }
+            const T value = first;
+            fill( value );
+        }
+        bool is_compact() const {
+            return !dense;
+        }
+        size_t heap_bytes() const {
+            return dense ? sizeof( *dense ) : 0;
+        }
+    private:
+        T uniform = T();
+        std::unique_ptr<cata::mdarray<T, point_om_omt>> dense;
+};
+
 struct map_layer {
-    cata::mdarray<oter_id, point_om_omt> terrain;
-    cata::mdarray<om_vision_level, point_om_omt> visible;
-    cata::mdarray<bool, point_om_omt> explored;
-    cata::mdarray<std::shared_ptr<map_data_summary>, point_om_omt> map_cache;
+    om_layer_array<oter_id> terrain;
+    om_layer_array<om_vision_level> visible;
+    om_layer_array<bool> explored;
+    om_layer_array<std::shared_ptr<map_data_summary>> map_cache;
     std::vector<om_note> notes;
     std::vector<om_map_extra> extras;
 };
@@ -451,6 +548,8 @@ class overmap
          **/
         void populate( overmap_special_batch &enabled_specials );
         void populate();
+        // The default specials of this overmap, filtered by its region's feature flags.
+        overmap_special_batch filtered_default_specials() const;
 
         const point_abs_om &pos() const {
             return loc;
@@ -461,6 +560,9 @@ class overmap
         //will this OMT contain a lake before or after it is generated?
         static bool omt_lake_noise_threshold( const point_abs_omt &origin, const point_om_omt &offset,
                                               double noise_threshold );
+        // Same as above, with the overmap's lake noise already sampled.
+        static bool omt_lake_noise_threshold( const om_noise::om_noise_grid &lake_noise,
+                                              const point_om_omt &offset, double noise_threshold );
         //does the overmap have at least one lake OMT?
         //TODO: extend pre-determined lake generation so we know instead of guess
         static bool guess_has_lake( const point_abs_om &p, double noise_threshold, int tile_count );
@@ -548,6 +650,19 @@ class overmap
          */
         void set_scent( const tripoint_abs_omt &loc, const scent_trace &new_scent );
 
+        /** The fire burning at @p loc, or nullptr. */
+        om_fire *fire_at( const tripoint_abs_omt &loc );
+        void set_fire( const tripoint_abs_omt &loc, const om_fire &fire );
+        void remove_fire( const tripoint_abs_omt &loc );
+        const std::map<tripoint_abs_omt, om_fire> &get_fires() const {
+            return fires;
+        }
+        /**
+         * How much an OMT of this overmap could burn, judged from its terrain type: nothing
+         * for water, roads and anything off the surface, the most for forest.
+         */
+        int estimated_fire_fuel( const tripoint_om_omt &p ) const;
+
         /**
          * @returns Whether @param p is within desired bounds of the overmap
          * @param clearance Minimal distance from the edges of the overmap
@@ -646,6 +761,8 @@ class overmap
                                        &predicate )
                                        const;
         point_om_omt get_fallback_road_connection_point() const;
+        /** Adds the layers, hordes, map data summaries and NPCs of this overmap to @p out. */
+        void add_memory_usage( memory_report::report &out ) const;
     private:
         friend class overmapbuffer;
 
@@ -663,6 +780,8 @@ class overmap
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
+        // Ordered, so fires spread the same way every time.
+        std::map<tripoint_abs_omt, om_fire> fires;
 
         // Records the locations where a given overmap special was placed, which
         // can be used after placement to lookup whether a given location was created
@@ -694,9 +813,22 @@ class overmap
 
         // Initialize
         void init_layers();
+        // Folds every layer array that holds a single value back into just that value.
+        void compact_layers();
         // open existing overmap, or generate a new one
         void open( overmap_special_batch &enabled_specials );
     public:
+        // An entity whose move took it into the reality bubble. It is still at
+        // origin until settle_horde_arrivals spawns it or leaves it at from.
+        struct horde_arrival {
+            tripoint_abs_ms origin;
+            // Its square before the step in, maybe in another overmap
+            tripoint_abs_ms from;
+            tripoint_abs_ms to;
+        };
+        // Spawns at most a few arrivals per turn, those the player sees and then the
+        // closest first. The rest stay entities outside and try again next turn.
+        static void settle_horde_arrivals( const std::vector<horde_arrival> &arrivals );
         // Get all values from omt_stack_arguments_map at the given point or nullopt if not set yet
         std::optional<mapgen_arguments> get_existing_omt_stack_arguments(
             const point_abs_omt &p ) const;
@@ -729,8 +861,15 @@ class overmap
         // Save per-player overmap view data.
         void serialize_view( std::ostream &fout ) const;
     private:
+        friend class overmap_generation_job;
+        // The already existing overmaps next to this one, north, south, west and east.
+        std::vector<const overmap *> existing_neighbors() const;
         void generate( const std::vector<const overmap *> &neighbor_overmaps,
                        overmap_special_batch &enabled_specials );
+        // The steps of generate, in order. They refer to the arguments, which must outlive them.
+        std::vector<std::function<void()>> generation_steps(
+                                            const std::vector<const overmap *> &neighbor_overmaps,
+                                            overmap_special_batch &enabled_specials, std::vector<Highway_path> &highway_paths );
         bool generate_sub( int z );
         bool generate_over( int z );
         // Check and put bridgeheads
@@ -746,7 +885,35 @@ class overmap
         void alert_entity( const tripoint_om_ms &location, const tripoint_abs_ms &destination,
                            int intensity );
         void process_mongroups();
-        void move_hordes();
+        // One active entity's movement over a horde tick, worked out from the
+        // terrain alone so that several overmaps can plan at the same time.
+        struct horde_move_plan {
+            struct step {
+                // Tick of the catch-up this step is taken on
+                int tick;
+                // Squares to step to, in order of preference. Later steps were
+                // planned from the first one.
+                std::vector<tripoint_abs_ms> candidates;
+            };
+            tripoint_abs_ms origin;
+            std::vector<step> steps;
+        };
+        // Whether from's own OMT shuts it off from to, see overmap.cpp.
+        bool horde_walled_in( const tripoint_abs_ms &from, const tripoint_abs_ms &to );
+        // Only touches this overmap, so different overmaps may plan in parallel.
+        std::vector<horde_move_plan> plan_horde_moves( int ticks );
+        // Moves the entities along their plans, checking for other entities
+        // on the way. Those that reach the reality bubble go to arrivals.
+        void apply_horde_moves( const std::vector<horde_move_plan> &plans, int ticks,
+                                std::vector<horde_arrival> &arrivals );
+        // Spawns the entity of arrival if spawn and there's room, otherwise moves it
+        // to arrival.from. Returns whether it spawned.
+        bool settle_horde_arrival( const horde_arrival &arrival, bool spawn );
+        // Advance hordes by |ticks| turns, at most one step per turn.
+        void move_hordes( int ticks = 1 );
+        // When move_hordes last ran, overmaps away from the player are only
+        // moved every few turns and catch up on the turns they skipped.
+        time_point last_horde_move = calendar::before_time_starts;
 
         //nemesis movement for "hunted" trait
         void signal_nemesis( const tripoint_abs_sm & );
@@ -996,6 +1163,36 @@ class overmap
         oter_id get_or_migrate_oter( const std::string &oterid );
 };
 
+/**
+ * Generation of a new overmap broken into steps, so it can be spread over several turns, see
+ * overmapbuffer::generate_ahead. Run to the end, it does what populate() does for an overmap
+ * that isn't on disk yet, random numbers included.
+ */
+class overmap_generation_job
+{
+    public:
+        explicit overmap_generation_job( overmap &target );
+        overmap_generation_job( const overmap_generation_job & ) = delete;
+        overmap_generation_job &operator=( const overmap_generation_job & ) = delete;
+
+        /**
+         * Runs steps until @p budget has passed, always at least one.
+         * @returns true once every step has run and the overmap is complete.
+         */
+        bool run_for( std::chrono::steady_clock::duration budget );
+
+    private:
+        overmap &om;
+        std::vector<const overmap *> neighbors;
+        overmap_special_batch enabled_specials;
+        std::vector<Highway_path> highway_paths;
+        // Refer to the members above.
+        std::vector<std::function<void()>> steps;
+        size_t next_step = 0;
+        // The overmap's own stream, see overmapbuffer::generation_seed. Kept between runs.
+        cata_default_random_engine engine;
+};
+
 // A small LRU cache: most oter_id's occur in clumps like forests of swamps.
 // This cache helps avoid much more costly lookups in the full hashmap.
 struct oter_display_lru {
@@ -1055,6 +1252,8 @@ struct oter_display_options {
 
     // Internal bookkeeping value - only draw edge mission indicator once
     mutable bool drawn_mission = false;
+    // Internal bookkeeping value - the line from center to mission_target, built on first use
+    mutable std::optional<std::unordered_set<point_abs_omt>> mission_line;
 };
 
 // arguments for oter_symbol_and_color pertaining to a single point
@@ -29,6 +29,7 @@
 #include "regional_settings.h"
 #include "rng.h"
 #include "simple_pathfinding.h"
+#include "thread_pool.h"
 #include "type_id.h"
 
 //in a box made by p1, p2, return { corner point in direction, direction from corner to p2 }
@@ -1061,23 +1062,32 @@ void highway_intersection_grid::set_options()
 void highway_intersection_grid::generate_offset( overmap_feature_grid_node &node )
 {
     const int max_offset_variance = this->max_offset_variance;
-    auto no_lakes = []( const point_abs_om & pt ) {
-        const region_settings &settings = overmap_buffer.get_default_settings( pt );
-        if( !settings.overmap_lake ) {
-            return true;
-        }
-        const region_settings_lake &lake_settings = settings.get_settings_lake();
-        return !overmap::guess_has_lake( pt, lake_settings.noise_threshold_lake,
-                                         lake_settings.lake_size_min );
-    };
     const point_abs_om grid_pos = node.get_grid_pos();
     tripoint_abs_om as_tripoint( grid_pos, 0 );
     tripoint_range radius = points_in_radius( as_tripoint, max_offset_variance );
-    std::vector<point_abs_om> intersection_candidates;
-
+    std::vector<point_abs_om> nearby;
+    std::vector<const region_settings_lake *> lake_settings;
     for( const tripoint_abs_om &p : radius ) {
-        if( p != as_tripoint && no_lakes( p.xy() ) ) { //intersection cannot generate at origin
-            intersection_candidates.emplace_back( p.xy() );
+        if( p != as_tripoint ) { //intersection cannot generate at origin
+            const region_settings &settings = overmap_buffer.get_default_settings( p.xy() );
+            nearby.emplace_back( p.xy() );
+            lake_settings.push_back( settings.overmap_lake ? &settings.get_settings_lake() : nullptr );
+        }
+    }
+    // Guessing samples the lake noise of a whole overmap, so do all candidates at once.
+    // The guesses only depend on the position and the seed, the order of the
+    // candidates and so the pick below stay the same.
+    std::vector<char> has_lake( nearby.size(), false );
+    cata::get_thread_pool().parallel_for( 0, static_cast<int>( nearby.size() ), [&]( int i ) {
+        if( lake_settings[i] != nullptr ) {
+            has_lake[i] = overmap::guess_has_lake( nearby[i], lake_settings[i]->noise_threshold_lake,
+                                                   lake_settings[i]->lake_size_min );
+        }
+    } );
+    std::vector<point_abs_om> intersection_candidates;
+    for( size_t i = 0; i < nearby.size(); ++i ) {
+        if( !has_lake[i] ) {
+            intersection_candidates.emplace_back( nearby[i] );
         }
     }
     if( intersection_candidates.empty() ) {
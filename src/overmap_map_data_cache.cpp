@@ -81,3 +81,47 @@ void map_data_summary::load( const JsonObject &jo, const std::string_view & )
         }
     }
 }
+
+namespace
+{
+std::bitset<24 * 24> column_mask( int x )
+{
+    std::bitset<24 * 24> mask;
+    for( int y = 0; y < 24; ++y ) {
+        mask.set( y * 24 + x );
+    }
+    return mask;
+}
+} // namespace
+
+const std::bitset<24 * 24> &map_data_summary::edges()
+{
+    static const std::bitset<24 * 24> edge_mask = []() {
+        std::bitset<24 * 24> mask = column_mask( 0 ) | column_mask( 23 );
+        for( int x = 0; x < 24; ++x ) {
+            mask.set( x );
+            mask.set( 23 * 24 + x );
+        }
+        return mask;
+    }();
+    return edge_mask;
+}
+
+std::bitset<24 * 24> map_data_summary::reachable_from( const std::bitset<24 * 24> &seeds ) const
+{
+    // Shifting by one moves every square a step along its row, these masks drop the ones
+    // that would wrap around onto the neighbouring row.
+    static const std::bitset<24 * 24> not_first_column = ~column_mask( 0 );
+    static const std::bitset<24 * 24> not_last_column = ~column_mask( 23 );
+    std::bitset<24 * 24> reached = seeds;
+    while( true ) {
+        const std::bitset<24 * 24> row_spread = reached | ( ( reached << 1 ) & not_first_column ) |
+                                                ( ( reached >> 1 ) & not_last_column );
+        const std::bitset<24 * 24> next = ( ( row_spread | ( row_spread << 24 ) |
+                                              ( row_spread >> 24 ) ) & passable ) | seeds;
+        if( next == reached ) {
+            return reached;
+        }
+        reached = next;
+    }
+}
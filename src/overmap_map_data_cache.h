@@ -35,6 +35,12 @@ struct map_data_summary {
                                bool placeholder_override = false ): placeholder( placeholder_override ),
         passable( new_passable ) {}
     void load( const JsonObject &jo, const std::string_view &src );
+    // Every square reachable from seeds through passable squares, moving in any of the eight
+    // directions and staying inside this OMT. The seeds themselves are always included.
+    // Floods a whole row of squares per bitset operation instead of visiting them one by one.
+    std::bitset<24 * 24> reachable_from( const std::bitset<24 * 24> &seeds ) const;
+    // The squares along the four sides of an OMT, the ones that lead out of it.
+    static const std::bitset<24 * 24> &edges();
     // Only used for placeholder summaries, not used by "real" map summaries.
     string_id<map_data_summary> id;
     bool was_loaded = false;
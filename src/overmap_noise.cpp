@@ -1,8 +1,12 @@
 #include <cmath>
 #include <algorithm>
+#include <deque>
+#include <mutex>
+#include <utility>
 
 #include "overmap_noise.h"
 #include "simplexnoise.h"
+#include "thread_pool.h"
 
 namespace om_noise
 {
@@ -45,4 +49,75 @@ float om_noise_layer_ocean::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+om_noise_grid::om_noise_grid( const om_noise_layer &layer, int border )
+    : layer( layer ), border( border ), width( OMAPX + 2 * border ), height( OMAPY + 2 * border ),
+      values( static_cast<size_t>( width ) * height )
+{
+    cata::get_thread_pool().parallel_for( 0, height, [&]( int row ) {
+        for( int col = 0; col < width; ++col ) {
+            values[row * width + col] = layer.noise_at( point_om_omt( col - border, row - border ) );
+        }
+    } );
+}
+
+float om_noise_grid::noise_at( const point_om_omt &omt_local ) const
+{
+    const int col = omt_local.x() + border;
+    const int row = omt_local.y() + border;
+    if( col < 0 || row < 0 || col >= width || row >= height ) {
+        return layer.noise_at( omt_local );
+    }
+    return values[row * width + col];
+}
+
+namespace
+{
+struct water_noise {
+    water_noise( const point_abs_omt &global_base_point, unsigned seed )
+        : global_base_point( global_base_point ), seed( seed ),
+          layer( global_base_point, seed ), grid( layer, 5 ) {
+    }
+    point_abs_omt global_base_point;
+    unsigned seed;
+    om_noise_layer_lake layer;
+    om_noise_grid grid;
+};
+} // namespace
+
+std::shared_ptr<const om_noise_grid> water_noise_grid( const point_abs_omt &global_base_point,
+        unsigned seed )
+{
+    // The overmap being generated plus its eight neighbours.
+    static constexpr size_t max_recent = 9;
+    static std::mutex recent_mutex;
+    static std::deque<std::shared_ptr<const water_noise>> recent;
+    const auto find_recent = [&]() -> std::shared_ptr<const om_noise_grid> {
+        for( const std::shared_ptr<const water_noise> &entry : recent )
+        {
+            if( entry->global_base_point == global_base_point && entry->seed == seed ) {
+                return { entry, &entry->grid };
+            }
+        }
+        return nullptr;
+    };
+    {
+        std::lock_guard<std::mutex> lock( recent_mutex );
+        if( std::shared_ptr<const om_noise_grid> found = find_recent() ) {
+            return found;
+        }
+    }
+    // Sampled without holding the lock, the grid fans out over the thread pool.
+    std::shared_ptr<const water_noise> sampled = std::make_shared<water_noise>( global_base_point,
+            seed );
+    std::lock_guard<std::mutex> lock( recent_mutex );
+    if( std::shared_ptr<const om_noise_grid> found = find_recent() ) {
+        return found;
+    }
+    if( recent.size() >= max_recent ) {
+        recent.pop_front();
+    }
+    recent.push_back( sampled );
+    return { sampled, &sampled->grid };
+}
+
 } // namespace om_noise
@@ -2,6 +2,9 @@
 #ifndef CATA_SRC_OVERMAP_NOISE_H
 #define CATA_SRC_OVERMAP_NOISE_H
 
+#include <memory>
+#include <vector>
+
 #include "coordinates.h"
 #include "game_constants.h"
 #include "point.h"
@@ -89,6 +92,34 @@ class om_noise_layer_ocean : public om_noise_layer
         float noise_at( const point_om_omt &local_omt_pos ) const override;
 };
 
+/**
+ * The values of a noise layer over a whole overmap and a border around it, sampled up front.
+ * Rows are sampled in parallel on the shared thread pool, which is safe because layers only do
+ * arithmetic on the position and seed. Points outside the border sample the layer directly.
+ * The layer must outlive the grid.
+ */
+class om_noise_grid
+{
+    public:
+        om_noise_grid( const om_noise_layer &layer, int border );
+        float noise_at( const point_om_omt &omt_local ) const;
+    private:
+        const om_noise_layer &layer;
+        int border;
+        int width;
+        int height;
+        std::vector<float> values;
+};
+
+/**
+ * Lake noise around the overmap at @p global_base_point, sampled with a border of 5, which is
+ * what lakes, oceans, ocean monster groups and the highway planner's lake guesses all need.
+ * Ocean noise is the same function, so it serves for that too. The last few grids are kept
+ * so the overmap being generated and its neighbours only sample each one once.
+ */
+std::shared_ptr<const om_noise_grid> water_noise_grid( const point_abs_omt &global_base_point,
+        unsigned seed );
+
 } // namespace om_noise
 
 #endif // CATA_SRC_OVERMAP_NOISE_H
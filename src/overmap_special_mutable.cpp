@@ -157,7 +157,7 @@ mutable_overmap_phase_remainder::satisfy_result mutable_overmap_phase_remainder:
                         best_result = *result;
                     }
                     if( *result == best_result ) {
-                        pos_dir_options.emplace_back( origin, dir, &rule, result.value().supressed_joins, std::string{} );
+                        pos_dir_options.emplace_back( origin, dir, &rule, result.value().supressed_joins );
                     }
                 }
             }
@@ -167,47 +167,61 @@ mutable_overmap_phase_remainder::satisfy_result mutable_overmap_phase_remainder:
             options.add( *chosen_result, rule.get_weight() );
         }
     }
-    std::string joins_s = enumerate_as_string( unresolved.all_unresolved_at( pos ),
-    []( const joins_tracker::join * j ) {
-        return string_format( "%s: %s", io::enum_to_string( j->where.dir ), j->join->id );
-    } );
+    choice_record record;
+    record.pos = pos;
+    record.terrain = { om.ter( pos ), om.ter( pos + point::north ), om.ter( pos + point::east ),
+                       om.ter( pos + point::south ), om.ter( pos + point::west )
+                     };
+    for( const joins_tracker::join *j : unresolved.all_unresolved_at( pos ) ) {
+        record.constraints.emplace_back( j->where.dir, j->join );
+    }
 
     if( satisfy_result *picked = options.pick() ) {
-        om_direction::type dir = picked->dir;
-        const mutable_overmap_placement_rule_remainder &rule = *picked->rule;
-        picked->description =
-            string_format(
-                // NOLINTNEXTLINE(cata-translate-string-literal)
-                "At %s chose '%s' rot %d with neighbours N:%s E:%s S:%s W:%s and constraints "
-                "%s",
-                pos.to_string(), rule.description(), static_cast<int>( dir ),
-                om.ter( pos + point::north ).id().str(), om.ter( pos + point::east ).id().str(),
-                om.ter( pos + point::south ).id().str(), om.ter( pos + point::west ).id().str(),
-                joins_s );
+        record.rule = picked->rule->parent;
+        record.dir = picked->dir;
+        picked->record = std::move( record );
         picked->rule->decrement();
         return *picked;
     } else {
-        std::string rules_s = enumerate_as_string( rules,
-        []( const mutable_overmap_placement_rule_remainder & rule ) {
-            if( rule.is_exhausted() ) {
-                return string_format( "(%s)", rule.description() );
-            } else {
-                return rule.description();
-            }
-        } );
-        std::string message =
-            string_format(
-                // NOLINTNEXTLINE(cata-translate-string-literal)
-                "At %s FAILED to match on terrain %s with neighbours N:%s E:%s S:%s W:%s and "
-                "constraints %s from amongst rules %s",
-                pos.to_string(), om.ter( pos ).id().str(),
-                om.ter( pos + point::north ).id().str(), om.ter( pos + point::east ).id().str(),
-                om.ter( pos + point::south ).id().str(), om.ter( pos + point::west ).id().str(),
-                joins_s, rules_s );
-        return satisfy_result{ {}, om_direction::type::invalid, nullptr, std::vector<om_pos_dir>{}, std::move( message ) };
+        for( const mutable_overmap_placement_rule_remainder &rule : rules ) {
+            record.rules.emplace_back( rule.parent, rule.is_exhausted() );
+        }
+        return satisfy_result( std::move( record ) );
     }
 }
 
+std::string mutable_overmap_phase_remainder::choice_record::describe() const
+{
+    const std::string joins_s = enumerate_as_string( constraints,
+    []( const std::pair<cube_direction, const mutable_overmap_join *> &c ) {
+        return string_format( "%s: %s", io::enum_to_string( c.first ), c.second->id );
+    } );
+    if( rule ) {
+        return string_format(
+                   // NOLINTNEXTLINE(cata-translate-string-literal)
+                   "At %s chose '%s' rot %d with neighbours N:%s E:%s S:%s W:%s and constraints "
+                   "%s",
+                   pos.to_string(), rule->description(), static_cast<int>( dir ),
+                   terrain[1].id().str(), terrain[2].id().str(), terrain[3].id().str(),
+                   terrain[4].id().str(), joins_s );
+    }
+    const std::string rules_s = enumerate_as_string( rules,
+    []( const std::pair<const mutable_overmap_placement_rule *, bool> &r ) {
+        if( r.second ) {
+            return string_format( "(%s)", r.first->description() );
+        } else {
+            return r.first->description();
+        }
+    } );
+    return string_format(
+               // NOLINTNEXTLINE(cata-translate-string-literal)
+               "At %s FAILED to match on terrain %s with neighbours N:%s E:%s S:%s W:%s and "
+               "constraints %s from amongst rules %s",
+               pos.to_string(), terrain[0].id().str(), terrain[1].id().str(),
+               terrain[2].id().str(), terrain[3].id().str(), terrain[4].id().str(), joins_s,
+               rules_s );
+}
+
 void mutable_overmap_terrain_join::deserialize( const JsonValue &jin )
 {
     if( jin.test_string() ) {
@@ -783,9 +797,11 @@ special_placement_result mutable_overmap_special_data::place(
 
     std::vector<placed_connection> connections_placed;
 
-    // This is for debugging only, it tracks a human-readable description
-    // of what happened to be put in the debugmsg in the event of failure.
-    std::vector<std::string> descriptions;
+    // This is for debugging only, it tracks what happened to be described
+    // in the debugmsg in the event of failure, along with where each phase
+    // after the first started.
+    std::vector<mutable_overmap_phase_remainder::choice_record> choices;
+    std::vector<std::pair<size_t, std::ptrdiff_t>> phase_starts;
 
     // Helper function to add a particular mutable_overmap_terrain at a
     // particular place.
@@ -834,7 +850,7 @@ special_placement_result mutable_overmap_special_data::place(
         tripoint_om_omt next_pos = unresolved.pick_top_priority();
         mutable_overmap_phase_remainder::satisfy_result satisfy_result =
             phase_remaining.satisfy( om, next_pos, unresolved );
-        descriptions.push_back( std::move( satisfy_result.description ) );
+        choices.push_back( std::move( satisfy_result.record ) );
         const mutable_overmap_placement_rule_remainder *rule = satisfy_result.rule;
         if( rule ) {
             const tripoint_om_omt &satisfy_origin = satisfy_result.origin;
@@ -851,9 +867,7 @@ special_placement_result mutable_overmap_special_data::place(
             if( current_phase == phases.end() ) {
                 break;
             }
-            descriptions.push_back(
-                // NOLINTNEXTLINE(cata-translate-string-literal)
-                string_format( "## Entering phase %td", current_phase - phases.begin() ) );
+            phase_starts.emplace_back( choices.size(), current_phase - phases.begin() );
             phase_remaining = current_phase->realise();
             unresolved.restore_postponed();
         }
@@ -873,6 +887,18 @@ special_placement_result mutable_overmap_special_data::place(
                                   dir_join->join->id );
         } );
 
+        std::vector<std::string> descriptions;
+        auto next_phase = phase_starts.begin();
+        for( size_t i = 0; i <= choices.size(); ++i ) {
+            for( ; next_phase != phase_starts.end() && next_phase->first == i; ++next_phase ) {
+                // NOLINTNEXTLINE(cata-translate-string-literal)
+                descriptions.push_back( string_format( "## Entering phase %td", next_phase->second ) );
+            }
+            if( i < choices.size() ) {
+                descriptions.push_back( choices[i].describe() );
+            }
+        }
+
         debugmsg( "Spawn of mutable special %s had unresolved joins.  Existing terrain "
                   "at %s was %s; joins were %s\nComplete record of placement follows:\n%s",
                   parent_id.str(), p.to_string(), current_terrain.id().str(), joins,
@@ -127,12 +127,11 @@ static const int npm_width = 3;
 /** Note preview map height without borders. Odd number. */
 static const int npm_height = 3;
 
-//forwards to cataimgui::draw_colored_text with automatic wrapping
-void overmap_sidebar::draw_sidebar_text( const std::string_view &original_text,
-        const nc_color &color )
+void overmap_sidebar::add_sidebar_text( cataimgui::retained_text &text,
+                                        const std::string_view &original_text, const nc_color &color )
 {
-    cataimgui::TextColoredParagraph( color, original_text );
-    ImGui::NewLine();
+    text.paragraph( std::string( original_text ), color );
+    text.new_line();
 }
 
 overmap_sidebar::overmap_sidebar( overmap_ui::overmap_draw_data_t &data,
@@ -148,14 +147,35 @@ void overmap_sidebar::init()
 {
 }
 
+void overmap_sidebar::invalidate()
+{
+    for( cataimgui::retained_text *text : {
+             &tile_info, &settings_info, &mission_info, &quick_reference, &layer_info, &debug_info
+         } ) {
+        text->invalidate();
+    }
+}
+
 void overmap_sidebar::draw_controls()
 {
+    // Anything else the text shows changes only on input, which invalidates it.
+    const size_t cursor_key = cataimgui::retained_key( draw_data.cursor_pos );
+
     // This info is always shown at the top of the sidebar
-    draw_tile_info();
+    if( tile_info.outdated( cursor_key ) ) {
+        build_tile_info( tile_info );
+    }
+    tile_info.draw();
     ImGui::Separator();
-    draw_settings_info();
+    if( settings_info.outdated( 0 ) ) {
+        build_settings_info( settings_info );
+    }
+    settings_info.draw();
     ImGui::Separator();
-    draw_mission_info();
+    if( mission_info.outdated( cursor_key ) ) {
+        build_mission_info( mission_info );
+    }
+    mission_info.draw();
     ImGui::Separator();
 
     // This info can be scrolled through
@@ -165,33 +185,43 @@ void overmap_sidebar::draw_controls()
     ImGui::SetNextItemOpen( quickref );
     quickref = ImGui::CollapsingHeader( _( "Quick Reference" ) );
     if( quickref ) {
-        draw_quick_reference();
+        if( quick_reference.outdated( 0 ) ) {
+            build_quick_reference( quick_reference );
+        }
+        quick_reference.draw();
     };
     bool &layers = om_sidebar_state.layers_header;
     ImGui::SetNextItemOpen( layers );
     layers = ImGui::CollapsingHeader( _( "Layers" ) );
     if( layers ) {
-        draw_layer_info();
+        if( layer_info.outdated( cursor_key ) ) {
+            build_layer_info( layer_info );
+        }
+        layer_info.draw();
     }
 
     if( debug_mode || draw_data.debug_editor ) {
-        bool &debug_info = om_sidebar_state.debug_header;
-        ImGui::SetNextItemOpen( debug_info );
-        debug_info = ImGui::CollapsingHeader( _( "Debug" ) );
-        if( debug_info ) {
-            draw_debug();
+        bool &debug_header = om_sidebar_state.debug_header;
+        ImGui::SetNextItemOpen( debug_header );
+        debug_header = ImGui::CollapsingHeader( _( "Debug" ) );
+        if( debug_header ) {
+            if( debug_info.outdated( cursor_key ) ) {
+                build_debug( debug_info );
+            }
+            debug_info.draw();
         }
     }
     ImGui::EndChild();
 }
 
-void overmap_sidebar::print_hint( const std::string &action, nc_color color )
+void overmap_sidebar::print_hint( cataimgui::retained_text &text, const std::string &action,
+                                  nc_color color )
 {
-    draw_sidebar_text( string_format( _( "%s - %s" ),
+    add_sidebar_text( text, string_format( _( "%s - %s" ),
                                       ictxt.get_desc( action ), ictxt.get_action_name( action ) ), color );
 }
 
-void overmap_sidebar::draw_tile_info()
+void overmap_sidebar::build_tile_info( cataimgui::retained_text &text )
 {
     const tripoint_abs_omt &cursor_pos = draw_data.cursor_pos;
 
@@ -213,13 +243,13 @@ void overmap_sidebar::draw_tile_info()
 
         if( ter.blends_adjacent( center_vision ) ) {
             oter_vision::blended_omt info = oter_vision::get_blended_omt_info( cursor_pos, center_vision );
-            draw_sidebar_text( info.sym, info.color );
+            add_sidebar_text( text, info.sym, info.color );
         } else {
-            draw_sidebar_text( ter.get_symbol( center_vision ), ter.get_color( center_vision ) );
+            add_sidebar_text( text, ter.get_symbol( center_vision ), ter.get_color( center_vision ) );
         }
 
-        ImGui::SameLine();
-        overmap_buffer.display_description_at( sm_pos, true );
+        text.same_line();
+        overmap_buffer.describe_at( sm_pos, true, text );
         if( center_vision != om_vision_level::full ) {
             std::string vision_level_string;
             switch( center_vision ) {
@@ -236,15 +266,15 @@ void overmap_sidebar::draw_tile_info()
                     vision_level_string = _( "This is a bug!" );
                     break;
             }
-            draw_sidebar_text( vision_level_string, c_light_gray );
+            add_sidebar_text( text, vision_level_string, c_light_gray );
         }
     } else {
         const oter_t &ter = oter_unexplored.obj();
 
-        draw_sidebar_text( ter.get_symbol( om_vision_level::full ) + " ",
+        add_sidebar_text( text, ter.get_symbol( om_vision_level::full ) + " ",
                            ter.get_color( om_vision_level::full ) );
-        ImGui::SameLine();
-        draw_sidebar_text( ter.get_name( om_vision_level::full ),
+        text.same_line();
+        add_sidebar_text( text, ter.get_name( om_vision_level::full ),
                            ter.get_color( om_vision_level::full ) );
     }
 
@@ -253,69 +283,69 @@ void overmap_sidebar::draw_tile_info()
         const bool weather_is_visible = uistate.overmap_debug_weather ||
                                         player_character.overmap_los( cursor_pos, sight_points * 2 );
         if( weather_is_visible ) {
-            draw_sidebar_text( _( "Weather: " ), c_white );
-            ImGui::SameLine();
-            draw_sidebar_text( overmap_ui::get_weather_at_point( cursor_pos )->name.translated(),
+            add_sidebar_text( text, _( "Weather: " ), c_white );
+            text.same_line();
+            add_sidebar_text( text, overmap_ui::get_weather_at_point( cursor_pos )->name.translated(),
                                overmap_ui::get_weather_at_point( cursor_pos )->color );
         } else {
-            draw_sidebar_text( _( "# Weather unknown" ), c_dark_gray );
+            add_sidebar_text( text, _( "# Weather unknown" ), c_dark_gray );
         }
     } else {
-        draw_sidebar_text( _( "Not viewing weather" ), c_dark_gray );
+        add_sidebar_text( text, _( "Not viewing weather" ), c_dark_gray );
     }
 
     const std::string coords = display::overmap_position_text( cursor_pos );
-    draw_sidebar_text( coords, c_red );
+    add_sidebar_text( text, coords, c_red );
 }
 
-void overmap_sidebar::draw_settings_info()
+void overmap_sidebar::build_settings_info( cataimgui::retained_text &text )
 {
-    print_hint( "TOGGLE_FAST_SCROLL", uistate.overmap_fast_scroll ? c_pink : c_magenta );
-    print_hint( "TOGGLE_FAST_TRAVEL", uistate.overmap_fast_travel ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_FAST_SCROLL", uistate.overmap_fast_scroll ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_FAST_TRAVEL", uistate.overmap_fast_travel ? c_pink : c_magenta );
 }
 
-void overmap_sidebar::draw_quick_reference()
+void overmap_sidebar::build_quick_reference( cataimgui::retained_text &text )
 {
-    draw_sidebar_text( _( "Use movement keys to pan." ), c_magenta );
-    draw_sidebar_text( string_format( _( "Press %s to preview route." ),
+    add_sidebar_text( text, _( "Use movement keys to pan." ), c_magenta );
+    add_sidebar_text( text, string_format( _( "Press %s to preview route." ),
                                       ictxt.get_desc( "CHOOSE_DESTINATION" ) ), c_magenta );
-    draw_sidebar_text( _( "Press again to confirm." ), c_magenta );
-    print_hint( "LEVEL_UP" );
-    print_hint( "LEVEL_DOWN" );
-    print_hint( "look" );
-    print_hint( "CENTER" );
-    print_hint( "CENTER_ON_DESTINATION" );
-    print_hint( "GO_TO_DESTINATION" );
-    print_hint( "SEARCH" );
-    print_hint( "CREATE_NOTE" );
-    print_hint( "DELETE_NOTE" );
-    print_hint( "MARK_DANGER" );
-    print_hint( "LIST_NOTES" );
-    print_hint( "CREATE_POINT_OF_INTEREST" );
-    print_hint( "MISSIONS" );
+    add_sidebar_text( text, _( "Press again to confirm." ), c_magenta );
+    print_hint( text, "LEVEL_UP" );
+    print_hint( text, "LEVEL_DOWN" );
+    print_hint( text, "look" );
+    print_hint( text, "CENTER" );
+    print_hint( text, "CENTER_ON_DESTINATION" );
+    print_hint( text, "GO_TO_DESTINATION" );
+    print_hint( text, "SEARCH" );
+    print_hint( text, "CREATE_NOTE" );
+    print_hint( text, "DELETE_NOTE" );
+    print_hint( text, "MARK_DANGER" );
+    print_hint( text, "LIST_NOTES" );
+    print_hint( text, "CREATE_POINT_OF_INTEREST" );
+    print_hint( text, "MISSIONS" );
 }
 
-void overmap_sidebar::draw_layer_info()
+void overmap_sidebar::build_layer_info( cataimgui::retained_text &text )
 {
 
     const tripoint_abs_omt &cursor_pos = draw_data.cursor_pos;
     const bool show_overlays = uistate.overmap_show_overlays || uistate.overmap_blinking;
     const bool is_explored = overmap_buffer.is_explored( cursor_pos );
 
-    print_hint( "TOGGLE_MAP_NOTES", uistate.overmap_show_map_notes ? c_pink : c_magenta );
-    print_hint( "TOGGLE_BLINKING", uistate.overmap_blinking ? c_pink : c_magenta );
-    print_hint( "TOGGLE_OVERLAYS", show_overlays ? c_pink : c_magenta );
-    print_hint( "TOGGLE_CITY_LABELS", uistate.overmap_show_city_labels ? c_pink : c_magenta );
-    print_hint( "TOGGLE_HORDES", uistate.overmap_show_hordes ? c_pink : c_magenta );
-    print_hint( "TOGGLE_MAP_REVEALS", uistate.overmap_show_revealed_omts ? c_pink : c_magenta );
-    print_hint( "TOGGLE_EXPLORED", is_explored ? c_pink : c_magenta );
-    print_hint( "TOGGLE_FOREST_TRAILS", uistate.overmap_show_forest_trails ? c_pink : c_magenta );
-    print_hint( "TOGGLE_OVERMAP_WEATHER",
+    print_hint( text, "TOGGLE_MAP_NOTES", uistate.overmap_show_map_notes ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_BLINKING", uistate.overmap_blinking ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_OVERLAYS", show_overlays ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_CITY_LABELS", uistate.overmap_show_city_labels ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_HORDES", uistate.overmap_show_hordes ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_MAP_REVEALS", uistate.overmap_show_revealed_omts ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_EXPLORED", is_explored ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_FOREST_TRAILS", uistate.overmap_show_forest_trails ? c_pink : c_magenta );
+    print_hint( text, "TOGGLE_OVERMAP_WEATHER",
                 !get_map().is_outside( get_player_character().pos_bub() ) ? c_dark_gray :
                 uistate.overmap_visible_weather ? c_pink : c_magenta );
 }
 
-void overmap_sidebar::draw_debug()
+void overmap_sidebar::build_debug( cataimgui::retained_text &text )
 {
     const tripoint_abs_omt &cursor_pos = draw_data.cursor_pos;
     avatar &player_character = get_avatar();
@@ -325,41 +355,41 @@ void overmap_sidebar::draw_debug()
                                     overmap_buffer.seen( cursor_pos );
 
     if( debug_mode ) {
-        print_hint( "TOGGLE_LAND_USE_CODES", uistate.overmap_show_land_use_codes ? c_pink : c_magenta );
+        print_hint( text, "TOGGLE_LAND_USE_CODES", uistate.overmap_show_land_use_codes ? c_pink : c_magenta );
     }
     if( draw_data.debug_editor ) {
-        print_hint( "REVEAL_MAP", c_light_blue );
-        print_hint( "LONG_TELEPORT", c_light_blue );
-        print_hint( "PLACE_SPECIAL", c_light_blue );
-        print_hint( "PLACE_TERRAIN", c_light_blue );
-        print_hint( "SET_SPECIAL_ARGS", c_light_blue );
-        print_hint( "MODIFY_HORDE", c_light_blue );
-        print_hint( "PRINT_NOISE_MAPS", c_light_blue );
+        print_hint( text, "REVEAL_MAP", c_light_blue );
+        print_hint( text, "LONG_TELEPORT", c_light_blue );
+        print_hint( text, "PLACE_SPECIAL", c_light_blue );
+        print_hint( text, "PLACE_TERRAIN", c_light_blue );
+        print_hint( text, "SET_SPECIAL_ARGS", c_light_blue );
+        print_hint( text, "MODIFY_HORDE", c_light_blue );
+        print_hint( text, "PRINT_NOISE_MAPS", c_light_blue );
     }
 
     if( ( draw_data.debug_editor && center_vision != om_vision_level::unseen ) ||
         draw_data.debug_info ) {
-        draw_sidebar_text( string_format( "current dimension: %s",
+        add_sidebar_text( text, string_format( "current dimension: %s",
                                           g->get_dimension_prefix().empty() ? "default" : g->get_dimension_prefix() ), c_white );
-        draw_sidebar_text( string_format( "abs_omt: %s", cursor_pos.to_string() ), c_white );
+        add_sidebar_text( text, string_format( "abs_omt: %s", cursor_pos.to_string() ), c_white );
         const oter_t &oter = overmap_buffer.ter( cursor_pos ).obj();
-        draw_sidebar_text( string_format( "oter: %s (rot %d)", oter.id.str(),
+        add_sidebar_text( text, string_format( "oter: %s (rot %d)", oter.id.str(),
                                           oter.get_rotation() ), c_white );
-        draw_sidebar_text( string_format( "oter_type: %s", oter.get_type_id().str() ), c_white );
+        add_sidebar_text( text, string_format( "oter_type: %s", oter.get_type_id().str() ), c_white );
         // tileset ids come with a prefix that must be stripped
-        draw_sidebar_text( string_format( "tileset id: '%s'",
+        add_sidebar_text( text, string_format( "tileset id: '%s'",
                                           oter.get_tileset_id( center_vision ).substr( 3 ) ), c_white );
         std::vector<oter_id> predecessors = overmap_buffer.predecessors( cursor_pos );
         if( !predecessors.empty() ) {
-            draw_sidebar_text( "predecessors:", c_white );
+            add_sidebar_text( text, "predecessors:", c_white );
             for( auto pred = predecessors.rbegin(); pred != predecessors.rend(); ++pred ) {
-                draw_sidebar_text( string_format( "- %s", pred->id().str() ), c_white );
+                add_sidebar_text( text, string_format( "- %s", pred->id().str() ), c_white );
             }
         }
 
         auto print_arguments = [&]( std::unordered_map<std::string, cata_variant> &map ) {
             for( const std::pair<const std::string, cata_variant> &arg : map ) {
-                draw_sidebar_text( string_format( "%s = %s", arg.first, arg.second.get_string() ),
+                add_sidebar_text( text, string_format( "%s = %s", arg.first, arg.second.get_string() ),
                                    c_white );
             }
         };
@@ -368,7 +398,7 @@ void overmap_sidebar::draw_debug()
             if( *args ) {
                 print_arguments( ( **args ).map );
             } else {
-                draw_sidebar_text( "Special scoped parameter values not set yet", c_yellow );
+                add_sidebar_text( text, "Special scoped parameter values not set yet", c_yellow );
             }
         }
         std::optional<mapgen_arguments> args_omt_stack =
@@ -379,7 +409,7 @@ void overmap_sidebar::draw_debug()
 
         for( cube_direction dir : all_enum_values<cube_direction>() ) {
             if( std::string *join = overmap_buffer.join_used_at( { cursor_pos, dir } ) ) {
-                draw_sidebar_text( string_format( "join %s: %s", io::enum_to_string( dir ), *join ),
+                add_sidebar_text( text, string_format( "join %s: %s", io::enum_to_string( dir ), *join ),
                                    c_white );
             }
         }
@@ -393,22 +423,22 @@ void overmap_sidebar::draw_debug()
                 horde_size += horde->size();
                 for( std::pair<const tripoint_abs_ms, horde_entity> &entity : *horde ) {
                     const mtype *horde_type = entity.second.get_type();
-                    ImGui::Indent();
-                    draw_sidebar_text( string_format( "Species: %s", horde_type->nname() ), c_blue );
-                    draw_sidebar_text( string_format( "Interest: %d", entity.second.tracking_intensity ),
+                    text.indent();
+                    add_sidebar_text( text, string_format( "Species: %s", horde_type->nname() ), c_blue );
+                    add_sidebar_text( text, string_format( "Interest: %d", entity.second.tracking_intensity ),
                                        c_blue );
-                    draw_sidebar_text( string_format( "Target: %s",
+                    add_sidebar_text( text, string_format( "Target: %s",
                                                       entity.second.destination.to_string() ), c_blue );
-                    ImGui::Unindent();
+                    text.unindent();
                     //mvwprintz(wbar, desc_pos + point(0, line_number++), c_red, "x"); ???
                 }
             }
-            draw_sidebar_text( string_format( "Horde, population: %d", horde_size ), c_white );
+            add_sidebar_text( text, string_format( "Horde, population: %d", horde_size ), c_white );
         }
     }
 }
 
-void overmap_sidebar::draw_mission_info()
+void overmap_sidebar::build_mission_info( cataimgui::retained_text &text )
 {
     const tripoint_abs_omt &cursor_pos = draw_data.cursor_pos;
     avatar &player_character = get_avatar();
@@ -423,13 +453,13 @@ void overmap_sidebar::draw_mission_info()
         if( current_mission != nullptr ) {
             mission_name = player_character.get_active_mission()->name();
 
-            draw_sidebar_text( _( "Current objective:" ), c_white );
+            add_sidebar_text( text, _( "Current objective:" ), c_white );
         } else {
             mission_name = player_character.get_active_point_of_interest().text;
 
-            draw_sidebar_text( _( "Current Point of Interest:" ), c_white );
+            add_sidebar_text( text, _( "Current Point of Interest:" ), c_white );
         }
-        draw_sidebar_text( mission_name, c_light_blue );
+        add_sidebar_text( text, mission_name, c_light_blue );
         const int above_below = target.z() - cursor_pos.z();
         std::string msg;
         if( above_below > 0 ) {
@@ -443,12 +473,12 @@ void overmap_sidebar::draw_mission_info()
         //~Parenthesis is a real-world value for distance. Example string: "223 tiles (5.35km) ⇗"
         const std::string distance_str = string_format( _( "%1$d tiles (%2$s) %3$s" ),
                                          distance, length_to_string_approx( actual_distance ), dir_arrow );
-        draw_sidebar_text( string_format( _( "Distance: %s" ), distance_str ), c_white );
+        add_sidebar_text( text, string_format( _( "Distance: %s" ), distance_str ), c_white );
         if( !msg.empty() ) {
-            draw_sidebar_text( msg, c_white );
+            add_sidebar_text( text, msg, c_white );
         }
     } else {
-        draw_sidebar_text( _( "No mission selected." ), c_white );
+        add_sidebar_text( text, _( "No mission selected." ), c_white );
     }
 }
 
@@ -2190,6 +2220,9 @@ static tripoint_abs_omt display()
 #else
         action = ictxt.handle_input( get_option<int>( "BLINK_SPEED" ) );
 #endif
+        if( action != "TIMEOUT" && action != "MOUSE_MOVE" ) {
+            om_sidebar.invalidate();
+        }
         if( !display_path.empty() ) {
             std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
             // We go faster per-tile the more we have to go
@@ -2521,12 +2554,16 @@ std::pair<std::string, nc_color> oter_symbol_and_color( const tripoint_abs_omt &
 
     oter_id cur_ter = oter_str_id::NULL_ID();
     avatar &player_character = get_avatar();
-    std::vector<point_abs_omt> plist;
     const bool blink = opts.blink || g->overmap_data.fast_traveling;
-
-    if( blink && !opts.mission_inbounds && opts.mission_target ) {
-        plist = line_to( opts.center.xy(), opts.mission_target->xy() );
-    }
+    // The edge indicator points along this line, which is the same for every tile drawn.
+    const auto on_mission_line = [&opts]( const point_abs_omt & p ) {
+        if( !opts.mission_line ) {
+            const std::vector<point_abs_omt> line = line_to( opts.center.xy(),
+                                                    opts.mission_target->xy() );
+            opts.mission_line.emplace( line.begin(), line.end() );
+        }
+        return opts.mission_line->count( p ) != 0;
+    };
 
     // Only load terrain if we can see it
     if( args.vision != om_vision_level::unseen ) {
@@ -2570,8 +2607,8 @@ std::pair<std::string, nc_color> oter_symbol_and_color( const tripoint_abs_omt &
         } else if( opts.mission_target->z() < opts.center.z() ) {
             ret.first = "v";
         }
-    } else if( !opts.mission_inbounds && !opts.drawn_mission && args.edge_tile &&
-               std::find( plist.begin(), plist.end(), omp.xy() ) != plist.end() ) {
+    } else if( !opts.mission_inbounds && !opts.drawn_mission && args.edge_tile && blink &&
+               opts.mission_target && on_mission_line( omp.xy() ) ) {
         ret.first = "*";
         ret.second = c_red;
         opts.drawn_mission = true;
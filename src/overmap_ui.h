@@ -180,21 +180,32 @@ class overmap_sidebar : public cataimgui::window
 {
         overmap_ui::overmap_draw_data_t &draw_data;
         const input_context &ictxt;
+        // Each part of the sidebar is built only when the cursor moves or after input.
+        cataimgui::retained_text tile_info;
+        cataimgui::retained_text settings_info;
+        cataimgui::retained_text mission_info;
+        cataimgui::retained_text quick_reference;
+        cataimgui::retained_text layer_info;
+        cataimgui::retained_text debug_info;
+        static void add_sidebar_text( cataimgui::retained_text &text,
+                                      const std::string_view &original_text, const nc_color &color );
         //uses input context to print a keybind hint
-        void draw_sidebar_text( const std::string_view &original_text, const nc_color &color );
-        void print_hint( const std::string &action, nc_color color = c_magenta );
-        void draw_tile_info();
-        void draw_mission_info();
-        void draw_settings_info();
-        void draw_quick_reference();
-        void draw_layer_info();
-        void draw_debug();
+        void print_hint( cataimgui::retained_text &text, const std::string &action,
+                         nc_color color = c_magenta );
+        void build_tile_info( cataimgui::retained_text &text );
+        void build_mission_info( cataimgui::retained_text &text );
+        void build_settings_info( cataimgui::retained_text &text );
+        void build_quick_reference( cataimgui::retained_text &text );
+        void build_layer_info( cataimgui::retained_text &text );
+        void build_debug( cataimgui::retained_text &text );
     public:
         int width = 0;
         int x_pos = 0;
         overmap_sidebar( overmap_ui::overmap_draw_data_t &data, const input_context &ictxt );
 
         void init();
+        /** Builds all the text again at the next draw, for after input that may have changed it. */
+        void invalidate();
         void draw_controls() override;
     protected:
         cataimgui::bounds get_bounds() override;
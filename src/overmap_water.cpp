@@ -4,7 +4,6 @@
 #include <cmath>
 #include <cstdlib>
 #include <memory>
-#include <optional>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -259,7 +258,8 @@ void overmap::river_meander( const point_om_omt &river_end, tripoint_om_omt &cur
 void overmap::place_lakes( const std::vector<const overmap *> &neighbor_overmaps )
 {
     const point_abs_omt origin = global_base_point();
-    const om_noise::om_noise_layer_lake noise_func( origin, g->get_seed() );
+    const std::shared_ptr<const om_noise::om_noise_grid> lake_noise =
+        om_noise::water_noise_grid( origin, g->get_seed() );
     const region_settings_lake &settings_lake = settings->get_settings_lake();
     double noise_threshold = settings_lake.noise_threshold_lake;
     const int lake_depth = settings_lake.lake_depth;
@@ -271,7 +271,7 @@ void overmap::place_lakes( const std::vector<const overmap *> &neighbor_overmaps
             point_om_omt( OMAPX + 5, OMAPY + 5 ) );
     const auto is_lake = [&]( const point_om_omt & p ) {
         return considered_bounds.contains( p ) &&
-               settings_lake.invert_lakes ^ omt_lake_noise_threshold( origin, p, noise_threshold );
+               settings_lake.invert_lakes ^ omt_lake_noise_threshold( *lake_noise, p, noise_threshold );
     };
 
     // We'll keep track of our visited lake points so we don't repeat the work.
@@ -407,8 +407,12 @@ void overmap::place_oceans( const std::vector<const overmap *> &neighbor_overmap
                                  !settings_ocean.ocean_start_east.has_value() &&
                                  !settings_ocean.ocean_start_west.has_value() && !settings_ocean.ocean_start_south.has_value();
 
-    const om_noise::om_noise_layer_ocean f( global_base_point(), g->get_seed() );
     const point_abs_om this_om = pos();
+    // The border covers everything is_ocean can look at.
+    std::shared_ptr<const om_noise::om_noise_grid> f;
+    if( !oceans_disabled ) {
+        f = om_noise::water_noise_grid( global_base_point(), g->get_seed() );
+    }
 
     const auto is_ocean = [&]( const point_om_omt & p ) {
         // credit to ehughsbaird for thinking up this inbounds solution to infinite flood fill lag.
@@ -425,7 +429,7 @@ void overmap::place_oceans( const std::vector<const overmap *> &neighbor_overmap
             // It's too soon!  Too soon for an ocean!!  ABORT!!!
             return false;
         }
-        return f.noise_at( p ) + ocean_adjust > settings_ocean.noise_threshold_ocean;
+        return f->noise_at( p ) + ocean_adjust > settings_ocean.noise_threshold_ocean;
     };
 
     const oter_id ocean_surface( "ocean_surface" );
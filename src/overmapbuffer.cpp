@@ -1,7 +1,9 @@
 #include "overmapbuffer.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <iterator>
@@ -10,10 +12,14 @@
 #include <optional>
 #include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "basecamp.h"
 #include "calendar.h"
 #include "cata_assert.h"
+#include "cata_imgui.h"
+#include "cata_scope_helpers.h"
 #include "cata_utility.h"
 #include "character.h"
 #include "character_id.h"
@@ -25,14 +31,15 @@
 #include "filesystem.h"
 #include "flexbuffer_json.h"
 #include "game.h"
+#include "hash_utils.h"
 #include "horde_entity.h"
 #include "horde_map.h"
-#include "imgui/imgui.h"
 #include "json.h"
 #include "line.h"
 #include "map.h"
 #include "mapgendata.h"
 #include "memory_fast.h"
+#include "memory_report.h"
 #include "messages.h"
 #include "mod_manager.h"
 #include "mongroup.h"
@@ -49,9 +56,11 @@
 #include "rng.h"
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
-#include "text.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "vehicle.h"
+#include "weather.h"
+#include "weather_type.h"
 #include "worldfactory.h"
 
 static const oter_type_str_id oter_type_bridgehead_ground( "bridgehead_ground" );
@@ -68,7 +77,7 @@ static int omt_to_sm_copy( int a )
 overmapbuffer overmap_buffer;
 
 overmapbuffer::overmapbuffer()
-    : last_requested_overmap( nullptr )
+    : recent_overmaps()
 {
 }
 
@@ -97,15 +106,31 @@ cata_path overmapbuffer::player_filename( const point_abs_om &p )
             p.y() );
 }
 
+overmap *&overmapbuffer::recent_overmap_slot( const point_abs_om &p ) const
+{
+    // Neighbouring overmaps land in different slots.
+    const unsigned int slot = static_cast<unsigned int>( p.x() ) * 3 +
+                              static_cast<unsigned int>( p.y() );
+    return recent_overmaps[slot % recent_overmaps.size()];
+}
+
 overmap &overmapbuffer::get( const point_abs_om &p )
 {
-    if( last_requested_overmap != nullptr && last_requested_overmap->pos() == p ) {
-        return *last_requested_overmap;
+    overmap *&recent = recent_overmap_slot( p );
+    if( recent != nullptr && recent->pos() == p ) {
+        return *recent;
     }
 
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
-        return *( last_requested_overmap = it->second.get() );
+        return *( recent = it->second.get() );
+    }
+
+    if( generating_ahead != nullptr ) {
+        // Generation reads the overmaps around it, so the one in progress has to be done first.
+        // It may be this one.
+        finish_generating_ahead();
+        return get( p );
     }
 
     // That constructor loads an existing overmap or creates a new one.
@@ -117,23 +142,134 @@ overmap &overmapbuffer::get( const point_abs_om &p )
     fix_mongroups( new_om );
     fix_npcs( new_om );
 
-    last_requested_overmap = &new_om;
+    // Taken again, fix_mongroups may have cached other overmaps in the same slot.
+    recent_overmap_slot( p ) = &new_om;
     return new_om;
 }
 
 void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_special_batch &specials )
 {
-    if( last_requested_overmap != nullptr ) {
-        auto om_iter = overmaps.find( p );
-        if( om_iter != overmaps.end() && om_iter->second.get() == last_requested_overmap ) {
-            last_requested_overmap = nullptr;
-        }
+    if( generating_ahead != nullptr ) {
+        finish_generating_ahead();
+    }
+    overmap *&recent = recent_overmap_slot( p );
+    if( recent != nullptr && recent->pos() == p ) {
+        recent = nullptr;
     }
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     global_state.overmap_count++;
     new_om.populate( specials );
 }
 
+void overmapbuffer::generate_ahead( const tripoint_abs_omt &p )
+{
+    // Far enough that a vehicle at speed doesn't reach the edge before the overmap is there.
+    static constexpr int generate_ahead_distance = OMAPX / 3;
+    // Time spent generating per call, small enough not to be felt in a turn.
+    static constexpr std::chrono::milliseconds generate_ahead_budget( 5 );
+    if( generating_ahead_job != nullptr ) {
+        continue_generating_ahead( generate_ahead_budget );
+        return;
+    }
+    point_abs_om om_pos;
+    point_om_omt local;
+    std::tie( om_pos, local ) = project_remain<coords::om>( p.xy() );
+    point toward;
+    if( local.x() < generate_ahead_distance ) {
+        toward.x = -1;
+    } else if( local.x() >= OMAPX - generate_ahead_distance ) {
+        toward.x = 1;
+    }
+    if( local.y() < generate_ahead_distance ) {
+        toward.y = -1;
+    } else if( local.y() >= OMAPY - generate_ahead_distance ) {
+        toward.y = 1;
+    }
+    for( const point &offset : {
+             point( toward.x, 0 ), point( 0, toward.y ), toward
+         } ) {
+        const point_abs_om candidate = om_pos + offset;
+        if( offset == point::zero || overmaps.count( candidate ) > 0 ||
+            failed_generating_ahead.count( candidate ) > 0 ) {
+            continue;
+        }
+        // One at a time, the next one can wait. Saved ones are only loaded.
+        if( get_existing( candidate ) == nullptr ) {
+            std::unique_ptr<overmap> new_om = std::make_unique<overmap>( candidate );
+            global_state.overmap_count++;
+            // Looks up the neighbours, which may load them.
+            generating_ahead_job = std::make_unique<overmap_generation_job>( *new_om );
+            generating_ahead = std::move( new_om );
+            continue_generating_ahead( generate_ahead_budget );
+        }
+        return;
+    }
+}
+
+overmap *overmapbuffer::continue_generating_ahead( const std::chrono::steady_clock::duration
+        budget )
+{
+    overmap &om = *generating_ahead;
+    const point_abs_om p = om.pos();
+    // While it runs it is in overmaps, as if get were generating it.
+    overmaps[p] = std::move( generating_ahead );
+    bool done = false;
+    bool paused = false;
+    // Unless the job finished, take the overmap out again: to resume it later, or to drop it
+    // with the job if a step threw.
+    on_out_of_scope take_out( [&]() {
+        if( done ) {
+            return;
+        }
+        if( paused ) {
+            generating_ahead = std::move( overmaps[p] );
+        } else {
+            generating_ahead_job.reset();
+            global_state.overmap_count--;
+            failed_generating_ahead.insert( p );
+        }
+        overmaps.erase( p );
+        overmap *&recent = recent_overmap_slot( p );
+        if( recent == &om ) {
+            recent = nullptr;
+        }
+    } );
+    try {
+        done = generating_ahead_job->run_for( budget );
+        paused = !done;
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap (%d,%d) failed to load: %s", p.x(), p.y(), err.what() );
+    }
+    if( !done ) {
+        return nullptr;
+    }
+    generating_ahead_job.reset();
+    fix_mongroups( om );
+    fix_npcs( om );
+    return &om;
+}
+
+void overmapbuffer::finish_generating_ahead()
+{
+    while( generating_ahead_job != nullptr ) {
+        continue_generating_ahead( std::chrono::steady_clock::duration::zero() );
+    }
+}
+
+unsigned int overmapbuffer::generation_seed( const point_abs_om &p ) const
+{
+    std::size_t seed = g->get_seed();
+    cata::hash_combine( seed, p.x() );
+    cata::hash_combine( seed, p.y() );
+    return static_cast<unsigned int>( seed );
+}
+
+unsigned int overmapbuffer::generation_seed( const tripoint_abs_omt &p,
+        std::string_view purpose ) const
+{
+    return rng_stream_seed( g->get_seed(), p, purpose );
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
@@ -253,16 +389,22 @@ void overmapbuffer::save()
 
 void overmapbuffer::reset()
 {
+    generating_ahead_job.reset();
+    generating_ahead.reset();
+    failed_generating_ahead.clear();
     overmaps.clear();
-    last_requested_overmap = nullptr;
+    recent_overmaps.fill( nullptr );
 }
 
 void overmapbuffer::clear()
 {
+    generating_ahead_job.reset();
+    generating_ahead.reset();
+    failed_generating_ahead.clear();
     overmaps.clear();
     known_non_existing.clear();
     global_state.clear();
-    last_requested_overmap = nullptr;
+    recent_overmaps.fill( nullptr );
 }
 
 void overmap_global_state::clear()
@@ -330,12 +472,13 @@ void overmapbuffer::delete_extra( const tripoint_abs_omt &p )
 
 overmap *overmapbuffer::get_existing( const point_abs_om &p )
 {
-    if( last_requested_overmap && last_requested_overmap->pos() == p ) {
-        return last_requested_overmap;
+    overmap *&recent = recent_overmap_slot( p );
+    if( recent && recent->pos() == p ) {
+        return recent;
     }
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
-        return last_requested_overmap = it->second.get();
+        return recent = it->second.get();
     }
     if( known_non_existing.count( p ) > 0 ) {
         // This overmap does not exist on disk (this has already been
@@ -713,14 +856,37 @@ void overmapbuffer::process_mongroups()
     }
 }
 
+// Overmaps the player isn't on only move their hordes every this many turns.
+static constexpr int horde_catch_up_turns = 3;
+
 void overmapbuffer::move_hordes()
 {
     // arbitrary radius to include nearby overmaps (aside from the current one)
     const int radius = MAPSIZE * 2;
     const tripoint_abs_sm center = get_player_character().pos_abs_sm();
+    const point_abs_om player_om = project_to<coords::om>( center.xy() );
+    std::vector<std::pair<overmap *, int>> due;
     for( overmap *&om : get_overmaps_near( center, radius ) ) {
-        om->move_hordes();
+        const int interval = om->pos() == player_om ? 1 : horde_catch_up_turns;
+        const int elapsed = to_turns<int>( calendar::turn - om->last_horde_move );
+        if( elapsed < interval ) {
+            continue;
+        }
+        om->last_horde_move = calendar::turn;
+        due.emplace_back( om, std::min( elapsed, horde_catch_up_turns ) );
     }
+
+    std::vector<std::vector<overmap::horde_move_plan>> plans( due.size() );
+    cata::get_thread_pool().parallel_for( 0, static_cast<int>( due.size() ), [&]( int i ) {
+        plans[i] = due[i].first->plan_horde_moves( due[i].second );
+    } );
+    // Applying touches the reality bubble and neighbouring overmaps, so it stays
+    // serial and in a fixed order to keep the outcome deterministic.
+    std::vector<overmap::horde_arrival> arrivals;
+    for( size_t i = 0; i < due.size(); ++i ) {
+        due[i].first->apply_horde_moves( plans[i], due[i].second, arrivals );
+    }
+    overmap::settle_horde_arrivals( arrivals );
 }
 
 void overmapbuffer::move_nemesis()
@@ -808,6 +974,86 @@ void overmapbuffer::set_scent( const tripoint_abs_omt &loc, int strength )
     om_loc.om->set_scent( loc, new_scent );
 }
 
+void overmapbuffer::note_fire( const tripoint_abs_omt &loc, int fuel )
+{
+    if( fuel <= 0 ) {
+        return;
+    }
+    const overmap_with_local_coords om_loc = get_om_global( loc );
+    om_fire fire;
+    if( const om_fire *existing = om_loc.om->fire_at( loc ) ) {
+        fire.fuel = std::max( existing->fuel, fuel );
+    } else {
+        fire.fuel = fuel;
+    }
+    // The fields it left behind are saved with the submaps, they are as far as it got.
+    fire.materialized = 0xF;
+    om_loc.om->set_fire( loc, fire );
+}
+
+om_fire *overmapbuffer::fire_at( const tripoint_abs_omt &loc )
+{
+    if( const overmap_with_local_coords om_loc = get_existing_om_global( loc ) ) {
+        return om_loc.om->fire_at( loc );
+    }
+    return nullptr;
+}
+
+void overmapbuffer::remove_fire( const tripoint_abs_omt &loc )
+{
+    if( const overmap_with_local_coords om_loc = get_existing_om_global( loc ) ) {
+        om_loc.om->remove_fire( loc );
+    }
+}
+
+// Fuel an overmap fire burns through every step, twice that in the rain.
+static constexpr int overmap_fire_burn_rate = 24;
+// A neighbour with this much fuel would catch every step.
+static constexpr int overmap_fire_spread_odds = 3456;
+
+void overmapbuffer::process_fires()
+{
+    const map &here = get_map();
+    const bool raining = get_weather().weather_id->precip >= precip_class::light;
+    // Collected first: new fires only start burning next step, and may be in another overmap.
+    std::vector<std::pair<tripoint_abs_omt, int>> ignitions;
+    for( std::pair<const point_abs_om, std::unique_ptr<overmap>> &omp : overmaps ) {
+        for( std::pair<const tripoint_abs_omt, om_fire> &fire : omp.second->fires ) {
+            // In the reality bubble the fire fields do the burning.
+            if( fire.second.fuel <= 0 || here.inbounds( fire.first ) ) {
+                continue;
+            }
+            fire.second.fuel = std::max( 0, fire.second.fuel - overmap_fire_burn_rate * ( raining ? 2 : 1 ) );
+            fire.second.materialized = 0;
+            if( fire.second.fuel == 0 || raining ) {
+                continue;
+            }
+            for( const point &offset : four_adjacent_offsets ) {
+                const tripoint_abs_omt next = fire.first + offset;
+                if( here.inbounds( next ) ) {
+                    continue;
+                }
+                point_abs_om next_om;
+                tripoint_om_omt next_local;
+                std::tie( next_om, next_local ) = project_remain<coords::om>( next );
+                // Fires don't spread into overmaps that aren't loaded, nor where one burns or
+                // has burnt out.
+                const auto loaded = overmaps.find( next_om );
+                if( loaded == overmaps.end() || loaded->second->fire_at( next ) != nullptr ) {
+                    continue;
+                }
+                const int fuel = loaded->second->estimated_fire_fuel( next_local );
+                if( fuel > 0 && x_in_y( fuel, overmap_fire_spread_odds ) ) {
+                    ignitions.emplace_back( next, fuel );
+                }
+            }
+        }
+    }
+    for( const std::pair<tripoint_abs_omt, int> &ignition : ignitions ) {
+        note_fire( ignition.first, ignition.second );
+    }
+}
+
 void overmapbuffer::move_vehicle( vehicle *veh, const point_abs_ms &old_msp )
 {
     const point_abs_ms new_msp = veh->pos_abs().xy();
@@ -906,6 +1152,26 @@ const oter_id &overmapbuffer::ter_existing( const tripoint_abs_omt &p )
     return om_loc.om->ter( om_loc.local );
 }
 
+std::vector<oter_id> overmapbuffer::ter_block( const inclusive_rectangle<point_abs_omt> &area,
+        int z )
+{
+    std::vector<oter_id> result;
+    result.reserve( static_cast<size_t>( area.p_max.x() - area.p_min.x() + 1 ) *
+                    ( area.p_max.y() - area.p_min.y() + 1 ) );
+    for( int y = area.p_min.y(); y <= area.p_max.y(); ++y ) {
+        int x = area.p_min.x();
+        while( x <= area.p_max.x() ) {
+            const overmap_with_local_coords om_loc = get_om_global( tripoint_abs_omt( x, y, z ) );
+            // Stay on this overmap until the row runs off its east side.
+            for( tripoint_om_omt local = om_loc.local; x <= area.p_max.x() && local.x() < OMAPX;
+                 ++x, ++local.x() ) {
+                result.push_back( om_loc.om->ter( local ) );
+            }
+        }
+    }
+    return result;
+}
+
 void overmapbuffer::ter_set( const tripoint_abs_omt &p, const oter_id &id )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
@@ -1045,22 +1311,22 @@ overmap_path_params overmap_path_params::for_aircraft()
     return ret;
 }
 
-static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path_params &params )
+// Both take the already looked up overmap of the tile, which is null if it doesn't exist.
+static int get_terrain_cost( const overmap_with_local_coords &om_loc, const oter_id &oter,
+                             const overmap_path_params &params )
 {
     if( params.only_known_by_player &&
-        !overmap_buffer.seen_more_than( omt_pos, om_vision_level::vague ) ) {
+        !( om_loc && om_loc.om->seen( om_loc.local ) > om_vision_level::vague ) ) {
         return -1;
     }
-    if( params.avoid_danger && overmap_buffer.is_marked_dangerous( omt_pos ) ) {
+    if( params.avoid_danger && om_loc && om_loc.om->is_marked_dangerous( om_loc.local ) ) {
         return -1;
     }
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
     return params.get_cost( oter->get_travel_cost_type() );
 }
 
-static bool is_ramp( const tripoint_abs_omt &omt_pos )
+static bool is_ramp( const oter_id &oter )
 {
-    const oter_id &oter = overmap_buffer.ter_existing( omt_pos );
     return ( oter->get_type_id() == oter_type_bridgehead_ground ) ||
            ( oter->get_type_id() == oter_type_bridgehead_ramp );
 }
@@ -1072,8 +1338,12 @@ pf::simple_path<tripoint_abs_omt> overmapbuffer::get_travel_path(
         return {};
     }
 
+    static const oter_id ot_null;
     const pf::omt_scoring_fn estimate = [&]( tripoint_abs_omt pos ) {
-        int cur_cost = get_terrain_cost( pos, params );
+        // Look the overmap up once per node, the checks below all read from it.
+        const overmap_with_local_coords om_loc = get_existing_om_global( pos );
+        const oter_id &oter = om_loc ? om_loc.om->ter( om_loc.local ) : ot_null;
+        int cur_cost = get_terrain_cost( om_loc, oter, params );
         if( cur_cost < 0 ) {
             if( pos == src ) {
                 cur_cost = 0;
@@ -1081,7 +1351,7 @@ pf::simple_path<tripoint_abs_omt> overmapbuffer::get_travel_path(
                 return pf::omt_score::rejected;
             }
         }
-        return pf::omt_score( cur_cost, is_ramp( pos ) );
+        return pf::omt_score( cur_cost, is_ramp( oter ) );
     };
 
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
@@ -1232,26 +1502,55 @@ static omt_find_params assign_params(
     return params;
 }
 
-bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
-        const omt_find_params &params )
+/**
+ * Remembers whether each terrain type matches a search's types, so the string
+ * matching in is_ot_match runs once per terrain type rather than once per tile.
+ */
+class omt_type_matcher
 {
-    bool type_matches = false;
-    if( params.existing_only ) {
-        for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
-            type_matches = check_ot_existing( elem.first, elem.second, location );
-            if( type_matches ) {
-                break;
+    public:
+        explicit omt_type_matcher( const omt_find_params &params ) : params_( &params ) {}
+
+        bool matches( const oter_id &oter ) {
+            const size_t index = oter.to_i();
+            if( index >= known_.size() ) {
+                known_.resize( index + 1, unknown );
             }
-        }
-    } else {
-        for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
-            type_matches = check_ot( elem.first, elem.second, location );
-            if( type_matches ) {
-                break;
+            if( known_[index] == unknown ) {
+                known_[index] = std::any_of( params_->types.begin(), params_->types.end(),
+                [&oter]( const std::pair<std::string, ot_match_type> &elem ) {
+                    return is_ot_match( elem.first, oter, elem.second );
+                } ) ? match : no_match;
             }
+            return known_[index] == match;
         }
+    private:
+        static constexpr int8_t unknown = -1;
+        static constexpr int8_t no_match = 0;
+        static constexpr int8_t match = 1;
+
+        const omt_find_params *params_;
+        std::vector<int8_t> known_;
+};
+
+bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
+        const omt_find_params &params )
+{
+    omt_type_matcher matcher( params );
+    return is_findable_location( location, params, matcher );
+}
+
+bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
+        const omt_find_params &params, omt_type_matcher &matcher )
+{
+    // No types means nothing matches, and no overmap needs to be looked up or generated.
+    if( params.types.empty() ) {
+        return false;
     }
-    if( !type_matches ) {
+    const overmap_with_local_coords om_loc = params.existing_only ?
+            get_existing_om_global( location ) : get_om_global( location );
+    if( !om_loc || !om_loc.om->inbounds( om_loc.local ) ||
+        !matcher.matches( om_loc.om->ter( om_loc.local ) ) ) {
         return false;
     }
 
@@ -1290,8 +1589,9 @@ tripoint_abs_omt overmapbuffer::find_closest(
 tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
+    omt_type_matcher matcher( params );
     // Check the origin before searching adjacent tiles!
-    if( params.min_distance == 0 && is_findable_location( origin, params ) ) {
+    if( params.min_distance == 0 && is_findable_location( origin, params, matcher ) ) {
         return origin;
     }
 
@@ -1332,7 +1632,7 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
                     for( auto &element : om_data.overmap_special_placements ) {
                         if( element.second == special_id ) {
                             const tripoint_abs_omt loc = om_base + element.first.raw();
-                            if( is_findable_location( loc, params ) ) {
+                            if( is_findable_location( loc, params, matcher ) ) {
                                 const int dist_xy = square_dist( origin.xy(), loc.xy() );
 
                                 if( dist_xy >= min_dist && dist_xy < max_dist ) {
@@ -1384,7 +1684,7 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
                     continue;
                 }
 
-                if( is_findable_location( loc, params ) ) {
+                if( is_findable_location( loc, params, matcher ) ) {
                     found_dist = dist;
                     result.push_back( loc );
                 }
@@ -1430,6 +1730,7 @@ tripoint_abs_omt overmapbuffer::find_existing_globally_unique( const tripoint_ab
 std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
+    omt_type_matcher matcher( params );
     std::vector<tripoint_abs_omt> result;
     // dist == 0 means search a whole overmap diameter.
     const int min_dist = params.min_distance;
@@ -1451,7 +1752,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
                 for( auto &element : om_data.overmap_special_placements ) {
                     if( element.second == special_id ) {
                         const tripoint_abs_omt loc = om_base + element.first.raw();
-                        if( is_findable_location( loc, params ) ) {
+                        if( is_findable_location( loc, params, matcher ) ) {
                             const int dist_xy = square_dist( origin.xy(), loc.xy() );
 
                             if( dist_xy >= min_dist && dist_xy < max_dist ) {
@@ -1464,7 +1765,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
         }
     } else {
         for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
-            if( is_findable_location( loc, params ) ) {
+            if( is_findable_location( loc, params, matcher ) ) {
                 result.push_back( loc );
             }
         }
@@ -1857,6 +2158,13 @@ int overmapbuffer::get_unique_special_count( const overmap_special_id &id )
     return global_state.unique_special_count[id];
 }
 
+void overmapbuffer::add_memory_usage( memory_report::report &out ) const
+{
+    for( const auto &[pos, om] : overmaps ) {
+        om->add_memory_usage( out );
+    }
+}
+
 int overmapbuffer::get_overmap_count() const
 {
     return global_state.overmap_count;
@@ -1990,18 +2298,19 @@ std::string overmapbuffer::get_description_at( const tripoint_abs_sm &where, boo
     return string_format( format_string, ter_name, dir_name, closest_city_name );
 }
 
-void overmapbuffer::display_description_at( const tripoint_abs_sm &where, bool draw_origin )
+void overmapbuffer::describe_at( const tripoint_abs_sm &where, bool draw_origin,
+                                cataimgui::retained_text &text )
 {
     const oter_id oter = ter( project_to<coords::omt>( where ) );
     om_vision_level vision = seen( project_to<coords::omt>( where ) );
     nc_color ter_color = oter->get_color( vision );
     std::string ter_name = colorize( oter->get_name( vision ), ter_color );
 
-    auto draw_origin_line = [&draw_origin, &oter]() {
+    auto draw_origin_line = [&draw_origin, &oter, &text]() {
         if( draw_origin ) {
-            ImGui::NewLine();
-            cataimgui::TextColoredParagraph( c_light_gray, get_origin( oter->get_type_id()->src ) );
-            ImGui::NewLine();
+            text.new_line();
+            text.paragraph( get_origin( oter->get_type_id()->src ), c_light_gray );
+            text.new_line();
         }
     };
 
@@ -2013,14 +2322,14 @@ void overmapbuffer::display_description_at( const tripoint_abs_sm &where, bool d
     }
 
     if( where.z() != 0 ) {
-        cataimgui::TextColoredParagraph( ter_color, ter_name );
+        text.paragraph( ter_name, ter_color );
         return;
     }
 
     const city_reference closest_cref = closest_known_city( where );
 
     if( !closest_cref ) {
-        cataimgui::TextColoredParagraph( ter_color, ter_name );
+        text.paragraph( ter_name, ter_color );
         draw_origin_line();
         return;
     }
@@ -2060,8 +2369,7 @@ void overmapbuffer::display_description_at( const tripoint_abs_sm &where, bool d
         }
     }
 
-    cataimgui::TextColoredParagraph( ter_color, string_format( format_string, ter_name, dir_name,
-                                     closest_city_name ) );
+    text.paragraph( string_format( format_string, ter_name, dir_name, closest_city_name ), ter_color );
     draw_origin_line();
 }
 
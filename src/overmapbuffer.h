@@ -4,6 +4,7 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
@@ -35,10 +36,19 @@ class basecamp;
 class character_id;
 class monster;
 class npc;
+class omt_type_matcher;
 class overmap_special;
 class vehicle;
 enum class cube_direction : int;
 enum class oter_travel_cost_type : int;
+namespace cataimgui
+{
+class retained_text;
+} // namespace cataimgui
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 namespace om_direction
 {
 enum class type : int;
@@ -46,6 +56,7 @@ enum class type : int;
 struct horde_entity;
 struct map_data_summary;
 struct mapgen_arguments;
+struct om_fire;
 struct mongroup;
 struct region_settings;
 
@@ -201,6 +212,23 @@ class overmapbuffer
         void clear();
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
 
+        /**
+         * Loads or generates the overmaps the player at @p p is getting close to, before they
+         * cross into them. Does at most one per call, generating it over several calls a few
+         * milliseconds at a time.
+         */
+        void generate_ahead( const tripoint_abs_omt &p );
+        /**
+         * Seed of the random numbers drawn while generating the overmap at @p p. It only depends
+         * on the game seed and @p p, so generating an overmap early doesn't change it.
+         */
+        unsigned int generation_seed( const point_abs_om &p ) const;
+        /**
+         * Seed of the random numbers drawn while generating @p purpose (such as mapgen) at @p p.
+         * Only depends on the game seed, @p p and @p purpose.
+         */
+        unsigned int generation_seed( const tripoint_abs_omt &p, std::string_view purpose ) const;
+
         /**
          * Returns the overmap terrain at the given OMT coordinates.
          * Creates a new overmap if necessary.
@@ -211,6 +239,12 @@ class overmapbuffer
          * Returns ot_null if the point is not in any existing overmap.
          */
         const oter_id &ter_existing( const tripoint_abs_omt &p );
+        /**
+         * Returns the overmap terrain of every OMT in @p area at height @p z, row by row,
+         * creating new overmaps as @ref ter does. Each row looks up its overmaps once
+         * instead of once per OMT.
+         */
+        std::vector<oter_id> ter_block( const inclusive_rectangle<point_abs_omt> &area, int z );
         void ter_set( const tripoint_abs_omt &p, const oter_id &id );
         std::optional<mapgen_arguments> *mapgen_args( const tripoint_abs_omt & );
         std::string *join_used_at( const std::pair<tripoint_abs_omt, cube_direction> & );
@@ -273,6 +307,19 @@ class overmapbuffer
          *     used for determining if a monster can detect the scent.
          */
         void set_scent( const tripoint_abs_omt &loc, int strength );
+        /**
+         * Starts or feeds an overmap fire at @p loc with @p fuel left to burn, for a fire that
+         * was burning when its area left the reality bubble.
+         */
+        void note_fire( const tripoint_abs_omt &loc, int fuel );
+        /** The overmap fire at @p loc, or nullptr. Burnt out fires are kept with no fuel. */
+        om_fire *fire_at( const tripoint_abs_omt &loc );
+        void remove_fire( const tripoint_abs_omt &loc );
+        /**
+         * Lets every overmap fire outside the reality bubble burn for a step and maybe catch
+         * the OMTs next to it. See @ref map::materialize_overmap_fire for how they come back.
+         */
+        void process_fires();
         /**
          * Check for any dangerous monster groups at the global overmap terrain coordinates.
          * If there are any, it's not safe.
@@ -588,7 +635,9 @@ class overmapbuffer
         //TODO: use display_description_at when converting UIs to ImGui
         std::string get_description_at( const tripoint_abs_sm &where, bool draw_origin = true );
 
-        void display_description_at( const tripoint_abs_sm &where, bool draw_origin = true );
+        /** Adds the ImGui version of get_description_at to @p text. */
+        void describe_at( const tripoint_abs_sm &where, bool draw_origin,
+                          cataimgui::retained_text &text );
 
         /**
          * Place the specified overmap special directly on the map using the provided location and rotation.
@@ -623,6 +672,9 @@ class overmapbuffer
         int get_major_river_count() const;
         void inc_major_river_count();
 
+        /** Adds every loaded overmap and what it holds to @p out. */
+        void add_memory_usage( memory_report::report &out ) const;
+
     private:
         /**
          * Common function used by the find_closest/all/random to determine if the location is
@@ -631,6 +683,9 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        /** As above, reusing the matcher's verdicts on terrain types seen earlier in the search. */
+        bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params,
+                                   omt_type_matcher &matcher );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
@@ -638,8 +693,21 @@ class overmapbuffer
          * to not exist on disk. See @ref get_existing for usage.
          */
         mutable std::set<point_abs_om> known_non_existing;
-        // Cached result of previous call to overmapbuffer::get_existing
-        overmap mutable *last_requested_overmap;
+        // Overmaps recently returned by get and get_existing, each one kept in the slot
+        // picked by recent_overmap_slot, so lookups that alternate between a few
+        // neighbouring overmaps don't have to go back to the map. Cleared along with it.
+        mutable std::array<overmap *, 8> recent_overmaps;
+        overmap *&recent_overmap_slot( const point_abs_om &p ) const;
+        // The overmap generate_ahead is generating, and the job doing it. Only in overmaps
+        // while the job runs, get finishes it when asked for it or for another new overmap.
+        std::unique_ptr<overmap> generating_ahead;
+        std::unique_ptr<overmap_generation_job> generating_ahead_job;
+        // Overmaps whose generation ahead threw, not tried again ahead.
+        std::set<point_abs_om> failed_generating_ahead;
+        // Runs the job for @p budget, returns the overmap once it's done and added. A step
+        // that throws drops the overmap and the job, get generates it again from scratch.
+        overmap *continue_generating_ahead( std::chrono::steady_clock::duration budget );
+        void finish_generating_ahead();
 
         /**
          * Get a list of notes in the (loaded) overmaps.
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <climits>
 #include <cstdlib>
 #include <functional>
 #include <memory>
@@ -11,6 +12,7 @@
 #include <queue>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -395,6 +397,429 @@ int map::extra_cost( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
     return pass_cost + avoid_cost;
 }
 
+// Routes longer than this go through the per-submap entrance graph first.
+static constexpr int HIERARCHICAL_ROUTE_MIN_DIST = 4 * SEEX;
+// Cost the abstract graph assigns to traps, dangerous fields and sharp terrain,
+// high enough that they are only planned through when nothing else works.
+static constexpr int ABSTRACT_DANGER_COST = 20;
+
+using submap_costs = std::array<int, SEEX * SEEY>;
+
+void pathfinding_cache::set_submap_graph_dirty( const point_bub_ms &p )
+{
+    const point sm( p.x() / SEEX, p.y() / SEEY );
+    const point local( p.x() % SEEX, p.y() % SEEY );
+    const auto mark = [this]( const point & s ) {
+        if( s.x >= 0 && s.x < MAPSIZE && s.y >= 0 && s.y < MAPSIZE ) {
+            for( std::array<pathfinding_submap_graph, MAPSIZE *MAPSIZE> &graphs : submap_graphs ) {
+                graphs[s.x * MAPSIZE + s.y].dirty = true;
+            }
+        }
+    };
+    mark( sm );
+    // Entrances on a border depend on the tiles on both sides of it
+    if( local.x == 0 ) {
+        mark( sm + point::west );
+    } else if( local.x == SEEX - 1 ) {
+        mark( sm + point::east );
+    }
+    if( local.y == 0 ) {
+        mark( sm + point::north );
+    } else if( local.y == SEEY - 1 ) {
+        mark( sm + point::south );
+    }
+}
+
+void pathfinding_cache::set_submap_graphs_dirty()
+{
+    for( std::array<pathfinding_submap_graph, MAPSIZE *MAPSIZE> &graphs : submap_graphs ) {
+        for( pathfinding_submap_graph &graph : graphs ) {
+            graph.dirty = true;
+        }
+    }
+}
+
+// Cost of stepping onto a tile as far as the abstract graph is concerned, -1 if
+// it blocks. This only looks at the cached flags, the refinement pass runs the
+// real cost functions for the creature in question.
+static int abstract_tile_cost( PathfindingFlags flags, bool doors )
+{
+    if( flags & PathfindingFlag::Air ) {
+        return -1;
+    }
+    if( flags & PathfindingFlag::Obstacle ) {
+        return doors && ( flags & PathfindingFlag::Door ) ? 4 : -1;
+    }
+    if( flags & ( PathfindingFlag::DangerousTrap | PathfindingFlag::DangerousField |
+                  PathfindingFlag::Sharp ) ) {
+        return ABSTRACT_DANGER_COST;
+    }
+    if( flags & ( PathfindingFlag::Slow | PathfindingFlag::Vehicle ) ) {
+        return 4;
+    }
+    return 2;
+}
+
+static point submap_of( const point_bub_ms &p )
+{
+    return point( p.x() / SEEX, p.y() / SEEY );
+}
+
+static point_bub_ms submap_origin( const point &sm )
+{
+    return point_bub_ms( sm.x * SEEX, sm.y * SEEY );
+}
+
+static int index_in_submap( const point_bub_ms &p )
+{
+    return ( p.x() % SEEX ) * SEEY + p.y() % SEEY;
+}
+
+// Cheapest cost from |from| to every tile of its submap without leaving the
+// submap, or -1 for tiles that can't be reached that way.
+static void costs_within_submap( const pathfinding_cache &cache, const point_bub_ms &from,
+                                 bool doors, submap_costs &dist )
+{
+    const point_bub_ms origin = submap_origin( submap_of( from ) );
+    dist.fill( -1 );
+    std::priority_queue<std::pair<int, point_bub_ms>, std::vector<std::pair<int, point_bub_ms>>, pair_greater_cmp_first>
+            open;
+    dist[index_in_submap( from )] = 0;
+    open.emplace( 0, from );
+    while( !open.empty() ) {
+        const std::pair<int, point_bub_ms> top = open.top();
+        open.pop();
+        const point_bub_ms &cur = top.second;
+        if( top.first > dist[index_in_submap( cur )] ) {
+            continue;
+        }
+        for( const tripoint &d : eight_horizontal_neighbors ) {
+            const point_bub_ms p = cur + d.xy();
+            if( p.x() < origin.x() || p.x() >= origin.x() + SEEX ||
+                p.y() < origin.y() || p.y() >= origin.y() + SEEY ) {
+                continue;
+            }
+            const int cost = abstract_tile_cost( cache.special[p], doors );
+            if( cost < 0 ) {
+                continue;
+            }
+            // Same diagonal penalty as the tile level search
+            const int newg = top.first + cost + ( d.x != 0 && d.y != 0 ? 1 : 0 );
+            int &old = dist[index_in_submap( p )];
+            if( old < 0 || newg < old ) {
+                old = newg;
+                open.emplace( newg, p );
+            }
+        }
+    }
+}
+
+static const pathfinding_submap_graph &get_submap_graph( pathfinding_cache &cache,
+        const point &sm, int map_size, bool doors )
+{
+    pathfinding_submap_graph &graph = cache.submap_graphs[doors ? 1 : 0][sm.x * MAPSIZE + sm.y];
+    if( !graph.dirty ) {
+        return graph;
+    }
+
+    graph.entrances.clear();
+    const point_bub_ms origin = submap_origin( sm );
+    const auto usable = [&cache, doors]( const point_bub_ms & p ) {
+        const int cost = abstract_tile_cost( cache.special[p], doors );
+        return cost >= 0 && cost < ABSTRACT_DANGER_COST;
+    };
+    const auto add_entrance = [&graph]( const point_bub_ms & p ) {
+        if( std::find( graph.entrances.begin(), graph.entrances.end(), p ) == graph.entrances.end() ) {
+            graph.entrances.push_back( p );
+        }
+    };
+    // Walks one border from |start| along |step|, |across| points into the neighbour.
+    // The neighbour walks the same pair of rows, so both sides agree on the entrances.
+    const auto add_border = [&]( const point_bub_ms & start, const point & step,
+    const point & across, int length ) {
+        int run_start = -1;
+        for( int i = 0; i <= length; ++i ) {
+            const point_bub_ms p = start + step * i;
+            const bool passable = i < length && usable( p ) && usable( p + across );
+            if( passable && run_start < 0 ) {
+                run_start = i;
+            } else if( !passable && run_start >= 0 ) {
+                const int run_end = i - 1;
+                // Wide openings get an entrance at each end so that routes don't all
+                // funnel through the middle of the border.
+                if( run_end - run_start >= 5 ) {
+                    add_entrance( start + step * run_start );
+                    add_entrance( start + step * run_end );
+                } else {
+                    add_entrance( start + step * ( ( run_start + run_end ) / 2 ) );
+                }
+                run_start = -1;
+            }
+        }
+    };
+    if( sm.x > 0 ) {
+        add_border( origin, point::south, point::west, SEEY );
+    }
+    if( sm.x < map_size - 1 ) {
+        add_border( origin + point( SEEX - 1, 0 ), point::south, point::east, SEEY );
+    }
+    if( sm.y > 0 ) {
+        add_border( origin, point::east, point::north, SEEX );
+    }
+    if( sm.y < map_size - 1 ) {
+        add_border( origin + point( 0, SEEY - 1 ), point::east, point::south, SEEX );
+    }
+
+    const size_t num = graph.entrances.size();
+    graph.costs.assign( num * num, -1 );
+    submap_costs dist;
+    for( size_t i = 0; i < num; ++i ) {
+        costs_within_submap( cache, graph.entrances[i], doors, dist );
+        for( size_t j = 0; j < num; ++j ) {
+            graph.costs[i * num + j] = dist[index_in_submap( graph.entrances[j] )];
+        }
+    }
+    graph.dirty = false;
+    return graph;
+}
+
+std::optional<std::vector<tripoint_bub_ms>> map::route_hierarchical( const tripoint_bub_ms &f,
+        const pathfinding_target &target, const pathfinding_settings &settings,
+        const std::function<bool( const tripoint_bub_ms & )> &avoid ) const
+{
+    const tripoint_bub_ms &t = target.center;
+    // Brings |special| up to date, which also flags the submap graphs that changed
+    get_pathfinding_cache_ref( f.z() );
+    pathfinding_cache &cache = get_pathfinding_cache( f.z() );
+    const bool doors = settings.allow_open_doors;
+    const int map_size = getmapsize();
+    const point goal_sm = submap_of( t.xy() );
+
+    submap_costs start_dist;
+    submap_costs goal_dist;
+    costs_within_submap( cache, f.xy(), doors, start_dist );
+    costs_within_submap( cache, t.xy(), doors, goal_dist );
+
+    // A* over the entrance tiles. Node 0 is the start, node 1 the goal.
+    struct abstract_node {
+        point_bub_ms pos;
+        int gscore;
+        int parent;
+        bool closed;
+    };
+    constexpr int goal_id = 1;
+    std::vector<abstract_node> nodes = {
+        { f.xy(), 0, -1, false },
+        { t.xy(), INT_MAX, -1, false }
+    };
+    std::unordered_map<point_bub_ms, int> node_ids;
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, pair_greater_cmp_first>
+            open;
+    const auto relax = [&]( int from, const point_bub_ms & p, int cost, bool is_goal ) {
+        const int newg = nodes[from].gscore + cost;
+        int id = goal_id;
+        if( !is_goal ) {
+            const auto inserted = node_ids.emplace( p, static_cast<int>( nodes.size() ) );
+            if( inserted.second ) {
+                nodes.push_back( { p, INT_MAX, -1, false } );
+            }
+            id = inserted.first->second;
+        }
+        abstract_node &n = nodes[id];
+        if( n.closed || newg >= n.gscore ) {
+            return;
+        }
+        n.gscore = newg;
+        n.parent = from;
+        open.emplace( newg + 2 * rl_dist( p, t.xy() ), id );
+    };
+
+    const pathfinding_submap_graph &start_graph = get_submap_graph( cache, submap_of( f.xy() ),
+            map_size, doors );
+    for( const point_bub_ms &e : start_graph.entrances ) {
+        const int cost = start_dist[index_in_submap( e )];
+        if( cost >= 0 ) {
+            relax( 0, e, cost, false );
+        }
+    }
+
+    bool found = false;
+    while( !open.empty() ) {
+        const int id = open.top().second;
+        open.pop();
+        if( nodes[id].closed ) {
+            continue;
+        }
+        nodes[id].closed = true;
+        if( id == goal_id ) {
+            found = true;
+            break;
+        }
+        if( nodes[id].gscore > settings.max_length ) {
+            // Same as the tile level search: the best route is too long
+            return std::vector<tripoint_bub_ms>();
+        }
+
+        const point_bub_ms cur = nodes[id].pos;
+        const point sm = submap_of( cur );
+        const pathfinding_submap_graph &graph = get_submap_graph( cache, sm, map_size, doors );
+        const size_t num = graph.entrances.size();
+        const size_t i = std::find( graph.entrances.begin(), graph.entrances.end(),
+                                    cur ) - graph.entrances.begin();
+        for( size_t j = 0; i < num && j < num; ++j ) {
+            const int cost = graph.costs[i * num + j];
+            if( cost > 0 ) {
+                relax( id, graph.entrances[j], cost, false );
+            }
+        }
+        if( sm == goal_sm ) {
+            const int cost = goal_dist[index_in_submap( cur )];
+            if( cost >= 0 ) {
+                relax( id, t.xy(), cost, true );
+            }
+        }
+        // Cross over into the neighbouring submaps
+        for( const point &d : four_adjacent_offsets ) {
+            const point_bub_ms p = cur + d;
+            const point other_sm = submap_of( p );
+            if( p.x() < 0 || p.y() < 0 || other_sm == sm ||
+                other_sm.x >= map_size || other_sm.y >= map_size ) {
+                continue;
+            }
+            const pathfinding_submap_graph &other = get_submap_graph( cache, other_sm, map_size, doors );
+            if( std::find( other.entrances.begin(), other.entrances.end(), p ) != other.entrances.end() ) {
+                relax( id, p, abstract_tile_cost( cache.special[p], doors ), false );
+            }
+        }
+    }
+    if( !found ) {
+        // Might still be reachable by climbing, bashing or changing z-levels
+        return std::nullopt;
+    }
+
+    std::vector<point_bub_ms> waypoints;
+    for( int id = nodes[goal_id].parent; id > 0; id = nodes[id].parent ) {
+        waypoints.push_back( nodes[id].pos );
+    }
+    std::reverse( waypoints.begin(), waypoints.end() );
+
+    // Refine every leg with the regular search, which is cheap over such short distances
+    std::vector<tripoint_bub_ms> ret;
+    tripoint_bub_ms cur = f;
+    for( const point_bub_ms &wp : waypoints ) {
+        const tripoint_bub_ms next( wp, f.z() );
+        if( square_dist( cur, next ) == 1 ) {
+            if( avoid( next ) ||
+                extra_cost( cur, next, settings, cache.special[next.xy()] ) < 0 ) {
+                return std::nullopt;
+            }
+            ret.push_back( next );
+        } else {
+            const std::vector<tripoint_bub_ms> leg = route( cur, pathfinding_target::point( next ), settings,
+                    avoid );
+            if( leg.empty() ) {
+                return std::nullopt;
+            }
+            ret.insert( ret.end(), leg.begin(), leg.end() );
+        }
+        cur = next;
+    }
+    if( !target.contains( cur ) ) {
+        const std::vector<tripoint_bub_ms> leg = route( cur, target, settings, avoid );
+        if( leg.empty() ) {
+            return std::nullopt;
+        }
+        ret.insert( ret.end(), leg.begin(), leg.end() );
+    }
+    return ret;
+}
+
+// Route requests to the same target in one turn before the rest of them share
+// a flow field instead of searching on their own.
+static constexpr int FLOW_FIELD_MIN_REQUESTS = 4;
+
+std::optional<std::vector<tripoint_bub_ms>> map::route_by_flow_field( const tripoint_bub_ms &f,
+        const pathfinding_target &target, const pathfinding_settings &settings,
+        const std::function<bool( const tripoint_bub_ms & )> &avoid ) const
+{
+    route_memo::flow_field &field = route_memos->get_flow_field( target, settings );
+    if( ++field.requests < FLOW_FIELD_MIN_REQUESTS ) {
+        return std::nullopt;
+    }
+
+    const tripoint_bub_ms &t = target.center;
+    constexpr std::array<int, 8> x_offset{ { -1,  1,  0,  0,  1, -1, -1, 1 } };
+    constexpr std::array<int, 8> y_offset{ {  0,  0, -1,  1, -1,  1, -1, 1 } };
+    if( !field.built ) {
+        field.built = true;
+        field.cost.assign( MAPSIZE_X * MAPSIZE_Y, -1 );
+        field.next.assign( MAPSIZE_X * MAPSIZE_Y, -1 );
+        const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z() );
+        const int size_x = getmapsize() * SEEX;
+        const int size_y = getmapsize() * SEEY;
+        std::priority_queue<std::pair<int, point_bub_ms>, std::vector<std::pair<int, point_bub_ms>>, pair_greater_cmp_first>
+                open;
+        for( const tripoint_bub_ms &p : points_in_radius( t, target.r ) ) {
+            if( inbounds( p ) && target.contains( p ) ) {
+                field.cost[flat_index( p.xy() )] = 0;
+                open.emplace( 0, p.xy() );
+            }
+        }
+        // Searched backwards from the target: expanding |cur| settles the cost
+        // of each neighbour stepping onto it.
+        while( !open.empty() ) {
+            const std::pair<int, point_bub_ms> top = open.top();
+            open.pop();
+            const point_bub_ms &cur = top.second;
+            if( top.first > field.cost[flat_index( cur )] || top.first > settings.max_length ) {
+                continue;
+            }
+            const tripoint_bub_ms cur_3d( cur, t.z() );
+            const PathfindingFlags cur_special = pf_cache.special[cur];
+            // Same as the tile level search: nothing that avoids traps walks onto air
+            if( top.first > 0 && settings.avoid_traps && ( cur_special & PathfindingFlag::Air ) ) {
+                continue;
+            }
+            for( size_t i = 0; i < 8; i++ ) {
+                const point_bub_ms p( cur.x() + x_offset[i], cur.y() + y_offset[i] );
+                if( p.x() < 0 || p.x() >= size_x || p.y() < 0 || p.y() >= size_y ) {
+                    continue;
+                }
+                const int cost = extra_cost( tripoint_bub_ms( p, t.z() ), cur_3d, settings, cur_special );
+                if( cost < 0 ) {
+                    continue;
+                }
+                const int newg = top.first + cost + ( x_offset[i] != 0 && y_offset[i] != 0 ? 1 : 0 );
+                const int index = flat_index( p );
+                if( field.cost[index] < 0 || newg < field.cost[index] ) {
+                    field.cost[index] = newg;
+                    field.next[index] = static_cast<int8_t>( i );
+                    open.emplace( newg, p );
+                }
+            }
+        }
+    }
+
+    if( field.cost[flat_index( f.xy() )] < 0 ) {
+        return std::nullopt;
+    }
+    std::vector<tripoint_bub_ms> ret;
+    tripoint_bub_ms cur = f;
+    // Costs strictly decrease along |next|, so this always ends on the target
+    while( !target.contains( cur ) ) {
+        const int8_t dir = field.next[flat_index( cur.xy() )];
+        if( dir < 0 ) {
+            return std::nullopt;
+        }
+        cur = tripoint_bub_ms( cur.x() - x_offset[dir], cur.y() - y_offset[dir], cur.z() );
+        if( !target.contains( cur ) && avoid( cur ) ) {
+            return std::nullopt;
+        }
+        ret.push_back( cur );
+    }
+    return ret;
+}
+
 std::vector<tripoint_bub_ms> map::route( const Creature &who,
         const pathfinding_target &target ) const
 {
@@ -450,6 +875,29 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
         return ret;
     }
 
+    if( std::optional<std::vector<tripoint_bub_ms>> memo = route_memos->find( abs_sub, f, target,
+            settings, avoid ) ) {
+        return *memo;
+    }
+
+    if( f.z() == t.z() ) {
+        std::optional<std::vector<tripoint_bub_ms>> flow = route_by_flow_field( f, target, settings,
+                avoid );
+        if( flow ) {
+            route_memos->add( f, target, settings, *flow );
+            return *flow;
+        }
+    }
+
+    if( f.z() == t.z() && rl_dist( f, t ) > HIERARCHICAL_ROUTE_MIN_DIST ) {
+        std::optional<std::vector<tripoint_bub_ms>> hierarchical = route_hierarchical( f, target,
+                settings, avoid );
+        if( hierarchical ) {
+            route_memos->add( f, target, settings, *hierarchical );
+            return *hierarchical;
+        }
+    }
+
     const int max_length = settings.max_length;
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
@@ -687,6 +1135,7 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f,
         }
 
         std::reverse( ret.begin(), ret.end() );
+        route_memos->add( f, target, settings, ret );
     }
 
     return ret;
@@ -1221,3 +1670,97 @@ bool pathfinding_target::contains( const tripoint_bub_ms &p ) const
     }
     return square_dist( center, p ) <= r;
 }
+
+bool pathfinding_settings::operator==( const pathfinding_settings &rhs ) const
+{
+    return bash_strength == rhs.bash_strength && max_dist == rhs.max_dist &&
+           max_length == rhs.max_length && climb_cost == rhs.climb_cost &&
+           allow_open_doors == rhs.allow_open_doors && allow_unlock_doors == rhs.allow_unlock_doors &&
+           avoid_traps == rhs.avoid_traps && allow_climb_stairs == rhs.allow_climb_stairs &&
+           avoid_rough_terrain == rhs.avoid_rough_terrain && avoid_sharp == rhs.avoid_sharp &&
+           avoid_dangerous_fields == rhs.avoid_dangerous_fields && size == rhs.size;
+}
+
+route_memo::route_group *route_memo::find_group( const pathfinding_target &target,
+        const pathfinding_settings &settings )
+{
+    for( route_group &group : groups ) {
+        if( group.center == target.center && group.r == target.r && group.settings == settings ) {
+            return &group;
+        }
+    }
+    return nullptr;
+}
+
+std::optional<std::vector<tripoint_bub_ms>> route_memo::find( const tripoint_abs_sm &map_origin,
+        const tripoint_bub_ms &f, const pathfinding_target &target,
+        const pathfinding_settings &settings,
+        const std::function<bool( const tripoint_bub_ms & )> &avoid )
+{
+    if( turn != calendar::turn || origin != map_origin ) {
+        clear();
+        turn = calendar::turn;
+        origin = map_origin;
+        return std::nullopt;
+    }
+    const route_group *group = find_group( target, settings );
+    if( group == nullptr ) {
+        return std::nullopt;
+    }
+    const auto start = group->starts.find( f );
+    if( start == group->starts.end() ) {
+        return std::nullopt;
+    }
+    const std::vector<tripoint_bub_ms> &route = group->routes[start->second.first];
+    std::vector<tripoint_bub_ms> ret( route.begin() + start->second.second, route.end() );
+    // The stored route may come from a creature that avoids less than this one
+    for( const tripoint_bub_ms &p : ret ) {
+        if( !target.contains( p ) && avoid( p ) ) {
+            return std::nullopt;
+        }
+    }
+    return ret;
+}
+
+void route_memo::add( const tripoint_bub_ms &f, const pathfinding_target &target,
+                      const pathfinding_settings &settings, const std::vector<tripoint_bub_ms> &route )
+{
+    if( route.empty() ) {
+        return;
+    }
+    route_group *group = find_group( target, settings );
+    if( group == nullptr ) {
+        group = &groups.emplace_back();
+        group->center = target.center;
+        group->r = target.r;
+        group->settings = settings;
+    }
+    const size_t index = group->routes.size();
+    group->routes.push_back( route );
+    // Every tile on a shortest route has the rest of that route as its own shortest route
+    group->starts.emplace( f, std::make_pair( index, size_t( 0 ) ) );
+    for( size_t i = 0; i + 1 < route.size(); ++i ) {
+        group->starts.emplace( route[i], std::make_pair( index, i + 1 ) );
+    }
+}
+
+route_memo::flow_field &route_memo::get_flow_field( const pathfinding_target &target,
+        const pathfinding_settings &settings )
+{
+    for( flow_field &field : flow_fields ) {
+        if( field.center == target.center && field.r == target.r && field.settings == settings ) {
+            return field;
+        }
+    }
+    flow_field &field = flow_fields.emplace_back();
+    field.center = target.center;
+    field.r = target.r;
+    field.settings = settings;
+    return field;
+}
+
+void route_memo::clear()
+{
+    groups.clear();
+    flow_fields.clear();
+}
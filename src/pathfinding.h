@@ -2,14 +2,18 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <optional>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "calendar.h"
 #include "coordinates.h"
+#include "map_scale_constants.h"
 #include "mdarray.h"
 #include "point.h"
 #include "type_id.h"
@@ -92,6 +96,13 @@ class PathfindingFlags
             return is_any_set();
         }
 
+        constexpr bool operator==( PathfindingFlags rhs ) const {
+            return flags_ == rhs.flags_;
+        }
+        constexpr bool operator!=( PathfindingFlags rhs ) const {
+            return flags_ != rhs.flags_;
+        }
+
         constexpr PathfindingFlags &operator|=( PathfindingFlags flags ) {
             set_union( flags );
             return *this;
@@ -131,6 +142,16 @@ constexpr PathfindingFlags operator |( const PathfindingFlag &a, const Pathfindi
     return PathfindingFlags( a ) | PathfindingFlags( b );
 }
 
+// Abstract view of a single submap for hierarchical routing: the tiles through
+// which it can be entered from a neighbouring submap, and the cost of walking
+// between every pair of them without leaving the submap.
+struct pathfinding_submap_graph {
+    bool dirty = true;
+    std::vector<point_bub_ms> entrances;
+    // costs[i * entrances.size() + j], -1 if j can't be reached from i inside the submap
+    std::vector<int> costs;
+};
+
 struct pathfinding_cache {
     pathfinding_cache();
 
@@ -138,6 +159,14 @@ struct pathfinding_cache {
     std::unordered_set<point_bub_ms> dirty_points;
 
     cata::mdarray<PathfindingFlags, point_bub_ms> special;
+
+    // Built lazily from |special|, indexed [doors passable][smx * MAPSIZE + smy].
+    // A submap's graphs are marked dirty whenever one of its tiles (or a tile
+    // right across its border) changes flags.
+    std::array<std::array<pathfinding_submap_graph, MAPSIZE *MAPSIZE>, 2> submap_graphs;
+
+    void set_submap_graph_dirty( const point_bub_ms &p );
+    void set_submap_graphs_dirty();
 };
 
 struct pathfinding_settings {
@@ -171,6 +200,8 @@ struct pathfinding_settings {
           avoid_rough_terrain( art ), avoid_sharp( as ), size( sz )  {}
 
     pathfinding_settings &operator=( const pathfinding_settings & ) = default;
+
+    bool operator==( const pathfinding_settings &rhs ) const;
 };
 
 struct pathfinding_target {
@@ -194,6 +225,60 @@ struct pathfinding_target {
     }
 };
 
+// Routes found during the current turn, so that creatures heading for the same
+// target with the same settings can reuse them, including from any tile along
+// an earlier route. Also holds the flow fields built for popular targets.
+// Everything is dropped when the turn changes, the map shifts
+// or the pathfinding cache of any level is marked dirty.
+class route_memo
+{
+    public:
+        // A stored route from |f| to |target|, or nullopt if there is none or
+        // |avoid| rejects one of its tiles.
+        std::optional<std::vector<tripoint_bub_ms>> find( const tripoint_abs_sm &origin,
+                const tripoint_bub_ms &f, const pathfinding_target &target,
+                const pathfinding_settings &settings,
+                const std::function<bool( const tripoint_bub_ms & )> &avoid );
+        void add( const tripoint_bub_ms &f, const pathfinding_target &target,
+                  const pathfinding_settings &settings, const std::vector<tripoint_bub_ms> &route );
+        void clear();
+
+        // Cost to reach a shared target from every tile of its z-level, see
+        // map::route_by_flow_field. Indexed like the pathfinder's layers.
+        struct flow_field {
+            tripoint_bub_ms center;
+            int r = 0;
+            pathfinding_settings settings;
+            // Routes asked for to this target this turn, the field is only
+            // worth building once several creatures share it
+            int requests = 0;
+            bool built = false;
+            std::vector<int> cost;
+            // Index into eight_horizontal_neighbors of the step towards the target, -1 if none
+            std::vector<int8_t> next;
+        };
+        flow_field &get_flow_field( const pathfinding_target &target,
+                                    const pathfinding_settings &settings );
+
+    private:
+        struct route_group {
+            tripoint_bub_ms center;
+            int r = 0;
+            pathfinding_settings settings;
+            std::vector<std::vector<tripoint_bub_ms>> routes;
+            // Tile -> (route, index of the first step taken from that tile)
+            std::unordered_map<tripoint_bub_ms, std::pair<size_t, size_t>> starts;
+        };
+
+        route_group *find_group( const pathfinding_target &target,
+                                 const pathfinding_settings &settings );
+
+        time_point turn = calendar::turn_zero;
+        tripoint_abs_sm origin;
+        std::vector<route_group> groups;
+        std::vector<flow_field> flow_fields;
+};
+
 // Returns true when the character is an avatar dragging a single-tile
 // vehicle, meaning grab-aware pathfinding (route_with_grab) should be used.
 bool has_grabbed_single_tile_vehicle( const Character &you, const map &here );
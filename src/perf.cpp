@@ -1,5 +1,15 @@
 #include "perf.h"
 
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "json.h"
+
 cata_timer::timers_map &cata_timer::top_level_timer_map()
 {
     static cata_timer::timers_map map;
@@ -11,3 +21,256 @@ std::vector<cata_timer::timers_map::iterator> &cata_timer::timer_stack()
     static std::vector<cata_timer::timers_map::iterator> stack;
     return stack;
 }
+
+namespace perf_trace
+{
+
+namespace
+{
+
+struct event {
+    uint32_t zone;
+    clock::time_point start;
+    clock::time_point end;
+};
+
+// Per thread, about 1.5 MiB, allocated the first time the thread records a zone.
+constexpr size_t ring_size = 1 << 16;
+
+struct thread_ring {
+    explicit thread_ring( int tid ) : tid( tid ), events( ring_size ) {}
+    int tid;
+    // Only ever advanced by the owning thread.
+    std::atomic<uint64_t> written{ 0 };
+    // Events before this are in a closed turn, guarded by registry_mutex.
+    uint64_t folded = 0;
+    std::vector<event> events;
+};
+
+struct zone_turn {
+    clock::duration time = clock::duration::zero();
+    uint32_t calls = 0;
+};
+
+std::mutex registry_mutex;
+clock::time_point origin;
+// The closed turns by zone index, oldest first.
+std::deque<std::vector<zone_turn>> turns;
+
+std::vector<std::string> &zone_names()
+{
+    static std::vector<std::string> names;
+    return names;
+}
+
+std::vector<std::unique_ptr<thread_ring>> &rings()
+{
+    static std::vector<std::unique_ptr<thread_ring>> all;
+    return all;
+}
+
+thread_ring &this_thread_ring()
+{
+    thread_local thread_ring *ring = nullptr;
+    if( ring == nullptr ) {
+        std::lock_guard<std::mutex> lock( registry_mutex );
+        std::vector<std::unique_ptr<thread_ring>> &all = rings();
+        ring = all.emplace_back( std::make_unique<thread_ring>( static_cast<int>( all.size() + 1 ) ) ).get();
+    }
+    return *ring;
+}
+
+int64_t to_us( clock::duration d )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( d ).count();
+}
+
+} // namespace
+
+namespace detail
+{
+
+std::atomic<bool> recording{ false };
+
+void record( zone_id zone, clock::time_point start, clock::time_point end )
+{
+    thread_ring &ring = this_thread_ring();
+    const uint64_t n = ring.written.load( std::memory_order_relaxed );
+    ring.events[n % ring_size] = { zone.index, start, end };
+    ring.written.store( n + 1, std::memory_order_release );
+}
+
+} // namespace detail
+
+zone_id intern( std::string_view name )
+{
+    std::lock_guard<std::mutex> lock( registry_mutex );
+    std::vector<std::string> &names = zone_names();
+    for( size_t i = 0; i < names.size(); ++i ) {
+        if( names[i] == name ) {
+            return zone_id{ static_cast<uint32_t>( i ) };
+        }
+    }
+    names.emplace_back( name );
+    return zone_id{ static_cast<uint32_t>( names.size() - 1 ) };
+}
+
+std::string name( zone_id zone )
+{
+    std::lock_guard<std::mutex> lock( registry_mutex );
+    const std::vector<std::string> &names = zone_names();
+    return zone.index < names.size() ? names[zone.index] : std::string();
+}
+
+void start()
+{
+    std::lock_guard<std::mutex> lock( registry_mutex );
+    for( const std::unique_ptr<thread_ring> &ring : rings() ) {
+        ring->written.store( 0, std::memory_order_relaxed );
+        ring->folded = 0;
+    }
+    turns.clear();
+    origin = clock::now();
+    detail::recording.store( true, std::memory_order_release );
+}
+
+void stop()
+{
+    detail::recording.store( false, std::memory_order_release );
+}
+
+bool write( const cata_path &path )
+{
+    std::lock_guard<std::mutex> lock( registry_mutex );
+    const std::vector<std::string> &names = zone_names();
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, false );
+        jsout.start_object();
+        jsout.member( "displayTimeUnit", "ms" );
+        jsout.member( "traceEvents" );
+        jsout.start_array();
+        for( const std::unique_ptr<thread_ring> &ring : rings() ) {
+            const uint64_t written = ring->written.load( std::memory_order_acquire );
+            const uint64_t first = written > ring_size ? written - ring_size : 0;
+            for( uint64_t i = first; i < written; ++i ) {
+                const event &e = ring->events[i % ring_size];
+                if( e.start < origin ) {
+                    continue;
+                }
+                jsout.start_object();
+                jsout.member( "name", names[e.zone] );
+                // a complete event, with its duration
+                jsout.member( "ph", "X" );
+                jsout.member( "ts", to_us( e.start - origin ) );
+                jsout.member( "dur", to_us( e.end - e.start ) );
+                jsout.member( "pid", 1 );
+                jsout.member( "tid", ring->tid );
+                jsout.end_object();
+            }
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, "hot path trace" );
+}
+
+void end_turn()
+{
+    if( !is_recording() ) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock( registry_mutex );
+    std::vector<zone_turn> turn( zone_names().size() );
+    for( const std::unique_ptr<thread_ring> &ring : rings() ) {
+        const uint64_t written = ring->written.load( std::memory_order_acquire );
+        // Whatever the ring already wrapped over is lost to this turn.
+        const uint64_t first = std::max( ring->folded, written > ring_size ? written - ring_size : 0 );
+        for( uint64_t i = first; i < written; ++i ) {
+            const event &e = ring->events[i % ring_size];
+            turn[e.zone].time += e.end - e.start;
+            ++turn[e.zone].calls;
+        }
+        ring->folded = written;
+    }
+    turns.emplace_back( std::move( turn ) );
+    if( turns.size() > static_cast<size_t>( turn_history ) ) {
+        turns.pop_front();
+    }
+}
+
+std::vector<zone_turn_stats> recent_turns()
+{
+    std::lock_guard<std::mutex> lock( registry_mutex );
+    const std::vector<std::string> &names = zone_names();
+    std::vector<zone_turn_stats> stats;
+    if( turns.empty() ) {
+        return stats;
+    }
+    const auto to_ms = []( clock::duration d ) {
+        return std::chrono::duration<double, std::milli>( d ).count();
+    };
+    for( size_t zone = 0; zone < names.size(); ++zone ) {
+        zone_turn_stats s;
+        uint64_t calls = 0;
+        for( const std::vector<zone_turn> &turn : turns ) {
+            // Zones interned after a turn closed took nothing in it.
+            if( zone >= turn.size() ) {
+                continue;
+            }
+            const double ms = to_ms( turn[zone].time );
+            s.mean_ms += ms;
+            s.max_ms = std::max( s.max_ms, ms );
+            calls += turn[zone].calls;
+        }
+        if( calls == 0 ) {
+            continue;
+        }
+        const std::vector<zone_turn> &last = turns.back();
+        s.name = names[zone];
+        s.last_ms = zone < last.size() ? to_ms( last[zone].time ) : 0.0;
+        s.mean_ms /= turns.size();
+        s.mean_calls = static_cast<double>( calls ) / turns.size();
+        stats.emplace_back( std::move( s ) );
+    }
+    std::stable_sort( stats.begin(), stats.end(), []( const zone_turn_stats & a,
+    const zone_turn_stats & b ) {
+        return a.mean_ms > b.mean_ms;
+    } );
+    return stats;
+}
+
+int recent_turn_count()
+{
+    std::lock_guard<std::mutex> lock( registry_mutex );
+    return static_cast<int>( turns.size() );
+}
+
+std::string allocation_tag_name( uint32_t tag )
+{
+    if( tag == 0 ) {
+        return "untagged";
+    }
+    std::string zone = name( zone_id{ tag - 1 } );
+    if( tag == cata::allocation_tag_count - 1 ) {
+        zone += " and later zones";
+    }
+    return zone;
+}
+
+void log_allocations()
+{
+    if constexpr( !cata::allocation_tracking_enabled() ) {
+        return;
+    }
+    std::vector<cata::allocation_tag_stats> stats = cata::get_allocation_tag_stats();
+    std::sort( stats.begin(), stats.end(), []( const cata::allocation_tag_stats & a,
+    const cata::allocation_tag_stats & b ) {
+        return a.live_bytes > b.live_bytes;
+    } );
+    for( const cata::allocation_tag_stats &s : stats ) {
+        DebugLog( DebugLevel::D_INFO, D_MAIN ) << "allocations by " << allocation_tag_name( s.tag )
+                                               << ": " << s.allocations << " allocs, " << s.frees << " frees, "
+                                               << s.allocated_bytes << " bytes allocated, " << s.live_bytes << " bytes live";
+    }
+}
+
+} // namespace perf_trace
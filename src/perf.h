@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <iostream>
@@ -13,8 +14,11 @@
 #include <utility>
 #include <vector>
 
+#include "cata_allocator.h"
 #include "debug.h"
 
+class cata_path;
+
 struct cata_timer {
         struct timer_stats {
             std::string name;
@@ -80,4 +84,108 @@ struct cata_timer {
         static std::vector<timers_map::iterator> &timer_stack();
 };
 
+/**
+ * Zones traced on hot paths during play, for a flame chart of where each turn goes.
+ *
+ * Nothing is recorded until @ref start, after that every thread records the zones it leaves
+ * into its own ring buffer, keeping the most recent events. No locks are taken and no strings
+ * built while recording, zone names are interned once per zone site. @ref write produces a
+ * Chrome trace that chrome://tracing or Perfetto can open. Start and write it between turns,
+ * while the thread pool is idle.
+ */
+namespace perf_trace
+{
+
+using clock = std::chrono::steady_clock;
+
+struct zone_id {
+    uint32_t index;
+};
+
+/** The same id for every call with the same name. Takes a lock, so call it once per site. */
+zone_id intern( std::string_view name );
+/** The name @p zone was interned with. */
+std::string name( zone_id zone );
+
+/** Drops everything recorded so far and records from now on. */
+void start();
+void stop();
+/** Writes what's in the ring buffers, returns false if it couldn't. */
+bool write( const cata_path &path );
+
+/** Turns kept for @ref recent_turns. */
+constexpr int turn_history = 100;
+
+/** What one zone took over the recent turns, inclusive of its nested zones, summed over threads. */
+struct zone_turn_stats {
+    std::string name;
+    double last_ms = 0.0;
+    double mean_ms = 0.0;
+    double max_ms = 0.0;
+    double mean_calls = 0.0;
+};
+
+/** Closes a turn while recording, folding the events recorded since the last one into it. */
+void end_turn();
+/** The zones recorded in the closed turns since @ref start, slowest on average first. */
+std::vector<zone_turn_stats> recent_turns();
+/** How many turns @ref recent_turns covers, at most @ref turn_history. */
+int recent_turn_count();
+
+/** What allocations under @p tag are listed as, the zone that set it or "untagged". */
+std::string allocation_tag_name( uint32_t tag );
+/** Writes the allocation totals by zone to the log, when built with allocation tracking. */
+void log_allocations();
+
+namespace detail
+{
+extern std::atomic<bool> recording;
+void record( zone_id zone, clock::time_point start, clock::time_point end );
+} // namespace detail
+
+inline bool is_recording()
+{
+    return detail::recording.load( std::memory_order_relaxed );
+}
+
+class scoped_zone
+{
+    public:
+        explicit scoped_zone( zone_id zone ) : zone( zone ), active( is_recording() ) {
+            if constexpr( cata::allocation_tracking_enabled() ) {
+                previous_tag = cata::set_allocation_tag( zone.index + 1 );
+            }
+            if( active ) {
+                start = clock::now();
+            }
+        }
+        ~scoped_zone() {
+            if( active ) {
+                detail::record( zone, start, clock::now() );
+            }
+            if constexpr( cata::allocation_tracking_enabled() ) {
+                cata::set_allocation_tag( previous_tag );
+            }
+        }
+        scoped_zone( const scoped_zone & ) = delete;
+        scoped_zone &operator=( const scoped_zone & ) = delete;
+    private:
+        zone_id zone;
+        bool active;
+        uint32_t previous_tag = 0;
+        clock::time_point start;
+};
+
+} // namespace perf_trace
+
+#define CATA_PERF_CONCAT_INNER( a, b ) a##b
+#define CATA_PERF_CONCAT( a, b ) CATA_PERF_CONCAT_INNER( a, b )
+
+/** Traces the rest of the enclosing scope as the zone @p name, a string literal. */
+#define CATA_TRACE_ZONE( name ) \
+    static const perf_trace::zone_id CATA_PERF_CONCAT( trace_zone_id_, __LINE__ ) = \
+            perf_trace::intern( name ); \
+    const perf_trace::scoped_zone CATA_PERF_CONCAT( trace_zone_, __LINE__ )( \
+            CATA_PERF_CONCAT( trace_zone_id_, __LINE__ ) )
+
 #endif // CATA_SRC_PERF_H
@@ -0,0 +1,182 @@
+#include "perf_hud.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <imgui/imgui.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "color.h"
+#include "creature_tracker.h"
+#include "flat_lru_cache.h"
+#include "game.h"
+#include "llm_intent.h"
+#include "map.h"
+#include "perf.h"
+#include "translations.h"
+
+// Turn time a zone may take before the HUD calls it out.
+static constexpr double warn_ms = 4.0;
+static constexpr double over_budget_ms = 16.0;
+
+perf_hud::perf_hud() : cataimgui::window( _( "Performance" ),
+            ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_AlwaysAutoResize )
+{
+    if( !perf_trace::is_recording() ) {
+        perf_trace::start();
+        started_trace = true;
+    }
+    force_to_back = true;
+}
+
+perf_hud::~perf_hud()
+{
+    if( started_trace ) {
+        perf_trace::stop();
+    }
+}
+
+cataimgui::bounds perf_hud::get_bounds()
+{
+    return { 0.f, 0.f, -1.f, -1.f };
+}
+
+void perf_hud::count_entities()
+{
+    map &here = get_map();
+    monsters = get_creature_tracker().size();
+    // The rest are the active NPCs and the avatar.
+    npcs = g->num_creatures() - monsters - 1;
+    vehicles = here.get_vehicles().size();
+    active_item_submaps = here.get_submaps_with_active_items().size();
+    counted_at = calendar::turn;
+
+    if constexpr( cata::allocation_tracking_enabled() ) {
+        std::vector<cata::allocation_tag_stats> now = cata::get_allocation_tag_stats();
+        last_turn_allocations.clear();
+        // Nothing to compare with when the HUD just opened.
+        if( allocations_at_turn_start.empty() ) {
+            allocations_at_turn_start = std::move( now );
+            return;
+        }
+        auto before = allocations_at_turn_start.begin();
+        for( const cata::allocation_tag_stats &s : now ) {
+            // Both are sorted by tag, and tags never disappear.
+            while( before != allocations_at_turn_start.end() && before->tag < s.tag ) {
+                ++before;
+            }
+            cata::allocation_tag_stats delta = s;
+            if( before != allocations_at_turn_start.end() && before->tag == s.tag ) {
+                delta.allocations -= before->allocations;
+                delta.frees -= before->frees;
+                delta.allocated_bytes -= before->allocated_bytes;
+            }
+            if( delta.allocations > 0 ) {
+                last_turn_allocations.push_back( delta );
+            }
+        }
+        std::sort( last_turn_allocations.begin(), last_turn_allocations.end(),
+        []( const cata::allocation_tag_stats & a, const cata::allocation_tag_stats & b ) {
+            return a.allocated_bytes > b.allocated_bytes;
+        } );
+        allocations_at_turn_start = std::move( now );
+    }
+}
+
+void perf_hud::draw_allocations()
+{
+    ImGui::Separator();
+    ImGui::Text( "%s", _( "Allocations in the last turn, by innermost zone" ) );
+    if( ImGui::BeginTable( "allocations", 4, ImGuiTableFlags_SizingFixedFit ) ) {
+        ImGui::TableSetupColumn( _( "Zone" ) );
+        ImGui::TableSetupColumn( _( "Allocs" ) );
+        ImGui::TableSetupColumn( _( "KiB" ) );
+        ImGui::TableSetupColumn( _( "Live KiB" ) );
+        ImGui::TableHeadersRow();
+        for( const cata::allocation_tag_stats &s : last_turn_allocations ) {
+            ImGui::TableNextColumn();
+            ImGui::Text( "%s", perf_trace::allocation_tag_name( s.tag ).c_str() );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%llu", static_cast<unsigned long long>( s.allocations ) );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%llu", static_cast<unsigned long long>( s.allocated_bytes / 1024 ) );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%lld", static_cast<long long>( s.live_bytes / 1024 ) );
+        }
+        ImGui::EndTable();
+    }
+}
+
+void perf_hud::draw_caches()
+{
+    const std::vector<std::pair<std::string, cache_stats>> caches = cache_counters::all();
+    if( caches.empty() ) {
+        return;
+    }
+    ImGui::Separator();
+    if( ImGui::BeginTable( "caches", 4, ImGuiTableFlags_SizingFixedFit ) ) {
+        ImGui::TableSetupColumn( _( "Cache" ) );
+        ImGui::TableSetupColumn( _( "Hits" ) );
+        ImGui::TableSetupColumn( _( "Misses" ) );
+        ImGui::TableSetupColumn( _( "Hit %" ) );
+        ImGui::TableHeadersRow();
+        for( const std::pair<std::string, cache_stats> &c : caches ) {
+            const uint64_t lookups = c.second.hits + c.second.misses;
+            ImGui::TableNextColumn();
+            ImGui::Text( "%s", c.first.c_str() );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%llu", static_cast<unsigned long long>( c.second.hits ) );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%llu", static_cast<unsigned long long>( c.second.misses ) );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%.1f", lookups == 0 ? 0.0 : 100.0 * c.second.hits / lookups );
+        }
+        ImGui::EndTable();
+    }
+}
+
+void perf_hud::draw_controls()
+{
+    if( counted_at != calendar::turn ) {
+        count_entities();
+    }
+    if( !perf_trace::is_recording() ) {
+        ImGui::TextColored( c_yellow, "%s", _( "Not tracing, showing the last turns traced." ) );
+    }
+    ImGui::Text( _( "Zone time per turn over the last %d turns" ), perf_trace::recent_turn_count() );
+
+    const std::vector<perf_trace::zone_turn_stats> stats = perf_trace::recent_turns();
+    if( ImGui::BeginTable( "zones", 5, ImGuiTableFlags_SizingFixedFit ) ) {
+        ImGui::TableSetupColumn( _( "Zone" ) );
+        ImGui::TableSetupColumn( _( "Last ms" ) );
+        ImGui::TableSetupColumn( _( "Mean ms" ) );
+        ImGui::TableSetupColumn( _( "Max ms" ) );
+        ImGui::TableSetupColumn( _( "Calls" ) );
+        ImGui::TableHeadersRow();
+        for( const perf_trace::zone_turn_stats &s : stats ) {
+            const nc_color color = s.mean_ms > over_budget_ms ? c_light_red :
+                                   s.mean_ms > warn_ms ? c_yellow : c_white;
+            ImGui::TableNextColumn();
+            ImGui::TextColored( color, "%s", s.name.c_str() );
+            ImGui::TableNextColumn();
+            ImGui::TextColored( color, "%.2f", s.last_ms );
+            ImGui::TableNextColumn();
+            ImGui::TextColored( color, "%.2f", s.mean_ms );
+            ImGui::TableNextColumn();
+            ImGui::TextColored( color, "%.2f", s.max_ms );
+            ImGui::TableNextColumn();
+            ImGui::TextColored( color, "%.1f", s.mean_calls );
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+    ImGui::Text( _( "Monsters: %zu  NPCs: %zu  Vehicles: %zu" ), monsters, npcs, vehicles );
+    ImGui::Text( _( "Submaps with active items: %zu" ), active_item_submaps );
+    ImGui::Text( _( "LLM requests queued: %zu" ), llm_intent::queue_depth() );
+    draw_caches();
+    if constexpr( cata::allocation_tracking_enabled() ) {
+        draw_allocations();
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+#ifndef CATA_SRC_PERF_HUD_H
+#define CATA_SRC_PERF_HUD_H
+
+#include <cstddef>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_allocator.h"
+#include "cata_imgui.h"
+
+/**
+ * A corner overlay of the per-turn time of the traced zones over the recent turns, and what
+ * is in the reality bubble to take it. Drawn over the game while it lives, toggled from the
+ * debug menu. It keeps @ref perf_trace recording while open if nothing else started it.
+ */
+class perf_hud : public cataimgui::window
+{
+    public:
+        perf_hud();
+        ~perf_hud() override;
+
+    protected:
+        void draw_controls() override;
+        cataimgui::bounds get_bounds() override;
+
+    private:
+        void count_entities();
+        void draw_allocations();
+        // Counts of the named flat_lru_cache instances since the game started.
+        void draw_caches();
+
+        bool started_trace = false;
+        time_point counted_at = calendar::before_time_starts;
+        size_t monsters = 0;
+        size_t npcs = 0;
+        size_t vehicles = 0;
+        size_t active_item_submaps = 0;
+        // Allocation totals when the current turn started, and what each tag did in the last one.
+        std::vector<cata::allocation_tag_stats> allocations_at_turn_start;
+        std::vector<cata::allocation_tag_stats> last_turn_allocations;
+};
+
+#endif // CATA_SRC_PERF_HUD_H
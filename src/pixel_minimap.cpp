@@ -34,6 +34,7 @@
 #include "monster.h"
 #include "pixel_minimap_projectors.h"
 #include "sdl_utils.h"
+#include "submap.h"
 #include "type_id.h"
 #include "vehicle.h"
 #include "viewer.h"
@@ -83,19 +84,20 @@ SDL_Texture_Ptr create_cache_texture( const SDL_Renderer_Ptr &renderer, int tile
                           tile_height );
 }
 
-SDL_Color get_map_color_at( const tripoint_bub_ms &p )
+// `sm` is the submap holding `p`, and `l` is `p` within it.
+SDL_Color get_map_color_at( const map &here, const tripoint_bub_ms &p, const submap &sm,
+                            const point_sm_ms &l )
 {
-    const map &here = get_map();
     if( const optional_vpart_position vp = here.veh_at( p ) ) {
         const vpart_display vd = vp->vehicle().get_display_of_tile( vp->mount_pos() );
         return curses_color_to_SDL( vd.color );
     }
 
-    if( const furn_id &furn_id = here.furn( p ) ) {
+    if( const furn_id &furn_id = sm.get_furn( l ) ) {
         return curses_color_to_SDL( furn_id->color() );
     }
 
-    return curses_color_to_SDL( here.ter( p )->color() );
+    return curses_color_to_SDL( sm.get_ter( l )->color() );
 }
 
 SDL_Color get_critter_color( Creature *critter, int flicker, int mixture )
@@ -301,11 +303,14 @@ void pixel_minimap::flush_cache_updates()
     }
 }
 
-void pixel_minimap::update_cache_at( const tripoint_bub_sm &sm_pos )
+void pixel_minimap::update_cache_at( const tripoint_bub_sm &sm_pos, const bool nv_goggle )
 {
     const map &here = get_map();
     const level_cache &access_cache = here.access_cache( sm_pos.z() );
-    const bool nv_goggle = get_player_character().get_vision_modes()[NV_GOGGLES];
+    const submap *sm = here.get_submap_at_grid( rebase_rel( sm_pos ) );
+    if( sm == nullptr ) {
+        return;
+    }
 
     submap_cache &cache_item = get_cache_at( here.get_abs_sub() + rebase_rel( sm_pos ) );
     const tripoint_bub_ms ms_pos = coords::project_to<coords::ms>( sm_pos );
@@ -323,7 +328,7 @@ void pixel_minimap::update_cache_at( const tripoint_bub_sm &sm_pos )
                 // TODO: Map memory?
                 color = { Uint8( pixel_minimap_r ), Uint8( pixel_minimap_g ), Uint8( pixel_minimap_b ), Uint8( pixel_minimap_a ) };
             } else {
-                color = get_map_color_at( p );
+                color = get_map_color_at( here, p, *sm, point_sm_ms( x, y ) );
 
                 //color terrain according to lighting conditions
                 if( nv_goggle ) {
@@ -364,9 +369,10 @@ void pixel_minimap::process_cache( const tripoint_bub_ms &center )
 {
     prepare_cache_for_updates( center );
 
+    const bool nv_goggle = get_player_character().get_vision_modes()[NV_GOGGLES];
     for( int y = 0; y < MAPSIZE; ++y ) {
         for( int x = 0; x < MAPSIZE; ++x ) {
-            update_cache_at( { x, y, center.z()} );
+            update_cache_at( { x, y, center.z()}, nv_goggle );
         }
     }
 
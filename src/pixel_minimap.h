@@ -56,7 +56,7 @@ class pixel_minimap
         void process_cache( const tripoint_bub_ms &center );
 
         void flush_cache_updates();
-        void update_cache_at( const tripoint_bub_sm &pos );
+        void update_cache_at( const tripoint_bub_sm &pos, bool nv_goggle );
         void prepare_cache_for_updates( const tripoint_bub_ms &center );
         void clear_unused_cache();
 
@@ -207,6 +207,113 @@ static int RAS_time( const Character &p, const item_location &loc );
 static void cycle_action( item &weap, const itype_id &ammo, map *here, const tripoint_bub_ms &pos );
 static void make_gun_sound_effect( const Character &p, bool burst, item *weapon );
 
+struct confidence_rating {
+    double aim_level;
+    char symbol;
+    std::string color;
+    std::string label;
+};
+
+/*
+* struct used to hold the information on entire aim_type prediction;
+* all the properties and odds for every 'confidence' outcome
+*/
+struct aim_type_prediction {
+    struct aim_confidence {
+        std::string label;
+        std::string color;
+        int chance;
+    };
+
+    std::string name;
+    std::string hotkey;
+    std::vector<confidence_rating> ratings; // this is read back in UI
+    std::vector<aim_confidence> chances;
+    bool is_default;
+    int moves;
+    int chance_to_hit; // all hit probabilities summed up for sorting
+    double confidence;
+    double steadiness;
+};
+
+/**
+ * The hit chances the aiming window worked out for each tile, so that redrawing it and moving
+ * the cursor over the targets in a crowd doesn't predict every aim mode again. Everything the
+ * chances depend on besides the target is the aim state; when that changes, they are dropped.
+ */
+class aim_chance_cache
+{
+    public:
+        struct aim_state {
+            const item *weapon = nullptr;
+            gun_mode_id gun_mode;
+            itype_id ammo;
+            const item *load = nullptr;
+            tripoint_bub_ms pos;
+            double recoil = 0.0;
+            double recoil_vehicle = 0.0;
+            int sight_dispersion = 0;
+            std::string selected_aim;
+            time_point turn = calendar::turn_zero;
+            int moves = 0;
+
+            bool operator==( const aim_state &rhs ) const {
+                return weapon == rhs.weapon && gun_mode == rhs.gun_mode && ammo == rhs.ammo &&
+                       load == rhs.load && pos == rhs.pos && recoil == rhs.recoil &&
+                       recoil_vehicle == rhs.recoil_vehicle && sight_dispersion == rhs.sight_dispersion &&
+                       selected_aim == rhs.selected_aim && turn == rhs.turn && moves == rhs.moves;
+            }
+        };
+
+        /** Forgets the chances unless they were computed in @p new_state. */
+        void set_state( const aim_state &new_state ) {
+            if( !( new_state == state ) ) {
+                state = new_state;
+                dispersion.reset();
+                by_tile.clear();
+            }
+        }
+        /** The gun's dispersion before aiming, the same for every tile. */
+        const dispersion_sources &weapon_dispersion( const Character &you, const item &weapon ) {
+            if( !dispersion ) {
+                dispersion = you.get_weapon_dispersion( weapon );
+                dispersion->add_range( you.recoil_vehicle() );
+            }
+            return *dispersion;
+        }
+        /** The chances at @p pos if they were computed for the same @p target, or nullptr. */
+        const std::vector<aim_type_prediction> *find( const tripoint_bub_ms &pos,
+                const Target_attributes &target ) const {
+            const auto it = by_tile.find( pos );
+            if( it == by_tile.end() || !same_target( it->second.target, target ) ) {
+                return nullptr;
+            }
+            return &it->second.chances;
+        }
+        const std::vector<aim_type_prediction> &store( const tripoint_bub_ms &pos,
+                const Target_attributes &target, std::vector<aim_type_prediction> &&chances ) {
+            cached &entry = by_tile[pos];
+            entry.target = target;
+            entry.chances = std::move( chances );
+            return entry.chances;
+        }
+
+    private:
+        struct cached {
+            Target_attributes target;
+            std::vector<aim_type_prediction> chances;
+        };
+
+        static bool same_target( const Target_attributes &a, const Target_attributes &b ) {
+            return a.range == b.range && a.size == b.size && a.light == b.light &&
+                   a.visible == b.visible;
+        }
+
+        aim_state state;
+        std::optional<dispersion_sources> dispersion;
+        std::map<tripoint_bub_ms, cached> by_tile;
+};
+
 class target_ui
 {
     public:
@@ -314,6 +421,8 @@ class target_ui
         // but increases the further away the new aim point will be
         // relative to the current one.
         double predicted_recoil = 0;
+        // Hit chances already shown in this aim session
+        aim_chance_cache aim_chances;
 
         // For AOE spells, list of tiles affected by the spell
         // relevant for TargetMode::Spell
@@ -1081,6 +1190,7 @@ int Character::fire_gun( map &here, const tripoint_bub_ms &target, int shots, it
     int curshot = 0;
     int hits = 0; // total shots on target
     int delay = 0; // delayed recoil that has yet to be applied
+    projectile_burst burst( here );
     while( curshot != shots ) {
         // Special handling for weapons where we supply the ammo separately (i.e. ammo is populated)
         // instead of it being loaded into the weapon, reload right before firing.
@@ -1122,7 +1232,8 @@ int Character::fire_gun( map &here, const tripoint_bub_ms &target, int shots, it
         dispersion_sources dispersion = total_gun_dispersion( gun, recoil_total(), proj.shot_spread );
 
         dealt_projectile_attack shot;
-        projectile_attack( shot, proj, &here, pos_bub( here ), aim, dispersion, this, in_veh, wp_attack );
+        projectile_attack( shot, proj, &here, pos_bub( here ), aim, dispersion, this, in_veh, wp_attack,
+                           &burst );
         if( !shot.targets_hit.empty() ) {
             hits++;
         }
@@ -1741,13 +1852,6 @@ static void do_aim( Character &you, const item &relevant, const double min_recoi
     }
 }
 
-struct confidence_rating {
-    double aim_level;
-    char symbol;
-    std::string color;
-    std::string label;
-};
-
 static int print_steadiness( const catacurses::window &w, int line_number, double steadiness )
 {
     const int window_width = getmaxx( w ) - 2; // Window width minus borders.
@@ -1829,28 +1933,6 @@ Target_attributes::Target_attributes( int rng, double target_size, float light_t
     visible = can_see;
 }
 
-/*
-* struct used to hold the information on entire aim_type prediction;
-* all the properties and odds for every 'confidence' outcome
-*/
-struct aim_type_prediction {
-    struct aim_confidence {
-        std::string label;
-        std::string color;
-        int chance;
-    };
-
-    std::string name;
-    std::string hotkey;
-    std::vector<confidence_rating> ratings; // this is read back in UI
-    std::vector<aim_confidence> chances;
-    bool is_default;
-    int moves;
-    int chance_to_hit; // all hit probabilities summed up for sorting
-    double confidence;
-    double steadiness;
-};
-
 // struct used for returning values from predict_recoil()
 // recoil is the either the sight dispersion or the aim mode's threshold
 // moves it the amount of moves it'll take to reach that aim state
@@ -1865,7 +1947,7 @@ struct recoil_prediction {
 */
 static recoil_prediction predict_recoil( const Character &you, const item &weapon,
         const Target_attributes &target, int sight_dispersion,
-        const aim_type &aim_mode, double start_recoil )
+        const aim_type &aim_mode, double start_recoil, std::optional<aim_mods_cache> &aim_cache )
 {
     if( !aim_mode.has_threshold || aim_mode.threshold > start_recoil ) {
         return { start_recoil, 0 };
@@ -1873,8 +1955,10 @@ static recoil_prediction predict_recoil( const Character &you, const item &weapo
 
     double predicted_recoil = start_recoil;
     int predicted_delay = 0;
-    const aim_mods_cache &aim_cache = you.gen_aim_mods_cache( weapon );
-    auto aim_cache_opt = std::make_optional( std::ref( aim_cache ) );
+    if( !aim_cache ) {
+        aim_cache = you.gen_aim_mods_cache( weapon );
+    }
+    auto aim_cache_opt = std::make_optional( std::cref( *aim_cache ) );
     // next loop simulates aiming until either aim mode threshold or sight_dispersion is reached
     do {
         const double aim_amount = you.aim_per_move( weapon, predicted_recoil, target, aim_cache_opt );
@@ -1909,10 +1993,12 @@ static std::vector<aim_type_prediction> calculate_ranged_chances(
         aim_types = you.get_aim_types( weapon );
     }
 
+    // The same for every aim mode, made by the first that needs it.
+    std::optional<aim_mods_cache> aim_cache;
     // predict how long it'll take to reach from current recoil
     // to the ui's selected default aim mode threshold.
     const recoil_prediction aim_to_selected = predict_recoil( you, weapon, target,
-            ui.get_sight_dispersion(), ui.get_selected_aim_type(), you.recoil );
+            ui.get_sight_dispersion(), ui.get_selected_aim_type(), you.recoil, aim_cache );
 
     const double selected_steadiness = calc_steadiness( you, weapon, pos, aim_to_selected.recoil );
 
@@ -1931,7 +2017,7 @@ static std::vector<aim_type_prediction> calculate_ranged_chances(
             prediction.moves = throw_moves;
         } else {
             prediction.moves = predict_recoil( you, weapon, target, ui.get_sight_dispersion(), aim_type,
-                                               you.recoil ).moves + time_to_attack( you, *weapon.type )
+                                               you.recoil, aim_cache ).moves + time_to_attack( you, *weapon.type )
                                + RAS_time( you, load_loc );
         }
 
@@ -1949,7 +2035,8 @@ static std::vector<aim_type_prediction> calculate_ranged_chances(
             // predict how long it'll take to reach from current recoil
             // to the current aim mode's threshold.
             const recoil_prediction aim_to_type = ( aim_type == ui.get_selected_aim_type() ) ? aim_to_selected :
-                                                  predict_recoil( you, weapon, target, ui.get_sight_dispersion(), aim_type, you.recoil );
+                                                  predict_recoil( you, weapon, target, ui.get_sight_dispersion(), aim_type, you.recoil,
+                                                          aim_cache );
             prediction.steadiness = calc_steadiness( you, weapon, pos, aim_to_type.recoil );
         }
 
@@ -2156,17 +2243,28 @@ static bool pl_sees( const optional_vpart_position &ovp )
     return u.sees( here,  ovp.value().pos_bub( here ) );
 }
 
-static int print_aim( const target_ui &ui, Character &you, const catacurses::window &w,
-                      int line_number, input_context &ctxt, const item &weapon, const tripoint_bub_ms &pos,
-                      item_location &load_loc )
+static int print_aim( const target_ui &ui, aim_chance_cache &cache, Character &you,
+                      const catacurses::window &w, int line_number, input_context &ctxt, const item &weapon,
+                      const tripoint_bub_ms &pos, item_location &load_loc )
 {
     // This is absolute accuracy for the player.
     // TODO: push the calculations duplicated from Creature::deal_projectile_attack() and
     // Creature::projectile_attack() into shared methods.
     // Dodge doesn't affect gun attacks
 
-    dispersion_sources dispersion = you.get_weapon_dispersion( weapon );
-    dispersion.add_range( you.recoil_vehicle() );
+    aim_chance_cache::aim_state state;
+    state.weapon = &weapon;
+    state.gun_mode = weapon.gun_get_mode_id();
+    state.ammo = weapon.ammo_current();
+    state.load = load_loc ? load_loc.get_item() : nullptr;
+    state.pos = you.pos_bub();
+    state.recoil = you.recoil;
+    state.recoil_vehicle = you.recoil_vehicle();
+    state.sight_dispersion = ui.get_sight_dispersion();
+    state.selected_aim = ui.get_selected_aim_type().action;
+    state.turn = calendar::turn;
+    state.moves = you.get_moves();
+    cache.set_state( state );
 
     // This could be extracted, to allow more/less verbose displays
     static const std::vector<confidence_rating> confidence_config = {{
@@ -2176,13 +2274,17 @@ static int print_aim( const target_ui &ui, Character &you, const catacurses::win
         }
     };
 
-    const std::vector<aim_type_prediction> aim_chances = calculate_ranged_chances( ui, you,
-            target_ui::TargetMode::Fire, ctxt, weapon, dispersion, confidence_config,
-            Target_attributes( you.pos_bub(), pos ), pos, load_loc );
+    const Target_attributes target( you.pos_bub(), pos );
+    const std::vector<aim_type_prediction> *aim_chances = cache.find( pos, target );
+    if( aim_chances == nullptr ) {
+        aim_chances = &cache.store( pos, target, calculate_ranged_chances( ui, you,
+                                    target_ui::TargetMode::Fire, ctxt, weapon, cache.weapon_dispersion( you, weapon ),
+                                    confidence_config, target, pos, load_loc ) );
+    }
 
     int time = RAS_time( you, load_loc );
 
-    return print_ranged_chance( w, line_number, aim_chances, time );
+    return print_ranged_chance( w, line_number, *aim_chances, time );
 }
 
 static void draw_throw_aim( const target_ui &ui, const Character &you, const catacurses::window &w,
@@ -3943,8 +4045,8 @@ void target_ui::draw_ui_window()
         // TODO: these are old, consider refactoring
         if( mode == TargetMode::Fire ) {
             item_location load_loc = activity->reload_loc;
-            text_y = print_aim( *this, *you, w_target, text_y, ctxt, *relevant->gun_current_mode(), dst,
-                                load_loc );
+            text_y = print_aim( *this, aim_chances, *you, w_target, text_y, ctxt,
+                                *relevant->gun_current_mode(), dst, load_loc );
         } else if( mode == TargetMode::Throw || mode == TargetMode::ThrowBlind ) {
             bool blind = mode == TargetMode::ThrowBlind;
             draw_throw_aim( *this, *you, w_target, text_y, ctxt, *relevant, dst, blind );
@@ -7,7 +7,9 @@
 #include "calendar.h"
 #include "cata_assert.h"
 #include "cata_utility.h"
+#include "coordinates.h"
 #include "debug.h"
+#include "hash_utils.h"
 #include "units.h"
 
 unsigned int rng_bits()
@@ -211,6 +213,27 @@ cata_default_random_engine &rng_get_engine()
     return eng;
 }
 
+scoped_rng_stream::scoped_rng_stream( unsigned int seed ) : saved( rng_get_engine() )
+{
+    rng_get_engine().seed( seed );
+}
+
+scoped_rng_stream::~scoped_rng_stream()
+{
+    rng_get_engine() = saved;
+}
+
+unsigned int rng_stream_seed( unsigned int base, const tripoint_abs_omt &where,
+                              std::string_view purpose )
+{
+    std::size_t seed = base;
+    cata::hash_combine( seed, where.x() );
+    cata::hash_combine( seed, where.y() );
+    cata::hash_combine( seed, where.z() );
+    cata::hash_combine( seed, purpose );
+    return static_cast<unsigned int>( seed );
+}
+
 void rng_set_engine_seed( unsigned int seed )
 {
     if( seed != 0 ) {
@@ -9,6 +9,7 @@
 #include <optional>
 #include <random>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -30,6 +31,28 @@ void rng_set_engine_seed( unsigned int seed );
 using cata_default_random_engine = std::minstd_rand0;
 cata_default_random_engine::result_type rng_get_first_seed();
 cata_default_random_engine &rng_get_engine();
+
+/**
+ * While alive, every rng function draws from a stream of its own seeded with @p seed, and the
+ * global engine is put back as it was afterwards. Whatever is generated inside the scope rolls
+ * the same numbers no matter what was generated before it, and doesn't shift the rest of the
+ * game's rolls. Scopes nest, the innermost one wins.
+ */
+class scoped_rng_stream
+{
+    public:
+        explicit scoped_rng_stream( unsigned int seed );
+        scoped_rng_stream( const scoped_rng_stream & ) = delete;
+        scoped_rng_stream &operator=( const scoped_rng_stream & ) = delete;
+        ~scoped_rng_stream();
+    private:
+        cata_default_random_engine saved;
+};
+
+// Derives a stream seed for generating @p purpose at @p where from a world level @p base seed,
+// so different places and different kinds of generation at one place get unrelated streams.
+unsigned int rng_stream_seed( unsigned int base, const tripoint_abs_omt &where,
+                              std::string_view purpose );
 unsigned int rng_bits();
 
 int rng( int lo, int hi );
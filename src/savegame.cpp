@@ -345,6 +345,7 @@ void scent_map::deserialize( const std::string &data, bool is_type )
                 val = stmp;
             }
         }
+        scent_everywhere();
     }
 }
 
@@ -522,7 +523,7 @@ void overmap::unserialize( const JsonObject &jsobj )
                     count--;
                     set_passable( project_combine( loc, tripoint_om_omt( i, j, z - OVERMAP_HEIGHT ) ),
                                   tmp_otid->get_type_id()->default_map_data );
-                    layer[z].terrain[i][j] = tmp_otid;
+                    layer[z].terrain.set( point_om_omt( i, j ), tmp_otid );
                 }
             }
         }
@@ -733,6 +734,25 @@ void overmap::unserialize( const JsonObject &jsobj )
                 }
                 scents[pos] = scent_trace( time, strength );
             }
+        } else if( name == "fires" ) {
+            JsonArray fires_json = om_member;
+            for( JsonObject fire_json : fires_json ) {
+                tripoint_abs_omt pos;
+                om_fire fire;
+                int materialized = 0;
+                for( JsonMember fire_member : fire_json ) {
+                    std::string fire_member_name = fire_member.name();
+                    if( fire_member_name == "pos" ) {
+                        fire_member.read( pos );
+                    } else if( fire_member_name == "fuel" ) {
+                        fire_member.read( fire.fuel );
+                    } else if( fire_member_name == "materialized" ) {
+                        fire_member.read( materialized );
+                    }
+                }
+                fire.materialized = static_cast<uint8_t>( materialized );
+                fires[pos] = fire;
+            }
         } else if( name == "npcs" ) {
             JsonArray npcs_json = om_member;
             for( JsonObject npc_json : npcs_json ) {
@@ -833,7 +853,7 @@ void overmap::unserialize( const JsonObject &jsobj )
                     // This way only the 'last' rotation/variation generated is kept.
                     om_predecessors.reserve( serialized_predecessors.size() );
                     oter_id current_oter;
-                    auto local_set_ter = [&]( oter_id & id ) {
+                    auto local_set_ter = [&]( const oter_id & id ) {
                         const oter_type_str_id &current_type_id = current_oter->get_type_id();
                         const oter_type_str_id &incoming_type_id = id->get_type_id();
                         const bool current_type_same = current_type_id == incoming_type_id;
@@ -925,7 +945,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                         }
                     }
                     count--;
-                    layer[z + OVERMAP_DEPTH].terrain[i][j] = tmp_otid;
+                    layer[z + OVERMAP_DEPTH].terrain.set( point_om_omt( i, j ), tmp_otid );
                     if( tmp_otid == oter_lake_shore || tmp_otid == oter_lake_surface ) {
                         lake_points.emplace_back( i, j, z );
                     }
@@ -969,7 +989,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                 ter_set( tripoint_om_omt( p.xy(), z ), oter_lake_water_cube );
             }
             ter_set( tripoint_om_omt( p.xy(), lake_depth ), oter_lake_bed );
-            layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = oter_lake_surface;
+            layer[p.z() + OVERMAP_DEPTH].terrain.set( p.xy(), oter_lake_surface );
         }
     }
     std::unordered_set<tripoint_om_omt> ocean_set;
@@ -999,7 +1019,7 @@ void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_pat
                 ter_set( tripoint_om_omt( p.xy(), z ), oter_ocean_water_cube );
             }
             ter_set( tripoint_om_omt( p.xy(), ocean_depth ), oter_ocean_bed );
-            layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = oter_ocean_surface;
+            layer[p.z() + OVERMAP_DEPTH].terrain.set( p.xy(), oter_ocean_surface );
         }
     }
     std::unordered_set<tripoint_om_omt> forest_set;
@@ -1069,12 +1089,13 @@ void overmap::unserialize_view( const JsonObject &jsobj )
                     for( int y = 0; y < OMAPY; ++y ) {
                         for( int x = 0; x < OMAPX; ++x ) {
                             point_om_omt idx( x, y );
-                            layer[z].visible[idx] = old_vision[idx] ? om_vision_level::full :
-                                                    om_vision_level::unseen;
+                            layer[z].visible.set( idx, old_vision[idx] ? om_vision_level::full :
+                                                  om_vision_level::unseen );
                         }
                     }
                 } else {
-                    unserialize_array_from_compacted_sequence( visible_by_z_json, layer[z].visible );
+                    unserialize_array_from_compacted_sequence( visible_by_z_json,
+                            layer[z].visible.expanded() );
                 }
                 if( visible_by_z_json.has_more() ) {
                     visible_by_z_json.throw_error( "Too many sequences for z visible view" );
@@ -1087,7 +1108,8 @@ void overmap::unserialize_view( const JsonObject &jsobj )
             JsonArray explored_json = view_member;
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
                 JsonArray explored_by_z_json = explored_json.next_array();
-                unserialize_array_from_compacted_sequence( explored_by_z_json, layer[z].explored );
+                unserialize_array_from_compacted_sequence( explored_by_z_json,
+                        layer[z].explored.expanded() );
                 if( explored_by_z_json.has_more() ) {
                     explored_by_z_json.throw_error( "Too many sequences for z explored view" );
                 }
@@ -1149,7 +1171,7 @@ static void serialize_enum_array_to_compacted_sequence( JsonOut &json, const MdA
     enum_type lastval = enum_traits<enum_type>::last;
     for( size_t j = 0; j < MdArray::size_y; ++j ) {
         for( size_t i = 0; i < MdArray::size_x; ++i ) {
-            const enum_type value = array[i][j];
+            const enum_type value = array[point_om_omt( i, j )];
             if( value == lastval ) {
                 ++count;
                 continue;
@@ -1178,7 +1200,7 @@ static void serialize_array_to_compacted_sequence( JsonOut &json, const MdArray
     int lastval = -1;
     for( size_t j = 0; j < MdArray::size_y; ++j ) {
         for( size_t i = 0; i < MdArray::size_x; ++i ) {
-            const int value = array[i][j];
+            const int value = array[point_om_omt( i, j )];
             if( value != lastval ) {
                 if( count ) {
                     json.write( count );
@@ -1337,7 +1359,7 @@ void overmap::serialize( std::ostream &fout ) const
         for( int j = 0; j < OMAPY; j++ ) {
             // NOLINTNEXTLINE(modernize-loop-convert)
             for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer_terrain[i][j];
+                oter_id t = layer_terrain[point_om_omt( i, j )];
                 if( t != last_tertype ) {
                     if( count ) {
                         json.write( count );
@@ -1486,6 +1508,18 @@ void overmap::serialize( std::ostream &fout ) const
     json.end_array();
     fout << std::endl;
 
+    json.member( "fires" );
+    json.start_array();
+    for( const auto &fire : fires ) {
+        json.start_object();
+        json.member( "pos", fire.first );
+        json.member( "fuel", fire.second.fuel );
+        json.member( "materialized", static_cast<int>( fire.second.materialized ) );
+        json.end_object();
+    }
+    json.end_array();
+    fout << std::endl;
+
     json.member( "npcs" );
     json.start_array();
     for( const auto &i : npcs ) {
@@ -1780,6 +1814,7 @@ void global_variables::unserialize( const JsonObject &jo )
     }
 
     game::legacy_migrate_npctalk_var_prefix( global_values );
+    ++generation;
 }
 
 void timed_event_manager::unserialize_all( const JsonArray &ja )
@@ -1979,6 +2014,7 @@ void creature_tracker::deserialize( const JsonArray &ja )
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     for( JsonValue jv : ja ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
         shared_ptr_fast<monster> mptr = make_shared_fast<monster>();
@@ -1061,6 +1061,8 @@ void Character::load( const JsonObject &data )
     if( !weapon.is_null() && weapon.relic_data && weapon.type->relic_data ) {
         weapon.relic_data = weapon.type->relic_data;
     }
+    // The items were replaced without the inventory version going up.
+    invalidate_carried_enchantments();
     data.read( "move_mode", move_mode );
 
     if( has_effect( effect_riding ) ) {
@@ -2312,6 +2314,30 @@ void npc::load( const JsonObject &data )
         complaints.emplace( member.name(), p );
     }
     data.read( "unique_id", unique_id );
+    // Entries are arrays rather than objects, they are written for every NPC in every save.
+    // NPCs without memories don't get a state just for loading.
+    if( data.has_array( "llm_memory" ) || data.has_array( "llm_overheard" ) ||
+        find_llm_intent_state( *this ) != nullptr ) {
+        llm_intent_state &llm_state = llm_intent_state_for( *this );
+        llm_state.conversation_memory.clear();
+        for( const JsonArray ja : data.get_array( "llm_memory" ) ) {
+            llm_intent_memory_entry entry;
+            ja.read( 0, entry.turn );
+            entry.player_utterance = ja.get_string( 1 );
+            entry.npc_response = ja.get_string( 2 );
+            ja.read( 3, entry.actions );
+            llm_state.conversation_memory.push_back( std::move( entry ) );
+        }
+        llm_state.overheard_memory.clear();
+        for( const JsonArray ja : data.get_array( "llm_overheard" ) ) {
+            auto entry = std::make_shared<llm_overheard_memory_entry>();
+            ja.read( 0, entry->turn );
+            entry->npc_name = ja.get_string( 1 );
+            entry->npc_response = ja.get_string( 2 );
+            ja.read( 3, entry->actions );
+            llm_state.overheard_memory.push_back( std::move( entry ) );
+        }
+    }
     clear_personality_traits();
     generate_personality_traits();
     data.read( "may_activity_occupancy_after_end_items_loc",
@@ -2387,6 +2413,34 @@ void npc::store( JsonOut &json ) const
 
     json.member( "complaints", complaints );
     json.member( "unique_id", unique_id );
+    const llm_intent_state *llm_state = find_llm_intent_state( *this );
+    if( llm_state != nullptr && !llm_state->conversation_memory.empty() ) {
+        json.member( "llm_memory" );
+        json.start_array();
+        for( const llm_intent_memory_entry &entry : llm_state->conversation_memory ) {
+            json.start_array();
+            json.write( entry.turn );
+            json.write( entry.player_utterance );
+            json.write( entry.npc_response );
+            json.write( entry.actions );
+            json.end_array();
+        }
+        json.end_array();
+    }
+    if( llm_state != nullptr && !llm_state->overheard_memory.empty() ) {
+        json.member( "llm_overheard" );
+        json.start_array();
+        for( const std::shared_ptr<const llm_overheard_memory_entry> &entry :
+             llm_state->overheard_memory ) {
+            json.start_array();
+            json.write( entry->turn );
+            json.write( entry->npc_name );
+            json.write( entry->npc_response );
+            json.write( entry->actions );
+            json.end_array();
+        }
+        json.end_array();
+    }
     json.member( "may_activity_occupancy_after_end_items_loc",
                  may_activity_occupancy_after_end_items_loc );
 }
@@ -3601,6 +3655,7 @@ void vehicle::deserialize( const JsonObject &data )
 
 void vehicle::deserialize_parts( const JsonArray &data )
 {
+    relative_parts_built_for = -1;
     parts.clear();
     parts.reserve( data.size() );
     for( const JsonValue jv : data ) {
@@ -4529,6 +4584,38 @@ static void deserialize( camp_locker_policy &value, const JsonObject &jo )
     }
 }
 
+static void serialize( const camp_offscreen_ledger &value, JsonOut &jsout )
+{
+    jsout.start_object();
+    jsout.member( "simulated_until", value.simulated_until );
+    jsout.member( "job_hours", value.job_hours );
+    jsout.member( "owed_meals" );
+    jsout.start_array();
+    for( const std::pair<const character_id, nutrients> &owed : value.owed_meals ) {
+        jsout.start_object();
+        jsout.member( "worker", owed.first );
+        jsout.member( "meal", owed.second );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.member( "hungry_hours", value.hungry_hours );
+    jsout.end_object();
+}
+
+static void deserialize( camp_offscreen_ledger &value, const JsonObject &jo )
+{
+    jo.allow_omitted_members();
+    jo.read( "simulated_until", value.simulated_until );
+    jo.read( "job_hours", value.job_hours );
+    for( JsonObject owed : jo.get_array( "owed_meals" ) ) {
+        owed.allow_omitted_members();
+        character_id worker;
+        owed.read( "worker", worker );
+        owed.read( "meal", value.owed_meals[worker] );
+    }
+    jo.read( "hungry_hours", value.hungry_hours );
+}
+
 // basecamp
 void basecamp::serialize( JsonOut &json ) const
 {
@@ -4545,6 +4632,7 @@ void basecamp::serialize( JsonOut &json ) const
         json.member( "locker_service_queue", locker_service_queue );
         json.member( "locker_next_service_turn", locker_next_service_turn );
         json.member( "next_camp_request_id", next_camp_request_id );
+        json.member( "offscreen", offscreen );
         json.member( "hidden_missions" );
         json.start_array();
         for( const std::vector<ui_mission_id> &list : hidden_missions ) {
@@ -4639,6 +4727,7 @@ void basecamp::deserialize( const JsonObject &data )
     data.read( "locker_service_queue", locker_service_queue );
     data.read( "locker_next_service_turn", locker_next_service_turn );
     data.read( "next_camp_request_id", next_camp_request_id );
+    data.read( "offscreen", offscreen );
     for( const camp_llm_request &request : camp_requests ) {
         next_camp_request_id = std::max( next_camp_request_id, request.request_id + 1 );
     }
@@ -4787,8 +4876,14 @@ void cata_variant::deserialize( const JsonValue &jsin )
 void event_multiset::serialize( JsonOut &jsout ) const
 {
     jsout.start_object();
-    std::vector<summaries_type::value_type> copy( summaries_.begin(), summaries_.end() );
-    jsout.member( "event_counts", copy );
+    // Written pair by pair rather than through a temporary vector, which for a long game
+    // would copy every distinct event just to save it.
+    jsout.member( "event_counts" );
+    jsout.start_array();
+    for( const summaries_type::value_type &summary : summaries_ ) {
+        jsout.write( summary );
+    }
+    jsout.end_array();
     jsout.end_object();
 }
 
@@ -4802,15 +4897,24 @@ void event_multiset::deserialize( const JsonObject &jo )
         std::vector<std::pair<cata::event::data_type, int>> copy;
         jo.read( "event_counts", copy );
         summaries_.clear();
-        for( const std::pair<cata::event::data_type, int> &p : copy ) {
+        summaries_.reserve( copy.size() );
+        total_count_ = 0;
+        for( std::pair<cata::event::data_type, int> &p : copy ) {
             event_summary summary{ p.second, calendar::start_of_game, calendar::start_of_game };
-            summaries_.emplace( p.first, summary );
+            summaries_.emplace( std::move( p.first ), summary );
+            total_count_ += p.second;
         }
     } else {
         // Read actual summaries
         std::vector<std::pair<cata::event::data_type, event_summary>> copy;
         jo.read( "event_counts", copy );
-        summaries_ = { copy.begin(), copy.end() };
+        summaries_.clear();
+        summaries_.reserve( copy.size() );
+        total_count_ = 0;
+        for( std::pair<cata::event::data_type, event_summary> &p : copy ) {
+            total_count_ += p.second.count;
+            summaries_.emplace( std::move( p.first ), p.second );
+        }
     }
 }
 
@@ -4882,6 +4986,85 @@ void _write_rle_terrain( JsonOut &jsout, std::string_view ter, int num )
     jsout.end_array();
 }
 
+// Packed layers are [ version, [ palette of ids ], "cells" ], where cells holds one
+// digit per tile (two if the palette is larger than the alphabet) indexing the palette.
+constexpr int packed_layer_version = 1;
+constexpr std::string_view packed_layer_digits =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// @p id_at returns the id string of tile ( i, j ).
+template<typename IdAt>
+void _write_packed_layer( JsonOut &jsout, IdAt id_at )
+{
+    std::vector<std::string_view> palette;
+    std::array<int, SEEX * SEEY> cells;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            const std::string_view id = id_at( i, j );
+            auto entry = std::find( palette.begin(), palette.end(), id );
+            if( entry == palette.end() ) {
+                entry = palette.insert( palette.end(), id );
+            }
+            cells[j * SEEX + i] = static_cast<int>( entry - palette.begin() );
+        }
+    }
+    const int base = static_cast<int>( packed_layer_digits.size() );
+    const bool wide = static_cast<int>( palette.size() ) > base;
+    std::string digits;
+    digits.reserve( cells.size() * ( wide ? 2 : 1 ) );
+    for( int cell : cells ) {
+        if( wide ) {
+            digits += packed_layer_digits[cell / base];
+        }
+        digits += packed_layer_digits[cell % base];
+    }
+    jsout.start_array();
+    jsout.write( packed_layer_version );
+    jsout.start_array();
+    for( std::string_view id : palette ) {
+        jsout.write( id );
+    }
+    jsout.end_array();
+    jsout.write( digits );
+    jsout.end_array();
+}
+
+// Reads a layer written by _write_packed_layer, returns its palette and fills in
+// the palette index of every tile in @p cells.
+std::vector<std::string> _read_packed_layer( const JsonValue &jv,
+        std::array<int, SEEX * SEEY> &cells )
+{
+    JsonArray packed = jv;
+    if( packed.next_int() != packed_layer_version ) {
+        packed.throw_error( "Unknown packed submap layer version" );
+    }
+    std::vector<std::string> palette;
+    for( const JsonValue entry : packed.next_array() ) {
+        palette.push_back( entry.get_string() );
+    }
+    const std::string digits = packed.next_string();
+    const int base = static_cast<int>( packed_layer_digits.size() );
+    const size_t width = static_cast<int>( palette.size() ) > base ? 2 : 1;
+    if( digits.size() != cells.size() * width ) {
+        packed.throw_error( "Packed submap layer has the wrong number of tiles" );
+    }
+    for( size_t cell = 0; cell < cells.size(); cell++ ) {
+        int index = 0;
+        for( size_t d = 0; d < width; d++ ) {
+            const size_t digit = packed_layer_digits.find( digits[cell * width + d] );
+            if( digit == std::string_view::npos ) {
+                packed.throw_error( "Packed submap layer has an invalid tile" );
+            }
+            index = index * base + static_cast<int>( digit );
+        }
+        if( index >= static_cast<int>( palette.size() ) ) {
+            packed.throw_error( "Packed submap layer refers past its palette" );
+        }
+        cells[cell] = index;
+    }
+    return palette;
+}
+
 } // namespace
 
 void ter_furn_migrations::load( const JsonObject &jo )
@@ -4992,49 +5175,62 @@ void submap::store( JsonOut &jsout ) const
     jsout.member( "turn_last_touched", last_touched );
     jsout.member( "temperature", temperature_mod );
 
-    // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
-    // this feature but the algorithm is backward compatible.
-    jsout.member( "terrain" );
-    jsout.start_array();
+    // Worlds can opt into palette-packed terrain and furniture, which are smaller
+    // and quicker to read than the per-tile ids. Either form loads in any world.
+    const bool packed = get_option<bool>( "PACKED_SUBMAPS" );
+
     if( is_uniform() ) {
+        jsout.member( "terrain" );
+        jsout.start_array();
         _write_rle_terrain( jsout, uniform_ter.id().str(), SEEX * SEEY );
         jsout.end_array();
         return;
     }
-    std::string last_id;
-    int num_same = 1;
-    for( int j = 0; j < SEEY; j++ ) {
-        // NOLINTNEXTLINE(modernize-loop-convert)
-        for( int i = 0; i < SEEX; i++ ) {
-            const std::string this_id = m->ter[i][j].obj().id.str();
-            if( !last_id.empty() ) {
-                if( this_id == last_id ) {
-                    num_same++;
-                } else {
-                    if( num_same == 1 ) {
-                        // if there's only one element don't write as an array
-                        jsout.write( last_id );
+    if( packed ) {
+        jsout.member( "packed_terrain" );
+        _write_packed_layer( jsout, [&]( int i, int j ) -> const std::string & {
+            return m->ter[i][j].obj().id.str();
+        } );
+    } else {
+        // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
+        // this feature but the algorithm is backward compatible.
+        jsout.member( "terrain" );
+        jsout.start_array();
+        std::string last_id;
+        int num_same = 1;
+        for( int j = 0; j < SEEY; j++ ) {
+            // NOLINTNEXTLINE(modernize-loop-convert)
+            for( int i = 0; i < SEEX; i++ ) {
+                const std::string this_id = m->ter[i][j].obj().id.str();
+                if( !last_id.empty() ) {
+                    if( this_id == last_id ) {
+                        num_same++;
                     } else {
-                        _write_rle_terrain( jsout, last_id, num_same );
-                        num_same = 1;
+                        if( num_same == 1 ) {
+                            // if there's only one element don't write as an array
+                            jsout.write( last_id );
+                        } else {
+                            _write_rle_terrain( jsout, last_id, num_same );
+                            num_same = 1;
+                        }
+                        last_id = this_id;
                     }
+                } else {
                     last_id = this_id;
                 }
-            } else {
-                last_id = this_id;
             }
         }
-    }
-    // Because of the RLE scheme we have to do one last pass
-    if( num_same == 1 ) {
-        jsout.write( last_id );
-    } else {
-        jsout.start_array();
-        jsout.write( last_id );
-        jsout.write( num_same );
+        // Because of the RLE scheme we have to do one last pass
+        if( num_same == 1 ) {
+            jsout.write( last_id );
+        } else {
+            jsout.start_array();
+            jsout.write( last_id );
+            jsout.write( num_same );
+            jsout.end_array();
+        }
         jsout.end_array();
     }
-    jsout.end_array();
 
     // Write out the radiation array in a simple RLE scheme.
     // written in intensity, count pairs
@@ -5062,22 +5258,37 @@ void submap::store( JsonOut &jsout ) const
     jsout.write( count );
     jsout.end_array();
 
-    jsout.member( "furniture" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            const point_sm_ms p( i, j );
-            // Save furniture
-            if( get_furn( p ) ) {
-                jsout.start_array();
-                jsout.write( p.x() );
-                jsout.write( p.y() );
-                jsout.write( get_furn( p ).obj().id );
-                jsout.end_array();
+    if( packed ) {
+        bool has_furniture = false;
+        for( int j = 0; j < SEEY && !has_furniture; j++ ) {
+            for( int i = 0; i < SEEX && !has_furniture; i++ ) {
+                has_furniture = static_cast<bool>( m->frn[i][j] );
+            }
+        }
+        if( has_furniture ) {
+            jsout.member( "packed_furniture" );
+            _write_packed_layer( jsout, [&]( int i, int j ) -> const std::string & {
+                return m->frn[i][j].obj().id.str();
+            } );
+        }
+    } else {
+        jsout.member( "furniture" );
+        jsout.start_array();
+        for( int j = 0; j < SEEY; j++ ) {
+            for( int i = 0; i < SEEX; i++ ) {
+                const point_sm_ms p( i, j );
+                // Save furniture
+                if( get_furn( p ) ) {
+                    jsout.start_array();
+                    jsout.write( p.x() );
+                    jsout.write( p.y() );
+                    jsout.write( get_furn( p ).obj().id );
+                    jsout.end_array();
+                }
             }
         }
+        jsout.end_array();
     }
-    jsout.end_array();
 
     jsout.member( "items" );
     jsout.start_array();
@@ -5311,6 +5522,61 @@ void submap::load( const JsonValue &jv, const std::string &member_name, int vers
                 debugmsg( "Mapbuffer terrain data is corrupt, tile data remaining." );
             }
         }
+    } else if( member_name == "packed_terrain" ) {
+        std::array<int, SEEX * SEEY> cells;
+        const std::vector<std::string> palette = _read_packed_layer( jv, cells );
+        std::vector<std::pair<ter_id, furn_id>> tiles;
+        tiles.reserve( palette.size() );
+        for( const std::string &id : palette ) {
+            ter_str_id terstr( id );
+            furn_id furn = furn_str_id::NULL_ID().id();
+            if( auto it = ter_migrations.find( terstr ); it != ter_migrations.end() ) {
+                terstr = it->second.first;
+                furn = it->second.second.id();
+            }
+            if( terstr.is_valid() ) {
+                tiles.emplace_back( terstr.id(), furn );
+            } else {
+                debugmsg( "invalid ter_str_id '%s'", terstr.c_str() );
+                tiles.emplace_back( ter_t_dirt, furn );
+            }
+        }
+        for( size_t cell = 0; cell < cells.size(); cell++ ) {
+            const std::pair<ter_id, furn_id> &tile = tiles[cells[cell]];
+            m->ter[cell % SEEX][cell / SEEX] = tile.first;
+            if( tile.second ) {
+                m->frn[cell % SEEX][cell / SEEX] = tile.second;
+            }
+        }
+    } else if( member_name == "packed_furniture" ) {
+        std::array<int, SEEX * SEEY> cells;
+        const std::vector<std::string> palette = _read_packed_layer( jv, cells );
+        std::vector<std::pair<ter_id, furn_id>> tiles;
+        tiles.reserve( palette.size() );
+        for( const std::string &id : palette ) {
+            furn_str_id furnstr( id );
+            ter_id ter = ter_str_id::NULL_ID().id();
+            if( auto it = furn_migrations.find( furnstr ); it != furn_migrations.end() ) {
+                furnstr = it->second.second;
+                ter = it->second.first.id();
+            }
+            if( furnstr.is_valid() ) {
+                tiles.emplace_back( ter, furnstr.id() );
+            } else {
+                debugmsg( "invalid furn_str_id '%s'", furnstr.c_str() );
+                tiles.emplace_back( ter, furn_str_id::NULL_ID().id() );
+            }
+        }
+        for( size_t cell = 0; cell < cells.size(); cell++ ) {
+            const std::pair<ter_id, furn_id> &tile = tiles[cells[cell]];
+            if( tile.first ) {
+                m->ter[cell % SEEX][cell / SEEX] = tile.first;
+            }
+            // Empty cells keep furniture a terrain migration may have placed.
+            if( tile.second ) {
+                m->frn[cell % SEEX][cell / SEEX] = tile.second;
+            }
+        }
     } else if( member_name == "radiation" ) {
         int rad_cell = 0;
         JsonArray radiation_rle = jv;
@@ -5389,6 +5655,7 @@ void submap::load( const JsonValue &jv, const std::string &member_name, int vers
             }
         }
     } else if( member_name == "fields" ) {
+        forget_field_cells();
         JsonArray fields_json = jv;
         while( fields_json.has_more() ) {
             // Coordinates loop
@@ -53,14 +53,36 @@ void scent_map::reset()
             val = 0;
         }
     }
+    scented_min = point_bub_ms( MAPSIZE_X, MAPSIZE_Y );
+    scented_max = point_bub_ms( -1, -1 );
     typescent = scenttype_id();
 }
 
+void scent_map::note_scent( const point_bub_ms &p )
+{
+    scented_min = point_bub_ms( std::min( scented_min.x(), p.x() ), std::min( scented_min.y(), p.y() ) );
+    scented_max = point_bub_ms( std::max( scented_max.x(), p.x() ), std::max( scented_max.y(), p.y() ) );
+}
+
+void scent_map::scent_everywhere()
+{
+    scented_min = point_bub_ms::zero;
+    scented_max = point_bub_ms( MAPSIZE_X - 1, MAPSIZE_Y - 1 );
+}
+
 void scent_map::decay()
 {
-    for( auto &elem : grscent ) {
-        for( int &val : elem ) {
+    const point_bub_ms old_min = scented_min;
+    const point_bub_ms old_max = scented_max;
+    scented_min = point_bub_ms( MAPSIZE_X, MAPSIZE_Y );
+    scented_max = point_bub_ms( -1, -1 );
+    for( int x = old_min.x(); x <= old_max.x(); ++x ) {
+        for( int y = old_min.y(); y <= old_max.y(); ++y ) {
+            int &val = grscent[x][y];
             val = std::max( 0, val - 1 );
+            if( val != 0 ) {
+                note_scent( { x, y } );
+            }
         }
     }
 }
@@ -95,6 +117,7 @@ void scent_map::shift( const point_rel_ms &sm_shift )
             grscent[x][y] = inbounds( p ) ? grscent[p.x()][p.y()] : 0;
         }
     }
+    scent_everywhere();
 }
 
 int scent_map::get( const tripoint_bub_ms &p ) const
@@ -115,6 +138,9 @@ void scent_map::set( const tripoint_bub_ms &p, int value, const scenttype_id &ty
 void scent_map::set_unsafe( const tripoint_bub_ms &p, int value, const scenttype_id &type )
 {
     grscent[p.x()][p.y()] = value;
+    if( value != 0 ) {
+        note_scent( p.xy() );
+    }
     if( !type.is_empty() ) {
         typescent = type;
     }
@@ -177,23 +203,31 @@ void scent_map::update( const tripoint_bub_ms &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
+    // Cells further than one step from any scent stay at zero, so only the part of the scent
+    // radius around the scented box has to be diffused.
+    const int scentmap_minx = std::max( center.x() - SCENT_RADIUS, scented_min.x() - 1 );
+    const int scentmap_maxx = std::min( center.x() + SCENT_RADIUS, scented_max.x() + 1 );
+    const int scentmap_miny = std::max( center.y() - SCENT_RADIUS, scented_min.y() - 1 );
+    const int scentmap_maxy = std::min( center.y() + SCENT_RADIUS, scented_max.y() + 1 );
+    if( scentmap_minx > scentmap_maxx || scentmap_miny > scentmap_maxy ) {
+        return;
+    }
+
+    // note: the intermediate matrices need to be at least
     // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
     // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
 
-    // These two matrices are transposed so that x addresses are contiguous in memory
+    // Both indexed [x][y] like grscent, so every inner loop below runs over contiguous memory
+    // without branches and the compiler can vectorize it.
     scent_array<int> sum_3_scent_y;
     scent_array<int> squares_used_y;
 
     // these are for caching flag lookups
     scent_array<bool> blocks_scent; // currently only ter_furn_flag::TFLAG_NO_SCENT blocks scent
     scent_array<bool> reduces_scent;
-
-    // for loop constants
-    const int scentmap_minx = center.x() - SCENT_RADIUS;
-    const int scentmap_maxx = center.x() + SCENT_RADIUS;
-    const int scentmap_miny = center.y() - SCENT_RADIUS;
-    const int scentmap_maxy = center.y() + SCENT_RADIUS;
+    // How much each square takes part in diffusion: 0 blocks it, REDUCE_SCENT squares only let
+    // 20% of the scent through.
+    scent_array<int> weight;
 
     // decrease this to reduce gas spread. Keep it under 125 for
     // stability. This is essentially a decimal number * 1000.
@@ -202,68 +236,78 @@ void scent_map::update( const tripoint_bub_ms &center, map &m )
     // The new scent flag searching function. Should be wayyy faster than the old one.
     m.scent_blockers( blocks_scent, reduces_scent, point_bub_ms( scentmap_minx - 1, scentmap_miny - 1 ),
                       point_bub_ms( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        for( int y = scentmap_miny - 1; y <= scentmap_maxy + 1; ++y ) {
+            weight[x][y] = blocks_scent[x][y] ? 0 : reduces_scent[x][y] ? 2 : 10;
+        }
+    }
     // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
     // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
+    // is a net performance improvement over the old code.
     // note: this method needs an array that is one square larger on each side in the x direction
     // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
     // MAPSIZE_X, but if that changes, this may need tweaking.
     for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        const std::array<int, MAPSIZE_Y> &w = weight[x];
+        const std::array<int, MAPSIZE_Y> &scent = grscent[x];
         for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
             // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
+            sum_3_scent_y[x][y] = w[y - 1] * scent[y - 1] + w[y] * scent[y] + w[y + 1] * scent[y + 1];
+            squares_used_y[x][y] = w[y - 1] + w[y] + w[y + 1];
         }
     }
 
     // Rest of the scent map
+    point_bub_ms new_min( MAPSIZE_X, MAPSIZE_Y );
+    point_bub_ms new_max( -1, -1 );
+    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+        std::array<int, MAPSIZE_Y> &scent = grscent[x];
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            const int squares_used = squares_used_y[x - 1][y]
+                                     + squares_used_y[x][y]
+                                     + squares_used_y[x + 1][y];
+            //less air movement for REDUCE_SCENT square
+            const int this_diffusivity = weight[x][y] == 2 ? diffusivity / 5 : diffusivity;
+            const int scent_here = scent[y];
+            // take the old scent and subtract what diffuses out
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            // neighboring REDUCE_SCENT squares absorb some scent
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            // we've already summed neighboring scent values in the y direction in the previous
+            // loop. Now we do it for the x direction, multiply by diffusion, and this is what
+            // diffuses into our current square.
+            const int diffused = ( temp_scent
+                                   + this_diffusivity * ( sum_3_scent_y[x - 1][y]
+                                           + sum_3_scent_y[x][y]
+                                           + sum_3_scent_y[x + 1][y] )
+                                 ) / ( 1000 * 10 );
+            // cells that block scent via NO_SCENT (in json) hold none
+            scent[y] = weight[x][y] == 0 ? 0 : diffused;
+        }
+    }
+
+    // Scent outside the diffused part is untouched, so the old box only shrinks to the new
+    // one when the diffused part covered all of it.
+    const bool covered = scentmap_minx <= scented_min.x() && scentmap_maxx >= scented_max.x() &&
+                         scentmap_miny <= scented_min.y() && scentmap_maxy >= scented_max.y();
+    if( covered ) {
+        scented_min = point_bub_ms( MAPSIZE_X, MAPSIZE_Y );
+        scented_max = point_bub_ms( -1, -1 );
+    }
     for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
         for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            int &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring REDUCE_SCENT squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent via NO_SCENT (in json)
-                scent_here = 0;
+            if( grscent[x][y] != 0 ) {
+                new_min = point_bub_ms( std::min( new_min.x(), x ), std::min( new_min.y(), y ) );
+                new_max = point_bub_ms( std::max( new_max.x(), x ), std::max( new_max.y(), y ) );
             }
         }
     }
+    if( new_min.x() <= new_max.x() ) {
+        note_scent( new_min );
+        note_scent( new_max );
+    }
 }
 
 namespace
@@ -51,12 +51,19 @@ class scent_map
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
         scent_array<int> grscent;
+        // Corners of a box holding every cell with a non-zero scent, so update() and decay()
+        // can leave the unscented rest of the bubble alone. Empty while max < min.
+        point_bub_ms scented_min; // NOLINT(cata-serialize)
+        point_bub_ms scented_max{ MAPSIZE_X - 1, MAPSIZE_Y - 1 }; // NOLINT(cata-serialize)
         scenttype_id typescent;
         std::optional<tripoint_bub_ms> player_last_position; // NOLINT(cata-serialize)
         time_point player_last_moved = calendar::before_time_starts; // NOLINT(cata-serialize)
 
         const game &gm; // NOLINT(cata-serialize)
 
+        void note_scent( const point_bub_ms &p );
+        void scent_everywhere();
+
     public:
         explicit scent_map( const game &g ) : gm( g ) { }
 
@@ -4,8 +4,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <deque>
 #include <exception>
 #include <filesystem>
 #include <map>
@@ -14,6 +17,7 @@
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -70,6 +74,15 @@ struct sound_effect_resource {
         }
     };
     std::unique_ptr<Mix_Chunk, deleter> chunk;
+    // How far the background loader is with this resource, see chunk_loader.
+    enum class state : uint8_t {
+        unloaded,
+        queued,
+        decoding,
+        ready
+    };
+    state load_state = state::unloaded;
+    std::chrono::steady_clock::time_point last_played;
 };
 
 static int add_sfx_path( const std::string &path );
@@ -311,6 +324,7 @@ static bool check_sound( const int volume = 1 )
 static const Uint16 audio_format =
     AUDIO_S16; // if this ever changes, do_pitch_shift() and slow_motion_sound() will probably need adjustment
 static const int audio_rate = 44100; // samples per second
+static const int sfx_channel_count = 128;
 
 /**
  * Attempt to initialize an audio device.  Returns false if initialization fails.
@@ -327,7 +341,7 @@ bool init_sound()
         // Mix_OpenAudio returns non-zero if something went wrong trying to open the device
         if( !Mix_OpenAudioDevice( audio_rate, audio_format, audio_channels, audio_buffers, nullptr,
                                   SDL_AUDIO_ALLOW_FREQUENCY_CHANGE ) ) {
-            Mix_AllocateChannels( 128 );
+            Mix_AllocateChannels( sfx_channel_count );
             Mix_ReserveChannels( static_cast<int>( sfx::channel::MAX_CHANNEL ) );
 
             // For the sound effects system.
@@ -343,6 +357,8 @@ bool init_sound()
             Mix_GroupChannels( static_cast<int>( sfx::channel::stamina_75 ),
                                static_cast<int>( sfx::channel::stamina_35 ),
                                static_cast<int>( sfx::group::low_stamina ) );
+            Mix_GroupChannels( static_cast<int>( sfx::channel::MAX_CHANNEL ), sfx_channel_count - 1,
+                               static_cast<int>( sfx::group::pooled ) );
 
             sound_init_success = true;
         } else {
@@ -352,8 +368,11 @@ bool init_sound()
 
     return sound_init_success;
 }
+static void stop_sfx_loader();
+
 void shutdown_sound()
 {
+    stop_sfx_loader();
     // De-allocate all loaded sound.
     sfx_resources.resource.clear();
     sfx_resources.sound_effects.clear();
@@ -519,28 +538,220 @@ static Mix_Chunk *make_null_chunk()
     return nchunk;
 }
 
-static Mix_Chunk *load_chunk( const std::string &path )
+// Safe to call off the main thread, it neither logs nor touches the mixer's channels.
+static Mix_Chunk *decode_chunk( const sound_effect_resource &resource, std::string &error )
 {
+    const std::string path = ( current_soundpack_path / resource.path ).generic_u8string();
     Mix_Chunk *result = Mix_LoadWAV( path.c_str() );
     if( result == nullptr ) {
-        // Failing to load a sound file is not a fatal error worthy of a backtrace
-        dbg( D_WARNING ) << "Failed to load sfx audio file " << path << ": " << Mix_GetError();
+        error = Mix_GetError();
         result = make_null_chunk();
     }
     return result;
 }
 
-// Check to see if the resource has already been loaded
-// - Loaded: Return stored pointer
-// - Not Loaded: Load chunk from stored resource path
+namespace
+{
+/**
+ * Decodes the sound pack's effects on a thread of its own, the preloaded ones first, so that
+ * an effect is rarely decoded on the main thread in the middle of play. Decoded chunks are
+ * kept up to a budget of bytes. Past it the ones least recently played, and not playing right
+ * now, are freed again and decoded anew when next played.
+ *
+ * The loader thread, and whatever thread plays a sound (see sfx::sound_thread), only decode.
+ * Freeing (Mix_FreeChunk halts the channels playing the chunk) and logging are queued for the
+ * main thread, see upkeep.
+ */
+class chunk_loader
+{
+    public:
+        ~chunk_loader() {
+            stop();
+        }
+
+        /** Starts decoding the resources @p order lists, in that order. */
+        void start( const std::vector<int> &order ) {
+            stop();
+            for( const int id : order ) {
+                sound_effect_resource &resource = sfx_resources.resource[id];
+                if( resource.load_state == sound_effect_resource::state::unloaded ) {
+                    resource.load_state = sound_effect_resource::state::queued;
+                    queue.push_back( id );
+                }
+            }
+            if( !queue.empty() ) {
+                thread = std::thread( &chunk_loader::run, this );
+            }
+        }
+
+        /** Drops whatever is still queued and waits for the thread, before the resources change. */
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            if( thread.joinable() ) {
+                thread.join();
+            }
+            unqueue_all();
+            decoded_bytes = 0;
+            for( const sound_effect_resource &resource : sfx_resources.resource ) {
+                if( resource.chunk ) {
+                    decoded_bytes += resource.chunk->alen;
+                }
+            }
+            stopping = false;
+        }
+
+        /** The decoded chunk of @p resource_id, decoded here and now if the thread hasn't yet. */
+        Mix_Chunk *acquire( int resource_id ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            sound_effect_resource &resource = sfx_resources.resource[resource_id];
+            decoded.wait( lock, [&resource] {
+                return resource.load_state != sound_effect_resource::state::decoding;
+            } );
+            if( resource.load_state != sound_effect_resource::state::ready ) {
+                resource.load_state = sound_effect_resource::state::decoding;
+                lock.unlock();
+                std::string error;
+                Mix_Chunk *chunk = decode_chunk( resource, error );
+                lock.lock();
+                store( resource, chunk, std::move( error ) );
+            }
+            resource.last_played = std::chrono::steady_clock::now();
+            return resource.chunk.get();
+        }
+
+        /** Logs the effects that failed to decode and frees chunks past the budget, main thread only. */
+        void upkeep() {
+            std::vector<std::pair<std::string, std::string>> failed;
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                failed.swap( failures );
+                if( decoded_bytes > max_decoded_bytes ) {
+                    trim();
+                }
+            }
+            for( const std::pair<std::string, std::string> &failure : failed ) {
+                // Failing to load a sound file is not a fatal error worthy of a backtrace
+                dbg( D_WARNING ) << "Failed to load sfx audio file " << failure.first << ": " << failure.second;
+            }
+        }
+
+    private:
+        // Some 25 minutes of 44.1 kHz stereo.
+        static constexpr size_t max_decoded_bytes = 256 * 1024 * 1024;
+        // Trimming goes down to this, so it isn't needed again at the very next sound.
+        static constexpr size_t trimmed_decoded_bytes = max_decoded_bytes / 4 * 3;
+        // A chunk acquired this recently may not be on a channel yet, so it isn't freed.
+        static constexpr std::chrono::seconds about_to_play{ 1 };
+
+        void run() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( !stopping && !queue.empty() ) {
+                sound_effect_resource &resource = sfx_resources.resource[queue.front()];
+                queue.pop_front();
+                if( resource.load_state != sound_effect_resource::state::queued ) {
+                    // Played, and so decoded, before the thread got to it.
+                    continue;
+                }
+                if( decoded_bytes >= max_decoded_bytes ) {
+                    // The rest is decoded when first played.
+                    resource.load_state = sound_effect_resource::state::unloaded;
+                    unqueue_all();
+                    break;
+                }
+                resource.load_state = sound_effect_resource::state::decoding;
+                lock.unlock();
+                std::string error;
+                Mix_Chunk *chunk = decode_chunk( resource, error );
+                lock.lock();
+                store( resource, chunk, std::move( error ) );
+            }
+        }
+
+        // The mutex must be held.
+        void store( sound_effect_resource &resource, Mix_Chunk *chunk, std::string &&error ) {
+            resource.chunk.reset( chunk );
+            if( !error.empty() ) {
+                failures.emplace_back( resource.path, std::move( error ) );
+            }
+            resource.load_state = sound_effect_resource::state::ready;
+            decoded_bytes += chunk->alen;
+            decoded.notify_all();
+        }
+
+        // The mutex must be held, or the thread not running.
+        void unqueue_all() {
+            for( const int id : queue ) {
+                sound_effect_resource &resource = sfx_resources.resource[id];
+                if( resource.load_state == sound_effect_resource::state::queued ) {
+                    resource.load_state = sound_effect_resource::state::unloaded;
+                }
+            }
+            queue.clear();
+        }
+
+        // Frees the least recently played chunks, main thread only and the mutex must be held.
+        void trim() {
+            const std::chrono::steady_clock::time_point recent = std::chrono::steady_clock::now() -
+                    about_to_play;
+            std::vector<const Mix_Chunk *> playing;
+            for( int channel = 0; channel < sfx_channel_count; ++channel ) {
+                if( Mix_Playing( channel ) ) {
+                    playing.push_back( Mix_GetChunk( channel ) );
+                }
+            }
+            std::vector<sound_effect_resource *> candidates;
+            for( sound_effect_resource &resource : sfx_resources.resource ) {
+                if( resource.last_played < recent &&
+                    resource.load_state == sound_effect_resource::state::ready &&
+                    std::find( playing.begin(), playing.end(), resource.chunk.get() ) == playing.end() ) {
+                    candidates.push_back( &resource );
+                }
+            }
+            std::sort( candidates.begin(), candidates.end(), []( const sound_effect_resource * lhs,
+            const sound_effect_resource * rhs ) {
+                return lhs->last_played < rhs->last_played;
+            } );
+            for( sound_effect_resource *resource : candidates ) {
+                if( decoded_bytes <= trimmed_decoded_bytes ) {
+                    break;
+                }
+                decoded_bytes -= resource->chunk->alen;
+                resource->chunk.reset();
+                resource->load_state = sound_effect_resource::state::unloaded;
+            }
+        }
+
+        std::thread thread;
+        std::deque<int> queue;
+        std::mutex mutex;
+        // Notified whenever a resource is done decoding.
+        std::condition_variable decoded;
+        bool stopping = false;
+        size_t decoded_bytes = 0;
+        // Paths and errors of the effects that failed to decode, logged by upkeep.
+        std::vector<std::pair<std::string, std::string>> failures;
+};
+
+// After sfx_resources, so it is destroyed, and its thread joined, first.
+chunk_loader sfx_loader;
+} // namespace
+
+static void stop_sfx_loader()
+{
+    sfx_loader.stop();
+}
+
+void sfx::do_sfx_loader_upkeep()
+{
+    sfx_loader.upkeep();
+}
+
 static Mix_Chunk *get_sfx_resource( int resource_id )
 {
-    sound_effect_resource &resource = sfx_resources.resource[ resource_id ];
-    if( !resource.chunk ) {
-        cata_path path = current_soundpack_path / resource.path;
-        resource.chunk.reset( load_chunk( path.generic_u8string() ) );
-    }
-    return resource.chunk.get();
+    return sfx_loader.acquire( resource_id );
 }
 
 static int add_sfx_path( const std::string &path )
@@ -824,6 +1035,27 @@ struct sound_effect_handler {
         }
     }
 
+    // A free channel of the pool, or else the one playing the oldest sound, which is cut short.
+    // Left to itself SDL_mixer drops the new sound when every channel is busy, but in a fight
+    // the newest sounds are the ones that matter.
+    static int pooled_channel() {
+        const int pool = static_cast<int>( sfx::group::pooled );
+        int channel = Mix_GroupAvailable( pool );
+        if( channel != -1 ) {
+            return channel;
+        }
+        channel = Mix_GroupOldest( pool );
+        if( channel == -1 ) {
+            return static_cast<int>( sfx::channel::any );
+        }
+        std::lock_guard<std::mutex> lock( channels_to_end_mutex );
+        // It may be due to be halted, which mustn't happen to the sound taking its place.
+        channels_to_end.erase( std::remove( channels_to_end.begin(), channels_to_end.end(),
+                                            static_cast<sfx::channel>( channel ) ), channels_to_end.end() );
+        Mix_HaltChannel( channel );
+        return channel;
+    }
+
     // returns false if failed
     // note: nloops == 0 means sound plays once, 1 means twice, etc. -1 means loops for (not actually) forever
     static bool make_audio( int audioChannel, Mix_Chunk *audio_src, int nloops, int volume,
@@ -851,6 +1083,9 @@ struct sound_effect_handler {
 
         Mix_VolumeChunk( audio_src,
                          effect.volume * get_option<int>( "SOUND_EFFECT_VOLUME" ) * volume / ( 100 * 100 ) );
+        if( audioChannel == static_cast<int>( sfx::channel::any ) ) {
+            audioChannel = pooled_channel();
+        }
         int channel;
 
         // to ensure the effect doesn't stop early, we tell SDL to loop it indefinitely. the slowed_time_effect callback will halt the sound effect at the appropriate time.
@@ -1070,6 +1305,8 @@ void load_soundset()
         dbg( D_INFO ) << '"' << current_soundpack << '"' << " soundpack: found path: " << soundpack_path;
     }
 
+    // The resources are about to change under it.
+    stop_sfx_loader();
     current_soundpack_path = soundpack_path;
     try {
         DynamicDataLoader::get_instance().load_data_from_path( soundpack_path, "core" );
@@ -1077,15 +1314,20 @@ void load_soundset()
         debugmsg( "failed to load sounds: %s", err.what() );
     }
 
-    // Preload sound effects
+    // Decode sound effects in the background, those to preload first.
+    std::vector<int> decode_order;
     for( const sfx_args &preload : sfx_preload ) {
         const std::vector<sound_effect> *find_result = sfx_resources.sound_effects.find( preload );
         if( find_result != sfx_resources.sound_effects.end() ) {
             for( const sound_effect &sfx : *find_result ) {
-                get_sfx_resource( sfx.resource_id );
+                decode_order.push_back( sfx.resource_id );
             }
         }
     }
+    for( int id = 0; id < static_cast<int>( sfx_resources.resource.size() ); ++id ) {
+        decode_order.push_back( id );
+    }
+    sfx_loader.start( decode_order );
 
     // Memory of unique_paths no longer required, swap with locally scoped unordered_map
     // to force deallocation of resources.
@@ -23,6 +23,7 @@
 #include <stack>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 #if defined(_MSC_VER) && defined(USE_VCPKG)
 #   include <SDL2/SDL_image.h>
@@ -59,6 +60,7 @@
 #include "map.h"
 #include "map_extras.h"
 #include "mapbuffer.h"
+#include "memory_report.h"
 #include "mission.h"
 #include "npc.h"
 #include "options.h"
@@ -1274,6 +1276,8 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
     static const std::string space_string = " ";
 
     const bool option_use_draw_ascii_lines_routine = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
+    // Codepoint and cell width of each glyph on a line, width 0 for cells without one.
+    static std::vector<std::pair<int, int>> cell_glyphs;
     bool update = false;
     for( int j = 0; j < win->height; j++ ) {
         if( !win->line[j].touched ) {
@@ -1290,6 +1294,20 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
                         color_as_sdl( catacurses::black ) );
         update = true;
         win->line[j].touched = false;
+
+        // Backgrounds go first, with runs of same colored cells filled as one rectangle,
+        // then the glyphs on top of them.
+        cell_glyphs.assign( win->width, { 0, 0 } );
+        point bg_start;
+        int bg_width = 0;
+        catacurses::base_color bg_color = catacurses::black;
+        const auto flush_bg = [&]() {
+            if( bg_width > 0 ) {
+                geometry->rect( renderer, bg_start, bg_width, font->height,
+                                color_as_sdl( bg_color ) );
+            }
+            bg_width = 0;
+        };
         for( int i = 0; i < win->width; i++ ) {
             const cursecell &cell = win->line[j].chars[i];
 
@@ -1303,22 +1321,39 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
                 continue; // second cell of a multi-cell character
             }
 
+            int cw = 1;
             // Spaces are used a lot, so this does help noticeably
-            if( cell.ch == space_string ) {
-                if( cell.BG != catacurses::black ) {
-                    geometry->rect( renderer, draw, font->width, font->height,
-                                    color_as_sdl( cell.BG ) );
+            if( cell.ch != space_string ) {
+                const int codepoint = UTF8_getch( cell.ch );
+                cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( cell.ch );
+                if( cw < 1 ) {
+                    // utf8_width() may return a negative width
+                    continue;
                 }
+                cell_glyphs[i] = { codepoint, cw };
+            }
+            if( cell.BG == catacurses::black ) {
                 continue;
             }
-            const int codepoint = UTF8_getch( cell.ch );
-            const catacurses::base_color FG = cell.FG;
-            const catacurses::base_color BG = cell.BG;
-            int cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( cell.ch );
-            if( cw < 1 ) {
-                // utf8_width() may return a negative width
+            if( bg_width > 0 && cell.BG == bg_color && bg_start.x + bg_width == draw.x ) {
+                bg_width += font->width * cw;
+            } else {
+                flush_bg();
+                bg_start = draw;
+                bg_width = font->width * cw;
+                bg_color = cell.BG;
+            }
+        }
+        flush_bg();
+
+        for( int i = 0; i < win->width; i++ ) {
+            const int codepoint = cell_glyphs[i].first;
+            if( cell_glyphs[i].second == 0 ) {
                 continue;
             }
+            const cursecell &cell = win->line[j].chars[i];
+            const point draw( offset + point( i * font->width, j * font->height ) );
+            const catacurses::base_color FG = cell.FG;
             bool use_draw_ascii_lines_routine = option_use_draw_ascii_lines_routine;
             unsigned char uc = static_cast<unsigned char>( cell.ch[0] );
             switch( codepoint ) {
@@ -1362,10 +1397,6 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
                     use_draw_ascii_lines_routine = false;
                     break;
             }
-            if( cell.BG != catacurses::black ) {
-                geometry->rect( renderer, draw, font->width * cw, font->height,
-                                color_as_sdl( BG ) );
-            }
             if( use_draw_ascii_lines_routine ) {
                 font->draw_ascii_lines( renderer, geometry, uc, draw, FG );
             } else {
@@ -4052,6 +4083,16 @@ void input_manager::pump_events()
     previously_pressed_key = 0;
 }
 
+bool input_manager::has_pending_key_input() const
+{
+    if( test_mode ) {
+        return false;
+    }
+    SDL_PumpEvents();
+    return SDL_PeepEvents( nullptr, 0, SDL_PEEKEVENT, SDL_KEYDOWN, SDL_KEYDOWN ) > 0 ||
+           SDL_PeepEvents( nullptr, 0, SDL_PEEKEVENT, SDL_TEXTINPUT, SDL_TEXTINPUT ) > 0;
+}
+
 // This is how we're actually going to handle input events, SDL getch
 // is simply a wrapper around this.
 input_event input_manager::get_input_event( const keyboard_mode preferred_keyboard_mode )
@@ -4150,6 +4191,29 @@ void rescale_tileset( int size )
     tilecontext->set_draw_scale( size );
 }
 
+void add_tileset_memory_usage( memory_report::report &out )
+{
+    // The near, far and overmap contexts can share a tileset, each sheet counts once.
+    std::unordered_set<SDL_Texture *> atlases;
+    for( const cata_tiles *context : {
+             closetilecontext.get(), fartilecontext.get(), overmap_tilecontext.get()
+         } ) {
+        if( context != nullptr ) {
+            context->collect_atlases( atlases );
+        }
+    }
+    size_t bytes = 0;
+    for( SDL_Texture *atlas : atlases ) {
+        Uint32 format = 0;
+        int width = 0;
+        int height = 0;
+        if( SDL_QueryTexture( atlas, &format, nullptr, &width, &height ) == 0 ) {
+            bytes += static_cast<size_t>( width ) * height * SDL_BYTESPERPIXEL( format );
+        }
+    }
+    out.add( "tileset_textures", atlases.size(), bytes );
+}
+
 static window_dimensions get_window_dimensions( const catacurses::window &win,
         const point &pos, const point &size )
 {
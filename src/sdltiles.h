@@ -25,6 +25,10 @@ class window;
 #endif
 
 class cata_tiles;
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 
 struct weather_type;
 
@@ -48,6 +52,8 @@ extern int fontwidth;
 // and only from there.
 void load_tileset();
 void rescale_tileset( int size );
+// Adds the sprite sheets of every loaded tileset, as decoded pixels, to the memory report.
+void add_tileset_memory_usage( memory_report::report &out );
 bool save_screenshot( const std::string &file_path );
 void toggle_fullscreen_window();
 
@@ -165,7 +165,7 @@ template<int xx_transform, int xy_transform, int yx_transform, int yy_transform,
 void cast_horizontal_zlight_segment(
     const array_of_grids_of<T> &output_caches,
     const array_of_grids_of<const T> &input_arrays,
-    const array_of_grids_of<const bool> &floor_caches,
+    const array_of_floor_caches &floor_caches,
     const tripoint_bub_ms &offset, const int offset_distance,
     const T numerator )
 {
@@ -200,6 +200,9 @@ void cast_horizontal_zlight_segment(
 
         for( auto this_span = spans.begin(); this_span != spans.end(); ) {
             bool started_block = false;
+            // While sweeping one span calc() only varies with the distance, which neighbouring
+            // cells mostly share, so only evaluate it when the distance changes.
+            int intensity_dist = -1;
             // TODO: Precalculate min/max delta.z based on start/end and distance
             for( delta.z() = 0; delta.z() <= distance; delta.z()++ ) {
                 // Shadowcasting sweeps from the cardinal to the most extreme edge of the octant
@@ -300,7 +303,10 @@ void cast_horizontal_zlight_segment(
                     }
 
                     const int dist = rl_dist( tripoint_rel_ms::zero, delta ) + offset_distance;
-                    last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    if( dist != intensity_dist ) {
+                        intensity_dist = dist;
+                        last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    }
 
                     if( !floor_block ) {
                         ( *output_caches[z_index] )[current.x()][current.y()] =
@@ -362,7 +368,7 @@ template<int x_transform, int y_transform, int z_transform, typename T,
 void cast_vertical_zlight_segment(
     const array_of_grids_of<T> &output_caches,
     const array_of_grids_of<const T> &input_arrays,
-    const array_of_grids_of<const bool> &floor_caches,
+    const array_of_floor_caches &floor_caches,
     const tripoint_bub_ms &offset, const int offset_distance,
     const T numerator )
 {
@@ -395,6 +401,9 @@ void cast_vertical_zlight_segment(
 
         for( auto this_span = spans.begin(); this_span != spans.end(); ) {
             bool started_block = false;
+            // While sweeping one span calc() only varies with the distance, which neighbouring
+            // cells mostly share, so only evaluate it when the distance changes.
+            int intensity_dist = -1;
             for( delta.y() = 0; delta.y() <= distance; delta.y()++ ) {
                 // See comment above trailing_edge_major and leading_edge_major in above function.
                 const slope trailing_edge_major( delta.y() * 2 - 1, delta.z() * 2 + 1 );
@@ -472,7 +481,10 @@ void cast_vertical_zlight_segment(
                     }
 
                     const int dist = rl_dist( tripoint_rel_ms::zero, delta ) + offset_distance;
-                    last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    if( dist != intensity_dist ) {
+                        intensity_dist = dist;
+                        last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    }
 
                     if( !floor_block ) {
                         ( *output_caches[z_index] )[current.x()][current.y()] =
@@ -533,7 +545,7 @@ template<typename T, T( *calc )( const T &, const T &, const int & ),
 void cast_zlight(
     const array_of_grids_of<T> &output_caches,
     const array_of_grids_of<const T> &input_arrays,
-    const array_of_grids_of<const bool> &floor_caches,
+    const array_of_floor_caches &floor_caches,
     const tripoint_bub_ms &origin, const int offset_distance, const T numerator,
     vertical_direction dir )
 {
@@ -667,13 +679,13 @@ void cast_zlight(
 template void cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
     const array_of_grids_of<float> &output_caches,
     const array_of_grids_of<const float> &input_arrays,
-    const array_of_grids_of<const bool> &floor_caches,
+    const array_of_floor_caches &floor_caches,
     const tripoint_bub_ms &origin, int offset_distance, float numerator,
     vertical_direction dir );
 
 template void cast_zlight<fragment_cloud, shrapnel_calc, shrapnel_check, accumulate_fragment_cloud>(
     const array_of_grids_of<fragment_cloud> &output_caches,
     const array_of_grids_of<const fragment_cloud> &input_arrays,
-    const array_of_grids_of<const bool> &floor_caches,
+    const array_of_floor_caches &floor_caches,
     const tripoint_bub_ms &origin, int offset_distance, fragment_cloud numerator,
     vertical_direction dir );
@@ -132,6 +132,9 @@ using array_of_grids_of =
     std::array<cata::mdarray<T, point_bub_ms>*, OVERMAP_LAYERS>
     >;
 
+// The floor caches of every layer, see level_cache::floor_cache.
+using array_of_floor_caches = std::array<const cata::mdbitset<point_bub_ms>*, OVERMAP_LAYERS>;
+
 // TODO: Generalize the floor check, allow semi-transparent floors
 template< typename T, T( *calc )( const T &, const T &, const int & ),
           bool( *check )( const T &, const T & ),
@@ -139,7 +142,7 @@ template< typename T, T( *calc )( const T &, const T &, const int & ),
 void cast_zlight(
     const array_of_grids_of<T> &output_caches,
     const array_of_grids_of<const T> &input_arrays,
-    const array_of_grids_of<const bool> &floor_caches,
+    const array_of_floor_caches &floor_caches,
     const tripoint_bub_ms &origin, int offset_distance, T numerator,
     vertical_direction dir = vertical_direction::BOTH );
 
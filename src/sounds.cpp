@@ -360,14 +360,42 @@ static void vector_quick_remove( std::vector<C> &source, int index )
     source.pop_back();
 }
 
+// Merges the sounds made on the same tile, such as the shots of an automatic burst, into one
+// source per tile. It is as loud as the loudest of them and weighs as much as all of them,
+// which is what clustering them together would give, minus the duplicated seed clusters.
+static std::vector<centroid> coalesce_sounds(
+    const std::vector<std::pair<tripoint_bub_ms, monster_sound_event>> &input_sounds )
+{
+    std::vector<centroid> sources;
+    sources.reserve( input_sounds.size() );
+    std::unordered_map<tripoint_bub_ms, size_t> source_at;
+    for( const auto &sound_event_pair : input_sounds ) {
+        const tripoint_bub_ms &p = sound_event_pair.first;
+        const float volume = static_cast<float>( sound_event_pair.second.volume );
+        const auto inserted = source_at.emplace( p, sources.size() );
+        if( inserted.second ) {
+            sources.push_back( {
+                static_cast<float>( p.x() ), static_cast<float>( p.y() ), static_cast<float>( p.z() ),
+                volume, volume, sound_event_pair.second.provocative
+            } );
+            continue;
+        }
+        centroid &source = sources[inserted.first->second];
+        source.volume = std::max( source.volume, volume );
+        source.weight += volume;
+        source.provocative |= sound_event_pair.second.provocative;
+    }
+    return sources;
+}
+
 static std::vector<centroid> cluster_sounds(
-    std::vector<std::pair<tripoint_bub_ms, monster_sound_event>>
-    input_sounds )
+    const std::vector<std::pair<tripoint_bub_ms, monster_sound_event>> &recorded_sounds )
 {
     // If there are too many monsters and too many noise sources (which can be monsters, go figure),
     // applying sound events to monsters can dominate processing time for the whole game,
     // so we cluster sounds and apply the centroids of the sounds to the monster AI
     // to fight the combinatorial explosion.
+    std::vector<centroid> input_sounds = coalesce_sounds( recorded_sounds );
     std::vector<centroid> sound_clusters;
     if( input_sounds.empty() ) {
         return sound_clusters;
@@ -381,18 +409,12 @@ static std::vector<centroid> cluster_sounds(
     // Randomly choose cluster seeds.
     for( size_t i = input_sounds.size(); i > stopping_point; i-- ) {
         size_t index = rng( 0, i - 1 );
-        // The volume and cluster weight are the same for the first element.
-        sound_clusters.push_back(
-            // Assure the compiler that these int->float conversions are safe.
-        {
-            static_cast<float>( input_sounds[index].first.x() ), static_cast<float>( input_sounds[index].first.y() ),
-            static_cast<float>( input_sounds[index].first.z() ),
-            static_cast<float>( input_sounds[index].second.volume ), static_cast<float>( input_sounds[index].second.volume ),
-            input_sounds[index].second.provocative
-        } );
+        sound_clusters.push_back( input_sounds[index] );
         vector_quick_remove( input_sounds, index );
     }
-    for( const auto &sound_event_pair : input_sounds ) {
+    for( const centroid &source : input_sounds ) {
+        const tripoint_bub_ms source_pos( static_cast<int>( source.x ), static_cast<int>( source.y ),
+                                          static_cast<int>( source.z ) );
         auto found_centroid = sound_clusters.begin();
         float dist_factor = max_map_distance;
         const auto cluster_end = sound_clusters.end();
@@ -400,31 +422,26 @@ static std::vector<centroid> cluster_sounds(
              ++centroid_iter ) {
             // Scale the distance between the two by the max possible distance.
             tripoint_bub_ms centroid_pos { static_cast<int>( centroid_iter->x ), static_cast<int>( centroid_iter->y ), static_cast<int>( centroid_iter->z ) };
-            const int dist = sound_distance( tripoint_bub_ms( sound_event_pair.first ), centroid_pos );
+            const int dist = sound_distance( source_pos, centroid_pos );
             if( dist * dist < dist_factor ) {
                 found_centroid = centroid_iter;
                 dist_factor = dist * dist;
             }
         }
-        const float volume_sum = static_cast<float>( sound_event_pair.second.volume ) +
-                                 found_centroid->weight;
+        const float volume_sum = source.weight + found_centroid->weight;
         // Set the centroid location to the average of the two locations, weighted by volume.
-        found_centroid->x = static_cast<float>( ( sound_event_pair.first.x() *
-                                                sound_event_pair.second.volume ) +
-                                                ( found_centroid->x * found_centroid->weight ) ) / volume_sum;
-        found_centroid->y = static_cast<float>( ( sound_event_pair.first.y() *
-                                                sound_event_pair.second.volume ) +
-                                                ( found_centroid->y * found_centroid->weight ) ) / volume_sum;
-        found_centroid->z = static_cast<float>( ( sound_event_pair.first.z() *
-                                                sound_event_pair.second.volume ) +
-                                                ( found_centroid->z * found_centroid->weight ) ) / volume_sum;
+        found_centroid->x = ( source.x * source.weight + found_centroid->x * found_centroid->weight ) /
+                            volume_sum;
+        found_centroid->y = ( source.y * source.weight + found_centroid->y * found_centroid->weight ) /
+                            volume_sum;
+        found_centroid->z = ( source.z * source.weight + found_centroid->z * found_centroid->weight ) /
+                            volume_sum;
         // Set the centroid volume to the larger of the volumes.
-        found_centroid->volume = std::max( found_centroid->volume,
-                                           static_cast<float>( sound_event_pair.second.volume ) );
+        found_centroid->volume = std::max( found_centroid->volume, source.volume );
         // Set the centroid weight to the sum of the weights.
         found_centroid->weight = volume_sum;
         // Set and keep provocative if any sound in the centroid is provocative
-        found_centroid->provocative |= sound_event_pair.second.provocative;
+        found_centroid->provocative |= source.provocative;
     }
     return sound_clusters;
 }
@@ -461,6 +478,14 @@ void sounds::process_sounds()
 
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = get_weather().weather_id->sound_attn;
+    // Collected once for all clusters. A trap that goes off is checked again through tr_at().
+    std::vector<tripoint_bub_ms> sound_trap_locations;
+    if( !sound_clusters.empty() ) {
+        for( const trap *trapType : trap::get_sound_triggered_traps() ) {
+            const std::vector<tripoint_bub_ms> &locations = here.trap_locations( trapType->id );
+            sound_trap_locations.insert( sound_trap_locations.end(), locations.begin(), locations.end() );
+        }
+    }
     for( const centroid &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -477,8 +502,14 @@ void sounds::process_sounds()
             const tripoint_abs_sm target( abs_sm, source.z() );
             overmap_buffer.signal_hordes( target, sig_power );
         }
-        // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        // Alert all monsters (that can hear) to the sound. The sound distance is never
+        // shorter than the horizontal one, so nobody outside this box can hear it.
+        for( Creature *listener : get_creature_tracker().creatures_in_radius( here.get_abs( source ),
+                vol * 2, OVERMAP_LAYERS ) ) {
+            if( !listener->is_monster() ) {
+                continue;
+            }
+            monster &critter = *listener->as_monster();
             // TODO: Generalize this to Creature::hear_sound
             const int dist = sound_distance( source, critter.pos_bub() );
             if( vol * 2 > dist ) {
@@ -487,15 +518,13 @@ void sounds::process_sounds()
             }
         }
         // Trigger sound-triggered traps and ensure they are still valid
-        for( const trap *trapType : trap::get_sound_triggered_traps() ) {
-            for( const tripoint_bub_ms &tp : here.trap_locations( trapType->id ) ) {
-                const int dist = sound_distance( source, tp );
-                const trap &tr = here.tr_at( tp );
-                // Exclude traps that certainly won't hear the sound
-                if( vol * 2 > dist ) {
-                    if( tr.triggered_by_sound( vol, dist ) ) {
-                        tr.trigger( tp );
-                    }
+        for( const tripoint_bub_ms &tp : sound_trap_locations ) {
+            const int dist = sound_distance( source, tp );
+            const trap &tr = here.tr_at( tp );
+            // Exclude traps that certainly won't hear the sound
+            if( vol * 2 > dist ) {
+                if( tr.triggered_by_sound( vol, dist ) ) {
+                    tr.trigger( tp );
                 }
             }
         }
@@ -2029,6 +2058,7 @@ void sfx::stop_sound_effect_fade( channel, int ) { }
 void sfx::stop_sound_effect_timed( channel, int ) { }
 void sfx::do_player_death_hurt( const Character &, bool ) { }
 void sfx::do_low_stamina_sfx() { }
+void sfx::do_sfx_loader_upkeep() { }
 void sfx::do_obstacle( const std::string & ) { }
 void sfx::play_variant_sound( const std::string &, const std::string &, const std::string &,
                               const std::optional<bool> &, const std::optional<bool> &, int ) { }
@@ -139,7 +139,8 @@ enum class group : int {
     weather = 1,    //SFX related to weather
     time_of_day,    //SFX related to time of day
     context_themes, //SFX related to context themes
-    low_stamina         //SFX related to low_stamina
+    low_stamina,        //SFX related to low_stamina
+    pooled              //the unreserved channels one-off SFX play on
 };
 
 void load_sound_effects( const JsonObject &jsobj );
@@ -190,6 +191,9 @@ void stop_sound_effect_timed( channel channel, int time );
 int set_channel_volume( channel channel, int volume );
 void do_player_death_hurt( const Character &target, bool death );
 void do_low_stamina_sfx();
+// Frees decoded effects past the budget and logs failed decodes, queued by any thread.
+// Main thread only.
+void do_sfx_loader_upkeep();
 // @param obst should be string id of obstacle terrain or vehicle part
 void do_obstacle( const std::string &obst = "" );
 } // namespace sfx
@@ -85,11 +85,7 @@ void event_multiset::set_type( event_type type )
 
 int event_multiset::count() const
 {
-    int total = 0;
-    for( const auto &pair : summaries_ ) {
-        total += pair.second.count;
-    }
-    return total;
+    return total_count_;
 }
 
 int event_multiset::count( const cata::event::data_type &criteria ) const
@@ -186,11 +182,13 @@ std::optional<event_multiset::summaries_type::value_type> event_multiset::last()
 void event_multiset::add( const cata::event &e )
 {
     summaries_[e.data()].add( e );
+    ++total_count_;
 }
 
 void event_multiset::add( const summaries_type::value_type &e )
 {
     summaries_[e.first].add( e.second );
+    total_count_ += e.second.count;
 }
 
 base_watcher::~base_watcher()
@@ -200,12 +198,13 @@ base_watcher::~base_watcher()
     }
 }
 
-void base_watcher::on_subscribe( stats_tracker *s )
+void base_watcher::on_subscribe( stats_tracker *s, base_watcher_set *set )
 {
     if( subscribed_to ) {
         debugmsg( "Subscribing a single base_watcher multiple times is not supported" );
     }
     subscribed_to = s;
+    subscribed_set = set;
 }
 
 void base_watcher::on_unsubscribe( stats_tracker *s )
@@ -214,6 +213,7 @@ void base_watcher::on_unsubscribe( stats_tracker *s )
         debugmsg( "Unexpected notification of unsubscription from wrong stats_tracker" );
     } else {
         subscribed_to = nullptr;
+        subscribed_set = nullptr;
     }
 }
 
@@ -247,15 +247,17 @@ cata_variant stats_tracker::value_of( const string_id<event_statistic> &stat )
 
 void stats_tracker::add_watcher( event_type type, event_multiset_watcher *watcher )
 {
-    event_type_watchers[type].insert( watcher );
-    watcher->on_subscribe( this );
+    watcher_set<event_multiset_watcher> &set = event_type_watchers[type];
+    set.insert( watcher );
+    watcher->on_subscribe( this, &set );
 }
 
 void stats_tracker::add_watcher( const string_id<event_transformation> &id,
                                  event_multiset_watcher *watcher )
 {
-    event_transformation_watchers[id].insert( watcher );
-    watcher->on_subscribe( this );
+    watcher_set<event_multiset_watcher> &set = event_transformation_watchers[id];
+    set.insert( watcher );
+    watcher->on_subscribe( this, &set );
     std::unique_ptr<stats_tracker_state> &state = event_transformation_states[ id ];
     if( !state ) {
         state = id->watch( *this );
@@ -265,8 +267,9 @@ void stats_tracker::add_watcher( const string_id<event_transformation> &id,
 const cata_variant &stats_tracker::add_watcher(
     const string_id<event_statistic> &id, stat_watcher *watcher )
 {
-    stat_watchers[id].insert( watcher );
-    watcher->on_subscribe( this );
+    watcher_set<stat_watcher> &set = stat_watchers[id];
+    set.insert( watcher );
+    watcher->on_subscribe( this, &set );
     std::unique_ptr<stats_tracker_state> &state = stat_states[ id ];
     if( !state ) {
         state = id->watch( *this );
@@ -276,21 +279,11 @@ const cata_variant &stats_tracker::add_watcher(
 
 void stats_tracker::unwatch( base_watcher *watcher )
 {
-    // Use a slow O(n) approach for now; if it proves problematic we can build
-    // an index, but that seems over-complex.
-    auto erase_from = [watcher]( auto & map_of_watcher_sets ) {
-        for( auto &p : map_of_watcher_sets ) {
-            auto &set = p.second;
-            if( set.erase( watcher ) ) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    if( erase_from( event_type_watchers ) ||
-        erase_from( event_transformation_watchers ) ||
-        erase_from( stat_watchers ) ) {
+    // The watcher sets live in unordered_map nodes, which stay put until
+    // unwatch_all clears them, so the pointer recorded on subscription is
+    // still good here.
+    if( watcher->subscribed_set && watcher->subscribed_set->erase( watcher ) ) {
+        watcher->subscribed_set = nullptr;
         return;
     }
     debugmsg( "unwatch for a watcher not found" );
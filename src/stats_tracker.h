@@ -102,8 +102,12 @@ class event_multiset
     private:
         event_type type_; // NOLINT(cata-serialize)
         summaries_type summaries_;
+        // Sum of every summary's count, kept up to date so count() needn't scan.
+        int total_count_ = 0; // NOLINT(cata-serialize)
 };
 
+class base_watcher_set;
+
 class base_watcher
 {
     public:
@@ -114,9 +118,11 @@ class base_watcher
         virtual ~base_watcher();
     private:
         friend class stats_tracker;
-        void on_subscribe( stats_tracker * );
+        void on_subscribe( stats_tracker *, base_watcher_set * );
         void on_unsubscribe( stats_tracker * );
         stats_tracker *subscribed_to = nullptr;
+        // The set this watcher was added to, so unwatching needn't search for it
+        base_watcher_set *subscribed_set = nullptr;
 };
 
 class stat_watcher : public base_watcher
@@ -132,8 +138,18 @@ class event_multiset_watcher : public base_watcher
         virtual void events_reset( const event_multiset &, stats_tracker & ) = 0;
 };
 
+class base_watcher_set
+{
+    public:
+        bool erase( base_watcher *watcher ) {
+            return watchers_.erase( watcher );
+        }
+    protected:
+        std::set<base_watcher *> watchers_;
+};
+
 template<typename Watcher>
-class watcher_set
+class watcher_set : public base_watcher_set
 {
         static_assert( std::is_base_of_v<base_watcher, Watcher>,
                        "Watcher must be derived from base_watcher" );
@@ -142,10 +158,6 @@ class watcher_set
             watchers_.insert( watcher );
         }
 
-        bool erase( base_watcher *watcher ) {
-            return watchers_.erase( watcher );
-        }
-
         template<typename Class, typename... FnArgs, typename... Args>
         void send_to_all( void ( Class::*mem_fn )( FnArgs... ), Args &&... args ) const {
             static_assert( std::is_base_of<Class, Watcher>::value,
@@ -162,8 +174,6 @@ class watcher_set
                 current = next;
             }
         }
-    private:
-        std::set<base_watcher *> watchers_;
 };
 
 class stats_tracker_state
@@ -1,54 +1,100 @@
-#include <unordered_map>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include "string_id.h"
 
 namespace
 {
-using InternMapType = std::unordered_map<std::string, int>;
-using ReverseLookupVecType = std::vector<const std::string *>;
-} // namespace
-
-static InternMapType &get_intern_map()
+/**
+ * Pool of the interned strings. The strings live in a deque, so they never move and are
+ * allocated in blocks instead of one by one, and the index into it is the id.
+ * Lookups go through an open addressing table of ids, which costs a few bytes per string
+ * instead of a heap node holding a second copy of it.
+ */
+class intern_pool
 {
-    static InternMapType map{};
-    return map;
-}
+    public:
+        template<typename S>
+        int intern( S &&s ) {
+            const std::string_view key( s );
+            const size_t hash = std::hash<std::string_view>()( key );
+            const size_t slot = find_slot( key, hash );
+            if( slots[slot] != empty_slot ) {
+                return slots[slot];
+            }
+            const int id = static_cast<int>( strings.size() );
+            strings.emplace_back( std::forward<S>( s ) );
+            slots[slot] = id;
+            // Keep the table at most half full so probe sequences stay short.
+            if( strings.size() * 2 > slots.size() ) {
+                grow();
+            }
+            return id;
+        }
 
-static ReverseLookupVecType &get_reverse_lookup_vec()
-{
-    static ReverseLookupVecType vec{};
-    return vec;
-}
+        const std::string &get( int id ) const {
+            return strings[id];
+        }
+
+    private:
+        static constexpr int empty_slot = -1;
+
+        std::deque<std::string> strings;
+        std::vector<int> slots = std::vector<int>( 1024, empty_slot );
+
+        // The slot holding key, or the empty slot where it belongs.
+        size_t find_slot( std::string_view key, size_t hash ) const {
+            const size_t mask = slots.size() - 1;
+            for( size_t slot = hash & mask; ; slot = ( slot + 1 ) & mask ) {
+                const int id = slots[slot];
+                if( id == empty_slot || strings[id] == key ) {
+                    return slot;
+                }
+            }
+        }
+
+        void grow() {
+            slots.assign( slots.size() * 2, empty_slot );
+            const size_t mask = slots.size() - 1;
+            for( int id = 0; id < static_cast<int>( strings.size() ); ++id ) {
+                size_t slot = std::hash<std::string_view>()( strings[id] ) & mask;
+                while( slots[slot] != empty_slot ) {
+                    slot = ( slot + 1 ) & mask;
+                }
+                slots[slot] = id;
+            }
+        }
+};
+} // namespace
 
-template<typename S>
-static int universal_string_id_intern( S &&s )
+static intern_pool &get_intern_pool()
 {
-    int next_id = get_reverse_lookup_vec().size();
-    const auto &pair = get_intern_map().emplace( std::forward<S>( s ), next_id );
-    if( pair.second ) { // inserted
-        get_reverse_lookup_vec().push_back( &pair.first->first );
-    }
-    return pair.first->second;
+    static intern_pool pool{};
+    return pool;
 }
 
 int string_identity_static::string_id_intern( const std::string &s )
 {
-    return universal_string_id_intern( s );
+    return get_intern_pool().intern( s );
 }
 
 int string_identity_static::string_id_intern( std::string &s )
 {
-    return universal_string_id_intern( s );
+    return get_intern_pool().intern( s );
 }
 
 int string_identity_static::string_id_intern( std::string &&s )
 {
-    return universal_string_id_intern( std::move( s ) );
+    return get_intern_pool().intern( std::move( s ) );
 }
 
 const std::string &string_identity_static::get_interned_string( int id )
 {
-    return *get_reverse_lookup_vec()[id];
+    return get_intern_pool().get( id );
 }
 
 int string_identity_static::empty_interned_string()
@@ -92,6 +92,11 @@ void sub_body_part_type::load( const JsonObject &jo, std::string_view )
     optional( jo, was_loaded, "unarmed_damage", unarmed_damage );
 }
 
+const std::vector<sub_body_part_type> &sub_body_part_type::get_all()
+{
+    return sub_body_part_factory.get_all();
+}
+
 void sub_body_part_type::reset()
 {
     sub_body_part_factory.reset();
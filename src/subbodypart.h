@@ -80,6 +80,8 @@ struct sub_body_part_type {
 
     std::vector<sub_bodypart_str_id> get_all_combined_similar_sub_bodyparts() const;
 
+    static const std::vector<sub_body_part_type> &get_all();
+
     // Clears all bps
     static void reset();
     // Post-load finalization
@@ -9,6 +9,7 @@
 #include "basecamp.h"
 #include "debug.h"
 #include "mapdata.h"
+#include "memory_report.h"
 #include "tileray.h"
 #include "trap.h"
 #include "units.h"
@@ -29,11 +30,87 @@ void maptile_soa::swap_soa_tile( const point_sm_ms &p1, const point_sm_ms &p2 )
     std::swap( rad[p1.x()][p1.y()], rad[p2.x()][p2.y()] );
 }
 
+const cata::colony<item> &submap_snapshot::get_items( const point_sm_ms &p ) const
+{
+    static const cata::colony<item> noitems;
+    auto it = items.find( p );
+    return it == items.end() ? noitems : it->second;
+}
+
+submap_snapshot submap::snapshot() const
+{
+    submap_snapshot ret;
+    ret.tiles = m;
+    ret.uniform_ter = uniform_ter;
+    ret.version = tile_version;
+    if( m ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                if( !m->itm[x][y].empty() ) {
+                    ret.items.emplace( point_sm_ms( x, y ), m->itm[x][y] );
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+void submap::unshare_tiles()
+{
+    // Snapshots never read items or fields out of the shared arrays, so those are moved over
+    // rather than copied. That keeps every reference to the items on the map valid.
+    std::shared_ptr<maptile_soa> own = std::make_shared<maptile_soa>();
+    own->ter = m->ter;
+    own->frn = m->frn;
+    own->lum = m->lum;
+    own->trp = m->trp;
+    own->rad = m->rad;
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            own->itm[x][y] = std::move( m->itm[x][y] );
+            own->fld[x][y] = std::move( m->fld[x][y] );
+        }
+    }
+    m = std::move( own );
+}
+
+uint64_t submap::total_content_version = 0;
+
 submap::submap( submap && ) noexcept( map_is_noexcept ) = default;
 submap::~submap() = default;
 
 submap &submap::operator=( submap && ) noexcept = default;
 
+void submap::add_memory_usage( memory_report::report &out ) const
+{
+    size_t bytes = sizeof( submap ) + cosmetics.capacity() * sizeof( cosmetic_t ) +
+                   spawns.capacity() * sizeof( spawn_point ) +
+                   vehicles.capacity() * sizeof( std::unique_ptr<vehicle> );
+    for( const cosmetic_t &cosmetic : cosmetics ) {
+        bytes += memory_report::heap_bytes( cosmetic.type ) + memory_report::heap_bytes( cosmetic.str );
+    }
+    out.add( "submaps", 1, bytes );
+    for( const std::unique_ptr<vehicle> &veh : vehicles ) {
+        out.add( "vehicles", 1, sizeof( vehicle ) + veh->part_count() * sizeof( vehicle_part ) );
+        for( const vpart_reference &vp : veh->get_all_parts() ) {
+            for( const item &it : veh->get_items( vp.part() ) ) {
+                out.add_items( "vehicle_items", it );
+            }
+        }
+    }
+    if( is_uniform() ) {
+        return;
+    }
+    out.add( "submap_tiles", 1, sizeof( maptile_soa ) );
+    // Fields live in a small map per tile.
+    out.add( "fields", field_count, field_count * ( sizeof( field_entry ) + 4 * sizeof( void * ) ) );
+    for( const point_sm_ms &p : get_item_tiles() ) {
+        for( const item &it : m->itm[p.x()][p.y()] ) {
+            out.add_items( "map_items", it );
+        }
+    }
+}
+
 void submap::clear_fields( const point_sm_ms &p )
 {
     field &f = get_field( p );
@@ -161,6 +238,8 @@ const computer *submap::get_computer( const point_sm_ms &p ) const
 
 computer *submap::get_computer( const point_sm_ms &p )
 {
+    // The caller may write to it.
+    ++other_version;
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         return &it->second;
@@ -170,6 +249,7 @@ computer *submap::get_computer( const point_sm_ms &p )
 
 void submap::set_computer( const point_sm_ms &p, const computer &c )
 {
+    ++other_version;
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         it->second = c;
@@ -180,9 +260,29 @@ void submap::set_computer( const point_sm_ms &p, const computer &c )
 
 void submap::delete_computer( const point_sm_ms &p )
 {
+    ++other_version;
     computers.erase( p );
 }
 
+bool submap::changed_since_saved( bool count_last_touched ) const
+{
+    if( !saved || !vehicles.empty() || !active_items.empty() || camp ||
+        !partial_constructions.empty() || !computers.empty() ) {
+        return true;
+    }
+    return saved->tile_version != tile_version || saved->content_version != content_version ||
+           saved->other_version != other_version ||
+           ( count_last_touched && saved->last_touched != last_touched ) ||
+           saved->spawns != spawns.size() || saved->cosmetics != cosmetics.size() ||
+           saved->field_count != field_count;
+}
+
+void submap::mark_saved()
+{
+    saved = saved_state{ tile_version, content_version, other_version, last_touched, spawns.size(),
+                         cosmetics.size(), field_count };
+}
+
 bool submap::contains_vehicle( vehicle *veh )
 {
     const auto match = std::find_if(
@@ -200,9 +300,12 @@ bool submap::is_open_air( const point_sm_ms &p ) const
 
 void submap::rotate( int turns )
 {
+    bump_content_version();
+    forget_field_cells();
     if( is_uniform() ) {
         return;
     }
+    prepare_tile_write();
     turns = turns % 4;
 
     if( turns == 0 ) {
@@ -277,9 +380,12 @@ void submap::rotate( int turns )
 
 void submap::mirror( bool horizontally )
 {
+    bump_content_version();
+    forget_field_cells();
     if( is_uniform() ) {
         return;
     }
+    prepare_tile_write();
     std::map<point_sm_ms, computer> mirror_comp;
 
     if( horizontally ) {
@@ -321,8 +427,10 @@ void submap::mirror( bool horizontally )
 
 void submap::revert_submap( submap &sr )
 {
+    bump_content_version();
     reverted = true;
     if( sr.is_uniform() ) {
+        // Dropping the tile arrays is a tile write too, set_all_ter bumps the version for it.
         m.reset();
         set_all_ter( sr.get_ter( point_sm_ms::zero ), true );
         return;
@@ -354,7 +462,7 @@ submap submap::get_revert_submap() const
     submap ret;
     ret.uniform_ter = uniform_ter;
     if( !is_uniform() ) {
-        ret.m = std::make_unique<maptile_soa>( *m );
+        ret.m = std::make_shared<maptile_soa>( *m );
         ret.cosmetics = cosmetics;
     }
 
@@ -385,9 +493,83 @@ void submap::update_lum_rem( const point_sm_ms &p, const item &i )
     }
 }
 
+const std::vector<point_sm_ms> &submap::get_item_tiles() const
+{
+    if( item_tiles_version == content_version ) {
+        return item_tiles;
+    }
+    item_tiles.clear();
+    if( !is_uniform() ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                if( !m->itm[x][y].empty() ) {
+                    item_tiles.emplace_back( x, y );
+                }
+            }
+        }
+    }
+    item_tiles_version = content_version;
+    return item_tiles;
+}
+
+const std::vector<point_sm_ms> &submap::get_trap_tiles() const
+{
+    if( trap_tiles_version == content_version + trap_version ) {
+        return trap_tiles;
+    }
+    trap_tiles.clear();
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point_sm_ms p( x, y );
+            if( get_trap( p ) != tr_null || get_ter( p )->trap != tr_null ) {
+                trap_tiles.push_back( p );
+            }
+        }
+    }
+    trap_tiles_version = content_version + trap_version;
+    return trap_tiles;
+}
+
+const std::vector<std::pair<point_sm_ms, int>> &submap::get_heat_tiles() const
+{
+    if( heat_tiles_version == content_version && heat_tiles_turn == calendar::turn ) {
+        return heat_tiles;
+    }
+    heat_tiles.clear();
+    if( is_uniform() ) {
+        // No fields, and the same terrain everywhere.
+        const int radiation = uniform_ter->heat_radiation;
+        if( radiation != 0 ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                for( int x = 0; x < SEEX; x++ ) {
+                    heat_tiles.emplace_back( point_sm_ms( x, y ), radiation );
+                }
+            }
+        }
+    } else {
+        const field_type_id fire = fd_fire.id();
+        for( int y = 0; y < SEEY; y++ ) {
+            for( int x = 0; x < SEEX; x++ ) {
+                const field_entry *fire_here = m->fld[x][y].find_field( fire );
+                const int intensity = fire_here != nullptr ? fire_here->get_field_intensity() : 0;
+                const int heat = intensity > 0 ? intensity : m->ter[x][y]->heat_radiation;
+                if( heat != 0 ) {
+                    heat_tiles.emplace_back( point_sm_ms( x, y ), heat );
+                }
+            }
+        }
+    }
+    heat_tiles_version = content_version;
+    heat_tiles_turn = calendar::turn;
+    return heat_tiles;
+}
+
 void submap::merge_submaps( submap *copy_from, bool copy_from_is_overlay )
 {
+    bump_content_version();
+    prepare_tile_write();
     this->field_count = 0;
+    forget_field_cells();
 
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
@@ -510,9 +692,11 @@ ter_id submap::get_original_ter( const point_sm_ms &p ) const
 void submap::set_original_ter( const point_sm_ms &p, const ter_id &t )
 {
     original_terrain[p] = t;
+    ++other_version;
 }
 
 void submap::clear_original_ter( const point_sm_ms &p )
 {
     original_terrain.erase( p );
+    ++other_version;
 }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
@@ -39,6 +40,10 @@
 class JsonOut;
 class JsonValue;
 class map;
+namespace memory_report
+{
+class report;
+} // namespace memory_report
 
 struct spawn_point {
     point_sm_ms pos;
@@ -71,6 +76,52 @@ struct maptile_soa {
     void swap_soa_tile( const point_sm_ms &p1, const point_sm_ms &p2 );
 };
 
+/**
+ * An immutable view of a submap's tiles as they were when it was taken, which other threads
+ * can read while the main thread keeps changing the submap. Terrain, furniture, traps,
+ * radiation and light are shared with the submap until it next writes to them. Item stacks
+ * are copied when the snapshot is taken, because items on the map have to keep their
+ * identity. Fields aren't included. Take snapshots on the main thread; reading and
+ * dropping them is fine anywhere.
+ */
+class submap_snapshot
+{
+    public:
+        ter_id get_ter( const point_sm_ms &p ) const {
+            return tiles ? tiles->ter[p.x()][p.y()] : uniform_ter;
+        }
+        furn_id get_furn( const point_sm_ms &p ) const {
+            return tiles ? tiles->frn[p.x()][p.y()] : furn_str_id::NULL_ID();
+        }
+        trap_id get_trap( const point_sm_ms &p ) const {
+            return tiles ? tiles->trp[p.x()][p.y()] : tr_null;
+        }
+        int get_radiation( const point_sm_ms &p ) const {
+            return tiles ? tiles->rad[p.x()][p.y()] : 0;
+        }
+        uint8_t get_lum( const point_sm_ms &p ) const {
+            return tiles ? tiles->lum[p.x()][p.y()] : 0;
+        }
+        const cata::colony<item> &get_items( const point_sm_ms &p ) const;
+
+        bool is_uniform() const {
+            return !tiles;
+        }
+        /** The submap's tile version when this was taken, see submap::get_tile_version. */
+        uint64_t get_version() const {
+            return version;
+        }
+
+    private:
+        friend class submap;
+
+        std::shared_ptr<const maptile_soa> tiles;
+        // Non-empty stacks only.
+        std::map<point_sm_ms, cata::colony<item>> items;
+        ter_id uniform_ter = t_null;
+        uint64_t version = 0;
+};
+
 class submap
 {
     public:
@@ -82,13 +133,14 @@ class submap
 
         void ensure_nonuniform() {
             if( is_uniform() ) {
-                m = std::make_unique<maptile_soa>();
+                m = std::make_shared<maptile_soa>();
                 std::uninitialized_fill_n( &m->ter[0][0], elements, uniform_ter );
                 std::uninitialized_fill_n( &m->frn[0][0], elements, furn_str_id::NULL_ID() );
                 std::uninitialized_fill_n( &m->lum[0][0], elements, 0 );
                 std::uninitialized_fill_n( &m->trp[0][0], elements, tr_null );
                 std::uninitialized_fill_n( &m->rad[0][0], elements, 0 );
             }
+            prepare_tile_write();
         }
 
         void revert_submap( submap &sr );
@@ -105,11 +157,13 @@ class submap
         void set_trap( const point_sm_ms &p, trap_id trap ) {
             ensure_nonuniform();
             m->trp[p.x()][p.y()] = trap;
+            ++trap_version;
         }
 
         void set_all_traps( const trap_id &trap ) {
             ensure_nonuniform();
             std::uninitialized_fill_n( &m->trp[0][0], elements, trap );
+            ++trap_version;
         }
 
         furn_id get_furn( const point_sm_ms &p ) const {
@@ -138,6 +192,7 @@ class submap
 
         void set_map_damage( const point_sm_ms &p, int dmg ) {
             ephemeral_data[p] = { dmg };
+            ++other_version;
         }
 
         ter_id get_ter( const point_sm_ms &p ) const {
@@ -150,17 +205,22 @@ class submap
         void set_ter( const point_sm_ms &p, ter_id terr ) {
             ensure_nonuniform();
             m->ter[p.x()][p.y()] = terr;
+            ++trap_version;
         }
 
         void set_all_ter( const ter_id &terr, bool uniform_ok = false ) {
+            ++trap_version;
             if( !uniform_ok ) {
                 ensure_nonuniform();
             }
             if( is_uniform() ) {
+                ++tile_version;
                 uniform_ter = terr;
             } else {
+                prepare_tile_write();
                 std::uninitialized_fill_n( &m->ter[0][0], elements, terr );
             }
+            bump_content_version();
         }
 
         int get_radiation( const point_sm_ms &p ) const {
@@ -196,12 +256,34 @@ class submap
 
         void update_lum_rem( const point_sm_ms &p, const item &i );
 
+        /**
+         * Tiles here holding at least one item, x-major. Built on demand and kept until the
+         * content version moves.
+         */
+        const std::vector<point_sm_ms> &get_item_tiles() const;
+        /**
+         * Tiles here with a trap, set on the tile or built into its terrain, x-major. Built on
+         * demand and kept until a trap or the terrain changes.
+         */
+        const std::vector<point_sm_ms> &get_trap_tiles() const;
+        /**
+         * Tiles here giving off heat and how much, the intensity of a fire or else the heat
+         * radiation of the terrain, y-major. Built on demand and kept for the rest of the turn
+         * while the content version stays put.
+         */
+        const std::vector<std::pair<point_sm_ms, int>> &get_heat_tiles() const;
+        /** For fires changing here, which the content version doesn't count. */
+        void invalidate_heat_tiles() const {
+            heat_tiles_turn = calendar::before_time_starts;
+        }
+
         // TODO: Replace this as it essentially makes itm public
         cata::colony<item> &get_items( const point_sm_ms &p ) {
             if( is_uniform() ) {
                 cata::colony<item> static noitems;
                 return noitems;
             }
+            prepare_tile_write();
             return m->itm[p.x()][p.y()];
         }
 
@@ -219,6 +301,7 @@ class submap
                 field static nofield;
                 return nofield;
             }
+            prepare_tile_write();
             return m->fld[p.x()][p.y()];
         }
 
@@ -246,6 +329,7 @@ class submap
             ins.str = str;
 
             cosmetics.push_back( ins );
+            ++other_version;
         }
 
         units::temperature_delta get_temperature_mod() const {
@@ -254,6 +338,7 @@ class submap
 
         void set_temperature_mod( units::temperature_delta new_temperature_mod ) {
             temperature_mod = units::to_fahrenheit_delta( new_temperature_mod );
+            ++other_version;
         }
 
         bool has_graffiti( const point_sm_ms &p ) const;
@@ -294,6 +379,51 @@ class submap
             return !static_cast<bool>( m );
         }
 
+        /** Takes a snapshot of the tiles as they are now, see submap_snapshot. */
+        submap_snapshot snapshot() const;
+
+        /**
+         * Goes up whenever the tiles may have been written to, so a reader can tell whether a
+         * snapshot is still current. Handing out mutable items or fields counts as a write.
+         */
+        uint64_t get_tile_version() const {
+            return tile_version;
+        }
+
+        /**
+         * Goes up whenever map code adds or removes items here, or sets terrain, furniture, traps
+         * or partial constructions. Unlike get_tile_version, reading never counts, but neither
+         * do edits made to an item in place.
+         */
+        uint64_t get_content_version() const {
+            return content_version;
+        }
+        void bump_content_version() {
+            ++content_version;
+            ++total_content_version;
+        }
+        /** Goes up with the content version of any submap. */
+        static uint64_t get_total_content_version() {
+            return total_content_version;
+        }
+
+        /**
+         * Whether anything that gets saved may have changed since the last call to mark_saved,
+         * so mapbuffer::save can leave the quad on disk alone. Errs toward yes: anything with
+         * vehicles, active items, a camp, partial constructions or computers, which all change
+         * without going through the submap, always counts as changed, and so does a submap that
+         * was never saved or loaded.
+         * @p count_last_touched is false while the submap stays loaded: the map stamps every
+         * submap it saves, and the stamp only needs to reach the disk when the submap leaves.
+         */
+        bool changed_since_saved( bool count_last_touched = true ) const;
+        /** Called once the submap is written or read back. */
+        void mark_saved();
+        /** For writes made past the submap, like items edited through an item_location. */
+        void note_unsaved_change() {
+            ++other_version;
+        }
+
         // Merge the contents of the two submaps onto the target submap. If there is a
         // conflict the overlay wins out. Note that it's technically possible for both
         // submaps to actually be overlays, but the one that's not called out is treated
@@ -303,11 +433,26 @@ class submap
         // Z levels.
         void merge_submaps( submap *copy_from, bool copy_from_is_overlay );
 
+        /** Adds this submap, its items and its vehicles to @p out. */
+        void add_memory_usage( memory_report::report &out ) const;
+
         std::vector<cosmetic_t> cosmetics; // Textual "visuals" for squares
 
         active_item_cache active_items;
 
         int field_count = 0;
+        // Tiles that may hold fields, indexed x * SEEY + y, so field processing can skip the
+        // rest of the submap. Only trusted while field_cells_known is set: map::add_field marks
+        // the tiles it fills, anything else that moves fields around calls forget_field_cells()
+        // and the next pass over the submap rescans it.
+        std::bitset<SEEX * SEEY> field_cells; // NOLINT(cata-serialize)
+        bool field_cells_known = false; // NOLINT(cata-serialize)
+        void note_field_cell( const point_sm_ms &p ) {
+            field_cells.set( static_cast<size_t>( p.x() * SEEY + p.y() ) );
+        }
+        void forget_field_cells() {
+            field_cells_known = false;
+        }
         time_point last_touched = calendar::turn_zero;
         bool reverted = false; // NOLINT(cata-serialize)
         // This tracks that a submap was edited outside of mapgen, and that it should be
@@ -328,9 +473,51 @@ class submap
         };
 
     private:
+        // Must be called before writing to the tile arrays.
+        void prepare_tile_write() {
+            ++tile_version;
+            if( m.use_count() > 1 ) {
+                unshare_tiles();
+            }
+        }
+        void unshare_tiles();
+
         std::map<point_sm_ms, tile_data> ephemeral_data;
         std::map<point_sm_ms, computer> computers;
-        std::unique_ptr<maptile_soa> m;
+        // Shared with any snapshots still looking at it.
+        std::shared_ptr<maptile_soa> m;
+        uint64_t tile_version = 0;
+        // Goes up with saved data kept outside the tile arrays: map damage, cosmetics, computers,
+        // original terrain and the temperature.
+        uint64_t other_version = 0; // NOLINT(cata-serialize)
+        struct saved_state {
+            uint64_t tile_version = 0;
+            uint64_t content_version = 0;
+            uint64_t other_version = 0;
+            time_point last_touched = calendar::turn_zero;
+            size_t spawns = 0;
+            size_t cosmetics = 0;
+            int field_count = 0;
+        };
+        // What the submap looked like when last written or read, nothing if it never was.
+        std::optional<saved_state> saved; // NOLINT(cata-serialize)
+        // Starts past every version handed out so far, so a submap loaded again in place of an
+        // unloaded one never looks unchanged.
+        uint64_t content_version = ++total_content_version;
+        static uint64_t total_content_version;
+        // Cache for get_item_tiles, valid while item_tiles_version == content_version
+        mutable std::vector<point_sm_ms> item_tiles; // NOLINT(cata-serialize)
+        mutable uint64_t item_tiles_version = 0; // NOLINT(cata-serialize)
+        // Goes up with every trap or terrain set.
+        uint64_t trap_version = 0; // NOLINT(cata-serialize)
+        // Cache for get_trap_tiles, valid while trap_tiles_version == content_version + trap_version,
+        // the content version counting rotations and merges.
+        mutable std::vector<point_sm_ms> trap_tiles; // NOLINT(cata-serialize)
+        mutable uint64_t trap_tiles_version = 0; // NOLINT(cata-serialize)
+        // Cache for get_heat_tiles, valid during heat_tiles_turn while heat_tiles_version == content_version
+        mutable std::vector<std::pair<point_sm_ms, int>> heat_tiles; // NOLINT(cata-serialize)
+        mutable uint64_t heat_tiles_version = 0; // NOLINT(cata-serialize)
+        mutable time_point heat_tiles_turn = calendar::before_time_starts; // NOLINT(cata-serialize)
         ter_id uniform_ter = t_null;
         int temperature_mod = 0; // delta in F
         // Tracks original terrain for tiles transformed by phase logic
@@ -933,10 +933,8 @@ void surroundings_menu::draw_item_tab()
                         ImGui::TableHeadersRow();
                         ImGui::TableNextColumn();
                         // embedded info for selected item
-                        std::vector<iteminfo> selected_info;
                         std::vector<iteminfo> dummy_info;
-                        selected_it->info( true, selected_info );
-                        item_info_data dummy( "", "", selected_info, dummy_info );
+                        item_info_data dummy( "", "", get_item_info( *selected_it ), dummy_info );
                         dummy.without_getch = true;
                         dummy.without_border = true;
                         cataimgui::set_scroll( info_scroll );
@@ -1163,6 +1161,17 @@ void surroundings_menu::draw_terfurn_tab()
     }
 }
 
+const std::vector<iteminfo> &surroundings_menu::get_item_info( const item &it )
+{
+    if( info_item != &it || info_turn != calendar::turn ) {
+        info_cache.clear();
+        it.info( true, info_cache );
+        info_item = &it;
+        info_turn = calendar::turn;
+    }
+    return info_cache;
+}
+
 void surroundings_menu::draw_examine_info()
 {
     switch( selected_tab ) {
@@ -1170,12 +1179,10 @@ void surroundings_menu::draw_examine_info()
             if( !item_data.selected_entry ) {
                 break;
             }
-            std::vector<iteminfo> selected_info;
             std::vector<iteminfo> dummy_info;
             const item *selected_item = item_data.selected_entry->get_selected_entity();
-            selected_item->info( true, selected_info );
-            item_info_data dummy( selected_item->tname(), selected_item->type_name(), selected_info,
-                                  dummy_info );
+            item_info_data dummy( selected_item->tname(), selected_item->type_name(),
+                                  get_item_info( *selected_item ), dummy_info );
             dummy.handle_scrolling = true;
             dummy.arrow_scrolling = true;
             iteminfo_window info( dummy, point::zero, width - 5, TERMY );
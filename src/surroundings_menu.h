@@ -10,6 +10,7 @@
 #include <vector>
 #include <stddef.h>
 
+#include "calendar.h"
 #include "cata_imgui.h"
 #include "color.h"
 #include "coordinates.h"
@@ -23,6 +24,7 @@ class Character;
 class Creature;
 class item;
 class map;
+struct iteminfo;
 struct map_data_common_t;
 
 class tab_data
@@ -183,6 +185,7 @@ class surroundings_menu : public cataimgui::window
         void draw_monster_tab();
         void draw_terfurn_tab();
         void draw_examine_info();
+        const std::vector<iteminfo> &get_item_info( const item &it );
         void draw_category_separator( const std::string &category, std::string &last_category,
                                       int target_col );
         std::vector<std::unordered_set<std::string>> get_shown_hotkeys( const tab_data *tab );
@@ -228,6 +231,11 @@ class surroundings_menu : public cataimgui::window
         const int min_width;
 
         cataimgui::scroll info_scroll = cataimgui::scroll::none;
+        // info() of the item in the info pane, which is drawn every frame; rebuilt when the
+        // selection changes or a turn passes
+        const item *info_item = nullptr;
+        time_point info_turn;
+        std::vector<iteminfo> info_cache;
 
         int width;
         int info_height;
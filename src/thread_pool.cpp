@@ -0,0 +1,184 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <utility>
+
+namespace cata
+{
+
+thread_pool::thread_pool( unsigned int num_workers )
+{
+    workers.reserve( num_workers );
+    for( unsigned int i = 0; i < num_workers; ++i ) {
+        workers.emplace_back( [this]() {
+            worker_loop();
+        } );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock( jobs_mutex );
+        stopping = true;
+    }
+    jobs_cv.notify_all();
+    for( std::thread &worker : workers ) {
+        if( worker.joinable() ) {
+            worker.join();
+        }
+    }
+}
+
+void thread_pool::worker_loop()
+{
+    std::unique_lock<std::mutex> lock( jobs_mutex );
+    while( true ) {
+        jobs_cv.wait( lock, [this]() {
+            return stopping || !jobs.empty();
+        } );
+        if( jobs.empty() ) {
+            // stopping and nothing left to do
+            return;
+        }
+        std::function<void()> job = std::move( jobs.front() );
+        jobs.pop_front();
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}
+
+void thread_pool::parallel_for( int begin, int end, const std::function<void( int )> &fn )
+{
+    if( end <= begin ) {
+        return;
+    }
+    const int helpers = std::min( static_cast<int>( workers.size() ), end - begin - 1 );
+    if( helpers <= 0 ) {
+        for( int i = begin; i < end; ++i ) {
+            fn( i );
+        }
+        return;
+    }
+
+    // Everything here lives on our stack, we don't return before all helpers are done.
+    std::atomic<int> next( begin );
+    int pending = helpers;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const auto run_chunks = [&]() {
+        for( int i = next++; i < end; i = next++ ) {
+            try {
+                fn( i );
+            } catch( ... ) {
+                std::lock_guard<std::mutex> lock( error_mutex );
+                if( !error ) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock( jobs_mutex );
+        for( int i = 0; i < helpers; ++i ) {
+            jobs.emplace_back( [&]() {
+                run_chunks();
+                std::lock_guard<std::mutex> lock( jobs_mutex );
+                --pending;
+                jobs_cv.notify_all();
+            } );
+        }
+    }
+    jobs_cv.notify_all();
+
+    run_chunks();
+
+    std::unique_lock<std::mutex> lock( jobs_mutex );
+    help_until( lock, [&pending]() {
+        return pending == 0;
+    } );
+    lock.unlock();
+
+    if( error ) {
+        std::rethrow_exception( error );
+    }
+}
+
+void thread_pool::run_alongside( const std::function<void()> &background,
+                                 const std::function<void()> &foreground )
+{
+    if( workers.empty() ) {
+        foreground();
+        background();
+        return;
+    }
+
+    bool background_done = false;
+    std::exception_ptr background_error;
+    {
+        std::lock_guard<std::mutex> lock( jobs_mutex );
+        jobs.emplace_back( [&]() {
+            try {
+                background();
+            } catch( ... ) {
+                background_error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock( jobs_mutex );
+            background_done = true;
+            jobs_cv.notify_all();
+        } );
+    }
+    jobs_cv.notify_one();
+
+    std::exception_ptr foreground_error;
+    try {
+        foreground();
+    } catch( ... ) {
+        foreground_error = std::current_exception();
+    }
+
+    // The background job refers to our stack, so wait for it even if the foreground failed.
+    std::unique_lock<std::mutex> lock( jobs_mutex );
+    help_until( lock, [&background_done]() {
+        return background_done;
+    } );
+    lock.unlock();
+
+    if( foreground_error ) {
+        std::rethrow_exception( foreground_error );
+    }
+    if( background_error ) {
+        std::rethrow_exception( background_error );
+    }
+}
+
+void thread_pool::help_until( std::unique_lock<std::mutex> &lock,
+                              const std::function<bool()> &done )
+{
+    // Help with queued jobs while waiting, so that nested calls from a worker can't starve.
+    while( !done() ) {
+        if( !jobs.empty() ) {
+            std::function<void()> job = std::move( jobs.front() );
+            jobs.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+            continue;
+        }
+        jobs_cv.wait( lock );
+    }
+}
+
+thread_pool &get_thread_pool()
+{
+    // The calling thread does its share of the work, so it counts as one of the hardware threads.
+    static thread_pool pool( std::max( std::thread::hardware_concurrency(), 1U ) - 1 );
+    return pool;
+}
+
+} // namespace cata
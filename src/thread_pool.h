@@ -0,0 +1,71 @@
+#pragma once
+#ifndef CATA_SRC_THREAD_POOL_H
+#define CATA_SRC_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cata
+{
+
+/**
+ * A small shared job system for splitting independent chunks of work across
+ * worker threads.
+ *
+ * Jobs run on worker threads must not touch the UI (that includes debugmsg),
+ * the RNG, or any game state that another job may be writing at the same time.
+ * The calling thread always takes part in the work, so a pool without workers
+ * simply runs everything inline.
+ */
+class thread_pool
+{
+    public:
+        explicit thread_pool( unsigned int num_workers );
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+        ~thread_pool();
+
+        /** Number of worker threads, not counting the calling thread. */
+        unsigned int num_workers() const {
+            return static_cast<unsigned int>( workers.size() );
+        }
+
+        /**
+         * Call @p fn for every index in [begin, end) and return once all calls
+         * have finished. If any call throws, the first exception is rethrown
+         * on the calling thread after the remaining indices are done.
+         */
+        void parallel_for( int begin, int end, const std::function<void( int )> &fn );
+
+        /**
+         * Run @p background on any thread while the calling thread runs @p foreground, and
+         * return once both are done. Only @p foreground is guaranteed to stay on the calling
+         * thread, so it is the one that may touch the UI. Exceptions are rethrown like in
+         * parallel_for, the one from @p foreground first.
+         */
+        void run_alongside( const std::function<void()> &background,
+                            const std::function<void()> &foreground );
+
+    private:
+        void worker_loop();
+        /** Run queued jobs on the calling thread until @p done holds, jobs_mutex must be held. */
+        void help_until( std::unique_lock<std::mutex> &lock, const std::function<bool()> &done );
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> jobs;
+        std::mutex jobs_mutex;
+        std::condition_variable jobs_cv;
+        bool stopping = false;
+};
+
+/** The pool shared by all engine subsystems, created on first use. */
+thread_pool &get_thread_pool();
+
+} // namespace cata
+
+#endif // CATA_SRC_THREAD_POOL_H
@@ -369,6 +369,10 @@ void timed_event::per_turn()
             break;
 
         case timed_event_type::AMIGARA_WHISPERS: {
+            // Only look for faults on the turns a whisper could actually be heard.
+            if( !calendar::once_every( time_duration::from_seconds( 10 ) ) ) {
+                break;
+            }
             bool faults = false;
             for( const tripoint_bub_ms &p : here.points_on_zlevel() ) {
                 if( here.ter( p ) == ter_t_fault ) {
@@ -377,7 +381,7 @@ void timed_event::per_turn()
                 }
             }
 
-            if( calendar::once_every( time_duration::from_seconds( 10 ) ) && faults ) {
+            if( faults ) {
                 add_msg( m_info, _( "You hear someone whispering \"%s\"" ),
                          SNIPPET.random_from_category( "amigara_whispers" ).value_or( translation() ) );
             }
@@ -302,6 +302,26 @@ const std::string &translation::translated( const int num ) const
     // in the places where they are changed, cache is explicitly invalidated
     // Note2: if `raw_pl` is defined, `num` becomes part of the "cache key"
     // otherwise `num` is ignored (for both translation and cache)
+#if defined(LOCALIZE) && !defined(CATA_IN_TOOL)
+    // The string is looked up once per language, a new `num` only picks another plural form
+    // of the same entry, and untranslated strings are returned as they are.
+    const TranslationManager &manager = TranslationManager::GetInstance();
+    if( cached_language_version != detail::get_current_language_version() ) {
+        cached_language_version = detail::get_current_language_version();
+        cached_index = manager.FindString( ctxt ? ctxt->c_str() : nullptr, raw.c_str() );
+        cached_translation = nullptr;
+    }
+    if( cached_index < 0 ) {
+        return raw_pl && num != 1 ? *raw_pl : raw;
+    }
+    if( !cached_translation || ( raw_pl && cached_num != num ) ) {
+        cached_num = num;
+        cached_translation = cata::make_value<std::string>( raw_pl ?
+                             manager.GetTranslatedStringPlural( cached_index, num ) :
+                             manager.GetTranslatedString( cached_index ) );
+    }
+    return *cached_translation;
+#else
     if( cached_language_version != detail::get_current_language_version() ||
         ( raw_pl && cached_num != num ) || !cached_translation ) {
         cached_language_version = detail::get_current_language_version();
@@ -324,6 +344,7 @@ const std::string &translation::translated( const int num ) const
         }
     }
     return *cached_translation;
+#endif
 }
 
 bool translation::empty() const
@@ -151,6 +151,8 @@ class translation
         mutable int cached_language_version = INVALID_LANGUAGE_VERSION;
         // `num`, which `cached_translation` corresponds to
         mutable int cached_num = 0;
+        // where the translation of `ctxt` and `raw` is in the loaded table, -1 if it has none
+        mutable int cached_index = -1;
         mutable cata::value_ptr<std::string> cached_translation;
 };
 
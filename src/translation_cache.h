@@ -41,6 +41,8 @@ inline std::string _translate_internal( const std::string &msg )
 
 // returns current language generation/version
 int get_current_language_version();
+// moves the version on, so every cached translation is looked up again
+void invalidate_language_version();
 
 template<typename T>
 class local_translation_cache;
@@ -57,4 +57,19 @@ const char *TranslationManager::TranslatePluralWithContext( const char *context,
     return impl->TranslatePluralWithContext( context, singular, plural, n );
 }
 
+int TranslationManager::FindString( const char *context, const char *message ) const
+{
+    return impl->FindString( context, message );
+}
+
+const char *TranslationManager::GetTranslatedString( int index ) const
+{
+    return impl->GetTranslatedString( index );
+}
+
+const char *TranslationManager::GetTranslatedStringPlural( int index, std::size_t n ) const
+{
+    return impl->GetTranslatedStringPlural( index, n );
+}
+
 #endif // defined(LOCALIZE)
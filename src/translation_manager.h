@@ -31,6 +31,16 @@ class TranslationManager
         const char *TranslateWithContext( const char *context, const char *message ) const;
         const char *TranslatePluralWithContext( const char *context, const char *singular,
                                                 const char *plural, std::size_t n ) const;
+
+        /**
+         * Index of the translation of @p message, in @p context unless that is null, or -1 if
+         * there is none. It stays valid until other documents are loaded, which also moves
+         * the language version on, so callers keep it next to the version they looked it up in.
+         */
+        int FindString( const char *context, const char *message ) const;
+        /** The translation at @p index, from @ref FindString. */
+        const char *GetTranslatedString( int index ) const;
+        const char *GetTranslatedStringPlural( int index, std::size_t n ) const;
 };
 
 #endif // defined(LOCALIZE)
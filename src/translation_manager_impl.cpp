@@ -18,25 +18,61 @@ std::uint32_t TranslationManager::Impl::Hash( const char *str )
     return hash;
 }
 
-std::optional<std::pair<std::size_t, std::size_t>> TranslationManager::Impl::LookupString(
-            const char *query ) const
-{
-    if( strings.empty() ) {
-        return std::nullopt;
-    }
-    std::uint32_t hash = Hash( query );
-    auto it = strings.find( hash );
-    if( it == strings.end() ) {
-        return std::nullopt;
-    }
-    for( const std::pair<size_t, size_t> &entry : it->second ) {
-        const std::size_t document = entry.first;
-        const std::size_t index = entry.second;
-        if( strcmp( documents[document].GetOriginalString( index ), query ) == 0 ) {
-            return std::optional<std::pair<std::size_t, std::size_t>> { entry };
+int TranslationManager::Impl::LookupString( const char *query ) const
+{
+    if( buckets.empty() || query[0] == '\0' ) {
+        return -1;
+    }
+    const std::uint32_t hash = Hash( query );
+    const std::size_t mask = buckets.size() - 1;
+    for( std::size_t pos = hash & mask; buckets[pos] >= 0; pos = ( pos + 1 ) & mask ) {
+        const string_entry &entry = strings[buckets[pos]];
+        if( entry.hash == hash &&
+            strcmp( documents[entry.document].GetOriginalString( entry.index ), query ) == 0 ) {
+            return buckets[pos];
+        }
+    }
+    return -1;
+}
+
+void TranslationManager::Impl::BuildIndex()
+{
+    std::size_t total = 0;
+    for( const TranslationDocument &document : documents ) {
+        total += document.Count();
+    }
+    std::size_t size = 2;
+    while( size < total * 2 ) {
+        size *= 2;
+    }
+    buckets.assign( size, -1 );
+    strings.reserve( total );
+    const std::size_t mask = size - 1;
+    for( std::size_t document = 0; document < documents.size(); document++ ) {
+        for( std::size_t i = 0; i < documents[document].Count(); i++ ) {
+            const char *message = documents[document].GetOriginalString( i );
+            if( message[0] == '\0' ) {
+                continue;
+            }
+            const std::uint32_t hash = Hash( message );
+            std::size_t pos = hash & mask;
+            // An earlier document translating the same string wins.
+            bool duplicate = false;
+            for( ; buckets[pos] >= 0; pos = ( pos + 1 ) & mask ) {
+                const string_entry &entry = strings[buckets[pos]];
+                if( entry.hash == hash &&
+                    strcmp( documents[entry.document].GetOriginalString( entry.index ), message ) == 0 ) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if( !duplicate ) {
+                buckets[pos] = static_cast<std::int32_t>( strings.size() );
+                strings.push_back( { hash, static_cast<std::uint32_t>( document ),
+                                     static_cast<std::uint32_t>( i ) } );
+            }
         }
     }
-    return std::nullopt;
 }
 
 std::string TranslationManager::Impl::LanguageCodeOfPath( std::string_view path )
@@ -86,7 +122,9 @@ void TranslationManager::Impl::Reset()
 {
     documents.clear();
     strings.clear();
-    strings.max_load_factor( 1.0f );
+    buckets.clear();
+    // Indices handed out by FindString are no longer valid.
+    detail::invalidate_language_version();
 }
 
 TranslationManager::Impl::Impl()
@@ -145,18 +183,7 @@ void TranslationManager::Impl::LoadDocuments( const std::vector<std::string> &fi
             DebugLog( D_ERROR, DC_ALL ) << e.what();
         }
     }
-    for( std::size_t document = 0; document < documents.size(); document++ ) {
-        for( std::size_t i = 0; i < documents[document].Count(); i++ ) {
-            const char *message = documents[document].GetOriginalString( i );
-            if( message[0] != '\0' ) {
-                const std::uint32_t hash = Hash( message );
-                if( strings.count( hash ) == 0 ) {
-                    strings[hash] = std::vector<std::pair<std::size_t, std::size_t>>( 1 );
-                }
-                strings[hash].emplace_back( document, i );
-            }
-        }
-    }
+    BuildIndex();
 }
 
 const char *TranslationManager::Impl::Translate( const std::string &message ) const
@@ -166,23 +193,16 @@ const char *TranslationManager::Impl::Translate( const std::string &message ) co
 
 const char *TranslationManager::Impl::Translate( const char *message ) const
 {
-    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( message );
-    if( entry ) {
-        const std::size_t document = entry->first;
-        const std::size_t string_index = entry->second;
-        return documents[document].GetTranslatedString( string_index );
-    }
-    return message;
+    const int index = LookupString( message );
+    return index >= 0 ? GetTranslatedString( index ) : message;
 }
 
 const char *TranslationManager::Impl::TranslatePlural( const char *singular, const char *plural,
         std::size_t n ) const
 {
-    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( singular );
-    if( entry ) {
-        const std::size_t document = entry->first;
-        const std::size_t string_index = entry->second;
-        return documents[document].GetTranslatedStringPlural( string_index, n );
+    const int index = LookupString( singular );
+    if( index >= 0 ) {
+        return GetTranslatedStringPlural( index, n );
     }
     if( n == 1 ) {
         return singular;
@@ -205,14 +225,8 @@ std::string TranslationManager::Impl::ConstructContextualQuery( const char *cont
 const char *TranslationManager::Impl::TranslateWithContext( const char *context,
         const char *message ) const
 {
-    std::string query = ConstructContextualQuery( context, message );
-    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( query.c_str() );
-    if( entry ) {
-        const std::size_t document = entry->first;
-        const std::size_t string_index = entry->second;
-        return documents[document].GetTranslatedString( string_index );
-    }
-    return message;
+    const int index = FindString( context, message );
+    return index >= 0 ? GetTranslatedString( index ) : message;
 }
 
 const char *TranslationManager::Impl::TranslatePluralWithContext( const char *context,
@@ -220,12 +234,9 @@ const char *TranslationManager::Impl::TranslatePluralWithContext( const char *co
         const char *plural,
         std::size_t n ) const
 {
-    std::string query = ConstructContextualQuery( context, singular );
-    std::optional<std::pair<std::size_t, std::size_t>> entry = LookupString( query.c_str() );
-    if( entry ) {
-        const std::size_t document = entry->first;
-        const std::size_t string_index = entry->second;
-        return documents[document].GetTranslatedStringPlural( string_index, n );
+    const int index = FindString( context, singular );
+    if( index >= 0 ) {
+        return GetTranslatedStringPlural( index, n );
     }
     if( n == 1 ) {
         return singular;
@@ -234,4 +245,24 @@ const char *TranslationManager::Impl::TranslatePluralWithContext( const char *co
     }
 }
 
+int TranslationManager::Impl::FindString( const char *context, const char *message ) const
+{
+    if( context == nullptr ) {
+        return LookupString( message );
+    }
+    return LookupString( ConstructContextualQuery( context, message ).c_str() );
+}
+
+const char *TranslationManager::Impl::GetTranslatedString( int index ) const
+{
+    const string_entry &entry = strings[index];
+    return documents[entry.document].GetTranslatedString( entry.index );
+}
+
+const char *TranslationManager::Impl::GetTranslatedStringPlural( int index, std::size_t n ) const
+{
+    const string_entry &entry = strings[index];
+    return documents[entry.document].GetTranslatedStringPlural( entry.index, n );
+}
+
 #endif // defined(LOCALIZE)
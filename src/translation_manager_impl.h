@@ -4,7 +4,7 @@
 
 #if defined(LOCALIZE)
 
-#include <optional>
+#include <cstdint>
 #include <unordered_map>
 
 #include "translation_document.h"
@@ -15,9 +15,18 @@ class TranslationManager::Impl
     private:
         std::vector<TranslationDocument> documents;
 
-        std::unordered_map<std::uint32_t, std::vector<std::pair<std::size_t, std::size_t>>> strings;
+        struct string_entry {
+            std::uint32_t hash;
+            std::uint32_t document;
+            std::uint32_t index;
+        };
+        // Every original string of the loaded documents once, from the first document that has it.
+        std::vector<string_entry> strings;
+        // Open addressed index into `strings` by hash, at most half full, -1 for empty buckets.
+        std::vector<std::int32_t> buckets;
         static std::uint32_t Hash( const char *str );
-        std::optional<std::pair<std::size_t, std::size_t>> LookupString( const char *query ) const;
+        int LookupString( const char *query ) const;
+        void BuildIndex();
 
         std::unordered_map<std::string, std::vector<std::string>> mo_files;
         static std::string LanguageCodeOfPath( std::string_view path );
@@ -38,6 +47,10 @@ class TranslationManager::Impl
         const char *TranslateWithContext( const char *context, const char *message ) const;
         const char *TranslatePluralWithContext( const char *context, const char *singular,
                                                 const char *plural, std::size_t n ) const;
+
+        int FindString( const char *context, const char *message ) const;
+        const char *GetTranslatedString( int index ) const;
+        const char *GetTranslatedStringPlural( int index, std::size_t n ) const;
 };
 
 #endif // defined(LOCALIZE)
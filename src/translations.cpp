@@ -17,6 +17,13 @@ int detail::get_current_language_version()
     return current_language_version;
 }
 
+void detail::invalidate_language_version()
+{
+    do {
+        current_language_version++;
+    } while( current_language_version == INVALID_LANGUAGE_VERSION );
+}
+
 #if defined(LOCALIZE)
 #include "options.h"
 #include "system_locale.h"
@@ -90,9 +97,7 @@ void set_language( const std::string &lang )
     reset_sanity_check_genders();
 
     // increment version to invalidate translation cache
-    do {
-        current_language_version++;
-    } while( current_language_version == INVALID_LANGUAGE_VERSION );
+    detail::invalidate_language_version();
 
 #else
     // Silence unused var warning
@@ -1618,7 +1618,9 @@ bool trapfunc::map_regen( const tripoint_bub_ms &p, Creature *c, item * )
             }
             set_queued_points();
             here.set_seen_cache_dirty( p );
-            here.set_transparency_cache_dirty( p.z() );
+            const tripoint_bub_ms omt_origin = here.get_bub( coords::project_to<coords::ms>( omt_pos ) );
+            here.set_transparency_cache_dirty( omt_origin,
+                                               omt_origin + tripoint_rel_ms( SEEX * 2 - 1, SEEY * 2 - 1, 0 ) );
             return true;
         }
     }
@@ -0,0 +1,370 @@
+#include "turn_replay.h"
+
+#include <chrono>
+#include <cstddef>
+#include <locale>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "flexbuffer_json.h"
+#include "game.h"
+#include "input.h"
+#include "json.h"
+#include "mapbuffer.h"
+#include "messages.h"
+#include "path_info.h"
+#include "perf.h"
+#include "rng.h"
+#include "translations.h"
+#include "worldfactory.h"
+
+namespace turn_replay
+{
+
+namespace
+{
+
+using clock = std::chrono::steady_clock;
+
+enum class mode : int {
+    idle,
+    record_pending,
+    recording,
+    replay_pending,
+    replaying,
+    replay_done
+};
+
+struct recorded_event {
+    // Turns since the recording started.
+    int turn = 0;
+    input_event event;
+};
+
+struct turn_sample {
+    double ms = 0.0;
+    // Engine state at the end of the turn, for telling where a replay went its own way.
+    std::string rng;
+};
+
+struct recording {
+    std::string world;
+    std::string save_id;
+    int turns = 0;
+    std::string rng;
+    std::vector<turn_sample> samples;
+    std::vector<recorded_event> events;
+};
+
+struct replay_state {
+    mode current = mode::idle;
+    recording rec;
+    clock::time_point turn_start;
+    // Replay only.
+    cata_path dir;
+    size_t next_event = 0;
+    std::vector<double> replayed_ms;
+    int first_divergence = -1;
+};
+
+replay_state &state()
+{
+    static replay_state instance;
+    return instance;
+}
+
+std::string engine_state()
+{
+    std::ostringstream os;
+    os.imbue( std::locale::classic() );
+    os << rng_get_engine();
+    return os.str();
+}
+
+bool set_engine_state( const std::string &saved )
+{
+    std::istringstream is( saved );
+    is.imbue( std::locale::classic() );
+    is >> rng_get_engine();
+    return !is.fail();
+}
+
+double elapsed_ms( const clock::time_point &since, const clock::time_point &now )
+{
+    return std::chrono::duration<double, std::milli>( now - since ).count();
+}
+
+void serialize( JsonOut &jsout, const recorded_event &rec )
+{
+    const input_event &evt = rec.event;
+    jsout.start_object();
+    jsout.member( "turn", rec.turn );
+    jsout.member( "type", static_cast<int>( evt.type ) );
+    jsout.member( "sequence", evt.sequence );
+    if( !evt.modifiers.empty() ) {
+        jsout.member( "modifiers" );
+        jsout.start_array();
+        for( const keymod_t mod : evt.modifiers ) {
+            jsout.write( static_cast<int>( mod ) );
+        }
+        jsout.end_array();
+    }
+    if( evt.type == input_event_t::mouse ) {
+        jsout.member( "x", evt.mouse_pos.x );
+        jsout.member( "y", evt.mouse_pos.y );
+    }
+    if( !evt.text.empty() ) {
+        jsout.member( "text", evt.text );
+    }
+    jsout.end_object();
+}
+
+recorded_event deserialize_event( const JsonObject &jo )
+{
+    recorded_event rec;
+    input_event &evt = rec.event;
+    rec.turn = jo.get_int( "turn" );
+    evt.type = static_cast<input_event_t>( jo.get_int( "type" ) );
+    for( const int key : jo.get_int_array( "sequence" ) ) {
+        evt.sequence.push_back( key );
+    }
+    if( jo.has_array( "modifiers" ) ) {
+        for( const int mod : jo.get_int_array( "modifiers" ) ) {
+            evt.modifiers.insert( static_cast<keymod_t>( mod ) );
+        }
+    }
+    evt.mouse_pos = point( jo.get_int( "x", 0 ), jo.get_int( "y", 0 ) );
+    evt.text = jo.get_string( "text", "" );
+    return rec;
+}
+
+bool write_recording( const recording &rec, const cata_path &path )
+{
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_object();
+        jsout.member( "world", rec.world );
+        jsout.member( "save_id", rec.save_id );
+        jsout.member( "turns", static_cast<int>( rec.samples.size() ) );
+        jsout.member( "rng", rec.rng );
+        jsout.member( "samples" );
+        jsout.start_array();
+        for( const turn_sample &sample : rec.samples ) {
+            jsout.start_object();
+            jsout.member( "ms", sample.ms );
+            jsout.member( "rng", sample.rng );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.member( "events" );
+        jsout.start_array();
+        for( const recorded_event &evt : rec.events ) {
+            serialize( jsout, evt );
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, _( "turn recording" ) );
+}
+
+bool read_recording( recording &rec, const cata_path &path )
+{
+    return read_from_file_json( path, [&]( const JsonValue & jv ) {
+        const JsonObject jo = jv.get_object();
+        rec.world = jo.get_string( "world" );
+        rec.save_id = jo.get_string( "save_id" );
+        rec.turns = jo.get_int( "turns" );
+        rec.rng = jo.get_string( "rng" );
+        for( const JsonObject sample : jo.get_array( "samples" ) ) {
+            rec.samples.push_back( { sample.get_float( "ms" ), sample.get_string( "rng" ) } );
+        }
+        for( const JsonObject evt : jo.get_array( "events" ) ) {
+            rec.events.push_back( deserialize_event( evt ) );
+        }
+    } );
+}
+
+void begin_recording( replay_state &st )
+{
+    st.current = mode::idle;
+    const cata_path dir = recording_dir();
+    if( !g->save() ) {
+        add_msg( m_bad, _( "Couldn't save the game, turn recording canceled." ) );
+        return;
+    }
+    MAPBUFFER.finish_pending_saves();
+    if( !assure_dir_exist( dir ) ||
+        !copy_directory( PATH_INFO::world_base_save_path(), dir / "world" ) ) {
+        add_msg( m_bad, _( "Couldn't copy the world to %s, turn recording canceled." ),
+                 dir.generic_u8string() );
+        return;
+    }
+    remove_file( dir / "replay.json" );
+    const int turns = st.rec.turns;
+    st.rec = recording();
+    st.rec.turns = turns;
+    st.rec.world = world_generator->active_world->world_name;
+    st.rec.save_id = get_avatar().get_save_id();
+    st.rec.rng = engine_state();
+    st.current = mode::recording;
+    st.turn_start = clock::now();
+    add_msg( m_info, _( "Recording %d turns for replay." ), turns );
+}
+
+void finish_recording( replay_state &st )
+{
+    st.current = mode::idle;
+    const cata_path path = recording_dir() / "replay.json";
+    if( write_recording( st.rec, path ) ) {
+        add_msg( m_info, _( "Recorded %d turns to %s." ), st.rec.samples.size(),
+                 path.generic_u8string() );
+    }
+    st.rec = recording();
+}
+
+void finish_replay( replay_state &st )
+{
+    st.current = mode::replay_done;
+    perf_trace::stop();
+    perf_trace::write( st.dir / "replay_trace.json" );
+    write_to_file( st.dir / "replay_result.json", [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "turns", static_cast<int>( st.replayed_ms.size() ) );
+        jsout.member( "first_divergence", st.first_divergence );
+        jsout.member( "recorded_ms" );
+        jsout.start_array();
+        for( size_t i = 0; i < st.replayed_ms.size() && i < st.rec.samples.size(); ++i ) {
+            jsout.write( st.rec.samples[i].ms );
+        }
+        jsout.end_array();
+        jsout.member( "replayed_ms", st.replayed_ms );
+        jsout.end_object();
+    }, _( "turn replay result" ) );
+    g->uquit = QUIT_NOSAVED;
+}
+
+} // namespace
+
+cata_path recording_dir()
+{
+    return PATH_INFO::config_dir_path() / "turn_replay";
+}
+
+void request_recording( int turns )
+{
+    replay_state &st = state();
+    if( st.current != mode::idle || turns <= 0 ) {
+        return;
+    }
+    st.rec.turns = turns;
+    st.current = mode::record_pending;
+}
+
+bool is_recording()
+{
+    return state().current == mode::record_pending || state().current == mode::recording;
+}
+
+void stop_recording()
+{
+    replay_state &st = state();
+    if( st.current == mode::recording ) {
+        finish_recording( st );
+    } else if( st.current == mode::record_pending ) {
+        st.current = mode::idle;
+    }
+}
+
+bool prepare_replay( const cata_path &dir, std::string &world, std::string &save_id )
+{
+    replay_state &st = state();
+    st = replay_state();
+    if( !read_recording( st.rec, dir / "replay.json" ) || st.rec.samples.empty() ) {
+        return false;
+    }
+    // A copy of its own, so the recording can be replayed again and again.
+    world = st.rec.world + "-replay";
+    if( !copy_directory( dir / "world", PATH_INFO::savedir_path() / world ) ) {
+        return false;
+    }
+    save_id = st.rec.save_id;
+    st.dir = dir;
+    st.current = mode::replay_pending;
+    return true;
+}
+
+bool replay_finished()
+{
+    return state().current == mode::replay_done;
+}
+
+void end_turn()
+{
+    replay_state &st = state();
+    const clock::time_point now = clock::now();
+    switch( st.current ) {
+        case mode::idle:
+        case mode::replay_done:
+            return;
+        case mode::record_pending:
+            begin_recording( st );
+            return;
+        case mode::recording:
+            st.rec.samples.push_back( { elapsed_ms( st.turn_start, now ), engine_state() } );
+            if( static_cast<int>( st.rec.samples.size() ) >= st.rec.turns ) {
+                finish_recording( st );
+            }
+            break;
+        case mode::replay_pending:
+            if( !set_engine_state( st.rec.rng ) ) {
+                debugmsg( "Turn replay has an unreadable RNG state, it will not match the recording." );
+            }
+            perf_trace::start();
+            st.current = mode::replaying;
+            break;
+        case mode::replaying: {
+            const size_t turn = st.replayed_ms.size();
+            st.replayed_ms.push_back( elapsed_ms( st.turn_start, now ) );
+            if( st.first_divergence < 0 && engine_state() != st.rec.samples[turn].rng ) {
+                st.first_divergence = static_cast<int>( turn );
+                DebugLog( D_WARNING, D_MAIN ) << "Turn replay diverged from the recording in turn " << turn;
+            }
+            if( st.replayed_ms.size() >= st.rec.samples.size() ) {
+                finish_replay( st );
+                return;
+            }
+            break;
+        }
+    }
+    // Taken again, so the bookkeeping above doesn't count toward the next turn.
+    st.turn_start = clock::now();
+}
+
+input_event next_input_event( const keyboard_mode preferred_keyboard_mode )
+{
+    replay_state &st = state();
+    if( st.current == mode::replaying ) {
+        if( st.next_event < st.rec.events.size() ) {
+            return st.rec.events[st.next_event++].event;
+        }
+        // The game wants more input than was recorded, so it went another way. Hand it back
+        // to the player rather than waiting for input that never comes.
+        if( st.first_divergence < 0 ) {
+            st.first_divergence = static_cast<int>( st.replayed_ms.size() );
+        }
+        finish_replay( st );
+    }
+    input_event evt = inp_mngr.get_input_event( preferred_keyboard_mode );
+    if( st.current == mode::recording ) {
+        st.rec.events.push_back( { static_cast<int>( st.rec.samples.size() ), evt } );
+    }
+    return evt;
+}
+
+} // namespace turn_replay
@@ -0,0 +1,54 @@
+#pragma once
+#ifndef CATA_SRC_TURN_REPLAY_H
+#define CATA_SRC_TURN_REPLAY_H
+
+#include <string>
+
+#include "input_enums.h"
+
+class cata_path;
+
+/**
+ * Records a window of turns so that a slow one can be replayed and profiled offline.
+ *
+ * A recording starts at a turn boundary: the game is saved, the world folder is copied next
+ * to the recording and the RNG engine state is written down. After that every input event
+ * is kept, and at each boundary the time the turn took and the engine state. Replaying loads
+ * the copied world, puts the engine back, feeds the recorded events in place of the player's
+ * and traces hot paths until the window is over, then quits without saving.
+ */
+namespace turn_replay
+{
+
+/** Where recordings go, replay.json and the copied world inside it. */
+cata_path recording_dir();
+
+/** Starts recording @p turns turns at the next turn boundary. */
+void request_recording( int turns );
+/** Whether a recording is pending or running. */
+bool is_recording();
+/** Ends a running recording early and writes what it has, drops a pending one. */
+void stop_recording();
+
+/**
+ * Reads the recording in @p dir and copies its world into the save folder, returns the names
+ * of the world and the character to load, or false if the recording can't be used.
+ * The replay itself starts at the first turn boundary after the game is loaded.
+ */
+bool prepare_replay( const cata_path &dir, std::string &world, std::string &save_id );
+/** Whether a prepared replay has run all its turns. */
+bool replay_finished();
+
+/** Called by do_turn at every turn boundary. */
+void end_turn();
+
+/**
+ * The next input event: the recorded one while replaying, otherwise that of the input
+ * manager, which is recorded while a recording runs. Input read through here is all
+ * a replay can reproduce.
+ */
+input_event next_input_event( keyboard_mode preferred_keyboard_mode = keyboard_mode::keycode );
+
+} // namespace turn_replay
+
+#endif // CATA_SRC_TURN_REPLAY_H
@@ -458,6 +458,15 @@ void vpslot_terrain_transform::deserialize( const JsonObject &jo )
     }
 }
 
+std::optional<vpart_bitflags> vpart_info::find_bitflag( const std::string &flag )
+{
+    const auto iter = vpart_bitflag_map.find( flag );
+    if( iter == vpart_bitflag_map.end() ) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
 void vpart_info::set_flag( const std::string &flag )
 {
     flags.insert( flag );
@@ -293,6 +293,8 @@ class vpart_info
         bool has_flag( const vpart_bitflags flag ) const {
             return bitflags.test( flag );
         }
+        /** The bit a string flag is also kept as, if it is one of the vpart_bitflags. */
+        static std::optional<vpart_bitflags> find_bitflag( const std::string &flag );
         void set_flag( const std::string &flag );
 
         /** Gets all categories of this part */
@@ -238,6 +238,7 @@ units::volume vehicle_stack::stored_volume() const
 
 vehicle::vehicle( const vproto_id &proto_id )
 {
+    invalidate_power_grids();
     face.init( 0_degrees );
     move.init( 0_degrees );
 
@@ -258,7 +259,10 @@ vehicle::vehicle( const vproto_id &proto_id )
     }
 }
 
-vehicle::~vehicle() = default;
+vehicle::~vehicle()
+{
+    invalidate_power_grids();
+}
 
 turret_cpu::~turret_cpu() = default;
 
@@ -2332,6 +2336,7 @@ bool vehicle::remove_part( vehicle_part &vp, RemovePartHandler &handler )
 
 bool vehicle::do_remove_part_actual( map *here )
 {
+    relative_parts_built_for = -1;
     bool changed = false;
     for( std::vector<vehicle_part>::iterator it = parts.end(); it != parts.begin(); /*noop*/ ) {
         --it;
@@ -2797,6 +2802,22 @@ std::vector<int> vehicle::parts_at_relative( const point_rel_ms &dp, const bool
         bool include_fake ) const
 {
     std::vector<int> res;
+    if( !use_cache && !include_fake &&
+        relative_parts_built_for == static_cast<int>( parts.size() ) ) {
+        // No part was added or erased since refresh(), so the cache holds every real part;
+        // give the same answer as the scan below, in part index order.
+        const auto iter = relative_parts.find( dp );
+        if( iter != relative_parts.end() ) {
+            for( const int p : iter->second ) {
+                const vehicle_part &vp = parts[p];
+                if( !vp.removed && !vp.is_fake ) {
+                    res.push_back( p );
+                }
+            }
+            std::sort( res.begin(), res.end() );
+        }
+        return res;
+    }
     if( !use_cache ) {
         if( include_fake ) {
             for( const vpart_reference &vp : get_all_parts_with_fakes() ) {
@@ -3036,9 +3057,11 @@ int vehicle::part_with_feature( const point_rel_ms &pt, vpart_bitflags f, bool u
 int vehicle::part_with_feature( const point_rel_ms &pt, const std::string &flag, bool unbroken,
                                 bool include_fake ) const
 {
+    const std::optional<vpart_bitflags> bit = vpart_info::find_bitflag( flag );
     for( const int p : parts_at_relative( pt, /* use_cache = */ false, include_fake ) ) {
         const vehicle_part &vp_here = this->part( p );
-        if( vp_here.info().has_flag( flag ) && !( unbroken && vp_here.is_broken() ) ) {
+        const bool has_flag = bit ? vp_here.info().has_flag( *bit ) : vp_here.info().has_flag( flag );
+        if( has_flag && !( unbroken && vp_here.is_broken() ) ) {
             return p;
         }
     }
@@ -5895,14 +5918,36 @@ void vehicle::translate_cables( const tripoint_rel_ms &offset )
     }
 }
 
+// Unsigned and wide so that it never wraps back to a generation a cache still holds.
+static uint64_t power_grid_generation = 1;
+
+void vehicle::invalidate_power_grids()
+{
+    power_grid_generation++;
+}
+
+const std::map<vehicle *, float> &vehicle::cached_connected_vehicles( const map &here ) const
+{
+    connected_vehicles_cache &cache = connected_cache;
+    if( cache.generation != power_grid_generation || cache.owner != this || cache.on != &here ) {
+        // The search only reads the vehicles it visits, and hands back this vehicle among them.
+        cache.vehicles = search_connected_vehicles( here, const_cast<vehicle *>( this ) );
+        cache.generation = power_grid_generation;
+        cache.owner = this;
+        cache.on = &here;
+    }
+    return cache.vehicles;
+}
+
 std::map<vehicle *, float> vehicle::search_connected_vehicles( const map &here )
 {
-    return search_connected_vehicles( here, this );
+    return cached_connected_vehicles( here );
 }
 
 std::map<const vehicle *, float> vehicle::search_connected_vehicles( const map &here ) const
 {
-    return search_connected_vehicles( here, this );
+    const std::map<vehicle *, float> &found = cached_connected_vehicles( here );
+    return std::map<const vehicle *, float>( found.begin(), found.end() );
 }
 
 void vehicle::get_connected_vehicles( const map &here, std::unordered_set<vehicle *> &dest )
@@ -6181,7 +6226,8 @@ void vehicle::idle( map &here, bool on_map )
     }
 
     // Parts emitting fields
-    const std::pair<int, double> exhaust_and_muffle = get_exhaust_part();
+    const std::pair<int, double> exhaust_and_muffle = emitters.empty() ? std::make_pair( -1, 1.0 ) :
+            get_exhaust_part();
     for( const int emitter_idx : emitters ) {
         const vehicle_part &pt = parts[emitter_idx];
         if( pt.is_unavailable() || !pt.enabled ) {
@@ -6199,7 +6245,8 @@ void vehicle::idle( map &here, bool on_map )
         }
     }
 
-    tiny_bitset flags = has_parts( { "STEREO", "CHIMES", "CRASH_TERRAIN_AROUND" }, true );
+    tiny_bitset flags = idle_effect_parts.empty() ? tiny_bitset( 3 ) :
+                        has_parts( { "STEREO", "CHIMES", "CRASH_TERRAIN_AROUND" }, true );
 
     if( flags.test( 0 ) ) {
         play_music( here );
@@ -6217,6 +6264,10 @@ void vehicle::idle( map &here, bool on_map )
         alarm( here );
     }
 
+    if( turret_locations.empty() ) {
+        return;
+    }
+
     // Notify player about status of all turrets if they're at controls
     bool player_at_controls = !get_parts_at( player_character.pos_abs(), "CONTROLS",
                               part_status_flag::working ).empty();
@@ -6697,6 +6748,8 @@ void vehicle::refresh( const bool remove_fakes )
     if( no_refresh ) {
         return;
     }
+    invalidate_power_grids();
+    relative_parts_built_for = -1;
 
     alternators.clear();
     engines.clear();
@@ -6720,6 +6773,7 @@ void vehicle::refresh( const bool remove_fakes )
     turret_locations.clear();
     mufflers.clear();
     planters.clear();
+    idle_effect_parts.clear();
     accessories.clear();
     cable_ports.clear();
     control_req_parts.clear();
@@ -6780,6 +6834,11 @@ void vehicle::refresh( const bool remove_fakes )
             floating.push_back( p );
         }
 
+        if( vpi.has_flag( "STEREO" ) || vpi.has_flag( "CHIMES" ) ||
+            vpi.has_flag( "CRASH_TERRAIN_AROUND" ) ) {
+            idle_effect_parts.push_back( p );
+        }
+
         if( vp.part().is_unavailable() ) {
             continue;
         }
@@ -6980,6 +7039,7 @@ void vehicle::refresh( const bool remove_fakes )
             relative_parts[pt].push_back( fake_index );
         }
     }
+    relative_parts_built_for = static_cast<int>( parts.size() );
 
     // NB: using the _old_ pivot point, don't recalc here, we only do that when moving!
     precalc_mounts( 0, pivot_rotation[0], pivot_anchor[0] );
@@ -7791,6 +7851,7 @@ void vehicle::shift_parts( map &here, const point_rel_ms &delta )
 {
     // Don't invalidate the active item cache's location!
     active_items.subtract_locations( delta );
+    relative_parts_built_for = -1;
     for( vehicle_part &elem : parts ) {
         elem.mount -= delta;
     }
@@ -8886,7 +8947,6 @@ bool vehicle::refresh_zones()
         }
         loot_zones = new_zones;
         zones_dirty = false;
-        zone_manager::get_manager().cache_data( false );
         return true;
     }
     return false;
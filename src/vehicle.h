@@ -899,7 +899,22 @@ class vehicle
         /// Templated to support const and non-const vehicle*
         template<typename Vehicle>
         static std::map<Vehicle *, float> search_connected_vehicles( const map &here, Vehicle *start );
+        // The last search_connected_vehicles() from this vehicle, reused until something that
+        // could change a power grid calls invalidate_power_grids().
+        struct connected_vehicles_cache {
+            // 0 until the first search, power grid generations start at 1.
+            uint64_t generation = 0;
+            const vehicle *owner = nullptr;
+            const map *on = nullptr;
+            std::map<vehicle *, float> vehicles;
+        };
+        mutable connected_vehicles_cache connected_cache; // NOLINT(cata-serialize)
+        const std::map<vehicle *, float> &cached_connected_vehicles( const map &here ) const;
     public:
+        /// Forgets every vehicle's cached power grid. Called whenever vehicles are created,
+        /// destroyed, refreshed, moved or taken off the map, since any of those can change what
+        /// the POWER_TRANSFER parts lead to.
+        static void invalidate_power_grids();
         std::vector<std::string> chat_topics; // What it has to say.
         void set_value( const std::string &key, diag_value value );
         template <typename... Args>
@@ -2354,6 +2369,9 @@ class vehicle
         std::vector<int> turret_locations; // NOLINT(cata-serialize)
         std::vector<int> mufflers; // NOLINT(cata-serialize)
         std::vector<int> planters; // NOLINT(cata-serialize)
+        // Parts idle() may have to run every turn: STEREO, CHIMES and CRASH_TERRAIN_AROUND,
+        // broken or not. Without any, a parked vehicle skips looking for them.
+        std::vector<int> idle_effect_parts; // NOLINT(cata-serialize)
         std::vector<int> accessories; // NOLINT(cata-serialize)
         std::vector<int> cable_ports; // NOLINT(cata-serialize)
         std::vector<int> fake_parts; // NOLINT(cata-serialize)
@@ -2369,6 +2387,9 @@ class vehicle
         vproto_id type;
         // parts_at_relative(dp) is used a lot (to put it mildly)
         std::map<point_rel_ms, std::vector<int>> relative_parts; // NOLINT(cata-serialize)
+        // Number of parts relative_parts was last built for, or -1 while it may be out of date.
+        // Lets the "no cache" lookups use it anyway once refresh() is done with it.
+        int relative_parts_built_for = -1; // NOLINT(cata-serialize)
         std::set<label> labels;            // stores labels
         std::set<std::string> tags;        // Properties of the vehicle
         // After fuel consumption, this tracks the remainder of fuel < 1, and applies it the next time.
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -24,6 +25,7 @@
 #include "cursesdef.h"
 #include "debug.h"
 #include "enums.h"
+#include "flat_lru_cache.h"
 #include "flood_fill.h"
 #include "hash_utils.h"
 #include "map.h"
@@ -143,6 +145,16 @@
  * maximum speed whenever possible. If the path calculated by A* does not contain any turns,
  * we can increase the vehicle speed for this segment. This is mostly applicable when the car
  * is traversing via roads across long distances.
+ *
+ * Long trips mostly go over OMTs that look alike to the planner, such as the same stretch of
+ * road again and again. So the nav map built for each pair of OMTs is kept as a template,
+ * found again by the obstacles the vehicle could touch from the nav map, its shape and the
+ * direction of travel. A template holds the valid positions and every A* search run on it,
+ * in nav map coordinates. When the view map of a new pair of OMTs matches a template, none of
+ * that is computed again, and a search from the same start node and speed reuses the path.
+ * The obstacles are still checked for every pair of OMTs, so a real obstacle means a
+ * different template and a new plan. The vehicle profiles are only computed again when the
+ * vehicle changes shape.
  */
 
 static const ter_str_id ter_t_open_air( "t_open_air" );
@@ -253,6 +265,64 @@ struct navigation_node {
     bool is_goal;
 };
 
+/*
+ * One step of a path found by A* in nav map coordinates: where the vehicle pivot starts the
+ * turn, and the orientation and target speed to drive at.
+ */
+struct nav_route_step {
+    point prev;
+    orientation facing_dir;
+    int8_t target_speed_tps;
+};
+
+/*
+ * An A* search on a nav map template, with everything besides the template that it depends on.
+ */
+struct nav_route {
+    point goal_point;
+    node_address start;
+    int16_t speed;
+    int16_t tileray_steps;
+    int speed_tps;
+    int max_cautious_speed_tps;
+    int max_steer;
+    std::vector<int> acceleration;
+    // From the goal back to the start, empty if the search found no path.
+    std::optional<std::vector<nav_route_step>> path;
+};
+
+/*
+ * The valid positions of a nav map, and the searches run on it so far (oldest first).
+ */
+struct nav_template {
+    // One bit per nav map point, x * NAV_MAP_SIZE_Y + y.
+    std::array<std::bitset<NAV_MAP_SIZE_X * NAV_MAP_SIZE_Y>, NUM_ORIENTATIONS> valid_positions;
+    std::vector<nav_route> routes;
+};
+
+/*
+ * What the valid positions of a nav map depend on: the view map obstacles the vehicle could
+ * touch from the nav map, the vehicle's shape and the rotation of the nav map.
+ */
+struct nav_template_key {
+    std::bitset<NAV_VIEW_SIZE_X * NAV_VIEW_SIZE_Y> obstacles;
+    quad_rotation rotation = quad_rotation::d0;
+    int shape_version = 0;
+    bool operator== ( const nav_template_key &other ) const {
+        return rotation == other.rotation && shape_version == other.shape_version &&
+               obstacles == other.obstacles;
+    }
+};
+
+struct nav_template_key_hasher {
+    std::size_t operator()( const nav_template_key &key ) const {
+        std::size_t seed = std::hash<std::bitset<NAV_VIEW_SIZE_X * NAV_VIEW_SIZE_Y>>()( key.obstacles );
+        cata::hash_combine( seed, static_cast<int>( key.rotation ) );
+        cata::hash_combine( seed, key.shape_version );
+        return seed;
+    }
+};
+
 /*
  * Data type describing a point transformation via translation and rotation.
  */
@@ -337,10 +407,13 @@ struct auto_navigation_data {
 
     // computed path to next OMT
     std::vector<navigation_step> path;
+    // the template matching the nav map, which the searches on it are kept with
+    std::shared_ptr<nav_template> current_template;
 
     void clear() {
         current_omt = { 0, 0, -100 };
         path.clear();
+        current_template.reset();
     }
     vehicle_profile &profile( orientation dir ) {
         return profiles.at( static_cast<int>( dir ) );
@@ -397,6 +470,14 @@ class vehicle::autodrive_controller
         const Character &driver;
         auto_navigation_data data;
         bool in_greedy_mode;
+        // What the vehicle profiles were computed from, see compute_shape().
+        std::vector<int> profile_shape;
+        // Bumped every time the profiles change, templates of older profiles are never found.
+        int shape_version = 0;
+        // How far from the pivot the profiles reach, in either axis.
+        int profile_reach = 0;
+        flat_lru_cache<nav_template_key, std::shared_ptr<nav_template>, nav_template_key_hasher>
+        nav_templates{ 16, "autodrive_nav_templates" };
 
         void compute_coordinates();
         bool check_drivable( map &here, const tripoint_bub_ms &pt ) const;
@@ -404,6 +485,9 @@ class vehicle::autodrive_controller
         void enqueue_if_ramp( point_queue &ramp_points, const map &here, const tripoint_bub_ms &p ) const;
         void compute_obstacles_from_enqueued_ramp_points( point_queue &ramp_points, map &here );
         vehicle_profile compute_profile( map &here, orientation facing ) const;
+        std::vector<int> compute_shape( map &here ) const;
+        void compute_profiles( map &here );
+        nav_template_key compute_template_key() const;
         void compute_valid_positions();
         void compute_goal_zone();
         void precompute_data( map &here );
@@ -412,7 +496,9 @@ class vehicle::autodrive_controller
         void compute_next_nodes( const node_address &addr, const navigation_node &node,
                                  int target_speed_tps,
                                  std::vector<std::pair<node_address, navigation_node>> &next_nodes ) const;
-        std::optional<std::vector<navigation_step>> compute_path( int speed_tps ) const;
+        std::optional<std::vector<nav_route_step>> search_path( const node_address &start,
+                int speed_tps ) const;
+        std::optional<std::vector<navigation_step>> compute_path( int speed_tps );
 };
 
 static const std::array<orientation, NUM_ORIENTATIONS> &all_orientations()
@@ -719,6 +805,63 @@ vehicle_profile vehicle::autodrive_controller::compute_profile( map &here,
     return ret;
 }
 
+// Everything compute_profile() reads from the vehicle: the pivot, the mounts of its parts
+// and its rotors.
+std::vector<int> vehicle::autodrive_controller::compute_shape( map &here ) const
+{
+    std::vector<int> ret;
+    const point_rel_ms pivot = driven_veh.pivot_point( here );
+    ret.push_back( pivot.x() );
+    ret.push_back( pivot.y() );
+    for( const vehicle_part &part : driven_veh.parts ) {
+        if( !part.removed ) {
+            ret.push_back( part.mount.x() );
+            ret.push_back( part.mount.y() );
+        }
+    }
+    for( int part_num : driven_veh.rotors ) {
+        ret.push_back( part_num );
+        ret.push_back( driven_veh.part( part_num ).info().rotor_info->rotor_diameter );
+    }
+    return ret;
+}
+
+void vehicle::autodrive_controller::compute_profiles( map &here )
+{
+    std::vector<int> shape = compute_shape( here );
+    if( shape_version > 0 && shape == profile_shape ) {
+        return;
+    }
+    profile_shape = std::move( shape );
+    shape_version++;
+    profile_reach = 0;
+    for( orientation dir : all_orientations() ) {
+        data.profile( dir ) = compute_profile( here, dir );
+        for( const point_rel_ms &p : data.profile( dir ).occupied_zone ) {
+            profile_reach = std::max( { profile_reach, std::abs( p.x() ), std::abs( p.y() ) } );
+        }
+    }
+}
+
+// The obstacles compute_valid_positions() could look at, the rest of the view map is left clear.
+nav_template_key vehicle::autodrive_controller::compute_template_key() const
+{
+    nav_template_key key;
+    key.rotation = data.nav_to_map.rotation;
+    key.shape_version = shape_version;
+    const point nav_min = data.nav_to_view.transform( point::zero );
+    const int x_min = std::max( nav_min.x - profile_reach, 0 );
+    const int x_max = std::min( nav_min.x + NAV_MAP_SIZE_X + profile_reach, NAV_VIEW_SIZE_X );
+    const int y_min = std::max( nav_min.y - profile_reach, 0 );
+    const int y_max = std::min( nav_min.y + NAV_MAP_SIZE_Y + profile_reach, NAV_VIEW_SIZE_Y );
+    for( int dx = x_min; dx < x_max; dx++ ) {
+        for( int dy = y_min; dy < y_max; dy++ ) {
+            key.obstacles[dx * NAV_VIEW_SIZE_Y + dy] = data.is_obstacle[dx][dy];
+        }
+    }
+    return key;
+}
+
 // Return true if the map tile at the given position (in map coordinates)
 // can be driven on (not an obstacle).
 // The logic should match what is in vehicle::part_collision().
@@ -976,14 +1119,35 @@ void vehicle::autodrive_controller::precompute_data( map &here )
         // TODO: change it during simulation based on vehicle speed and terrain
         // or maybe just keep track of player moves?
         data.max_steer = 1;
-        for( orientation dir : all_orientations() ) {
-            data.profile( dir ) = compute_profile( here, dir );
-        }
+        compute_profiles( here );
 
         // initialize navigation data
         compute_coordinates();
         compute_obstacles( here );
-        compute_valid_positions();
+        const nav_template_key key = compute_template_key();
+        data.current_template = nav_templates.get( key, nullptr );
+        if( data.current_template ) {
+            for( orientation facing : all_orientations() ) {
+                const auto &valid = data.current_template->valid_positions[static_cast<int>( facing )];
+                for( int mx = 0; mx < NAV_MAP_SIZE_X; mx++ ) {
+                    for( int my = 0; my < NAV_MAP_SIZE_Y; my++ ) {
+                        data.valid_position( facing, point( mx, my ) ) = valid[mx * NAV_MAP_SIZE_Y + my];
+                    }
+                }
+            }
+        } else {
+            compute_valid_positions();
+            data.current_template = std::make_shared<nav_template>();
+            for( orientation facing : all_orientations() ) {
+                auto &valid = data.current_template->valid_positions[static_cast<int>( facing )];
+                for( int mx = 0; mx < NAV_MAP_SIZE_X; mx++ ) {
+                    for( int my = 0; my < NAV_MAP_SIZE_Y; my++ ) {
+                        valid[mx * NAV_MAP_SIZE_Y + my] = data.valid_position( facing, point( mx, my ) );
+                    }
+                }
+            }
+            nav_templates.insert( key, data.current_template );
+        }
         compute_goal_zone();
         data.path.clear();
     }
@@ -1100,22 +1264,16 @@ const
     }
 }
 
-std::optional<std::vector<navigation_step>> vehicle::autodrive_controller::compute_path(
-            int speed_tps ) const
+std::optional<std::vector<nav_route_step>> vehicle::autodrive_controller::search_path(
+            const node_address &start, int speed_tps ) const
 {
-    if( speed_tps == 0 || speed_tps < -1 ) {
-        return std::nullopt;
-    }
     // TODO: tweak this
     constexpr int max_search_count = 10000;
-    std::vector<navigation_step> ret;
+    std::vector<nav_route_step> ret;
     // TODO: check simple reachability first and bail out or set upper bound on node score
     std::unordered_map<node_address, navigation_node, node_address_hasher> known_nodes;
     std::priority_queue<scored_address, std::vector<scored_address>, std::greater<>>
             open_set;
-    const tripoint_abs_ms veh_pos = driven_veh.pos_abs();
-    const node_address start = data.nav_to_map.inverse().transform(
-                                   veh_pos.raw().xy(), to_orientation( driven_veh.face.dir() ) );
     known_nodes.emplace( start, make_start_node( start, driven_veh ) );
     open_set.push( scored_address{ start, 0 } );
     std::vector<std::pair<node_address, navigation_node>> next_nodes;
@@ -1128,13 +1286,7 @@ std::optional<std::vector<navigation_step>> vehicle::autodrive_controller::compu
             while( !( addr == start ) ) {
                 const navigation_node &node = known_nodes.at( addr );
                 const node_address &prev = node.prev;
-                const tripoint_abs_ms prev_loc( data.nav_to_map.transform( prev.get_point(),
-                                                data.current_omt.z() ) );
-                ret.emplace_back( navigation_step{
-                    data.adjust_z( prev_loc ),
-                    data.nav_to_map.transform( addr.facing_dir ),
-                    node.target_speed_tps
-                } );
+                ret.emplace_back( nav_route_step{ prev.get_point(), addr.facing_dir, node.target_speed_tps } );
                 addr = prev;
             }
             return ret;
@@ -1163,6 +1315,50 @@ std::optional<std::vector<navigation_step>> vehicle::autodrive_controller::compu
     return std::nullopt;
 }
 
+std::optional<std::vector<navigation_step>> vehicle::autodrive_controller::compute_path(
+            int speed_tps )
+{
+    if( speed_tps == 0 || speed_tps < -1 ) {
+        return std::nullopt;
+    }
+    // How many searches to keep per template, a straight road only needs a few.
+    constexpr size_t max_routes = 8;
+    const tripoint_abs_ms veh_pos = driven_veh.pos_abs();
+    const node_address start = data.nav_to_map.inverse().transform(
+                                   veh_pos.raw().xy(), to_orientation( driven_veh.face.dir() ) );
+    const navigation_node start_node = make_start_node( start, driven_veh );
+    std::vector<nav_route> &routes = data.current_template->routes;
+    auto route = std::find_if( routes.begin(), routes.end(), [&]( const nav_route & r ) {
+        return r.goal_point == data.goal_points.back() && r.start == start &&
+               r.speed == start_node.speed && r.tileray_steps == start_node.tileray_steps &&
+               r.speed_tps == speed_tps && r.max_cautious_speed_tps == data.max_cautious_speed_tps &&
+               r.max_steer == data.max_steer && r.acceleration == data.acceleration;
+    } );
+    if( route == routes.end() ) {
+        if( routes.size() >= max_routes ) {
+            routes.erase( routes.begin() );
+        }
+        routes.push_back( nav_route{ data.goal_points.back(), start, start_node.speed,
+                                     start_node.tileray_steps, speed_tps, data.max_cautious_speed_tps,
+                                     data.max_steer, data.acceleration, search_path( start, speed_tps ) } );
+        route = routes.end() - 1;
+    }
+    if( !route->path ) {
+        return std::nullopt;
+    }
+    std::vector<navigation_step> ret;
+    ret.reserve( route->path->size() );
+    for( const nav_route_step &step : *route->path ) {
+        const tripoint_abs_ms prev_loc( data.nav_to_map.transform( step.prev, data.current_omt.z() ) );
+        ret.emplace_back( navigation_step{
+            data.adjust_z( prev_loc ),
+            data.nav_to_map.transform( step.facing_dir ),
+            step.target_speed_tps
+        } );
+    }
+    return ret;
+}
+
 vehicle::autodrive_controller::autodrive_controller( const vehicle &driven_veh,
         const Character &driver ) : driven_veh( driven_veh ), driver( driver )
 {
@@ -160,14 +160,14 @@ int vehicle::slowdown( map &here, int at_velocity ) const
 void vehicle::smart_controller_handle_turn( map &here,
         const std::optional<float> &k_traction_cache )
 {
-    // get settings or defaults
-    smart_controller_config cfg = smart_controller_cfg.value_or( smart_controller_config() );
-
     if( !has_enabled_smart_controller ) {
         smart_controller_state = std::nullopt;
         return;
     }
 
+    // get settings or defaults
+    smart_controller_config cfg = smart_controller_cfg.value_or( smart_controller_config() );
+
     if( smart_controller_state && smart_controller_state->created == calendar::turn ) {
         return;
     }
@@ -884,8 +884,6 @@ veh_collision vehicle::part_collision( map &here, int part, const tripoint_abs_m
     Creature *critter = get_creature_tracker().creature_at( p, true );
     Character *ph = dynamic_cast<Character *>( critter );
 
-    Character *driver = get_driver( here );
-
     // If in a vehicle assume it's this one
     if( ph != nullptr && ph->in_vehicle ) {
         critter = nullptr;
@@ -1130,6 +1128,8 @@ veh_collision vehicle::part_collision( map &here, int part, const tripoint_abs_m
                 }
             }
         } else if( ret.type == veh_coll_body ) {
+            // Only needed to blame someone for the hit; finding it scans all boarded parts.
+            Character *driver = get_driver( here );
             int dam = obj_dmg * vpi.dmg_mod / 100;
 
             // We know critter is set for this type.  Assert to inform static
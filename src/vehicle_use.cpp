@@ -1335,16 +1335,18 @@ void vehicle::open_or_close( map &here, const int part_index, const bool opening
             unlock( parti );
         }
         prt.open = opening;
+        here.set_transparency_cache_dirty( bub_part_pos( here, prt ) );
         if( prt.is_fake ) {
             parts.at( prt.fake_part_to ).open = opening;
+            here.set_transparency_cache_dirty( bub_part_pos( here, prt.fake_part_to ) );
         } else if( prt.has_fake ) {
             parts.at( prt.fake_part_at ).open = opening;
+            here.set_transparency_cache_dirty( bub_part_pos( here, prt.fake_part_at ) );
         }
     };
     //find_lines_of_parts() doesn't return the part_index we passed, so we set it on its own
     part_open_or_close( part_index, opening );
     insides_dirty = true;
-    here.set_transparency_cache_dirty( sm_pos.z() );
     const tripoint_abs_ms part_location = mount_to_tripoint_abs( parts[part_index].mount );
     here.set_seen_cache_dirty( here.get_bub( part_location ) );
     const int dist = rl_dist( get_player_character().pos_abs(), part_location );
@@ -0,0 +1,145 @@
+#include "visibility_oracle.h"
+
+#include <algorithm>
+
+#include "coordinates.h"
+
+// Past this many observing tiles the rows are dropped and started anew, a row
+// costs a few KiB.
+static constexpr size_t max_visibility_observers = 2048;
+
+bool visibility_oracle::in_range( const tripoint_bub_ms &p )
+{
+    return p.x() >= 0 && p.y() >= 0 && p.x() < MAPSIZE_X && p.y() < MAPSIZE_Y;
+}
+
+size_t visibility_oracle::index_of( const tripoint_bub_ms &p )
+{
+    return static_cast<size_t>( p.y() ) * MAPSIZE_X + p.x();
+}
+
+int visibility_oracle::lookup( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const
+{
+    if( rows.empty() || !in_range( from ) || !in_range( to ) ) {
+        return -1;
+    }
+    if( const auto found = rows.find( from.raw() ); found != rows.end() ) {
+        const size_t at = index_of( to );
+        if( found->second->known[at] ) {
+            return found->second->visible[at] ? 1 : 0;
+        }
+    }
+    if( const auto found = rows.find( to.raw() ); found != rows.end() ) {
+        const size_t at = index_of( from );
+        if( found->second->known[at] ) {
+            return found->second->visible[at] ? 1 : 0;
+        }
+    }
+    return -1;
+}
+
+void visibility_oracle::store( const tripoint_bub_ms &from, const tripoint_bub_ms &to,
+                               bool visible )
+{
+    if( !in_range( from ) || !in_range( to ) ) {
+        return;
+    }
+    std::unique_ptr<row> &observer = rows[from.raw()];
+    if( !observer ) {
+        if( rows.size() > max_visibility_observers ) {
+            rows.clear();
+            store( from, to, visible );
+            return;
+        }
+        observer = std::make_unique<row>();
+    }
+    const size_t at = index_of( to );
+    observer->known[at] = true;
+    observer->visible[at] = visible;
+}
+
+void visibility_oracle::clear()
+{
+    rows.clear();
+}
+
+uint64_t skew_sight_cache::key_of( const tripoint_bub_ms &from, const tripoint_bub_ms &to )
+{
+    // The order is canonical so the cache is reflexive. Bubble coordinates fit in 10 bits
+    // each, the z-level in 6.
+    const tripoint_bub_ms &min = from < to ? from : to;
+    const tripoint_bub_ms &max = from < to ? to : from;
+    const auto pack = []( const tripoint_bub_ms & p ) {
+        return static_cast<uint64_t>( p.x() & 0x3ff ) << 16 |
+               static_cast<uint64_t>( p.y() & 0x3ff ) << 6 |
+               static_cast<uint64_t>( ( p.z() + OVERMAP_DEPTH ) & 0x3f );
+    };
+    return pack( min ) << 26 | pack( max );
+}
+
+size_t skew_sight_cache::set_of( const uint64_t key )
+{
+    // Fibonacci hashing, the top bits of the product depend on every bit of the key.
+    return static_cast<size_t>( ( key * 0x9E3779B97F4A7C15ULL ) >> ( 64 - set_bits ) );
+}
+
+int skew_sight_cache::lookup( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const
+{
+    if( sets.empty() ) {
+        return -1;
+    }
+    const uint64_t key = key_of( from, to );
+    const entry_set &set = sets[set_of( key )];
+    if( set.epoch != epoch ) {
+        return -1;
+    }
+    for( int i = 0; i < ways; ++i ) {
+        if( ( set.used & ( 1 << i ) ) && set.keys[i] == key ) {
+            return ( set.visible >> i ) & 1;
+        }
+    }
+    return -1;
+}
+
+void skew_sight_cache::store( const tripoint_bub_ms &from, const tripoint_bub_ms &to,
+                              bool visible )
+{
+    if( sets.empty() ) {
+        sets.resize( size_t( 1 ) << set_bits );
+    }
+    const uint64_t key = key_of( from, to );
+    entry_set &set = sets[set_of( key )];
+    if( set.epoch != epoch ) {
+        set.epoch = epoch;
+        set.used = 0;
+        set.next_victim = 0;
+    }
+    int way = -1;
+    for( int i = 0; i < ways; ++i ) {
+        if( ( set.used & ( 1 << i ) ) && set.keys[i] == key ) {
+            way = i;
+            break;
+        }
+    }
+    if( way < 0 ) {
+        // Filled in order, then replaced in the same order, so the oldest entry goes first.
+        way = set.next_victim;
+        set.next_victim = ( set.next_victim + 1 ) % ways;
+        set.keys[way] = key;
+        set.used |= 1 << way;
+    }
+    if( visible ) {
+        set.visible |= 1 << way;
+    } else {
+        set.visible &= ~( 1 << way );
+    }
+}
+
+void skew_sight_cache::clear()
+{
+    if( ++epoch == 0 ) {
+        // Wrapped around, old stamps could be mistaken for current ones.
+        std::fill( sets.begin(), sets.end(), entry_set() );
+        epoch = 1;
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef CATA_SRC_VISIBILITY_ORACLE_H
+#define CATA_SRC_VISIBILITY_ORACLE_H
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "coords_fwd.h"
+#include "map_scale_constants.h"
+#include "point.h"
+
+/**
+ * Line of sight answers of map::sees between tiles of one z-level, kept as a
+ * dense row of bits per observing tile.
+ *
+ * Every creature that looks around during a turn asks about many targets from
+ * the same tile, so a row per observer answers those by lookup instead of
+ * walking the bresenham line again, and shares them with every other creature
+ * standing there. A sight line is symmetric for the callers, so an answer
+ * stored from the target's row is used as well.
+ * The map drops everything whenever the vision transparency changes.
+ */
+class visibility_oracle
+{
+    public:
+        // 1 if |to| is in sight of |from|, 0 if it isn't, -1 if nobody asked yet.
+        int lookup( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const;
+        void store( const tripoint_bub_ms &from, const tripoint_bub_ms &to, bool visible );
+        void clear();
+        size_t observers() const {
+            return rows.size();
+        }
+
+    private:
+        struct row {
+            std::bitset<MAPSIZE_X * MAPSIZE_Y> known;
+            std::bitset<MAPSIZE_X * MAPSIZE_Y> visible;
+        };
+        static bool in_range( const tripoint_bub_ms &p );
+        static size_t index_of( const tripoint_bub_ms &p );
+
+        std::unordered_map<tripoint, std::unique_ptr<row>> rows;
+};
+
+/**
+ * Line of sight answers of map::sees between tiles of different z-levels.
+ *
+ * These lines are few and hard to group by observer, so they are kept pairwise in a
+ * fixed size table: the pair is hashed to a set of a few entries that share one cache line,
+ * and when the set is full the oldest entry gives way. Clearing only starts a new epoch,
+ * sets stamped with an older one count as empty. The table is allocated on the first store,
+ * so maps that never look across z-levels don't pay for it.
+ */
+class skew_sight_cache
+{
+    public:
+        // 1 if |to| is in sight of |from|, 0 if it isn't, -1 if that isn't known.
+        int lookup( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const;
+        void store( const tripoint_bub_ms &from, const tripoint_bub_ms &to, bool visible );
+        void clear();
+
+    private:
+        static constexpr int ways = 6;
+        static constexpr int set_bits = 12;
+
+        struct alignas( 64 ) entry_set {
+            uint32_t epoch = 0;
+            uint8_t used = 0;
+            uint8_t visible = 0;
+            uint8_t next_victim = 0;
+            std::array<uint64_t, ways> keys = {};
+        };
+        static uint64_t key_of( const tripoint_bub_ms &from, const tripoint_bub_ms &to );
+        static size_t set_of( uint64_t key );
+
+        std::vector<entry_set> sets;
+        // Starts above the epoch of a new set, so a new set is empty.
+        uint32_t epoch = 1;
+};
+
+#endif // CATA_SRC_VISIBILITY_ORACLE_H
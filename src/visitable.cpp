@@ -109,6 +109,14 @@ static T sum_no_wrap( T a, T b )
     return a + b;
 }
 
+// Whether filter is the default return_true<item>, which the queries below then don't call.
+static bool accepts_everything( const std::function<bool( const item & )> &filter )
+{
+    using filter_fn = bool( * )( const item & );
+    const filter_fn *fn = filter.target<filter_fn>();
+    return fn != nullptr && *fn == &return_true<item>;
+}
+
 template <typename T>
 static int has_quality_internal( const T &self, const quality_id &qual, int level, int limit )
 {
@@ -157,19 +165,29 @@ bool read_only_visitable::has_quality( const quality_id &qual, int level, int qt
 /** @relates visitable */
 bool inventory::has_quality( const quality_id &qual, int level, int qty ) const
 {
-    const quality_query query{ qual, level, qty };
-
-    if( qualities_cache.find( query ) == qualities_cache.end() ) {
-        int res = 0;
+    auto found = quality_levels.find( qual );
+    if( found == quality_levels.end() ) {
+        // Count every level at once, the crafting menu asks after the same quality at many levels.
+        std::map<int, int> &levels = quality_levels[qual];
         for( const auto &stack : this->items ) {
-            res += stack.size() * has_quality_internal( stack.front(), qual, level, qty );
-            if( res >= qty ) {
-                qualities_cache[query] = true;
-            }
+            const int copies = stack.size();
+            stack.front().visit_items( [&qual, &levels, copies]( const item * e, item * ) {
+                int &count = levels[e->get_quality( qual )];
+                count = sum_no_wrap( count, copies * static_cast<int>( e->count() ) );
+                return VisitResponse::NEXT;
+            } );
         }
+        found = quality_levels.find( qual );
     }
 
-    return qualities_cache[query];
+    int res = 0;
+    for( auto it = found->second.lower_bound( level ); it != found->second.end(); ++it ) {
+        res = sum_no_wrap( res, it->second );
+        if( res >= qty ) {
+            return true;
+        }
+    }
+    return false;
 }
 
 /** @relates visitable */
@@ -759,6 +777,7 @@ std::list<item> map_cursor::remove_items_with( const
             // finally remove the item
             res.push_back( *iter );
             iter = stack.erase( iter );
+            sub->bump_content_version();
 
             if( --count == 0 ) {
                 break;
@@ -857,11 +876,12 @@ static int charges_of_internal( const T &self, const M &main, const itype_id &id
 
     bool found_tool_with_UPS = false;
     bool found_bionic_tool = false;
+    const bool unfiltered = accepts_everything( filter );
     self.visit_items( [&]( const item * e, item * ) {
-        if( filter( *e ) &&
-            ( id == e->typeId() || ( in_tools && id == e->ammo_current() ) ||
+        // The type test is cheap, component filters often aren't, so it goes first.
+        if( ( id == e->typeId() || ( in_tools && id == e->ammo_current() ) ||
               ( id == itype_UPS && e->has_flag( flag_IS_UPS ) ) ) &&
-            !e->is_broken() ) {
+            ( unfiltered || filter( *e ) ) && !e->is_broken() ) {
             if( id != itype_UPS ) {
                 if( e->count_by_charges() ) {
                     qty = sum_no_wrap( qty, e->charges );
@@ -957,9 +977,10 @@ int inventory::charges_of( const itype_id &what, int limit,
                            const std::function<void( int )> &visitor, bool in_tools ) const
 {
     const itype_bin &binned = get_binned_items();
-    const auto iter = std::find_if( binned.begin(),
+    // Only UPS charges can come from other types, everything else is a direct lookup.
+    const auto iter = what != itype_UPS ? binned.find( what ) : std::find_if( binned.begin(),
     binned.end(), [&what]( itype_bin::value_type const & it ) {
-        return it.first == what || ( what == itype_UPS && it.first->has_flag( flag_IS_UPS ) );
+        return it.first == what || it.first->has_flag( flag_IS_UPS );
     } );
     if( iter == binned.end() ) {
         return 0;
@@ -996,10 +1017,10 @@ static int amount_of_internal( const T &self, const itype_id &id, bool pseudo, i
                                const std::function<bool( const item & )> &filter )
 {
     int qty = 0;
-    self.visit_items( [&qty, &id, &pseudo, &limit, &filter]( const item * e, item * ) {
-        if( !e->has_flag( json_flag_ITEM_BROKEN ) &&
-            ( id == itype_any || e->typeId() == id ) && filter( *e ) &&
-            ( pseudo || !e->has_flag( json_flag_PSEUDO ) ) ) {
+    const bool unfiltered = accepts_everything( filter );
+    self.visit_items( [&qty, &id, &pseudo, &limit, &filter, unfiltered]( const item * e, item * ) {
+        if( ( id == itype_any || e->typeId() == id ) && !e->has_flag( json_flag_ITEM_BROKEN ) &&
+            ( unfiltered || filter( *e ) ) && ( pseudo || !e->has_flag( json_flag_PSEUDO ) ) ) {
             qty = sum_no_wrap( qty, 1 );
         }
         return qty != limit ? VisitResponse::NEXT : VisitResponse::ABORT;
@@ -1094,9 +1094,32 @@ units::temperature weather_manager::get_area_temperature( const tripoint_abs_omt
                get_weather().get_cur_weather_gen().base_temperature ) : temperature;
 }
 
+units::temperature weather_manager::get_natural_temperature( const tripoint_abs_ms &location,
+        const time_point &t )
+{
+    const weather_generator &wgen = get_cur_weather_gen();
+    const unsigned int seed = g->get_seed();
+    if( wgen.id != natural_temperature_gen || seed != natural_temperature_seed ||
+        natural_temperature_cache.size() >= 1 << 16 ) {
+        natural_temperature_cache.clear();
+        natural_temperature_gen = wgen.id;
+        natural_temperature_seed = seed;
+    }
+
+    const tripoint_abs_omt omt = project_to<coords::omt>( location );
+    const auto inserted = natural_temperature_cache.emplace( std::make_pair( omt, to_turn<int>( t ) ),
+                          0_K );
+    if( inserted.second ) {
+        inserted.first->second = wgen.get_weather_temperature( project_to<coords::ms>( omt ), t,
+                                 seed );
+    }
+    return inserted.first->second;
+}
+
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    natural_temperature_cache.clear();
 }
 
 const weather_manager &get_weather_const()
@@ -9,6 +9,7 @@
 #include "catacharset.h"
 #include "color.h"
 #include "coordinates.h"
+#include "hash_utils.h"
 #include "pimpl.h"
 #include "ret_val.h"
 #include "type_id.h"
@@ -235,9 +236,23 @@ class weather_manager
         * this is essentially the "natural" temperature.
         */
         units::temperature get_area_temperature( const tripoint_abs_omt &location ) const;
+        /*
+        * Returns the weather generator's temperature of the OMT holding the given point at the
+        * given time, as used for items catching up on time spent outside the reality bubble.
+        * The noise behind it varies over thousands of tiles, so one value serves the whole OMT
+        * and is remembered until clear_temp_cache().
+        */
+        units::temperature get_natural_temperature( const tripoint_abs_ms &location,
+                const time_point &t );
         void clear_temp_cache();
         static void serialize_all( JsonOut &json );
         static void unserialize_all( const JsonObject &w );
+    private:
+        /** natural temperatures by OMT and turn, valid for one generator and seed */
+        std::unordered_map<std::pair<tripoint_abs_omt, int>, units::temperature, cata::tuple_hash>
+        natural_temperature_cache;
+        weather_generator_id natural_temperature_gen;
+        unsigned int natural_temperature_seed = 0;
 };
 
 weather_manager &get_weather();
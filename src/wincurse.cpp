@@ -695,6 +695,11 @@ void input_manager::pump_events()
     previously_pressed_key = 0;
 }
 
+bool input_manager::has_pending_key_input() const
+{
+    return false;
+}
+
 // we can probably add support for keycode mode, but wincurse is deprecated
 // so we just ignore the mode argument.
 input_event input_manager::get_input_event( const keyboard_mode /*preferred_keyboard_mode*/ )
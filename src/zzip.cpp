@@ -3,8 +3,10 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <exception>
+#include <fstream>
 #include <iosfwd>
 #include <memory>
 #include <optional>
@@ -29,6 +31,7 @@
 #include "flexbuffer_json.h"
 #include "mmap_file.h"
 #include "std_hash_fs_path.h"
+#include "thread_pool.h"
 
 namespace
 {
@@ -85,8 +88,8 @@ struct zzip_vector_storage : flexbuffer_storage {
     }
 };
 
-// To save time, and because we aren't multithreading, we can cache zstd
-// compress and decompress contexts, indexed by dictionary path.
+// To save time we cache zstd compress and decompress contexts, indexed by dictionary path.
+// zstd contexts can't be shared between threads, so each thread keeps its own.
 struct cached_zstd_context {
     std::vector<char> dictionary_;
     ZSTD_CCtx *cctx = nullptr;
@@ -134,7 +137,164 @@ struct cached_zstd_context {
     }
 };
 
-std::unordered_map<std::string, cached_zstd_context> cached_contexts;
+thread_local std::unordered_map<std::string, cached_zstd_context> cached_contexts;
+
+// Returns the cached contexts for the given dictionary, loading it if needed.
+// Returns nullptr if the dictionary can't be read.
+cached_zstd_context *get_cached_context( std::filesystem::path const &dictionary_path )
+{
+    std::string key = dictionary_path.generic_u8string();
+    if( auto it = cached_contexts.find( key ); it != cached_contexts.end() ) {
+        return &it->second;
+    }
+    std::vector<char> dictionary;
+    if( !dictionary_path.empty() ) {
+        std::shared_ptr<const mmap_file> dictionary_file = mmap_file::map_file( dictionary_path );
+        if( !dictionary_file ) {
+            return nullptr;
+        }
+        dictionary.resize( dictionary_file->len() );
+        memcpy( dictionary.data(), dictionary_file->base(), dictionary_file->len() );
+    }
+    ZSTD_CCtx *cctx = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter( cctx, ZSTD_c_compressionLevel, 7 );
+    ZSTD_DCtx *dctx = ZSTD_createDCtx();
+    if( !dictionary.empty() ) {
+        ZSTD_CCtx_loadDictionary_byReference( cctx, dictionary.data(), dictionary.size() );
+        ZSTD_DCtx_loadDictionary_byReference( dctx, dictionary.data(), dictionary.size() );
+    }
+    return &cached_contexts.emplace( std::move( key ), cached_zstd_context{ std::move( dictionary ), cctx, dctx } ).first->second;
+}
+
+// A world can train its own dictionaries to refine the shipped one for each kind of content.
+// They live next to the base dictionary as <stem>.<id>.dict, and <stem>.trained names the one
+// new entries are compressed with. Each entry records the id it was compressed with, so
+// entries written with older dictionaries stay readable as long as their files are kept.
+std::filesystem::path trained_dictionary_path( std::filesystem::path const &base, uint32_t id )
+{
+    std::array<char, 9> hex;
+    snprintf( hex.data(), hex.size(), "%08x", id );
+    return base.parent_path() / std::filesystem::u8path( base.stem().generic_u8string() + "." +
+            hex.data() + ".dict" );
+}
+
+std::filesystem::path current_trained_dictionary_path( std::filesystem::path const &base )
+{
+    return base.parent_path() / std::filesystem::u8path( base.stem().generic_u8string() +
+            ".trained" );
+}
+
+struct cached_trained_dictionary {
+    std::filesystem::file_time_type mtime;
+    uint32_t id = 0;
+};
+thread_local std::unordered_map<std::string, cached_trained_dictionary> cached_trained_dictionaries;
+
+// Id of the dictionary trained for the given base dictionary, or 0 if there is none.
+uint32_t current_trained_dictionary( std::filesystem::path const &base )
+{
+    if( base.empty() ) {
+        return 0;
+    }
+    std::string key = base.generic_u8string();
+    std::error_code ec;
+    const std::filesystem::path pointer = current_trained_dictionary_path( base );
+    std::filesystem::file_time_type mtime = std::filesystem::last_write_time( pointer, ec );
+    if( ec ) {
+        cached_trained_dictionaries.erase( key );
+        return 0;
+    }
+    if( auto it = cached_trained_dictionaries.find( key ); it != cached_trained_dictionaries.end() &&
+        it->second.mtime == mtime ) {
+        return it->second.id;
+    }
+    uint32_t id = 0;
+    std::ifstream fin( pointer );
+    fin >> std::hex >> id;
+    if( !fin ) {
+        id = 0;
+    }
+    cached_trained_dictionaries[key] = cached_trained_dictionary{ mtime, id };
+    return id;
+}
+
+// Builds raw dictionary content out of the most widely shared stretches of the samples.
+// This is a much simplified take on zstd's COVER trainer, which we don't vendor.
+std::string build_raw_dictionary( std::vector<std::string> const &samples, size_t dictionary_size )
+{
+    constexpr size_t dmer_len = 8;
+    constexpr size_t segment_len = 256;
+    const auto dmer_hash = []( const char *p ) {
+        return XXH64( p, dmer_len, 0 );
+    };
+
+    // How many samples each dmer shows up in.
+    std::unordered_map<uint64_t, int> frequency;
+    for( const std::string &sample : samples ) {
+        std::unordered_set<uint64_t> seen;
+        for( size_t i = 0; i + dmer_len <= sample.size(); ++i ) {
+            if( seen.insert( dmer_hash( sample.data() + i ) ).second ) {
+                frequency[dmer_hash( sample.data() + i )]++;
+            }
+        }
+    }
+
+    struct segment {
+        const std::string *sample;
+        size_t offset;
+        int64_t score;
+    };
+    std::vector<segment> segments;
+    for( const std::string &sample : samples ) {
+        for( size_t offset = 0; offset + segment_len <= sample.size(); offset += segment_len ) {
+            int64_t score = 0;
+            for( size_t i = offset; i + dmer_len <= offset + segment_len; ++i ) {
+                // Stretches only one sample has are worthless to the others.
+                score += frequency[dmer_hash( sample.data() + i )] - 1;
+            }
+            if( score > 0 ) {
+                segments.push_back( segment{ &sample, offset, score } );
+            }
+        }
+    }
+    std::stable_sort( segments.begin(), segments.end(), []( const segment & a, const segment & b ) {
+        return a.score > b.score;
+    } );
+
+    std::vector<const segment *> picked;
+    std::unordered_set<uint64_t> picked_hashes;
+    size_t picked_size = 0;
+    for( const segment &seg : segments ) {
+        if( picked_size + segment_len > dictionary_size ) {
+            break;
+        }
+        if( picked_hashes.insert( XXH64( seg.sample->data() + seg.offset, segment_len, 0 ) ).second ) {
+            picked.push_back( &seg );
+            picked_size += segment_len;
+        }
+    }
+    // zstd finds the end of a raw dictionary cheapest, so the best stretches go last.
+    std::string dictionary;
+    dictionary.reserve( picked_size );
+    for( auto it = picked.rbegin(); it != picked.rend(); ++it ) {
+        dictionary.append( ( *it )->sample->data() + ( *it )->offset, segment_len );
+    }
+    return dictionary;
+}
+
+bool write_file_atomically( std::filesystem::path const &path, std::string_view content )
+{
+    std::filesystem::path tmp_path = path;
+    tmp_path.concat( ".tmp" ); // NOLINT(cata-u8-path)
+    {
+        std::ofstream fout( tmp_path, std::ios::binary | std::ios::trunc );
+        fout.write( content.data(), content.size() );
+        if( !fout ) {
+            return false;
+        }
+    }
+    return rename_file( tmp_path, path );
+}
 
 } // namespace
 
@@ -149,14 +309,23 @@ namespace
 
 constexpr unsigned int kEntryFileNameMagic = 0;
 constexpr unsigned int kEntryChecksumMagic = 1;
+constexpr unsigned int kEntryDictionaryMagic = 2;
 constexpr unsigned int kFooterChecksumMagic = 15;
 
 constexpr size_t kFooterChecksumContentSize = 2 * sizeof( uint64_t );
 constexpr size_t kFooterChecksumFrameSize = ZSTD_SKIPPABLEHEADERSIZE + kFooterChecksumContentSize;
 constexpr size_t kEntryChecksumFrameSize = ZSTD_SKIPPABLEHEADERSIZE + sizeof( uint64_t );
+constexpr size_t kEntryDictionaryFrameSize = ZSTD_SKIPPABLEHEADERSIZE + sizeof( uint32_t );
+
+constexpr size_t kTrainedDictionarySize = 64 * 1024;
+// Training needs a good deal more sample data than the dictionary it makes.
+constexpr size_t kMinTrainingSampleSize = 4 * kTrainedDictionarySize;
+constexpr size_t kMaxTrainingSampleSize = 32 * kTrainedDictionarySize;
 constexpr size_t kDefaultFooterSize = 1024;
 
 constexpr size_t kFixedSizeOverhead = kFooterChecksumFrameSize + kDefaultFooterSize;
+// Below this much content in one zzip::add_files call, compressing on the pool costs more than it saves.
+constexpr size_t kParallelCompressionThreshold = 256 * 1024;
 
 constexpr uint64_t kCheckumSeed = 0x1337C0DE;
 constexpr uint64_t kDeletedChecksumTombstone = 0xDE1337ED;
@@ -168,6 +337,8 @@ constexpr const std::string_view kEntryLenKey = "len";
 constexpr const std::string_view kMetaKey = "meta";
 constexpr const std::string_view kMetaContentEndKey = "content_end";
 constexpr const std::string_view kMetaTotalContentSizeKey = "total_content_size";
+// Id of the trained dictionary new entries are written with, 0 for the base dictionary.
+constexpr const std::string_view kMetaDictionaryKey = "dictionary";
 
 constexpr size_t kAssumedPageSize = 4 * 1024;
 
@@ -292,7 +463,8 @@ std::pair<void *, size_t> read_and_skip_entry_metadata(
     void *entry_base,
     size_t entry_len,
     std::optional<std::string> *filename_out = nullptr,
-    std::optional<uint64_t> *checksum_out = nullptr )
+    std::optional<uint64_t> *checksum_out = nullptr,
+    std::optional<uint32_t> *dictionary_out = nullptr )
 {
     char *base = static_cast<char *>( entry_base );
     while( entry_len > 0 && ZSTD_isSkippableFrame( base, entry_len ) ) {
@@ -315,6 +487,14 @@ std::pair<void *, size_t> read_and_skip_entry_metadata(
                 }
                 checksum_out->emplace( MEM_readLE64( &checksum ) );
             }
+            if( dictionary_out && header.dictID == kEntryDictionaryMagic ) {
+                uint32_t dictionary;
+                size_t ec = ZSTD_readSkippableFrame( &dictionary, sizeof( dictionary ), nullptr, base, entry_len );
+                if( ZSTD_isError( ec ) || ec != sizeof( uint32_t ) ) {
+                    return { nullptr, 0 };
+                }
+                dictionary_out->emplace( MEM_readLE32( &dictionary ) );
+            }
         } else {
             return { nullptr, 0 };
         }
@@ -329,14 +509,49 @@ std::pair<void *, size_t> read_and_skip_entry_metadata(
     return { base, entry_len };
 }
 
+// zstd stores a block as-is when compressing doesn't make it smaller. If the entry's frame
+// is a single such block, returns a view of the content in place, otherwise std::nullopt.
+std::optional<std::string_view> stored_frame_content( const void *frame_base, size_t frame_len )
+{
+    constexpr size_t kBlockHeaderSize = 3;
+    constexpr size_t kFrameChecksumSize = 4;
+    constexpr uint32_t kBlockTypeRaw = 0;
+
+    ZSTD_FrameHeader header;
+    if( ZSTD_getFrameHeader( &header, frame_base, frame_len ) != 0 ||
+        header.frameType != ZSTD_frame ||
+        frame_len < header.headerSize + kBlockHeaderSize ) {
+        return std::nullopt;
+    }
+    const char *block = static_cast<const char *>( frame_base ) + header.headerSize;
+    const uint32_t block_header = MEM_readLE24( block );
+    const bool last_block = ( block_header & 1 ) != 0;
+    const uint32_t block_type = ( block_header >> 1 ) & 3;
+    const size_t block_size = block_header >> 3;
+    const size_t frame_end = header.headerSize + kBlockHeaderSize + block_size +
+                             ( header.checksumFlag ? kFrameChecksumSize : 0 );
+    if( !last_block || block_type != kBlockTypeRaw || frame_end != frame_len ||
+        ( header.frameContentSize != ZSTD_CONTENTSIZE_UNKNOWN &&
+          header.frameContentSize != block_size ) ) {
+        return std::nullopt;
+    }
+    return std::string_view{ block + kBlockHeaderSize, block_size };
+}
+
 } // namespace
 
 struct zzip::context {
-    context( ZSTD_CCtx *cctx, ZSTD_DCtx *dctx )
-        : cctx{ cctx }, dctx{ dctx }
+    context( ZSTD_CCtx *cctx, ZSTD_DCtx *dctx, uint32_t dictionary_id,
+             std::filesystem::path dictionary_path )
+        : cctx{ cctx }, dctx{ dctx }, dictionary_id{ dictionary_id },
+          dictionary_path{ std::move( dictionary_path ) }
     {}
+    // Compresses with the current trained dictionary, if there is one.
     ZSTD_CCtx *cctx;
+    // Decompresses entries written with the base dictionary.
     ZSTD_DCtx *dctx;
+    uint32_t dictionary_id;
+    std::filesystem::path dictionary_path;
 };
 
 zzip::zzip( std::shared_ptr<mmap_file> file, JsonObject footer )
@@ -406,27 +621,19 @@ std::optional<zzip> zzip::load(
     std::optional<zzip> ret{ std::in_place, zzip{std::move( file ), std::move( footer )} };
     zzip &zip = ret.value();
 
-    ZSTD_CCtx *cctx;
-    ZSTD_DCtx *dctx;
-    if( auto it = cached_contexts.find( dictionary_path.generic_u8string() );
-        it != cached_contexts.end() ) {
-        cctx = it->second.cctx;
-        dctx = it->second.dctx;
-    } else {
-        cctx = ZSTD_createCCtx();
-        ZSTD_CCtx_setParameter( cctx, ZSTD_c_compressionLevel, 7 );
-        dctx = ZSTD_createDCtx();
-
-        std::vector<char> dictionary;
-        if( !dictionary_path.empty() ) {
-            std::shared_ptr<const mmap_file> dictionary_file = mmap_file::map_file( dictionary_path );
-            dictionary.resize( dictionary_file->len() );
-            memcpy( dictionary.data(), dictionary_file->base(), dictionary_file->len() );
-            ZSTD_CCtx_loadDictionary_byReference( cctx, dictionary.data(), dictionary.size() );
-            ZSTD_DCtx_loadDictionary_byReference( dctx, dictionary.data(), dictionary.size() );
+    cached_zstd_context *base = get_cached_context( dictionary_path );
+    if( !base ) {
+        ret.reset();
+        return ret;
+    }
+    cached_zstd_context *compress_with = base;
+    uint32_t dictionary_id = current_trained_dictionary( dictionary_path );
+    if( dictionary_id != 0 ) {
+        compress_with = get_cached_context( trained_dictionary_path( dictionary_path, dictionary_id ) );
+        if( !compress_with ) {
+            compress_with = base;
+            dictionary_id = 0;
         }
-
-        cached_contexts.emplace( dictionary_path.generic_u8string(), cached_zstd_context{ std::move( dictionary ), cctx, dctx } );
     }
 
     if( needs_footer && !zip.rewrite_footer() ) {
@@ -434,7 +641,8 @@ std::optional<zzip> zzip::load(
         return ret;
     }
 
-    zip.ctx_ = std::make_unique<zzip::context>( cctx, dctx );
+    zip.ctx_ = std::make_unique<zzip::context>( compress_with->cctx, base->dctx, dictionary_id,
+               dictionary_path );
     return ret;
 }
 
@@ -457,6 +665,7 @@ bool zzip::add_file( std::filesystem::path const &zzip_relative_path, std::strin
     if( !ensure_capacity_for(
             old_content_end +
             ZSTD_SKIPPABLEHEADERSIZE + relative_path_string.length() +
+            kEntryDictionaryFrameSize +
             kEntryChecksumFrameSize +
             estimated_size +
             kFixedSizeOverhead ) ) {
@@ -483,7 +692,6 @@ bool zzip::add_file( std::filesystem::path const &zzip_relative_path, std::strin
     return true;
 }
 
-
 bool zzip::copy_files( std::vector<std::filesystem::path> const &zzip_relative_paths,
                        zzip const &from, bool shrink_to_fit )
 {
@@ -568,18 +776,18 @@ std::vector<std::byte> zzip::get_file( std::filesystem::path const &zzip_relativ
     return buf;
 }
 
-size_t zzip::get_file_to( std::filesystem::path const &zzip_relative_path, std::byte *dest,
-                          size_t dest_len ) const
+std::pair<void *, size_t> zzip::checked_entry_frame(
+    std::filesystem::path const &zzip_relative_path, std::optional<uint32_t> *dictionary_out ) const
 {
     zzip_footer footer{ footer_ };
     std::optional<zzip_file_entry> fparams = footer.get_entry( zzip_relative_path );
     if( !fparams.has_value() ) {
-        return 0;
+        return { nullptr, 0 };
     }
     size_t file_len = fparams->len;
     void *file_base = file_base_plus( fparams->offset );
     if( file_len > file_capacity_at( fparams->offset ) ) {
-        return 0;
+        return { nullptr, 0 };
     }
 
     std::optional<uint64_t> checksum_opt;
@@ -587,19 +795,110 @@ size_t zzip::get_file_to( std::filesystem::path const &zzip_relative_path, std::
                                           file_base,
                                           file_len,
                                           nullptr,
-                                          &checksum_opt );
+                                          &checksum_opt,
+                                          dictionary_out );
     if( !checksum_opt.has_value() ) {
-        return 0;
+        return { nullptr, 0 };
     }
     uint64_t checksum = XXH64( file_base, file_len, kCheckumSeed );
     if( checksum != *checksum_opt ) {
+        return { nullptr, 0 };
+    }
+    return { file_base, file_len };
+}
+
+std::optional<std::string_view> zzip::get_file_view(
+    std::filesystem::path const &zzip_relative_path ) const
+{
+    void *file_base;
+    size_t file_len;
+    std::tie( file_base, file_len ) = checked_entry_frame( zzip_relative_path, nullptr );
+    if( file_base == nullptr ) {
+        return std::nullopt;
+    }
+    return stored_frame_content( file_base, file_len );
+}
+
+std::string zzip::get_file_string( std::filesystem::path const &zzip_relative_path ) const
+{
+    // Checks the entry once, then either copies the stored content or decompresses the frame.
+    std::optional<uint32_t> dictionary_opt;
+    void *file_base;
+    size_t file_len;
+    std::tie( file_base, file_len ) = checked_entry_frame( zzip_relative_path, &dictionary_opt );
+    if( file_base == nullptr ) {
+        return {};
+    }
+    std::optional<std::string_view> view = stored_frame_content( file_base, file_len );
+    if( view.has_value() ) {
+        return std::string( *view );
+    }
+    return decompress_frame_to_string( file_base, file_len, dictionary_opt );
+}
+
+bool zzip::read_file( std::filesystem::path const &zzip_relative_path,
+                      const std::function<void( std::string_view )> &reader ) const
+{
+    std::optional<uint32_t> dictionary_opt;
+    void *file_base;
+    size_t file_len;
+    std::tie( file_base, file_len ) = checked_entry_frame( zzip_relative_path, &dictionary_opt );
+    if( file_base == nullptr ) {
+        return false;
+    }
+    if( std::optional<std::string_view> view = stored_frame_content( file_base, file_len ) ) {
+        reader( *view );
+        return true;
+    }
+    reader( decompress_frame_to_string( file_base, file_len, dictionary_opt ) );
+    return true;
+}
+
+std::string zzip::decompress_frame_to_string( const void *file_base, size_t file_len,
+        std::optional<uint32_t> dictionary ) const
+{
+    size_t size = ZSTD_decompressBound( file_base, file_len );
+    if( ZSTD_isError( size ) ) {
+        return {};
+    }
+    std::string buf;
+    buf.resize( size );
+    size_t final_size = decompress_frame( file_base, file_len, dictionary,
+                                          reinterpret_cast<std::byte *>( buf.data() ), size );
+    buf.resize( final_size );
+    return buf;
+}
+
+size_t zzip::get_file_to( std::filesystem::path const &zzip_relative_path, std::byte *dest,
+                          size_t dest_len ) const
+{
+    std::optional<uint32_t> dictionary_opt;
+    void *file_base;
+    size_t file_len;
+    std::tie( file_base, file_len ) = checked_entry_frame( zzip_relative_path, &dictionary_opt );
+    if( file_base == nullptr ) {
         return 0;
     }
+    return decompress_frame( file_base, file_len, dictionary_opt, dest, dest_len );
+}
+
+size_t zzip::decompress_frame( const void *file_base, size_t file_len,
+                               std::optional<uint32_t> dictionary, std::byte *dest, size_t dest_len ) const
+{
     unsigned long long file_size = ZSTD_decompressBound( file_base, file_len );
     if( dest_len < file_size ) {
         return 0;
     }
-    size_t actual = ZSTD_decompressDCtx( ctx_->dctx, dest, dest_len, file_base, file_len );
+    ZSTD_DCtx *dctx = ctx_->dctx;
+    if( dictionary.value_or( 0 ) != 0 ) {
+        cached_zstd_context *trained = get_cached_context(
+                                           trained_dictionary_path( ctx_->dictionary_path, *dictionary ) );
+        if( !trained ) {
+            return 0;
+        }
+        dctx = trained->dctx;
+    }
+    size_t actual = ZSTD_decompressDCtx( dctx, dest, dest_len, file_base, file_len );
     if( ZSTD_isError( actual ) ) {
         return 0;
     }
@@ -695,9 +994,12 @@ size_t zzip::ensure_capacity_for( size_t bytes )
     return new_size;
 }
 
-// Actually performs the compression and encoding of a file into the zzip.
-size_t zzip::write_file_at( std::string_view filename, std::string_view content, size_t offset,
-                            std::optional<uint64_t> force_checksum )
+namespace
+{
+// Compresses and encodes one entry into @p capacity bytes at @p dest.
+size_t encode_entry( ZSTD_CCtx *cctx, uint32_t dictionary_id, std::string_view filename,
+                     std::string_view content, char *dest, size_t capacity,
+                     std::optional<uint64_t> force_checksum )
 {
     // The format of a compressed entry is a series of zstd frames.
     // There are an unbounded number of leading skippable frames of unspecified content.
@@ -707,14 +1009,10 @@ size_t zzip::write_file_at( std::string_view filename, std::string_view content,
     //   - The actual compressed frame.
     // Returns the size of the entire file entry, or the return zstd error.
     // (i.e. from the start of the first skippable frame to the end of the compressed data).
-
-    if( file_->len() <= offset ) {
-        return 0;
-    }
-
+    size_t offset = 0;
     size_t header_size = ZSTD_writeSkippableFrame(
-                             file_base_plus( offset ),
-                             file_capacity_at( offset ),
+                             dest,
+                             capacity,
                              filename.data(),
                              filename.length(),
                              kEntryFileNameMagic
@@ -723,12 +1021,31 @@ size_t zzip::write_file_at( std::string_view filename, std::string_view content,
         return header_size;
     }
     offset += header_size;
+    if( dictionary_id != 0 ) {
+        uint32_t dictionary_le = 0;
+        MEM_writeLE32( &dictionary_le, dictionary_id );
+        size_t dictionary_size = ZSTD_writeSkippableFrame(
+                                     dest + offset,
+                                     capacity - offset,
+                                     reinterpret_cast<const char *>( &dictionary_le ),
+                                     sizeof( dictionary_le ),
+                                     kEntryDictionaryMagic
+                                 );
+        if( ZSTD_isError( dictionary_size ) ) {
+            return dictionary_size;
+        }
+        offset += dictionary_size;
+        header_size += dictionary_size;
+    }
     // Make room for the checksum frame before the file.
+    if( capacity < offset + kEntryChecksumFrameSize ) {
+        return static_cast<size_t>( -ZSTD_error_dstSize_tooSmall );
+    }
     offset += kEntryChecksumFrameSize;
     size_t file_size = ZSTD_compress2(
-                           ctx_->cctx,
-                           file_base_plus( offset ),
-                           file_capacity_at( offset ),
+                           cctx,
+                           dest + offset,
+                           capacity - offset,
                            content.data(),
                            content.size()
                        );
@@ -739,12 +1056,12 @@ size_t zzip::write_file_at( std::string_view filename, std::string_view content,
     if( force_checksum.has_value() ) {
         checksum = force_checksum.value();
     } else {
-        checksum = XXH64( file_base_plus( offset ), file_size, kCheckumSeed );
+        checksum = XXH64( dest + offset, file_size, kCheckumSeed );
     }
     uint64_t checksum_le = 0;
     MEM_writeLE64( &checksum_le, checksum );
     size_t checksum_size = ZSTD_writeSkippableFrame(
-                               file_base_plus( offset - kEntryChecksumFrameSize ),
+                               dest + offset - kEntryChecksumFrameSize,
                                kEntryChecksumFrameSize,
                                reinterpret_cast<const char *>( &checksum_le ),
                                sizeof( checksum_le ),
@@ -756,6 +1073,107 @@ size_t zzip::write_file_at( std::string_view filename, std::string_view content,
     return header_size + checksum_size + file_size;
 }
 
+size_t entry_bound( std::string_view filename, size_t content_size )
+{
+    return ZSTD_SKIPPABLEHEADERSIZE + filename.length() + kEntryDictionaryFrameSize +
+           kEntryChecksumFrameSize + ZSTD_compressBound( content_size );
+}
+} // namespace
+
+// Actually performs the compression and encoding of a file into the zzip.
+size_t zzip::write_file_at( std::string_view filename, std::string_view content, size_t offset,
+                            std::optional<uint64_t> force_checksum )
+{
+    if( file_->len() <= offset ) {
+        return 0;
+    }
+    return encode_entry( ctx_->cctx, ctx_->dictionary_id, filename, content,
+                         static_cast<char *>( file_base_plus( offset ) ), file_capacity_at( offset ),
+                         force_checksum );
+}
+
+bool zzip::add_files( std::vector<std::pair<std::filesystem::path, std::string_view>> const
+                      &files )
+{
+    // Only the last of entries with the same path would be kept, so only that one is written.
+    std::vector<const std::pair<std::filesystem::path, std::string_view> *> to_write;
+    std::unordered_set<std::string> seen;
+    for( auto it = files.rbegin(); it != files.rend(); ++it ) {
+        if( seen.insert( it->first.generic_u8string() ).second ) {
+            to_write.push_back( &*it );
+        }
+    }
+    std::reverse( to_write.begin(), to_write.end() );
+    if( to_write.empty() ) {
+        return true;
+    }
+
+    struct staged_entry {
+        std::string path;
+        std::vector<char> bytes;
+        size_t size = 0;
+    };
+    std::vector<staged_entry> staged( to_write.size() );
+    size_t total_content = 0;
+    for( size_t i = 0; i < to_write.size(); ++i ) {
+        staged[i].path = to_write[i]->first.generic_u8string();
+        total_content += to_write[i]->second.size();
+    }
+    // Pool threads have contexts of their own, zstd contexts can't be shared.
+    const std::filesystem::path compress_dictionary = ctx_->dictionary_id == 0 ?
+            ctx_->dictionary_path :
+            trained_dictionary_path( ctx_->dictionary_path, ctx_->dictionary_id );
+    const std::thread::id caller = std::this_thread::get_id();
+    const auto compress = [&]( int i ) {
+        staged_entry &entry = staged[i];
+        const std::string_view content = to_write[i]->second;
+        ZSTD_CCtx *cctx = ctx_->cctx;
+        if( std::this_thread::get_id() != caller ) {
+            cached_zstd_context *own = get_cached_context( compress_dictionary );
+            if( !own ) {
+                entry.size = static_cast<size_t>( -ZSTD_error_dictionary_wrong );
+                return;
+            }
+            cctx = own->cctx;
+        }
+        entry.bytes.resize( entry_bound( entry.path, content.size() ) );
+        entry.size = encode_entry( cctx, ctx_->dictionary_id, entry.path, content, entry.bytes.data(),
+                                   entry.bytes.size(), std::nullopt );
+    };
+    if( staged.size() > 1 && total_content >= kParallelCompressionThreshold ) {
+        cata::get_thread_pool().parallel_for( 0, static_cast<int>( staged.size() ), compress );
+    } else {
+        for( size_t i = 0; i < staged.size(); ++i ) {
+            compress( static_cast<int>( i ) );
+        }
+    }
+
+    // Appended in the order given, with one footer for all of them.
+    JsonObject footer_copy = copy_footer();
+    footer_copy.allow_omitted_members();
+    zzip_footer footer{ footer_copy };
+    std::optional<zzip_meta> meta_opt = footer.get_meta();
+    size_t content_end = meta_opt.has_value() ? meta_opt->content_end : 0;
+    size_t staged_size = 0;
+    for( const staged_entry &entry : staged ) {
+        if( ZSTD_isError( entry.size ) ) {
+            return false;
+        }
+        staged_size += entry.size;
+    }
+    if( !ensure_capacity_for( content_end + staged_size + kFixedSizeOverhead ) ) {
+        return false;
+    }
+    std::vector<compressed_entry> new_entries;
+    new_entries.reserve( staged.size() );
+    for( staged_entry &entry : staged ) {
+        memcpy( file_base_plus( content_end ), entry.bytes.data(), entry.size );
+        new_entries.emplace_back( compressed_entry{ std::move( entry.path ), content_end, entry.size } );
+        content_end += entry.size;
+    }
+    return update_footer( footer_copy, content_end, new_entries );
+}
+
 // Writes a new footer at the end of the zzip, copying old entries from the given
 // original JsonObject and inserting the given new entries.
 // If shrink_to_fit is true, will shrink the file as needed to eliminate padding bytes
@@ -803,6 +1221,7 @@ bool zzip::update_footer( JsonObject const &original_footer,
         size_t meta_start = builder.StartMap( kMetaKey.data() );
         builder.UInt( kMetaContentEndKey.data(), content_end );
         builder.UInt( kMetaTotalContentSizeKey.data(), total_content_size );
+        builder.UInt( kMetaDictionaryKey.data(), ctx_ ? ctx_->dictionary_id : 0 );
         builder.EndMap( meta_start );
     }
     builder.EndMap( root_start );
@@ -1112,6 +1531,7 @@ bool zzip::delete_files( std::unordered_set<std::filesystem::path, std_fs_path_h
             content_end +
             filename_lengths +
             zzip_relative_paths.size() * ( ZSTD_SKIPPABLEHEADERSIZE +
+                                           kEntryDictionaryFrameSize +
                                            kEntryChecksumFrameSize +
                                            empty_estimated_size ) +
             kFixedSizeOverhead ) ) {
@@ -1176,20 +1596,109 @@ bool zzip::compact_to( std::filesystem::path const &dest, double bloat_factor )
         return false;
     }
 
+    // The first compaction with enough content trains a dictionary for this kind of content,
+    // the copy below then recompresses everything with it.
+    if( ctx_->dictionary_id == 0 && !ctx_->dictionary_path.empty() ) {
+        train_dictionary();
+    }
+
     return compact_to( std::move( compacted_file ) );
 }
 
 bool zzip::compact_to( std::shared_ptr<mmap_file> const &dest ) const
 {
-    std::optional<zzip> new_zip = zzip::load( dest );
+    std::optional<zzip> new_zip = zzip::load( dest, ctx_->dictionary_path );
     if( !new_zip ) {
         return false;
     }
-    bool success = new_zip->copy_files( get_entries(), *this, /* shrink_to_fit = */ true );
+    // Entries written with the dictionary the copy uses are copied as they are,
+    // the rest are recompressed.
+    std::vector<std::filesystem::path> to_copy;
+    std::vector<std::filesystem::path> to_recompress;
+    for( const compressed_entry &entry : zzip_footer{ footer_ }.get_entries() ) {
+        std::optional<uint32_t> dictionary_opt;
+        read_and_skip_entry_metadata( file_base_plus( entry.offset ), entry.len, nullptr, nullptr,
+                                      &dictionary_opt );
+        std::filesystem::path path = std::filesystem::u8path( entry.path );
+        if( dictionary_opt.value_or( 0 ) == new_zip->ctx_->dictionary_id ) {
+            to_copy.emplace_back( std::move( path ) );
+        } else {
+            to_recompress.emplace_back( std::move( path ) );
+        }
+    }
+    bool success = new_zip->copy_files( to_copy, *this, /* shrink_to_fit = */ to_recompress.empty() );
+    for( const std::filesystem::path &path : to_recompress ) {
+        std::vector<std::byte> contents = get_file( path );
+        success = success && !contents.empty() && new_zip->add_file( path, std::string_view(
+                      reinterpret_cast<const char *>( contents.data() ), contents.size() ) );
+    }
+    if( success && !to_recompress.empty() ) {
+        JsonObject footer_copy = new_zip->copy_footer();
+        footer_copy.allow_omitted_members();
+        success = new_zip->update_footer( footer_copy, zzip_footer{ new_zip->footer_ }.get_meta().content_end,
+                                          {}, /* shrink_to_fit = */ true );
+    }
     dest->flush();
     return success;
 }
 
+bool zzip::train_dictionary()
+{
+    if( ctx_->dictionary_path.empty() ) {
+        return false;
+    }
+    std::vector<std::string> samples;
+    size_t sample_size = 0;
+    for( const compressed_entry &entry : zzip_footer{ footer_ }.get_entries() ) {
+        if( sample_size >= kMaxTrainingSampleSize ) {
+            break;
+        }
+        std::vector<std::byte> contents = get_file( std::filesystem::u8path( entry.path ) );
+        sample_size += contents.size();
+        samples.emplace_back( reinterpret_cast<const char *>( contents.data() ), contents.size() );
+    }
+    if( !train_dictionary( ctx_->dictionary_path, samples ) ) {
+        return false;
+    }
+    // Switch over to the new dictionary for anything written from now on.
+    const uint32_t dictionary_id = current_trained_dictionary( ctx_->dictionary_path );
+    cached_zstd_context *trained = get_cached_context( trained_dictionary_path(
+                                       ctx_->dictionary_path, dictionary_id ) );
+    if( !trained ) {
+        return false;
+    }
+    ctx_->cctx = trained->cctx;
+    ctx_->dictionary_id = dictionary_id;
+    return true;
+}
+
+bool zzip::train_dictionary( std::filesystem::path const &dictionary,
+                             std::vector<std::string> const &samples )
+{
+    size_t sample_size = 0;
+    for( const std::string &sample : samples ) {
+        sample_size += sample.size();
+    }
+    if( dictionary.empty() || sample_size < kMinTrainingSampleSize ) {
+        return false;
+    }
+    std::string content = build_raw_dictionary( samples, kTrainedDictionarySize );
+    if( content.empty() ) {
+        return false;
+    }
+    // Raw dictionaries carry no id of their own, so derive one. 0 means the base dictionary.
+    uint32_t dictionary_id = static_cast<uint32_t>( XXH64( content.data(), content.size(),
+                             kCheckumSeed ) );
+    if( dictionary_id == 0 ) {
+        dictionary_id = 1;
+    }
+    std::array<char, 9> hex;
+    snprintf( hex.data(), hex.size(), "%08x", dictionary_id );
+    // The dictionary has to be in place before anything can refer to it.
+    return write_file_atomically( trained_dictionary_path( dictionary, dictionary_id ), content ) &&
+           write_file_atomically( current_trained_dictionary_path( dictionary ), hex.data() );
+}
+
 bool zzip::clear()
 {
     return file_->resize_file( 0 ) && rewrite_footer( /* shrink_to_fit = */ true );
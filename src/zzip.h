@@ -6,10 +6,13 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "flexbuffer_json.h"
@@ -87,9 +90,17 @@ class zzip
          */
         bool add_file( std::filesystem::path const &zzip_relative_path, std::string_view content );
 
+        /**
+         * Writes all the given files as above, with one footer update for the lot. Entries are
+         * compressed on the shared thread pool when there is enough content to be worth it, and
+         * appended in the given order. If a path is given more than once, the last one is kept.
+         * Returns true on success, false on any error, in which case nothing was added.
+         */
+        bool add_files( std::vector<std::pair<std::filesystem::path, std::string_view>> const &files );
+
         /**
          * Directly copies compressed entries from one zzip to another, keeping the same path.
-         * If `from` was not opened with the same dictionary, the copied files may not be readable.
+         * If `from` was not opened with the same base dictionary, the copied files may not be readable.
          */
         bool copy_files( std::vector<std::filesystem::path> const &zzip_relative_paths,
                          zzip const &from, bool shrink_to_fit = false );
@@ -143,6 +154,29 @@ class zzip
                             std::byte *dest,
                             size_t dest_len ) const;
 
+        /**
+         * Returns a view of the given file straight into the mapped zzip, with no decompression
+         * or copy, if it is stored uncompressed. zstd stores content that way when it can't make
+         * it smaller. Returns std::nullopt if the file does not exist, is corrupt, or is
+         * compressed. The view is only valid until the zzip is next written to.
+         */
+        std::optional<std::string_view> get_file_view( std::filesystem::path const &zzip_relative_path )
+        const;
+
+        /**
+         * Extracts the given file into a fresh std::string, ready to be handed to the json loader
+         * without another copy. Returns an empty string if it does not exist.
+         */
+        std::string get_file_string( std::filesystem::path const &zzip_relative_path ) const;
+
+        /**
+         * Checks the given file once and hands its content to reader: in place if it is stored
+         * uncompressed, see get_file_view, otherwise decompressed into a temporary buffer.
+         * Returns false without calling reader if the file does not exist or is corrupt.
+         */
+        bool read_file( std::filesystem::path const &zzip_relative_path,
+                        const std::function<void( std::string_view )> &reader ) const;
+
         /**
          * Removes the files from the zzip.
          * Under the hood, this just removes the file entry from the footer. The last
@@ -167,6 +201,23 @@ class zzip
          */
         bool compact_to( std::shared_ptr<mmap_file> const &dest ) const;
 
+        /**
+         * Trains a dictionary from samples of this kind of content, to be used instead of the
+         * base @p dictionary (the one passed to zzip::load) for entries written from now on.
+         * Entries written with earlier dictionaries stay readable as long as their files,
+         * kept next to the base dictionary, are.
+         * Returns false if there isn't enough sample data or the dictionary can't be written.
+         */
+        static bool train_dictionary( std::filesystem::path const &dictionary,
+                                      std::vector<std::string> const &samples );
+
+        /**
+         * Trains a dictionary as above from this zzip's own entries, and uses it for anything
+         * written to this zzip from now on. The first compaction of a zzip with a base
+         * dictionary does this on its own.
+         */
+        bool train_dictionary();
+
         /**
          * Removes all contents and resets to a default initialized empty zzip.
          * Returns true on success, false on error.
@@ -214,6 +265,16 @@ class zzip
 
     private:
         JsonObject copy_footer() const;
+        // Locates the zstd frame of an entry after checking it against its checksum.
+        // Returns { nullptr, 0 } if the entry is missing or corrupt.
+        std::pair<void *, size_t> checked_entry_frame( std::filesystem::path const &zzip_relative_path,
+                std::optional<uint32_t> *dictionary_out ) const;
+        // Decompresses a frame found by checked_entry_frame into dest. Returns 0 on error.
+        size_t decompress_frame( const void *file_base, size_t file_len,
+                                 std::optional<uint32_t> dictionary, std::byte *dest, size_t dest_len ) const;
+        // Decompresses a frame found by checked_entry_frame into a fresh string. Empty on error.
+        std::string decompress_frame_to_string( const void *file_base, size_t file_len,
+                                                std::optional<uint32_t> dictionary ) const;
         size_t ensure_capacity_for( size_t bytes );
         size_t write_file_at( std::string_view filename, std::string_view content, size_t offset,
                               std::optional<uint64_t> force_checksum = std::nullopt );
@@ -105,6 +105,35 @@ size_t zzip_stack::get_file_to( std::filesystem::path const &zzip_relative_path,
     return zzip_of_temp( temp ).get_file_to( zzip_relative_path, dest, dest_len );
 }
 
+std::optional<std::string_view> zzip_stack::get_file_view( std::filesystem::path const
+        &zzip_relative_path ) const
+{
+    file_temp temp = temp_of_file( zzip_relative_path );
+    if( temp == file_temp::unknown ) {
+        return std::nullopt;
+    }
+    return zzip_of_temp( temp ).get_file_view( zzip_relative_path );
+}
+
+std::string zzip_stack::get_file_string( std::filesystem::path const &zzip_relative_path ) const
+{
+    file_temp temp = temp_of_file( zzip_relative_path );
+    if( temp == file_temp::unknown ) {
+        return std::string{};
+    }
+    return zzip_of_temp( temp ).get_file_string( zzip_relative_path );
+}
+
+bool zzip_stack::read_file( std::filesystem::path const &zzip_relative_path,
+                            const std::function<void( std::string_view )> &reader ) const
+{
+    file_temp temp = temp_of_file( zzip_relative_path );
+    if( temp == file_temp::unknown ) {
+        return false;
+    }
+    return zzip_of_temp( temp ).read_file( zzip_relative_path, reader );
+}
+
 std::shared_ptr<zzip_stack> zzip_stack::create_from_folder( std::filesystem::path const &path,
         std::filesystem::path const &folder,
         std::filesystem::path const &dictionary )
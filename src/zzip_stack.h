@@ -6,8 +6,10 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
@@ -87,6 +89,23 @@ class zzip_stack
                             std::byte *dest,
                             size_t dest_len ) const;
 
+        /**
+         * See zzip::get_file_view.
+         */
+        std::optional<std::string_view> get_file_view( std::filesystem::path const &zzip_relative_path )
+        const;
+
+        /**
+         * See zzip::get_file_string.
+         */
+        std::string get_file_string( std::filesystem::path const &zzip_relative_path ) const;
+
+        /**
+         * See zzip::read_file.
+         */
+        bool read_file( std::filesystem::path const &zzip_relative_path,
+                        const std::function<void( std::string_view )> &reader ) const;
+
         /**
          * Removes the files from the zzip.
          * Under the hood, this just removes the file entry from the footer. The last
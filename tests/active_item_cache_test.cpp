@@ -1,8 +1,11 @@
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "cata_catch.h"
 #include "coordinates.h"
+#include "enums.h"
 #include "item.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -10,6 +13,7 @@
 #include "point.h"
 #include "type_id.h"
 
+static const itype_id itype_apple( "apple" );
 static const itype_id itype_firecracker_act( "firecracker_act" );
 
 TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
@@ -44,3 +48,29 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "settled_food_sleeps_until_its_next_temperature_check", "[item]" )
+{
+    clear_map_without_vision();
+    map &here = get_map();
+    const tripoint_bub_ms spot( 30, 30, 0 );
+    item apple( itype_apple, calendar::turn );
+    REQUIRE( apple.active );
+    // The first pass gives it a temperature and finds that it has no tags to process.
+    CHECK( apple.processing_wake() == calendar::turn );
+    apple.process( here, nullptr, spot, 1.0f, temperature_flag::NORMAL, 1.0f, false, false );
+    CHECK( apple.processing_wake() == calendar::turn + 10_minutes );
+
+    active_item_cache cache;
+    cache.add( apple, point_sm_ms( spot.x() % SEEX, spot.y() % SEEY ) );
+    CHECK( cache.get_for_processing().empty() );
+    CHECK_FALSE( cache.empty() );
+    CHECK( cache.get().size() == 1 );
+
+    calendar::turn += 9_minutes;
+    CHECK( cache.get_for_processing().empty() );
+    calendar::turn += 1_minutes;
+    const std::vector<item_reference> due = cache.get_for_processing();
+    REQUIRE( due.size() == 1 );
+    CHECK( due.front().item_ref.get() == &apple );
+}
@@ -0,0 +1,66 @@
+#include "benchmark_helpers.h"
+
+#include <fstream>
+
+#include "cata_path.h"
+#include "coordinates.h"
+#include "filesystem.h"
+#include "flexbuffer_json.h"
+#include "json_loader.h"
+#include "map.h"
+#include "path_info.h"
+#include "point.h"
+
+uintmax_t peak_rss_kib()
+{
+#if defined(__linux__)
+    std::ifstream in( "/proc/self/status" );
+    for( std::string line; std::getline( in, line ); ) {
+        //NOLINTNEXTLINE(cata-text-style)
+        if( line.compare( 0, 7, "VmHWM:\t" ) == 0 ) {
+            return std::stoull( line.substr( 7 ) );
+        }
+    }
+#endif
+    return 0;
+}
+
+void reset_peak_rss()
+{
+#if defined(__linux__)
+    // Resets the peak to the current resident set size, see proc(5).
+    std::ofstream( "/proc/self/clear_refs" ) << "5";
+#endif
+}
+
+bool find_benchmark_budget( const std::string &file, const std::string &name, JsonObject &budget )
+{
+    const cata_path budget_path = PATH_INFO::base_path() / "tests" / "data" / file;
+    if( !file_exist( budget_path ) ) {
+        return false;
+    }
+    JsonObject budgets = json_loader::from_path( budget_path );
+    budgets.allow_omitted_members();
+    if( !budgets.has_object( name ) ) {
+        return false;
+    }
+    budget = budgets.get_object( name );
+    budget.allow_omitted_members();
+    return true;
+}
+
+tripoint_abs_omt fixture_origin()
+{
+    return project_to<coords::omt>( get_map().get_abs_sub() ) + point( MAPSIZE, MAPSIZE );
+}
+
+void load_fixture( int omts )
+{
+    const tripoint_abs_omt origin = fixture_origin();
+    for( int y = 0; y < omts; ++y ) {
+        for( int x = 0; x < omts; ++x ) {
+            tinymap tm;
+            tm.load( origin + point( x, y ), false );
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef CATA_TESTS_BENCHMARK_HELPERS_H
+#define CATA_TESTS_BENCHMARK_HELPERS_H
+
+#include <cstdint>
+#include <string>
+
+#include "coords_fwd.h"
+
+class JsonObject;
+
+// Peak resident set size in KiB since the last reset_peak_rss(), or 0 if we can't tell.
+uintmax_t peak_rss_kib();
+void reset_peak_rss();
+
+// Looks up the budget for @p name in tests/data/<file>, false if there is none.
+bool find_benchmark_budget( const std::string &file, const std::string &name, JsonObject &budget );
+
+// South east corner of the benchmark fixture, just outside the reality bubble so the map buffer
+// can drop and reload it.
+tripoint_abs_omt fixture_origin();
+// Loads the @p omts by @p omts square of fixture, generating whatever of it isn't on disk yet.
+void load_fixture( int omts );
+
+#endif // CATA_TESTS_BENCHMARK_HELPERS_H
@@ -411,6 +411,19 @@ TEST_CASE( "lcmatch", "[utility][nogame]" )
     CHECK( lcmatch( "無効", "無效" ) == false );
 }
 
+TEST_CASE( "lcmatch_prepared_key_agrees_with_lcmatch", "[utility][nogame]" )
+{
+    const std::vector<std::string> subjects = { "Bo", "Bö", "BŌ", "«101 борцовский приём»", "無効" };
+    const std::vector<std::string> queries = { "", "bo", "bö", "bō", "co", "прИ", "прб", "無", "無效" };
+    for( const std::string &subject : subjects ) {
+        const lcmatch_key key = lcmatch_prepare( subject );
+        for( const std::string &query : queries ) {
+            CAPTURE( subject, query );
+            CHECK( lcmatch( key, lcmatch_query( query ) ) == lcmatch( subject, query ) );
+        }
+    }
+}
+
 TEST_CASE( "obscure_message", "[utility][nogame]" )
 {
     SECTION( "narrow fixed" ) {
@@ -2497,3 +2497,154 @@ TEST_CASE( "basecamp_smart_zoning_stays_non_destructive_when_bed_is_already_zone
     CHECK( find_zone_at( zone_type_SOURCE_FIREWOOD, fixture.fire_anchor ) == nullptr );
 }
 
+
+TEST_CASE( "zone_lookups_follow_zone_order_and_edits", "[zones]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    zone_manager &zm = zone_manager::get_manager();
+    zm.clear();
+
+    map &here = get_map();
+    const tripoint_abs_ms origin = here.get_abs( get_avatar().pos_bub() );
+    // Spans a submap border so it lands in several buckets.
+    const tripoint_abs_ms far_corner = origin + tripoint( SEEX + 2, SEEY + 2, 0 );
+    zm.add( "Food", zone_type_LOOT_FOOD, faction_your_followers, false, true, origin, far_corner );
+    create_tile_zone( "Drink", zone_type_LOOT_DRINK, far_corner );
+
+    CHECK( zm.get_zone_at( far_corner, zone_type_LOOT_FOOD ) != nullptr );
+    CHECK( zm.get_zone_at( far_corner, true )->get_type() == zone_type_LOOT_DRINK );
+    CHECK( zm.get_zones_at( origin + tripoint( -1, 0, 0 ), zone_type_LOOT_FOOD ).empty() );
+
+    const tripoint_abs_ms outside = far_corner + tripoint( 3, 1, 0 );
+    CHECK( zm.has_near( zone_type_LOOT_FOOD, outside, 3 ) );
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_FOOD, outside, 2 ) );
+    CHECK( zm.get_nearest( zone_type_LOOT_FOOD, outside, 5 ) ==
+           std::optional<tripoint_abs_ms>( far_corner ) );
+
+    std::vector<zone_manager::ref_zone_data> zones = zm.get_zones();
+    REQUIRE( zones.size() == 2 );
+    zm.swap( zones[0].get(), zones[1].get() );
+    CHECK( zm.get_zone_at( far_corner, true )->get_type() == zone_type_LOOT_FOOD );
+
+    zones = zm.get_zones();
+    REQUIRE( zm.remove( zones[0].get() ) );
+    CHECK( zm.get_zone_at( far_corner, zone_type_LOOT_DRINK ) == nullptr );
+    CHECK( zm.get_zone_at( far_corner, zone_type_LOOT_FOOD ) != nullptr );
+
+    zm.clear();
+}
+
+TEST_CASE( "zone_cache_updates_per_edit_and_per_batch", "[zones]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    zone_manager &zm = zone_manager::get_manager();
+    zm.clear();
+
+    map &here = get_map();
+    const tripoint_abs_ms first = here.get_abs( get_avatar().pos_bub() ) + tripoint::east;
+    const tripoint_abs_ms second = first + tripoint::east;
+    create_tile_zone( "Food", zone_type_LOOT_FOOD, first );
+    create_tile_zone( "More food", zone_type_LOOT_FOOD, first );
+    CHECK( zm.has( zone_type_LOOT_FOOD, first ) );
+
+    SECTION( "removing one of two overlapping zones keeps the tile cached" ) {
+        REQUIRE( zm.remove( zm.get_zones()[0].get() ) );
+        CHECK( zm.has( zone_type_LOOT_FOOD, first ) );
+        REQUIRE( zm.remove( zm.get_zones()[0].get() ) );
+        CHECK_FALSE( zm.has( zone_type_LOOT_FOOD, first ) );
+    }
+
+    SECTION( "moving a zone recaches its type" ) {
+        zm.get_zones()[0].get().set_position( std::make_pair( second, second ) );
+        CHECK( zm.has( zone_type_LOOT_FOOD, first ) );
+        CHECK( zm.has( zone_type_LOOT_FOOD, second ) );
+    }
+
+    SECTION( "a batch holds the point caches back until it closes" ) {
+        {
+            zone_manager::batch_edit batch( zm );
+            create_tile_zone( "Drink", zone_type_LOOT_DRINK, second );
+            CHECK_FALSE( zm.has( zone_type_LOOT_DRINK, second ) );
+            CHECK( zm.get_zone_at( second, zone_type_LOOT_DRINK ) != nullptr );
+        }
+        CHECK( zm.has( zone_type_LOOT_DRINK, second ) );
+    }
+
+    zm.clear();
+}
+
+TEST_CASE( "zone_sorting_plan_chains_trips_from_the_last_dropoff", "[zones][items][activities]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    zone_manager &zm = zone_manager::get_manager();
+    zm.clear();
+
+    map &here = get_map();
+    const tripoint_bub_ms start = get_avatar().pos_bub();
+    const tripoint_abs_ms near_src = here.get_abs( start + tripoint( 2, 0, 0 ) );
+    const tripoint_abs_ms far_src = here.get_abs( start + tripoint( 4, 0, 0 ) );
+    const tripoint_abs_ms behind_src = here.get_abs( start + tripoint( -3, 0, 0 ) );
+    const tripoint_abs_ms empty_src = here.get_abs( start + tripoint( 0, 2, 0 ) );
+    for( const tripoint_abs_ms &src : { near_src, far_src, behind_src, empty_src } ) {
+        create_tile_zone( "Unsorted", zone_type_LOOT_UNSORTED, src );
+    }
+    create_tile_zone( "Food", zone_type_LOOT_FOOD, here.get_abs( start + tripoint( 6, 0, 0 ) ) );
+    for( const tripoint_abs_ms &src : { near_src, far_src, behind_src } ) {
+        here.add_item_or_charges( here.get_bub( src ), item( itype_test_bitter_almond ) );
+    }
+
+    const std::vector<zone_sorting::sort_trip> plan = zone_sorting::plan_sort_trips(
+                get_avatar(), { empty_src, behind_src, far_src, near_src }, {} );
+    REQUIRE( plan.size() == 3 );
+    // Nearest first, then whatever is nearest to the food zone it dropped off at.
+    CHECK( plan[0].src == near_src );
+    CHECK( plan[1].src == far_src );
+    CHECK( plan[2].src == behind_src );
+    for( const zone_sorting::sort_trip &trip : plan ) {
+        CHECK( trip.dest_types == std::vector<zone_type_id> { zone_type_LOOT_FOOD } );
+        CHECK( trip.loads == 1 );
+        CHECK( trip.est_moves > 0 );
+    }
+
+    zm.clear();
+}
+
+TEST_CASE( "zone_query_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    zone_manager &zm = zone_manager::get_manager();
+    zm.clear();
+
+    map &here = get_map();
+    const tripoint_abs_ms origin = here.get_abs( get_avatar().pos_bub() );
+    // A loot sorting setup: a big unsorted zone and a few dozen single tile destinations.
+    zm.add( "Unsorted", zone_type_LOOT_UNSORTED, faction_your_followers, false, true,
+            origin + tripoint( -10, -10, 0 ), origin + tripoint( -2, -2, 0 ) );
+    const std::array<zone_type_id, 4> dest_types = {
+        zone_type_LOOT_FOOD, zone_type_LOOT_DRINK, zone_type_LOOT_PFOOD, zone_type_LOOT_PDRINK
+    };
+    for( int i = 0; i < 40; ++i ) {
+        create_tile_zone( "Dest " + std::to_string( i ), dest_types[i % dest_types.size()],
+                          origin + tripoint( 2 + i % 10, 2 + i / 10, 0 ) );
+    }
+    const tripoint_abs_ms probe = origin + tripoint( 5, 3, 0 );
+
+    BENCHMARK( "has" ) {
+        return zm.has( zone_type_LOOT_FOOD, probe, faction_your_followers );
+    };
+    BENCHMARK( "has_near" ) {
+        return zm.has_near( zone_type_LOOT_PDRINK, origin, 60, faction_your_followers );
+    };
+    BENCHMARK( "get_near" ) {
+        return zm.get_near( zone_type_LOOT_FOOD, origin, 60, nullptr, faction_your_followers ).size();
+    };
+    BENCHMARK( "get_point_set_loot" ) {
+        return zm.get_point_set_loot( origin, 60, faction_your_followers ).size();
+    };
+
+    zm.clear();
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "creature.h"
+#include "creature_tracker.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "player_helpers.h"
+#include "point.h"
+
+TEST_CASE( "creature_tracker_finds_monsters_in_a_box", "[creature_tracker]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    map &here = get_map();
+    creature_tracker &creatures = get_creature_tracker();
+
+    monster &first = spawn_test_monster( "mon_zombie", { 30, 30, 0 } );
+    monster &second = spawn_test_monster( "mon_zombie", { 50, 30, 0 } );
+    monster &third = spawn_test_monster( "mon_zombie", { 31, 31, 0 } );
+    const tripoint_abs_ms center = here.get_abs( tripoint_bub_ms( 30, 30, 0 ) );
+
+    const auto monsters_near = [&]( int radius ) {
+        std::vector<Creature *> found;
+        for( Creature *critter : creatures.creatures_in_radius( center, radius ) ) {
+            if( critter->is_monster() ) {
+                found.push_back( critter );
+            }
+        }
+        return found;
+    };
+
+    // In the order they were added, like get_monsters_list
+    CHECK( monsters_near( 1 ) == std::vector<Creature *>( { &first, &third } ) );
+    CHECK( monsters_near( 20 ) == std::vector<Creature *>( { &first, &second, &third } ) );
+
+    SECTION( "moving keeps the order and the buckets" ) {
+        third.setpos( here, tripoint_bub_ms( 70, 30, 0 ) );
+        CHECK( monsters_near( 1 ) == std::vector<Creature *>( { &first } ) );
+        second.setpos( here, tripoint_bub_ms( 29, 29, 0 ) );
+        CHECK( monsters_near( 1 ) == std::vector<Creature *>( { &first, &second } ) );
+        creatures.swap_positions( first, third );
+        CHECK( monsters_near( 1 ) == std::vector<Creature *>( { &second, &third } ) );
+    }
+
+    SECTION( "dead and removed monsters drop out" ) {
+        first.set_hp( 0 );
+        CHECK( monsters_near( 1 ) == std::vector<Creature *>( { &third } ) );
+        creatures.remove( third );
+        CHECK( monsters_near( 1 ).empty() );
+    }
+
+    SECTION( "other levels are only found when asked for" ) {
+        monster &below = spawn_test_monster( "mon_zombie", { 30, 30, -1 } );
+        CHECK( monsters_near( 1 ) == std::vector<Creature *>( { &first, &third } ) );
+        std::vector<Creature *> found = creatures.creatures_in_radius( center, 1, 1 );
+        CHECK( std::find( found.begin(), found.end(), &below ) != found.end() );
+    }
+
+    SECTION( "map radius queries still list one creature per tile in tile order" ) {
+        const std::list<Creature *> listed = here.get_creatures_in_radius( { 30, 30, 0 }, 1 );
+        CHECK( listed == std::list<Creature *>( { &first, &third } ) );
+    }
+}
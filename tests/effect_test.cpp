@@ -628,6 +628,17 @@ TEST_CASE( "effect_modifiers", "[effect][modifier]" )
         CHECK( eff_intense.get_mod( "INT" ) == -2 );
         CHECK( eff_intense.get_mod( "PER" ) == -4 );
     }
+
+    // Processing skips the modifier lookups of effects without any.
+    SECTION( "effects without mods report none" ) {
+        CHECK( effect_debugged->has_mod_data() );
+        CHECK( effect_intensified->has_mod_data() );
+        CHECK_FALSE( effect_test_int_remove->has_mod_data() );
+        effect eff_remove( effect_source::empty(), &effect_test_int_remove.obj(), 1_turns,
+                           bodypart_str_id::NULL_ID(), false, 1, calendar::turn );
+        CHECK( eff_remove.get_mod( "HURT" ) == 0 );
+        CHECK( eff_remove.get_amount( "SPEED" ) == 0 );
+    }
 }
 
 TEST_CASE( "bleed_effect_attribution", "[effect][bleed][monster]" )
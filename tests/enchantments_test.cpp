@@ -1,5 +1,7 @@
 #include <cmath>
+#include <list>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "avatar.h"
@@ -127,6 +129,34 @@ TEST_CASE( "worn_enchantments", "[enchantments][worn][items]" )
 
 }
 
+TEST_CASE( "relic_enchantments_follow_where_the_relic_is", "[enchantments][worn][items]" )
+{
+    avatar p;
+    clear_character( p );
+    const int str_before = p.get_str();
+
+    // Carried but not worn, so it doesn't count.
+    item_location ring = p.i_add( item( itype_test_ring_strength_1 ) );
+    p.recalculate_enchantment_cache();
+    p.process_turn();
+    CHECK( p.get_str() == str_before );
+
+    // Found again after the ring moves.
+    std::optional<std::list<item>::iterator> worn_ring = p.wear( ring, false );
+    REQUIRE( worn_ring );
+    p.recalculate_enchantment_cache();
+    p.process_turn();
+    CHECK( p.get_str() == str_before + 1 );
+    p.recalculate_enchantment_cache();
+    p.process_turn();
+    CHECK( p.get_str() == str_before + 1 );
+
+    REQUIRE( p.takeoff( item_location( p, &**worn_ring ) ) );
+    p.recalculate_enchantment_cache();
+    p.process_turn();
+    CHECK( p.get_str() == str_before );
+}
+
 TEST_CASE( "bionic_enchantments", "[enchantments][bionics]" )
 {
     avatar p;
@@ -16,6 +16,7 @@
 #include "character_id.h"
 #include "character_martial_arts.h"
 #include "computer.h"
+#include "condition.h"
 #include "coordinates.h"
 #include "creature.h"
 #include "damage.h"
@@ -23,11 +24,14 @@
 #include "dialogue.h"
 #include "dialogue_helpers.h"
 #include "effect_on_condition.h"
+#include "event.h"
+#include "event_bus.h"
 #include "field_type.h"
 #include "game.h"
 #include "global_vars.h"
 #include "item.h"
 #include "item_location.h"
+#include "json_loader.h"
 #include "line.h"
 #include "magic.h"
 #include "map.h"
@@ -168,6 +172,8 @@ static const effect_on_condition_id effect_on_condition_EOC_teleport_test( "EOC_
 static const effect_on_condition_id
 effect_on_condition_EOC_test_weapon_damage( "EOC_test_weapon_damage" );
 static const effect_on_condition_id effect_on_condition_EOC_try_kill( "EOC_try_kill" );
+static const effect_on_condition_id
+effect_on_condition_EOC_wake_on_event_test( "EOC_wake_on_event_test" );
 static const effect_on_condition_id effect_on_condition_run_eocs_1( "run_eocs_1" );
 static const effect_on_condition_id effect_on_condition_run_eocs_2( "run_eocs_2" );
 static const effect_on_condition_id effect_on_condition_run_eocs_3( "run_eocs_3" );
@@ -1579,3 +1585,47 @@ TEST_CASE( "EOC_run_eocs", "[eoc]" )
     CHECK( std::isnan( globvars.get_global_value( "nan_val" ).dbl() ) );
     CHECK( globvars.get_global_value( "copied_val" ) == "BLORG" );
 }
+
+TEST_CASE( "EOC_wake_on_events", "[eoc]" )
+{
+    clear_avatar();
+    avatar &u = get_avatar();
+    global_variables &globvars = get_globals();
+    globvars.clear_global_values();
+    // Anything already due runs now, with the test EOC's condition still false
+    effect_on_conditions::process_effect_on_conditions( u );
+
+    effect_on_conditions::queue_effect_on_condition( 1_days, effect_on_condition_EOC_wake_on_event_test,
+            u, {} );
+    globvars.set_global_value( "wake_test_enabled", 1 );
+    effect_on_conditions::process_effect_on_conditions( u );
+    CHECK( !globvars.maybe_get_global_value( "wake_test_ran" ) );
+
+    get_event_bus().send<event_type::character_wakes_up>( u.getID() );
+    effect_on_conditions::process_effect_on_conditions( u );
+    CHECK( globvars.get_global_value( "wake_test_ran" ) == 1 );
+
+    globvars.clear_global_values();
+}
+
+TEST_CASE( "condition_and_or_not_trees", "[eoc]" )
+{
+    clear_avatar();
+    get_avatar().male = true;
+    dialogue d( get_talker_for( get_avatar() ), nullptr );
+
+    const auto check = [&d]( const std::string & json ) {
+        CAPTURE( json );
+        const conditional_t cond( json_loader::from_string( json ).get_object() );
+        return cond( d );
+    };
+    CHECK( check( R"({ "and": [ "u_male", { "not": "u_female" } ] })" ) );
+    CHECK_FALSE( check( R"({ "and": [ "u_male", { "and": [ "u_male", "u_female" ] } ] })" ) );
+    CHECK( check( R"({ "or": [ "u_female", { "or": [ "u_female", "u_male" ] } ] })" ) );
+    CHECK_FALSE( check( R"({ "or": [ "u_female", { "not": { "or": [ "u_female", "u_male" ] } } ] })" ) );
+    CHECK( check( R"({ "and": [ "u_male", { "not": { "and": [ "u_male", "u_female" ] } } ] })" ) );
+    CHECK( check( R"({ "not": { "not": "u_male" } })" ) );
+    CHECK_FALSE( check( R"({ "and": [ { "not": "u_male" } ] })" ) );
+    CHECK( check( R"({ "and": [ ] })" ) );
+    CHECK_FALSE( check( R"({ "or": [ ] })" ) );
+}
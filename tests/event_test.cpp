@@ -69,6 +69,32 @@ TEST_CASE( "send_event_through_bus", "[event]" )
     CHECK( e.get<mtype_id>( "victim_type" ) == zombie );
 }
 
+struct kills_only_subscriber : public test_subscriber {
+    bool notified_by( event_type type ) const override {
+        return type == event_type::character_kills_monster;
+    }
+};
+
+TEST_CASE( "send_event_only_to_interested_subscribers", "[event]" )
+{
+    event_bus bus;
+    test_subscriber all;
+    kills_only_subscriber kills;
+    bus.subscribe( &all );
+    bus.subscribe( &kills );
+
+    bus.send<event_type::character_kills_monster>( character_id( 5 ), zombie, 0 );
+    bus.send<event_type::character_wakes_up>( character_id( 5 ) );
+    CHECK( all.events.size() == 2 );
+    REQUIRE( kills.events.size() == 1 );
+    CHECK( kills.events[0].type() == event_type::character_kills_monster );
+
+    bus.unsubscribe( &all );
+    bus.send<event_type::character_wakes_up>( character_id( 5 ) );
+    CHECK( all.events.size() == 2 );
+    CHECK( kills.events.size() == 1 );
+}
+
 TEST_CASE( "destroy_bus_before_subscriber", "[event]" )
 {
     test_subscriber sub;
@@ -30,6 +30,7 @@
 #include "player_helpers.h"
 #include "point.h"
 #include "stomach.h"
+#include "string_formatter.h"
 #include "type_id.h"
 #include "units.h"
 #include "value_ptr.h"
@@ -88,6 +89,8 @@ static const itype_id itype_union_suit("union_suit");
 static const itype_id itype_vest("vest");
 static const itype_id itype_wetsuit("wetsuit");
 
+static const ter_str_id ter_t_wall("t_wall");
+
 static const vitamin_id vitamin_mutagen("mutagen");
 static const vitamin_id vitamin_mutant_toxin("mutant_toxin");
 
@@ -248,6 +251,24 @@ TEST_CASE("camp_locker_item_classification", "[camp][locker]") {
         camp_locker_slot::ranged_weapon);
 }
 
+TEST_CASE("camp_locker_profiles_rebuild_lazily_after_reset", "[camp][locker]") {
+  const std::initializer_list<itype_id> types = {
+      itype_briefs, itype_jeans,       itype_test_jumpsuit_cotton,
+      itype_suit,   itype_hakama,      itype_knee_pads,
+      itype_vest,   itype_helmet_army, itype_backpack};
+  std::map<itype_id, std::optional<camp_locker_slot>> finalized;
+  for (const itype_id &type : types) {
+    finalized[type] = classify_camp_locker_item(item(type));
+  }
+
+  camp_locker_profiles::reset();
+  for (const itype_id &type : types) {
+    CAPTURE(type.str());
+    CHECK(classify_camp_locker_item(item(type)) == finalized[type]);
+  }
+  camp_locker_profiles::finalize_all();
+}
+
 TEST_CASE("camp_locker_zone_candidate_gathering", "[camp][locker]") {
   clear_avatar();
   clear_map_without_vision();
@@ -697,6 +718,8 @@ TEST_CASE("camp_patrol_runtime_contract", "[camp][patrol]") {
                                                camp_patrol_loop_dwell());
     REQUIRE(second_runtime);
     CHECK(second_runtime->target == clusters[1][0]);
+    CHECK(second_runtime->leg_start == clusters[0][0]);
+    CHECK(start_runtime->leg_start == clusters[3][0]);
   }
 
   SECTION("one guard loops an understaffed connected cluster") {
@@ -767,6 +790,43 @@ TEST_CASE("camp_patrol_runtime_contract", "[camp][patrol]") {
   }
 }
 
+TEST_CASE("camp_patrol_legs_are_cached_until_the_map_changes",
+          "[camp][patrol]") {
+  clear_avatar();
+  clear_map_without_vision();
+  zone_manager::get_manager().clear();
+
+  map &here = get_map();
+  const tripoint_abs_ms from = here.get_abs(tripoint_bub_ms{10, 10, 0});
+  const tripoint_abs_ms to = here.get_abs(tripoint_bub_ms{20, 10, 0});
+
+  basecamp test_camp("Patrol Camp", project_to<coords::omt>(from));
+  test_camp.set_owner(your_fac);
+  test_camp.set_bb_pos(from);
+  npc &guard = spawn_npc(tripoint_bub_ms{10, 10, 0}.xy(), "thug");
+
+  const std::vector<tripoint_abs_ms> *leg =
+      test_camp.get_patrol_leg(guard, from, to);
+  REQUIRE(leg != nullptr);
+  REQUIRE_FALSE(leg->empty());
+  CHECK(leg->back() == to);
+  CHECK(test_camp.get_patrol_leg(guard, from, to) == leg);
+  CHECK(test_camp.get_patrol_leg(guard, from, from) == nullptr);
+
+  for (int y = 5; y <= 15; ++y) {
+    here.ter_set(tripoint_bub_ms{15, y, 0}, ter_t_wall);
+  }
+  const std::vector<tripoint_abs_ms> *rerouted =
+      test_camp.get_patrol_leg(guard, from, to);
+  REQUIRE(rerouted != nullptr);
+  CHECK(rerouted->back() == to);
+  for (const tripoint_abs_ms &step : *rerouted) {
+    CHECK(here.ter(here.get_bub(step)) != ter_t_wall);
+  }
+
+  zone_manager::get_manager().clear();
+}
+
 TEST_CASE("camp_locker_zone_candidate_gathering_respects_reservations",
           "[camp][locker]") {
   clear_avatar();
@@ -4102,6 +4162,56 @@ TEST_CASE("camp_locker_downtime_queue_processes_one_worker_at_a_time",
   zone_manager::get_manager().clear();
 }
 
+TEST_CASE("camp_locker_wave_gives_contested_gear_to_the_queue_front",
+          "[camp][locker]") {
+  restore_on_out_of_scope restore_calendar_turn(calendar::turn);
+  clear_avatar();
+  clear_map_without_vision();
+  zone_manager::get_manager().clear();
+
+  map &here = get_map();
+  const tripoint_abs_ms locker_abs = here.get_abs(tripoint_bub_ms{6, 5, 0});
+  const tripoint_bub_ms locker_local = here.get_bub(locker_abs);
+
+  create_tile_zone("Locker", zone_type_CAMP_LOCKER, locker_abs);
+  here.i_clear(locker_local);
+  here.add_item_or_charges(locker_local, item(itype_duffelbag));
+
+  const tripoint_abs_omt camp_omt = project_to<coords::omt>(locker_abs);
+  here.add_camp(camp_omt, "faction_camp");
+  std::optional<basecamp *> bcp = overmap_buffer.find_camp(camp_omt.xy());
+  REQUIRE(!!bcp);
+  basecamp *test_camp = *bcp;
+  test_camp->set_owner(your_fac);
+
+  npc &first_worker = spawn_npc(tripoint_bub_ms{5, 5, 0}.xy(), "thug");
+  clear_character(first_worker, true);
+  REQUIRE(first_worker.wear_item(item(itype_daypack), false).has_value());
+  npc &second_worker = spawn_npc(tripoint_bub_ms{5, 6, 0}.xy(), "thug");
+  clear_character(second_worker, true);
+  REQUIRE(second_worker.wear_item(item(itype_daypack), false).has_value());
+  test_camp->add_assignee(first_worker.getID());
+  test_camp->add_assignee(second_worker.getID());
+
+  test_camp->mark_camp_locker_dirty(first_worker);
+  test_camp->mark_camp_locker_dirty(second_worker);
+  CHECK(test_camp->camp_locker_outlook(first_worker).has_changes);
+  CHECK(test_camp->camp_locker_outlook(first_worker).claims.size() == 1);
+  CHECK_FALSE(test_camp->camp_locker_outlook(second_worker).has_changes);
+
+  // Jumping the queue hands the duffel bag over
+  test_camp->mark_camp_locker_dirty(second_worker, true);
+  CHECK(test_camp->camp_locker_outlook(second_worker).has_changes);
+  CHECK_FALSE(test_camp->camp_locker_outlook(first_worker).has_changes);
+
+  // Once it's gone, neither plans for it
+  here.i_clear(locker_local);
+  CHECK_FALSE(test_camp->camp_locker_outlook(first_worker).has_changes);
+  CHECK_FALSE(test_camp->camp_locker_outlook(second_worker).has_changes);
+
+  zone_manager::get_manager().clear();
+}
+
 TEST_CASE("camp_locker_new_zone_gear_requeues_worker_after_baseline_noop",
           "[camp][locker]") {
   restore_on_out_of_scope restore_calendar_turn(calendar::turn);
@@ -4261,6 +4371,143 @@ TEST_CASE("camp_locker_downtime_rehydrates_transient_assignees",
   zone_manager::get_manager().clear();
 }
 
+TEST_CASE("camp_locker_index_follows_locker_tile_edits", "[camp][locker]") {
+  clear_avatar();
+  clear_map_without_vision();
+
+  map &here = get_map();
+  const tripoint_abs_ms first_abs = here.get_abs(tripoint_bub_ms{5, 5, 0});
+  const tripoint_abs_ms second_abs = here.get_abs(tripoint_bub_ms{6, 5, 0});
+  const tripoint_bub_ms first_local = here.get_bub(first_abs);
+  const tripoint_bub_ms second_local = here.get_bub(second_abs);
+  here.i_clear(first_local);
+  here.i_clear(second_local);
+  here.add_item_or_charges(first_local, item(itype_helmet_bike));
+  here.add_item_or_charges(first_local, item(itype_sneakers));
+  here.add_item_or_charges(second_local, item(itype_helmet_army));
+
+  const camp_locker_policy policy;
+  const std::vector<camp_locker_reservation> no_reservations;
+  const character_id worker_id;
+  const std::vector<const item *> no_current_items;
+  camp_locker_index index;
+  const auto check_matches_full_scan = [&]() {
+    const camp_locker_candidate_map ranked = index.ranked_candidates(
+        policy, no_reservations, worker_id, std::nullopt);
+    const camp_locker_candidate_map scanned = collect_camp_locker_candidates(
+        index.items(no_reservations, worker_id), policy);
+    const camp_locker_plan ranked_plan = plan_camp_locker_loadout(
+        no_current_items, ranked, policy, std::nullopt, true);
+    const camp_locker_plan scanned_plan =
+        plan_camp_locker_loadout(no_current_items, scanned, policy);
+    CHECK(ranked.size() == scanned.size());
+    for (const auto &[slot, slot_plan] : scanned_plan) {
+      CAPTURE(camp_locker_slot_id(slot));
+      REQUIRE(ranked_plan.count(slot) == 1);
+      CHECK(ranked_plan.at(slot).selected_candidate ==
+            slot_plan.selected_candidate);
+    }
+    return ranked;
+  };
+
+  index.refresh({first_abs, second_abs});
+  camp_locker_candidate_map ranked = check_matches_full_scan();
+  REQUIRE(ranked.count(camp_locker_slot::helmet) == 1);
+  CHECK(ranked.at(camp_locker_slot::helmet).size() == 2);
+  CHECK(index.items(no_reservations, worker_id).size() == 3);
+
+  here.i_clear(second_local);
+  index.refresh({first_abs, second_abs});
+  ranked = check_matches_full_scan();
+  REQUIRE(ranked.count(camp_locker_slot::helmet) == 1);
+  REQUIRE(ranked.at(camp_locker_slot::helmet).size() == 1);
+  CHECK(ranked.at(camp_locker_slot::helmet).front()->typeId() ==
+        itype_helmet_bike);
+
+  here.add_item_or_charges(first_local, item(itype_helmet_army));
+  index.refresh({first_abs, second_abs});
+  ranked = check_matches_full_scan();
+  REQUIRE(ranked.count(camp_locker_slot::helmet) == 1);
+  CHECK(ranked.at(camp_locker_slot::helmet).size() == 2);
+
+  // Dropping a tile from the zone drops its items too
+  index.refresh({second_abs});
+  CHECK(index.items(no_reservations, worker_id).empty());
+  CHECK(index.ranked_candidates(policy, no_reservations, worker_id,
+                                std::nullopt)
+            .empty());
+}
+
+TEST_CASE("camp_offscreen_simulation_banks_jobs_and_meals", "[camp]") {
+  restore_on_out_of_scope restore_calendar_turn(calendar::turn);
+  clear_avatar();
+  clear_map_without_vision();
+
+  map &here = get_map();
+  const tripoint_abs_omt near_omt =
+      project_to<coords::omt>(here.get_abs(tripoint_bub_ms{5, 5, 0}));
+  const tripoint_abs_omt far_omt = near_omt + point_rel_omt(40, 40);
+  REQUIRE_FALSE(here.inbounds(far_omt));
+
+  faction *camp_faction = get_player_character().get_faction();
+  camp_faction->empty_food_supply();
+  nutrients stock;
+  stock.calories = 20000 * 1000;
+  camp_faction->add_to_food_supply({{calendar::turn_zero, stock}});
+
+  basecamp far_camp("Far Camp", far_omt);
+  far_camp.set_owner(your_fac);
+  npc &worker = spawn_npc(tripoint_bub_ms{6, 5, 0}.xy(), "thug");
+  static const activity_id ACT_MULTIPLE_FARM("ACT_MULTIPLE_FARM");
+  REQUIRE(worker.job.set_task_priority(ACT_MULTIPLE_FARM, 5));
+  far_camp.add_assignee(worker.getID());
+
+  const time_point start = calendar::turn;
+  far_camp.simulate_offscreen(start);
+  far_camp.simulate_offscreen(start + 10_hours + 30_minutes);
+
+  const camp_offscreen_ledger &ledger = far_camp.get_offscreen_ledger();
+  CHECK(ledger.simulated_until == start + 10_hours);
+  REQUIRE(ledger.job_hours.count(ACT_MULTIPLE_FARM) == 1);
+  CHECK(ledger.job_hours.at(ACT_MULTIPLE_FARM) ==
+        10 * (1_hours * work_day_hours / 24));
+  const int drawn = 20000 - camp_faction->food_supply().kcal();
+  CHECK(drawn > 0);
+  REQUIRE(ledger.owed_meals.count(worker.getID()) == 1);
+  CHECK(ledger.owed_meals.at(worker.getID()).kcal() == Approx(drawn).margin(1));
+  CHECK(ledger.hungry_hours == 0_turns);
+
+  // Once the camp is loaded again the worker eats what it drew
+  std::ostringstream os;
+  JsonOut jsout(os);
+  far_camp.serialize(jsout);
+  std::string saved = os.str();
+  const std::string far_pos =
+      string_format(R"("pos":[%d,%d,%d])", far_omt.x(), far_omt.y(), far_omt.z());
+  const size_t pos_at = saved.find(far_pos);
+  REQUIRE(pos_at != std::string::npos);
+  saved.replace(pos_at, far_pos.size(),
+                string_format(R"("pos":[%d,%d,%d])", near_omt.x(), near_omt.y(),
+                              near_omt.z()));
+  JsonValue jsin = json_loader::from_string(saved);
+  basecamp near_camp;
+  near_camp.deserialize(jsin.get_object());
+  CHECK(near_camp.get_offscreen_ledger().job_hours ==
+        ledger.job_hours);
+  worker.assigned_camp = near_omt;
+  near_camp.add_assignee(worker.getID());
+
+  const int eaten_before = worker.stomach.get_calories();
+  const int larder_before = camp_faction->food_supply().kcal();
+  near_camp.simulate_offscreen(start + 11_hours);
+  CHECK(near_camp.get_offscreen_ledger().empty());
+  CHECK(worker.stomach.get_calories() - eaten_before +
+            camp_faction->food_supply().kcal() - larder_before ==
+        Approx(drawn).margin(2));
+
+  camp_faction->empty_food_supply();
+}
+
 TEST_CASE("camp_calorie_counting", "[camp]") {
   clear_avatar();
   clear_map_without_vision();
@@ -5779,6 +6026,43 @@ TEST_CASE("camp_request_speech_parsing", "[camp][basecamp_ai]") {
   }
 }
 
+TEST_CASE("camp_crafting_inventory_is_formed_again_only_after_changes",
+          "[camp][crafting]") {
+  clear_avatar();
+  clear_map_without_vision();
+  map &here = get_map();
+  const tripoint_bub_ms storage_local{6, 5, 0};
+  const tripoint_abs_ms storage_abs = here.get_abs(storage_local);
+  const tripoint_abs_omt camp_omt = project_to<coords::omt>(storage_abs);
+  here.add_camp(camp_omt, "faction_camp");
+  std::optional<basecamp *> bcp = overmap_buffer.find_camp(camp_omt.xy());
+  REQUIRE(bcp.has_value());
+  basecamp *test_camp = *bcp;
+  test_camp->set_storage_tiles({storage_abs});
+  here.add_item_or_charges(storage_local, item(itype_daypack));
+
+  test_camp->form_crafting_inventory(here);
+  CHECK(test_camp->get_crafting_inventory().amount_of(itype_daypack) == 1);
+  here.add_item_or_charges(storage_local, item(itype_daypack));
+  test_camp->form_crafting_inventory(here);
+  CHECK(test_camp->get_crafting_inventory().amount_of(itype_daypack) == 2);
+
+  // Within the turn the inventory is reused, edits in place need an invalidation to show
+  const auto marked = [](const item &it) { return it.get_var("camp_test", 0) == 1; };
+  for (item &it : here.i_at(storage_local)) {
+    it.set_var("camp_test", 1);
+  }
+  test_camp->form_crafting_inventory(here);
+  CHECK_FALSE(test_camp->get_crafting_inventory().has_item_with(marked));
+  test_camp->invalidate_crafting_inventory();
+  test_camp->form_crafting_inventory(here);
+  CHECK(test_camp->get_crafting_inventory().has_item_with(marked));
+
+  here.i_clear(storage_local);
+  test_camp->form_crafting_inventory(here);
+  CHECK(test_camp->get_crafting_inventory().amount_of(itype_daypack) == 0);
+}
+
 // TODO: Tests for: Check calorie display at various activity levels, camp
 // crafting works as expected (consumes inputs, returns outputs+byproducts,
 // costs calories)
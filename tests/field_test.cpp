@@ -18,6 +18,7 @@
 #include "player_helpers.h"
 #include "point.h"
 #include "string_formatter.h"
+#include "submap.h"
 #include "type_id.h"
 #include "weather_type.h"
 
@@ -104,6 +105,43 @@ TEST_CASE( "field_expiry", "[field]" )
     test_field_expiry( "fd_short_halflife" );
 }
 
+TEST_CASE( "field_processing_visits_only_tiles_with_fields", "[field]" )
+{
+    clear_map_without_vision();
+    map &m = get_map();
+    tripoint_bub_ms first{ 36, 36, 0 };
+    const tripoint_bub_ms second{ 38, 37, 0 };
+    point_sm_ms first_l;
+    submap *sm = map_meddler::unsafe_get_submap_at( first, first_l );
+    REQUIRE( sm != nullptr );
+
+    m.add_field( first, field_fd_test, 1 );
+    m.add_field( second, field_fd_test, 1 );
+    m.process_fields();
+    REQUIRE( sm->field_cells_known );
+    CHECK( sm->field_cells.count() == 2 );
+    REQUIRE( m.get_field( first, field_fd_test ) );
+    CHECK( m.get_field( first, field_fd_test )->get_field_age() > 0_turns );
+
+    SECTION( "fields placed behind the map's back are found after a rescan" ) {
+        const point_sm_ms hidden( 1, 2 );
+        sm->get_field( hidden ).add_field( field_fd_test, 1, 0_turns );
+        sm->field_count++;
+        sm->forget_field_cells();
+        m.process_fields();
+        CHECK( sm->field_cells.count() == 3 );
+        REQUIRE( sm->get_field( hidden ).find_field( field_fd_test ) );
+        CHECK( sm->get_field( hidden ).find_field( field_fd_test )->get_field_age() > 0_turns );
+    }
+
+    SECTION( "tiles drop off the list once their fields are gone" ) {
+        m.remove_field( first, field_fd_test );
+        m.process_fields();
+        m.process_fields();
+        CHECK( sm->field_cells.count() == 1 );
+    }
+}
+
 static void fire_duration( const std::string &terrain_type, const time_duration minimum,
                            const time_duration maximum )
 {
@@ -0,0 +1,118 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cata_catch.h"
+#include "flat_lru_cache.h"
+#include "thread_pool.h"
+
+TEST_CASE( "flat_lru_cache_evicts_unreferenced_entries_first", "[flat_lru_cache]" )
+{
+    flat_lru_cache<int, int> cache( 3 );
+    CHECK( cache.get( 1, -1 ) == -1 );
+    cache.insert( 1, 10 );
+    cache.insert( 2, 20 );
+    cache.insert( 3, 30 );
+    CHECK( cache.size() == 3 );
+
+    // 1 is used again, so the clock passes it once and takes 2.
+    CHECK( cache.get( 1, -1 ) == 10 );
+    std::vector<std::pair<int, int>> evicted;
+    cache.insert( 4, 40, [&evicted]( const int &k, const int &v ) {
+        evicted.emplace_back( k, v );
+    } );
+    REQUIRE( evicted.size() == 1 );
+    CHECK( evicted[0] == std::make_pair( 2, 20 ) );
+    CHECK( cache.size() == 3 );
+    CHECK( cache.get( 1, -1 ) == 10 );
+    CHECK( cache.get( 2, -1 ) == -1 );
+    CHECK( cache.get( 3, -1 ) == 30 );
+    CHECK( cache.get( 4, -1 ) == 40 );
+
+    // Inserting a key already there replaces its value without evicting.
+    cache.insert( 3, 33 );
+    CHECK( cache.get( 3, -1 ) == 33 );
+    CHECK( cache.size() == 3 );
+    CHECK( cache.stats().evictions == 1 );
+}
+
+TEST_CASE( "flat_lru_cache_finds_keys_after_removals", "[flat_lru_cache]" )
+{
+    // Every key in the same probe run.
+    struct same_hash {
+        size_t operator()( int ) const {
+            return 0;
+        }
+    };
+    flat_lru_cache<int, int, same_hash> cache( 8 );
+    for( int i = 0; i < 8; ++i ) {
+        cache.insert( i, i * 10 );
+    }
+    cache.remove( 0 );
+    cache.remove( 3 );
+    cache.remove( 42 );
+    CHECK( cache.size() == 6 );
+    for( int i = 0; i < 8; ++i ) {
+        CAPTURE( i );
+        CHECK( cache.get( i, -1 ) == ( i == 0 || i == 3 ? -1 : i * 10 ) );
+    }
+    // The freed slots are used before anything is evicted.
+    cache.insert( 100, 1 );
+    cache.insert( 101, 2 );
+    CHECK( cache.get( 100, -1 ) == 1 );
+    CHECK( cache.get( 101, -1 ) == 2 );
+    CHECK( cache.stats().evictions == 0 );
+
+    cache.clear();
+    CHECK( cache.size() == 0 );
+    CHECK( cache.get( 1, -1 ) == -1 );
+    cache.insert( 1, 5 );
+    CHECK( cache.get( 1, -1 ) == 5 );
+}
+
+TEST_CASE( "flat_lru_cache_counts_into_named_counters", "[flat_lru_cache]" )
+{
+    const std::string name = "flat_lru_cache_test_counters";
+    const auto named_stats = [&name]() {
+        for( const std::pair<std::string, cache_stats> &entry : cache_counters::all() ) {
+            if( entry.first == name ) {
+                return entry.second;
+            }
+        }
+        return cache_stats();
+    };
+    const cache_stats before = named_stats();
+    flat_lru_cache<int, std::string> cache( 2, name );
+    cache.insert( 1, "one" );
+    CHECK( cache.get( 1, "" ) == "one" );
+    CHECK( cache.get( 2, "" ).empty() );
+    cache.insert( 2, "two" );
+    cache.insert( 3, "three" );
+
+    const cache_stats after = named_stats();
+    CHECK( cache.stats().hits == 1 );
+    CHECK( cache.stats().misses == 1 );
+    CHECK( after.hits - before.hits == 1 );
+    CHECK( after.misses - before.misses == 1 );
+    CHECK( after.evictions - before.evictions == 1 );
+}
+
+TEST_CASE( "sharded_lru_cache_is_shared_by_workers", "[flat_lru_cache]" )
+{
+    constexpr int keys = 4096;
+    sharded_lru_cache<int, int> cache( keys * 2 );
+    cata::get_thread_pool().parallel_for( 0, keys, [&cache]( int i ) {
+        cache.insert( i, i * 3 );
+    } );
+    CHECK( cache.size() == static_cast<size_t>( keys ) );
+    int wrong = 0;
+    for( int i = 0; i < keys; ++i ) {
+        wrong += cache.get( i, -1 ) != i * 3;
+    }
+    CHECK( wrong == 0 );
+    CHECK( cache.stats().hits == static_cast<uint64_t>( keys ) );
+    cache.remove( 7 );
+    CHECK( cache.get( 7, -1 ) == -1 );
+}
@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 
+#include "color.h"
 #include "output.h"
 
 template<class IterResult, class IterExpect>
@@ -106,3 +107,22 @@ TEST_CASE( "fold-string" )
         check_equal( folded.begin(), folded.end(), expected.begin(), expected.end() );
     }
 }
+
+TEST_CASE( "fold-string-per-message-matches-joined-text" )
+{
+    // dialogue_window folds each history message on its own and joins the lines.
+    const std::vector<std::string> messages = {
+        colorize( "Lorem ipsum dolor sit amet, consectetur adipiscing elit.", c_white ),
+        colorize( "", c_light_gray ),
+        colorize( "Pellentesque a.\nSed ut perspiciatis unde omnis iste natus.", c_yellow ),
+    };
+    std::string joined;
+    std::vector<std::string> per_message;
+    for( const std::string &msg : messages ) {
+        joined += msg + "\n";
+        const std::vector<std::string> folded = foldstring( msg, 17 );
+        per_message.insert( per_message.end(), folded.begin(), folded.end() );
+    }
+    const std::vector<std::string> folded = foldstring( joined, 17 );
+    check_equal( per_message.begin(), per_message.end(), folded.begin(), folded.end() );
+}
@@ -1,7 +1,12 @@
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
 #include "horde_map.h"
 
 #include "cata_catch.h"
 #include "coordinates.h"
+#include "map_scale_constants.h"
 #include "monster.h"
 #include "rng.h"
 
@@ -135,3 +140,115 @@ TEST_CASE( "horde_map_corner_cases", "[hordes]" )
     }
 
 }
+
+TEST_CASE( "horde_map_keeps_submaps_and_levels_apart", "[hordes]" )
+{
+    horde_map test_horde;
+    point_abs_om om_origin( -3, 7 );
+    test_horde.set_location( om_origin );
+
+    const int max_ms = OMAPX * 2 * SEEX - 1;
+    const std::vector<tripoint_om_ms> locations = {
+        { 0, 0, -OVERMAP_DEPTH }, { 0, 0, OVERMAP_HEIGHT }, { 0, 0, 0 },
+        { max_ms, max_ms, 0 }, { max_ms, 0, -OVERMAP_DEPTH }, { 0, max_ms, OVERMAP_HEIGHT }
+    };
+    for( const tripoint_om_ms &loc : locations ) {
+        test_horde.spawn_entity( project_combine( om_origin, loc ), mon_zombie );
+    }
+    for( const tripoint_om_ms &loc : locations ) {
+        CAPTURE( loc );
+        CHECK( test_horde.entity_at( loc ) != nullptr );
+        CHECK( test_horde.find( loc ) != test_horde.end() );
+        std::vector<std::unordered_map<tripoint_abs_ms, horde_entity>*> group =
+            test_horde.entity_group_at( project_to<coords::sm>( loc ), horde_map_flavors::idle );
+        REQUIRE( group.size() == 1 );
+        CHECK( group[0]->size() == 1 );
+    }
+    CHECK( count_entities( test_horde, horde_map_flavors::idle ) == 6 );
+
+    test_horde.clear_chunk( project_to<coords::sm>( locations[0] ) );
+    CHECK( test_horde.entity_at( locations[0] ) == nullptr );
+    CHECK( test_horde.entity_at( locations[1] ) != nullptr );
+    CHECK( test_horde.entity_at( locations[2] ) != nullptr );
+
+    int erased = 0;
+    for( horde_map::iterator iter = test_horde.begin(); iter != test_horde.end(); ) {
+        iter = test_horde.erase( iter );
+        erased++;
+    }
+    CHECK( erased == 5 );
+    CHECK( test_horde.begin() == test_horde.end() );
+}
+
+TEST_CASE( "horde_map_signal_reaches_only_nearby_submaps", "[hordes]" )
+{
+    horde_map test_horde;
+    point_abs_om om_origin( 2, -1 );
+    test_horde.set_location( om_origin );
+
+    // One zombie per submap on a strip long enough that the signal looks up
+    // chunks in its radius instead of walking every chunk.
+    const int strip_length = OMAPX * 2;
+    for( int x = 0; x < strip_length; ++x ) {
+        test_horde.spawn_entity( project_combine( om_origin, tripoint_om_ms( x * SEEX, 5 * SEEY, 0 ) ),
+                                 mon_zombie );
+    }
+    // And a few on other levels.
+    test_horde.spawn_entity( project_combine( om_origin, tripoint_om_ms( 10 * SEEX, 5 * SEEY, 2 ) ),
+                             mon_zombie );
+    test_horde.spawn_entity( project_combine( om_origin, tripoint_om_ms( 10 * SEEX, 5 * SEEY, 5 ) ),
+                             mon_zombie );
+    REQUIRE( count_entities( test_horde, horde_map_flavors::idle ) == strip_length + 2 );
+
+    const tripoint_abs_ms origin = project_combine( om_origin, tripoint_om_ms( 10 * SEEX, 5 * SEEY,
+                                   0 ) );
+    // Submaps up to 3 away hear this.
+    test_horde.signal_entities( origin, 4 );
+    CHECK( count_entities( test_horde, horde_map_flavors::active ) == 8 );
+    CHECK( count_entities( test_horde, horde_map_flavors::idle ) == strip_length + 2 - 8 );
+    for( int x = 0; x < strip_length; ++x ) {
+        CAPTURE( x );
+        const horde_entity *entity = test_horde.entity_at( tripoint_om_ms( x * SEEX, 5 * SEEY, 0 ) );
+        REQUIRE( entity != nullptr );
+        CHECK( ( entity->destination == origin ) == ( std::abs( x - 10 ) <= 3 ) );
+    }
+
+    // A signal from another overmap still reaches across the border.
+    horde_map near_edge;
+    near_edge.set_location( om_origin );
+    near_edge.spawn_entity( project_combine( om_origin, tripoint_om_ms( 0, 0, 0 ) ), mon_zombie );
+    near_edge.signal_entities( project_combine( om_origin, tripoint_om_ms( -SEEX, 0, 0 ) ), 2 );
+    CHECK( count_entities( near_edge, horde_map_flavors::active ) == 1 );
+}
+
+TEST_CASE( "horde_map_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    horde_map test_horde;
+    point_abs_om om_origin( 2, -1 );
+    test_horde.set_location( om_origin );
+    // A thousand zombies two tiles apart, filling a strip of submaps.
+    const auto spawn_all = [&]() {
+        for( int i = 0; i < 1000; ++i ) {
+            test_horde.spawn_entity( project_combine( om_origin, tripoint_om_ms( ( i % 100 ) * 2,
+                                     ( i / 100 ) * 2, 0 ) ), mon_zombie );
+        }
+    };
+
+    BENCHMARK( "spawn and clear 1000" ) {
+        spawn_all();
+        test_horde.clear();
+        return test_horde.entity_at( tripoint_om_ms( 0, 0, 0 ) ) == nullptr;
+    };
+
+    spawn_all();
+    REQUIRE( count_entities( test_horde, horde_map_flavors::idle ) == 1000 );
+    BENCHMARK( "iterate 1000" ) {
+        return count_entities( test_horde, horde_map_flavors::idle ) +
+               count_entities( test_horde, horde_map_flavors::active );
+    };
+    const tripoint_abs_ms origin = project_combine( om_origin, tripoint_om_ms( 100, 10, 0 ) );
+    BENCHMARK( "signal_entities" ) {
+        test_horde.signal_entities( origin, 20 );
+        return count_entities( test_horde, horde_map_flavors::active );
+    };
+}
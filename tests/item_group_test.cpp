@@ -269,3 +269,33 @@ TEST_CASE( "Event-based_item_spawns_do_not_spawn_outside_event", "[item_group]"
         CHECK( items[0].typeId() == test_rock );
     }
 }
+
+TEST_CASE( "distribution_picks_follow_entry_weights", "[item_group]" )
+{
+    Item_group group( Item_group::G_DISTRIBUTION, 100, 0, 0, "distribution test" );
+    group.add_item_entry( itype_rock, 1 );
+    group.add_item_entry( itype_test_rock, 3 );
+
+    int rocks = 0;
+    int test_rocks = 0;
+    constexpr int rolls = 4000;
+    for( int i = 0; i < rolls; ++i ) {
+        Item_spawn_data::RecursionList rec;
+        const itype_id picked = group.create_single( calendar::turn_zero, rec ).typeId();
+        if( picked == itype_rock ) {
+            ++rocks;
+        } else if( picked == itype_test_rock ) {
+            ++test_rocks;
+        }
+    }
+    // every roll lands on one of the two
+    CHECK( rocks + test_rocks == rolls );
+    CHECK( rocks == Approx( rolls / 4 ).margin( rolls / 20 ) );
+
+    // Removing an entry leaves everything to the rest.
+    group.remove_item( itype_rock );
+    Item_spawn_data::RecursionList rec;
+    for( int i = 0; i < 100; ++i ) {
+        CHECK( group.create_single( calendar::turn_zero, rec ).typeId() == itype_test_rock );
+    }
+}
@@ -10,11 +10,13 @@
 #include "map.h"
 #include "map_helpers.h"
 #include "map_selector.h"
+#include "mapbuffer.h"
 #include "player_helpers.h"
 #include "pocket_type.h"
 #include "point.h"
 #include "ret_val.h"
 #include "rng.h"
+#include "submap.h"
 #include "type_id.h"
 #include "visitable.h"
 
@@ -98,3 +100,71 @@ TEST_CASE( "item_in_container", "[item][item_location]" )
 
     CHECK( jeans_loc.parent_item() == backpack_loc );
 }
+
+TEST_CASE( "nested_item_location_follows_its_root", "[item][item_location]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    Character &dummy = get_player_character();
+    map &here = get_map();
+    item_location backpack_loc( dummy, & **dummy.wear_item( item( itype_backpack ) ) );
+    REQUIRE( backpack_loc->put_in( item( itype_backpack ), pocket_type::CONTAINER ).success() );
+    item_location inner_loc( backpack_loc, &backpack_loc->only_item() );
+    REQUIRE( inner_loc->put_in( item( itype_jeans ), pocket_type::CONTAINER ).success() );
+    item_location jeans_loc( inner_loc, &inner_loc->only_item() );
+
+    CHECK( jeans_loc.where() == item_location::type::container );
+    CHECK( jeans_loc.where_recursive() == item_location::type::character );
+    CHECK( jeans_loc.carrier() == &dummy );
+    CHECK( jeans_loc.pos_abs() == dummy.pos_abs() );
+    // The chain is resolved once, where it is isn't.
+    dummy.setpos( here, dummy.pos_bub() + point::east );
+    CHECK( jeans_loc.pos_abs() == dummy.pos_abs() );
+    CHECK( jeans_loc.pos_bub( here ) == dummy.pos_bub() );
+
+    const tripoint_bub_ms spot = dummy.pos_bub() + point::south;
+    item &on_map = here.add_item( spot, item( itype_backpack ) );
+    REQUIRE( on_map.put_in( item( itype_tshirt ), pocket_type::CONTAINER ).success() );
+    item_location map_backpack( map_cursor( spot ), &on_map );
+    item_location tshirt_loc( map_backpack, &map_backpack->only_item() );
+    CHECK( tshirt_loc.where_recursive() == item_location::type::map );
+    CHECK( tshirt_loc.carrier() == nullptr );
+    CHECK( tshirt_loc.pos_bub( here ) == spot );
+}
+
+TEST_CASE( "item_edited_through_a_tinymap_location_is_saved", "[item][item_location][map]" )
+{
+    clear_map_without_vision();
+    // Outside the reality bubble, so saving drops it and loading reads it back from disk.
+    const tripoint_abs_omt omt = project_to<coords::omt>( get_map().get_abs_sub() ) +
+                                 point( MAPSIZE, MAPSIZE );
+    const tripoint_omt_ms spot( 5, 5, 0 );
+    {
+        tinymap tm;
+        tm.load( omt, false );
+        tm.i_clear( spot );
+        tm.add_item( spot, item( itype_jeans ) );
+    }
+    MAPBUFFER.save();
+    MAPBUFFER.finish_pending_saves();
+    {
+        tinymap tm;
+        tm.load( omt, false );
+        map_stack stack = tm.i_at( spot );
+        REQUIRE( stack.size() == 1 );
+        item_location jeans( map_cursor( tm.get_abs( spot ) ), &*stack.begin() );
+        // As if the location had been kept since an earlier save, only the edit itself is left.
+        submap *sm = MAPBUFFER.lookup_submap( project_to<coords::sm>( tm.get_abs( spot ) ) );
+        REQUIRE( sm != nullptr );
+        sm->mark_saved();
+        jeans->set_var( "test_edit", "edited" );
+    }
+    MAPBUFFER.save();
+    MAPBUFFER.finish_pending_saves();
+
+    tinymap tm;
+    tm.load( omt, false );
+    map_stack stack = tm.i_at( spot );
+    REQUIRE( stack.size() == 1 );
+    CHECK( stack.begin()->get_var( "test_edit" ) == "edited" );
+}
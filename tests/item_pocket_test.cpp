@@ -3082,3 +3082,50 @@ TEST_CASE( "unload_from_spillable_container", "[item][pocket]" )
     }
 }
 
+
+TEST_CASE( "remaining_charges_by_weight_and_volume_agree_with_separate_queries", "[pocket][charges]" )
+{
+    item backpack( itype_test_backpack );
+    backpack.put_in( item( itype_test_rock ), pocket_type::CONTAINER );
+    item nuts( itype_test_pine_nuts );
+    nuts.charges = 3;
+    backpack.put_in( nuts, pocket_type::CONTAINER );
+
+    const item &cbackpack = backpack;
+    const std::vector<const item_pocket *> pockets = cbackpack.get_standard_pockets();
+    REQUIRE( !pockets.empty() );
+    const item_pocket &pocket = *pockets.front();
+    REQUIRE( !pocket.empty() );
+
+    // Stacking with the nuts already inside as well as fitting around the rock.
+    item more_nuts( itype_test_pine_nuts );
+    const std::pair<int, int> nut_capacity = pocket.charges_per_remaining_weight_and_volume( more_nuts );
+    CHECK( nut_capacity.first == pocket.charges_per_remaining_weight( more_nuts ) );
+    CHECK( nut_capacity.second == pocket.charges_per_remaining_volume( more_nuts ) );
+
+    item rock( itype_test_rock );
+    const std::pair<int, int> rock_capacity = pocket.charges_per_remaining_weight_and_volume( rock );
+    CHECK( rock_capacity.first == pocket.charges_per_remaining_weight( rock ) );
+    CHECK( rock_capacity.second == pocket.charges_per_remaining_volume( rock ) );
+}
+
+TEST_CASE( "pocket_aggregates_cached_within_a_scope_follow_content_changes", "[pocket][item]" )
+{
+    item backpack( itype_test_backpack );
+    item box( itype_test_box );
+    box.put_in( item( itype_test_rock ), pocket_type::CONTAINER );
+    backpack.put_in( box, pocket_type::CONTAINER );
+
+    const units::mass weight_outside = backpack.weight();
+    const units::volume volume_outside = backpack.volume();
+
+    item_pocket::aggregate_scope aggregates;
+    CHECK( backpack.weight() == weight_outside );
+    CHECK( backpack.volume() == volume_outside );
+    // Asked twice, answered from the cache the second time.
+    CHECK( backpack.weight() == weight_outside );
+
+    // Adding through the pocket drops what the scope had cached.
+    backpack.put_in( item( itype_test_rock ), pocket_type::CONTAINER );
+    CHECK( backpack.weight() == weight_outside + item( itype_test_rock ).weight() );
+}
@@ -381,6 +381,24 @@ TEST_CASE( "item_variables_round-trip_accurately", "[item]" )
     CHECK( i.get_var( "C", tripoint_abs_ms::zero ) == tripoint_abs_ms( 2, 3, 4 ) );
 }
 
+TEST_CASE( "items_without_variables_answer_lookups_and_stack", "[item]" )
+{
+    item rock( itype_test_rock );
+    rock.clear_vars();
+    CHECK_FALSE( rock.has_var( "dirt" ) );
+    CHECK( rock.maybe_get_value( "dirt" ) == nullptr );
+    CHECK( rock.get_var( "dirt", 3 ) == 3 );
+
+    item other_rock( itype_test_rock );
+    other_rock.clear_vars();
+    CHECK( rock.stacks_with( other_rock ) );
+
+    // a variable outside the ignored set still keeps them apart
+    other_rock.set_var( "item_note", "mine" );
+    CHECK_FALSE( rock.stacks_with( other_rock ) );
+    CHECK( other_rock.has_var( "item_note" ) );
+}
+
 TEST_CASE( "water_affect_items_while_swimming_check", "[item][water][swimming]" )
 {
     avatar &guy = get_avatar();
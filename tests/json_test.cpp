@@ -13,6 +13,7 @@
 
 #include "bodypart.h"
 #include "cached_options.h"
+#include "cata_path.h"
 #include "cata_scope_helpers.h"
 #include "cata_utility.h"
 #include "cata_catch.h"
@@ -20,11 +21,13 @@
 #include "damage.h"
 #include "debug.h"
 #include "enum_bitset.h"
+#include "filesystem.h"
 #include "item.h"
 #include "json.h"
 #include "json_loader.h"
 #include "magic.h"
 #include "mutation.h"
+#include "path_info.h"
 #include "sounds.h"
 #include "string_formatter.h"
 #include "translations.h"
@@ -1060,3 +1063,97 @@ TEST_CASE( "serialize_optional", "[json]" )
         test_serialization( v, "[1,2,3]" );
     }
 }
+
+TEST_CASE( "json_loader_from_paths_keeps_order", "[json]" )
+{
+    const std::vector<cata_path> files = get_files_from_path( ".json",
+                                         PATH_INFO::moddir() / "TEST_DATA", true, true );
+    REQUIRE( files.size() > 1 );
+
+    std::vector<cata_path> seen;
+    json_loader::from_paths( files, [&]( const cata_path & file, const JsonValue & jsin ) {
+        seen.push_back( file );
+        JsonValue serial = json_loader::from_path( file );
+        CHECK( jsin.test_array() == serial.test_array() );
+        CHECK( jsin.test_object() == serial.test_object() );
+    } );
+    CHECK( seen == files );
+}
+
+TEST_CASE( "json_loader_from_paths_snapshot_matches_files", "[json]" )
+{
+    const std::vector<cata_path> files = get_files_from_path( ".json",
+                                         PATH_INFO::moddir() / "TEST_DATA", true, true );
+    REQUIRE( files.size() > 1 );
+    const std::string snapshot_name = "json_loader_from_paths_snapshot_test";
+
+    std::vector<std::string> first;
+    json_loader::from_paths( files, [&]( const cata_path &, const JsonValue & jsin ) {
+        first.push_back( jsin.test_array() ? "array" : "object" );
+    }, snapshot_name );
+
+    // The second pass is served from the snapshot written by the first.
+    std::vector<std::string> second;
+    std::vector<cata_path> seen;
+    json_loader::from_paths( files, [&]( const cata_path & file, const JsonValue & jsin ) {
+        seen.push_back( file );
+        second.push_back( jsin.test_array() ? "array" : "object" );
+    }, snapshot_name );
+    CHECK( seen == files );
+    CHECK( first == second );
+}
+
+TEST_CASE( "json_object_repeated_member_lookups", "[json]" )
+{
+    // NOLINTNEXTLINE(cata-text-style)
+    const std::string json = R"({"a": 1, "b": "two", "c": [3], "d": {"e": 4}})";
+    JsonObject jo = json_loader::from_string( json );
+
+    // A found key is remembered, lookups of other keys must not be confused by that.
+    CHECK( jo.has_member( "b" ) );
+    CHECK( jo.has_string( "b" ) );
+    CHECK( jo.get_string( "b" ) == "two" );
+    CHECK_FALSE( jo.has_member( "bb" ) );
+    CHECK_FALSE( jo.has_member( "" ) );
+    CHECK( jo.get_int( "a" ) == 1 );
+    CHECK( jo.get_int( "z", 7 ) == 7 );
+    CHECK( jo.get_array( "c" ).size() == 1 );
+    // The key passed in may not outlive the lookup.
+    CHECK( jo.has_object( std::string( "d" ) ) );
+    CHECK( jo.get_object( std::string( "d" ) ).get_int( "e" ) == 4 );
+
+    JsonObject copy = jo;
+    CHECK( copy.get_string( "b" ) == "two" );
+    CHECK( copy.get_int( "a" ) == 1 );
+    copy.allow_omitted_members();
+}
+
+TEST_CASE( "json_parse_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    // A few hundred objects shaped like item definitions.
+    std::string json = "[";
+    for( int i = 0; i < 300; ++i ) {
+        if( i > 0 ) {
+            json += ",";
+        }
+        json += string_format( R"({"id":"bench_item_%d","weight":%d,"volume":"%d ml",)"
+                               R"("flags":["BENCH_A","BENCH_%d"],"name":{"str":"bench item %d"}})",
+                               i, i * 13, i * 7, i % 5, i );
+    }
+    json += "]";
+
+    BENCHMARK( "parse and read 300 objects" ) {
+        int total = 0;
+        JsonArray ja = json_loader::from_string( json );
+        for( JsonObject jo : ja ) {
+            total += jo.get_string( "id" ).size();
+            total += jo.get_int( "weight" );
+            total += jo.get_string( "volume" ).size();
+            for( const std::string flag : jo.get_array( "flags" ) ) {
+                total += flag.size();
+            }
+            total += jo.get_object( "name" ).get_string( "str" ).size();
+        }
+        return total;
+    };
+}
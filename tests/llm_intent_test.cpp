@@ -1,4 +1,5 @@
 #include <map>
+#include <sstream>
 #include <string>
 
 #include "avatar.h"
@@ -7,7 +8,10 @@
 #include "coordinates.h"
 #include "creature.h"
 #include "faction.h"
+#include "flexbuffer_json.h"
 #include "game.h"
+#include "json.h"
+#include "json_loader.h"
 #include "llm_intent.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -29,6 +33,10 @@ bool parse_move_field_for_test( const std::string &field, point &delta,
                                 std::string &error );
 tripoint_abs_ms resolve_move_target_for_test( const tripoint_abs_ms &origin,
         const point &delta );
+std::string build_budgeted_snapshot_for_test( npc &listener, const std::string &player_utterance,
+        int token_budget );
+std::string ambient_reply_fingerprint_for_test( npc &listener, const std::string &player_utterance );
+void broadcast_overheard_memory_for_test( const npc &speaker, const std::string &speech );
 } // namespace llm_intent
 
 static const faction_id faction_your_followers( "your_followers" );
@@ -101,6 +109,120 @@ TEST_CASE( "llm_intent_snapshot_includes_attitude_and_lettered_targets", "[llm_i
     CHECK( snapshot.find( "zombie hostile threat=" ) != std::string::npos );
 }
 
+TEST_CASE( "llm_intent_overheard_speech_is_shared_by_nearby_allies", "[llm_intent]" )
+{
+    setup_snapshot_test_scene();
+    npc &speaker = spawn_test_npc_at( point_bub_ms( 50, 50 ), "Speaker NPC" );
+    npc &near_ally = spawn_test_npc_at( point_bub_ms( 53, 50 ), "Near Ally" );
+    npc &other_ally = spawn_test_npc_at( point_bub_ms( 50, 45 ), "Other Ally" );
+    npc &far_ally = spawn_test_npc_at( point_bub_ms( 100, 50 ), "Far Ally" );
+    npc &stranger = spawn_test_npc_at( point_bub_ms( 51, 50 ), "Stranger" );
+    for( npc *guy : { &speaker, &near_ally, &other_ally, &far_ally } ) {
+        guy->set_fac( faction_your_followers );
+    }
+
+    llm_intent::broadcast_overheard_memory_for_test( speaker, "Keep it down." );
+    CHECK( speaker.get_llm_overheard_memory().empty() );
+    CHECK( stranger.get_llm_overheard_memory().empty() );
+    CHECK( far_ally.get_llm_overheard_memory().empty() );
+    const auto near_memory = near_ally.get_llm_overheard_memory();
+    const auto other_memory = other_ally.get_llm_overheard_memory();
+    REQUIRE( near_memory.size() == 1 );
+    REQUIRE( other_memory.size() == 1 );
+    CHECK( near_memory[0]->npc_response == "Keep it down." );
+    CHECK( near_memory[0]->npc_name == "Speaker NPC" );
+    // One utterance, kept by both.
+    CHECK( near_memory[0] == other_memory[0] );
+
+    for( int i = 0; i < 10; ++i ) {
+        llm_intent::broadcast_overheard_memory_for_test( speaker, "Again." );
+    }
+    CHECK( near_ally.get_llm_overheard_memory().size() == 4 );
+}
+
+TEST_CASE( "llm_intent_memory_is_kept_in_the_save_and_clipped", "[llm_intent]" )
+{
+    setup_snapshot_test_scene();
+    npc &guy = spawn_test_npc_at( point_bub_ms( 50, 50 ), "Remembering NPC" );
+    const std::string rambling( 2000, 'a' );
+    guy.add_llm_intent_memory( "Follow me.", rambling, { "follow" } );
+    guy.add_llm_overheard_memory( "Other NPC", "I'll keep watch.", {} );
+    REQUIRE( guy.get_llm_intent_memory().size() == 1 );
+    CHECK( guy.get_llm_intent_memory()[0].npc_response.size() < 400 );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    guy.serialize( jsout );
+    guy.add_llm_intent_memory( "Never mind.", "Sure.", {} );
+    guy.add_llm_overheard_memory( "Other NPC", "Nothing here.", {} );
+
+    guy.deserialize( json_loader::from_string( os.str() ).get_object() );
+    const std::vector<npc::llm_intent_memory_entry> memory = guy.get_llm_intent_memory();
+    REQUIRE( memory.size() == 1 );
+    CHECK( memory[0].player_utterance == "Follow me." );
+    CHECK( memory[0].actions == std::vector<std::string> { "follow" } );
+    const auto overheard = guy.get_llm_overheard_memory();
+    REQUIRE( overheard.size() == 1 );
+    CHECK( overheard[0]->npc_name == "Other NPC" );
+    CHECK( overheard[0]->npc_response == "I'll keep watch." );
+}
+
+TEST_CASE( "llm_intent_prompt_puts_stable_text_first", "[llm_intent]" )
+{
+    setup_snapshot_test_scene();
+    npc &listener = spawn_test_npc_at( point_bub_ms( 50, 50 ), "Listener NPC" );
+    listener.set_fac( faction_your_followers );
+
+    const std::string snapshot = llm_intent::build_snapshot_for_test( listener, "Hold there.", "req-layout" );
+    const size_t name_pos = snapshot.find( "your_name: " );
+    const size_t legend_pos = snapshot.find( "legend:\n" );
+    const size_t conversation_pos = snapshot.find( "Recent conversation newest first:" );
+    const size_t map_pos = snapshot.find( "map:\n" );
+    const size_t id_pos = snapshot.find( "id: req-layout" );
+    REQUIRE( name_pos != std::string::npos );
+    REQUIRE( id_pos != std::string::npos );
+    CHECK( name_pos < legend_pos );
+    CHECK( legend_pos < conversation_pos );
+    CHECK( conversation_pos < map_pos );
+    CHECK( map_pos < id_pos );
+
+    const std::string prompt = llm_intent::build_action_prompt_for_test( "Listener NPC", "Hold there.",
+                               snapshot );
+    CHECK( prompt.find( "<System>" ) < prompt.find( snapshot ) );
+}
+
+TEST_CASE( "llm_intent_snapshot_shrinks_to_token_budget", "[llm_intent]" )
+{
+    setup_snapshot_test_scene();
+    npc &listener = spawn_test_npc_at( point_bub_ms( 50, 50 ), "Listener NPC" );
+    spawn_test_monster( mon_zombie.str(), tripoint_bub_ms( 68, 50, 0 ) );
+
+    const std::string full = llm_intent::build_budgeted_snapshot_for_test( listener, "Hold there.", 0 );
+    const std::string small = llm_intent::build_budgeted_snapshot_for_test( listener, "Hold there.",
+                              300 );
+
+    CHECK( small.size() < full.size() );
+    CHECK( full.find( "beyond the map" ) == std::string::npos );
+    CHECK( small.find( "x*n ... n tiles of x in a row" ) != std::string::npos );
+    CHECK( small.find( "beyond the map (|dx| or |dy| over 6):" ) != std::string::npos );
+    CHECK( small.find( "dy=+20 " ) == std::string::npos );
+    CHECK( small.find( "dy=+06 " ) != std::string::npos );
+    CHECK( small.find( "(dx=+18,dy=+00)" ) != std::string::npos );
+}
+
+TEST_CASE( "llm_intent_ambient_fingerprint_ignores_utterance_noise", "[llm_intent]" )
+{
+    setup_snapshot_test_scene();
+    npc &listener = spawn_test_npc_at( point_bub_ms( 50, 50 ), "Listener NPC" );
+
+    const std::string hello = llm_intent::ambient_reply_fingerprint_for_test( listener, "Hello there!" );
+    CHECK( hello == llm_intent::ambient_reply_fingerprint_for_test( listener, "  hello,  THERE " ) );
+    CHECK( hello != llm_intent::ambient_reply_fingerprint_for_test( listener, "Go away." ) );
+
+    spawn_test_monster( mon_zombie.str(), tripoint_bub_ms( 54, 50, 0 ) );
+    CHECK( hello != llm_intent::ambient_reply_fingerprint_for_test( listener, "Hello there!" ) );
+}
+
 TEST_CASE( "llm_intent_prompt_explicitly_allows_lettered_targets", "[llm_intent]" )
 {
     const std::string prompt = llm_intent::build_action_prompt_for_test( "Listener NPC",
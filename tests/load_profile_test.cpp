@@ -0,0 +1,55 @@
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include "cata_catch.h"
+#include "cata_path.h"
+#include "flexbuffer_json.h"
+#include "json_loader.h"
+#include "load_profile.h"
+
+TEST_CASE( "load_profile_writes_phases_and_loader_totals", "[load_profile]" )
+{
+    load_profile profile;
+    profile.add_phase( "finalize", "Ignored", load_profile::clock::now(),
+                       load_profile::clock::now() );
+    profile.add_object( "ignored", "dda", std::chrono::milliseconds( 1 ) );
+
+    profile.reset( true );
+    const load_profile::clock::time_point start = load_profile::clock::now();
+    profile.add_phase( "finalize", "Items", start, start + std::chrono::milliseconds( 3 ) );
+    profile.add_object( "GENERIC", "dda", std::chrono::microseconds( 10 ) );
+    profile.add_object( "GENERIC", "dda", std::chrono::microseconds( 30 ) );
+    profile.add_object( "GENERIC", "mod", std::chrono::microseconds( 5 ) );
+
+    const std::filesystem::path file = std::filesystem::temp_directory_path() /
+                                       std::filesystem::u8path( "load_profile_test.json" );
+    const cata_path path( cata_path::root_path::unknown, file );
+    profile.write( path );
+
+    JsonObject jo = json_loader::from_path( path ).get_object();
+    jo.allow_omitted_members();
+    JsonArray events = jo.get_array( "traceEvents" );
+    REQUIRE( events.size() == 1 );
+    JsonObject event = events.next_object();
+    event.allow_omitted_members();
+    CHECK( event.get_string( "name" ) == "Items" );
+    CHECK( event.get_string( "cat" ) == "finalize" );
+    CHECK( event.get_string( "ph" ) == "X" );
+    CHECK( event.get_int( "dur" ) == 3000 );
+
+    JsonArray loaders = jo.get_array( "loaders" );
+    REQUIRE( loaders.size() == 2 );
+    JsonObject dda = loaders.next_object();
+    CHECK( dda.get_string( "type" ) == "GENERIC" );
+    CHECK( dda.get_string( "src" ) == "dda" );
+    CHECK( dda.get_int( "count" ) == 2 );
+    CHECK( dda.get_int( "total_us" ) == 40 );
+    CHECK( dda.get_int( "max_us" ) == 30 );
+    JsonObject mod = loaders.next_object();
+    mod.allow_omitted_members();
+    CHECK( mod.get_string( "src" ) == "mod" );
+    CHECK( mod.get_int( "count" ) == 1 );
+
+    std::filesystem::remove( file );
+}
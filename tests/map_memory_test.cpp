@@ -9,6 +9,7 @@
 #include "map.h"
 #include "map_memory.h"
 #include "map_scale_constants.h"
+#include "options_helpers.h"
 #include "point.h"
 
 static constexpr tripoint_abs_ms p1{ -SEEX - 2, -SEEY - 3, -1 };
@@ -122,6 +123,39 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     CHECK( mt.get_dec_rotation() == 0 );
 }
 
+TEST_CASE( "map_memory_bounds_loaded_regions", "[map_memory]" )
+{
+    map_memory memory;
+    constexpr int region_ms = MM_REG_SIZE * SEEX;
+    const auto spot = []( int i ) {
+        return tripoint_abs_ms( i * region_ms + region_ms / 2, region_ms / 2, 0 );
+    };
+    for( int i = 0; i < map_memory::max_loaded_regions + 20; ++i ) {
+        memory.prepare_region( spot( i ), spot( i ) + tripoint( SEEX, SEEY, 0 ) );
+        memory.set_tile_symbol( spot( i ), 7 );
+        REQUIRE( memory.loaded_regions() <= map_memory::max_loaded_regions );
+    }
+    // The regions in view are the most recently used, and stay.
+    const int last = map_memory::max_loaded_regions + 19;
+    CHECK( !memory.prepare_region( spot( last ), spot( last ) + tripoint( SEEX, SEEY, 0 ) ) );
+    CHECK( memory.get_tile( spot( last ) ).symbol == 7 );
+    memory.clear();
+    CHECK( memory.loaded_regions() == 0 );
+}
+
+TEST_CASE( "map_memory_keeps_fewer_regions_in_low_memory_profile", "[map_memory]" )
+{
+    override_option low_memory( "LOW_MEMORY_PROFILE", "true" );
+    map_memory memory;
+    constexpr int region_ms = MM_REG_SIZE * SEEX;
+    for( int i = 0; i < map_memory::max_loaded_regions; ++i ) {
+        const tripoint_abs_ms spot( i * region_ms + region_ms / 2, region_ms / 2, 0 );
+        memory.prepare_region( spot, spot + tripoint( SEEX, SEEY, 0 ) );
+        REQUIRE( memory.loaded_regions() <= map_memory::low_memory_loaded_regions );
+    }
+    CHECK( memory.loaded_regions() > map_memory::low_memory_loaded_regions / 2 );
+}
+
 // TODO: map memory save / load
 
 #include <chrono>
@@ -12,6 +12,7 @@
 #include "map.h"
 #include "map_helpers.h"
 #include "map_iterator.h"
+#include "map_scale_constants.h"
 #include "monster.h"
 #include "pathfinding.h"
 #include "point.h"
@@ -649,3 +650,190 @@ TEST_CASE( "map_route_mon_around_danger", "[map][pathfinding]" )
     }
     clear_map_without_vision();
 }
+
+static void check_walkable_route( const map &m, const tripoint_bub_ms &from,
+                                  const tripoint_bub_ms &to, const std::vector<tripoint_bub_ms> &path )
+{
+    REQUIRE( !path.empty() );
+    CHECK( path.back() == to );
+    tripoint_bub_ms prev = from;
+    for( const tripoint_bub_ms &p : path ) {
+        CHECK( square_dist( prev, p ) == 1 );
+        CHECK( m.passable( p ) );
+        prev = p;
+    }
+}
+
+TEST_CASE( "map_route_long_distance_uses_current_terrain", "[map][pathfinding]" )
+{
+    map &m = get_map();
+    clear_map_without_vision();
+    const ter_id t_wall_metal( "t_wall_metal" );
+    const ter_id t_floor( "t_floor" );
+    pathfinding_settings settings;
+    settings.max_dist = 200;
+    settings.max_length = 1000;
+    const tripoint_bub_ms from{ 20, 65, 0 };
+    const tripoint_bub_ms to{ 100, 65, 0 };
+    GIVEN( "A long wall between source and target, with a single gap" ) {
+        /*
+         * Map layout:
+         *   . . # . .    #=wall across the whole map at x=60
+         *   . . . . .    gap at y=20
+         *   @ . # . t
+         *   . . # . .
+         */
+        std::vector<tripoint_bub_ms> wall;
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( y != 20 ) {
+                wall.emplace_back( 60, y, 0 );
+            }
+        }
+        place_obstacle( m, wall );
+        WHEN( "map::route does pathfinding across the map" ) {
+            const std::vector<tripoint_bub_ms> path = m.route( from, pathfinding_target::point( to ),
+                    settings );
+            THEN( "the route goes through the gap" ) {
+                check_walkable_route( m, from, to, path );
+                CHECK( std::find( path.begin(), path.end(), tripoint_bub_ms( 60, 20, 0 ) ) != path.end() );
+            }
+        }
+        WHEN( "the gap is closed and another one is opened further along" ) {
+            m.route( from, pathfinding_target::point( to ), settings );
+            m.ter_set( tripoint_bub_ms( 60, 20, 0 ), t_wall_metal );
+            m.ter_set( tripoint_bub_ms( 60, 110, 0 ), t_floor );
+            const std::vector<tripoint_bub_ms> path = m.route( from, pathfinding_target::point( to ),
+                    settings );
+            THEN( "the route goes through the new gap" ) {
+                check_walkable_route( m, from, to, path );
+                CHECK( std::find( path.begin(), path.end(), tripoint_bub_ms( 60, 110, 0 ) ) != path.end() );
+            }
+        }
+    }
+    clear_map_without_vision();
+}
+
+TEST_CASE( "map_route_reuses_routes_found_this_turn", "[map][pathfinding]" )
+{
+    map &m = setup_map_without_obstacles();
+    pathfinding_settings settings;
+    settings.max_dist = 100;
+    settings.max_length = 500;
+    const tripoint_bub_ms from{ 2, 10, 0 };
+    const pathfinding_target target = pathfinding_target::point( tripoint_bub_ms{ 18, 10, 0 } );
+    // Force a real search instead of the straight line shortcut
+    place_obstacle( m, { { 10, 8, 0 }, { 10, 9, 0 }, { 10, 10, 0 }, { 10, 11, 0 }, { 10, 12, 0 } } );
+
+    const std::vector<tripoint_bub_ms> path = m.route( from, target, settings );
+    REQUIRE( path.size() > 4 );
+    const tripoint_bub_ms &midway = path[3];
+
+    WHEN( "another route to the same target starts on that path" ) {
+        const std::vector<tripoint_bub_ms> suffix = m.route( midway, target, settings );
+        THEN( "it is the rest of the first path" ) {
+            CHECK( suffix == std::vector<tripoint_bub_ms>( path.begin() + 4, path.end() ) );
+        }
+    }
+    WHEN( "the avoid callback rejects a tile of the stored path" ) {
+        const tripoint_bub_ms rejected = path[5];
+        const std::vector<tripoint_bub_ms> other = m.route( midway, target, settings,
+        [&rejected]( const tripoint_bub_ms & p ) {
+            return p == rejected;
+        } );
+        THEN( "a new route is searched for" ) {
+            REQUIRE( !other.empty() );
+            CHECK( std::find( other.begin(), other.end(), rejected ) == other.end() );
+        }
+    }
+    WHEN( "the terrain on the stored path changes" ) {
+        const tripoint_bub_ms blocked = path[5];
+        place_obstacle( m, { blocked } );
+        const std::vector<tripoint_bub_ms> other = m.route( midway, target, settings );
+        THEN( "the stored path is not used" ) {
+            REQUIRE( !other.empty() );
+            CHECK( std::find( other.begin(), other.end(), blocked ) == other.end() );
+        }
+    }
+    clear_map_without_vision();
+}
+
+TEST_CASE( "map_route_many_creatures_to_one_target", "[map][pathfinding]" )
+{
+    map &m = setup_map_without_obstacles();
+    pathfinding_settings settings;
+    settings.max_dist = 100;
+    settings.max_length = 500;
+    const tripoint_bub_ms center{ 10, 10, 0 };
+    const pathfinding_target target = pathfinding_target::adjacent( center );
+    /*
+     * Map layout:
+     *   . . . . . . .    #=wall, T=target center
+     *   . # # # # # .    everything approaches from the south
+     *   . # . T . # .
+     *   . # . . . # .
+     *   . . . . . . .
+     */
+    std::vector<tripoint_bub_ms> walls;
+    for( int x = 7; x <= 13; ++x ) {
+        walls.emplace_back( x, 7, 0 );
+    }
+    for( int y = 8; y <= 12; ++y ) {
+        walls.emplace_back( 7, y, 0 );
+        walls.emplace_back( 13, y, 0 );
+    }
+    place_obstacle( m, walls );
+
+    const std::vector<tripoint_bub_ms> starts = {
+        { 2, 2, 0 }, { 18, 2, 0 }, { 10, 3, 0 }, { 4, 5, 0 }, { 16, 4, 0 }, { 3, 18, 0 }, { 10, 2, 0 }
+    };
+    for( const tripoint_bub_ms &start : starts ) {
+        CAPTURE( start );
+        const std::vector<tripoint_bub_ms> path = m.route( start, target, settings );
+        REQUIRE( !path.empty() );
+        CHECK( target.contains( path.back() ) );
+        tripoint_bub_ms prev = start;
+        for( const tripoint_bub_ms &p : path ) {
+            CHECK( square_dist( prev, p ) == 1 );
+            CHECK( m.passable( p ) );
+            prev = p;
+        }
+    }
+
+    const tripoint_bub_ms rejected{ 10, 13, 0 };
+    const std::vector<tripoint_bub_ms> path = m.route( tripoint_bub_ms{ 10, 18, 0 }, target,
+    settings, [&rejected]( const tripoint_bub_ms & p ) {
+        return p == rejected;
+    } );
+    REQUIRE( !path.empty() );
+    CHECK( std::find( path.begin(), path.end(), rejected ) == path.end() );
+    clear_map_without_vision();
+}
+
+TEST_CASE( "map_route_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    map &m = get_map();
+    clear_map_without_vision();
+    pathfinding_settings settings;
+    settings.max_dist = 200;
+    settings.max_length = 1000;
+    // A wall across the middle with one gap near its end, so the search has to go around.
+    std::vector<tripoint_bub_ms> wall;
+    for( int y = 10; y < 110; ++y ) {
+        if( y != 100 ) {
+            wall.emplace_back( 60, y, 0 );
+        }
+    }
+    place_obstacle( m, wall );
+    const tripoint_bub_ms from{ 20, 60, 0 };
+    const pathfinding_target target = pathfinding_target::point( tripoint_bub_ms{ 100, 60, 0 } );
+    REQUIRE( !m.route( from, target, settings ).empty() );
+
+    const time_point start_turn = calendar::turn;
+    BENCHMARK( "route around a wall" ) {
+        // Routes are remembered for the rest of the turn, each run has to search.
+        calendar::turn += 1_turns;
+        return m.route( from, target, settings ).size();
+    };
+    calendar::turn = start_turn;
+    clear_map_without_vision();
+}
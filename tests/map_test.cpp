@@ -1,3 +1,5 @@
+#include <bitset>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -19,12 +21,17 @@
 #include "item.h"
 #include "item_contents.h"
 #include "item_location.h"
+#include "level_cache.h"
 #include "itype.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "map_scale_constants.h"
 #include "map_selector.h"
+#include "mapbuffer.h"
 #include "monster.h"
+#include "options_helpers.h"
+#include "overmapbuffer.h"
+#include "player_helpers.h"
 #include "pocket_type.h"
 #include "point.h"
 #include "ret_val.h"
@@ -32,14 +39,26 @@
 #include "type_id.h"
 #include "units.h"
 #include "value_ptr.h"
+#include "vehicle.h"
+#include "vpart_position.h"
 #include "weather.h"
 
+static const field_type_str_id field_fd_fire( "fd_fire" );
+
+static const furn_str_id furn_f_fireplace( "f_fireplace" );
+static const furn_str_id furn_f_hay( "f_hay" );
+
 static const itype_id itype_almond_milk( "almond_milk" );
 static const itype_id itype_bag_plastic( "bag_plastic" );
 static const itype_id itype_bottle_plastic( "bottle_plastic" );
 static const itype_id itype_cookies( "cookies" );
 static const itype_id itype_disinfectant( "disinfectant" );
 
+static const trap_str_id tr_beartrap( "tr_beartrap" );
+static const trap_str_id tr_funnel( "tr_funnel" );
+
+static const vproto_id vehicle_prototype_test_shopping_cart( "test_shopping_cart" );
+
 TEST_CASE( "map_coordinate_conversion_functions" )
 {
     map &here = get_map();
@@ -184,6 +203,33 @@ void map::check_submap_active_item_consistency()
     }
 }
 
+TEST_CASE( "transparency_cache_region_invalidation", "[map][lightmap]" )
+{
+    clear_map();
+    map &here = get_map();
+    here.build_map_cache( 0, true );
+    const std::bitset<MAPSIZE *MAPSIZE> &dirty = here.get_cache_ref( 0 ).transparency_cache_dirty;
+    REQUIRE( dirty.none() );
+
+    // A rectangle straddling the corner of four submaps dirties exactly those four.
+    here.set_transparency_cache_dirty( tripoint_bub_ms( SEEX - 1, SEEY - 1, 0 ),
+                                       tripoint_bub_ms( SEEX, SEEY, 0 ) );
+    CHECK( dirty.count() == 4 );
+    CHECK( dirty[0 * MAPSIZE + 0] );
+    CHECK( dirty[0 * MAPSIZE + 1] );
+    CHECK( dirty[1 * MAPSIZE + 0] );
+    CHECK( dirty[1 * MAPSIZE + 1] );
+
+    here.build_map_cache( 0, true );
+    REQUIRE( dirty.none() );
+
+    // Out of bounds corners are clipped to the map instead of wrapping around.
+    here.set_transparency_cache_dirty( tripoint_bub_ms( -50, -50, 0 ), tripoint_bub_ms( 2, 2, 0 ) );
+    CHECK( dirty.count() == 1 );
+    CHECK( dirty[0] );
+    here.build_map_cache( 0, true );
+}
+
 TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
 {
     // Regression test for the situation where game::place_player would misuse
@@ -193,6 +239,43 @@ TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
     get_map().check_submap_active_item_consistency();
 }
 
+TEST_CASE( "map_shift_moves_vehicle_caches_along", "[map][vehicle]" )
+{
+    clear_map_without_vision();
+    clear_vehicles();
+    map &here = get_map();
+    vehicle *staying = here.add_vehicle( vehicle_prototype_test_shopping_cart, { 60, 60, 0 },
+                                         0_degrees, 0, 0 );
+    // On the column of submaps that drops off when shifting east.
+    vehicle *leaving = here.add_vehicle( vehicle_prototype_test_shopping_cart, { 3, 60, 0 },
+                                         0_degrees, 0, 0 );
+    REQUIRE( staying != nullptr );
+    REQUIRE( leaving != nullptr );
+    const tripoint_abs_ms staying_pos = here.get_abs( tripoint_bub_ms( 60, 60, 0 ) );
+    const tripoint_abs_ms leaving_pos = here.get_abs( tripoint_bub_ms( 3, 60, 0 ) );
+
+    here.shift( point_rel_sm::east );
+    const level_cache &cache = here.access_cache( 0 );
+    CHECK( cache.vehicle_list.count( staying ) == 1 );
+    CHECK( cache.vehicle_list.count( leaving ) == 0 );
+    optional_vpart_position vp = here.veh_at( staying_pos );
+    REQUIRE( vp );
+    CHECK( &vp->vehicle() == staying );
+    const tripoint_bub_ms shifted = here.get_bub( staying_pos );
+    CHECK( cache.get_veh_exists_at( shifted ) );
+    CHECK_FALSE( cache.get_veh_exists_at( shifted + point::east * SEEX ) );
+
+    // Back in with the submap it is on.
+    here.shift( point_rel_sm::west );
+    vp = here.veh_at( leaving_pos );
+    REQUIRE( vp );
+    CHECK( here.access_cache( 0 ).vehicle_list.count( &vp->vehicle() ) == 1 );
+    vp = here.veh_at( staying_pos );
+    REQUIRE( vp );
+    CHECK( &vp->vehicle() == staying );
+    clear_vehicles();
+}
+
 TEST_CASE( "inactive_container_with_active_contents", "[active_item][map]" )
 {
     map &here = get_map();
@@ -328,3 +411,126 @@ TEST_CASE( "active_monster_drops", "[active_item][map]" )
     }
     CHECK( dropped_bag.empty() );
 }
+
+TEST_CASE( "item_tiles_near_follows_item_stacks", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint_bub_ms center( 60, 60, 0 );
+    REQUIRE( here.item_tiles_near( center, 12 ).empty() );
+
+    const tripoint_bub_ms near_tile = center + point( 3, -2 );
+    const tripoint_bub_ms far_tile = center + point( 13, 0 );
+    here.add_item( near_tile, item( itype_bag_plastic ) );
+    here.add_item( near_tile, item( itype_bag_plastic ) );
+    here.add_item( far_tile, item( itype_bag_plastic ) );
+    CHECK( here.item_tiles_near( center, 12 ) == std::vector<tripoint_bub_ms> { near_tile } );
+    CHECK( here.item_tiles_near( center, 13 ).size() == 2 );
+
+    here.i_clear( near_tile );
+    CHECK( here.item_tiles_near( center, 12 ).empty() );
+    // Removing through an item_location goes through the same index.
+    item_location loc( map_cursor( far_tile ), &here.i_at( far_tile ).only_item() );
+    loc.remove_item();
+    CHECK( here.item_tiles_near( center, 13 ).empty() );
+}
+
+TEST_CASE( "trap_tiles_near_follows_traps", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint_bub_ms center( 60, 60, 0 );
+    REQUIRE( here.trap_tiles_near( center, 5 ).empty() );
+
+    // Set out of order and across a submap border, listed y first then x.
+    const tripoint_bub_ms below = center + point( -4, 3 );
+    const tripoint_bub_ms above = center + point( 5, -1 );
+    const tripoint_bub_ms far_tile = center + point( 6, 0 );
+    here.trap_set( below, tr_beartrap.id() );
+    here.trap_set( above, tr_funnel.id() );
+    here.trap_set( far_tile, tr_funnel.id() );
+    CHECK( here.trap_tiles_near( center, 5 ) == std::vector<tripoint_bub_ms> { above, below } );
+    CHECK( here.trap_tiles_near( center, 6 ).size() == 3 );
+
+    here.remove_trap( above );
+    CHECK( here.trap_tiles_near( center, 5 ) == std::vector<tripoint_bub_ms> { below } );
+    clear_map();
+    CHECK( here.trap_tiles_near( center, 6 ).empty() );
+}
+
+TEST_CASE( "active_zlevels_follow_range_and_creatures", "[map][zlevels]" )
+{
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    REQUIRE( get_avatar().posz() == 0 );
+    {
+        override_option all_levels( "ACTIVE_Z_RANGE", "0" );
+        CHECK( here.active_zlevels( 0 ).all() );
+    }
+    override_option near_levels( "ACTIVE_Z_RANGE", "1" );
+    const std::bitset<OVERMAP_LAYERS> around_avatar = here.active_zlevels( 0 );
+    CHECK( around_avatar.count() == 3 );
+    CHECK( around_avatar[OVERMAP_DEPTH - 1] );
+    CHECK( around_avatar[OVERMAP_DEPTH + 1] );
+    // Looking at another level keeps the avatar's level, it holds a creature.
+    const std::bitset<OVERMAP_LAYERS> above = here.active_zlevels( 4 );
+    CHECK( above.count() == 4 );
+    CHECK( above[OVERMAP_DEPTH] );
+    CHECK( above[OVERMAP_DEPTH + 3] );
+    CHECK( above[OVERMAP_DEPTH + 5] );
+}
+
+TEST_CASE( "queued_mapgen_generates_the_stacks_a_shift_would_load", "[map][slow]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint_abs_sm before = here.get_abs_sub();
+    // Two OMTs east of the middle, so the stacks past the east edge are queued.
+    const tripoint_abs_ms east = project_to<coords::ms>( before + tripoint( HALF_MAPSIZE + 4,
+                                 HALF_MAPSIZE, 0 ) );
+    here.queue_mapgen_toward( east );
+    here.generate_queued_mapgen( std::chrono::hours( 1 ) );
+    CHECK( here.get_abs_sub() == before );
+    const tripoint_abs_sm past_edge = before + tripoint( MAPSIZE + 1, HALF_MAPSIZE, 0 );
+    CHECK( MAPBUFFER.submap_exists( past_edge ) );
+    CHECK( MAPBUFFER.submap_exists( past_edge + tripoint::below ) );
+}
+
+TEST_CASE( "contained_fires_are_not_handed_to_the_overmap", "[map][fire]" )
+{
+    clear_map();
+    map &here = get_map();
+    // Both on the west edge, so they leave with a shift east, in different OMTs.
+    const tripoint_bub_ms in_fireplace( 3, 2 * SEEY + 3, 0 );
+    const tripoint_bub_ms in_the_open( 3, 6 * SEEY + 3, 0 );
+    const tripoint_abs_omt fireplace_omt = project_to<coords::omt>( here.get_abs( in_fireplace ) );
+    const tripoint_abs_omt open_omt = project_to<coords::omt>( here.get_abs( in_the_open ) );
+    overmap_buffer.remove_fire( fireplace_omt );
+    overmap_buffer.remove_fire( open_omt );
+    here.furn_set( in_fireplace, furn_f_fireplace );
+    REQUIRE( here.add_field( in_fireplace, field_fd_fire, 1 ) );
+    here.furn_set( in_the_open + point::east, furn_f_hay );
+    REQUIRE( here.add_field( in_the_open, field_fd_fire, 1 ) );
+
+    here.shift( point_rel_sm( 1, 0 ) );
+    CHECK( overmap_buffer.fire_at( fireplace_omt ) == nullptr );
+    CHECK( overmap_buffer.fire_at( open_omt ) != nullptr );
+    overmap_buffer.remove_fire( open_omt );
+    here.shift( point_rel_sm( -1, 0 ) );
+    clear_map();
+}
+
+TEST_CASE( "low_memory_profile_narrows_active_zlevels", "[map][zlevels][memory_budget]" )
+{
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    REQUIRE( get_avatar().posz() == 0 );
+    override_option low_memory( "LOW_MEMORY_PROFILE", "true" );
+    override_option all_levels( "ACTIVE_Z_RANGE", "0" );
+    const std::bitset<OVERMAP_LAYERS> around_avatar = here.active_zlevels( 0 );
+    CHECK( around_avatar.count() == 3 );
+    CHECK( around_avatar[OVERMAP_DEPTH - 1] );
+    CHECK( around_avatar[OVERMAP_DEPTH + 1] );
+}
@@ -132,6 +132,14 @@ TEST_CASE( "math_parser_parsing", "[math_parser]" )
     CHECK( testexp.eval( d ) == Approx( std::cos( std::sin( 1.0 ) ) ) );
     CHECK( testexp.parse( "sin(-(-(-(-2))))" ) );
     CHECK( testexp.eval( d ) == Approx( std::sin( 2 ) ) );
+    // constant arguments are folded when parsing, but rng() and rand() must still roll each time
+    CHECK( testexp.parse( "rand( 1000000 ) + 2 * 0" ) );
+    double const first_roll = testexp.eval( d );
+    bool rolled_again = false;
+    for( int i = 0; i < 20 && !rolled_again; i++ ) {
+        rolled_again = testexp.eval( d ) != first_roll;
+    }
+    CHECK( rolled_again );
     CHECK( testexp.parse( "max( 1, 2, 3, 4, 5, 6 )" ) );
     CHECK( testexp.eval( d ) == Approx( 6 ) );
     CHECK( testexp.parse( "cos( sin( min( 1 + 2, -50 ) ) )" ) );
@@ -331,6 +339,13 @@ TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
     globvars.set_global_value( "x", 100 );
     CHECK( testexp.parse( "x" ) );
     CHECK( testexp.eval( d ) == Approx( 100 ) );
+    // the remembered global lookup follows overwrites and removals
+    globvars.set_global_value( "x", 101 );
+    CHECK( testexp.eval( d ) == Approx( 101 ) );
+    globvars.remove_global_value( "x" );
+    CHECK( testexp.eval( d ) == Approx( 0 ) );
+    globvars.set_global_value( "x", 100 );
+    CHECK( testexp.eval( d ) == Approx( 100 ) );
     get_avatar().set_value( "x", 92 );
     CHECK( testexp.parse( "u_x" ) );
     CHECK( testexp.eval( d ) == Approx( 92 ) );
@@ -435,3 +450,32 @@ TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
     CHECK( get_avatar().get_stamina() == 459 );
 
 }
+
+TEST_CASE( "math_parser_eval_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    global_variables &globvars = get_globals();
+    globvars.set_global_value( "bench_x", 100 );
+    get_avatar().set_value( "bench_x", 92 );
+
+    math_exp arithmetic;
+    REQUIRE( arithmetic.parse( "50 + 2 * 3 ^ 2 - ( 7 % 3 ) / 2" ) );
+    math_exp variables;
+    REQUIRE( variables.parse( "bench_x * 2 + u_bench_x - n_bench_x" ) );
+    math_exp functions;
+    REQUIRE( functions.parse( "max( min( bench_x, 40 ), sqrt( u_bench_x ) ) + u_val('stamina')" ) );
+
+    BENCHMARK( "arithmetic" ) {
+        return arithmetic.eval( d );
+    };
+    BENCHMARK( "variables" ) {
+        return variables.eval( d );
+    };
+    BENCHMARK( "functions" ) {
+        return functions.eval( d );
+    };
+
+    globvars.remove_global_value( "bench_x" );
+    get_avatar().remove_value( "bench_x" );
+}
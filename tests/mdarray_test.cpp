@@ -15,3 +15,22 @@ TEST_CASE( "mdarray_default_size_sensible", "[mdarray]" )
     static_assert( mdarray<int, point_om_omt>::size_x == OMAPX );
     static_assert( mdarray<int, point_om_omt>::size_y == OMAPY );
 }
+
+TEST_CASE( "mdbitset_reads_and_writes_like_bools", "[mdarray]" )
+{
+    using cata::mdbitset;
+    static_assert( mdbitset<point_bub_ms>::size_x == MAPSIZE_X );
+    static_assert( mdbitset<point_bub_ms>::size_y == MAPSIZE_Y );
+    static_assert( sizeof( mdbitset<point_bub_ms> ) < sizeof( cata::mdarray<bool, point_bub_ms> ) / 4 );
+
+    mdbitset<point_bub_ms> grid;
+    CHECK_FALSE( grid[point_bub_ms( 3, 5 )] );
+    grid[3][5] = true;
+    CHECK( grid[point_bub_ms( 3, 5 )] );
+    CHECK_FALSE( grid[5][3] );
+    grid.fill( true );
+    CHECK( grid[MAPSIZE_X - 1][MAPSIZE_Y - 1] );
+    grid[point_bub_ms( 0, 0 )] = false;
+    CHECK_FALSE( grid[0][0] );
+    CHECK( grid[0][1] );
+}
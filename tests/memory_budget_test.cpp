@@ -0,0 +1,15 @@
+#include "cata_catch.h"
+#include "memory_budget.h"
+#include "options_helpers.h"
+
+TEST_CASE( "memory_budget_reads_what_the_process_holds", "[memory_budget]" )
+{
+#if defined(__linux__)
+    CHECK( memory_budget::resident_bytes() > 0 );
+#endif
+    override_option no_budget( "MEMORY_BUDGET_MB", "0" );
+    override_option no_profile( "LOW_MEMORY_PROFILE", "false" );
+    CHECK( memory_budget::budget_bytes() == 0 );
+    // Nothing to keep to, so nothing is shed.
+    CHECK_FALSE( memory_budget::check() );
+}
@@ -0,0 +1,44 @@
+#include <cstddef>
+#include <string>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "memory_report.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "type_id.h"
+
+static const itype_id itype_backpack( "backpack" );
+static const itype_id itype_rock( "rock" );
+
+static size_t count_of( const memory_report::report &rep, const std::string &kind )
+{
+    const auto it = rep.entries().find( kind );
+    return it == rep.entries().end() ? 0 : it->second.count;
+}
+
+TEST_CASE( "memory_report_counts_map_items", "[memory_report]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    map &here = get_map();
+    const tripoint_bub_ms spot = get_avatar().pos_bub() + point::east;
+
+    const memory_report::report before = memory_report::collect();
+    CHECK( count_of( before, "submaps" ) > 0 );
+    CHECK( count_of( before, "overmaps" ) > 0 );
+
+    item backpack( itype_backpack );
+    REQUIRE( backpack.put_in( item( itype_rock ), pocket_type::CONTAINER ).success() );
+    here.add_item( spot, backpack );
+    const memory_report::report after = memory_report::collect();
+    // The backpack and the rock inside it.
+    CHECK( count_of( after, "map_items" ) == count_of( before, "map_items" ) + 2 );
+    CHECK( after.total_bytes() > before.total_bytes() );
+
+    clear_map_without_vision();
+}
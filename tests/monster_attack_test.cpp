@@ -622,3 +622,41 @@ TEST_CASE( "Unified_grab_break_test", "[mattack][grab]" )
     // 2,5% margin
     CHECK( success == Approx( expected_success ).margin( 250 ) );
 }
+
+TEST_CASE( "Mattack_preconditions_gate_calls", "[mattack]" )
+{
+    map &here = get_map();
+
+    const tripoint_bub_ms target_location = attacker_location + tripoint::east;
+
+    clear_map_without_vision();
+    clear_creatures();
+    Character &you = get_player_character();
+    clear_avatar();
+    you.setpos( here, target_location );
+
+    monster &test_monster = spawn_test_monster( "mon_debug_grabber_right", attacker_location );
+    const mattack_actor &attack = test_monster.type->special_attacks.at( "grab" ).operator * ();
+
+    // Nowhere to go, nobody to grab
+    test_monster.unset_dest();
+    CHECK( !attack.may_fire( test_monster ) );
+    CHECK( !attack.call( test_monster ) );
+
+    // Heading for an empty tile
+    test_monster.set_dest( here.get_abs( target_location + tripoint::south ) );
+    CHECK( !attack.may_fire( test_monster ) );
+    CHECK( !attack.call( test_monster ) );
+
+    // Heading for a target out of reach
+    you.setpos( here, attacker_location + tripoint( 5, 0, 0 ) );
+    test_monster.set_dest( you.pos_abs() );
+    CHECK( !attack.may_fire( test_monster ) );
+    CHECK( !attack.call( test_monster ) );
+
+    // Adjacent target
+    you.setpos( here, target_location );
+    test_monster.set_dest( you.pos_abs() );
+    CHECK( attack.may_fire( test_monster ) );
+    CHECK( attack.call( test_monster ) );
+}
@@ -37,6 +37,7 @@
 #include "mtype.h"
 #include "options.h"
 #include "options_helpers.h"
+#include "overmap.h"
 #include "overmap_map_data_cache.h"
 #include "overmapbuffer.h"
 #include "point.h"
@@ -60,6 +61,7 @@ static const oter_str_id oter_field( "field" );
 static const ter_str_id ter_t_fence( "t_fence" );
 static const ter_str_id ter_t_grass( "t_grass" );
 static const ter_str_id ter_t_palisade( "t_palisade" );
+static const ter_str_id ter_t_wall( "t_wall" );
 static const ter_str_id ter_t_water_dp( "t_water_dp" );
 
 
@@ -844,6 +846,30 @@ TEST_CASE( "monster_can_navigate_from_overmap_to_reality_bubble", "[monster][hor
     test_move_to_location( local_test_monster, destination );
 }
 
+TEST_CASE( "horde_entity_held_back_across_an_overmap_border", "[monster][hordes]" )
+{
+    clear_map_and_put_player_underground();
+    map &m = get_map();
+    // Walled in, so the entity can't be placed and stays outside.
+    const tripoint_bub_ms entry( 0, 66, 0 );
+    for( const tripoint_bub_ms &p : points_in_radius( entry, 1 ) ) {
+        m.ter_set( p, ter_t_wall );
+    }
+    // A catch-up step from the overmap to the west that ended across the border.
+    const point_abs_om east_om = project_to<coords::om>( m.get_abs( entry ).xy() );
+    overmap_buffer.get( east_om + point::west );
+    const tripoint_abs_ms from( project_to<coords::ms>( east_om ), 0 );
+    const tripoint_abs_ms origin = from + point::west;
+    REQUIRE( project_to<coords::om>( origin.xy() ) == east_om + point::west );
+    overmap_buffer.spawn_monster( origin, mon_test_zombie );
+
+    overmap::settle_horde_arrivals( { { origin, from, m.get_abs( entry ) } } );
+    CHECK( g->num_creatures() == 1 );
+    CHECK( overmap_buffer.entity_at( origin ) == nullptr );
+    CHECK( overmap_buffer.entity_at( from ) != nullptr );
+    clear_map();
+}
+
 TEST_CASE( "monster_can_navigate_from_overmap_to_reality_bubble_following_sound",
            "[monster][hordes][sound]" )
 {
@@ -956,6 +982,33 @@ TEST_CASE( "monster_cant_enter_reality_bubble_because_wall", "[monster][hordes]"
     REQUIRE( g->num_creatures() == 1 );
 }
 
+TEST_CASE( "horde_reaching_reality_bubble_spawns_a_few_per_turn", "[monster][hordes]" )
+{
+    // Remove interacting with the player as a complication.
+    clear_map_and_put_player_underground();
+    map &m = get_map();
+    const int horde_size = 40;
+    // A column of entities just outside the reality bubble, all walking straight in.
+    for( int i = 0; i < horde_size; ++i ) {
+        const tripoint_abs_ms spawn_location = m.get_abs( { -1, 46 + i, 0 } );
+        overmap_buffer.spawn_monster( spawn_location, mon_test_zombie );
+        overmap_buffer.alert_entity( spawn_location, m.get_abs( { 66, 46 + i, 0 } ), 100 );
+    }
+    int num_steps = 0;
+    int spawned = 0;
+    do {
+        num_steps++;
+        overmap_buffer.move_hordes();
+        calendar::turn += 1_turns;
+        const int now_spawned = g->num_creatures() - 1;
+        // The ones held back stay outside and try again.
+        CHECK( now_spawned - spawned <= 16 );
+        spawned = now_spawned;
+    } while( spawned < horde_size && num_steps < 100 );
+    CAPTURE( num_steps );
+    CHECK( spawned == horde_size );
+}
+
 // The idea here is we wipe all the map data and place the player at world origin so that
 // when we flatten the overmap area we will be using we don't have pre-existing mapgen outputs.
 // EG the failure that led to this was the monster being placed in a lake,
@@ -1292,3 +1345,65 @@ TEST_CASE( "dormant_zombie_places_corpse_and_trap", "[monster][map]" )
     // The monster count should have dropped by one since it destroyed itself.
     CHECK( g->num_creatures() == 1 );
 }
+
+TEST_CASE( "monster_ai_detail_drops_with_distance", "[monster]" )
+{
+    clear_map_and_put_player_underground();
+    clear_creatures();
+    // The player sits at ( 0, 0, -2 ).
+    monster &near_mon = spawn_test_monster( "mon_zombie", tripoint_bub_ms( 10, 10, 0 ) );
+    monster &mid_mon = spawn_test_monster( "mon_zombie", tripoint_bub_ms( 40, 40, 0 ) );
+    monster &far_mon = spawn_test_monster( "mon_zombie", tripoint_bub_ms( 100, 100, 0 ) );
+    REQUIRE( near_mon.is_wandering() );
+
+    CHECK( near_mon.ai_lod() == monster_lod::full );
+    CHECK( mid_mon.ai_lod() == monster_lod::reduced );
+    CHECK( far_mon.ai_lod() == monster_lod::coarse );
+
+    SECTION( "mid range monsters plan every few turns" ) {
+        mid_mon.plan();
+        CHECK_FALSE( mid_mon.lod_plan_due( monster_lod::reduced ) );
+        calendar::turn += 4_turns;
+        CHECK( mid_mon.lod_plan_due( monster_lod::reduced ) );
+        CHECK_FALSE( far_mon.lod_plan_due( monster_lod::coarse ) );
+    }
+
+    SECTION( "a sound promotes a far monster at once" ) {
+        far_mon.wander_to( far_mon.pos_abs() + point( 5, 0 ), 10 );
+        CHECK( far_mon.ai_lod() == monster_lod::full );
+    }
+
+    SECTION( "damage promotes a far monster at once" ) {
+        far_mon.apply_damage( nullptr, bodypart_id( "torso" ), 1 );
+        CHECK( far_mon.ai_lod() == monster_lod::full );
+        calendar::turn += 1_hours;
+        CHECK( far_mon.ai_lod() == monster_lod::coarse );
+    }
+
+    SECTION( "a goal promotes a far monster at once" ) {
+        far_mon.set_dest( far_mon.pos_abs() + point( 5, 0 ) );
+        CHECK( far_mon.ai_lod() == monster_lod::full );
+    }
+}
+
+TEST_CASE( "sounds_from_one_tile_reach_monsters_as_one_source", "[monster][sound]" )
+{
+    clear_map_without_vision();
+    sounds::reset_sounds();
+
+    const tripoint_bub_ms turret( 60, 60, 0 );
+    const tripoint_bub_ms door( 70, 60, 0 );
+    // An automatic burst and a slammed door.
+    for( int i = 0; i < 30; i++ ) {
+        sounds::sound( turret, 80, sounds::sound_t::combat, "Brrrap!" );
+    }
+    sounds::sound( door, 20, sounds::sound_t::activity, "Slam!" );
+
+    const std::pair<std::vector<tripoint_bub_ms>, std::vector<tripoint_bub_ms>> heard =
+                sounds::get_monster_sounds();
+    CHECK( heard.first.size() == 31 );
+    REQUIRE( heard.second.size() == 2 );
+    CHECK( std::count( heard.second.begin(), heard.second.end(), turret ) == 1 );
+    CHECK( std::count( heard.second.begin(), heard.second.end(), door ) == 1 );
+    sounds::reset_sounds();
+}
@@ -55,6 +55,7 @@ static const item_group_id Item_spawn_data_SUS_trash_forest_manmade( "SUS_trash_
 static const item_group_id Item_spawn_data_test_NPC_guns( "test_NPC_guns" );
 
 static const itype_id itype_M24( "M24" );
+static const itype_id itype_ballistic_vest_esapi( "ballistic_vest_esapi" );
 static const itype_id itype_bat( "bat" );
 static const itype_id itype_debug_backpack( "debug_backpack" );
 static const itype_id itype_leather_belt( "leather_belt" );
@@ -693,3 +694,117 @@ TEST_CASE( "npc_prefers_guns", "[npc_ai]" )
     CAPTURE( hostile.get_wielded_item().get_item()->tname() );
     REQUIRE( hostile.get_wielded_item().get_item()->is_gun() );
 }
+
+TEST_CASE( "npc_ai_replans_are_throttled_by_priority", "[npc_ai]" )
+{
+    g->faction_manager_ptr->create_if_needed();
+
+    clear_map_without_vision();
+    clear_avatar();
+    set_time_to_day();
+    calendar::turn += 1_turns;
+
+    Character &player_character = get_player_character();
+    const point_bub_ms far_away = player_character.pos_bub().xy() + point( 40, 0 );
+    npc &worker = spawn_npc( far_away, "test_talker" );
+    worker.set_attitude( NPCATT_NULL );
+    REQUIRE( rl_dist( player_character.pos_bub(), worker.pos_bub() ) > 2 * SEEX );
+
+    SECTION( "a calm distant NPC re-plans every few turns" ) {
+        REQUIRE( worker.take_replan_slot() );
+        CHECK( worker.ai_priority() == npc_ai_priority::background );
+        CHECK_FALSE( worker.take_replan_slot() );
+        int replans = 0;
+        for( int i = 0; i < 15; i++ ) {
+            calendar::turn += 1_turns;
+            replans += worker.take_replan_slot() ? 1 : 0;
+        }
+        CHECK( replans == 3 );
+    }
+
+    SECTION( "being attacked forces the next re-plan" ) {
+        REQUIRE( worker.take_replan_slot() );
+        calendar::turn += 1_turns;
+        worker.on_attacked( player_character );
+        CHECK( worker.ai_priority() == npc_ai_priority::combat );
+        CHECK( worker.take_replan_slot() );
+    }
+
+    SECTION( "a hostile nearby wakes a distant NPC at once" ) {
+        REQUIRE( worker.take_replan_slot() );
+        calendar::turn += 1_turns;
+        monster &zombie = spawn_test_monster( "mon_zombie", worker.pos_bub() + point( 5, 0 ) );
+        REQUIRE( zombie.attitude_to( worker ) == Creature::Attitude::HOSTILE );
+        CHECK( worker.ai_priority() == npc_ai_priority::combat );
+        CHECK( worker.take_replan_slot() );
+        CHECK( worker.take_replan_slot() );
+    }
+
+    SECTION( "NPCs near the player share the per-turn budget" ) {
+        std::vector<npc *> crowd;
+        for( int i = 0; i < 12; i++ ) {
+            npc &guy = spawn_npc( player_character.pos_bub().xy() + point( i - 6, 3 ), "test_talker" );
+            guy.set_attitude( NPCATT_NULL );
+            crowd.push_back( &guy );
+        }
+        for( npc *guy : crowd ) {
+            REQUIRE( guy->take_replan_slot() );
+            CHECK( guy->ai_priority() == npc_ai_priority::near_player );
+        }
+        calendar::turn += 1_turns;
+        int replans = 0;
+        for( npc *guy : crowd ) {
+            replans += guy->take_replan_slot() ? 1 : 0;
+        }
+        CHECK( replans == 8 );
+        // Whoever missed out is overdue on the next turn and re-plans regardless.
+        calendar::turn += 1_turns;
+        replans = 0;
+        for( npc *guy : crowd ) {
+            replans += guy->take_replan_slot() ? 1 : 0;
+        }
+        CHECK( replans == 12 );
+    }
+}
+
+TEST_CASE( "npc_armour_estimate_is_shared_until_worn_items_change", "[npc_ai]" )
+{
+    clear_map_without_vision();
+    clear_avatar();
+    calendar::turn += 1_turns;
+
+    Character &player_character = get_player_character();
+    npc &first = spawn_npc( player_character.pos_bub().xy() + point( 3, 0 ), "test_talker" );
+    npc &second = spawn_npc( player_character.pos_bub().xy() + point( -3, 0 ), "test_talker" );
+
+    const float bare = first.estimate_armour( player_character );
+    CHECK( player_character.cached_armour_estimate_turn == calendar::turn );
+    CHECK( second.estimate_armour( player_character ) == bare );
+
+    // Putting on armour is seen at once, without waiting for the next turn.
+    player_character.wear_item( item( itype_ballistic_vest_esapi ), false );
+    const float armoured = second.estimate_armour( player_character );
+    CHECK( armoured > bare );
+    CHECK( first.estimate_armour( player_character ) == armoured );
+}
+
+TEST_CASE( "npc_hibernation_drops_bubble_caches", "[npc_ai]" )
+{
+    clear_map_without_vision();
+    clear_avatar();
+
+    Character &player_character = get_player_character();
+    npc &guy = spawn_npc( player_character.pos_bub().xy() + point( 3, 0 ), "test_talker" );
+    guy.path = { guy.pos_bub() + point::east, guy.pos_bub() + point( 2, 0 ) };
+    REQUIRE( guy.take_replan_slot() );
+    REQUIRE_FALSE( guy.is_hibernating() );
+
+    guy.hibernate();
+    CHECK( guy.is_hibernating() );
+    CHECK( guy.path.empty() );
+
+    // Coming back into the bubble wakes it with a fresh plan.
+    guy.on_load( &get_map() );
+    CHECK_FALSE( guy.is_hibernating() );
+    CHECK( guy.take_replan_slot() );
+}
@@ -5,6 +5,7 @@
 
 #include "cata_catch.h"
 #include "options.h"
+#include "options_helpers.h"
 #include "string_formatter.h"
 #include "translation.h"
 #include "type_id.h"
@@ -91,3 +92,18 @@ TEST_CASE( "option_slider_test", "[option]" )
     }
     CHECK( checked == num_slider_options );
 }
+
+TEST_CASE( "option_handle_follows_option_changes", "[option]" )
+{
+    static const option_handle<int> autosave_turns( "AUTOSAVE_TURNS" );
+    static const option_handle<bool> autosave( "AUTOSAVE" );
+    const int old_turns = get_option<int>( "AUTOSAVE_TURNS" );
+    CHECK( autosave_turns.get() == old_turns );
+    {
+        override_option turns( "AUTOSAVE_TURNS", std::to_string( old_turns + 1 ) );
+        override_option enabled( "AUTOSAVE", "true" );
+        CHECK( autosave_turns.get() == old_turns + 1 );
+        CHECK( autosave.get() );
+    }
+    CHECK( autosave_turns.get() == old_turns );
+}
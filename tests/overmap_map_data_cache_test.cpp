@@ -85,3 +85,46 @@ TEST_CASE( "round_trip_bitset_to_base64", "[map_data][hordes]" )
     base64_decode_bitset( packed_bitset, copied_summary.passable );
     CHECK( test_summary.passable == copied_summary.passable );
 }
+
+TEST_CASE( "map_data_summary_flood_fill", "[map_data][hordes]" )
+{
+    // A room with solid walls two squares in from the edges of the OMT.
+    std::bitset<24 * 24> layout;
+    layout.set();
+    for( int i = 2; i < 22; ++i ) {
+        layout.reset( 2 * 24 + i );
+        layout.reset( 21 * 24 + i );
+        layout.reset( i * 24 + 2 );
+        layout.reset( i * 24 + 21 );
+    }
+    map_data_summary summary( layout );
+    std::bitset<24 * 24> inside;
+    inside.set( 10 * 24 + 10 );
+    std::bitset<24 * 24> outside;
+    outside.set( 0 );
+
+    std::bitset<24 * 24> from_inside = summary.reachable_from( inside );
+    CHECK( from_inside.count() == 18 * 18 );
+    CHECK( ( from_inside & map_data_summary::edges() ).none() );
+    std::bitset<24 * 24> from_outside = summary.reachable_from( outside );
+    CHECK( from_outside.count() == 24 * 24 - 20 * 20 );
+    CHECK( ( from_inside & from_outside ).none() );
+
+    // A gap in the corner only lets diagonal movement through.
+    summary.passable.set( 21 * 24 + 21 );
+    from_inside = summary.reachable_from( inside );
+    CHECK( from_inside[23 * 24 + 23] );
+    CHECK( ( from_inside & map_data_summary::edges() ).any() );
+
+    // Squares don't wrap around from one row to the next.
+    std::bitset<24 * 24> column;
+    std::bitset<24 * 24> far_column;
+    for( int y = 0; y < 24; ++y ) {
+        column.set( y * 24 );
+        far_column.set( y * 24 + 23 );
+    }
+    map_data_summary strip( column | far_column );
+    std::bitset<24 * 24> top_left;
+    top_left.set( 0 );
+    CHECK( strip.reachable_from( top_left ) == column );
+}
@@ -1,3 +1,4 @@
+#include <memory>
 #include <string>
 
 #include "cata_catch.h"
@@ -25,3 +26,36 @@ TEST_CASE( "om_noise_layer_lake_export", "[.]" )
     om_debug::export_raw_noise( "lake-map-raw.pgm", f, OMAPX * 5, OMAPY * 5 );
     om_debug::export_interpreted_noise( "lake-map-interp.pgm", f, OMAPX * 5, OMAPY * 5, 0.25, false );
 }
+
+TEST_CASE( "om_noise_grid_matches_its_layer", "[overmap][noise]" )
+{
+    const om_noise::om_noise_layer_ocean f( point_abs_omt( 3 * OMAPX, -2 * OMAPY ), 1920237457 );
+    const om_noise::om_noise_grid grid( f, 5 );
+    for( const point_om_omt &p : {
+             point_om_omt( 0, 0 ), point_om_omt( -5, -5 ), point_om_omt( OMAPX + 4, OMAPY + 4 ),
+             point_om_omt( OMAPX / 2, 7 ), point_om_omt( -6, 3 ), point_om_omt( OMAPX + 5, 0 )
+         } ) {
+        CAPTURE( p );
+        CHECK( grid.noise_at( p ) == f.noise_at( p ) );
+    }
+}
+
+TEST_CASE( "water_noise_grid_is_shared_and_matches_lakes_and_oceans", "[overmap][noise]" )
+{
+    const point_abs_omt origin( -4 * OMAPX, 7 * OMAPY );
+    const std::shared_ptr<const om_noise::om_noise_grid> grid =
+        om_noise::water_noise_grid( origin, 1920237457 );
+    CHECK( om_noise::water_noise_grid( origin, 1920237457 ) == grid );
+    CHECK( om_noise::water_noise_grid( origin, 1920237458 ) != grid );
+
+    const om_noise::om_noise_layer_lake lake( origin, 1920237457 );
+    const om_noise::om_noise_layer_ocean ocean( origin, 1920237457 );
+    for( const point_om_omt &p : {
+             point_om_omt( 0, 0 ), point_om_omt( -5, -5 ), point_om_omt( OMAPX + 4, OMAPY + 4 ),
+             point_om_omt( OMAPX / 2, 7 ), point_om_omt( -6, 3 )
+         } ) {
+        CAPTURE( p );
+        CHECK( grid->noise_at( p ) == lake.noise_at( p ) );
+        CHECK( grid->noise_at( p ) == ocean.noise_at( p ) );
+    }
+}
@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "avatar.h"
 #include "calendar.h"
 #include "cata_catch.h"
 #include "city.h"
@@ -34,9 +35,11 @@
 #include "mapbuffer.h"
 #include "omdata.h"
 #include "options.h"
+#include "options_helpers.h"
 #include "output.h"
 #include "overmap.h"
 #include "overmap_location.h"
+#include "overmap_noise.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
 #include "point.h"
@@ -47,12 +50,16 @@
 #include "value_ptr.h"
 #include "vehicle.h"
 #include "vpart_position.h"
+#include "weather_type.h"
 
 static const oter_str_id oter_cabin( "cabin" );
 static const oter_str_id oter_cabin_east( "cabin_east" );
 static const oter_str_id oter_cabin_north( "cabin_north" );
 static const oter_str_id oter_cabin_south( "cabin_south" );
 static const oter_str_id oter_cabin_west( "cabin_west" );
+static const oter_str_id oter_field( "field" );
+static const oter_str_id oter_forest( "forest" );
+static const oter_str_id oter_lake_surface( "lake_surface" );
 
 static const overmap_special_id overmap_special_Cabin( "Cabin" );
 static const overmap_special_id overmap_special_Lab( "Lab" );
@@ -156,6 +163,83 @@ TEST_CASE( "set_and_get_overmap_scents", "[overmap]" )
     REQUIRE( test_overmap->scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
 
+TEST_CASE( "overmap_fires_burn_out_and_spread_only_over_fuel", "[overmap][fire]" )
+{
+    scoped_weather_override weather_clear( WEATHER_CLEAR );
+    // Far enough that the whole neighbourhood is outside the reality bubble.
+    const tripoint_abs_omt center = project_to<coords::omt>( get_avatar().pos_abs() ) + point( 20, 0 );
+    REQUIRE_FALSE( get_map().inbounds( center + point::west ) );
+    std::vector<std::pair<tripoint_abs_omt, oter_id>> original;
+    for( const point &offset : { point::zero, point::north, point::east, point::south, point::west } ) {
+        original.emplace_back( center + offset, overmap_buffer.ter( center + offset ) );
+    }
+    overmap_buffer.ter_set( center, oter_forest.id() );
+
+    SECTION( "water doesn't burn" ) {
+        for( const point &offset : four_adjacent_offsets ) {
+            overmap_buffer.ter_set( center + offset, oter_lake_surface.id() );
+        }
+        overmap_buffer.note_fire( center, 100 );
+        om_fire *fire = overmap_buffer.fire_at( center );
+        REQUIRE( fire != nullptr );
+        CHECK( fire->fuel == 100 );
+        // Whatever burnt is saved with the submaps.
+        CHECK( fire->materialized == 0xF );
+
+        overmap_buffer.process_fires();
+        fire = overmap_buffer.fire_at( center );
+        REQUIRE( fire != nullptr );
+        CHECK( fire->fuel < 100 );
+        CHECK( fire->materialized == 0 );
+        for( int i = 0; i < 10; ++i ) {
+            overmap_buffer.process_fires();
+        }
+        fire = overmap_buffer.fire_at( center );
+        // Kept burnt out, so it doesn't catch again.
+        REQUIRE( fire != nullptr );
+        CHECK( fire->fuel == 0 );
+        for( const point &offset : four_adjacent_offsets ) {
+            CHECK( overmap_buffer.fire_at( center + offset ) == nullptr );
+        }
+    }
+    SECTION( "forest catches" ) {
+        for( const point &offset : four_adjacent_offsets ) {
+            overmap_buffer.ter_set( center + offset, oter_forest.id() );
+        }
+        overmap_buffer.note_fire( center, 2000 );
+        int caught = 0;
+        for( int i = 0; i < 80 && caught == 0; ++i ) {
+            overmap_buffer.process_fires();
+            for( const point &offset : four_adjacent_offsets ) {
+                caught += overmap_buffer.fire_at( center + offset ) != nullptr ? 1 : 0;
+            }
+        }
+        CHECK( caught > 0 );
+        for( const point &offset : four_adjacent_offsets ) {
+            overmap_buffer.remove_fire( center + offset );
+        }
+    }
+    overmap_buffer.remove_fire( center );
+    for( const std::pair<tripoint_abs_omt, oter_id> &omt : original ) {
+        overmap_buffer.ter_set( omt.first, omt.second );
+    }
+}
+
+TEST_CASE( "overmap_fire_fuel_follows_terrain", "[overmap][fire]" )
+{
+    std::unique_ptr<overmap> test_overmap = std::make_unique<overmap>( point_abs_om() );
+    const tripoint_om_omt forest( 10, 10, 0 );
+    const tripoint_om_omt field( 11, 10, 0 );
+    const tripoint_om_omt lake( 12, 10, 0 );
+    test_overmap->ter_set( forest, oter_forest.id() );
+    test_overmap->ter_set( field, oter_field.id() );
+    test_overmap->ter_set( lake, oter_lake_surface.id() );
+    CHECK( test_overmap->estimated_fire_fuel( forest ) > test_overmap->estimated_fire_fuel( field ) );
+    CHECK( test_overmap->estimated_fire_fuel( field ) > 0 );
+    CHECK( test_overmap->estimated_fire_fuel( lake ) == 0 );
+    CHECK( test_overmap->estimated_fire_fuel( forest + tripoint::below ) == 0 );
+}
+
 TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
 {
     overmap_buffer.clear();
@@ -232,6 +316,145 @@ TEST_CASE( "default_overmap_generation_has_non_mandatory_specials_at_origin", "[
     CHECK( found_optional == true );
 }
 
+TEST_CASE( "overmap_noise_grid_matches_its_layer", "[overmap]" )
+{
+    const om_noise::om_noise_layer_forest forest( point_abs_omt( 180, -360 ), 12345 );
+    const om_noise::om_noise_grid grid( forest, 5 );
+    // Inside the border, on it, and past it where the grid samples directly.
+    for( const point_om_omt &p : {
+             point_om_omt( 0, 0 ), point_om_omt( OMAPX - 1, OMAPY - 1 ), point_om_omt( 17, 92 ),
+             point_om_omt( -5, -5 ), point_om_omt( OMAPX + 4, 3 ), point_om_omt( -6, 0 ),
+             point_om_omt( 0, OMAPY + 5 )
+         } ) {
+        CAPTURE( p );
+        CHECK( grid.noise_at( p ) == forest.noise_at( p ) );
+    }
+}
+
+TEST_CASE( "overmap_buffer_generates_overmaps_ahead_of_the_player", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    const point_abs_om origin( 3, 3 );
+    const tripoint_abs_omt near_east_edge( project_to<coords::omt>( origin ) +
+                                           point( OMAPX - 5, OMAPY / 2 ), 0 );
+    overmap_buffer.get( origin );
+    REQUIRE_FALSE( overmap_buffer.has( origin + point::east ) );
+
+    // A few milliseconds per call, so it takes some.
+    for( int calls = 0; calls < 1000 && !overmap_buffer.has( origin + point::east ); ++calls ) {
+        overmap_buffer.generate_ahead( near_east_edge );
+    }
+    CHECK( overmap_buffer.has( origin + point::east ) );
+    CHECK_FALSE( overmap_buffer.has( origin + point::west ) );
+    CHECK_FALSE( overmap_buffer.has( origin + point::south ) );
+
+    // Nothing left to do in the middle of an overmap.
+    const tripoint_abs_omt middle( project_to<coords::omt>( origin ) +
+                                   point( OMAPX / 2, OMAPY / 2 ), 0 );
+    overmap_buffer.generate_ahead( middle );
+    CHECK_FALSE( overmap_buffer.has( origin + point::west ) );
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "overmaps_generated_ahead_match_the_ones_generated_at_once", "[overmap][slow]" )
+{
+    const point_abs_om origin( -4, 6 );
+    const point_abs_om east = origin + point::east;
+    const tripoint_abs_omt near_east_edge( project_to<coords::omt>( origin ) +
+                                           point( OMAPX - 5, OMAPY / 2 ), 0 );
+    const auto terrain_of = []( const point_abs_om & om ) {
+        std::vector<oter_id> terrain;
+        const point_abs_omt corner = project_to<coords::omt>( om );
+        for( int y = 0; y < OMAPY; ++y ) {
+            for( int x = 0; x < OMAPX; ++x ) {
+                terrain.push_back( overmap_buffer.ter( tripoint_abs_omt( corner + point( x, y ), 0 ) ) );
+            }
+        }
+        return terrain;
+    };
+
+    overmap_buffer.clear();
+    overmap_buffer.get( origin );
+    // Rolls between the steps don't reach the generation.
+    for( int calls = 0; calls < 1000 && !overmap_buffer.has( east ); ++calls ) {
+        overmap_buffer.generate_ahead( near_east_edge );
+        rng( 0, 100 );
+    }
+    REQUIRE( overmap_buffer.has( east ) );
+    const std::vector<oter_id> sliced = terrain_of( east );
+
+    overmap_buffer.clear();
+    overmap_buffer.get( origin );
+    overmap_buffer.get( east );
+    CHECK( terrain_of( east ) == sliced );
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "omt_generation_seeds_only_depend_on_the_game_seed_and_position", "[overmap]" )
+{
+    const tripoint_abs_omt p( 301, -77, 0 );
+    const unsigned int seed = overmap_buffer.generation_seed( p, "mapgen" );
+    CHECK( seed == rng_stream_seed( g->get_seed(), p, "mapgen" ) );
+    overmap_buffer.clear();
+    CHECK( overmap_buffer.generation_seed( p, "mapgen" ) == seed );
+    CHECK( overmap_buffer.generation_seed( p + tripoint::above, "mapgen" ) != seed );
+}
+
+TEST_CASE( "overmap_generation_keeps_the_game_rng_stream", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    rng_set_engine_seed( 4242 );
+    const int expected = rng( 0, 1000000 );
+    rng_set_engine_seed( 4242 );
+    overmap_buffer.get( point_abs_om( -7, 11 ) );
+    CHECK( rng( 0, 1000000 ) == expected );
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "overmap_buffer_ter_block_matches_single_lookups", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    // Straddles the corner where four overmaps meet.
+    const point_abs_omt corner = project_to<coords::omt>( point_abs_om( 2, 2 ) );
+    const inclusive_rectangle<point_abs_omt> area( corner - point( 3, 2 ), corner + point( 2, 3 ) );
+    const std::vector<oter_id> block = overmap_buffer.ter_block( area, 0 );
+    REQUIRE( block.size() == 36 );
+    size_t idx = 0;
+    for( int y = area.p_min.y(); y <= area.p_max.y(); ++y ) {
+        for( int x = area.p_min.x(); x <= area.p_max.x(); ++x ) {
+            CAPTURE( x, y );
+            CHECK( block[idx++] == overmap_buffer.ter( tripoint_abs_omt( x, y, 0 ) ) );
+        }
+    }
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "overmap_layer_arrays_hold_one_value_until_it_varies", "[overmap]" )
+{
+    om_layer_array<om_vision_level> visible;
+    visible.fill( om_vision_level::unseen );
+    REQUIRE( visible.is_compact() );
+
+    visible.set( point_om_omt( 4, 5 ), om_vision_level::unseen );
+    CHECK( visible.is_compact() );
+
+    visible.set( point_om_omt( 4, 5 ), om_vision_level::full );
+    CHECK_FALSE( visible.is_compact() );
+    CHECK( visible[point_om_omt( 4, 5 )] == om_vision_level::full );
+    CHECK( visible[point_om_omt( 5, 4 )] == om_vision_level::unseen );
+
+    om_layer_array<om_vision_level> copy = visible;
+    visible.compact();
+    CHECK_FALSE( visible.is_compact() );
+    CHECK( copy[point_om_omt( 4, 5 )] == om_vision_level::full );
+
+    visible.set( point_om_omt( 4, 5 ), om_vision_level::unseen );
+    visible.compact();
+    CHECK( visible.is_compact() );
+    CHECK( visible[point_om_omt( 4, 5 )] == om_vision_level::unseen );
+    CHECK( copy[point_om_omt( 4, 5 )] == om_vision_level::full );
+}
+
 TEST_CASE( "is_ot_match", "[overmap][terrain]" )
 {
     SECTION( "exact match" ) {
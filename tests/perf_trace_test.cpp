@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "cata_catch.h"
+#include "cata_path.h"
+#include "flexbuffer_json.h"
+#include "json_loader.h"
+#include "perf.h"
+
+TEST_CASE( "perf_trace_records_zones_only_while_started", "[perf]" )
+{
+    const auto traced = []() {
+        CATA_TRACE_ZONE( "perf_trace_test_zone" );
+    };
+    perf_trace::stop();
+    traced();
+    perf_trace::start();
+    traced();
+    traced();
+    perf_trace::stop();
+    traced();
+
+    CHECK( perf_trace::intern( "perf_trace_test_zone" ).index ==
+           perf_trace::intern( "perf_trace_test_zone" ).index );
+    CHECK( perf_trace::intern( "perf_trace_test_zone" ).index !=
+           perf_trace::intern( "perf_trace_other_zone" ).index );
+
+    const std::filesystem::path file = std::filesystem::temp_directory_path() /
+                                       std::filesystem::u8path( "perf_trace_test.json" );
+    const cata_path path( cata_path::root_path::unknown, file );
+    REQUIRE( perf_trace::write( path ) );
+
+    JsonObject jo = json_loader::from_path( path ).get_object();
+    jo.allow_omitted_members();
+    int recorded = 0;
+    for( JsonObject event : jo.get_array( "traceEvents" ) ) {
+        event.allow_omitted_members();
+        if( event.get_string( "name" ) == "perf_trace_test_zone" ) {
+            CHECK( event.get_string( "ph" ) == "X" );
+            CHECK( event.get_int( "dur" ) >= 0 );
+            ++recorded;
+        }
+    }
+    CHECK( recorded == 2 );
+
+    std::filesystem::remove( file );
+}
+
+TEST_CASE( "perf_trace_folds_zones_into_turns", "[perf]" )
+{
+    const auto traced = []() {
+        CATA_TRACE_ZONE( "perf_trace_turn_zone" );
+    };
+    const auto find = []( const std::vector<perf_trace::zone_turn_stats> &stats ) {
+        return std::find_if( stats.begin(), stats.end(), []( const perf_trace::zone_turn_stats & s ) {
+            return s.name == "perf_trace_turn_zone";
+        } );
+    };
+    perf_trace::start();
+    traced();
+    traced();
+    perf_trace::end_turn();
+    traced();
+    traced();
+    traced();
+    traced();
+    perf_trace::end_turn();
+    perf_trace::stop();
+    // Not recording, so no turn is closed.
+    perf_trace::end_turn();
+
+    CHECK( perf_trace::recent_turn_count() == 2 );
+    const std::vector<perf_trace::zone_turn_stats> stats = perf_trace::recent_turns();
+    const auto zone = find( stats );
+    REQUIRE( zone != stats.end() );
+    CHECK( zone->mean_calls == Approx( 3.0 ) );
+    CHECK( zone->max_ms >= zone->mean_ms );
+    CHECK( zone->mean_ms >= 0.0 );
+
+    perf_trace::start();
+    CHECK( perf_trace::recent_turn_count() == 0 );
+    const std::vector<perf_trace::zone_turn_stats> cleared = perf_trace::recent_turns();
+    CHECK( find( cleared ) == cleared.end() );
+    perf_trace::stop();
+}
@@ -9,6 +9,8 @@
 #include <vector>
 
 #include "activity_actor_definitions.h"
+#include "activity_handlers.h"
+#include "activity_item_handling.h"
 #include "avatar.h"
 #include "calendar.h"
 #include "cata_catch.h"
@@ -46,10 +48,12 @@ static const activity_id ACT_AIM( "ACT_AIM" );
 static const activity_id ACT_BOLTCUTTING( "ACT_BOLTCUTTING" );
 static const activity_id ACT_CRACKING( "ACT_CRACKING" );
 static const activity_id ACT_HACKSAW( "ACT_HACKSAW" );
+static const activity_id ACT_MULTIPLE_CHOP_TREES( "ACT_MULTIPLE_CHOP_TREES" );
 static const activity_id ACT_NULL( "ACT_NULL" );
 static const activity_id ACT_OXYTORCH( "ACT_OXYTORCH" );
 static const activity_id ACT_PRYING( "ACT_PRYING" );
 static const activity_id ACT_SHEARING( "ACT_SHEARING" );
+static const activity_id ACT_VEHICLE_REPAIR( "ACT_VEHICLE_REPAIR" );
 
 static const bionic_id bio_ears( "bio_ears" );
 
@@ -2143,3 +2147,60 @@ TEST_CASE( "activity_interruption_by_distractions", "[activity][interruption]" )
         }
     }
 }
+
+TEST_CASE( "multi_activity_skips_last_until_something_changes", "[activity][zones]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    Character &you = get_player_character();
+    map &here = get_map();
+    const tripoint_bub_ms spot = you.pos_bub() + point( 3, 0 );
+    const tripoint_abs_ms abs_spot = here.get_abs( spot );
+    const auto remembered = [&]() {
+        return multi_activity_actor::remembered_skip( you, ACT_MULTIPLE_CHOP_TREES, abs_spot, spot );
+    };
+
+    CHECK( multi_activity_actor::remembers_skips( ACT_MULTIPLE_CHOP_TREES ) );
+    CHECK_FALSE( multi_activity_actor::remembers_skips( ACT_VEHICLE_REPAIR ) );
+    CHECK_FALSE( remembered() );
+
+    multi_activity_actor::remember_skip( you, ACT_MULTIPLE_CHOP_TREES, abs_spot, spot,
+                                         requirement_check_result::SKIP_LOCATION_NO_ZONE, false );
+    REQUIRE( remembered() == requirement_check_result::SKIP_LOCATION_NO_ZONE );
+
+    SECTION( "looking at the tile keeps it" ) {
+        for( item &it : here.i_at( spot ) ) {
+            static_cast<void>( it );
+        }
+        calendar::turn += 30_seconds;
+        CHECK( remembered() == requirement_check_result::SKIP_LOCATION_NO_ZONE );
+    }
+    SECTION( "changing the tile forgets it" ) {
+        here.ter_set( spot, ter_t_dirt );
+        CHECK_FALSE( remembered() );
+    }
+    SECTION( "dropping something on the tile forgets it" ) {
+        here.add_item( spot, item( itype_test_rock ) );
+        CHECK_FALSE( remembered() );
+    }
+    SECTION( "changing the inventory forgets it" ) {
+        you.i_add( item( itype_test_rock ) );
+        CHECK_FALSE( remembered() );
+    }
+    SECTION( "it lasts a minute at most" ) {
+        calendar::turn += 1_minutes;
+        CHECK_FALSE( remembered() );
+    }
+    SECTION( "loot far away only matters when fetching was considered" ) {
+        const tripoint_bub_ms far_spot = spot + point( 4 * SEEX, 0 );
+        REQUIRE( here.inbounds( far_spot ) );
+        here.add_item( far_spot, item( itype_test_rock ) );
+        CHECK( remembered() == requirement_check_result::SKIP_LOCATION_NO_ZONE );
+
+        multi_activity_actor::remember_skip( you, ACT_MULTIPLE_CHOP_TREES, abs_spot, spot,
+                                             requirement_check_result::SKIP_LOCATION, true );
+        REQUIRE( remembered() == requirement_check_result::SKIP_LOCATION );
+        here.add_item( far_spot, item( itype_test_rock ) );
+        CHECK_FALSE( remembered() );
+    }
+}
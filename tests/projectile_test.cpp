@@ -133,3 +133,28 @@ TEST_CASE( "liquid_projectiles_applies_effect", "[projectile_effect]" )
         CHECK( !dummy.has_effect( effect_bile_stink ) );
     }
 }
+
+TEST_CASE( "projectile_burst_traces_each_trajectory_once", "[projectile]" )
+{
+    clear_map_without_vision();
+    map &here = get_map();
+    here.build_map_cache( 0 );
+    const tripoint_bub_ms from( 10, 10, 0 );
+    const tripoint_bub_ms to( 20, 13, 0 );
+
+    projectile_burst burst( here );
+    const std::vector<tripoint_bub_ms> path = burst.clear_path( from, to );
+    CHECK( path == here.find_clear_path( from, to ) );
+    CHECK( burst.clear_path( from, to ) == path );
+    CHECK( burst.traced() == 1 );
+    burst.clear_path( from, to + tripoint_rel_ms::north );
+    CHECK( burst.traced() == 2 );
+
+    // Once the caches see a wall in the way, the path is traced again.
+    here.ter_set( path[path.size() / 2], ter_id( "t_wall" ) );
+    here.build_map_cache( 0 );
+    const std::vector<tripoint_bub_ms> around = burst.clear_path( from, to );
+    CHECK( burst.traced() == 3 );
+    CHECK( around == here.find_clear_path( from, to ) );
+    clear_map_without_vision();
+}
@@ -0,0 +1,23 @@
+#include "cata_catch.h"
+#include "cata_imgui.h"
+#include "color.h"
+#include "coordinates.h"
+
+TEST_CASE( "retained_text_is_built_again_only_for_a_new_key", "[imgui]" )
+{
+    cataimgui::retained_text text;
+    const tripoint_abs_omt here( 3, 4, 0 );
+    const size_t key = cataimgui::retained_key( here, true );
+
+    CHECK( text.outdated( key ) );
+    text.paragraph( "built", c_white );
+    CHECK_FALSE( text.outdated( key ) );
+    CHECK_FALSE( text.outdated( cataimgui::retained_key( here, true ) ) );
+
+    CHECK( text.outdated( cataimgui::retained_key( here + point::east, true ) ) );
+    CHECK( text.outdated( key ) );
+
+    text.invalidate();
+    CHECK( text.outdated( key ) );
+    CHECK_FALSE( text.outdated( key ) );
+}
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "cata_catch.h"
+#include "coordinates.h"
 #include "rng.h"
 #include "test_statistics.h"
 
@@ -78,3 +79,31 @@ TEST_CASE( "random_entry_preserves_constness", "[rng]" )
     i1 = 5678;
     CHECK( v1[0] == 5678 );
 }
+
+TEST_CASE( "scoped_rng_stream_is_reproducible_and_restores_the_game_stream", "[rng]" )
+{
+    const unsigned int seed = rng_stream_seed( 1234, tripoint_abs_omt( 5, -3, 0 ), "mapgen" );
+    CHECK( seed != rng_stream_seed( 1234, tripoint_abs_omt( 5, -3, 0 ), "overmap" ) );
+    CHECK( seed != rng_stream_seed( 1234, tripoint_abs_omt( 5, -3, 1 ), "mapgen" ) );
+
+    rng_set_engine_seed( 4242 );
+    const int expected_game_roll = rng( 0, 1000000 );
+
+    std::vector<int> first;
+    std::vector<int> second;
+    rng_set_engine_seed( 4242 );
+    {
+        const scoped_rng_stream stream( seed );
+        for( int i = 0; i < 10; ++i ) {
+            first.push_back( rng( 0, 1000000 ) );
+        }
+    }
+    CHECK( rng( 0, 1000000 ) == expected_game_roll );
+    {
+        const scoped_rng_stream stream( seed );
+        for( int i = 0; i < 10; ++i ) {
+            second.push_back( rng( 0, 1000000 ) );
+        }
+    }
+    CHECK( first == second );
+}
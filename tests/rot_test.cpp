@@ -105,6 +105,24 @@ TEST_CASE( "Items_rot_away", "[rot]" )
     }
 }
 
+TEST_CASE( "Items_left_in_a_freezer_catch_up_without_rotting", "[rot]" )
+{
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    set_map_temperature( units::from_fahrenheit( 65 ) );
+
+    item frozen_item( itype_meat_cooked );
+    frozen_item.process( get_map(), nullptr, tripoint_bub_ms::zero, 1, temperature_flag::FREEZER );
+
+    // Weeks away from the reality bubble, only the last two days of which move the temperature.
+    calendar::turn += 20_days;
+    CHECK_FALSE( frozen_item.process_temperature_rot( 1, tripoint_bub_ms::zero, get_map(), nullptr,
+                 temperature_flag::FREEZER ) );
+    CHECK( frozen_item.get_rot() == 0_turns );
+    CHECK( frozen_item.has_own_flag( json_flag_FROZEN ) );
+}
+
 TEST_CASE( "Hourly_rotpoints", "[rot]" )
 {
     item normal_item( itype_meat_cooked );
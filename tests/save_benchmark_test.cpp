@@ -0,0 +1,159 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#include "avatar.h"
+#include "benchmark_helpers.h"
+#include "cached_options.h"
+#include "cata_catch.h"
+#include "cata_scope_helpers.h"
+#include "coordinates.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "string_formatter.h"
+
+// Benchmarks for the save and load paths of the map, overmap and map memory buffers, run with
+// `cata_test "[save_benchmark]"`. They are hidden from the normal test run because they write a
+// good chunk of world to disk. Next to the timings they report how many bytes each save wrote
+// and the peak resident set size, so changes to those paths can be compared run to run.
+
+namespace
+{
+
+// Side length, in overmap terrains, of the square of world the fixture generates.
+constexpr int fixture_omts = 12;
+constexpr unsigned int fixture_seed = 1234;
+
+uintmax_t disk_usage( const cata_path &dir )
+{
+    uintmax_t total = 0;
+    std::error_code ec;
+    for( std::filesystem::recursive_directory_iterator it( dir.get_unrelative_path(), ec ), end;
+         !ec && it != end; it.increment( ec ) ) {
+        if( it->is_regular_file( ec ) ) {
+            total += it->file_size( ec );
+        }
+    }
+    return total;
+}
+
+// Generates the same stretch of world on every run.
+void generate_fixture()
+{
+    rng_set_engine_seed( fixture_seed );
+    load_fixture( fixture_omts );
+}
+
+void memorize_fixture( avatar &u )
+{
+    const tripoint_abs_ms origin = project_to<coords::ms>( fixture_origin() );
+    for( int y = 0; y < fixture_omts * SEEY * 2; ++y ) {
+        for( int x = 0; x < fixture_omts * SEEX * 2; ++x ) {
+            u.memorize_terrain( origin + point( x, y ), "t_grass", 0, 0 );
+            if( ( x + y ) % 7 == 0 ) {
+                u.memorize_symbol( origin + point( x, y ), U'#' );
+            }
+        }
+    }
+}
+
+template<typename Save>
+void report_save( const std::string &what, Save &&save )
+{
+    const uintmax_t before = disk_usage( PATH_INFO::world_base_save_path() );
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    save();
+    const int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start ).count();
+    const uintmax_t after = disk_usage( PATH_INFO::world_base_save_path() );
+    WARN( string_format( "%s: %d ms, world grew by %d bytes to %d bytes, peak RSS %d KiB", what,
+                         ms, static_cast<int64_t>( after ) - static_cast<int64_t>( before ), after,
+                         peak_rss_kib() ) );
+}
+
+} // namespace
+
+TEST_CASE( "mapbuffer_save_and_load_benchmark", "[.][benchmark][save_benchmark]" )
+{
+    clear_map_without_vision();
+    clear_overmaps();
+    generate_fixture();
+
+    // Saving drops the fixture from the map buffer and skips submaps that haven't changed since,
+    // so only the first save does any work. Time that one instead of repeating it.
+    report_save( "mapbuffer first save", []() {
+        MAPBUFFER.save();
+        MAPBUFFER.finish_pending_saves();
+    } );
+
+    BENCHMARK( "mapbuffer full load" ) {
+        MAPBUFFER.clear_outside_reality_bubble();
+        load_fixture( fixture_omts );
+    };
+    WARN( string_format( "mapbuffer peak RSS %d KiB", peak_rss_kib() ) );
+}
+
+TEST_CASE( "overmapbuffer_save_and_load_benchmark", "[.][benchmark][save_benchmark]" )
+{
+    clear_overmaps();
+    rng_set_engine_seed( fixture_seed );
+    const point_abs_om origin = project_to<coords::om>( fixture_origin().xy() );
+    for( int y = -1; y <= 1; ++y ) {
+        for( int x = -1; x <= 1; ++x ) {
+            overmap_buffer.get( origin + point( x, y ) );
+        }
+    }
+
+    report_save( "overmapbuffer first save", []() {
+        overmap_buffer.save();
+    } );
+
+    BENCHMARK( "overmapbuffer save" ) {
+        overmap_buffer.save();
+    };
+    BENCHMARK( "overmapbuffer full load" ) {
+        overmap_buffer.reset();
+        for( int y = -1; y <= 1; ++y ) {
+            for( int x = -1; x <= 1; ++x ) {
+                overmap_buffer.get( origin + point( x, y ) );
+            }
+        }
+    };
+    WARN( string_format( "overmapbuffer peak RSS %d KiB", peak_rss_kib() ) );
+    clear_overmaps();
+}
+
+TEST_CASE( "map_memory_save_and_load_benchmark", "[.][benchmark][save_benchmark]" )
+{
+    // Map memory doesn't touch the disk in tests, which is what we want to measure here.
+    restore_on_out_of_scope restore_test_mode( test_mode );
+    test_mode = false;
+
+    clear_avatar();
+    avatar &u = get_avatar();
+    u.clear_map_memory();
+    memorize_fixture( u );
+
+    report_save( "map memory first save", [&u]() {
+        u.save_map_memory();
+    } );
+
+    BENCHMARK( "map memory save" ) {
+        memorize_fixture( u );
+        return u.save_map_memory();
+    };
+    BENCHMARK( "map memory full load" ) {
+        u.clear_map_memory();
+        u.load_map_memory();
+    };
+    WARN( string_format( "map memory peak RSS %d KiB", peak_rss_kib() ) );
+    u.clear_map_memory();
+}
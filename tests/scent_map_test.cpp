@@ -0,0 +1,85 @@
+#include <array>
+
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_scale_constants.h"
+#include "point.h"
+#include "scent_map.h"
+
+namespace
+{
+
+// Exposes the raw scent grid and lets the test turn the scented box off.
+class test_scent_map : public scent_map
+{
+    public:
+        explicit test_scent_map( const game &g ) : scent_map( g ) { }
+
+        void diffuse_everywhere() {
+            scent_everywhere();
+        }
+        bool same_scent( const test_scent_map &other ) const {
+            return grscent == other.grscent;
+        }
+};
+
+} // namespace
+
+TEST_CASE( "scent_diffusion_limited_to_scented_box_matches_full_diffusion", "[scent]" )
+{
+    clear_map_without_vision();
+    map &here = get_map();
+    const tripoint_bub_ms center( MAPSIZE_X / 2, MAPSIZE_Y / 2, 0 );
+
+    test_scent_map boxed( *g );
+    test_scent_map full( *g );
+    boxed.reset();
+    full.reset();
+    boxed.set( center + point( 3, -2 ), 500 );
+    full.set( center + point( 3, -2 ), 500 );
+    boxed.set( center + point( -20, 10 ), 80 );
+    full.set( center + point( -20, 10 ), 80 );
+
+    for( int turn = 0; turn < 30; ++turn ) {
+        full.diffuse_everywhere();
+        boxed.update( center, here );
+        full.update( center, here );
+        if( turn % 10 == 0 ) {
+            boxed.decay();
+            full.decay();
+        }
+        CAPTURE( turn );
+        REQUIRE( boxed.same_scent( full ) );
+    }
+    CHECK( boxed.get( center + point( 3, -2 ) ) > 0 );
+    CHECK( boxed.get( center + point( 6, -2 ) ) > 0 );
+    CHECK( boxed.get( center + point( 39, 39 ) ) == 0 );
+}
+
+TEST_CASE( "scent_map_update_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    clear_map_without_vision();
+    map &here = get_map();
+    const tripoint_bub_ms center( MAPSIZE_X / 2, MAPSIZE_Y / 2, 0 );
+
+    test_scent_map scent( *g );
+    scent.reset();
+    scent.set( center, 500 );
+    scent.set( center + point( -20, 10 ), 80 );
+    scent.update( center, here );
+
+    BENCHMARK( "update, scented box" ) {
+        // Kept fresh, so the box stays the same size from run to run.
+        scent.set( center, 500 );
+        scent.update( center, here );
+        return scent.get( center );
+    };
+    BENCHMARK( "update, whole map" ) {
+        scent.diffuse_everywhere();
+        scent.update( center, here );
+        return scent.get( center );
+    };
+}
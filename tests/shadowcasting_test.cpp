@@ -365,14 +365,14 @@ static void do_3d_benchmark(
 {
     struct test_grids {
         std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> seen_squares = {};
-        std::array<cata::mdarray<bool, point_bub_ms>, OVERMAP_LAYERS> floor_cache = {};
+        std::array<cata::mdbitset<point_bub_ms>, OVERMAP_LAYERS> floor_cache = {};
     };
 
     std::unique_ptr<test_grids> grids = std::make_unique<test_grids>();
 
     const tripoint_bub_ms origin( 65, 65, 0 );
     array_of_grids_of<float> seen_caches;
-    array_of_grids_of<const bool> floor_caches;
+    array_of_floor_caches floor_caches;
 
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         seen_caches[z + OVERMAP_DEPTH] = &grids->seen_squares[z + OVERMAP_DEPTH];
@@ -443,7 +443,7 @@ static void shadowcasting_3d_2d( const int iterations )
     cata::mdarray<float, point_bub_ms> seen_squares_control = {};
     cata::mdarray<float, point_bub_ms> seen_squares_experiment = {};
     cata::mdarray<float, point_bub_ms> transparency_cache = {};
-    cata::mdarray<bool, point_bub_ms> floor_cache = {};
+    cata::mdbitset<point_bub_ms> floor_cache;
 
     randomly_fill_transparency( transparency_cache );
 
@@ -464,7 +464,7 @@ static void shadowcasting_3d_2d( const int iterations )
     const tripoint_bub_ms origin( offset );
     array_of_grids_of<const float> transparency_caches;
     array_of_grids_of<float> seen_caches;
-    array_of_grids_of<const bool> floor_caches;
+    array_of_floor_caches floor_caches;
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         // TODO: Give some more proper values here
         transparency_caches[z + OVERMAP_DEPTH] = &transparency_cache;
@@ -578,7 +578,7 @@ static void run_spot_check( const grid_overlay &test_case, const grid_overlay &e
     std::array<level_cache *, OVERMAP_LAYERS> caches;
     array_of_grids_of<float> seen_squares;
     array_of_grids_of<const float> transparency_cache;
-    array_of_grids_of<const bool> floor_cache;
+    array_of_floor_caches floor_cache;
 
     const int upper_bound = fov_3d ? OVERMAP_LAYERS : 12;
     const int lower_bound = fov_3d ? 0 : 11;
@@ -1141,3 +1141,39 @@ TEST_CASE( "bresenham_vs_shadowcasting", "[.]" )
 {
     shadowcasting_runoff( 1, true );
 }
+
+TEST_CASE( "shadowcasting_kernel_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    struct test_grids {
+        std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> transparency_cache = {};
+        std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> seen_squares = {};
+        std::array<cata::mdbitset<point_bub_ms>, OVERMAP_LAYERS> floor_cache = {};
+    };
+    std::unique_ptr<test_grids> grids = std::make_unique<test_grids>();
+
+    rng_set_engine_seed( 1234 );
+    array_of_grids_of<const float> transparency_caches;
+    array_of_grids_of<float> seen_caches;
+    array_of_floor_caches floor_caches;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        randomly_fill_transparency( grids->transparency_cache[z + OVERMAP_DEPTH] );
+        transparency_caches[z + OVERMAP_DEPTH] = &grids->transparency_cache[z + OVERMAP_DEPTH];
+        seen_caches[z + OVERMAP_DEPTH] = &grids->seen_squares[z + OVERMAP_DEPTH];
+        floor_caches[z + OVERMAP_DEPTH] = &grids->floor_cache[z + OVERMAP_DEPTH];
+    }
+    cata::mdarray<float, point_bub_ms> &ground_transparency =
+        grids->transparency_cache[OVERMAP_DEPTH];
+    cata::mdarray<float, point_bub_ms> &ground_seen = grids->seen_squares[OVERMAP_DEPTH];
+    const tripoint_bub_ms origin( 65, 65, 0 );
+
+    BENCHMARK( "castLightAll" ) {
+        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+            ground_seen, ground_transparency, origin.xy() );
+        return ground_seen[origin.x()][origin.y()];
+    };
+    BENCHMARK( "cast_zlight" ) {
+        cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+            seen_caches, transparency_caches, floor_caches, origin, 0, 1.0 );
+        return ground_seen[origin.x()][origin.y()];
+    };
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "benchmark_helpers.h"
+#include "cata_catch.h"
+#include "flexbuffer_json.h"
+#include "game.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "overmapbuffer.h"
+#include "player_helpers.h"
+#include "rng.h"
+#include "string_formatter.h"
+
+// Times the phases of getting into a game: loading the data of the test world's mods,
+// generating a fixed stretch of world from a fixed seed, saving it and loading it back.
+// Run it with `cata_test "[startup_benchmark]"`, or build the cata_bench_startup target.
+// Each phase reports its wall time and peak resident set size, and fails if it goes over
+// its budget in tests/data/startup_budget.json.
+
+namespace
+{
+
+constexpr int fixture_omts = 8;
+constexpr unsigned int fixture_seed = 4321;
+
+void run_phase( const std::string &name, const std::function<void()> &phase )
+{
+    reset_peak_rss();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    phase();
+    const int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start ).count();
+    const int64_t rss = peak_rss_kib();
+    WARN( string_format( "%s: %d ms, peak RSS %d KiB", name, ms, rss ) );
+
+    JsonObject budget;
+    if( !find_benchmark_budget( "startup_budget.json", name, budget ) ) {
+        return;
+    }
+    CAPTURE( name );
+    CHECK( ms <= budget.get_int64( "max_ms" ) );
+    if( rss > 0 && budget.has_member( "max_rss_kib" ) ) {
+        CHECK( rss <= budget.get_int64( "max_rss_kib" ) );
+    }
+}
+
+} // namespace
+
+TEST_CASE( "startup_benchmark", "[.][benchmark][startup_benchmark]" )
+{
+    // Nothing may keep pointers into the data we are about to reload.
+    clear_avatar();
+    clear_map_without_vision();
+    clear_overmaps();
+
+    run_phase( "data", []() {
+        g->load_core_data();
+        g->load_world_modfiles();
+    } );
+    clear_avatar();
+    clear_map_without_vision();
+
+    run_phase( "world", []() {
+        rng_set_engine_seed( fixture_seed );
+        load_fixture( fixture_omts );
+    } );
+    run_phase( "save", []() {
+        MAPBUFFER.save();
+        MAPBUFFER.finish_pending_saves();
+        overmap_buffer.save();
+    } );
+    run_phase( "load", []() {
+        MAPBUFFER.clear_outside_reality_bubble();
+        load_fixture( fixture_omts );
+    } );
+
+    clear_map_without_vision();
+    clear_overmaps();
+}
@@ -3,6 +3,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "event_subscriber.h"
 #include "flexbuffer_json.h"
 #include "game.h"
+#include "json.h"
 #include "json_loader.h"
 #include "map_scale_constants.h"
 #include "options_helpers.h"
@@ -1003,3 +1005,38 @@ TEST_CASE( "legacy_stats_tracker_save_loading", "[stats]" )
     CHECK( s.get_events( event_type::character_triggers_trap ).count() == 2 );
     CHECK( s.get_events( event_type::character_kills_monster ).count() == 0 );
 }
+
+TEST_CASE( "stats_tracker_save_round_trip", "[stats]" )
+{
+    stats_tracker s;
+    event_bus b;
+    b.subscribe( &s );
+
+    const character_id u_id = get_player_character().getID();
+    const cata::event kill1 =
+        cata::event::make<event_type::character_kills_monster>( u_id, mon_zombie, 0 );
+    const cata::event kill2 = cata::event::make<event_type::character_kills_monster>( u_id,
+                              mon_zombie_brute, 0 );
+    b.send( kill1 );
+    b.send( kill1 );
+    b.send( kill2 );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    s.serialize( jsout );
+
+    JsonValue jsin = json_loader::from_string( os.str() );
+    stats_tracker loaded;
+    loaded.deserialize( jsin.get_object() );
+    const event_multiset &events = loaded.get_events( event_type::character_kills_monster );
+    CHECK( events.counts().size() == 2 );
+    CHECK( events.count() == 3 );
+    CHECK( events.count( kill1.data() ) == 2 );
+    CHECK( events.count( kill2.data() ) == 1 );
+
+    // Events added after loading keep adding to the loaded totals.
+    event_bus b2;
+    b2.subscribe( &loaded );
+    b2.send( kill2 );
+    CHECK( loaded.get_events( event_type::character_kills_monster ).count() == 4 );
+}
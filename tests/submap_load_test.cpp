@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -19,8 +20,11 @@
 #include "flexbuffer_json.h"
 #include "game.h"
 #include "item.h"
+#include "json.h"
 #include "json_loader.h"
 #include "map_scale_constants.h"
+#include "mapdata.h"
+#include "options_helpers.h"
 #include "point.h"
 #include "string_formatter.h"
 #include "submap.h"
@@ -1559,3 +1563,48 @@ TEST_CASE( "submap_fd_migration", "[submap][load]" )
     INFO( string_format( "%d fields found: %s", total_fields, fields_list ) );
     REQUIRE( ( found_field_new_id && total_fields == 1 ) );
 }
+
+static std::string store_to_string( const submap &sm )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_object();
+    jsout.member( "version", savegame_version );
+    sm.store( jsout );
+    jsout.end_object();
+    return os.str();
+}
+
+TEST_CASE( "submap_packed_layers_round_trip", "[submap][load]" )
+{
+    override_option packed( "PACKED_SUBMAPS", "true" );
+
+    // Enough distinct terrain to need two digits per tile, and a few without.
+    for( const size_t palette_size : {
+             static_cast<size_t>( 4 ), std::min<size_t>( ter_t::count(), 100 )
+         } ) {
+        CAPTURE( palette_size );
+        submap original;
+        for( int y = 0; y < SEEY; ++y ) {
+            for( int x = 0; x < SEEX; ++x ) {
+                original.set_ter( { x, y }, ter_id( static_cast<int>( ( y * SEEX + x ) % palette_size ) ) );
+            }
+        }
+        original.set_furn( corner_nw, furn_f_bookcase );
+        original.set_furn( corner_se, furn_f_dresser );
+
+        const std::string saved = store_to_string( original );
+        CHECK( saved.find( "packed_terrain" ) != std::string::npos );
+        CHECK( saved.find( "packed_furniture" ) != std::string::npos );
+
+        submap loaded;
+        load_from_jsin( loaded, json_loader::from_string( saved ) );
+        for( int y = 0; y < SEEY; ++y ) {
+            for( int x = 0; x < SEEX; ++x ) {
+                CAPTURE( x, y );
+                CHECK( loaded.get_ter( { x, y } ) == original.get_ter( { x, y } ) );
+                CHECK( loaded.get_furn( { x, y } ) == original.get_furn( { x, y } ) );
+            }
+        }
+    }
+}
@@ -1,10 +1,15 @@
+#include "calendar.h"
 #include "cata_catch.h"
+#include "colony.h"
 #include "coordinates.h"
+#include "item.h"
 #include "map_scale_constants.h"
 #include "point.h"
 #include "submap.h"
 #include "type_id.h"
 
+static const itype_id itype_test_rock( "test_rock" );
+
 TEST_CASE( "submap_rotation", "[submap]" )
 {
     // Corners are labelled starting from the upper-left one, clockwise.
@@ -115,3 +120,102 @@ TEST_CASE( "submap_rotation2", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_snapshot_is_unaffected_by_later_writes", "[submap]" )
+{
+    constexpr point_sm_ms p = { 3, 4 };
+    submap sm;
+    sm.set_ter( p, ter_id( 1 ) );
+    sm.get_items( p ).insert( item( itype_test_rock ) );
+    item *on_map = &*sm.get_items( p ).begin();
+
+    const submap_snapshot snap = sm.snapshot();
+    CHECK( snap.get_version() == sm.get_tile_version() );
+
+    sm.set_ter( p, ter_id( 2 ) );
+    sm.get_items( p ).insert( item( itype_test_rock ) );
+
+    CHECK( snap.get_version() != sm.get_tile_version() );
+    CHECK( snap.get_ter( p ) == ter_id( 1 ) );
+    CHECK( snap.get_items( p ).size() == 1 );
+    CHECK( snap.get_items( point_sm_ms::zero ).empty() );
+    CHECK( sm.get_ter( p ) == ter_id( 2 ) );
+    CHECK( sm.get_items( p ).size() == 2 );
+    // Items on the map keep their identity when the tiles stop being shared.
+    CHECK( &*sm.get_items( p ).begin() == on_map );
+}
+
+TEST_CASE( "submap_snapshot_of_uniform_submap", "[submap]" )
+{
+    submap sm;
+    sm.set_all_ter( ter_id( 5 ), true );
+    const submap_snapshot snap = sm.snapshot();
+    sm.set_ter( point_sm_ms::zero, ter_id( 6 ) );
+    CHECK( snap.is_uniform() );
+    CHECK( snap.get_ter( point_sm_ms::zero ) == ter_id( 5 ) );
+    CHECK( sm.get_ter( point_sm_ms::zero ) == ter_id( 6 ) );
+}
+
+TEST_CASE( "uniform_submap_writes_bump_the_versions", "[submap]" )
+{
+    submap sm;
+    sm.set_all_ter( ter_id( 5 ), true );
+    REQUIRE( sm.is_uniform() );
+
+    uint64_t tile_version = sm.get_tile_version();
+    uint64_t content_version = sm.get_content_version();
+    sm.set_all_ter( ter_id( 6 ), true );
+    CHECK( sm.is_uniform() );
+    CHECK( sm.get_tile_version() != tile_version );
+    CHECK( sm.get_content_version() != content_version );
+
+    // Reverting to a uniform submap drops the tile arrays.
+    submap reverted;
+    reverted.set_ter( point_sm_ms::zero, ter_id( 7 ) );
+    REQUIRE_FALSE( reverted.is_uniform() );
+    tile_version = reverted.get_tile_version();
+    content_version = reverted.get_content_version();
+    reverted.revert_submap( sm );
+    CHECK( reverted.is_uniform() );
+    CHECK( reverted.get_tile_version() != tile_version );
+    CHECK( reverted.get_content_version() != content_version );
+}
+
+TEST_CASE( "submap_tracks_changes_since_it_was_saved", "[submap]" )
+{
+    constexpr point_sm_ms p = { 3, 4 };
+    submap sm;
+    sm.set_all_ter( ter_id( 1 ) );
+    // Never saved, so it has to be.
+    CHECK( sm.changed_since_saved() );
+    sm.mark_saved();
+    CHECK_FALSE( sm.changed_since_saved() );
+
+    // Reading doesn't count.
+    const submap &read_only = sm;
+    CHECK( read_only.get_ter( p ) == ter_id( 1 ) );
+    CHECK( read_only.get_items( p ).empty() );
+    CHECK_FALSE( sm.changed_since_saved() );
+
+    SECTION( "terrain" ) {
+        sm.set_ter( p, ter_id( 2 ) );
+        CHECK( sm.changed_since_saved() );
+    }
+    SECTION( "items" ) {
+        sm.get_items( p ).insert( item( itype_test_rock ) );
+        CHECK( sm.changed_since_saved() );
+    }
+    SECTION( "map damage" ) {
+        sm.set_map_damage( p, 5 );
+        CHECK( sm.changed_since_saved() );
+    }
+    SECTION( "edits past the submap" ) {
+        sm.note_unsaved_change();
+        CHECK( sm.changed_since_saved() );
+    }
+    SECTION( "the last touched stamp only while it counts" ) {
+        sm.last_touched += 1_hours;
+        CHECK( sm.changed_since_saved() );
+        CHECK_FALSE( sm.changed_since_saved( false ) );
+    }
+}
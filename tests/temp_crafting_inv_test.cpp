@@ -1,6 +1,7 @@
 #include "../src/temp_crafting_inventory.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "inventory.h"
 #include "item.h"
 #include "type_id.h"
 
@@ -48,3 +49,21 @@ TEST_CASE( "temp_crafting_inv_test_quality", "[crafting][inventory]" )
 
     CHECK( inv.max_quality( qual_PRY ) == 4 );
 }
+
+TEST_CASE( "inventory_quality_counts_follow_added_items", "[crafting][inventory]" )
+{
+    inventory inv;
+    inv.add_item( item( itype_test_halligan ) );
+
+    CHECK( inv.has_quality( qual_HAMMER, 2 ) );
+    CHECK_FALSE( inv.has_quality( qual_HAMMER, 3 ) );
+    CHECK_FALSE( inv.has_quality( qual_HAMMER, 1, 2 ) );
+    CHECK_FALSE( inv.has_quality( qual_AXE ) );
+
+    // The counts were taken above, adding more items has to drop them.
+    inv.add_item( item( itype_test_halligan ) );
+    inv.add_item( item( itype_test_fire_ax ) );
+    CHECK( inv.has_quality( qual_HAMMER, 1, 2 ) );
+    CHECK( inv.has_quality( qual_HAMMER, 2, 2 ) );
+    CHECK( inv.has_quality( qual_AXE ) );
+}
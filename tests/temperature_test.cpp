@@ -1,16 +1,23 @@
 #include <string>
 
+#include "avatar.h"
 #include "calendar.h"
 #include "cata_catch.h"
 #include "coordinates.h"
 #include "enums.h"
+#include "field_type.h"
 #include "flag.h"
+#include "game.h"
 #include "game_constants.h"
 #include "item.h"
 #include "map.h"
+#include "map_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
 #include "type_id.h"
 #include "units.h"
 #include "weather.h"
+#include "weather_gen.h"
 
 static const itype_id itype_meat_cooked( "meat_cooked" );
 static const itype_id itype_water( "water" );
@@ -296,3 +303,47 @@ TEST_CASE( "Temperature_controlled_location", "[temperature]" )
                     temperatures::normal ) ) );
     }
 }
+
+TEST_CASE( "natural_temperature_is_shared_across_an_overmap_tile", "[temperature]" )
+{
+    weather_manager &weather = get_weather();
+    weather.clear_temp_cache();
+    const weather_generator &wgen = weather.get_cur_weather_gen();
+    const tripoint_abs_omt omt = project_to<coords::omt>( get_map().get_abs( tripoint_bub_ms::zero ) );
+    const tripoint_abs_ms corner = project_to<coords::ms>( omt );
+    const time_point t = calendar::turn + 3_hours;
+
+    const units::temperature expected = wgen.get_weather_temperature( corner, t, g->get_seed() );
+    CHECK( units::to_kelvin( weather.get_natural_temperature( corner, t ) ) ==
+           Approx( units::to_kelvin( expected ) ) );
+    CHECK( units::to_kelvin( weather.get_natural_temperature( corner + point( 5, 17 ), t ) ) ==
+           Approx( units::to_kelvin( expected ) ) );
+
+    const time_point later = t + 6_hours;
+    CHECK( units::to_kelvin( weather.get_natural_temperature( corner, later ) ) ==
+           Approx( units::to_kelvin( wgen.get_weather_temperature( corner, later, g->get_seed() ) ) ) );
+    weather.clear_temp_cache();
+}
+
+TEST_CASE( "heat_radiation_follows_fires_within_a_turn", "[temperature]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    map &here = get_map();
+    const tripoint_bub_ms pos = get_avatar().pos_bub();
+    const tripoint_bub_ms fire = pos + point::east;
+    CHECK( units::to_kelvin_delta( get_heat_radiation( pos ) ) == 0 );
+
+    REQUIRE( here.add_field( fire, fd_fire, 3 ) );
+    const units::temperature_delta hot = get_heat_radiation( pos );
+    CHECK( units::to_kelvin_delta( hot ) > 0 );
+    CHECK( get_best_fire( pos ) == 3 );
+    REQUIRE( here.heat_sources_near( pos, 6 ).size() == 1 );
+    CHECK( here.heat_sources_near( pos + point( -3, 0 ), 2 ).empty() );
+
+    here.set_field_intensity( fire, fd_fire, 1 );
+    CHECK( units::to_kelvin_delta( get_heat_radiation( pos ) ) < units::to_kelvin_delta( hot ) );
+    here.remove_field( fire, fd_fire );
+    CHECK( units::to_kelvin_delta( get_heat_radiation( pos ) ) == 0 );
+    clear_map_without_vision();
+}
@@ -0,0 +1,83 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cata_catch.h"
+#include "thread_pool.h"
+
+TEST_CASE( "thread_pool_parallel_for_visits_every_index_once", "[thread_pool]" )
+{
+    for( unsigned int workers : {
+             0U, 1U, 3U
+         } ) {
+        CAPTURE( workers );
+        cata::thread_pool pool( workers );
+        CHECK( pool.num_workers() == workers );
+        std::vector<std::atomic<int>> visits( 100 );
+        pool.parallel_for( -20, 80, [&]( int i ) {
+            visits[i + 20]++;
+        } );
+        for( const std::atomic<int> &v : visits ) {
+            CHECK( v == 1 );
+        }
+    }
+}
+
+TEST_CASE( "thread_pool_parallel_for_handles_empty_and_nested_ranges", "[thread_pool]" )
+{
+    cata::thread_pool pool( 2 );
+    int calls = 0;
+    pool.parallel_for( 5, 5, [&]( int ) {
+        calls++;
+    } );
+    CHECK( calls == 0 );
+
+    std::atomic<int> total( 0 );
+    pool.parallel_for( 0, 4, [&]( int ) {
+        pool.parallel_for( 0, 4, [&]( int ) {
+            total++;
+        } );
+    } );
+    CHECK( total == 16 );
+}
+
+TEST_CASE( "thread_pool_parallel_for_rethrows_job_exceptions", "[thread_pool]" )
+{
+    cata::thread_pool pool( 2 );
+    std::atomic<int> finished( 0 );
+    CHECK_THROWS_AS( pool.parallel_for( 0, 10, [&]( int i ) {
+        if( i == 3 ) {
+            throw std::runtime_error( "job failed" );
+        }
+        finished++;
+    } ), std::runtime_error );
+    CHECK( finished == 9 );
+}
+
+TEST_CASE( "thread_pool_run_alongside_keeps_foreground_on_caller", "[thread_pool]" )
+{
+    for( unsigned int workers : {
+             0U, 2U
+         } ) {
+        CAPTURE( workers );
+        cata::thread_pool pool( workers );
+        const std::thread::id caller = std::this_thread::get_id();
+        std::atomic<int> background_runs( 0 );
+        std::thread::id foreground_thread;
+        pool.run_alongside( [&]() {
+            background_runs++;
+        }, [&]() {
+            foreground_thread = std::this_thread::get_id();
+        } );
+        CHECK( background_runs == 1 );
+        CHECK( foreground_thread == caller );
+
+        CHECK_THROWS_AS( pool.run_alongside( [&]() {
+            throw std::runtime_error( "background failed" );
+        }, [&]() {
+            background_runs++;
+        } ), std::runtime_error );
+        CHECK( background_runs == 2 );
+    }
+}
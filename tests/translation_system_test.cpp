@@ -153,6 +153,26 @@ TEST_CASE( "TranslationManager_translates_message_with_context", "[translations]
     CHECK( untranslated_unknown_pike == "pike" );
 }
 
+TEST_CASE( "TranslationManager_finds_strings_by_index", "[translations]" )
+{
+    const std::string path = "./data/mods/TEST_DATA/lang/mo/ru/LC_MESSAGES/TEST_DATA.mo";
+    TranslationManager manager;
+    // The first document to translate a string wins, so loading one twice changes nothing.
+    manager.LoadDocuments( std::vector<std::string> { path, path } );
+    const int battery = manager.FindString( nullptr, "battery" );
+    REQUIRE( battery >= 0 );
+    CHECK( std::string( manager.GetTranslatedString( battery ) ) == "батарейка" );
+    CHECK( std::string( manager.GetTranslatedStringPlural( battery, 5 ) ) == "батареек" );
+    const int weapon_pike = manager.FindString( "weapon", "pike" );
+    const int fish_pike = manager.FindString( "fish", "pike" );
+    REQUIRE( weapon_pike >= 0 );
+    REQUIRE( fish_pike >= 0 );
+    CHECK( weapon_pike != fish_pike );
+    CHECK( std::string( manager.GetTranslatedString( fish_pike ) ) == "щука" );
+    CHECK( manager.FindString( nullptr, "__UnTrAnSlAtEd!!!__#" ) == -1 );
+    CHECK( manager.FindString( nullptr, "" ) == -1 );
+}
+
 static void CheckPluralEvaluation( const TranslationPluralRulesEvaluator &evaluator,
                                    const std::function<std::size_t( std::size_t )> &ground_truth )
 {
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "benchmark_helpers.h"
+#include "calendar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "do_turn.h"
+#include "field_type.h"
+#include "flexbuffer_json.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "string_formatter.h"
+#include "type_id.h"
+#include "units.h"
+#include "vehicle.h"
+
+// Advances fixed scenes through do_turn(), the game's own turn loop, from a fixed seed.
+// Run it with `cata_test "[turn_benchmark]"`, or build the cata_bench_turns target.
+// Each scene reports turns per second, median and 99th percentile turn latency and peak
+// resident set size, and fails if it goes over its budget in tests/data/turn_budget.json.
+
+static const mtype_id mon_zombie( "mon_zombie" );
+
+static const trait_id trait_DEBUG_NODMG( "DEBUG_NODMG" );
+
+static const vproto_id vehicle_prototype_car( "car" );
+
+namespace
+{
+
+constexpr int benchmark_turns = 300;
+constexpr unsigned int fixture_seed = 4321;
+
+void spawn_npc_crowd()
+{
+    const tripoint_bub_ms center = get_avatar().pos_bub();
+    for( int i = 0; i < 30; ++i ) {
+        spawn_npc( center.xy() + point( 4 + ( i % 6 ) * 3, -6 + ( i / 6 ) * 3 ), "test_talker" );
+    }
+}
+
+void spawn_horde()
+{
+    const tripoint_bub_ms center = get_avatar().pos_bub();
+    for( int i = 0; i < 80; ++i ) {
+        spawn_test_monster( mon_zombie.str(), center + point( 16 + i % 10, -20 + ( i / 10 ) * 5 ) );
+    }
+}
+
+void spawn_convoy()
+{
+    map &here = get_map();
+    const tripoint_bub_ms center = get_avatar().pos_bub();
+    for( int i = 0; i < 6; ++i ) {
+        vehicle *veh = here.add_vehicle( vehicle_prototype_car, center + point( -40, -30 + i * 10 ),
+                                         0_degrees, 100, 0 );
+        REQUIRE( veh != nullptr );
+        veh->engine_on = true;
+        veh->velocity = 400;
+        veh->cruise_velocity = veh->velocity;
+    }
+}
+
+void start_fires()
+{
+    map &here = get_map();
+    const tripoint_bub_ms center = get_avatar().pos_bub();
+    for( int y = -20; y < -8; ++y ) {
+        for( int x = -20; x < 20; x += 2 ) {
+            here.add_field( center + point( x, y ), fd_fire, 3 );
+        }
+    }
+}
+
+// Nearest-rank percentile of the sorted latencies.
+double percentile( const std::vector<double> &sorted, double fraction )
+{
+    return sorted[std::min( sorted.size() - 1, static_cast<size_t>( sorted.size() * fraction ) )];
+}
+
+void run_scene( const std::string &name, const std::function<void()> &setup )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    set_time_to_day();
+    avatar &u = get_avatar();
+    // The avatar only watches, nothing may get it killed before the run is over.
+    u.toggle_trait( trait_DEBUG_NODMG );
+    rng_set_engine_seed( fixture_seed );
+    setup();
+
+    std::vector<double> latencies;
+    latencies.reserve( benchmark_turns );
+    reset_peak_rss();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for( int i = 0; i < benchmark_turns; ++i ) {
+        // Never enough moves to act, so do_turn() doesn't wait for input.
+        u.set_moves( -1000 );
+        const std::chrono::steady_clock::time_point turn_start = std::chrono::steady_clock::now();
+        do_turn();
+        latencies.push_back( std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - turn_start ).count() );
+    }
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                           start ).count();
+    const int64_t rss = peak_rss_kib();
+    std::sort( latencies.begin(), latencies.end() );
+    const double turns_per_second = benchmark_turns / std::max( seconds, 1e-9 );
+    const double p50 = percentile( latencies, 0.5 );
+    const double p99 = percentile( latencies, 0.99 );
+    WARN( string_format( "%s: %.1f turns/s, p50 %.2f ms, p99 %.2f ms, peak RSS %d KiB", name,
+                         turns_per_second, p50, p99, rss ) );
+
+    u.toggle_trait( trait_DEBUG_NODMG );
+    clear_map_without_vision();
+
+    JsonObject budget;
+    if( !find_benchmark_budget( "turn_budget.json", name, budget ) ) {
+        return;
+    }
+    CAPTURE( name );
+    if( budget.has_member( "min_turns_per_second" ) ) {
+        CHECK( turns_per_second >= budget.get_float( "min_turns_per_second" ) );
+    }
+    if( budget.has_member( "max_p99_ms" ) ) {
+        CHECK( p99 <= budget.get_float( "max_p99_ms" ) );
+    }
+    if( rss > 0 && budget.has_member( "max_rss_kib" ) ) {
+        CHECK( rss <= budget.get_int64( "max_rss_kib" ) );
+    }
+}
+
+} // namespace
+
+TEST_CASE( "turn_benchmark", "[.][benchmark][turn_benchmark]" )
+{
+    run_scene( "npc_crowd", spawn_npc_crowd );
+    run_scene( "horde", spawn_horde );
+    run_scene( "convoy", spawn_convoy );
+    run_scene( "fire", start_fires );
+}
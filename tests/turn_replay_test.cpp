@@ -0,0 +1,65 @@
+#include <filesystem>
+#include <string>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "do_turn.h"
+#include "filesystem.h"
+#include "flexbuffer_json.h"
+#include "game.h"
+#include "map_helpers.h"
+#include "path_info.h"
+#include "player_helpers.h"
+#include "turn_replay.h"
+
+static void run_turns( int turns )
+{
+    for( int i = 0; i < turns; ++i ) {
+        // Never enough moves to act, so do_turn() doesn't wait for input.
+        get_avatar().set_moves( -1000 );
+        do_turn();
+    }
+}
+
+TEST_CASE( "turn_replay_records_and_replays_a_window_of_turns", "[turn_replay]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    const cata_path dir = turn_replay::recording_dir();
+
+    turn_replay::request_recording( 3 );
+    CHECK( turn_replay::is_recording() );
+    // The first boundary starts the recording, the next three end its turns.
+    run_turns( 4 );
+    CHECK_FALSE( turn_replay::is_recording() );
+    REQUIRE( file_exist( dir / "replay.json" ) );
+    REQUIRE( dir_exist( ( dir / "world" ).get_unrelative_path() ) );
+
+    std::string world;
+    std::string save_id;
+    REQUIRE( turn_replay::prepare_replay( dir, world, save_id ) );
+    CHECK( save_id == get_avatar().get_save_id() );
+    const cata_path replay_world = PATH_INFO::savedir_path() / world;
+    CHECK( dir_exist( replay_world.get_unrelative_path() ) );
+
+    run_turns( 3 );
+    CHECK_FALSE( turn_replay::replay_finished() );
+    // The last boundary ends the game, do_turn() would clean up the map after it.
+    turn_replay::end_turn();
+    CHECK( turn_replay::replay_finished() );
+    CHECK( g->uquit == QUIT_NOSAVED );
+    g->uquit = QUIT_NO;
+    int replayed = 0;
+    REQUIRE( read_from_file_json( dir / "replay_result.json", [&replayed]( const JsonValue & jv ) {
+        JsonObject jo = jv.get_object();
+        jo.allow_omitted_members();
+        replayed = jo.get_int( "turns" );
+    } ) );
+    CHECK( replayed == 3 );
+
+    std::filesystem::remove_all( replay_world.get_unrelative_path() );
+    std::filesystem::remove_all( dir.get_unrelative_path() );
+    clear_map_without_vision();
+}
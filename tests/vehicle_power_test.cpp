@@ -1,4 +1,5 @@
 #include <cstdlib>
+#include <map>
 #include <optional>
 #include <string>
 #include <utility>
@@ -46,6 +47,47 @@ static void reset_player()
     player_character.add_effect( effect_blind, 1_turns, true );
 }
 
+static void connect_debug_cord( map &here, const tripoint_bub_ms &source,
+                                const tripoint_bub_ms &target )
+{
+    const optional_vpart_position target_vp = here.veh_at( target );
+    const optional_vpart_position source_vp = here.veh_at( source );
+
+    item cord( itype_test_power_cord_25_loss );
+    cord.set_var( "source_x", source.x() );
+    cord.set_var( "source_y", source.y() );
+    cord.set_var( "source_z", source.z() );
+    cord.set_var( "state", "pay_out_cable" );
+    cord.active = true;
+
+    if( !target_vp ) {
+        debugmsg( "missing target at %s", target.to_string() );
+    }
+    vehicle *const target_veh = &target_vp->vehicle();
+    vehicle *const source_veh = &source_vp->vehicle();
+    if( source_veh == target_veh ) {
+        debugmsg( "source same as target" );
+    }
+
+    tripoint_abs_ms target_global = here.get_abs( target );
+    const vpart_id vpid( cord.typeId().str() );
+
+    point_rel_ms vcoords = source_vp->mount_pos();
+    vehicle_part source_part( vpid, item( cord ) );
+    source_part.target.first = target_global;
+    source_part.target.second = target_veh->pos_abs();
+    source_veh->install_part( here, vcoords, std::move( source_part ) );
+
+    vcoords = target_vp->mount_pos();
+    vehicle_part target_part( vpid, item( cord ) );
+    tripoint_bub_ms source_global( cord.get_var( "source_x", 0 ),
+                                   cord.get_var( "source_y", 0 ),
+                                   cord.get_var( "source_z", 0 ) );
+    target_part.target.first = here.get_abs( source_global );
+    target_part.target.second = source_veh->pos_abs();
+    target_veh->install_part( here, vcoords, std::move( target_part ) );
+}
+
 TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
 {
     clear_vehicles();
@@ -53,46 +95,6 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     build_test_map( ter_id( "t_pavement" ) );
     map &here = get_map();
 
-    const auto connect_debug_cord = [&here]( const tripoint_bub_ms & source,
-    const tripoint_bub_ms & target ) {
-        const optional_vpart_position target_vp = here.veh_at( target );
-        const optional_vpart_position source_vp = here.veh_at( source );
-
-        item cord( itype_test_power_cord_25_loss );
-        cord.set_var( "source_x", source.x() );
-        cord.set_var( "source_y", source.y() );
-        cord.set_var( "source_z", source.z() );
-        cord.set_var( "state", "pay_out_cable" );
-        cord.active = true;
-
-        if( !target_vp ) {
-            debugmsg( "missing target at %s", target.to_string() );
-        }
-        vehicle *const target_veh = &target_vp->vehicle();
-        vehicle *const source_veh = &source_vp->vehicle();
-        if( source_veh == target_veh ) {
-            debugmsg( "source same as target" );
-        }
-
-        tripoint_abs_ms target_global = here.get_abs( target );
-        const vpart_id vpid( cord.typeId().str() );
-
-        point_rel_ms vcoords = source_vp->mount_pos();
-        vehicle_part source_part( vpid, item( cord ) );
-        source_part.target.first = target_global;
-        source_part.target.second = target_veh->pos_abs();
-        source_veh->install_part( here, vcoords, std::move( source_part ) );
-
-        vcoords = target_vp->mount_pos();
-        vehicle_part target_part( vpid, item( cord ) );
-        tripoint_bub_ms source_global( cord.get_var( "source_x", 0 ),
-                                       cord.get_var( "source_y", 0 ),
-                                       cord.get_var( "source_z", 0 ) );
-        target_part.target.first = here.get_abs( source_global );
-        target_part.target.second = source_veh->pos_abs();
-        target_veh->install_part( here, vcoords, std::move( target_part ) );
-    };
-
     const std::vector<tripoint_bub_ms> placements { { 4, 10, 0 }, { 6, 10, 0 }, { 8, 10, 0 } };
     std::vector<vpart_reference> batteries;
     for( const tripoint_bub_ms &p : placements ) {
@@ -110,7 +112,7 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     // connect first to second and second to third, each cord is 25% lossy
     // third battery will on average take twice as many charges to charge as the first
     for( size_t i = 0; i < placements.size() - 1; i++ ) {
-        connect_debug_cord( placements[i], placements[i + 1] );
+        connect_debug_cord( here, placements[i], placements[i + 1] );
     }
     const optional_vpart_position ovp_first = here.veh_at( placements[0] );
     REQUIRE( ovp_first.has_value() );
@@ -140,6 +142,43 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     }
 }
 
+TEST_CASE( "power_grid_follows_cables_and_vehicles", "[vehicle][power]" )
+{
+    clear_vehicles();
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+    map &here = get_map();
+
+    const std::vector<tripoint_bub_ms> placements { { 4, 14, 0 }, { 6, 14, 0 }, { 8, 14, 0 } };
+    std::vector<vehicle *> vehicles;
+    for( const tripoint_bub_ms &p : placements ) {
+        vehicle *veh = here.add_vehicle( vehicle_prototype_none, p, 0_degrees, 0, 0 );
+        REQUIRE( veh != nullptr );
+        REQUIRE( veh->install_part( here, point_rel_ms::zero, vpart_frame ) != -1 );
+        REQUIRE( veh->install_part( here, point_rel_ms::zero, vpart_small_storage_battery ) != -1 );
+        veh->refresh( );
+        here.add_vehicle_to_cache( veh );
+        vehicles.push_back( veh );
+    }
+    vehicle &first = *vehicles[0];
+    CHECK( first.search_connected_vehicles( here ).size() == 1 );
+
+    connect_debug_cord( here, placements[0], placements[1] );
+    CHECK( first.search_connected_vehicles( here ).size() == 2 );
+    // Asking again without changes gives the same grid.
+    CHECK( first.search_connected_vehicles( here ).size() == 2 );
+
+    connect_debug_cord( here, placements[1], placements[2] );
+    CHECK( first.search_connected_vehicles( here ).size() == 3 );
+    CHECK( std::as_const( first ).connected_battery_power_level( here ).second ==
+           3 * vehicles[2]->battery_power_level().second );
+
+    here.destroy_vehicle( vehicles[2] );
+    const std::map<vehicle *, float> grid = first.search_connected_vehicles( here );
+    CHECK( grid.size() == 2 );
+    CHECK( grid.count( vehicles[1] ) == 1 );
+}
+
 TEST_CASE( "Solar_power", "[vehicle][power]" )
 {
     clear_vehicles();
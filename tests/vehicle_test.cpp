@@ -111,6 +111,49 @@ TEST_CASE( "destroy_grabbed_vehicle_section", "[vehicle]" )
     }
 }
 
+// Mount lookups may answer from the relative_parts cache; they must agree with a plain scan.
+static void check_mount_lookups_match_scan( const vehicle &veh )
+{
+    for( const vpart_reference &vp : veh.get_all_parts() ) {
+        const point_rel_ms mount = vp.mount_pos();
+        std::vector<int> scanned;
+        for( const vpart_reference &other : veh.get_all_parts() ) {
+            if( other.mount_pos() == mount && !other.part().removed ) {
+                scanned.push_back( static_cast<int>( other.part_index() ) );
+            }
+        }
+        CAPTURE( mount );
+        CHECK( veh.parts_at_relative( mount, false ) == scanned );
+        CHECK( veh.part_with_feature( mount, "OBSTACLE", false ) ==
+               veh.part_with_feature( mount, VPFLAG_OBSTACLE, false ) );
+        CHECK( veh.part_with_feature( mount, "CARGO", true ) ==
+               veh.part_with_feature( mount, VPFLAG_CARGO, true ) );
+    }
+}
+
+TEST_CASE( "vehicle_mount_lookups_follow_part_changes", "[vehicle]" )
+{
+    map &here = get_map();
+    clear_map_without_vision();
+    vehicle *veh_ptr = here.add_vehicle( vehicle_prototype_car, tripoint_bub_ms( 60, 60, 0 ),
+                                         0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    check_mount_lookups_match_scan( *veh_ptr );
+
+    const point_rel_ms mount = veh_ptr->part( 0 ).mount;
+    const int before = veh_ptr->part_with_feature( mount, "AUTOPILOT", false );
+    REQUIRE( before == -1 );
+    const int installed = veh_ptr->install_part( here, mount, vpart_programmable_autopilot );
+    REQUIRE( installed >= 0 );
+    CHECK( veh_ptr->part_with_feature( mount, "AUTOPILOT", false ) == installed );
+    check_mount_lookups_match_scan( *veh_ptr );
+
+    veh_ptr->remove_part( veh_ptr->part( installed ) );
+    CHECK( veh_ptr->part_with_feature( mount, "AUTOPILOT", false ) == -1 );
+    veh_ptr->part_removal_cleanup( here );
+    check_mount_lookups_match_scan( *veh_ptr );
+}
+
 TEST_CASE( "add_item_to_broken_vehicle_part", "[vehicle]" )
 {
     map &here = get_map();
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "type_id.h"
+#include "visibility_oracle.h"
+
+static const ter_str_id ter_t_wall( "t_wall" );
+
+TEST_CASE( "visibility_oracle_answers_from_either_end", "[vision][visibility_oracle]" )
+{
+    visibility_oracle oracle;
+    const tripoint_bub_ms a( 10, 10, 0 );
+    const tripoint_bub_ms b( 20, 14, 0 );
+    const tripoint_bub_ms c( 30, 30, 0 );
+
+    CHECK( oracle.lookup( a, b ) == -1 );
+    oracle.store( a, b, true );
+    oracle.store( a, c, false );
+    CHECK( oracle.lookup( a, b ) == 1 );
+    CHECK( oracle.lookup( b, a ) == 1 );
+    CHECK( oracle.lookup( a, c ) == 0 );
+    CHECK( oracle.lookup( c, a ) == 0 );
+    CHECK( oracle.lookup( b, c ) == -1 );
+    CHECK( oracle.observers() == 1 );
+
+    // Tiles off the bubble are never stored
+    oracle.store( tripoint_bub_ms( -1, 5, 0 ), a, true );
+    CHECK( oracle.lookup( tripoint_bub_ms( -1, 5, 0 ), a ) == -1 );
+
+    oracle.clear();
+    CHECK( oracle.lookup( a, b ) == -1 );
+    CHECK( oracle.observers() == 0 );
+}
+
+TEST_CASE( "skew_sight_cache_keeps_recent_lines_across_z_levels", "[vision][visibility_oracle]" )
+{
+    skew_sight_cache cache;
+    const tripoint_bub_ms low( 10, 10, 0 );
+    const tripoint_bub_ms high( 12, 11, 1 );
+
+    CHECK( cache.lookup( low, high ) == -1 );
+    cache.store( low, high, true );
+    CHECK( cache.lookup( low, high ) == 1 );
+    CHECK( cache.lookup( high, low ) == 1 );
+    cache.store( high, low, false );
+    CHECK( cache.lookup( low, high ) == 0 );
+
+    // Far more lines than fit, the most recent ones are still answered.
+    for( int x = 0; x < 120; x++ ) {
+        for( int y = 0; y < 120; y++ ) {
+            cache.store( tripoint_bub_ms( x, y, 0 ), tripoint_bub_ms( x, y, -1 ), ( x + y ) % 2 == 0 );
+        }
+    }
+    CHECK( cache.lookup( tripoint_bub_ms( 119, 119, 0 ), tripoint_bub_ms( 119, 119, -1 ) ) == 1 );
+    CHECK( cache.lookup( tripoint_bub_ms( 119, 118, -1 ), tripoint_bub_ms( 119, 118, 0 ) ) == 0 );
+
+    cache.clear();
+    CHECK( cache.lookup( tripoint_bub_ms( 119, 119, 0 ), tripoint_bub_ms( 119, 119, -1 ) ) == -1 );
+    cache.store( low, high, true );
+    CHECK( cache.lookup( low, high ) == 1 );
+}
+
+TEST_CASE( "map_sees_forgets_sight_lines_when_a_wall_goes_up", "[vision][visibility_oracle]" )
+{
+    clear_avatar();
+    clear_map_without_vision();
+    map &here = get_map();
+    const tripoint_bub_ms from( 30, 30, 0 );
+    const tripoint_bub_ms to( 40, 30, 0 );
+    here.build_map_cache( 0 );
+
+    CHECK( here.sees( from, to, 60 ) );
+    CHECK( here.sees( to, from, 60 ) );
+    CHECK( here.has_potential_los( from, to ) );
+
+    here.ter_set( tripoint_bub_ms( 35, 30, 0 ), ter_t_wall );
+    here.build_map_cache( 0 );
+    CHECK_FALSE( here.sees( from, to, 60 ) );
+    CHECK_FALSE( here.has_potential_los( from, to ) );
+    // Out of range is still answered before the stored line
+    CHECK_FALSE( here.sees( from, tripoint_bub_ms( 31, 30, 0 ), 0 ) );
+}
+
+TEST_CASE( "prefetched_sight_lines_match_map_sees", "[vision][visibility_oracle]" )
+{
+    clear_avatar();
+    map &here = get_map();
+    // Putting the wall up again drops everything the oracle knew.
+    const auto build_wall = [&here]() {
+        clear_map_without_vision();
+        for( int y = 20; y <= 40; y++ ) {
+            here.ter_set( tripoint_bub_ms( 35, y, 0 ), ter_t_wall );
+        }
+        here.build_map_cache( 0 );
+    };
+    const tripoint_bub_ms from( 30, 30, 0 );
+    std::vector<std::pair<tripoint_bub_ms, tripoint_bub_ms>> lines;
+    for( int y = 10; y <= 50; y += 4 ) {
+        lines.emplace_back( from, tripoint_bub_ms( 45, y, 0 ) );
+        lines.emplace_back( tripoint_bub_ms( 25, y, 0 ), from );
+    }
+
+    build_wall();
+    std::vector<bool> traced;
+    for( const std::pair<tripoint_bub_ms, tripoint_bub_ms> &line : lines ) {
+        traced.push_back( here.sees( line.first, line.second, 60 ) );
+    }
+    REQUIRE( std::count( traced.begin(), traced.end(), false ) > 0 );
+    REQUIRE( std::count( traced.begin(), traced.end(), true ) > 0 );
+
+    build_wall();
+    here.prefetch_sight_lines( lines );
+    for( size_t i = 0; i < lines.size(); i++ ) {
+        CAPTURE( lines[i].first, lines[i].second );
+        CHECK( here.sees( lines[i].first, lines[i].second, 60 ) == traced[i] );
+    }
+}
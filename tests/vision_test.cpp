@@ -1187,3 +1187,38 @@ TEST_CASE( "pl_sees-oob-nocrash", "[vision]" )
 
     clear_avatar();
 }
+
+TEST_CASE( "vision_cached_light_source_follows_terrain_changes", "[shadowcasting][vision]" )
+{
+    clear_map_without_vision( -2, OVERMAP_HEIGHT );
+    g->reset_light_level();
+    scoped_weather_override weather_clear( WEATHER_CLEAR );
+    calendar::turn = midnight;
+
+    map &here = get_map();
+    const tripoint_bub_ms lamp( 30, 30, 0 );
+    const tripoint_bub_ms target( 34, 30, 0 );
+    here.ter_set( lamp, ter_t_utility_light );
+    here.build_map_cache( 0 );
+    const float open_light = here.ambient_light_at( target );
+    REQUIRE( open_light > LIGHT_AMBIENT_LOW );
+
+    // Nothing changed, so the lamp's cached light is reused as is.
+    here.build_map_cache( 0 );
+    CHECK( here.ambient_light_at( target ) == open_light );
+
+    std::vector<std::pair<tripoint_bub_ms, ter_id>> old_terrain;
+    for( int y = 20; y <= 40; ++y ) {
+        const tripoint_bub_ms wall( 32, y, 0 );
+        old_terrain.emplace_back( wall, here.ter( wall ) );
+        here.ter_set( wall, ter_t_brick_wall );
+    }
+    here.build_map_cache( 0 );
+    CHECK( here.ambient_light_at( target ) < open_light );
+
+    for( const std::pair<tripoint_bub_ms, ter_id> &old : old_terrain ) {
+        here.ter_set( old.first, old.second );
+    }
+    here.build_map_cache( 0 );
+    CHECK( here.ambient_light_at( target ) == open_light );
+}
@@ -1,3 +1,5 @@
+#include <climits>
+
 #include "cata_catch.h"
 
 #include "calendar.h"
@@ -25,3 +27,48 @@ TEST_CASE( "visitable_summation" )
 
     CHECK( test_inv.charges_of( itype_water, item::INFINITE_CHARGES ) > 1 );
 }
+
+TEST_CASE( "visitable_filters_only_see_items_of_the_queried_type" )
+{
+    item bottle_of_water( itype_bottle_plastic, calendar::turn );
+    item water_in_bottle( itype_water, calendar::turn );
+    water_in_bottle.charges = 2;
+    bottle_of_water.put_in( water_in_bottle, pocket_type::CONTAINER );
+
+    int filter_calls = 0;
+    const auto counting_filter = [&filter_calls]( const item & ) {
+        ++filter_calls;
+        return true;
+    };
+    CHECK( bottle_of_water.charges_of( itype_water, INT_MAX, counting_filter ) == 2 );
+    // the bottle itself is not water, so the filter never had to look at it
+    CHECK( filter_calls == 1 );
+
+    filter_calls = 0;
+    CHECK( bottle_of_water.amount_of( itype_bottle_plastic, true, INT_MAX, counting_filter ) == 1 );
+    CHECK( filter_calls == 1 );
+
+    // and the default filter gives the same totals as an explicit one
+    CHECK( bottle_of_water.charges_of( itype_water ) == 2 );
+    CHECK( bottle_of_water.amount_of( itype_bottle_plastic ) == 1 );
+}
+
+TEST_CASE( "visitable_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    inventory test_inv;
+    for( int i = 0; i < 200; ++i ) {
+        item bottle_of_water( itype_bottle_plastic, calendar::turn );
+        item water_in_bottle( itype_water, calendar::turn );
+        water_in_bottle.charges = 2;
+        bottle_of_water.put_in( water_in_bottle, pocket_type::CONTAINER );
+        test_inv.add_item( bottle_of_water );
+    }
+    REQUIRE( test_inv.charges_of( itype_water ) == 400 );
+
+    BENCHMARK( "charges_of, 200 bottles" ) {
+        return test_inv.charges_of( itype_water );
+    };
+    BENCHMARK( "amount_of, 200 bottles" ) {
+        return test_inv.amount_of( itype_bottle_plastic );
+    };
+}
@@ -117,3 +117,29 @@ TEST_CASE( "zones_custom", "[zones]" )
         REQUIRE( nbp2.count( tripoint_abs_ms( m_zone_loc ) ) == 1 ); // container matches this zone
     }
 }
+
+TEST_CASE( "zones_custom_destination_follows_zone_edits", "[zones]" )
+{
+    clear_map_without_vision();
+    zone_manager &zmgr = zone_manager::get_manager();
+    zmgr.clear();
+    map &m = get_map();
+    tripoint_abs_ms const zone_loc = m.get_abs( tripoint_bub_ms{ 5, 5, 0 } );
+    tripoint_abs_ms const where = m.get_abs( tripoint_bub_ms::zero );
+    item hammer( itype_hammer );
+    item noted_hammer( itype_hammer );
+    noted_hammer.set_var( "item_note", "spare" );
+
+    mapgen_place_zone( zone_loc, zone_loc, zone_type_LOOT_CUSTOM, your_fac, {}, "n:spare" );
+    CHECK( zmgr.get_near_zone_type_for_item( noted_hammer, where ) == zone_type_LOOT_CUSTOM );
+    CHECK( !zmgr.get_near_zone_type_for_item( hammer, where ).is_valid() );
+
+    mapgen_place_zone( zone_loc, zone_loc, zone_type_LOOT_CUSTOM, your_fac, {}, "hammer" );
+    CHECK( zmgr.get_near_zone_type_for_item( hammer, where ) == zone_type_LOOT_CUSTOM );
+    CHECK( zmgr.get_near_zone_type_for_item( item( itype_hammer ), where ) ==
+           zone_type_LOOT_CUSTOM );
+
+    REQUIRE( zmgr.remove( zmgr.get_zones().back().get() ) );
+    CHECK( !zmgr.get_near_zone_type_for_item( hammer, where ).is_valid() );
+    zmgr.clear();
+}
@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -356,3 +357,180 @@ TEST_CASE( "zzip_corruption_recovery", "[.][zzip]" )
         }
     }
 }
+
+TEST_CASE( "zzip_trained_dictionary", "[.][zzip]" )
+{
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() /
+                                      std::filesystem::u8path( "zzip_trained_dictionary" );
+    std::filesystem::remove_all( dir );
+    std::filesystem::create_directories( dir );
+    const std::filesystem::path base_dictionary = dir / std::filesystem::u8path( "maps.dict" );
+    {
+        std::ofstream fout( base_dictionary, std::ios::binary );
+        fout << R"({"version":1,"coordinates":[0,0,0],"terrain":["t_grass","t_dirt"]})";
+    }
+
+    // Similar looking but not identical entries, like saved submaps are.
+    std::unordered_map<std::filesystem::path, std::string, std_fs_path_hash> files;
+    for( int i = 0; i < 64; ++i ) {
+        std::string contents;
+        for( int j = 0; j < 100; ++j ) {
+            contents += R"({"coordinates":[)" + std::to_string( i ) + "," + std::to_string( j ) +
+                        R"(,0],"terrain":["t_grass",)" + std::to_string( ( i * j ) % 7 ) +
+                        R"(,"t_tree_young"],"furniture":[],"items":[]})";
+        }
+        files.emplace( std::filesystem::u8path( "sm" + std::to_string( i ) ), contents );
+    }
+
+    std::shared_ptr<mmap_file> mem_file = mmap_file::map_writeable_memory( 0 );
+    std::optional<zzip> z = zzip::load( mem_file, base_dictionary );
+    REQUIRE( z.has_value() );
+    for( auto& [name, contents] : files ) {
+        REQUIRE( z->add_file( name, contents ) );
+    }
+
+    REQUIRE( z->train_dictionary() );
+    const std::filesystem::path newer = std::filesystem::u8path( "newer" );
+    REQUIRE( z->add_file( newer, "written with the trained dictionary" ) );
+
+    // Entries from before and after training both decode.
+    for( auto& [name, contents] : files ) {
+        CHECK( _view( z->get_file( name ) ) == contents );
+    }
+    CHECK( _view( z->get_file( newer ) ) == "written with the trained dictionary" );
+
+    // Compaction recompresses the older entries with the trained dictionary.
+    std::shared_ptr<mmap_file> mem_file2 = mmap_file::map_writeable_memory( 0 );
+    REQUIRE( z->compact_to( mem_file2 ) );
+    CHECK( mem_file2->len() < mem_file->len() );
+    std::optional<zzip> compacted = zzip::load( mem_file2, base_dictionary );
+    REQUIRE( compacted.has_value() );
+    for( auto& [name, contents] : files ) {
+        CHECK( _view( compacted->get_file( name ) ) == contents );
+    }
+    CHECK( _view( compacted->get_file( newer ) ) == "written with the trained dictionary" );
+
+    std::filesystem::remove_all( dir );
+}
+
+TEST_CASE( "zzip_stored_entries_are_viewed_in_place", "[.][zzip]" )
+{
+    std::shared_ptr<mmap_file> mem_file = mmap_file::map_writeable_memory( 0 );
+    std::optional<zzip> z = zzip::load( mem_file );
+    REQUIRE( z.has_value() );
+
+    const std::filesystem::path noise_name = std::filesystem::u8path( "noise.bin" );
+    const std::filesystem::path text_name = std::filesystem::u8path( "text.json" );
+    const std::vector<std::byte> noise = make_bytes( 4096 );
+    std::string text;
+    while( text.size() < 4096 ) {
+        text += R"({"terrain":"t_grass","furniture":"f_null"},)";
+    }
+    REQUIRE( z->add_file( noise_name, _view( noise ) ) );
+    REQUIRE( z->add_file( text_name, text ) );
+
+    // Random bytes don't compress, so zstd stores them and they can be read in place.
+    std::optional<std::string_view> noise_view = z->get_file_view( noise_name );
+    REQUIRE( noise_view.has_value() );
+    CHECK( *noise_view == _view( noise ) );
+    const char *mapped = static_cast<const char *>( mem_file->base() );
+    CHECK( noise_view->data() >= mapped );
+    CHECK( noise_view->data() + noise_view->size() <= mapped + mem_file->len() );
+    CHECK( z->get_file_string( noise_name ) == _view( noise ) );
+
+    CHECK_FALSE( z->get_file_view( text_name ).has_value() );
+    CHECK( z->get_file_string( text_name ) == text );
+
+    const std::filesystem::path missing_name = std::filesystem::u8path( "missing.json" );
+    CHECK_FALSE( z->get_file_view( missing_name ).has_value() );
+    CHECK( z->get_file_string( missing_name ).empty() );
+}
+
+TEST_CASE( "zzip_add_files_writes_a_batch_in_order", "[.][zzip]" )
+{
+    std::shared_ptr<mmap_file> mem_file = mmap_file::map_writeable_memory( 0 );
+    std::optional<zzip> z = zzip::load( mem_file );
+    REQUIRE( z.has_value() );
+    REQUIRE( z->add_file( std::filesystem::u8path( "old.txt" ), "old" ) );
+
+    // Enough content to be compressed on the thread pool.
+    std::vector<std::string> contents;
+    std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+    for( int i = 0; i < 16; ++i ) {
+        std::string text;
+        while( text.size() < 32 * 1024 ) {
+            text += R"({"terrain":"t_grass","furniture":"f_null","index":)" + std::to_string( i ) + "},";
+        }
+        contents.push_back( std::move( text ) );
+    }
+    for( int i = 0; i < 16; ++i ) {
+        files.emplace_back( std::filesystem::u8path( "batch" + std::to_string( i ) + ".json" ),
+                            contents[i] );
+    }
+    files.emplace_back( std::filesystem::u8path( "batch3.json" ), "replaced" );
+    REQUIRE( z->add_files( files ) );
+
+    std::optional<zzip> reloaded = zzip::load( mem_file );
+    REQUIRE( reloaded.has_value() );
+    CHECK( reloaded->get_entries().size() == 17 );
+    CHECK( reloaded->get_file_string( std::filesystem::u8path( "old.txt" ) ) == "old" );
+    for( int i = 0; i < 16; ++i ) {
+        const std::string expected = i == 3 ? "replaced" : contents[i];
+        CHECK( reloaded->get_file_string( std::filesystem::u8path( "batch" + std::to_string(
+                                              i ) + ".json" ) ) == expected );
+    }
+    // Appended in the order given, less the replaced entry.
+    std::vector<zzip::entry_layout> layout = reloaded->get_layout();
+    std::sort( layout.begin(), layout.end(), []( const zzip::entry_layout & a,
+    const zzip::entry_layout & b ) {
+        return a.offset < b.offset;
+    } );
+    REQUIRE( layout.size() == 17 );
+    CHECK( layout[0].path == std::filesystem::u8path( "old.txt" ) );
+    CHECK( layout[1].path == std::filesystem::u8path( "batch0.json" ) );
+    CHECK( layout[3].path == std::filesystem::u8path( "batch2.json" ) );
+    CHECK( layout[4].path == std::filesystem::u8path( "batch4.json" ) );
+    CHECK( layout[16].path == std::filesystem::u8path( "batch3.json" ) );
+}
+
+TEST_CASE( "zzip_benchmark", "[.][benchmark][kernel_benchmark]" )
+{
+    // Text about the size and shape of a saved submap, a little different in each file.
+    std::vector<std::pair<std::filesystem::path, std::string>> files;
+    for( int i = 0; i < 64; ++i ) {
+        std::string contents = "[{\"version\":36,\"coordinates\":[" + std::to_string( i ) + ",0,0],";
+        contents += "\"terrain\":[";
+        for( int t = 0; t < 144; ++t ) {
+            contents += t % 7 == i % 7 ? "\"t_floor\"," : "[\"t_grass\",3],";
+        }
+        contents += "\"t_dirt\"],\"furniture\":[],\"items\":[]}]";
+        files.emplace_back( std::filesystem::u8path( "sm_" + std::to_string( i ) + ".json" ),
+                            std::move( contents ) );
+    }
+
+    BENCHMARK( "write 64 files" ) {
+        std::optional<zzip> z = zzip::load( mmap_file::map_writeable_memory( 0 ) );
+        for( const std::pair<std::filesystem::path, std::string> &file : files ) {
+            z->add_file( file.first, file.second );
+        }
+        return z->get_entries().size();
+    };
+
+    std::shared_ptr<mmap_file> mem_file = mmap_file::map_writeable_memory( 0 );
+    {
+        std::optional<zzip> z = zzip::load( mem_file );
+        REQUIRE( z.has_value() );
+        for( const std::pair<std::filesystem::path, std::string> &file : files ) {
+            REQUIRE( z->add_file( file.first, file.second ) );
+        }
+    }
+    std::optional<zzip> z = zzip::load( mem_file );
+    REQUIRE( z.has_value() );
+    BENCHMARK( "read 64 files" ) {
+        size_t total = 0;
+        for( const std::pair<std::filesystem::path, std::string> &file : files ) {
+            total += z->get_file_string( file.first ).size();
+        }
+        return total;
+    };
+}
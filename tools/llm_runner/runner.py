@@ -2,16 +2,20 @@
 import argparse
 import json
 import os
+import socket
 import sys
+import threading
 import time
 import traceback
 import urllib.request
 import urllib.error
-from typing import Any, Dict, Optional, TextIO, Tuple
+from collections import OrderedDict
+from typing import Any, Dict, List, Optional, TextIO, Tuple
 
 TEMPERATURE = 0.6
 TOP_P = 0.9
 REPETITION_PENALTY = 1.0
+SESSION_CACHE_LIMIT = 64
 
 
 def strip_think_tags(text: str) -> str:
@@ -41,6 +45,94 @@ def sanitize_jsonish(value: Any) -> Any:
     return value
 
 
+class PrefixSessions:
+    """Remembers the stable prompt prefix last sent for each NPC session.
+
+    The game puts everything that doesn't change between an NPC's requests at the start
+    of the prompt and sends its length as prefix_bytes.  Backends with prefix caching
+    reuse the KV cache for that part; this keeps track of how much of it matched.
+    """
+
+    def __init__(self, limit: int) -> None:
+        self.limit = limit
+        self.prefixes: "OrderedDict[str, bytes]" = OrderedDict()
+
+    def touch(self, request: Dict[str, Any]) -> Dict[str, Any]:
+        session = request.get("session")
+        prefix_bytes = request.get("prefix_bytes")
+        prompt = request.get("prompt")
+        if not isinstance(session, str) or not session or not isinstance(prompt, str):
+            return {}
+        if not isinstance(prefix_bytes, int) or prefix_bytes < 0:
+            prefix_bytes = 0
+        prefix = prompt.encode("utf-8", "replace")[:prefix_bytes]
+        previous = self.prefixes.pop(session, b"")
+        reused = 0
+        for old, new in zip(previous, prefix):
+            if old != new:
+                break
+            reused += 1
+        self.prefixes[session] = prefix
+        while len(self.prefixes) > self.limit:
+            self.prefixes.popitem(last=False)
+        return {
+            "session": session,
+            "session_prefix_bytes": len(prefix),
+            "session_prefix_reused_bytes": reused,
+        }
+
+
+PREFIX_SESSIONS = PrefixSessions(SESSION_CACHE_LIMIT)
+
+# Requests come from stdin and responses go to stdout, unless this thread serves a
+# connection to the --listen socket, see serve_socket().
+STREAMS = threading.local()
+# One generate() at a time, the OpenVINO pipeline is shared by every connection.
+GENERATE_LOCK = threading.Lock()
+
+
+def input_stream() -> TextIO:
+    return getattr(STREAMS, "input", sys.stdin)
+
+
+def output_stream() -> TextIO:
+    return getattr(STREAMS, "output", sys.stdout)
+
+
+class SpeechStreamer:
+    """Collects generated text and writes one partial response once the speech field ends.
+
+    The game prints the speech from the partial response right away and applies the
+    actions only from the full response that follows.
+    """
+
+    def __init__(self, request_id: str) -> None:
+        self.request_id = request_id
+        self.text = ""
+        self.sent = False
+
+    def feed(self, chunk: str) -> None:
+        if self.sent or not chunk:
+            return
+        self.text += chunk
+        visible = self.text
+        if "<think>" in visible:
+            if "</think>" not in visible:
+                return
+            visible = strip_think_tags(visible)
+        separator = visible.find("|")
+        if separator < 0 or not visible[:separator].strip():
+            return
+        self.sent = True
+        write_response({"request_id": self.request_id, "ok": True, "partial": True,
+                        "text": visible[:separator + 1]})
+
+    def __call__(self, chunk: str) -> bool:
+        self.feed(chunk)
+        # False keeps generation going.
+        return False
+
+
 def parse_args() -> argparse.Namespace:
     parser = argparse.ArgumentParser(
         description="OpenVINO GenAI LLM runner (stdin/stdout JSON).",
@@ -120,6 +212,18 @@ def parse_args() -> argparse.Namespace:
         default="Hello from the LLM self-test.",
         help="Prompt used for --self-test.",
     )
+    parser.add_argument(
+        "--listen",
+        default="",
+        help="Unix socket to serve the game from instead of stdin/stdout. The runner keeps "
+             "running, and its model loaded, when the game disconnects.",
+    )
+    parser.add_argument(
+        "--config-id",
+        default="",
+        help="Fingerprint of the game settings this runner was launched with. Each --listen "
+             "connection is greeted with it, so a game with other settings can replace the runner.",
+    )
     parser.add_argument(
         "--dry-run",
         action="store_true",
@@ -158,12 +262,24 @@ def log_line(log_fp: Optional[TextIO], message: str) -> None:
     log_fp.flush()
 
 
-def load_pipeline(model_dir: str, device: str, cache_dir: str, max_prompt_len: int):
+def load_pipeline(model_dir: str, device: str, cache_dir: str, max_prompt_len: int,
+                  log_fp: Optional[TextIO] = None):
     import openvino_genai as ov_genai
 
     if cache_dir:
         os.makedirs(cache_dir, exist_ok=True)
     is_cpu = device.upper() == "CPU"
+    if device.upper() in ("CPU", "GPU"):
+        # The paged attention backend keeps KV blocks of shared prompt prefixes.
+        try:
+            scheduler_config = ov_genai.SchedulerConfig()
+            scheduler_config.enable_prefix_caching = True
+            kwargs = {"scheduler_config": scheduler_config}
+            if cache_dir:
+                kwargs["CACHE_DIR"] = cache_dir
+            return ov_genai.LLMPipeline(model_dir, device, **kwargs)
+        except Exception as exc:
+            log_line(log_fp, f"prefix caching unavailable, loading without it: {exc}")
     use_cpu_fallback = not is_cpu
     enable_cpu_fallback = "NO" if use_cpu_fallback else None
     try:
@@ -246,33 +362,44 @@ def read_request(line: str) -> Dict[str, Any]:
     return sanitize_jsonish(json.loads(line))
 
 
+def iter_requests(log_fp: Optional[TextIO]):
+    """Yields requests from stdin, flattening batch messages into their requests."""
+    for line in input_stream():
+        line = line.strip()
+        if not line:
+            continue
+        try:
+            request = read_request(line)
+        except Exception as exc:
+            log_line(log_fp, f"invalid request: {exc}")
+            write_response({"request_id": "unknown", "ok": False, "error": str(exc)})
+            continue
+        if request.get("command") == "batch":
+            for entry in request.get("requests") or []:
+                if isinstance(entry, dict):
+                    yield entry
+            continue
+        yield request
+
+
 def write_response(payload: Dict[str, Any]) -> None:
     if "text" in payload:
         payload["text"] = sanitize_text(payload.get("text"))
     if "error" in payload:
         payload["error"] = sanitize_text(payload.get("error"))
-    sys.stdout.write(json.dumps(payload, ensure_ascii=True) + "\n")
-    sys.stdout.flush()
+    out = output_stream()
+    out.write(json.dumps(payload, ensure_ascii=True) + "\n")
+    out.flush()
 
 
-def handle_request(
-    pipe,
+def generation_params(
     tokenizer,
     request: Dict[str, Any],
     default_max_tokens: int,
     max_prompt_len: int,
-    build_time_ms: float,
-    total_load_time_ms: float,
-    log_fp: Optional[TextIO],
-) -> Dict[str, Any]:
-    request_id = request.get("request_id", "unknown")
-    if request.get("command") == "shutdown":
-        return {"request_id": request_id, "ok": True, "shutdown": True}
-
-    prompt = request.get("prompt")
-    if not isinstance(prompt, str) or not prompt.strip():
-        return {"request_id": request_id, "ok": False, "error": "Missing prompt"}
-
+) -> Tuple[int, str, int, Dict[str, Any]]:
+    """Returns prompt tokens, token count method, max new tokens and generate() kwargs."""
+    prompt = request.get("prompt") or ""
     max_tokens = request.get("max_tokens", default_max_tokens)
     if not isinstance(max_tokens, int) or max_tokens <= 0:
         max_tokens = default_max_tokens
@@ -293,21 +420,50 @@ def handle_request(
         max_length = max(max_length, max_prompt_len)
     if max_length <= prompt_tokens:
         max_length = prompt_tokens + max(1, max_tokens)
+
+    do_sample = temperature is not None or top_p is not None
+    gen_kwargs: Dict[str, Any] = {
+        "max_length": max_length,
+        "do_sample": do_sample,
+    }
+    if temperature is not None:
+        gen_kwargs["temperature"] = float(temperature)
+    if top_p is not None:
+        gen_kwargs["top_p"] = float(top_p)
+    if repetition_penalty is not None:
+        gen_kwargs["repetition_penalty"] = float(repetition_penalty)
+    return prompt_tokens, token_count_method, max_tokens, gen_kwargs
+
+
+def handle_request(
+    pipe,
+    tokenizer,
+    request: Dict[str, Any],
+    default_max_tokens: int,
+    max_prompt_len: int,
+    build_time_ms: float,
+    total_load_time_ms: float,
+    log_fp: Optional[TextIO],
+) -> Dict[str, Any]:
+    request_id = request.get("request_id", "unknown")
+    if request.get("command") == "shutdown":
+        return {"request_id": request_id, "ok": True, "shutdown": True}
+
+    prompt = request.get("prompt")
+    if not isinstance(prompt, str) or not prompt.strip():
+        return {"request_id": request_id, "ok": False, "error": "Missing prompt"}
+
+    prompt_tokens, token_count_method, max_tokens, gen_kwargs = generation_params(
+        tokenizer, request, default_max_tokens, max_prompt_len
+    )
+    max_length = gen_kwargs["max_length"]
     start_time = time.perf_counter()
     try:
-        do_sample = temperature is not None or top_p is not None
-        gen_kwargs = {
-            "max_length": max_length,
-            "do_sample": do_sample,
-        }
-        if temperature is not None:
-            gen_kwargs["temperature"] = float(temperature)
-        if top_p is not None:
-            gen_kwargs["top_p"] = float(top_p)
-        if repetition_penalty is not None:
-            gen_kwargs["repetition_penalty"] = float(repetition_penalty)
         try:
-            result = pipe.generate(prompt, **gen_kwargs)
+            if request.get("stream"):
+                result = pipe.generate(prompt, streamer=SpeechStreamer(request_id), **gen_kwargs)
+            else:
+                result = pipe.generate(prompt, **gen_kwargs)
         except TypeError as exc:
             log_line(log_fp, f"generate params unsupported, retrying without sampling args: {exc}")
             result = pipe.generate(
@@ -337,6 +493,7 @@ def handle_request(
             "npu": get_npu_metrics(),
             "use_api": False,
         }
+        metrics.update(PREFIX_SESSIONS.touch(request))
         return {"request_id": request_id, "ok": True, "text": text, "metrics": metrics}
     except Exception as exc:
         log_line(log_fp, f"request exception: {exc}")
@@ -344,6 +501,73 @@ def handle_request(
         return {"request_id": request_id, "ok": False, "error": str(exc)}
 
 
+def handle_batch_requests(
+    pipe,
+    tokenizer,
+    requests: List[Dict[str, Any]],
+    default_max_tokens: int,
+    max_prompt_len: int,
+    build_time_ms: float,
+    total_load_time_ms: float,
+    log_fp: Optional[TextIO],
+) -> List[Dict[str, Any]]:
+    """Generates all prompts of a batch in one generate() call, in request order.
+
+    Sampling settings come from the first request and max_length is the largest of the
+    batch.  Falls back to one request at a time if the pipeline can't batch.
+    """
+    def one_by_one() -> List[Dict[str, Any]]:
+        return [
+            handle_request(pipe, tokenizer, request, default_max_tokens, max_prompt_len,
+                           build_time_ms, total_load_time_ms, log_fp)
+            for request in requests
+        ]
+
+    prompts = [request.get("prompt") for request in requests]
+    if len(requests) < 2 or not all(isinstance(p, str) and p.strip() for p in prompts):
+        return one_by_one()
+
+    params = [generation_params(tokenizer, request, default_max_tokens, max_prompt_len)
+              for request in requests]
+    gen_kwargs = dict(params[0][3])
+    gen_kwargs["max_length"] = max(param[3]["max_length"] for param in params)
+    start_time = time.perf_counter()
+    try:
+        result = pipe.generate(prompts, **gen_kwargs)
+        texts = list(getattr(result, "texts", None) or [])
+    except Exception as exc:
+        log_line(log_fp, f"batch generate failed, running one by one: {exc}")
+        return one_by_one()
+    if len(texts) != len(requests):
+        log_line(log_fp, f"batch generate returned {len(texts)} texts for {len(requests)} prompts")
+        return one_by_one()
+    elapsed_ms = (time.perf_counter() - start_time) * 1000.0
+
+    responses = []
+    for request, param, text in zip(requests, params, texts):
+        prompt_tokens, token_count_method, max_tokens, _ = param
+        text = sanitize_text(strip_think_tags(str(text)))
+        generated_tokens, _ = count_tokens(tokenizer, text)
+        metrics = {
+            "build_time_ms": build_time_ms,
+            "total_load_time_ms": total_load_time_ms,
+            "gen_time_ms": elapsed_ms,
+            "prompt_tokens": prompt_tokens,
+            "generated_tokens": generated_tokens,
+            "total_tokens": prompt_tokens + generated_tokens,
+            "max_length": gen_kwargs["max_length"],
+            "max_new_tokens": max_tokens,
+            "token_count_method": token_count_method,
+            "batch_size": len(requests),
+            "npu": get_npu_metrics(),
+            "use_api": False,
+        }
+        metrics.update(PREFIX_SESSIONS.touch(request))
+        responses.append({"request_id": request.get("request_id", "unknown"), "ok": True,
+                          "text": text, "metrics": metrics})
+    return responses
+
+
 def try_import_openvino_genai(log_fp: Optional[TextIO]) -> Optional[object]:
     try:
         import openvino_genai as ov_genai
@@ -378,7 +602,7 @@ def run_openvino_self_test(args: argparse.Namespace, log_fp: Optional[TextIO]) -
     device = select_device(args.device, log_fp)
     try:
         log_line(log_fp, "self-test: loading OpenVINO pipeline")
-        pipe = load_pipeline(args.model_dir, device, cache_dir, args.max_prompt_len)
+        pipe = load_pipeline(args.model_dir, device, cache_dir, args.max_prompt_len, log_fp)
         tokenizer = build_tokenizer(args.model_dir)
         request = {
             "request_id": "self_test",
@@ -411,11 +635,12 @@ def run_openvino_self_test(args: argparse.Namespace, log_fp: Optional[TextIO]) -
         return 1
 
 
-def ollama_generate(ollama_url: str, model: str, prompt: str, max_tokens: int, temperature: float) -> Dict[str, Any]:
+def ollama_generate(ollama_url: str, model: str, prompt: str, max_tokens: int, temperature: float,
+                    streamer: Optional[SpeechStreamer] = None) -> Dict[str, Any]:
     payload = {
         "model": model,
         "prompt": prompt,
-        "stream": False,
+        "stream": streamer is not None,
         "options": {
             "temperature": float(temperature),
             "num_predict": int(max_tokens),
@@ -425,7 +650,21 @@ def ollama_generate(ollama_url: str, model: str, prompt: str, max_tokens: int, t
     data = json.dumps(payload).encode("utf-8")
     req = urllib.request.Request(url, data=data, headers={"Content-Type": "application/json"})
     with urllib.request.urlopen(req, timeout=600) as resp:
-        return json.loads(resp.read().decode("utf-8"))
+        if streamer is None:
+            return json.loads(resp.read().decode("utf-8"))
+        # Streamed replies are one JSON object per line, the last one carries the stats.
+        final: Dict[str, Any] = {}
+        text = ""
+        for raw_line in resp:
+            raw_line = raw_line.strip()
+            if not raw_line:
+                continue
+            final = json.loads(raw_line.decode("utf-8"))
+            chunk = final.get("response", "")
+            text += chunk
+            streamer.feed(chunk)
+        final["response"] = text
+        return final
 
 
 def ollama_unload(ollama_url: str, model: str, log_fp: Optional[TextIO]) -> None:
@@ -516,6 +755,43 @@ def run_api_self_test(args: argparse.Namespace, log_fp: Optional[TextIO]) -> int
         return 1
 
 
+def open_listen_socket(path: str, log_fp: Optional[TextIO]) -> socket.socket:
+    """Binds the --listen socket, replacing a stale one left by a runner that died."""
+    if os.path.exists(path):
+        os.unlink(path)
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(path)
+    server.listen()
+    log_line(log_fp, f"listening on {path}")
+    return server
+
+
+def serve_socket(server: socket.socket, log_fp: Optional[TextIO], config_id: str,
+                 serve_connection) -> int:
+    """Runs serve_connection for every game that connects, each on a thread of its own.
+
+    Every connection is first greeted with config_id and this process's pid. A shutdown
+    request or the game going away ends only that connection.
+    """
+    def serve(conn: socket.socket) -> None:
+        with conn, conn.makefile("r", encoding="utf-8", newline="\n") as conn_in, \
+                conn.makefile("w", encoding="utf-8", newline="\n") as conn_out:
+            STREAMS.input = conn_in
+            STREAMS.output = conn_out
+            try:
+                write_response({"request_id": "handshake", "ok": True, "config_id": config_id,
+                                "pid": os.getpid()})
+                serve_connection()
+            except OSError as exc:
+                log_line(log_fp, f"connection ended: {exc}")
+        log_line(log_fp, "game disconnected")
+
+    while True:
+        conn, _ = server.accept()
+        log_line(log_fp, "game connected")
+        threading.Thread(target=serve, args=(conn,), daemon=True).start()
+
+
 def main() -> int:
     args = parse_args()
     log_fp = setup_logger(args.log_file)
@@ -526,15 +802,25 @@ def main() -> int:
     backend = (args.backend or "openvino").strip().lower()
     if args.use_api:
         backend = "api"
+    # Listening before the model loads lets the game connect right away, its requests
+    # wait in the socket until the model is ready.
+    server = None
+    if args.listen and not args.self_test:
+        server = open_listen_socket(args.listen, log_fp)
 
     if backend == "api":
         if args.self_test:
             return run_api_self_test(args, log_fp)
+        if server:
+            return serve_socket(server, log_fp, args.config_id, lambda: run_api_mode(args, log_fp))
         return run_api_mode(args, log_fp)
 
     if backend == "ollama":
         if args.self_test:
             return run_ollama_self_test(args, log_fp)
+        if server:
+            return serve_socket(server, log_fp, args.config_id,
+                                lambda: run_ollama_mode(args, log_fp))
         return run_ollama_mode(args, log_fp)
 
     if not args.model_dir:
@@ -558,7 +844,7 @@ def main() -> int:
         build_start = time.perf_counter()
         cache_dir = args.cache_dir or os.path.join(args.model_dir, ".ov_cache")
         device = select_device(args.device, log_fp)
-        pipe = load_pipeline(args.model_dir, device, cache_dir, args.max_prompt_len)
+        pipe = load_pipeline(args.model_dir, device, cache_dir, args.max_prompt_len, log_fp)
         build_time_ms = (time.perf_counter() - build_start) * 1000.0
         total_load_time_ms = (time.perf_counter() - start_time) * 1000.0
         log_line(log_fp, f"pipeline loaded (build {build_time_ms:.1f} ms, total {total_load_time_ms:.1f} ms)")
@@ -570,40 +856,59 @@ def main() -> int:
         print(f"Failed to load pipeline: {exc}", file=sys.stderr)
         return 1
 
-    for line in sys.stdin:
-        line = line.strip()
-        if not line:
-            continue
-        try:
-            request = read_request(line)
-        except Exception as exc:
-            log_line(log_fp, f"invalid request: {exc}")
-            write_response({"request_id": "unknown", "ok": False, "error": str(exc)})
-            continue
+    def serve_openvino() -> int:
+        for line in input_stream():
+            line = line.strip()
+            if not line:
+                continue
+            try:
+                request = read_request(line)
+            except Exception as exc:
+                log_line(log_fp, f"invalid request: {exc}")
+                write_response({"request_id": "unknown", "ok": False, "error": str(exc)})
+                continue
 
-        response = handle_request(
-            pipe,
-            tokenizer,
-            request,
-            args.max_tokens,
-            args.max_prompt_len,
-            build_time_ms,
-            total_load_time_ms,
-            log_fp,
-        )
-        if not response.get("ok"):
-            log_line(log_fp, f"request failed: {response.get('error', '')}")
-        else:
-            text = response.get("text", "")
-            if isinstance(text, str) and text:
-                snippet = sanitize_text(text)
-                snippet = snippet if len(snippet) <= 4000 else snippet[:4000] + "...[truncated]"
-                log_line(log_fp, f"response raw: {snippet}")
-        write_response(response)
-        if response.get("shutdown"):
-            return 0
+            with GENERATE_LOCK:
+                if request.get("command") == "batch":
+                    batch = [entry for entry in request.get("requests") or [] if isinstance(entry, dict)]
+                    responses = handle_batch_requests(
+                        pipe,
+                        tokenizer,
+                        batch,
+                        args.max_tokens,
+                        args.max_prompt_len,
+                        build_time_ms,
+                        total_load_time_ms,
+                        log_fp,
+                    )
+                else:
+                    responses = [handle_request(
+                        pipe,
+                        tokenizer,
+                        request,
+                        args.max_tokens,
+                        args.max_prompt_len,
+                        build_time_ms,
+                        total_load_time_ms,
+                        log_fp,
+                    )]
+            for response in responses:
+                if not response.get("ok"):
+                    log_line(log_fp, f"request failed: {response.get('error', '')}")
+                else:
+                    text = response.get("text", "")
+                    if isinstance(text, str) and text:
+                        snippet = sanitize_text(text)
+                        snippet = snippet if len(snippet) <= 4000 else snippet[:4000] + "...[truncated]"
+                        log_line(log_fp, f"response raw: {snippet}")
+                write_response(response)
+                if response.get("shutdown"):
+                    return 0
+        return 0
 
-    return 0
+    if server:
+        return serve_socket(server, log_fp, args.config_id, serve_openvino)
+    return serve_openvino()
 
 
 def extract_message_content_text(content: Any) -> str:
@@ -665,20 +970,12 @@ def run_ollama_mode(args: argparse.Namespace, log_fp: Optional[TextIO]) -> int:
         print("Ollama model is required for Ollama mode.", file=sys.stderr)
         return 1
 
-    for line in sys.stdin:
-        line = line.strip()
-        if not line:
-            continue
-        try:
-            request = read_request(line)
-        except Exception as exc:
-            log_line(log_fp, f"invalid request: {exc}")
-            write_response({"request_id": "unknown", "ok": False, "error": str(exc)})
-            continue
-
+    for request in iter_requests(log_fp):
         request_id = request.get("request_id", "unknown")
         if request.get("command") == "shutdown":
-            ollama_unload(args.ollama_url, model, log_fp)
+            # A daemon keeps the model for the next game.
+            if not args.listen:
+                ollama_unload(args.ollama_url, model, log_fp)
             write_response({"request_id": request_id, "ok": True, "shutdown": True})
             return 0
 
@@ -696,7 +993,8 @@ def run_ollama_mode(args: argparse.Namespace, log_fp: Optional[TextIO]) -> int:
 
         start_time = time.perf_counter()
         try:
-            response = ollama_generate(args.ollama_url, model, prompt, max_tokens, temperature)
+            streamer = SpeechStreamer(request_id) if request.get("stream") else None
+            response = ollama_generate(args.ollama_url, model, prompt, max_tokens, temperature, streamer)
             elapsed_ms = (time.perf_counter() - start_time) * 1000.0
             text = strip_think_tags(sanitize_text(response.get("response", "")))
             payload = {"request_id": request_id, "ok": True, "text": text}
@@ -709,6 +1007,7 @@ def run_ollama_mode(args: argparse.Namespace, log_fp: Optional[TextIO]) -> int:
                 "eval_count": response.get("eval_count"),
                 "eval_duration": response.get("eval_duration"),
             }
+            payload["metrics"].update(PREFIX_SESSIONS.touch(request))
             write_response(payload)
         except Exception as exc:
             log_line(log_fp, f"ollama request exception: {exc}")
@@ -735,20 +1034,12 @@ def run_api_mode(args: argparse.Namespace, log_fp: Optional[TextIO]) -> int:
     if args.api_key_env:
         api_key = os.environ.get(args.api_key_env, "")
 
-    for line in sys.stdin:
-        line = line.strip()
-        if not line:
-            continue
-        try:
-            request = read_request(line)
-        except Exception as exc:
-            log_line(log_fp, f"invalid request: {exc}")
-            write_response({"request_id": "unknown", "ok": False, "error": str(exc)})
-            continue
-
+    for request in iter_requests(log_fp):
         request_id = request.get("request_id", "unknown")
         if request.get("command") == "shutdown":
-            ollama_unload(args.ollama_url, model, log_fp)
+            # A daemon keeps the model for the next game.
+            if not args.listen:
+                ollama_unload(args.ollama_url, model, log_fp)
             write_response({"request_id": request_id, "ok": True, "shutdown": True})
             return 0
 
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Summarizes config/llm_intent_telemetry.csv, as written from the debug menu.
+
+Prints per-kind request counts and latency percentiles, optionally grouped by a
+column such as npc, to help size hardware and tune the runner settings.
+"""
+import argparse
+import csv
+import os
+import sys
+from typing import Dict, List
+
+
+SPANS = ["capture_ms", "queue_ms", "render_ms", "ttft_ms", "runner_ms", "total_ms"]
+
+
+def repo_root() -> str:
+    return os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Summarize LLM intent telemetry dumps.")
+    parser.add_argument(
+        "path",
+        nargs="?",
+        default=os.path.join(repo_root(), "config", "llm_intent_telemetry.csv"),
+        help="Telemetry CSV (default: config/llm_intent_telemetry.csv).",
+    )
+    parser.add_argument("--group-by", default="kind", help="Column to group rows by (default: kind).")
+    return parser.parse_args()
+
+
+def percentile(values: List[float], fraction: float) -> float:
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * fraction))]
+
+
+def summarize(rows: List[Dict[str, str]], group_by: str) -> None:
+    groups: Dict[str, List[Dict[str, str]]] = {}
+    for row in rows:
+        groups.setdefault(row.get(group_by, ""), []).append(row)
+    for name, members in sorted(groups.items()):
+        ok = sum(1 for row in members if row.get("ok") == "1")
+        cached = sum(1 for row in members if row.get("cached") == "1")
+        parse_failed = sum(1 for row in members if row.get("parse_failed") == "1")
+        print(f"{name}: {len(members)} requests, {ok} ok, {cached} cached, {parse_failed} parse failures")
+        live = [row for row in members if row.get("cached") != "1"]
+        for span in SPANS:
+            values = [float(row[span]) for row in live if row.get(span) and float(row[span]) >= 0.0]
+            if values:
+                print(f"  {span:<10} p50 {percentile(values, 0.5):9.1f}  p95 {percentile(values, 0.95):9.1f}"
+                      f"  max {max(values):9.1f}")
+        generated = [int(row["generated_tokens"]) for row in live if int(row.get("generated_tokens") or -1) >= 0]
+        runner_ms = [float(row["runner_ms"]) for row in live if int(row.get("generated_tokens") or -1) >= 0]
+        if generated and sum(runner_ms) > 0.0:
+            print(f"  tokens     {sum(generated) / len(generated):.0f} generated per request,"
+                  f" {sum(generated) * 1000.0 / sum(runner_ms):.1f} generated/s")
+
+
+def main() -> int:
+    args = parse_args()
+    if not os.path.exists(args.path):
+        print(f"No telemetry at {args.path}, write it from the debug menu first.", file=sys.stderr)
+        return 1
+    with open(args.path, "r", encoding="utf-8", errors="replace", newline="") as handle:
+        rows = list(csv.DictReader(handle))
+    if not rows:
+        print("No requests recorded.")
+        return 0
+    summarize(rows, args.group_by)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())